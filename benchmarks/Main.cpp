@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/prometheus/Prometheus.h>
+
+#include <benchmark/benchmark.h>
+#include <boost/log/core/core.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Runs the benchmarks and writes their results as JSON.
+ *
+ * Unless the command line says otherwise, the results are written to `clio_benchmarks.json` next to the usual console
+ * output so every run can be kept and compared with earlier ones (e.g. with google-benchmark's `compare.py`).
+ */
+int
+main(int argc, char** argv)
+{
+    static constexpr std::string_view outFlag = "--benchmark_out=";
+    static constexpr std::string_view outFormatFlag = "--benchmark_out_format=";
+
+    std::vector<char*> args(argv, argv + argc);
+    bool hasOut = false;
+    bool hasOutFormat = false;
+    for (auto const* arg : args) {
+        hasOut = hasOut || std::string_view{arg}.starts_with(outFlag);
+        hasOutFormat = hasOutFormat || std::string_view{arg}.starts_with(outFormatFlag);
+    }
+
+    std::string defaultOut{"--benchmark_out=clio_benchmarks.json"};
+    std::string defaultOutFormat{"--benchmark_out_format=json"};
+    if (!hasOut)
+        args.push_back(defaultOut.data());
+    if (!hasOutFormat)
+        args.push_back(defaultOutFormat.data());
+
+    auto newArgc = static_cast<int>(args.size());
+    args.push_back(nullptr);
+
+    boost::log::core::get()->set_logging_enabled(false);
+    PrometheusService::init();
+
+    benchmark::Initialize(&newArgc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(newArgc, args.data()))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <data/LedgerCache.h>
+#include <util/TestObject.h>
+
+#include <benchmark/benchmark.h>
+#include <ripple/protocol/digest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto TXNID = "E6DBAFC99223B42257915A63DFC6B0C032D4070F9A574B255AD97466726FC321";
+constexpr auto NUM_OBJECTS = 100'000u;
+constexpr auto UPDATE_SIZE = 200u;
+constexpr uint32_t FIRST_SEQ = 1;
+
+ripple::uint256 const&
+keyAt(std::uint64_t index)
+{
+    static auto const keys = [] {
+        std::vector<ripple::uint256> keys;
+        keys.reserve(NUM_OBJECTS);
+        for (std::uint64_t i = 0; i < NUM_OBJECTS; ++i)
+            keys.push_back(ripple::sha512Half(i));
+        return keys;
+    }();
+    return keys[index % NUM_OBJECTS];
+}
+
+std::vector<LedgerObject>
+makeObjects(std::uint64_t first, std::uint64_t count, uint32_t seq)
+{
+    std::vector<LedgerObject> objects;
+    objects.reserve(count);
+    for (auto i = first; i < first + count; ++i) {
+        auto const sle = CreateAccountRootObject(ACCOUNT, 0, seq, static_cast<int>(i), 1, TXNID, seq);
+        objects.push_back({keyAt(i), sle.getSerializer().peekData()});
+    }
+    return objects;
+}
+
+/**
+ * @brief A full cache shared by the read benchmarks; it is only ever read, so all the threads can use it.
+ */
+LedgerCache const&
+sharedCache()
+{
+    static auto const cache = [] {
+        auto cache = std::make_unique<LedgerCache>();
+        cache->update(makeObjects(0, NUM_OBJECTS, FIRST_SEQ), FIRST_SEQ);
+        cache->setFull();
+        return cache;
+    }();
+    return *cache;
+}
+
+/**
+ * @brief Readers hammering the cache from background threads while the benchmark thread writes to it.
+ */
+class BackgroundReaders {
+    std::atomic_bool stop_ = false;
+    std::vector<std::thread> threads_;
+
+public:
+    BackgroundReaders(LedgerCache const& cache, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            threads_.emplace_back([this, &cache, i] {
+                auto index = i;
+                while (!stop_) {
+                    benchmark::DoNotOptimize(cache.get(keyAt(index), cache.latestLedgerSequence()));
+                    index += 7;
+                }
+            });
+        }
+    }
+
+    ~BackgroundReaders()
+    {
+        stop_ = true;
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    BackgroundReaders(BackgroundReaders const&) = delete;
+    BackgroundReaders&
+    operator=(BackgroundReaders const&) = delete;
+};
+
+}  // namespace
+
+static void
+BM_LedgerCacheGet(benchmark::State& state)
+{
+    auto const& cache = sharedCache();
+    auto index = static_cast<std::uint64_t>(state.thread_index()) * 7919;
+
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(cache.get(keyAt(index), FIRST_SEQ));
+        index += 13;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LedgerCacheGet)->ThreadRange(1, 16)->UseRealTime();
+
+static void
+BM_LedgerCacheGetSuccessor(benchmark::State& state)
+{
+    auto const& cache = sharedCache();
+    auto index = static_cast<std::uint64_t>(state.thread_index()) * 7919;
+
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(cache.getSuccessor(keyAt(index), FIRST_SEQ));
+        index += 13;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LedgerCacheGetSuccessor)->ThreadRange(1, 16)->UseRealTime();
+
+/**
+ * @brief Apply ledger-sized updates while a number of threads (the argument) read from the cache.
+ */
+static void
+BM_LedgerCacheUpdate(benchmark::State& state)
+{
+    LedgerCache cache;
+    cache.update(makeObjects(0, NUM_OBJECTS, FIRST_SEQ), FIRST_SEQ);
+    cache.setFull();
+
+    auto const readers = BackgroundReaders{cache, static_cast<std::size_t>(state.range(0))};
+    auto seq = FIRST_SEQ;
+    std::uint64_t first = 0;
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        auto const objects = makeObjects(first, UPDATE_SIZE, ++seq);
+        first += UPDATE_SIZE;
+        state.ResumeTiming();
+
+        cache.update(objects, seq);
+    }
+    state.SetItemsProcessed(state.iterations() * UPDATE_SIZE);
+}
+BENCHMARK(BM_LedgerCacheUpdate)->Arg(0)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <etl/impl/ExtractionDataPipe.h>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace etl::detail;
+
+namespace {
+
+constexpr uint32_t START_SEQ = 1000;
+constexpr auto PAYLOAD_SIZE = 4096u;
+
+}  // namespace
+
+/**
+ * @brief Hand-off of extracted ledgers from one extractor thread per stride (the argument) to the transformer.
+ *
+ * Each extractor pushes every stride-th sequence like the ETL does; the benchmark thread pops them in order.
+ */
+static void
+BM_ExtractionDataPipeHandOff(benchmark::State& state)
+{
+    auto const stride = static_cast<uint32_t>(state.range(0));
+    ExtractionDataPipe<std::string> pipe{stride, START_SEQ};
+    std::atomic_bool stop = false;
+
+    std::vector<std::thread> extractors;
+    for (uint32_t i = 0; i < stride; ++i) {
+        extractors.emplace_back([&pipe, &stop, stride, i] {
+            auto seq = START_SEQ + i;
+            for (; !stop; seq += stride)
+                pipe.push(seq, std::string(PAYLOAD_SIZE, 'x'));
+            pipe.finish(seq);
+        });
+    }
+
+    auto seq = START_SEQ;
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(pipe.popNext(seq++));
+
+    // drain until every extractor has seen the stop flag and pushed its end marker
+    stop = true;
+    std::vector<bool> finished(stride, false);
+    for (uint32_t remaining = stride; remaining > 0; ++seq) {
+        auto const queue = (seq - START_SEQ) % stride;
+        if (finished[queue])
+            continue;
+
+        if (!pipe.popNext(seq)) {
+            finished[queue] = true;
+            --remaining;
+        }
+    }
+
+    for (auto& extractor : extractors)
+        extractor.join();
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * PAYLOAD_SIZE);
+}
+BENCHMARK(BM_ExtractionDataPipeHandOff)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
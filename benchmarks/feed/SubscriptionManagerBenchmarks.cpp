@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <feed/SubscriptionManager.h>
+#include <util/Taggable.h>
+#include <util/TestObject.h>
+#include <util/config/Config.h>
+#include <web/interface/ConnectionBase.h>
+
+#include <benchmark/benchmark.h>
+#include <boost/json.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto ACCOUNT1 = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+
+/**
+ * @brief A session that only counts the messages it is sent.
+ */
+struct CountingSession : public web::ConnectionBase {
+    std::shared_ptr<std::atomic_uint64_t> received;
+
+    CountingSession(util::TagDecoratorFactory const& factory, std::shared_ptr<std::atomic_uint64_t> counter)
+        : web::ConnectionBase(factory, ""), received(std::move(counter))
+    {
+    }
+
+    void
+    send(std::shared_ptr<std::string>) override
+    {
+        received->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void
+    send(std::string&&, boost::beast::http::status = boost::beast::http::status::ok) override
+    {
+        received->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+struct FanOut {
+    util::Config config;
+    util::TagDecoratorFactory tagFactory{config};
+    std::shared_ptr<std::atomic_uint64_t> received = std::make_shared<std::atomic_uint64_t>(0);
+    std::shared_ptr<feed::SubscriptionManager> manager;
+    std::vector<std::shared_ptr<web::ConnectionBase>> sessions;
+
+    FanOut(std::size_t numSessions, std::uint64_t numWorkers)
+        : manager(std::make_shared<feed::SubscriptionManager>(numWorkers, nullptr))
+    {
+        for (std::size_t i = 0; i < numSessions; ++i)
+            sessions.push_back(std::make_shared<CountingSession>(tagFactory, received));
+    }
+
+    /** @brief Wait until the sessions received the given number of messages in total. */
+    void
+    waitFor(std::uint64_t expected) const
+    {
+        while (received->load(std::memory_order_relaxed) < expected)
+            std::this_thread::yield();
+    }
+};
+
+TransactionAndMetadata
+paymentTransaction()
+{
+    TransactionAndMetadata tx;
+    tx.transaction = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32).getSerializer().peekData();
+    tx.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    tx.ledgerSequence = 32;
+    return tx;
+}
+
+}  // namespace
+
+/**
+ * @brief Broadcast a manifest to N sessions (first argument) using M subscription workers (second argument).
+ */
+static void
+BM_SubscriptionManagerBroadcast(benchmark::State& state)
+{
+    FanOut fanOut{static_cast<std::size_t>(state.range(0)), static_cast<std::uint64_t>(state.range(1))};
+    for (auto const& session : fanOut.sessions)
+        fanOut.manager->subManifest(session);
+
+    auto const manifest = boost::json::object{{"type", "manifestReceived"}, {"master_key", "nHBk"}, {"seq", 1}};
+    std::uint64_t expected = 0;
+
+    for ([[maybe_unused]] auto _ : state) {
+        fanOut.manager->forwardManifest(manifest);
+        expected += fanOut.sessions.size();
+        fanOut.waitFor(expected);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(expected));
+}
+BENCHMARK(BM_SubscriptionManagerBroadcast)
+    ->ArgsProduct({{1, 100, 1000, 10000}, {1, 4}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Publish a payment to N sessions (first argument) subscribed to one of its accounts, using M subscription
+ * workers (second argument). Covers serializing the transaction and the keyed fan-out.
+ */
+static void
+BM_SubscriptionManagerPubTransaction(benchmark::State& state)
+{
+    FanOut fanOut{static_cast<std::size_t>(state.range(0)), static_cast<std::uint64_t>(state.range(1))};
+    auto const account = GetAccountIDWithString(ACCOUNT1);
+    for (auto const& session : fanOut.sessions)
+        fanOut.manager->subAccount(account, session);
+
+    auto const tx = paymentTransaction();
+    auto const ledgerInfo = CreateLedgerInfo(LEDGERHASH, 33);
+    std::uint64_t expected = 0;
+
+    for ([[maybe_unused]] auto _ : state) {
+        fanOut.manager->pubTransaction(tx, ledgerInfo);
+        expected += fanOut.sessions.size();
+        fanOut.waitFor(expected);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(expected));
+}
+BENCHMARK(BM_SubscriptionManagerPubTransaction)
+    ->ArgsProduct({{1, 100, 1000, 10000}, {1, 4}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
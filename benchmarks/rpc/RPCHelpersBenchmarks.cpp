@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <rpc/RPCHelpers.h>
+#include <util/Allocations.h>
+#include <util/TestObject.h>
+
+#include <benchmark/benchmark.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STLedgerEntry.h>
+
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto ACCOUNT1 = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr auto CURRENCY = "0158415500000000C1F76FF6ECB0BAC600000000";
+constexpr auto ISSUER = "rK9DrarGKnVEo2nYp5MfVRXRYf5yRX3mwD";
+constexpr auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto TXNID = "E6DBAFC99223B42257915A63DFC6B0C032D4070F9A574B255AD97466726FC321";
+
+/**
+ * @brief A payment and an offer creation with their metadata, the most common transactions in account_tx responses.
+ */
+std::vector<TransactionAndMetadata>
+transactions()
+{
+    TransactionAndMetadata payment;
+    payment.transaction = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32).getSerializer().peekData();
+    payment.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    payment.ledgerSequence = 32;
+    payment.date = 700000000;
+
+    TransactionAndMetadata offer;
+    offer.transaction =
+        CreateCreateOfferTransactionObject(ACCOUNT1, 1, 32, CURRENCY, ISSUER, 1, 3).getSerializer().peekData();
+    offer.metadata = CreateMetaDataForCreateOffer(CURRENCY, ISSUER, 0, 1, 3).getSerializer().peekData();
+    offer.ledgerSequence = 32;
+    offer.date = 700000000;
+
+    return {payment, offer};
+}
+
+}  // namespace
+
+/**
+ * @brief Deserialize a transaction and its metadata and convert both to JSON, as account_tx and tx do.
+ */
+static void
+BM_RPCHelpersToExpandedJson(benchmark::State& state)
+{
+    auto const txs = transactions();
+    auto const& tx = txs.at(state.range(0));
+    benchmarks::AllocationCounter const allocations;
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(rpc::toExpandedJson(tx, rpc::NFTokenjson::ENABLE));
+
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RPCHelpersToExpandedJson)->Arg(0)->Arg(1);
+
+static void
+BM_RPCHelpersToJsonLedgerEntry(benchmark::State& state)
+{
+    auto const object = CreateAccountRootObject(ACCOUNT1, 0, 1, 10, 2, TXNID, 3);
+    ripple::SLE const sle{object, ripple::keylet::account(GetAccountIDWithString(ACCOUNT1)).key};
+    benchmarks::AllocationCounter const allocations;
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(rpc::toJson(sle));
+
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RPCHelpersToJsonLedgerEntry);
+
+static void
+BM_RPCHelpersToJsonLedgerHeader(benchmark::State& state)
+{
+    auto const header = CreateLedgerInfo(LEDGERHASH, 33);
+    benchmarks::AllocationCounter const allocations;
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(rpc::toJson(header));
+
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RPCHelpersToJsonLedgerHeader);
@@ -0,0 +1,274 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <rpc/common/AnyHandler.h>
+#include <rpc/common/Specs.h>
+#include <rpc/common/Types.h>
+#include <rpc/common/Validators.h>
+#include <rpc/handlers/AccountTx.h>
+#include <rpc/handlers/LedgerEntry.h>
+#include <rpc/handlers/Subscribe.h>
+#include <util/Allocations.h>
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/json.hpp>
+
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace {
+
+constexpr auto MINIMAL_REQUEST = R"({"account": "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"})";
+constexpr auto FULL_REQUEST = R"({
+    "account": "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn",
+    "ledger_index_min": 100,
+    "ledger_index_max": 2000,
+    "limit": 50,
+    "binary": false,
+    "forward": true,
+    "tx_type": "Payment",
+    "marker": {"ledger": 150, "seq": 3}
+})";
+
+constexpr auto MINIMAL_SUBSCRIBE_REQUEST = R"({"streams": ["ledger"]})";
+constexpr auto FULL_SUBSCRIBE_REQUEST = R"({
+    "streams": ["ledger", "transactions", "book_changes"],
+    "accounts": ["rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"],
+    "accounts_proposed": ["rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun"],
+    "books": [{
+        "taker_pays": {"currency": "XRP"},
+        "taker_gets": {"currency": "USD", "issuer": "rK9DrarGKnVEo2nYp5MfVRXRYf5yRX3mwD"},
+        "taker": "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn",
+        "both": true,
+        "snapshot": false
+    }]
+})";
+
+constexpr auto MINIMAL_LEDGER_ENTRY_REQUEST =
+    R"({"index": "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652"})";
+constexpr auto FULL_LEDGER_ENTRY_REQUEST = R"({
+    "ripple_state": {
+        "accounts": ["rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn", "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun"],
+        "currency": "USD"
+    },
+    "ledger_index": "validated",
+    "binary": true
+})";
+
+boost::json::value
+request(int64_t which)
+{
+    return boost::json::parse(which == 0 ? MINIMAL_REQUEST : FULL_REQUEST);
+}
+
+void
+processSpec(benchmark::State& state, rpc::RpcSpec const& spec, boost::json::value const& value)
+{
+    for ([[maybe_unused]] auto _ : state) {
+        auto copy = value;
+        benchmark::DoNotOptimize(spec.process(copy));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename HandlerType>
+void
+parseInput(benchmark::State& state, HandlerType const& handler, boost::json::value const& value)
+{
+    for ([[maybe_unused]] auto _ : state) {
+        auto copy = value;
+        benchmark::DoNotOptimize(handler.parseInput(copy, 2));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+struct EchoInput {
+    std::string account;
+    std::optional<uint32_t> limit;
+};
+
+struct EchoOutput {
+    std::string account;
+    uint32_t limit = 0;
+};
+
+EchoInput
+tag_invoke(boost::json::value_to_tag<EchoInput>, boost::json::value const& jv)
+{
+    auto const& obj = jv.as_object();
+    EchoInput input{obj.at("account").as_string().c_str(), std::nullopt};
+    if (obj.contains("limit"))
+        input.limit = jv.at("limit").as_int64();
+    return input;
+}
+
+void
+tag_invoke(boost::json::value_from_tag, boost::json::value& jv, EchoOutput const& output)
+{
+    jv = {{"account", output.account}, {"limit", output.limit}};
+}
+
+/**
+ * @brief A handler that does no work of its own, so that dispatching it only measures the framework around handlers.
+ */
+class EchoHandler {
+public:
+    using Input = EchoInput;
+    using Output = EchoOutput;
+    using Result = rpc::HandlerReturnType<Output>;
+
+    static rpc::RpcSpecConstRef
+    spec([[maybe_unused]] uint32_t apiVersion)
+    {
+        return rpc::AccountTxHandler::spec(apiVersion);
+    }
+
+    Result
+    process(Input input, [[maybe_unused]] rpc::Context const& ctx) const
+    {
+        return Output{std::move(input.account), input.limit.value_or(200)};
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief Baseline for the benchmarks below: copying the request they process on every iteration.
+ */
+static void
+BM_RpcSpecCopyRequest(benchmark::State& state)
+{
+    auto const value = request(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto copy = value;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_RpcSpecCopyRequest)->Arg(0)->Arg(1);
+
+/**
+ * @brief Validate an account_tx request with only the required field (0) or with every field set (1).
+ */
+static void
+BM_RpcSpecProcess(benchmark::State& state)
+{
+    processSpec(state, rpc::AccountTxHandler::spec(2), request(state.range(0)));
+}
+BENCHMARK(BM_RpcSpecProcess)->Arg(0)->Arg(1);
+
+/**
+ * @brief Validate a subscribe request to a single stream (0) or to streams, accounts and an order book (1).
+ */
+static void
+BM_SubscribeSpecProcess(benchmark::State& state)
+{
+    auto const handler = rpc::SubscribeHandler{nullptr, nullptr};
+    auto const value = boost::json::parse(state.range(0) == 0 ? MINIMAL_SUBSCRIBE_REQUEST : FULL_SUBSCRIBE_REQUEST);
+    processSpec(state, handler.spec(2), value);
+}
+BENCHMARK(BM_SubscribeSpecProcess)->Arg(0)->Arg(1);
+
+/**
+ * @brief Validate a ledger_entry request by index (0) or for a trust line, which goes through a nested section (1).
+ */
+static void
+BM_LedgerEntrySpecProcess(benchmark::State& state)
+{
+    auto const value =
+        boost::json::parse(state.range(0) == 0 ? MINIMAL_LEDGER_ENTRY_REQUEST : FULL_LEDGER_ENTRY_REQUEST);
+    processSpec(state, rpc::LedgerEntryHandler::spec(2), value);
+}
+BENCHMARK(BM_LedgerEntrySpecProcess)->Arg(0)->Arg(1);
+
+/**
+ * @brief Validate the same account_tx requests with the static spec and fill the typed input on the way.
+ */
+static void
+BM_AccountTxStaticSpecParse(benchmark::State& state)
+{
+    parseInput(state, rpc::AccountTxHandler{nullptr}, request(state.range(0)));
+}
+BENCHMARK(BM_AccountTxStaticSpecParse)->Arg(0)->Arg(1);
+
+/**
+ * @brief Validate the same subscribe requests with the static spec and fill the typed input on the way.
+ */
+static void
+BM_SubscribeStaticSpecParse(benchmark::State& state)
+{
+    auto const value = boost::json::parse(state.range(0) == 0 ? MINIMAL_SUBSCRIBE_REQUEST : FULL_SUBSCRIBE_REQUEST);
+    parseInput(state, rpc::SubscribeHandler{nullptr, nullptr}, value);
+}
+BENCHMARK(BM_SubscribeStaticSpecParse)->Arg(0)->Arg(1);
+
+/**
+ * @brief Validate the same ledger_entry requests with the static spec and fill the typed input on the way.
+ */
+static void
+BM_LedgerEntryStaticSpecParse(benchmark::State& state)
+{
+    auto const value =
+        boost::json::parse(state.range(0) == 0 ? MINIMAL_LEDGER_ENTRY_REQUEST : FULL_LEDGER_ENTRY_REQUEST);
+    parseInput(state, rpc::LedgerEntryHandler{nullptr}, value);
+}
+BENCHMARK(BM_LedgerEntryStaticSpecParse)->Arg(0)->Arg(1);
+
+/**
+ * @brief Dispatch a request through AnyHandler: validation, conversion to and from the typed input and output, and
+ * the handler call. Reports the heap allocations per request.
+ *
+ * The second argument selects how the params reach the handler: 0 copies them like the engine used to, 1 moves them
+ * in like the engine does now. The copy moved in is made outside of the measured allocations.
+ */
+static void
+BM_AnyHandlerDispatch(benchmark::State& state)
+{
+    auto const value = request(state.range(0));
+    auto const moved = state.range(1) != 0;
+    auto const handler = rpc::AnyHandler{EchoHandler{}};
+
+    boost::asio::io_context ioc;
+    boost::asio::spawn(ioc, [&](boost::asio::yield_context yield) {
+        auto const ctx = rpc::Context{yield, {}, false, "", 2};
+        benchmarks::AllocationCounter allocations;
+
+        for ([[maybe_unused]] auto _ : state) {
+            if (moved) {
+                state.PauseTiming();
+                auto params = allocations.exclude([&] { return value; });
+                state.ResumeTiming();
+                benchmark::DoNotOptimize(handler.process(std::move(params), ctx));
+            } else {
+                benchmark::DoNotOptimize(handler.process(value, ctx));
+            }
+        }
+
+        allocations.report(state);
+    });
+    ioc.run();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AnyHandlerDispatch)->Args({0, 0})->Args({0, 1})->Args({1, 0})->Args({1, 1});
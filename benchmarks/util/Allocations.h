@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <utility>
+
+namespace benchmarks {
+
+/**
+ * @return The number of heap allocations made by the calling thread so far
+ */
+std::uint64_t
+allocationCount();
+
+/**
+ * @brief Reports the average number of heap allocations per iteration of a benchmark.
+ *
+ * The benchmark binary replaces the global operator new with one that counts allocations per thread, so only the
+ * allocations made by the thread running the benchmark loop are counted.
+ */
+class AllocationCounter {
+    std::uint64_t start_ = allocationCount();
+
+public:
+    /**
+     * @brief Add the `allocs_per_iter` counter to the state; call after the benchmark loop.
+     *
+     * @param state The state of the benchmark
+     */
+    void
+    report(benchmark::State& state) const
+    {
+        state.counters["allocs_per_iter"] = benchmark::Counter(
+            static_cast<double>(allocationCount() - start_), benchmark::Counter::kAvgIterations
+        );
+    }
+
+    /**
+     * @brief Run a function without counting its allocations, e.g. to set up the input of an iteration.
+     *
+     * @param fn The function to run
+     * @return What the function returns
+     */
+    template <typename FnType>
+    auto
+    exclude(FnType&& fn)
+    {
+        auto const before = allocationCount();
+        auto result = std::forward<FnType>(fn)();
+        start_ += allocationCount() - before;
+        return result;
+    }
+};
+
+}  // namespace benchmarks
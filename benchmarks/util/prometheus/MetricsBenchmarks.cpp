@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/prometheus/Prometheus.h>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <string>
+
+using namespace util::prometheus;
+
+/**
+ * @brief Increment a counter that is shared by all the threads, the way request counters are used.
+ */
+static void
+BM_PrometheusCounterIncrement(benchmark::State& state)
+{
+    auto& counter = PrometheusService::counterInt("bench_counter_total_number", Labels{}, "Benchmark counter");
+
+    for ([[maybe_unused]] auto _ : state)
+        ++counter;
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PrometheusCounterIncrement)->ThreadRange(1, 16)->UseRealTime();
+
+static void
+BM_PrometheusGaugeUpdate(benchmark::State& state)
+{
+    auto& gauge = PrometheusService::gaugeInt("bench_gauge_current_number", Labels{}, "Benchmark gauge");
+
+    for ([[maybe_unused]] auto _ : state) {
+        ++gauge;
+        --gauge;
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_PrometheusGaugeUpdate)->ThreadRange(1, 16)->UseRealTime();
+
+/**
+ * @brief Look a labelled counter up by name and labels on every update, as code that doesn't keep a reference does.
+ */
+static void
+BM_PrometheusCounterLookup(benchmark::State& state)
+{
+    for ([[maybe_unused]] auto _ : state) {
+        ++PrometheusService::counterInt(
+            "bench_lookup_total_number", Labels{{Label{"method", "account_info"}, Label{"status", "finished"}}}
+        );
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PrometheusCounterLookup)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * @brief Serialize all metrics with the given number (the argument) of extra labelled series registered.
+ */
+static void
+BM_PrometheusScrape(benchmark::State& state)
+{
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        PrometheusService::counterInt(
+            "bench_scrape_total_number", Labels{{Label{"series", fmt::format("{}", i)}}}, "Benchmark scrape series"
+        ) += i;
+    }
+
+    std::size_t bytes = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        auto const metrics = PrometheusService::collectMetrics();
+        bytes += metrics.size();
+        benchmark::DoNotOptimize(metrics);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_PrometheusScrape)->Arg(10)->Arg(100)->Arg(1000);
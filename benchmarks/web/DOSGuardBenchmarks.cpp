@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/config/Config.h>
+#include <web/DOSGuard.h>
+#include <web/IpKey.h>
+#include <web/WhitelistHandler.h>
+
+#include <benchmark/benchmark.h>
+#include <boost/json/parse.hpp>
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr auto CONFIG = R"JSON({
+    "dos_guard": {
+        "max_fetches": 4000000000,
+        "max_connections": 1000000,
+        "max_requests": 4000000000,
+        "whitelist": ["127.0.0.1", "10.0.0.0/8", "192.168.0.0/16", "2001:db8::/32"]
+    }
+})JSON";
+
+class NoSweepHandler {
+public:
+    template <typename GuardType>
+    void
+    setup(GuardType*)
+    {
+    }
+};
+
+using Guard = web::BasicDOSGuard<web::WhitelistHandler, NoSweepHandler>;
+
+struct GuardWithWhitelist {
+    util::Config config{boost::json::parse(CONFIG)};
+    web::WhitelistHandler whitelist{config};
+    NoSweepHandler sweep;
+    Guard guard{config, whitelist, sweep};
+};
+
+/**
+ * @brief The IP used by a benchmark thread: either the same for every thread or a distinct one per thread.
+ */
+std::string
+clientIp(benchmark::State const& state, bool shared)
+{
+    return shared ? "203.0.113.1" : fmt::format("203.0.113.{}", state.thread_index() + 1);
+}
+
+GuardWithWhitelist&
+sharedGuard()
+{
+    static GuardWithWhitelist guard;
+    return guard;
+}
+
+}  // namespace
+
+/**
+ * @brief Count a request from a client that is not whitelisted; the argument selects a single shared IP (1) or one IP
+ * per thread (0).
+ */
+static void
+BM_DOSGuardRequest(benchmark::State& state)
+{
+    auto& guard = sharedGuard().guard;
+    auto const ip = clientIp(state, state.range(0) != 0);
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(guard.request(ip));
+
+    if (state.thread_index() == 0)
+        guard.clear();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DOSGuardRequest)->Arg(0)->Arg(1)->ThreadRange(1, 16)->UseRealTime();
+
+/**
+ * @brief Same as BM_DOSGuardRequest but with the client IP parsed once up front, as sessions do.
+ */
+static void
+BM_DOSGuardRequestByKey(benchmark::State& state)
+{
+    auto& guard = sharedGuard().guard;
+    auto const ip = web::makeIpKey(clientIp(state, state.range(0) != 0));
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(guard.request(ip));
+
+    if (state.thread_index() == 0)
+        guard.clear();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DOSGuardRequestByKey)->Arg(0)->Arg(1)->ThreadRange(1, 16)->UseRealTime();
+
+static void
+BM_DOSGuardAdd(benchmark::State& state)
+{
+    auto& guard = sharedGuard().guard;
+    auto const ip = clientIp(state, state.range(0) != 0);
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(guard.add(ip, 1));
+
+    if (state.thread_index() == 0)
+        guard.clear();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DOSGuardAdd)->Arg(0)->Arg(1)->ThreadRange(1, 16)->UseRealTime();
+
+/**
+ * @brief Requests from whitelisted clients only go through the whitelist lookup.
+ */
+static void
+BM_DOSGuardWhitelistedRequest(benchmark::State& state)
+{
+    auto& guard = sharedGuard().guard;
+    std::vector<std::string> const ips{"127.0.0.1", "10.1.2.3", "192.168.10.20", "2001:db8::1"};
+    std::size_t index = 0;
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(guard.request(ips[index++ % ips.size()]));
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DOSGuardWhitelistedRequest)->ThreadRange(1, 16)->UseRealTime();
+
+/**
+ * @brief Look up addresses in a whitelist of the given number of /24 IPv4 and /48 IPv6 networks; half of the looked up
+ * addresses are whitelisted.
+ */
+static void
+BM_WhitelistLookup(benchmark::State& state)
+{
+    auto const numNetworks = static_cast<std::size_t>(state.range(0));
+
+    web::Whitelist whitelist;
+    for (std::size_t i = 0; i < numNetworks; ++i) {
+        whitelist.add(fmt::format("10.{}.{}.0/24", (i >> 8) & 0xff, i & 0xff));
+        whitelist.add(fmt::format("2001:db8:{:x}::/48", i));
+    }
+
+    std::vector<web::IpKey> keys;
+    for (std::size_t i = 0; i < 64; ++i) {
+        auto const network = i * 7919 % numNetworks;
+        auto const firstOctet = i % 2 == 0 ? 10 : 11;
+        keys.push_back(web::makeIpKey(fmt::format("{}.{}.{}.7", firstOctet, (network >> 8) & 0xff, network & 0xff)));
+    }
+
+    std::size_t index = 0;
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(whitelist.isWhiteListed(keys[index++ % keys.size()]));
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WhitelistLookup)->Arg(16)->Arg(1024)->Arg(65536);
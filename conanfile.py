@@ -17,6 +17,9 @@ class Clio(ConanFile):
         'packaging': [True, False], # create distribution packages
         'coverage': [True, False],  # build for test coverage report; create custom target `clio_tests-ccov`
         'lint': [True, False],      # run clang-tidy checks during compilation
+        'loadgen': [True, False],   # build the load generator; create `clio_loadgen` binary
+        'benchmark': [True, False], # build microbenchmarks; create `clio_benchmarks` binary
+        'profiling': [True, False], # record profiling zones; compiled out when False
     }
 
     requires = [
@@ -27,6 +30,7 @@ class Clio(ConanFile):
         'grpc/1.50.1',
         'openssl/1.1.1u',
         'xrpl/2.0.0-b4',
+        'zstd/1.5.5',
     ]
 
     default_options = {
@@ -36,6 +40,9 @@ class Clio(ConanFile):
         'packaging': False,
         'coverage': False,
         'lint': False,
+        'loadgen': False,
+        'benchmark': False,
+        'profiling': True,
         'docs': False,
         
         'xrpl/*:tests': False,
@@ -49,6 +56,7 @@ class Clio(ConanFile):
         'protobuf/*:shared': False,
         'protobuf/*:with_zlib': True,
         'snappy/*:shared': False,
+        'zstd/*:shared': False,
         'gtest/*:no_main': True,
     }
 
@@ -59,6 +67,8 @@ class Clio(ConanFile):
     def requirements(self):
         if self.options.tests:
             self.requires('gtest/1.14.0')
+        if self.options.benchmark:
+            self.requires('benchmark/1.8.3')
 
     def configure(self):
         if self.settings.compiler == 'apple-clang':
@@ -78,6 +88,9 @@ class Clio(ConanFile):
         tc.variables['coverage'] = self.options.coverage
         tc.variables['lint'] = self.options.lint
         tc.variables['docs'] = self.options.docs
+        tc.variables['loadgen'] = self.options.loadgen
+        tc.variables['benchmark'] = self.options.benchmark
+        tc.variables['profiling'] = self.options.profiling
         tc.variables['packaging'] = self.options.packaging
         tc.generate()
 
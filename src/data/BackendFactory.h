@@ -21,6 +21,7 @@
 
 #include <data/BackendInterface.h>
 #include <data/CassandraBackend.h>
+#include <data/EmbeddedBackend.h>
 #include <util/config/Config.h>
 #include <util/log/Logger.h>
 
@@ -49,11 +50,41 @@ make_Backend(util::Config const& config)
     if (boost::iequals(type, "cassandra") or boost::iequals(type, "cassandra-new")) {
         auto cfg = config.section("database." + type);
         backend = std::make_shared<data::cassandra::CassandraBackend>(data::cassandra::SettingsProvider{cfg}, readOnly);
+    } else if (boost::iequals(type, "embedded")) {
+        auto const settings =
+            config.contains("database.embedded") ? embedded::Settings::fromConfig(config.section("database.embedded"))
+                                                 : embedded::Settings{};
+
+        // All the data is kept in RAM, so a writer without online_delete would grow until it runs out of memory
+        if (settings.onlineDelete == 0) {
+            if (not readOnly) {
+                throw std::runtime_error(
+                    "database.embedded.online_delete must be set: the embedded backend keeps all data in RAM"
+                );
+            }
+            LOG(log.warn()) << "database.embedded.online_delete is not set; all the data of the writer must fit in RAM";
+        }
+
+        backend = std::make_shared<data::embedded::EmbeddedBackend>(settings, readOnly);
     }
 
     if (!backend)
         throw std::runtime_error("Invalid database type");
 
+    if (config.valueOr("nft_index.enabled", false)) {
+        static constexpr std::size_t DEFAULT_MAX_COLLECTION_SIZE = 10000;
+        static constexpr std::size_t DEFAULT_MAX_TOKENS = 100000;
+        backend->nftIndex().enable(
+            config.valueOr("nft_index.max_collection_size", DEFAULT_MAX_COLLECTION_SIZE),
+            config.valueOr("nft_index.max_tokens", DEFAULT_MAX_TOKENS)
+        );
+    }
+
+    if (config.valueOr("balances_index.enabled", false)) {
+        static constexpr std::size_t DEFAULT_MAX_ACCOUNTS = 1000;
+        backend->balancesIndex().enable(config.valueOr("balances_index.max_accounts", DEFAULT_MAX_ACCOUNTS));
+    }
+
     auto const rng = backend->hardFetchLedgerRangeNoThrow();
     if (rng) {
         backend->updateRange(rng->minSequence);
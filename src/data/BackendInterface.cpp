@@ -19,6 +19,8 @@
 
 #include <data/BackendInterface.h>
 #include <util/log/Logger.h>
+#include <util/profiling/Profiling.h>
+#include <util/trace/Trace.h>
 
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/STLedgerEntry.h>
@@ -61,18 +63,23 @@ BackendInterface::fetchLedgerObject(
     boost::asio::yield_context yield
 ) const
 {
+    util::trace::Span span{"backend.fetchLedgerObject"};
+
     auto obj = cache_.get(key, sequence);
     if (obj) {
         LOG(gLog.trace()) << "Cache hit - " << ripple::strHex(key);
+        span.setAttribute("cache", "hit");
         return *obj;
     }
 
     LOG(gLog.trace()) << "Cache miss - " << ripple::strHex(key);
+    span.setAttribute("cache", "miss");
     auto dbObj = doFetchLedgerObject(key, sequence, yield);
     if (!dbObj) {
         LOG(gLog.trace()) << "Missed cache and missed in db";
     } else {
         LOG(gLog.trace()) << "Missed cache but found in db";
+        cache_.put(key, sequence, *dbObj);
     }
     return dbObj;
 }
@@ -84,6 +91,8 @@ BackendInterface::fetchLedgerObjects(
     boost::asio::yield_context yield
 ) const
 {
+    util::trace::Span span{"backend.fetchLedgerObjects"};
+
     std::vector<Blob> results;
     results.resize(keys.size());
     std::vector<ripple::uint256> misses;
@@ -97,11 +106,17 @@ BackendInterface::fetchLedgerObjects(
     }
     LOG(gLog.trace()) << "Cache hits = " << keys.size() - misses.size() << " - cache misses = " << misses.size();
 
+    if (span.isRecording()) {
+        span.setAttribute("keys", std::to_string(keys.size()));
+        span.setAttribute("cache_misses", std::to_string(misses.size()));
+    }
+
     if (!misses.empty()) {
         auto objs = doFetchLedgerObjects(misses, sequence, yield);
         for (size_t i = 0, j = 0; i < results.size(); ++i) {
             if (results[i].empty()) {
                 results[i] = objs[j];
+                cache_.put(keys[i], sequence, results[i]);
                 ++j;
             }
         }
@@ -109,6 +124,73 @@ BackendInterface::fetchLedgerObjects(
 
     return results;
 }
+
+std::optional<NFT>
+BackendInterface::fetchNFT(
+    ripple::uint256 const& tokenID,
+    std::uint32_t const ledgerSequence,
+    boost::asio::yield_context yield
+) const
+{
+    util::trace::Span span{"backend.fetchNFT"};
+
+    if (auto nft = nftIndex_.getNFT(tokenID, ledgerSequence); nft) {
+        LOG(gLog.trace()) << "NFT index hit - " << ripple::strHex(tokenID);
+        span.setAttribute("cache", "hit");
+        return nft;
+    }
+
+    span.setAttribute("cache", "miss");
+
+    auto nft = doFetchNFT(tokenID, ledgerSequence, yield);
+    if (nft)
+        nftIndex_.put(*nft, ledgerSequence);
+
+    return nft;
+}
+
+NFTsAndCursor
+BackendInterface::fetchNFTsByIssuer(
+    ripple::AccountID const& issuer,
+    std::optional<std::uint32_t> const& taxon,
+    std::uint32_t const ledgerSequence,
+    std::uint32_t const limit,
+    std::optional<ripple::uint256> const& cursorIn,
+    boost::asio::yield_context yield
+) const
+{
+    util::trace::Span span{"backend.fetchNFTsByIssuer"};
+
+    if (nftIndex_.shouldLoadIssuer(issuer, ledgerSequence)) {
+        static constexpr std::uint32_t LOAD_PAGE_SIZE = 256;
+
+        std::vector<NFT> nfts;
+        std::optional<ripple::uint256> cursor;
+        do {
+            auto page = doFetchNFTsByIssuer(issuer, std::nullopt, ledgerSequence, LOAD_PAGE_SIZE, cursor, yield);
+            nfts.insert(nfts.end(), page.nfts.begin(), page.nfts.end());
+            cursor = page.cursor;
+        } while (cursor and nfts.size() <= nftIndex_.maxIssuerTokens());
+
+        if (cursor or nfts.size() > nftIndex_.maxIssuerTokens()) {
+            LOG(gLog.debug()) << "Too many NFTs to index issuer " << ripple::toBase58(issuer);
+            nftIndex_.skipIssuer(issuer);
+        } else {
+            nftIndex_.putIssuer(issuer, nfts, ledgerSequence);
+        }
+    }
+
+    if (auto page = nftIndex_.getNFTsByIssuer(issuer, taxon, ledgerSequence, limit, cursorIn); page) {
+        LOG(gLog.trace()) << "NFT index hit - " << ripple::toBase58(issuer);
+        span.setAttribute("cache", "hit");
+        return std::move(*page);
+    }
+
+    span.setAttribute("cache", "miss");
+
+    return doFetchNFTsByIssuer(issuer, taxon, ledgerSequence, limit, cursorIn, yield);
+}
+
 // Fetches the successor to key/index
 std::optional<ripple::uint256>
 BackendInterface::fetchSuccessorKey(
@@ -117,11 +199,15 @@ BackendInterface::fetchSuccessorKey(
     boost::asio::yield_context yield
 ) const
 {
+    util::trace::Span span{"backend.fetchSuccessorKey"};
+
     auto succ = cache_.getSuccessor(key, ledgerSequence);
     if (succ) {
         LOG(gLog.trace()) << "Cache hit - " << ripple::strHex(key);
+        span.setAttribute("cache", "hit");
     } else {
         LOG(gLog.trace()) << "Cache miss - " << ripple::strHex(key);
+        span.setAttribute("cache", "miss");
     }
     return succ ? succ->key : doFetchSuccessorKey(key, ledgerSequence, yield);
 }
@@ -152,66 +238,75 @@ BackendInterface::fetchBookOffers(
     boost::asio::yield_context yield
 ) const
 {
+    util::trace::Span const span{"backend.fetchBookOffers"};
+
     // TODO try to speed this up. This can take a few seconds. The goal is
     // to get it down to a few hundred milliseconds.
     BookOffersPage page;
     const ripple::uint256 bookEnd = ripple::getQualityNext(book);
     ripple::uint256 uTipIndex = book;
     std::vector<ripple::uint256> keys;
-    auto getMillis = [](auto diff) { return std::chrono::duration_cast<std::chrono::milliseconds>(diff).count(); };
-    auto begin = std::chrono::system_clock::now();
     std::uint32_t numSucc = 0;
     std::uint32_t numPages = 0;
     long succMillis = 0;
     long pageMillis = 0;
-    while (keys.size() < limit) {
-        auto mid1 = std::chrono::system_clock::now();
-        auto offerDir = fetchSuccessorObject(uTipIndex, ledgerSequence, yield);
-        auto mid2 = std::chrono::system_clock::now();
-        numSucc++;
-        succMillis += getMillis(mid2 - mid1);
-        if (!offerDir || offerDir->key >= bookEnd) {
-            LOG(gLog.trace()) << "offerDir.has_value() " << offerDir.has_value() << " breaking";
-            break;
-        }
-        uTipIndex = offerDir->key;
+
+    static util::profiling::Zone const directoriesZone{"backend.book_offers.directories"};
+    static util::profiling::Zone const successorZone{"backend.book_offers.successor"};
+    static util::profiling::Zone const pagesZone{"backend.book_offers.pages"};
+    static util::profiling::Zone const objectsZone{"backend.book_offers.objects"};
+
+    auto const dirMillis = util::profiling::timed(directoriesZone, [&]() {
         while (keys.size() < limit) {
-            ++numPages;
-            ripple::STLedgerEntry const sle{
-                ripple::SerialIter{offerDir->blob.data(), offerDir->blob.size()}, offerDir->key};
-            auto indexes = sle.getFieldV256(ripple::sfIndexes);
-            keys.insert(keys.end(), indexes.begin(), indexes.end());
-            auto next = sle.getFieldU64(ripple::sfIndexNext);
-            if (next == 0u) {
-                LOG(gLog.trace()) << "Next is empty. breaking";
+            auto [offerDir, millis] = util::profiling::timed(successorZone, [&]() {
+                return fetchSuccessorObject(uTipIndex, ledgerSequence, yield);
+            });
+            numSucc++;
+            succMillis += millis;
+            if (!offerDir || offerDir->key >= bookEnd) {
+                LOG(gLog.trace()) << "offerDir.has_value() " << offerDir.has_value() << " breaking";
                 break;
             }
-            auto nextKey = ripple::keylet::page(uTipIndex, next);
-            auto nextDir = fetchLedgerObject(nextKey.key, ledgerSequence, yield);
-            assert(nextDir);
-            offerDir->blob = *nextDir;
-            offerDir->key = nextKey.key;
+            uTipIndex = offerDir->key;
+
+            util::profiling::ScopedZone const pagesScope{pagesZone};
+            while (keys.size() < limit) {
+                ++numPages;
+                ripple::STLedgerEntry const sle{
+                    ripple::SerialIter{offerDir->blob.data(), offerDir->blob.size()}, offerDir->key};
+                auto indexes = sle.getFieldV256(ripple::sfIndexes);
+                keys.insert(keys.end(), indexes.begin(), indexes.end());
+                auto next = sle.getFieldU64(ripple::sfIndexNext);
+                if (next == 0u) {
+                    LOG(gLog.trace()) << "Next is empty. breaking";
+                    break;
+                }
+                auto nextKey = ripple::keylet::page(uTipIndex, next);
+                auto nextDir = fetchLedgerObject(nextKey.key, ledgerSequence, yield);
+                assert(nextDir);
+                offerDir->blob = *nextDir;
+                offerDir->key = nextKey.key;
+            }
+            pageMillis += std::chrono::duration_cast<std::chrono::milliseconds>(pagesScope.elapsed()).count();
         }
-        auto mid3 = std::chrono::system_clock::now();
-        pageMillis += getMillis(mid3 - mid2);
-    }
-    auto mid = std::chrono::system_clock::now();
-    auto objs = fetchLedgerObjects(keys, ledgerSequence, yield);
+    });
+
+    auto const [objs, objectsMillis] =
+        util::profiling::timed(objectsZone, [&]() { return fetchLedgerObjects(keys, ledgerSequence, yield); });
     for (size_t i = 0; i < keys.size() && i < limit; ++i) {
         LOG(gLog.trace()) << "Key = " << ripple::strHex(keys[i]) << " blob = " << ripple::strHex(objs[i])
                           << " ledgerSequence = " << ledgerSequence;
         assert(!objs[i].empty());
         page.offers.push_back({keys[i], objs[i]});
     }
-    auto end = std::chrono::system_clock::now();
-    LOG(gLog.debug()) << "Fetching " << std::to_string(keys.size()) << " offers took "
-                      << std::to_string(getMillis(mid - begin)) << " milliseconds. Fetching next dir took "
-                      << std::to_string(succMillis) << " milliseonds. Fetched next dir " << std::to_string(numSucc)
-                      << " times"
+    LOG(gLog.debug()) << "Fetching " << std::to_string(keys.size()) << " offers took " << std::to_string(dirMillis)
+                      << " milliseconds. Fetching next dir took " << std::to_string(succMillis)
+                      << " milliseonds. Fetched next dir " << std::to_string(numSucc) << " times"
                       << " Fetching next page of dir took " << std::to_string(pageMillis) << " milliseconds"
                       << ". num pages = " << std::to_string(numPages) << ". Fetching all objects took "
-                      << std::to_string(getMillis(end - mid))
-                      << " milliseconds. total time = " << std::to_string(getMillis(end - begin)) << " milliseconds"
+                      << std::to_string(objectsMillis)
+                      << " milliseconds. total time = " << std::to_string(dirMillis + objectsMillis)
+                      << " milliseconds"
                       << " book = " << ripple::strHex(book);
 
     return page;
@@ -251,6 +346,8 @@ BackendInterface::fetchLedgerPage(
     boost::asio::yield_context yield
 ) const
 {
+    util::trace::Span const span{"backend.fetchLedgerPage"};
+
     LedgerPage page;
 
     std::vector<ripple::uint256> keys;
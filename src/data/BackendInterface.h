@@ -19,8 +19,10 @@
 
 #pragma once
 
+#include <data/BalancesIndex.h>
 #include <data/DBHelpers.h>
 #include <data/LedgerCache.h>
+#include <data/NFTIndex.h>
 #include <data/Types.h>
 #include <util/config/Config.h>
 #include <util/log/Logger.h>
@@ -122,6 +124,8 @@ protected:
     mutable std::shared_mutex rngMtx_;
     std::optional<LedgerRange> range;
     LedgerCache cache_;
+    NFTIndex nftIndex_;
+    BalancesIndex balancesIndex_;
 
 public:
     BackendInterface() = default;
@@ -146,6 +150,42 @@ public:
         return cache_;
     }
 
+    /**
+     * @return Immutable NFT index
+     */
+    NFTIndex const&
+    nftIndex() const
+    {
+        return nftIndex_;
+    }
+
+    /**
+     * @return Mutable NFT index
+     */
+    NFTIndex&
+    nftIndex()
+    {
+        return nftIndex_;
+    }
+
+    /**
+     * @return Immutable balances index
+     */
+    BalancesIndex const&
+    balancesIndex() const
+    {
+        return balancesIndex_;
+    }
+
+    /**
+     * @return Mutable balances index
+     */
+    BalancesIndex&
+    balancesIndex()
+    {
+        return balancesIndex_;
+    }
+
     /**
      * @brief Fetches a specific ledger by sequence number.
      *
@@ -263,13 +303,27 @@ public:
     /**
      * @brief Fetches a specific NFT.
      *
+     * The NFT index is consulted first, if enabled; the database is read otherwise and the result offered to the index.
+     *
+     * @param tokenID The ID of the NFT
+     * @param ledgerSequence The ledger sequence to fetch for
+     * @param yield The coroutine context
+     * @return NFT object on success; nullopt otherwise
+     */
+    std::optional<NFT>
+    fetchNFT(ripple::uint256 const& tokenID, std::uint32_t ledgerSequence, boost::asio::yield_context yield) const;
+
+    /**
+     * @brief Database-specific implementation of fetching a specific NFT.
+     *
      * @param tokenID The ID of the NFT
      * @param ledgerSequence The ledger sequence to fetch for
      * @param yield The coroutine context
      * @return NFT object on success; nullopt otherwise
      */
     virtual std::optional<NFT>
-    fetchNFT(ripple::uint256 const& tokenID, std::uint32_t ledgerSequence, boost::asio::yield_context yield) const = 0;
+    doFetchNFT(ripple::uint256 const& tokenID, std::uint32_t ledgerSequence, boost::asio::yield_context yield)
+        const = 0;
 
     /**
      * @brief Fetches all transactions for a specific NFT.
@@ -293,6 +347,9 @@ public:
     /**
      * @brief Fetches all NFTs issued by a given address.
      *
+     * If the NFT index is enabled, the first request for the latest ledger reads all the tokens of the issuer to index
+     * them, unless it has too many; later requests for the latest ledger are then served from the index.
+     *
      * @param issuer AccountID of issuer you wish you query.
      * @param taxon Optional taxon of NFTs by which you wish to filter.
      * @param limit Paging limit.
@@ -302,7 +359,7 @@ public:
      * @return std::vector<NFT> of NFTs issued by this account, or
      * this issuer/taxon combination if taxon is passed and an optional marker
      */
-    virtual NFTsAndCursor
+    NFTsAndCursor
     fetchNFTsByIssuer(
         ripple::AccountID const& issuer,
         std::optional<std::uint32_t> const& taxon,
@@ -310,6 +367,28 @@ public:
         std::uint32_t limit,
         std::optional<ripple::uint256> const& cursorIn,
         boost::asio::yield_context yield
+    ) const;
+
+    /**
+     * @brief Database-specific implementation of fetching all NFTs issued by a given address.
+     *
+     * @param issuer AccountID of issuer you wish you query.
+     * @param taxon Optional taxon of NFTs by which you wish to filter.
+     * @param limit Paging limit.
+     * @param cursorIn Optional cursor to allow us to pick up from where we
+     * last left off.
+     * @param yield Currently executing coroutine.
+     * @return std::vector<NFT> of NFTs issued by this account, or
+     * this issuer/taxon combination if taxon is passed and an optional marker
+     */
+    virtual NFTsAndCursor
+    doFetchNFTsByIssuer(
+        ripple::AccountID const& issuer,
+        std::optional<std::uint32_t> const& taxon,
+        std::uint32_t ledgerSequence,
+        std::uint32_t limit,
+        std::optional<ripple::uint256> const& cursorIn,
+        boost::asio::yield_context yield
     ) const = 0;
 
     /**
@@ -399,6 +478,30 @@ public:
         boost::asio::yield_context yield
     ) const;
 
+    /**
+     * @brief Fetches a page of a scan over the ledger objects of a range, in no particular order.
+     *
+     * Unlike @ref fetchLedgerPage this reads the objects in bulk rather than walking the successor chain, so it is the
+     * fastest way to read the whole state when the order of the objects doesn't matter. Only the latest version of each
+     * object at or below the given sequence is returned and deleted objects are skipped, so a page may hold fewer than
+     * limit objects or even none while the scan is not over.
+     *
+     * @param range The range to scan
+     * @param cursor The cursor returned by the previous page of the same scan; nullopt to start the scan
+     * @param ledgerSequence The ledger sequence to fetch for
+     * @param limit The maximum number of objects to read per page
+     * @param yield The coroutine context
+     * @return The page; its cursor is nullopt if the range was scanned completely
+     */
+    virtual LedgerScanPage
+    fetchLedgerScanPage(
+        ScanRange const& range,
+        std::optional<std::string> const& cursor,
+        std::uint32_t ledgerSequence,
+        std::uint32_t limit,
+        boost::asio::yield_context yield
+    ) const = 0;
+
     /**
      * @brief Fetches the successor object.
      *
@@ -0,0 +1,388 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <data/BalancesIndex.h>
+
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/SField.h>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/Serializer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace data {
+
+namespace {
+
+enum class BalanceType { Asset, Frozen, Obligation };
+
+struct Contribution {
+    BalanceType type;
+    ripple::AccountID peer;
+    ripple::STAmount amount;
+};
+
+ripple::AccountID const&
+peerOf(ripple::AccountID const& account, TrustLineState const& line)
+{
+    return line.lowLimit.getIssuer() == account ? line.highLimit.getIssuer() : line.lowLimit.getIssuer();
+}
+
+// mirrors how gateway_balances classifies a trust line when no hot wallet is given
+std::optional<Contribution>
+contributionOf(ripple::AccountID const& account, TrustLineState const& line)
+{
+    auto const viewLowest = line.lowLimit.getIssuer() == account;
+    auto balance = line.balance;
+    if (!viewLowest)
+        balance.negate();
+
+    auto const balSign = balance.signum();
+    if (balSign == 0)
+        return std::nullopt;
+
+    auto const& peer = viewLowest ? line.highLimit.getIssuer() : line.lowLimit.getIssuer();
+    auto const freeze = line.flags & (viewLowest ? ripple::lsfLowFreeze : ripple::lsfHighFreeze);
+
+    if (balSign > 0)
+        return Contribution{BalanceType::Asset, peer, balance};
+
+    if (freeze != 0u)
+        return Contribution{BalanceType::Frozen, peer, -balance};
+
+    return Contribution{BalanceType::Obligation, peer, -balance};
+}
+
+// adds one more line to the running total of a currency, like gateway_balances in rippled
+void
+accumulate(ripple::STAmount& total, ripple::STAmount const& amount)
+{
+    if (total == beast::zero) {
+        // This is needed to set the currency code correctly
+        total = amount;
+        return;
+    }
+
+    try {
+        total += amount;
+    } catch (std::runtime_error const&) {
+        // Presumably the exception was caused by overflow; return the largest valid amount then, as rippled does
+        total = ripple::STAmount(total.issue(), ripple::STAmount::cMaxValue, ripple::STAmount::cMaxOffset);
+    }
+}
+
+// the state of a RippleState affected node of a transaction metadata, before or after the transaction
+std::optional<TrustLineState>
+trustLineStateOf(ripple::STObject const& node, bool before)
+{
+    auto const& nodeType = node.getFName();
+    if ((nodeType == ripple::sfCreatedNode && before) || (nodeType == ripple::sfDeletedNode && !before))
+        return std::nullopt;
+
+    auto const& fieldsName = nodeType == ripple::sfCreatedNode ? ripple::sfNewFields : ripple::sfFinalFields;
+    if (!node.isFieldPresent(fieldsName))
+        return std::nullopt;
+
+    auto const& fields = node.peekAtField(fieldsName).downcast<ripple::STObject>();
+    auto const* previousFields = before && node.isFieldPresent(ripple::sfPreviousFields)
+        ? &node.peekAtField(ripple::sfPreviousFields).downcast<ripple::STObject>()
+        : nullptr;
+
+    auto const holder = [&](ripple::SField const& field) -> ripple::STObject const* {
+        if (previousFields != nullptr && previousFields->isFieldPresent(field))
+            return previousFields;
+
+        return fields.isFieldPresent(field) ? &fields : nullptr;
+    };
+
+    auto const* low = holder(ripple::sfLowLimit);
+    auto const* high = holder(ripple::sfHighLimit);
+    if (low == nullptr || high == nullptr)
+        return std::nullopt;
+
+    TrustLineState state;
+    state.lowLimit = low->getFieldAmount(ripple::sfLowLimit);
+    state.highLimit = high->getFieldAmount(ripple::sfHighLimit);
+
+    // fields with default values are left out of the metadata
+    if (auto const* balance = holder(ripple::sfBalance); balance != nullptr) {
+        state.balance = balance->getFieldAmount(ripple::sfBalance);
+    } else {
+        state.balance = ripple::STAmount{ripple::Issue{state.lowLimit.getCurrency(), ripple::noAccount()}};
+    }
+
+    if (auto const* flags = holder(ripple::sfFlags); flags != nullptr)
+        state.flags = flags->getFieldU32(ripple::sfFlags);
+
+    return state;
+}
+
+}  // namespace
+
+TrustLineState
+TrustLineState::fromSLE(ripple::SLE const& sle)
+{
+    return TrustLineState{
+        sle.getFieldAmount(ripple::sfBalance),
+        sle.getFieldAmount(ripple::sfLowLimit),
+        sle.getFieldAmount(ripple::sfHighLimit),
+        sle.getFieldU32(ripple::sfFlags)
+    };
+}
+
+void
+IssuerBalances::add(ripple::AccountID const& account, TrustLineState const& line)
+{
+    auto const contribution = contributionOf(account, line);
+    if (!contribution)
+        return;
+
+    auto const& [type, peer, amount] = *contribution;
+    switch (type) {
+        case BalanceType::Asset:
+            assets[peer][amount.getCurrency()] = amount;
+            break;
+        case BalanceType::Frozen:
+            frozenBalances[peer][amount.getCurrency()] = amount;
+            break;
+        case BalanceType::Obligation:
+            accumulate(obligations[amount.getCurrency()], amount);
+            break;
+    }
+}
+
+IndexedBalances::IndexedBalances(ripple::AccountID const& account, std::vector<TrustLineState> const& lines)
+    : account_{account}
+{
+    for (auto const& line : lines)
+        addLine(line, nextPosition_++);
+}
+
+void
+IndexedBalances::addLine(TrustLineState const& line, std::uint64_t position)
+{
+    auto const contribution = contributionOf(account_, line);
+    positions_[{peerOf(account_, line), line.balance.getCurrency()}] = position;
+    if (!contribution)
+        return;
+
+    auto const& [type, peer, amount] = *contribution;
+    if (type != BalanceType::Obligation) {
+        balances_.add(account_, line);
+        return;
+    }
+
+    auto const currency = amount.getCurrency();
+    auto& owed = owed_[currency];
+    owed[position] = amount;
+
+    // a line added after all the others extends the total just like the next line of a full walk does
+    if (owed.rbegin()->first == position and not stale_.contains(currency)) {
+        accumulate(balances_.obligations[currency], amount);
+    } else {
+        stale_.insert(currency);
+    }
+}
+
+void
+IndexedBalances::apply(std::optional<TrustLineState> const& before, std::optional<TrustLineState> const& after)
+{
+    auto const& line = before ? *before : *after;
+    auto const key = LineKey{peerOf(account_, line), line.balance.getCurrency()};
+
+    auto position = nextPosition_;
+    if (auto const it = positions_.find(key); it != positions_.end()) {
+        position = it->second;
+        positions_.erase(it);
+    }
+
+    if (before) {
+        if (auto const contribution = contributionOf(account_, *before); contribution) {
+            auto const& [type, peer, amount] = *contribution;
+            auto const erase = [&](IssuerBalances::PeerBalances& balances) {
+                if (auto const it = balances.find(peer); it != balances.end()) {
+                    it->second.erase(amount.getCurrency());
+                    if (it->second.empty())
+                        balances.erase(it);
+                }
+            };
+
+            switch (type) {
+                case BalanceType::Asset:
+                    erase(balances_.assets);
+                    break;
+                case BalanceType::Frozen:
+                    erase(balances_.frozenBalances);
+                    break;
+                case BalanceType::Obligation: {
+                    auto const currency = amount.getCurrency();
+                    auto const it = owed_.find(currency);
+                    if (it == owed_.end() or it->second.erase(position) == 0)
+                        break;
+
+                    if (it->second.empty()) {
+                        owed_.erase(it);
+                        balances_.obligations.erase(currency);
+                        stale_.erase(currency);
+                    } else {
+                        stale_.insert(currency);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    if (after) {
+        if (position == nextPosition_)
+            ++nextPosition_;
+        addLine(*after, position);
+    }
+}
+
+void
+IndexedBalances::refresh()
+{
+    for (auto const& currency : stale_) {
+        auto& total = balances_.obligations[currency];
+        total = ripple::STAmount{};
+        for (auto const& [_, amount] : owed_.at(currency))
+            accumulate(total, amount);
+    }
+
+    stale_.clear();
+}
+
+void
+BalancesIndex::enable(std::size_t maxAccounts)
+{
+    std::scoped_lock const lck{mtx_};
+    maxAccounts_ = maxAccounts;
+    enabled_ = true;
+}
+
+bool
+BalancesIndex::isEnabled() const
+{
+    return enabled_;
+}
+
+void
+BalancesIndex::update(std::vector<TransactionAndMetadata> const& transactions, std::uint32_t seq)
+{
+    if (not enabled_)
+        return;
+
+    struct Change {
+        std::uint32_t transactionIndex;
+        std::optional<TrustLineState> before;
+        std::optional<TrustLineState> after;
+    };
+
+    std::vector<Change> changes;
+    for (auto const& tx : transactions) {
+        ripple::SerialIter it{tx.metadata.data(), tx.metadata.size()};
+        ripple::STObject const meta{it, ripple::sfMetadata};
+        auto const transactionIndex = meta.getFieldU32(ripple::sfTransactionIndex);
+
+        for (auto const& node : meta.getFieldArray(ripple::sfAffectedNodes)) {
+            if (node.getFieldU16(ripple::sfLedgerEntryType) != ripple::ltRIPPLE_STATE)
+                continue;
+
+            changes.push_back({transactionIndex, trustLineStateOf(node, true), trustLineStateOf(node, false)});
+        }
+    }
+
+    // the changes of the same trust line must be replayed in the order of the transactions
+    std::stable_sort(changes.begin(), changes.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.transactionIndex < rhs.transactionIndex;
+    });
+
+    std::scoped_lock const lck{mtx_};
+    if (latestSeq_ != 0 and seq != latestSeq_ + 1)
+        accounts_.clear();
+    latestSeq_ = seq;
+
+    if (accounts_.empty())
+        return;
+
+    std::set<ripple::AccountID> touched;
+    for (auto const& [_, before, after] : changes) {
+        auto const& line = before ? *before : *after;
+        for (auto const& account : {line.lowLimit.getIssuer(), line.highLimit.getIssuer()}) {
+            auto const it = accounts_.find(account);
+            if (it == accounts_.end())
+                continue;
+
+            it->second.apply(before, after);
+            touched.insert(account);
+        }
+    }
+
+    for (auto const& account : touched)
+        accounts_.at(account).refresh();
+}
+
+std::uint32_t
+BalancesIndex::latestLedgerSequence() const
+{
+    std::shared_lock const lck{mtx_};
+    return latestSeq_;
+}
+
+std::optional<IssuerBalances>
+BalancesIndex::get(ripple::AccountID const& account, std::uint32_t seq) const
+{
+    if (not enabled_)
+        return std::nullopt;
+
+    std::shared_lock const lck{mtx_};
+    if (seq != latestSeq_)
+        return std::nullopt;
+
+    if (auto const it = accounts_.find(account); it != accounts_.end())
+        return it->second.balances();
+
+    return std::nullopt;
+}
+
+void
+BalancesIndex::put(ripple::AccountID const& account, std::vector<TrustLineState> const& lines, std::uint32_t seq) const
+{
+    if (not enabled_)
+        return;
+
+    std::scoped_lock const lck{mtx_};
+    if (seq == latestSeq_ and accounts_.size() < maxAccounts_ and not accounts_.contains(account))
+        accounts_.try_emplace(account, account, lines);
+}
+
+std::size_t
+BalancesIndex::size() const
+{
+    std::shared_lock const lck{mtx_};
+    return accounts_.size();
+}
+
+}  // namespace data
@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <data/Types.h>
+
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/UintTypes.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief The fields of a trust line that matter to the balances of the accounts on both sides of it.
+ */
+struct TrustLineState {
+    ripple::STAmount balance;
+    ripple::STAmount lowLimit;
+    ripple::STAmount highLimit;
+    std::uint32_t flags = 0;
+
+    /**
+     * @brief Read the state of a trust line from its ledger object.
+     *
+     * @param sle The RippleState ledger object
+     * @return The state of the trust line
+     */
+    static TrustLineState
+    fromSLE(ripple::SLE const& sle);
+};
+
+/**
+ * @brief The balances of an account as reported by gateway_balances when no hot wallet is given.
+ *
+ * Obligations are summed like rippled does: a running amount per currency that every trust line is added to in the
+ * order of the owner directory, rounding at each step and capped at the largest amount if it overflows. The result
+ * depends on that order, so the trust lines must be added in the order they are walked.
+ */
+struct IssuerBalances {
+    using PeerBalances = std::map<ripple::AccountID, std::map<ripple::Currency, ripple::STAmount>>;
+
+    std::map<ripple::Currency, ripple::STAmount> obligations;
+    PeerBalances assets;
+    PeerBalances frozenBalances;
+
+    /**
+     * @brief Add the contribution of the next trust line of the account.
+     *
+     * @param account The account the balances are of
+     * @param line The trust line
+     */
+    void
+    add(ripple::AccountID const& account, TrustLineState const& line);
+
+    bool
+    operator==(IssuerBalances const&) const = default;
+};
+
+/**
+ * @brief The balances of an indexed account together with what is needed to update them like a full walk would.
+ *
+ * Every trust line keeps its position in the owner directory, where new lines are appended and removed ones leave the
+ * others in place. The amounts owed on each line are kept in that order, so the total of a currency is extended in
+ * place when its last line is added and summed again from its lines when any other line changes.
+ */
+class IndexedBalances {
+    using LineKey = std::pair<ripple::AccountID, ripple::Currency>;
+
+    ripple::AccountID account_;
+    IssuerBalances balances_;
+    std::uint64_t nextPosition_ = 0;
+    std::map<LineKey, std::uint64_t> positions_;
+    std::map<ripple::Currency, std::map<std::uint64_t, ripple::STAmount>> owed_;
+    std::set<ripple::Currency> stale_;
+
+public:
+    /**
+     * @brief Index the balances of an account.
+     *
+     * @param account The account
+     * @param lines All its trust lines, in the order of its owner directory
+     */
+    IndexedBalances(ripple::AccountID const& account, std::vector<TrustLineState> const& lines);
+
+    /**
+     * @brief Apply the change of one of the trust lines of the account.
+     *
+     * @param before The trust line before the change; nullopt if it was created
+     * @param after The trust line after the change; nullopt if it was deleted
+     */
+    void
+    apply(std::optional<TrustLineState> const& before, std::optional<TrustLineState> const& after);
+
+    /**
+     * @brief Sum again the totals of the currencies whose lines changed other than at the end.
+     *
+     * Called once all the changes of a ledger were applied, so a total is summed at most once per ledger.
+     */
+    void
+    refresh();
+
+    /**
+     * @return The balances
+     */
+    [[nodiscard]] IssuerBalances const&
+    balances() const
+    {
+        return balances_;
+    }
+
+private:
+    void
+    addLine(TrustLineState const& line, std::uint64_t position);
+};
+
+/**
+ * @brief In-memory balances of the accounts that are queried through gateway_balances, kept up to date with the trust
+ * line changes of every new ledger.
+ *
+ * An account enters the index when all its trust lines have been read for the latest ledger. From then on the metadata
+ * of each new ledger is used to replace the contribution of every trust line it changes, so the balances of the latest
+ * ledger are served without reading the trust lines again, and are the same as those of a full walk. Nothing is ever
+ * evicted; once the configured number of accounts is indexed, other accounts are always computed from the database.
+ *
+ * The index is disabled unless @ref enable is called. If a ledger is ever skipped, the index is cleared.
+ */
+class BalancesIndex {
+    std::atomic_bool enabled_ = false;
+    std::size_t maxAccounts_ = 0;
+
+    mutable std::shared_mutex mtx_;
+    std::uint32_t latestSeq_ = 0;
+    mutable std::unordered_map<ripple::AccountID, IndexedBalances, ripple::hardened_hash<>> accounts_;
+
+public:
+    /**
+     * @brief Start indexing.
+     *
+     * @param maxAccounts The maximum number of accounts to index
+     */
+    void
+    enable(std::size_t maxAccounts);
+
+    /**
+     * @return true if the index is enabled; false otherwise
+     */
+    bool
+    isEnabled() const;
+
+    /**
+     * @brief Apply the trust line changes of a new ledger.
+     *
+     * @param transactions All the transactions of the ledger, in any order
+     * @param seq The sequence of the ledger
+     */
+    void
+    update(std::vector<TransactionAndMetadata> const& transactions, std::uint32_t seq);
+
+    /**
+     * @return The latest ledger sequence the index is up to date with
+     */
+    std::uint32_t
+    latestLedgerSequence() const;
+
+    /**
+     * @brief Fetch the balances of an account.
+     *
+     * @param account The account
+     * @param seq The sequence to fetch for
+     * @return The balances if the account is indexed and seq is the latest sequence; nullopt otherwise
+     */
+    std::optional<IssuerBalances>
+    get(ripple::AccountID const& account, std::uint32_t seq) const;
+
+    /**
+     * @brief Offer all the trust lines of an account to index its balances; ignored unless they were read for the
+     * latest sequence.
+     *
+     * @param account The account
+     * @param lines All the trust lines of the account, in the order of its owner directory
+     * @param seq The sequence they were read for
+     */
+    void
+    put(ripple::AccountID const& account, std::vector<TrustLineState> const& lines, std::uint32_t seq) const;
+
+    /**
+     * @return The number of indexed accounts
+     */
+    std::size_t
+    size() const;
+};
+
+}  // namespace data
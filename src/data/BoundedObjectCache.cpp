@@ -0,0 +1,285 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <data/BoundedObjectCache.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace data {
+
+namespace {
+
+// used to size the frequency sketch for the number of objects that fit in the cache. Two counters per row for every
+// object, i.e. 8 bytes per object, keep collisions low enough for a scan not to drown the hot objects in noise.
+constexpr std::size_t AVERAGE_OBJECT_SIZE = 256;
+constexpr std::size_t SKETCH_WIDTH_PER_ENTRY = 2;
+constexpr std::size_t MIN_SKETCH_WIDTH = 64;
+
+}  // namespace
+
+BoundedObjectCache::FrequencySketch::FrequencySketch(std::size_t expectedEntries)
+    : mask_{std::bit_ceil(std::max(expectedEntries * SKETCH_WIDTH_PER_ENTRY, MIN_SKETCH_WIDTH)) - 1}
+    , sampleSize_{SAMPLE_FACTOR * (mask_ + 1)}
+    , table_(DEPTH * (mask_ + 1), 0)
+{
+}
+
+void
+BoundedObjectCache::FrequencySketch::increment(ripple::uint256 const& key)
+{
+    bool incremented = false;
+    for (std::size_t row = 0; row < DEPTH; ++row) {
+        auto& counter = table_[index(key, row)];
+        if (counter < MAX_COUNT) {
+            ++counter;
+            incremented = true;
+        }
+    }
+
+    if (incremented && ++additions_ >= sampleSize_)
+        halve();
+}
+
+std::uint8_t
+BoundedObjectCache::FrequencySketch::estimate(ripple::uint256 const& key) const
+{
+    auto result = MAX_COUNT;
+    for (std::size_t row = 0; row < DEPTH; ++row)
+        result = std::min(result, table_[index(key, row)]);
+    return result;
+}
+
+std::size_t
+BoundedObjectCache::FrequencySketch::index(ripple::uint256 const& key, std::size_t row) const
+{
+    // keys are hashes already, so each 64-bit word of the key serves as an independent hash for one row
+    static_assert(ripple::uint256::bytes >= DEPTH * sizeof(std::uint64_t));
+
+    std::uint64_t word = 0;
+    std::memcpy(&word, key.data() + row * sizeof(word), sizeof(word));
+    return row * (mask_ + 1) + (word & mask_);
+}
+
+void
+BoundedObjectCache::FrequencySketch::halve()
+{
+    for (auto& counter : table_)
+        counter >>= 1;
+    additions_ /= 2;
+}
+
+BoundedObjectCache::Shard::Shard(std::size_t maxBytes)
+    : maxWindowBytes_{maxBytes * WINDOW_PERCENT / 100}
+    , maxMainBytes_{maxBytes - maxWindowBytes_}
+    , sketch_{maxBytes / (AVERAGE_OBJECT_SIZE + ENTRY_OVERHEAD)}
+{
+}
+
+std::optional<Blob>
+BoundedObjectCache::Shard::get(ripple::uint256 const& key, std::uint32_t seq)
+{
+    std::scoped_lock const lck{mtx_};
+    sketch_.increment(key);
+
+    auto const it = index_.find(key);
+    if (it == index_.end() or seq < it->second->seq)
+        return {};
+
+    auto& list = it->second->inWindow ? window_ : main_;
+    list.splice(list.begin(), list, it->second);
+    return it->second->blob;
+}
+
+void
+BoundedObjectCache::Shard::put(ripple::uint256 const& key, std::uint32_t seq, Blob blob)
+{
+    std::scoped_lock const lck{mtx_};
+    if (index_.contains(key))
+        return;
+
+    window_.push_front({key, seq, std::move(blob)});
+    index_.emplace(key, window_.begin());
+    windowBytes_ += cost(window_.front());
+    evictFromWindow();
+    bytes_ = windowBytes_ + mainBytes_;
+}
+
+void
+BoundedObjectCache::Shard::update(ripple::uint256 const& key, std::uint32_t seq, Blob const& blob)
+{
+    std::scoped_lock const lck{mtx_};
+    auto const it = index_.find(key);
+    if (it == index_.end())
+        return;
+
+    auto& entry = *it->second;
+    if (blob.empty()) {
+        erase(it->second);
+        bytes_ = windowBytes_ + mainBytes_;
+        return;
+    }
+
+    if (seq <= entry.seq)
+        return;
+
+    auto& bytes = entry.inWindow ? windowBytes_ : mainBytes_;
+    bytes -= cost(entry);
+    entry.seq = seq;
+    entry.blob = blob;
+    bytes += cost(entry);
+
+    if (entry.inWindow) {
+        evictFromWindow();
+    } else {
+        evictFromMain();
+    }
+    bytes_ = windowBytes_ + mainBytes_;
+}
+
+std::size_t
+BoundedObjectCache::Shard::size() const
+{
+    std::scoped_lock const lck{mtx_};
+    return index_.size();
+}
+
+std::size_t
+BoundedObjectCache::Shard::bytes() const
+{
+    return bytes_;
+}
+
+std::size_t
+BoundedObjectCache::Shard::cost(Entry const& entry)
+{
+    return entry.blob.size() + ENTRY_OVERHEAD;
+}
+
+void
+BoundedObjectCache::Shard::erase(List::iterator it)
+{
+    if (it->inWindow) {
+        windowBytes_ -= cost(*it);
+        index_.erase(it->key);
+        window_.erase(it);
+    } else {
+        mainBytes_ -= cost(*it);
+        index_.erase(it->key);
+        main_.erase(it);
+    }
+}
+
+void
+BoundedObjectCache::Shard::evictFromWindow()
+{
+    while (windowBytes_ > maxWindowBytes_) {
+        auto const candidate = std::prev(window_.end());
+        if (not admit(*candidate)) {
+            erase(candidate);
+            continue;
+        }
+
+        windowBytes_ -= cost(*candidate);
+        mainBytes_ += cost(*candidate);
+        candidate->inWindow = false;
+        main_.splice(main_.begin(), window_, candidate);
+    }
+}
+
+void
+BoundedObjectCache::Shard::evictFromMain()
+{
+    while (mainBytes_ > maxMainBytes_)
+        erase(std::prev(main_.end()));
+}
+
+bool
+BoundedObjectCache::Shard::admit(Entry const& candidate)
+{
+    auto const candidateCost = cost(candidate);
+    if (candidateCost > maxMainBytes_)
+        return false;
+
+    auto const frequency = sketch_.estimate(candidate.key);
+    while (mainBytes_ + candidateCost > maxMainBytes_) {
+        auto const victim = std::prev(main_.end());
+        if (frequency <= sketch_.estimate(victim->key))
+            return false;
+        erase(victim);
+    }
+
+    return true;
+}
+
+BoundedObjectCache::BoundedObjectCache(std::size_t maxBytes, std::size_t shards)
+{
+    auto const count = std::clamp<std::size_t>(maxBytes / MIN_SHARD_BYTES, 1, std::max<std::size_t>(shards, 1));
+    shards_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        shards_.push_back(std::make_unique<Shard>(maxBytes / count));
+}
+
+std::optional<Blob>
+BoundedObjectCache::get(ripple::uint256 const& key, std::uint32_t seq)
+{
+    return shardFor(key).get(key, seq);
+}
+
+void
+BoundedObjectCache::put(ripple::uint256 const& key, std::uint32_t seq, Blob blob)
+{
+    shardFor(key).put(key, seq, std::move(blob));
+}
+
+void
+BoundedObjectCache::update(ripple::uint256 const& key, std::uint32_t seq, Blob const& blob)
+{
+    shardFor(key).update(key, seq, blob);
+}
+
+std::size_t
+BoundedObjectCache::size() const
+{
+    std::size_t result = 0;
+    for (auto const& shard : shards_)
+        result += shard->size();
+    return result;
+}
+
+std::size_t
+BoundedObjectCache::bytes() const
+{
+    std::size_t result = 0;
+    for (auto const& shard : shards_)
+        result += shard->bytes();
+    return result;
+}
+
+BoundedObjectCache::Shard&
+BoundedObjectCache::shardFor(ripple::uint256 const& key) const
+{
+    // the sketch hashes with the low bits of each word of the key, so the shard is picked with the high bits instead
+    return *shards_[key.data()[ripple::uint256::bytes - 1] % shards_.size()];
+}
+
+}  // namespace data
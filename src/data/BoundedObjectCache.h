@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <data/Types.h>
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/hardened_hash.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief A memory-capped cache of ledger objects for nodes that can't afford to keep the entire state in memory.
+ *
+ * Eviction follows W-TinyLFU: new objects enter a small LRU window and, once pushed out of it, are only admitted to
+ * the main LRU if they were requested more often than the object they would evict. Request frequencies are estimated
+ * with a count-min sketch that is periodically halved, so a scan over many cold keys can't flush out the hot ones.
+ *
+ * Every read updates the recency and frequency of its key, so the cache is split by key into shards that each have
+ * their own lists, sketch, mutex and share of the memory cap; concurrent requests only contend when their keys fall in
+ * the same shard.
+ *
+ * Every entry is tagged with the sequence it is known to be valid from and is valid for any later sequence until it is
+ * refreshed or erased by update(). Thread-safe.
+ */
+class BoundedObjectCache {
+public:
+    // approximate bookkeeping cost of one entry on top of its blob
+    static constexpr std::size_t ENTRY_OVERHEAD = 128;
+    static constexpr std::size_t WINDOW_PERCENT = 1;
+    static constexpr std::size_t DEFAULT_SHARDS = 16;
+    // smaller caches get fewer shards, so no shard is too small for its admission policy to work
+    static constexpr std::size_t MIN_SHARD_BYTES = 1024 * 1024;
+
+private:
+    /** @brief Count-min sketch of recent request frequencies with 4-bit saturating counters. */
+    class FrequencySketch {
+        static constexpr std::size_t DEPTH = 4;
+        static constexpr std::uint8_t MAX_COUNT = 15;
+        static constexpr std::size_t SAMPLE_FACTOR = 10;
+
+        std::size_t mask_;
+        std::size_t sampleSize_;
+        std::size_t additions_ = 0;
+        std::vector<std::uint8_t> table_;
+
+    public:
+        explicit FrequencySketch(std::size_t expectedEntries);
+
+        void
+        increment(ripple::uint256 const& key);
+
+        [[nodiscard]] std::uint8_t
+        estimate(ripple::uint256 const& key) const;
+
+    private:
+        [[nodiscard]] std::size_t
+        index(ripple::uint256 const& key, std::size_t row) const;
+
+        void
+        halve();
+    };
+
+    /** @brief A W-TinyLFU cache for the keys of one shard. */
+    class Shard {
+        struct Entry {
+            ripple::uint256 key;
+            std::uint32_t seq = 0;
+            Blob blob;
+            bool inWindow = true;
+        };
+
+        using List = std::list<Entry>;
+
+        std::size_t const maxWindowBytes_;
+        std::size_t const maxMainBytes_;
+        std::size_t windowBytes_ = 0;
+        std::size_t mainBytes_ = 0;
+        // the sum of both, readable without the lock
+        std::atomic_size_t bytes_ = 0;
+
+        List window_;
+        List main_;
+        std::unordered_map<ripple::uint256, List::iterator, ripple::hardened_hash<>> index_;
+        FrequencySketch sketch_;
+
+        mutable std::mutex mtx_;
+
+    public:
+        explicit Shard(std::size_t maxBytes);
+
+        std::optional<Blob>
+        get(ripple::uint256 const& key, std::uint32_t seq);
+
+        void
+        put(ripple::uint256 const& key, std::uint32_t seq, Blob blob);
+
+        void
+        update(ripple::uint256 const& key, std::uint32_t seq, Blob const& blob);
+
+        [[nodiscard]] std::size_t
+        size() const;
+
+        [[nodiscard]] std::size_t
+        bytes() const;
+
+    private:
+        [[nodiscard]] static std::size_t
+        cost(Entry const& entry);
+
+        void
+        erase(List::iterator it);
+
+        void
+        evictFromWindow();
+
+        void
+        evictFromMain();
+
+        [[nodiscard]] bool
+        admit(Entry const& candidate);
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+public:
+    /**
+     * @brief Create a new cache.
+     *
+     * @param maxBytes The memory cap, including the per-entry bookkeeping
+     * @param shards The number of shards to split the cache into; fewer are used if the cap is too small for them
+     */
+    explicit BoundedObjectCache(std::size_t maxBytes, std::size_t shards = DEFAULT_SHARDS);
+
+    /**
+     * @brief Fetch an object, recording the request for the admission policy whether it hits or not.
+     *
+     * @param key The key to fetch for
+     * @param seq The sequence to fetch for
+     * @return The cached Blob if it is valid for the sequence; nullopt otherwise
+     */
+    std::optional<Blob>
+    get(ripple::uint256 const& key, std::uint32_t seq);
+
+    /**
+     * @brief Offer an object fetched from the database to the cache.
+     *
+     * The object is always taken into the window but only reaches the main cache if the admission policy allows.
+     *
+     * @param key The key of the object
+     * @param seq The sequence the object was fetched for
+     * @param blob The object; must not be empty
+     */
+    void
+    put(ripple::uint256 const& key, std::uint32_t seq, Blob blob);
+
+    /**
+     * @brief Apply a change from a new ledger to an object if it is cached; objects not in the cache are ignored.
+     *
+     * @param key The key of the object
+     * @param seq The sequence of the new ledger
+     * @param blob The new version of the object or an empty blob if it was deleted
+     */
+    void
+    update(ripple::uint256 const& key, std::uint32_t seq, Blob const& blob);
+
+    /**
+     * @return The number of cached objects
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * @return The memory used by the cached objects, including the per-entry bookkeeping
+     */
+    [[nodiscard]] std::size_t
+    bytes() const;
+
+    /**
+     * @return The number of shards the cache is split into
+     */
+    [[nodiscard]] std::size_t
+    shardCount() const
+    {
+        return shards_.size();
+    }
+
+private:
+    [[nodiscard]] Shard&
+    shardFor(ripple::uint256 const& key) const;
+};
+
+}  // namespace data
@@ -0,0 +1,258 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <data/CacheCompressor.h>
+
+#include <boost/asio/post.hpp>
+#include <fmt/format.h>
+#include <zdict.h>
+#include <zstd.h>
+
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace data {
+
+namespace {
+
+// every serialized ledger object starts with the sfLedgerEntryType field: type UINT16 (1), field 1
+constexpr unsigned char LEDGER_ENTRY_TYPE_FIELD = 0x11;
+
+struct CCtxDeleter {
+    void
+    operator()(ZSTD_CCtx* ctx) const
+    {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct DCtxDeleter {
+    void
+    operator()(ZSTD_DCtx* ctx) const
+    {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+ZSTD_CCtx*
+compressionContext()
+{
+    thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> const ctx{ZSTD_createCCtx()};
+    return ctx.get();
+}
+
+ZSTD_DCtx*
+decompressionContext()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> const ctx{ZSTD_createDCtx()};
+    return ctx.get();
+}
+
+void
+throwIfError(std::size_t rc, std::string_view label)
+{
+    if (ZSTD_isError(rc) != 0u)
+        throw std::runtime_error(fmt::format("{}: {}", label, ZSTD_getErrorName(rc)));
+}
+
+}  // namespace
+
+void
+CacheCompressor::CDictDeleter::operator()(ZSTD_CDict_s* dict) const
+{
+    ZSTD_freeCDict(dict);
+}
+
+void
+CacheCompressor::DDictDeleter::operator()(ZSTD_DDict_s* dict) const
+{
+    ZSTD_freeDDict(dict);
+}
+
+CacheCompressor::CacheCompressor(int level) : level_{level}
+{
+}
+
+CacheCompressor::~CacheCompressor()
+{
+    trainer_.stop();
+    trainer_.join();
+}
+
+Blob
+CacheCompressor::compress(Blob const& blob)
+{
+    auto const type = entryType(blob);
+    auto const dict = dictionaryForType(type);
+    if (not dict)
+        addSample(type, blob);
+
+    // compressed into a reusable buffer first so that the stored blob doesn't keep the slack of the worst case bound
+    thread_local Blob buffer;
+    buffer.resize(ZSTD_compressBound(blob.size()));
+
+    auto const size = dict
+        ? ZSTD_compress_usingCDict(
+              compressionContext(), buffer.data(), buffer.size(), blob.data(), blob.size(), dict->compression.get()
+          )
+        : ZSTD_compressCCtx(compressionContext(), buffer.data(), buffer.size(), blob.data(), blob.size(), level_);
+    throwIfError(size, "Compress ledger object");
+
+    return Blob{buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(size)};
+}
+
+Blob
+CacheCompressor::decompress(Blob const& compressed) const
+{
+    Blob blob;
+    decompress(compressed, blob);
+    return blob;
+}
+
+void
+CacheCompressor::decompress(Blob const& compressed, Blob& out) const
+{
+    auto const contentSize = ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+    if (contentSize == ZSTD_CONTENTSIZE_ERROR or contentSize == ZSTD_CONTENTSIZE_UNKNOWN)
+        throw std::runtime_error("Decompress ledger object: not a compressed object");
+
+    out.resize(contentSize);
+    std::size_t size = 0;
+    if (auto const id = ZSTD_getDictID_fromFrame(compressed.data(), compressed.size()); id != 0u) {
+        std::shared_ptr<Dictionary const> dict;
+        {
+            std::shared_lock const lk(dictionariesMtx_);
+            dict = byId_.at(id);
+        }
+
+        size = ZSTD_decompress_usingDDict(
+            decompressionContext(),
+            out.data(),
+            out.size(),
+            compressed.data(),
+            compressed.size(),
+            dict->decompression.get()
+        );
+    } else {
+        size =
+            ZSTD_decompressDCtx(decompressionContext(), out.data(), out.size(), compressed.data(), compressed.size());
+    }
+
+    throwIfError(size, "Decompress ledger object");
+}
+
+void
+CacheCompressor::waitForTraining()
+{
+    std::unique_lock lk(trainingMtx_);
+    trainingCv_.wait(lk, [this]() { return pendingTrainings_ == 0; });
+}
+
+std::size_t
+CacheCompressor::numDictionaries() const
+{
+    std::shared_lock const lk(dictionariesMtx_);
+    return byId_.size();
+}
+
+std::uint16_t
+CacheCompressor::entryType(Blob const& blob)
+{
+    if (blob.size() < 3 or blob[0] != LEDGER_ENTRY_TYPE_FIELD)
+        return 0;
+
+    return static_cast<std::uint16_t>((blob[1] << 8) | blob[2]);
+}
+
+void
+CacheCompressor::addSample(std::uint16_t type, Blob const& blob)
+{
+    Blob bytes;
+    std::vector<std::size_t> sizes;
+    {
+        std::scoped_lock const lk(samplesMtx_);
+        auto& samples = samples_[type];
+        if (samples.done)
+            return;
+
+        samples.bytes.insert(samples.bytes.end(), blob.begin(), blob.end());
+        samples.sizes.push_back(blob.size());
+        if (samples.sizes.size() < SAMPLES_PER_DICTIONARY)
+            return;
+
+        // whatever the outcome of training, objects of this type are not sampled anymore
+        samples.done = true;
+        bytes = std::exchange(samples.bytes, {});
+        sizes = std::exchange(samples.sizes, {});
+    }
+
+    {
+        std::scoped_lock const lk(trainingMtx_);
+        ++pendingTrainings_;
+    }
+
+    // training takes a while; objects keep being compressed without a dictionary until it is published
+    boost::asio::post(trainer_, [this, type, bytes = std::move(bytes), sizes = std::move(sizes)]() {
+        train(type, bytes, sizes);
+
+        {
+            std::scoped_lock const lk(trainingMtx_);
+            --pendingTrainings_;
+        }
+        trainingCv_.notify_all();
+    });
+}
+
+void
+CacheCompressor::train(std::uint16_t type, Blob const& bytes, std::vector<std::size_t> const& sizes)
+{
+    Blob buffer(DICTIONARY_CAPACITY);
+    auto const size = ZDICT_trainFromBuffer(
+        buffer.data(), buffer.size(), bytes.data(), sizes.data(), static_cast<unsigned>(sizes.size())
+    );
+    if (ZDICT_isError(size) != 0u)
+        return;
+
+    auto const id = ZDICT_getDictID(buffer.data(), size);
+    if (id == 0u)
+        return;
+
+    auto dict = std::make_shared<Dictionary>();
+    dict->compression.reset(ZSTD_createCDict(buffer.data(), size, level_));
+    dict->decompression.reset(ZSTD_createDDict(buffer.data(), size));
+    if (not dict->compression or not dict->decompression)
+        return;
+
+    std::unique_lock const lk(dictionariesMtx_);
+    if (byId_.contains(id))
+        return;
+
+    byType_.emplace(type, dict);
+    byId_.emplace(id, std::move(dict));
+}
+
+std::shared_ptr<CacheCompressor::Dictionary const>
+CacheCompressor::dictionaryForType(std::uint16_t type) const
+{
+    std::shared_lock const lk(dictionariesMtx_);
+    auto const it = byType_.find(type);
+    return it == byType_.end() ? nullptr : it->second;
+}
+
+}  // namespace data
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#pragma once
+
+#include <data/Types.h>
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace data {
+
+/**
+ * @brief Compresses ledger objects kept in @ref LedgerCache with zstd.
+ *
+ * Objects of the same LedgerEntryType share most of their layout, so one dictionary is trained per type from the first
+ * `SAMPLES_PER_DICTIONARY` objects of that type seen by the cache. Training runs on a background thread and the new
+ * dictionary is only published once it is ready; objects compressed before that are compressed without one.
+ * Dictionaries are never replaced, and every compressed frame carries the id of the dictionary it needs, so any stored
+ * object can always be decompressed.
+ *
+ * Thread-safe: compress() and decompress() may be called concurrently from any thread.
+ */
+class CacheCompressor {
+public:
+    static constexpr std::size_t SAMPLES_PER_DICTIONARY = 1000;
+    static constexpr std::size_t DICTIONARY_CAPACITY = 16 * 1024;
+    static constexpr int DEFAULT_LEVEL = 3;
+
+private:
+    struct CDictDeleter {
+        void
+        operator()(ZSTD_CDict_s* dict) const;
+    };
+
+    struct DDictDeleter {
+        void
+        operator()(ZSTD_DDict_s* dict) const;
+    };
+
+    struct Dictionary {
+        std::unique_ptr<ZSTD_CDict_s, CDictDeleter> compression;
+        std::unique_ptr<ZSTD_DDict_s, DDictDeleter> decompression;
+    };
+
+    struct Samples {
+        Blob bytes;
+        std::vector<std::size_t> sizes;
+        bool done = false;
+    };
+
+    int level_;
+
+    std::mutex samplesMtx_;
+    std::unordered_map<std::uint16_t, Samples> samples_;
+
+    mutable std::shared_mutex dictionariesMtx_;
+    std::unordered_map<std::uint16_t, std::shared_ptr<Dictionary const>> byType_;
+    std::unordered_map<unsigned, std::shared_ptr<Dictionary const>> byId_;
+
+    std::mutex trainingMtx_;
+    std::condition_variable trainingCv_;
+    std::size_t pendingTrainings_ = 0;
+    boost::asio::thread_pool trainer_{1};
+
+public:
+    /**
+     * @brief Create a new compressor.
+     *
+     * @param level The zstd compression level to use
+     */
+    explicit CacheCompressor(int level = DEFAULT_LEVEL);
+
+    /** @brief Waits for the dictionary being trained, if any; dictionaries not started yet are abandoned. */
+    ~CacheCompressor();
+
+    CacheCompressor(CacheCompressor const&) = delete;
+    CacheCompressor&
+    operator=(CacheCompressor const&) = delete;
+
+    /**
+     * @brief Compress a ledger object.
+     *
+     * @param blob The serialized ledger object
+     * @return The compressed object, sized exactly to its content
+     */
+    [[nodiscard]] Blob
+    compress(Blob const& blob);
+
+    /**
+     * @brief Decompress a ledger object.
+     *
+     * @param compressed An object returned by compress()
+     * @return The serialized ledger object
+     */
+    [[nodiscard]] Blob
+    decompress(Blob const& compressed) const;
+
+    /**
+     * @brief Decompress a ledger object into a buffer, reusing its memory.
+     *
+     * @param compressed An object returned by compress()
+     * @param out Receives the serialized ledger object
+     */
+    void
+    decompress(Blob const& compressed, Blob& out) const;
+
+    /**
+     * @brief Block until every dictionary whose samples are complete has been trained.
+     */
+    void
+    waitForTraining();
+
+    /**
+     * @return The number of dictionaries trained so far
+     */
+    [[nodiscard]] std::size_t
+    numDictionaries() const;
+
+    /**
+     * @brief Read the LedgerEntryType of a serialized ledger object.
+     *
+     * @param blob The serialized ledger object
+     * @return The type of the object or 0 if the object doesn't start with its type
+     */
+    [[nodiscard]] static std::uint16_t
+    entryType(Blob const& blob);
+
+private:
+    void
+    addSample(std::uint16_t type, Blob const& blob);
+
+    void
+    train(std::uint16_t type, Blob const& bytes, std::vector<std::size_t> const& sizes);
+
+    [[nodiscard]] std::shared_ptr<Dictionary const>
+    dictionaryForType(std::uint16_t type) const;
+};
+
+}  // namespace data
@@ -26,9 +26,10 @@
 #include <data/cassandra/SettingsProvider.h>
 #include <data/cassandra/impl/ExecutionStrategy.h>
 #include <util/LedgerUtils.h>
-#include <util/Profiler.h>
 #include <util/log/Logger.h>
+#include <util/profiling/Profiling.h>
 
+#include <ripple/basics/hardened_hash.h>
 #include <ripple/protocol/LedgerHeader.h>
 #include <ripple/protocol/nft.h>
 #include <boost/asio/spawn.hpp>
@@ -170,7 +171,8 @@ public:
     bool
     doFinishWrites() override
     {
-        // wait for other threads to finish their writes
+        // send the partially filled batches and wait for other threads to finish their writes
+        executor_.flush();
         executor_.sync();
 
         if (!range) {
@@ -222,8 +224,8 @@ public:
         auto const res = executor_.read(yield, schema_->selectLedgerBySeq, sequence);
         if (res) {
             if (auto const& result = res.value(); result) {
-                if (auto const maybeValue = result.template get<std::vector<unsigned char>>(); maybeValue) {
-                    return util::deserializeHeader(ripple::makeSlice(*maybeValue));
+                if (auto const maybeValue = result.template get<BlobView>(); maybeValue) {
+                    return util::deserializeHeader(ripple::Slice{maybeValue->data(), maybeValue->size()});
                 }
 
                 LOG(log_.error()) << "Could not fetch ledger by sequence - no rows";
@@ -335,18 +337,22 @@ public:
     }
 
     std::optional<NFT>
-    fetchNFT(ripple::uint256 const& tokenID, std::uint32_t const ledgerSequence, boost::asio::yield_context yield)
+    doFetchNFT(ripple::uint256 const& tokenID, std::uint32_t const ledgerSequence, boost::asio::yield_context yield)
         const override
     {
-        auto const res = executor_.read(yield, schema_->selectNFT, tokenID, ledgerSequence);
-        if (not res)
-            return std::nullopt;
+        // the state and the URI don't depend on each other, so both are read at once
+        std::vector<Statement> statements;
+        statements.reserve(2);
+        statements.push_back(schema_->selectNFT.bind(tokenID, ledgerSequence));
+        statements.push_back(schema_->selectNFTURI.bind(tokenID, ledgerSequence));
+
+        auto const results = executor_.readEach(yield, statements);
 
-        if (auto const maybeRow = res->template get<uint32_t, ripple::AccountID, bool>(); maybeRow) {
+        if (auto const maybeRow = results.at(0).template get<uint32_t, ripple::AccountID, bool>(); maybeRow) {
             auto [seq, owner, isBurned] = *maybeRow;
             auto result = std::make_optional<NFT>(tokenID, seq, owner, isBurned);
 
-            // now fetch URI. Usually we will have the URI even for burned NFTs,
+            // Usually we will have the URI even for burned NFTs,
             // but if the first ledger on this clio included NFTokenBurn
             // transactions we will not have the URIs for any of those tokens.
             // In any other case not having the URI indicates something went
@@ -357,11 +363,8 @@ public:
             // a URI because it was burned in the first ledger) to indicate that
             // even though we are returning a blank URI, the NFT might have had
             // one.
-            auto uriRes = executor_.read(yield, schema_->selectNFTURI, tokenID, ledgerSequence);
-            if (uriRes) {
-                if (auto const maybeUri = uriRes->template get<ripple::Blob>(); maybeUri)
-                    result->uri = *maybeUri;
-            }
+            if (auto const maybeUri = results.at(1).template get<BlobView>(); maybeUri)
+                result->uri = Blob{maybeUri->begin(), maybeUri->end()};
 
             return result;
         }
@@ -442,7 +445,7 @@ public:
     }
 
     NFTsAndCursor
-    fetchNFTsByIssuer(
+    doFetchNFTsByIssuer(
         ripple::AccountID const& issuer,
         std::optional<std::uint32_t> const& taxon,
         std::uint32_t const ledgerSequence,
@@ -493,28 +496,27 @@ public:
         if (nftIDs.size() == limit)
             ret.cursor = nftIDs.back();
 
-        auto const nftQueryStatement = schema_->selectNFTBulk.bind(nftIDs);
-        nftQueryStatement.bindAt(1, ledgerSequence);
+        // Fetch all the NFT data, meanwhile filtering out the NFTs that are not within the ledger range, together with
+        // the URI for each NFT (but it's possible that URI doesn't exist)
+        std::vector<Statement> statements;
+        statements.reserve(2);
+        statements.push_back(schema_->selectNFTBulk.bind(nftIDs));
+        statements.back().bindAt(1, ledgerSequence);
+        statements.push_back(schema_->selectNFTURIBulk.bind(nftIDs));
+        statements.back().bindAt(1, ledgerSequence);
 
-        // Fetch all the NFT data, meanwhile filtering out the NFTs that are not within the ledger range
-        auto const nftRes = executor_.read(yield, nftQueryStatement);
-        auto const& nftQueryResults = nftRes.value();
+        auto const results = executor_.readEach(yield, statements);
+        auto const& nftQueryResults = results.at(0);
+        auto const& nftURIQueryResults = results.at(1);
 
         if (not nftQueryResults.hasRows()) {
             LOG(log_.debug()) << "No rows returned";
             return {};
         }
 
-        auto const nftURIQueryStatement = schema_->selectNFTURIBulk.bind(nftIDs);
-        nftURIQueryStatement.bindAt(1, ledgerSequence);
-
-        // Get the URI for each NFT, but it's possible that URI doesn't exist
-        auto const uriRes = executor_.read(yield, nftURIQueryStatement);
-        auto const& nftURIQueryResults = uriRes.value();
-
-        std::unordered_map<std::string, Blob> nftURIMap;
-        for (auto const [nftID, uri] : extract<ripple::uint256, Blob>(nftURIQueryResults))
-            nftURIMap.insert({ripple::strHex(nftID), uri});
+        std::unordered_map<ripple::uint256, BlobView, ripple::hardened_hash<>> nftURIMap;
+        for (auto const [nftID, uri] : extract<ripple::uint256, BlobView>(nftURIQueryResults))
+            nftURIMap.emplace(nftID, uri);
 
         for (auto const [nftID, seq, owner, isBurned] :
              extract<ripple::uint256, std::uint32_t, ripple::AccountID, bool>(nftQueryResults)) {
@@ -523,9 +525,9 @@ public:
             nft.ledgerSequence = seq;
             nft.owner = owner;
             nft.isBurned = isBurned;
-            if (nftURIMap.contains(ripple::strHex(nft.tokenID)))
-                nft.uri = nftURIMap.at(ripple::strHex(nft.tokenID));
-            ret.nfts.push_back(nft);
+            if (auto const uri = nftURIMap.find(nft.tokenID); uri != nftURIMap.end())
+                nft.uri = Blob{uri->second.begin(), uri->second.end()};
+            ret.nfts.push_back(std::move(nft));
         }
 
         return ret;
@@ -537,9 +539,9 @@ public:
     {
         LOG(log_.debug()) << "Fetching ledger object for seq " << sequence << ", key = " << ripple::to_string(key);
         if (auto const res = executor_.read(yield, schema_->selectObject, key, sequence); res) {
-            if (auto const result = res->template get<Blob>(); result) {
-                if (result->size())
-                    return *result;
+            if (auto const result = res->template get<BlobView>(); result) {
+                if (not result->empty())
+                    return Blob{result->begin(), result->end()};
             } else {
                 LOG(log_.debug()) << "Could not fetch ledger object - no rows";
             }
@@ -554,10 +556,8 @@ public:
     fetchTransaction(ripple::uint256 const& hash, boost::asio::yield_context yield) const override
     {
         if (auto const res = executor_.read(yield, schema_->selectTransaction, hash); res) {
-            if (auto const maybeValue = res->template get<Blob, Blob, uint32_t, uint32_t>(); maybeValue) {
-                auto [transaction, meta, seq, date] = *maybeValue;
-                return std::make_optional<TransactionAndMetadata>(transaction, meta, seq, date);
-            }
+            if (auto const maybeValue = res->template get<BlobView, BlobView, uint32_t, uint32_t>(); maybeValue)
+                return toTransactionAndMetadata(*maybeValue);
 
             LOG(log_.debug()) << "Could not fetch transaction - no rows";
         } else {
@@ -567,6 +567,36 @@ public:
         return std::nullopt;
     }
 
+    LedgerScanPage
+    fetchLedgerScanPage(
+        ScanRange const& range,
+        std::optional<std::string> const& cursor,
+        std::uint32_t const ledgerSequence,
+        std::uint32_t const limit,
+        boost::asio::yield_context yield
+    ) const override
+    {
+        // the range is a range of partition tokens, paged through by the driver
+        auto const statement = schema_->selectLedgerScanPage.bind(range.first, range.last, ledgerSequence);
+        statement.setPaging(limit, cursor);
+
+        auto const res = executor_.read(yield, statement);
+        if (not res) {
+            LOG(log_.error()) << "Could not fetch ledger scan page: " << res.error();
+            throw DatabaseTimeout{};
+        }
+
+        LedgerScanPage page;
+        auto const& results = res.value();
+        for (auto [key, object] : extract<ripple::uint256, BlobView>(results)) {
+            if (not object.empty())
+                page.objects.push_back({key, Blob{object.begin(), object.end()}});
+        }
+        page.cursor = results.pagingState();
+
+        return page;
+    }
+
     std::optional<ripple::uint256>
     doFetchSuccessorKey(ripple::uint256 key, std::uint32_t const ledgerSequence, boost::asio::yield_context yield)
         const override
@@ -599,7 +629,8 @@ public:
         std::vector<Statement> statements;
         statements.reserve(numHashes);
 
-        auto const timeDiff = util::timed([this, yield, &results, &hashes, &statements]() {
+        static util::profiling::Zone const zone{"backend.fetch_transactions"};
+        auto const timeDiff = util::profiling::timed(zone, [this, yield, &results, &hashes, &statements]() {
             // TODO: seems like a job for "hash IN (list of hashes)" instead?
             std::transform(
                 std::cbegin(hashes),
@@ -614,8 +645,8 @@ public:
                 std::cend(entries),
                 std::back_inserter(results),
                 [](auto const& res) -> TransactionAndMetadata {
-                    if (auto const maybeRow = res.template get<Blob, Blob, uint32_t, uint32_t>(); maybeRow)
-                        return *maybeRow;
+                    if (auto const maybeRow = res.template get<BlobView, BlobView, uint32_t, uint32_t>(); maybeRow)
+                        return toTransactionAndMetadata(*maybeRow);
 
                     return {};
                 }
@@ -661,8 +692,8 @@ public:
             std::cend(entries),
             std::back_inserter(results),
             [](auto const& res) -> Blob {
-                if (auto const maybeValue = res.template get<Blob>(); maybeValue)
-                    return *maybeValue;
+                if (auto const maybeValue = res.template get<BlobView>(); maybeValue)
+                    return Blob{maybeValue->begin(), maybeValue->end()};
 
                 return {};
             }
@@ -675,25 +706,28 @@ public:
     std::vector<LedgerObject>
     fetchLedgerDiff(std::uint32_t const ledgerSequence, boost::asio::yield_context yield) const override
     {
-        auto const [keys, timeDiff] = util::timed([this, &ledgerSequence, yield]() -> std::vector<ripple::uint256> {
-            auto const res = executor_.read(yield, schema_->selectDiff, ledgerSequence);
-            if (not res) {
-                LOG(log_.error()) << "Could not fetch ledger diff: " << res.error() << "; ledger = " << ledgerSequence;
-                return {};
-            }
+        static util::profiling::Zone const zone{"backend.fetch_ledger_diff"};
+        auto const [keys, timeDiff] =
+            util::profiling::timed(zone, [this, &ledgerSequence, yield]() -> std::vector<ripple::uint256> {
+                auto const res = executor_.read(yield, schema_->selectDiff, ledgerSequence);
+                if (not res) {
+                    LOG(log_.error()) << "Could not fetch ledger diff: " << res.error()
+                                      << "; ledger = " << ledgerSequence;
+                    return {};
+                }
 
-            auto const& results = res.value();
-            if (not results) {
-                LOG(log_.error()) << "Could not fetch ledger diff - no rows; ledger = " << ledgerSequence;
-                return {};
-            }
+                auto const& results = res.value();
+                if (not results) {
+                    LOG(log_.error()) << "Could not fetch ledger diff - no rows; ledger = " << ledgerSequence;
+                    return {};
+                }
 
-            std::vector<ripple::uint256> resultKeys;
-            for (auto [key] : extract<ripple::uint256>(results))
-                resultKeys.push_back(key);
+                std::vector<ripple::uint256> resultKeys;
+                for (auto [key] : extract<ripple::uint256>(results))
+                    resultKeys.push_back(key);
 
-            return resultKeys;
-        });
+                return resultKeys;
+            });
 
         // one of the above errors must have happened
         if (keys.empty())
@@ -725,7 +759,7 @@ public:
         LOG(log_.trace()) << " Writing ledger object " << key.size() << ":" << seq << " [" << blob.size() << " bytes]";
 
         if (range)
-            executor_.write(schema_->insertDiff, seq, key);
+            executor_.writeToPartition("diff:" + std::to_string(seq), schema_->insertDiff, seq, key);
 
         executor_.write(schema_->insertObject, std::move(key), seq, std::move(blob));
     }
@@ -744,40 +778,31 @@ public:
     void
     writeAccountTransactions(std::vector<AccountTransactionsData>&& data) override
     {
-        std::vector<Statement> statements;
-        statements.reserve(data.size() * 10);  // assume 10 transactions avg
-
-        for (auto& record : data) {
-            std::transform(
-                std::begin(record.accounts),
-                std::end(record.accounts),
-                std::back_inserter(statements),
-                [this, &record](auto&& account) {
-                    return schema_->insertAccountTx.bind(
-                        std::forward<decltype(account)>(account),
-                        std::make_tuple(record.ledgerSequence, record.transactionIndex),
-                        record.txHash
-                    );
-                }
-            );
+        for (auto const& record : data) {
+            for (auto const& account : record.accounts) {
+                executor_.writeToPartition(
+                    "account_tx:" + ripple::strHex(account),
+                    schema_->insertAccountTx,
+                    account,
+                    std::make_tuple(record.ledgerSequence, record.transactionIndex),
+                    record.txHash
+                );
+            }
         }
-
-        executor_.write(std::move(statements));
     }
 
     void
     writeNFTTransactions(std::vector<NFTTransactionsData>&& data) override
     {
-        std::vector<Statement> statements;
-        statements.reserve(data.size());
-
-        std::transform(std::cbegin(data), std::cend(data), std::back_inserter(statements), [this](auto const& record) {
-            return schema_->insertNFTTx.bind(
-                record.tokenID, std::make_tuple(record.ledgerSequence, record.transactionIndex), record.txHash
+        for (auto const& record : data) {
+            executor_.writeToPartition(
+                "nf_token_transactions:" + ripple::strHex(record.tokenID),
+                schema_->insertNFTTx,
+                record.tokenID,
+                std::make_tuple(record.ledgerSequence, record.transactionIndex),
+                record.txHash
             );
-        });
-
-        executor_.write(std::move(statements));
+        }
     }
 
     void
@@ -791,7 +816,9 @@ public:
     {
         LOG(log_.trace()) << "Writing txn to cassandra";
 
-        executor_.write(schema_->insertLedgerTransaction, seq, hash);
+        executor_.writeToPartition(
+            "ledger_transactions:" + std::to_string(seq), schema_->insertLedgerTransaction, seq, hash
+        );
         executor_.write(
             schema_->insertTransaction, std::move(hash), seq, date, std::move(transaction), std::move(metadata)
         );
@@ -871,6 +898,14 @@ private:
 
         return true;
     }
+
+    // the only copy of the blobs, straight out of the driver's result
+    static TransactionAndMetadata
+    toTransactionAndMetadata(std::tuple<BlobView, BlobView, uint32_t, uint32_t> const& row)
+    {
+        auto const& [transaction, metadata, seq, date] = row;
+        return {Blob{transaction.begin(), transaction.end()}, Blob{metadata.begin(), metadata.end()}, seq, date};
+    }
 };
 
 using CassandraBackend = BasicCassandraBackend<SettingsProvider, detail::DefaultExecutionStrategy<>>;
@@ -0,0 +1,1281 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <data/EmbeddedBackend.h>
+#include <util/LedgerUtils.h>
+
+#include <ripple/protocol/nft.h>
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace data::embedded {
+
+namespace {
+
+enum class RecordType : std::uint8_t {
+    Ledger = 1,
+    Object,
+    Diff,
+    Successor,
+    Transaction,
+    AccountTransaction,
+    NFT,
+    NFTURI,
+    NFTTransaction,
+    Range,
+};
+
+class Encoder {
+    std::string& out_;
+
+public:
+    explicit Encoder(std::string& out) : out_{out}
+    {
+    }
+
+    Encoder&
+    type(RecordType type)
+    {
+        out_.push_back(static_cast<char>(type));
+        return *this;
+    }
+
+    Encoder&
+    u32(std::uint32_t value)
+    {
+        for (std::size_t i = 0; i < sizeof(value); ++i)
+            out_.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        return *this;
+    }
+
+    // fixed size field such as a key or hash, written without a size prefix
+    Encoder&
+    raw(std::string_view value)
+    {
+        out_.append(value);
+        return *this;
+    }
+
+    template <std::size_t Bits, typename Tag>
+    Encoder&
+    raw(ripple::base_uint<Bits, Tag> const& value)
+    {
+        return raw(std::string_view{reinterpret_cast<char const*>(value.data()), value.size()});
+    }
+
+    Encoder&
+    bytes(std::string_view value)
+    {
+        u32(static_cast<std::uint32_t>(value.size()));
+        out_.append(value);
+        return *this;
+    }
+
+    Encoder&
+    bytes(Blob const& value)
+    {
+        return bytes(std::string_view{reinterpret_cast<char const*>(value.data()), value.size()});
+    }
+};
+
+class Decoder {
+    std::string_view in_;
+
+    std::string_view
+    take(std::size_t size)
+    {
+        if (in_.size() < size)
+            throw std::runtime_error("Truncated record in the embedded backend log");
+
+        auto const result = in_.substr(0, size);
+        in_.remove_prefix(size);
+        return result;
+    }
+
+public:
+    explicit Decoder(std::string_view in) : in_{in}
+    {
+    }
+
+    [[nodiscard]] bool
+    empty() const
+    {
+        return in_.empty();
+    }
+
+    RecordType
+    type()
+    {
+        return static_cast<RecordType>(take(1).front());
+    }
+
+    std::uint32_t
+    u32()
+    {
+        auto const data = take(sizeof(std::uint32_t));
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i < sizeof(value); ++i)
+            value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+        return value;
+    }
+
+    template <typename T>
+    T
+    raw()
+    {
+        return T::fromVoid(take(T::bytes).data());
+    }
+
+    Blob
+    blob()
+    {
+        auto const data = take(u32());
+        return {data.begin(), data.end()};
+    }
+};
+
+// Returns the newest version of `key` visible at `sequence`, if any
+template <typename Table, typename Key>
+typename Table::mapped_type::value_type const*
+findVersion(Table const& table, Key const& key, std::uint32_t sequence)
+{
+    auto const it = table.find(key);
+    if (it == table.end())
+        return nullptr;
+
+    auto const version = it->second.lower_bound(sequence);
+    return version == it->second.end() ? nullptr : &*version;
+}
+
+// Keys are mapped onto the scan space by their first 8 bytes, which keeps them in order
+// Number of entries compaction visits per lock acquisition
+constexpr std::size_t SLICE_SIZE = 1024;
+
+constexpr auto SCAN_SIGN_BIT = std::uint64_t{1} << 63;
+
+ripple::uint256
+scanKey(std::int64_t position)
+{
+    auto const value = static_cast<std::uint64_t>(position) ^ SCAN_SIGN_BIT;
+    ripple::uint256 key;
+    for (auto i = 0u; i < sizeof(value); ++i)
+        key.data()[i] = static_cast<unsigned char>(value >> (8 * (sizeof(value) - 1 - i)));
+    return key;
+}
+
+std::int64_t
+scanPosition(ripple::uint256 const& key)
+{
+    std::uint64_t value = 0;
+    for (auto i = 0u; i < sizeof(value); ++i)
+        value = (value << 8) | key.data()[i];
+    return static_cast<std::int64_t>(value ^ SCAN_SIGN_BIT);
+}
+
+// Same semantics as the account_tx and nf_token_transactions queries of the Cassandra backend
+template <typename Index>
+std::pair<std::vector<ripple::uint256>, std::optional<TransactionsCursor>>
+pageOf(Index const& index, std::uint32_t limit, bool forward, std::optional<TransactionsCursor> const& cursorIn)
+{
+    std::vector<ripple::uint256> hashes;
+    auto cursor = cursorIn;
+
+    auto const take = [&](auto begin, auto end) {
+        for (auto it = begin; it != end and hashes.size() < limit; ++it) {
+            hashes.push_back(it->second);
+            cursor = TransactionsCursor{it->first};
+        }
+    };
+
+    if (forward) {
+        auto const from = cursorIn ? cursorIn->asTuple() : std::make_tuple(0u, 0u);
+        take(index.upper_bound(from), index.end());
+
+        // forward queries by ledger/tx sequence `>=`
+        // so we have to advance the index by one
+        if (not hashes.empty())
+            ++cursor->transactionIndex;
+    } else {
+        auto constexpr max = std::numeric_limits<std::uint32_t>::max();
+        auto const from = cursorIn ? cursorIn->asTuple() : std::make_tuple(max, max);
+        take(std::make_reverse_iterator(index.lower_bound(from)), index.rend());
+    }
+
+    return {std::move(hashes), cursor};
+}
+
+std::uint32_t
+taxonOf(ripple::uint256 const& tokenID)
+{
+    return ripple::nft::toUInt32(ripple::nft::getTaxon(tokenID));
+}
+
+}  // namespace
+
+Settings
+Settings::fromConfig(util::Config const& cfg)
+{
+    Settings settings;
+    settings.path = cfg.valueOr<std::string>("path", settings.path);
+    settings.sync = cfg.valueOr("sync", settings.sync);
+    settings.onlineDelete = cfg.valueOr("online_delete", settings.onlineDelete);
+    settings.chunkSize = cfg.valueOr("chunk_size", settings.chunkSize);
+    return settings;
+}
+
+EmbeddedBackend::EmbeddedBackend(Settings settings, bool readOnly)
+    : settings_{std::move(settings)}
+    , readOnly_{readOnly}
+    , wal_{(std::filesystem::path{settings_.path} / "clio.wal").string(), readOnly_, settings_.sync}
+{
+    {
+        std::unique_lock const lk(mtx_);
+        wal_.replay([this](std::string_view chunk) { apply(chunk); });
+    }
+
+    if (not readOnly_)
+        compactor_ = std::thread([this] { runCompactor(); });
+
+    LOG(log_.info()) << "Created EmbeddedBackend at " << settings_.path << "; readOnly: " << readOnly_;
+}
+
+EmbeddedBackend::~EmbeddedBackend()
+{
+    {
+        std::scoped_lock const lk(compactorMtx_);
+        stopping_ = true;
+    }
+    compactorCv_.notify_one();
+
+    if (compactor_.joinable())
+        compactor_.join();
+}
+
+std::optional<ripple::LedgerHeader>
+EmbeddedBackend::fetchLedgerBySequence(std::uint32_t const sequence, boost::asio::yield_context) const
+{
+    std::shared_lock const lk(mtx_);
+    if (auto const it = ledgers_.find(sequence); it != ledgers_.end())
+        return util::deserializeHeader(ripple::makeSlice(it->second));
+
+    return std::nullopt;
+}
+
+std::optional<ripple::LedgerHeader>
+EmbeddedBackend::fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context) const
+{
+    std::shared_lock const lk(mtx_);
+    auto const seq = ledgerHashes_.find(hash);
+    if (seq == ledgerHashes_.end())
+        return std::nullopt;
+
+    if (auto const it = ledgers_.find(seq->second); it != ledgers_.end())
+        return util::deserializeHeader(ripple::makeSlice(it->second));
+
+    return std::nullopt;
+}
+
+std::optional<std::uint32_t>
+EmbeddedBackend::fetchLatestLedgerSequence(boost::asio::yield_context) const
+{
+    std::shared_lock const lk(mtx_);
+    if (storedRange_)
+        return storedRange_->maxSequence;
+
+    return std::nullopt;
+}
+
+std::optional<TransactionAndMetadata>
+EmbeddedBackend::fetchTransaction(ripple::uint256 const& hash, boost::asio::yield_context) const
+{
+    std::shared_lock const lk(mtx_);
+    if (auto const it = transactions_.find(hash); it != transactions_.end())
+        return it->second;
+
+    return std::nullopt;
+}
+
+std::vector<TransactionAndMetadata>
+EmbeddedBackend::fetchTransactions(std::vector<ripple::uint256> const& hashes, boost::asio::yield_context) const
+{
+    std::vector<TransactionAndMetadata> results;
+    results.reserve(hashes.size());
+
+    std::shared_lock const lk(mtx_);
+    std::transform(
+        std::cbegin(hashes),
+        std::cend(hashes),
+        std::back_inserter(results),
+        [this](auto const& hash) -> TransactionAndMetadata {
+            if (auto const it = transactions_.find(hash); it != transactions_.end())
+                return it->second;
+
+            return {};
+        }
+    );
+
+    return results;
+}
+
+TransactionsAndCursor
+EmbeddedBackend::fetchAccountTransactions(
+    ripple::AccountID const& account,
+    std::uint32_t const limit,
+    bool const forward,
+    std::optional<TransactionsCursor> const& cursorIn,
+    boost::asio::yield_context yield
+) const
+{
+    if (not fetchLedgerRange())
+        return {{}, {}};
+
+    std::vector<ripple::uint256> hashes;
+    std::optional<TransactionsCursor> cursor;
+    {
+        std::shared_lock const lk(mtx_);
+        if (auto const it = accountTransactions_.find(account); it != accountTransactions_.end())
+            std::tie(hashes, cursor) = pageOf(it->second, limit, forward, cursorIn);
+    }
+
+    auto txns = fetchTransactions(hashes, yield);
+    if (txns.size() == limit)
+        return {std::move(txns), cursor};
+
+    return {std::move(txns), {}};
+}
+
+std::vector<TransactionAndMetadata>
+EmbeddedBackend::fetchAllTransactionsInLedger(std::uint32_t const ledgerSequence, boost::asio::yield_context yield)
+    const
+{
+    auto const hashes = fetchAllTransactionHashesInLedger(ledgerSequence, yield);
+    return fetchTransactions(hashes, yield);
+}
+
+std::vector<ripple::uint256>
+EmbeddedBackend::fetchAllTransactionHashesInLedger(std::uint32_t const ledgerSequence, boost::asio::yield_context)
+    const
+{
+    std::shared_lock const lk(mtx_);
+    if (auto const it = ledgerTransactions_.find(ledgerSequence); it != ledgerTransactions_.end())
+        return {it->second.begin(), it->second.end()};
+
+    return {};
+}
+
+std::optional<NFT>
+EmbeddedBackend::doFetchNFT(
+    ripple::uint256 const& tokenID,
+    std::uint32_t const ledgerSequence,
+    boost::asio::yield_context
+) const
+{
+    std::shared_lock const lk(mtx_);
+    auto const state = findVersion(nfts_, tokenID, ledgerSequence);
+    if (state == nullptr)
+        return std::nullopt;
+
+    auto result = std::make_optional<NFT>(tokenID, state->first, state->second.owner, state->second.isBurned);
+    if (auto const uri = findVersion(nftURIs_, tokenID, ledgerSequence); uri != nullptr)
+        result->uri = uri->second;
+
+    return result;
+}
+
+TransactionsAndCursor
+EmbeddedBackend::fetchNFTTransactions(
+    ripple::uint256 const& tokenID,
+    std::uint32_t const limit,
+    bool const forward,
+    std::optional<TransactionsCursor> const& cursorIn,
+    boost::asio::yield_context yield
+) const
+{
+    if (not fetchLedgerRange())
+        return {{}, {}};
+
+    std::vector<ripple::uint256> hashes;
+    std::optional<TransactionsCursor> cursor;
+    {
+        std::shared_lock const lk(mtx_);
+        if (auto const it = nftTransactions_.find(tokenID); it != nftTransactions_.end())
+            std::tie(hashes, cursor) = pageOf(it->second, limit, forward, cursorIn);
+    }
+
+    auto txns = fetchTransactions(hashes, yield);
+    if (txns.size() == limit)
+        return {std::move(txns), cursor};
+
+    return {std::move(txns), {}};
+}
+
+NFTsAndCursor
+EmbeddedBackend::doFetchNFTsByIssuer(
+    ripple::AccountID const& issuer,
+    std::optional<std::uint32_t> const& taxon,
+    std::uint32_t const ledgerSequence,
+    std::uint32_t const limit,
+    std::optional<ripple::uint256> const& cursorIn,
+    boost::asio::yield_context
+) const
+{
+    NFTsAndCursor ret;
+
+    std::shared_lock const lk(mtx_);
+    auto const it = issuerNFTs_.find(issuer);
+    if (it == issuerNFTs_.end())
+        return ret;
+
+    auto const cursor = cursorIn.value_or(ripple::uint256(0));
+    auto const from = std::make_tuple(taxon.value_or(cursorIn ? taxonOf(*cursorIn) : 0u), cursor);
+
+    std::vector<ripple::uint256> nftIDs;
+    for (auto id = it->second.upper_bound(from); id != it->second.end() and nftIDs.size() < limit; ++id) {
+        if (taxon and std::get<0>(*id) != *taxon)
+            break;
+        nftIDs.push_back(std::get<1>(*id));
+    }
+
+    if (nftIDs.size() == limit)
+        ret.cursor = nftIDs.back();
+
+    // NFTs that did not exist yet at ledgerSequence are filtered out
+    for (auto const& nftID : nftIDs) {
+        auto const state = findVersion(nfts_, nftID, ledgerSequence);
+        if (state == nullptr)
+            continue;
+
+        NFT nft{nftID, state->first, state->second.owner, state->second.isBurned};
+        if (auto const uri = findVersion(nftURIs_, nftID, ledgerSequence); uri != nullptr)
+            nft.uri = uri->second;
+        ret.nfts.push_back(std::move(nft));
+    }
+
+    return ret;
+}
+
+std::optional<Blob>
+EmbeddedBackend::doFetchLedgerObject(
+    ripple::uint256 const& key,
+    std::uint32_t const sequence,
+    boost::asio::yield_context
+) const
+{
+    std::shared_lock const lk(mtx_);
+    if (auto const version = findVersion(objects_, key, sequence); version != nullptr and not version->second.empty())
+        return version->second;
+
+    return std::nullopt;
+}
+
+std::vector<Blob>
+EmbeddedBackend::doFetchLedgerObjects(
+    std::vector<ripple::uint256> const& keys,
+    std::uint32_t const sequence,
+    boost::asio::yield_context
+) const
+{
+    std::vector<Blob> results;
+    results.reserve(keys.size());
+
+    std::shared_lock const lk(mtx_);
+    std::transform(
+        std::cbegin(keys),
+        std::cend(keys),
+        std::back_inserter(results),
+        [this, sequence](auto const& key) -> Blob {
+            if (auto const version = findVersion(objects_, key, sequence); version != nullptr)
+                return version->second;
+
+            return {};
+        }
+    );
+
+    return results;
+}
+
+std::vector<LedgerObject>
+EmbeddedBackend::fetchLedgerDiff(std::uint32_t const ledgerSequence, boost::asio::yield_context yield) const
+{
+    std::vector<ripple::uint256> keys;
+    {
+        std::shared_lock const lk(mtx_);
+        if (auto const it = diffs_.find(ledgerSequence); it != diffs_.end())
+            keys.assign(it->second.begin(), it->second.end());
+    }
+
+    if (keys.empty())
+        return {};
+
+    auto const objs = fetchLedgerObjects(keys, ledgerSequence, yield);
+    std::vector<LedgerObject> results;
+    results.reserve(keys.size());
+
+    std::transform(
+        std::cbegin(keys),
+        std::cend(keys),
+        std::cbegin(objs),
+        std::back_inserter(results),
+        [](auto const& key, auto const& obj) {
+            return LedgerObject{key, obj};
+        }
+    );
+
+    return results;
+}
+
+LedgerScanPage
+EmbeddedBackend::fetchLedgerScanPage(
+    ScanRange const& range,
+    std::optional<std::string> const& cursor,
+    std::uint32_t const ledgerSequence,
+    std::uint32_t const limit,
+    boost::asio::yield_context
+) const
+{
+    LedgerScanPage page;
+
+    std::shared_lock const lk(mtx_);
+    auto it = cursor ? objects_.upper_bound(ripple::uint256::fromVoid(cursor->data()))
+                     : objects_.lower_bound(scanKey(range.first));
+
+    for (std::uint32_t read = 0; it != objects_.end() and scanPosition(it->first) <= range.last; ++it, ++read) {
+        if (read == limit) {
+            auto const& last = std::prev(it)->first;
+            page.cursor = std::string{reinterpret_cast<char const*>(last.data()), ripple::uint256::bytes};
+            break;
+        }
+
+        auto const version = it->second.lower_bound(ledgerSequence);
+        if (version != it->second.end() and not version->second.empty())
+            page.objects.push_back({it->first, version->second});
+    }
+
+    return page;
+}
+
+std::optional<ripple::uint256>
+EmbeddedBackend::doFetchSuccessorKey(
+    ripple::uint256 key,
+    std::uint32_t const ledgerSequence,
+    boost::asio::yield_context
+) const
+{
+    std::shared_lock const lk(mtx_);
+    auto const version = findVersion(successors_, key, ledgerSequence);
+    if (version == nullptr or version->second == lastKey)
+        return std::nullopt;
+
+    return version->second;
+}
+
+std::optional<LedgerRange>
+EmbeddedBackend::hardFetchLedgerRange(boost::asio::yield_context) const
+{
+    std::shared_lock const lk(mtx_);
+    return storedRange_;
+}
+
+void
+EmbeddedBackend::writeLedger(ripple::LedgerHeader const& ledgerHeader, std::string&& blob)
+{
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        Encoder{pending_}.type(RecordType::Ledger).raw(ledgerHeader.hash).u32(ledgerHeader.seq).bytes(blob);
+        ledgerSequence_ = ledgerHeader.seq;
+    }
+
+    flushIfLarge();
+}
+
+void
+EmbeddedBackend::doWriteLedgerObject(std::string&& key, std::uint32_t const seq, std::string&& blob)
+{
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        Encoder encoder{pending_};
+
+        if (range)
+            encoder.type(RecordType::Diff).u32(seq).raw(key);
+
+        encoder.type(RecordType::Object).raw(key).u32(seq).bytes(blob);
+    }
+
+    flushIfLarge();
+}
+
+void
+EmbeddedBackend::writeSuccessor(std::string&& key, std::uint32_t const seq, std::string&& successor)
+{
+    assert(key.size() == sizeof(ripple::uint256));
+    assert(successor.size() == sizeof(ripple::uint256));
+
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        Encoder{pending_}.type(RecordType::Successor).raw(key).u32(seq).raw(successor);
+    }
+
+    flushIfLarge();
+}
+
+void
+EmbeddedBackend::writeTransaction(
+    std::string&& hash,
+    std::uint32_t const seq,
+    std::uint32_t const date,
+    std::string&& transaction,
+    std::string&& metadata
+)
+{
+    assert(hash.size() == sizeof(ripple::uint256));
+
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        Encoder{pending_}.type(RecordType::Transaction).raw(hash).u32(seq).u32(date).bytes(transaction).bytes(metadata);
+    }
+
+    flushIfLarge();
+}
+
+void
+EmbeddedBackend::writeNFTs(std::vector<NFTsData>&& data)
+{
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        Encoder encoder{pending_};
+
+        for (NFTsData const& record : data) {
+            encoder.type(RecordType::NFT)
+                .raw(record.tokenID)
+                .u32(record.ledgerSequence)
+                .raw(record.owner)
+                .u32(record.isBurned ? 1 : 0);
+
+            // a set uri means the NFT is new to us, see NFTsData
+            if (record.uri)
+                encoder.type(RecordType::NFTURI).raw(record.tokenID).u32(record.ledgerSequence).bytes(*record.uri);
+        }
+    }
+
+    flushIfLarge();
+}
+
+void
+EmbeddedBackend::writeAccountTransactions(std::vector<AccountTransactionsData>&& data)
+{
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        Encoder encoder{pending_};
+
+        for (auto const& record : data) {
+            for (auto const& account : record.accounts) {
+                encoder.type(RecordType::AccountTransaction)
+                    .raw(account)
+                    .u32(record.ledgerSequence)
+                    .u32(record.transactionIndex)
+                    .raw(record.txHash);
+            }
+        }
+    }
+
+    flushIfLarge();
+}
+
+void
+EmbeddedBackend::writeNFTTransactions(std::vector<NFTTransactionsData>&& data)
+{
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        Encoder encoder{pending_};
+
+        for (auto const& record : data) {
+            encoder.type(RecordType::NFTTransaction)
+                .raw(record.tokenID)
+                .u32(record.ledgerSequence)
+                .u32(record.transactionIndex)
+                .raw(record.txHash);
+        }
+    }
+
+    flushIfLarge();
+}
+
+void
+EmbeddedBackend::flushIfLarge()
+{
+    if (readOnly_)
+        return;
+
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        if (pending_.size() < settings_.chunkSize)
+            return;
+    }
+
+    std::scoped_lock const walLock(walMtx_);
+
+    std::string chunk;
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        if (pending_.size() < settings_.chunkSize)
+            return;
+        chunk = std::exchange(pending_, {});
+    }
+
+    if (batchFailed_)
+        return;
+
+    try {
+        wal_.append(chunk, false);
+    } catch (std::exception const& e) {
+        LOG(log_.error()) << "Could not write a chunk of ledger " << ledgerSequence_ << ": " << e.what();
+        batchFailed_ = true;
+        return;
+    }
+
+    std::unique_lock const lk(mtx_);
+    apply(chunk);
+}
+
+bool
+EmbeddedBackend::doFinishWrites()
+{
+    if (readOnly_) {
+        LOG(log_.error()) << "Can't commit ledger " << ledgerSequence_ << " to a read only EmbeddedBackend";
+        return false;
+    }
+
+    std::scoped_lock const walLock(walMtx_);
+
+    std::string batch;
+    {
+        std::scoped_lock const lk(pendingMtx_);
+        batch = std::exchange(pending_, {});
+    }
+
+    if (std::exchange(batchFailed_, false)) {
+        LOG(log_.error()) << "Could not commit ledger " << ledgerSequence_ << ": part of it was not written";
+        abortBatch();
+        return false;
+    }
+
+    auto minSequence = ledgerSequence_;
+    {
+        std::shared_lock const lk(mtx_);
+        if (storedRange_)
+            minSequence = storedRange_->minSequence;
+    }
+
+    // the range record is last so that the ledger is only considered committed if the whole batch made it to disk
+    Encoder{batch}.type(RecordType::Range).u32(minSequence).u32(ledgerSequence_);
+
+    try {
+        wal_.append(batch, true);
+    } catch (std::exception const& e) {
+        LOG(log_.error()) << "Could not commit ledger " << ledgerSequence_ << ": " << e.what();
+        abortBatch();
+        return false;
+    }
+
+    {
+        std::unique_lock const lk(mtx_);
+        apply(batch);
+    }
+
+    LOG(log_.info()) << "Committed ledger " << ledgerSequence_;
+
+    auto const onlineDelete = settings_.onlineDelete;
+    if (onlineDelete != 0 and ledgerSequence_ - minSequence + 1 >= 2 * onlineDelete)
+        requestCompaction(ledgerSequence_ - onlineDelete + 1);
+
+    return true;
+}
+
+void
+EmbeddedBackend::abortBatch()
+{
+    // chunks already applied stay in memory past the end of the range and are overwritten when the ledger is retried
+    try {
+        wal_.abort();
+    } catch (std::exception const& e) {
+        LOG(log_.error()) << "Could not drop the uncommitted part of ledger " << ledgerSequence_ << ": " << e.what();
+    }
+}
+
+bool
+EmbeddedBackend::deleteLedgersBefore(std::uint32_t const minSequence)
+{
+    if (readOnly_)
+        return false;
+
+    {
+        std::shared_lock const lk(mtx_);
+        if (not storedRange_ or minSequence <= storedRange_->minSequence)
+            return true;
+
+        if (minSequence > storedRange_->maxSequence) {
+            LOG(log_.warn()) << "Refusing to delete ledgers before " << minSequence << ": past the last ledger "
+                             << storedRange_->maxSequence;
+            return false;
+        }
+    }
+
+    raiseMinSequence(minSequence);
+
+    std::scoped_lock const lk(compactionMtx_);
+    return compact(minSequence);
+}
+
+void
+EmbeddedBackend::raiseMinSequence(std::uint32_t const minSequence)
+{
+    {
+        std::unique_lock const lk(mtx_);
+        if (storedRange_)
+            storedRange_->minSequence = std::max(storedRange_->minSequence, minSequence);
+    }
+
+    std::unique_lock const lk(rngMtx_);
+    if (range)
+        range->minSequence = std::max(range->minSequence, minSequence);
+}
+
+void
+EmbeddedBackend::requestCompaction(std::uint32_t const minSequence)
+{
+    // readers stop seeing the older ledgers right away; deleting them and compacting the log happens in the background
+    raiseMinSequence(minSequence);
+
+    {
+        std::scoped_lock const lk(compactorMtx_);
+        compactionRequest_ = std::max(compactionRequest_.value_or(0u), minSequence);
+    }
+    compactorCv_.notify_one();
+}
+
+void
+EmbeddedBackend::runCompactor()
+{
+    while (true) {
+        std::uint32_t minSequence = 0;
+        {
+            std::unique_lock lk(compactorMtx_);
+            compactorCv_.wait(lk, [this] { return stopping_ or compactionRequest_; });
+            if (stopping_)
+                return;
+
+            minSequence = *std::exchange(compactionRequest_, std::nullopt);
+        }
+
+        std::scoped_lock const lk(compactionMtx_);
+        compact(minSequence);
+    }
+}
+
+bool
+EmbeddedBackend::compact(std::uint32_t const minSequence)
+{
+    if (not prune(minSequence))
+        return false;
+
+    // everything committed up to tailFrom is in memory; what is appended after it is copied over as is
+    std::uint64_t tailFrom = 0;
+    std::optional<LedgerRange> snapshotRange;
+    {
+        std::scoped_lock const walLock(walMtx_);
+        tailFrom = wal_.committedSize();
+
+        std::shared_lock const lk(mtx_);
+        snapshotRange = storedRange_;
+    }
+
+    if (not snapshotRange)
+        return true;
+
+    std::uint64_t logSize = 0;
+    try {
+        auto rewrite = wal_.startRewrite();
+        if (not writeSnapshot(rewrite, snapshotRange->minSequence, snapshotRange->maxSequence))
+            return false;
+
+        std::scoped_lock const walLock(walMtx_);
+        wal_.finishRewrite(rewrite, tailFrom);
+        logSize = wal_.size();
+    } catch (std::exception const& e) {
+        // the data is gone from memory but will come back on restart; the next deletion will retry the compaction
+        LOG(log_.error()) << "Could not compact the log after deleting ledgers before " << minSequence << ": "
+                          << e.what();
+        return false;
+    }
+
+    LOG(log_.info()) << "Deleted ledgers before " << minSequence << "; log is now " << logSize << " bytes";
+    return true;
+}
+
+boost::json::object
+EmbeddedBackend::stats() const
+{
+    std::shared_lock const lk(mtx_);
+    return {
+        {"ledgers", ledgers_.size()},
+        {"objects", objects_.size()},
+        {"transactions", transactions_.size()},
+        {"log_size", wal_.size()},
+    };
+}
+
+void
+EmbeddedBackend::apply(std::string_view batch)
+{
+    Decoder in{batch};
+    while (not in.empty()) {
+        switch (in.type()) {
+            case RecordType::Ledger: {
+                auto const hash = in.raw<ripple::uint256>();
+                auto const seq = in.u32();
+                ledgers_[seq] = in.blob();
+                ledgerHashes_[hash] = seq;
+                break;
+            }
+            case RecordType::Object: {
+                auto const key = in.raw<ripple::uint256>();
+                auto const seq = in.u32();
+                objects_[key][seq] = in.blob();
+                break;
+            }
+            case RecordType::Diff: {
+                auto const seq = in.u32();
+                diffs_[seq].insert(in.raw<ripple::uint256>());
+                break;
+            }
+            case RecordType::Successor: {
+                auto const key = in.raw<ripple::uint256>();
+                auto const seq = in.u32();
+                successors_[key][seq] = in.raw<ripple::uint256>();
+                break;
+            }
+            case RecordType::Transaction: {
+                auto const hash = in.raw<ripple::uint256>();
+                auto const seq = in.u32();
+                auto const date = in.u32();
+                auto transaction = in.blob();
+                auto metadata = in.blob();
+                transactions_[hash] = TransactionAndMetadata{std::move(transaction), std::move(metadata), seq, date};
+                ledgerTransactions_[seq].insert(hash);
+                break;
+            }
+            case RecordType::AccountTransaction: {
+                auto const account = in.raw<ripple::AccountID>();
+                auto const seq = in.u32();
+                auto const idx = in.u32();
+                accountTransactions_[account][std::make_tuple(seq, idx)] = in.raw<ripple::uint256>();
+                break;
+            }
+            case RecordType::NFT: {
+                auto const tokenID = in.raw<ripple::uint256>();
+                auto const seq = in.u32();
+                auto const owner = in.raw<ripple::AccountID>();
+                nfts_[tokenID][seq] = NFTState{owner, in.u32() != 0};
+                break;
+            }
+            case RecordType::NFTURI: {
+                auto const tokenID = in.raw<ripple::uint256>();
+                auto const seq = in.u32();
+                nftURIs_[tokenID][seq] = in.blob();
+                issuerNFTs_[ripple::nft::getIssuer(tokenID)].emplace(taxonOf(tokenID), tokenID);
+                break;
+            }
+            case RecordType::NFTTransaction: {
+                auto const tokenID = in.raw<ripple::uint256>();
+                auto const seq = in.u32();
+                auto const idx = in.u32();
+                nftTransactions_[tokenID][std::make_tuple(seq, idx)] = in.raw<ripple::uint256>();
+                break;
+            }
+            case RecordType::Range: {
+                // a deletion may have raised the first ledger while this batch was being committed
+                auto const minSequence = std::max(in.u32(), storedRange_ ? storedRange_->minSequence : 0u);
+                storedRange_ = LedgerRange{minSequence, in.u32()};
+                break;
+            }
+            default:
+                throw std::runtime_error("Unknown record type in the embedded backend log");
+        }
+    }
+}
+
+template <template <typename> typename Lock, typename Table, typename Visit, typename AfterSlice>
+bool
+EmbeddedBackend::forEachSliced(Table& table, Visit const& visit, AfterSlice const& afterSlice)
+{
+    std::optional<typename std::remove_const_t<Table>::key_type> resume;
+    bool done = false;
+
+    while (not done) {
+        if (stopping_)
+            return false;
+
+        {
+            Lock<std::shared_mutex> const lk(mtx_);
+            auto it = resume ? table.upper_bound(*resume) : table.begin();
+            for (std::size_t visited = 0; it != table.end() and visited < SLICE_SIZE; ++visited) {
+                resume = it->first;
+                it = visit(it);
+            }
+            done = it == table.end();
+        }
+
+        afterSlice();
+    }
+
+    return true;
+}
+
+bool
+EmbeddedBackend::prune(std::uint32_t const minSequence)
+{
+    auto const noop = [] {};
+    auto const keep = [](auto const&) {};
+
+    // keep the newest version visible at minSequence and everything after it
+    auto const pruneVersions = [&](auto& table) {
+        return forEachSliced<std::unique_lock>(
+            table,
+            [&table, minSequence](auto it) {
+                auto& versions = it->second;
+                if (auto const visible = versions.lower_bound(minSequence); visible != versions.end())
+                    versions.erase(std::next(visible), versions.end());
+
+                return versions.empty() ? table.erase(it) : std::next(it);
+            },
+            noop
+        );
+    };
+
+    auto const pruneIndex = [&](auto& table) {
+        return forEachSliced<std::unique_lock>(
+            table,
+            [&table, minSequence](auto it) {
+                auto& index = it->second;
+                index.erase(index.begin(), index.lower_bound(std::make_tuple(minSequence, 0u)));
+
+                return index.empty() ? table.erase(it) : std::next(it);
+            },
+            noop
+        );
+    };
+
+    // erase the entries of a table keyed by ledger sequence up to minSequence
+    auto const pruneLedgers = [&](auto& table, auto const& onErase) {
+        return forEachSliced<std::unique_lock>(
+            table,
+            [&table, &onErase, minSequence](auto it) {
+                if (it->first >= minSequence)
+                    return table.end();
+
+                onErase(it->second);
+                return table.erase(it);
+            },
+            noop
+        );
+    };
+
+    auto const pruneObjects = [&] {
+        return forEachSliced<std::unique_lock>(
+            objects_,
+            [this, minSequence](auto it) {
+                auto& versions = it->second;
+                if (auto const visible = versions.lower_bound(minSequence); visible != versions.end())
+                    versions.erase(std::next(visible), versions.end());
+
+                // objects deleted before minSequence are not visible in any of the remaining ledgers
+                auto const deleted = versions.size() == 1 and versions.begin()->first <= minSequence and
+                    versions.begin()->second.empty();
+                return versions.empty() or deleted ? objects_.erase(it) : std::next(it);
+            },
+            noop
+        );
+    };
+
+    auto const pruneLedgerHashes = [&] {
+        return forEachSliced<std::unique_lock>(
+            ledgerHashes_,
+            [this, minSequence](auto it) { return it->second < minSequence ? ledgerHashes_.erase(it) : std::next(it); },
+            noop
+        );
+    };
+
+    auto const eraseTransactions = [this](auto const& hashes) {
+        for (auto const& hash : hashes)
+            transactions_.erase(hash);
+    };
+
+    return pruneObjects() and pruneVersions(successors_) and pruneVersions(nfts_) and pruneVersions(nftURIs_) and
+        pruneLedgers(ledgers_, keep) and pruneLedgerHashes() and pruneLedgers(diffs_, keep) and
+        pruneLedgers(ledgerTransactions_, eraseTransactions) and pruneIndex(accountTransactions_) and
+        pruneIndex(nftTransactions_);
+}
+
+bool
+EmbeddedBackend::writeSnapshot(
+    WriteAheadLog::Rewrite& rewrite,
+    std::uint32_t const minSequence,
+    std::uint32_t const maxSequence
+)
+{
+    // Ledgers committed after the snapshot started are skipped: they are copied over from the tail of the log
+    std::string chunk;
+    Encoder encoder{chunk};
+
+    auto const flush = [&] {
+        if (chunk.size() >= settings_.chunkSize) {
+            rewrite.append(chunk, false);
+            chunk.clear();
+        }
+    };
+
+    auto const snapshotVersions = [&](auto const& table, auto const& encode) {
+        return forEachSliced<std::shared_lock>(
+            table,
+            [&](auto it) {
+                for (auto const& [seq, value] : it->second) {
+                    if (seq <= maxSequence)
+                        encode(it->first, seq, value);
+                }
+                return std::next(it);
+            },
+            flush
+        );
+    };
+
+    auto const snapshotIndex = [&](auto const& table, auto const& encode) {
+        return forEachSliced<std::shared_lock>(
+            table,
+            [&](auto it) {
+                for (auto const& [seqIdx, hash] : it->second) {
+                    auto const [seq, idx] = seqIdx;
+                    if (seq <= maxSequence)
+                        encode(it->first, seq, idx, hash);
+                }
+                return std::next(it);
+            },
+            flush
+        );
+    };
+
+    auto const snapshotLedgers = [&](auto const& table, auto const& encode) {
+        return forEachSliced<std::shared_lock>(
+            table,
+            [&](auto it) {
+                if (it->first > maxSequence)
+                    return table.end();
+
+                encode(it->first, it->second);
+                return std::next(it);
+            },
+            flush
+        );
+    };
+
+    auto const snapshotLedgerHeaders = [&] {
+        return forEachSliced<std::shared_lock>(
+            std::as_const(ledgerHashes_),
+            [&](auto it) {
+                auto const& [hash, seq] = *it;
+                if (auto const ledger = ledgers_.find(seq); seq <= maxSequence and ledger != ledgers_.end())
+                    encoder.type(RecordType::Ledger).raw(hash).u32(seq).bytes(ledger->second);
+                return std::next(it);
+            },
+            flush
+        );
+    };
+
+    auto const encodeObject = [&](auto const& key, auto seq, auto const& blob) {
+        encoder.type(RecordType::Object).raw(key).u32(seq).bytes(blob);
+    };
+
+    auto const encodeDiff = [&](auto seq, auto const& keys) {
+        for (auto const& key : keys)
+            encoder.type(RecordType::Diff).u32(seq).raw(key);
+    };
+
+    auto const encodeSuccessor = [&](auto const& key, auto seq, auto const& successor) {
+        encoder.type(RecordType::Successor).raw(key).u32(seq).raw(successor);
+    };
+
+    auto const encodeTransactions = [&](auto, auto const& hashes) {
+        for (auto const& hash : hashes) {
+            auto const txn = transactions_.find(hash);
+            if (txn == transactions_.end())
+                continue;
+
+            encoder.type(RecordType::Transaction)
+                .raw(hash)
+                .u32(txn->second.ledgerSequence)
+                .u32(txn->second.date)
+                .bytes(txn->second.transaction)
+                .bytes(txn->second.metadata);
+        }
+    };
+
+    auto const encodeAccountTransaction = [&](auto const& account, auto seq, auto idx, auto const& hash) {
+        encoder.type(RecordType::AccountTransaction).raw(account).u32(seq).u32(idx).raw(hash);
+    };
+
+    auto const encodeNFT = [&](auto const& tokenID, auto seq, auto const& state) {
+        encoder.type(RecordType::NFT).raw(tokenID).u32(seq).raw(state.owner).u32(state.isBurned ? 1 : 0);
+    };
+
+    auto const encodeNFTURI = [&](auto const& tokenID, auto seq, auto const& uri) {
+        encoder.type(RecordType::NFTURI).raw(tokenID).u32(seq).bytes(uri);
+    };
+
+    auto const encodeNFTTransaction = [&](auto const& tokenID, auto seq, auto idx, auto const& hash) {
+        encoder.type(RecordType::NFTTransaction).raw(tokenID).u32(seq).u32(idx).raw(hash);
+    };
+
+    auto const complete = snapshotLedgerHeaders() and snapshotVersions(objects_, encodeObject) and
+        snapshotLedgers(diffs_, encodeDiff) and snapshotVersions(successors_, encodeSuccessor) and
+        snapshotLedgers(ledgerTransactions_, encodeTransactions) and
+        snapshotIndex(accountTransactions_, encodeAccountTransaction) and snapshotVersions(nfts_, encodeNFT) and
+        snapshotVersions(nftURIs_, encodeNFTURI) and snapshotIndex(nftTransactions_, encodeNFTTransaction);
+
+    if (not complete)
+        return false;
+
+    encoder.type(RecordType::Range).u32(minSequence).u32(maxSequence);
+    rewrite.append(chunk, true);
+    return true;
+}
+
+}  // namespace data::embedded
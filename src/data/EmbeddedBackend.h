@@ -0,0 +1,336 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <data/BackendInterface.h>
+#include <data/embedded/WriteAheadLog.h>
+#include <util/config/Config.h>
+#include <util/log/Logger.h>
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/AccountID.h>
+#include <boost/asio/spawn.hpp>
+#include <boost/json.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace data::embedded {
+
+/**
+ * @brief Settings of the embedded backend.
+ */
+struct Settings {
+    std::string path = "./clio_db";
+    bool sync = true;
+    std::uint32_t onlineDelete = 0;
+    std::size_t chunkSize = 16u * 1024 * 1024;
+
+    /**
+     * @brief Read the settings from the `database.embedded` section of the config.
+     *
+     * @param cfg The section to read from
+     * @return The settings
+     */
+    static Settings
+    fromConfig(util::Config const& cfg);
+};
+
+/**
+ * @brief Implements @ref BackendInterface on top of local storage for single node deployments.
+ *
+ * This is a memory resident store with a persistent log, not a paged on-disk engine: every table is kept in an ordered
+ * map and the whole data set must fit in RAM, which makes it suitable for edge nodes serving a bounded window of
+ * ledgers (see `online_delete`, which @ref data::make_Backend requires for a writer) and for benchmarks, not for full
+ * history.
+ *
+ * Versioned entries (objects, successors, NFTs) are stored newest first so that a read at a given sequence is a single
+ * lookup. Durability comes from a @ref WriteAheadLog: writes are buffered and appended to the log in chunks of
+ * `chunkSize` bytes, and `finishWrites` appends the last chunk together with the new range as the commit of the
+ * ledger. Like with the Cassandra backend, data of a ledger can be read before it is committed, but the range only
+ * covers committed ledgers. On startup the committed batches of the log are replayed to rebuild the tables.
+ *
+ * If `online_delete` is set, once the stored range grows to twice that many ledgers the range is shrunk right away and
+ * a background thread deletes everything that is only needed to serve older ledgers and compacts the log. Both steps
+ * work on small slices of the tables at a time, so readers and the ETL are never blocked for long.
+ */
+class EmbeddedBackend : public BackendInterface {
+    template <typename T>
+    using Versions = std::map<std::uint32_t, T, std::greater<>>;
+
+    using TransactionIndex = std::map<std::tuple<std::uint32_t, std::uint32_t>, ripple::uint256>;
+
+    struct NFTState {
+        ripple::AccountID owner;
+        bool isBurned = false;
+    };
+
+    util::Logger log_{"Backend"};
+
+    Settings settings_;
+    bool readOnly_;
+    WriteAheadLog wal_;
+    std::mutex walMtx_;
+    bool batchFailed_ = false;  // guarded by walMtx_
+
+    std::mutex pendingMtx_;
+    std::string pending_;
+    std::uint32_t ledgerSequence_ = 0u;
+
+    std::mutex compactionMtx_;
+    std::mutex compactorMtx_;
+    std::condition_variable compactorCv_;
+    std::optional<std::uint32_t> compactionRequest_;
+    std::atomic_bool stopping_ = false;
+
+    mutable std::shared_mutex mtx_;
+    std::optional<LedgerRange> storedRange_;
+    std::map<std::uint32_t, Blob> ledgers_;
+    std::map<ripple::uint256, std::uint32_t> ledgerHashes_;
+    std::map<ripple::uint256, Versions<Blob>> objects_;
+    std::map<std::uint32_t, std::set<ripple::uint256>> diffs_;
+    std::map<ripple::uint256, Versions<ripple::uint256>> successors_;
+    std::map<ripple::uint256, TransactionAndMetadata> transactions_;
+    std::map<std::uint32_t, std::set<ripple::uint256>> ledgerTransactions_;
+    std::map<ripple::AccountID, TransactionIndex> accountTransactions_;
+    std::map<ripple::uint256, Versions<NFTState>> nfts_;
+    std::map<ripple::uint256, Versions<Blob>> nftURIs_;
+    std::map<ripple::AccountID, std::set<std::tuple<std::uint32_t, ripple::uint256>>> issuerNFTs_;
+    std::map<ripple::uint256, TransactionIndex> nftTransactions_;
+
+    std::thread compactor_;
+
+public:
+    /**
+     * @brief Create a new embedded backend, replaying its log if one exists.
+     *
+     * @param settings The settings to use
+     * @param readOnly Whether the backend should refuse writes
+     */
+    EmbeddedBackend(Settings settings, bool readOnly);
+
+    /** @brief Stops the background compaction, abandoning a compaction in progress. */
+    ~EmbeddedBackend() override;
+
+    EmbeddedBackend(EmbeddedBackend const&) = delete;
+    EmbeddedBackend&
+    operator=(EmbeddedBackend const&) = delete;
+
+    /**
+     * @brief Delete everything that is only needed to serve ledgers older than the given sequence and compact the log.
+     *
+     * Runs on the calling thread; online deletion runs the same steps in the background.
+     *
+     * Ledger objects, successors and NFTs keep the last version visible at `minSequence`, so that ledger remains fully
+     * readable and becomes the first ledger of the range.
+     *
+     * @param minSequence The first ledger to keep
+     * @return true on success; false otherwise
+     */
+    bool
+    deleteLedgersBefore(std::uint32_t minSequence);
+
+    std::optional<ripple::LedgerHeader>
+    fetchLedgerBySequence(std::uint32_t sequence, boost::asio::yield_context yield) const override;
+
+    std::optional<ripple::LedgerHeader>
+    fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context yield) const override;
+
+    std::optional<std::uint32_t>
+    fetchLatestLedgerSequence(boost::asio::yield_context yield) const override;
+
+    std::optional<TransactionAndMetadata>
+    fetchTransaction(ripple::uint256 const& hash, boost::asio::yield_context yield) const override;
+
+    std::vector<TransactionAndMetadata>
+    fetchTransactions(std::vector<ripple::uint256> const& hashes, boost::asio::yield_context yield) const override;
+
+    TransactionsAndCursor
+    fetchAccountTransactions(
+        ripple::AccountID const& account,
+        std::uint32_t limit,
+        bool forward,
+        std::optional<TransactionsCursor> const& cursor,
+        boost::asio::yield_context yield
+    ) const override;
+
+    std::vector<TransactionAndMetadata>
+    fetchAllTransactionsInLedger(std::uint32_t ledgerSequence, boost::asio::yield_context yield) const override;
+
+    std::vector<ripple::uint256>
+    fetchAllTransactionHashesInLedger(std::uint32_t ledgerSequence, boost::asio::yield_context yield) const override;
+
+    std::optional<NFT>
+    doFetchNFT(ripple::uint256 const& tokenID, std::uint32_t ledgerSequence, boost::asio::yield_context yield)
+        const override;
+
+    TransactionsAndCursor
+    fetchNFTTransactions(
+        ripple::uint256 const& tokenID,
+        std::uint32_t limit,
+        bool forward,
+        std::optional<TransactionsCursor> const& cursorIn,
+        boost::asio::yield_context yield
+    ) const override;
+
+    NFTsAndCursor
+    doFetchNFTsByIssuer(
+        ripple::AccountID const& issuer,
+        std::optional<std::uint32_t> const& taxon,
+        std::uint32_t ledgerSequence,
+        std::uint32_t limit,
+        std::optional<ripple::uint256> const& cursorIn,
+        boost::asio::yield_context yield
+    ) const override;
+
+    std::optional<Blob>
+    doFetchLedgerObject(ripple::uint256 const& key, std::uint32_t sequence, boost::asio::yield_context yield)
+        const override;
+
+    std::vector<Blob>
+    doFetchLedgerObjects(
+        std::vector<ripple::uint256> const& keys,
+        std::uint32_t sequence,
+        boost::asio::yield_context yield
+    ) const override;
+
+    std::vector<LedgerObject>
+    fetchLedgerDiff(std::uint32_t ledgerSequence, boost::asio::yield_context yield) const override;
+
+    LedgerScanPage
+    fetchLedgerScanPage(
+        ScanRange const& range,
+        std::optional<std::string> const& cursor,
+        std::uint32_t ledgerSequence,
+        std::uint32_t limit,
+        boost::asio::yield_context yield
+    ) const override;
+
+    std::optional<ripple::uint256>
+    doFetchSuccessorKey(ripple::uint256 key, std::uint32_t ledgerSequence, boost::asio::yield_context yield)
+        const override;
+
+    std::optional<LedgerRange>
+    hardFetchLedgerRange(boost::asio::yield_context yield) const override;
+
+    void
+    writeLedger(ripple::LedgerHeader const& ledgerHeader, std::string&& blob) override;
+
+    void
+    writeTransaction(
+        std::string&& hash,
+        std::uint32_t seq,
+        std::uint32_t date,
+        std::string&& transaction,
+        std::string&& metadata
+    ) override;
+
+    void
+    writeNFTs(std::vector<NFTsData>&& data) override;
+
+    void
+    writeAccountTransactions(std::vector<AccountTransactionsData>&& data) override;
+
+    void
+    writeNFTTransactions(std::vector<NFTTransactionsData>&& data) override;
+
+    void
+    writeSuccessor(std::string&& key, std::uint32_t seq, std::string&& successor) override;
+
+    void
+    startWrites() const override
+    {
+        // Note: writes are buffered until doFinishWrites, nothing to start here.
+    }
+
+    bool
+    isTooBusy() const override
+    {
+        return false;
+    }
+
+    boost::json::object
+    stats() const override;
+
+private:
+    void
+    doWriteLedgerObject(std::string&& key, std::uint32_t seq, std::string&& blob) override;
+
+    bool
+    doFinishWrites() override;
+
+    // appends the pending writes to the log as a chunk of the current ledger once they grew past the chunk size
+    void
+    flushIfLarge();
+
+    // must be called with walMtx_ held
+    void
+    abortBatch();
+
+    void
+    raiseMinSequence(std::uint32_t minSequence);
+
+    void
+    requestCompaction(std::uint32_t minSequence);
+
+    void
+    runCompactor();
+
+    // must be called with compactionMtx_ held
+    bool
+    compact(std::uint32_t minSequence);
+
+    // must be called with mtx_ held exclusively
+    void
+    apply(std::string_view batch);
+
+    bool
+    prune(std::uint32_t minSequence);
+
+    bool
+    writeSnapshot(WriteAheadLog::Rewrite& rewrite, std::uint32_t minSequence, std::uint32_t maxSequence);
+
+    /**
+     * @brief Visit a table a slice at a time, holding the lock only while visiting a slice.
+     *
+     * @param table The table to visit; entries may be added or removed between slices
+     * @param visit Called with an iterator to each entry; returns the iterator to continue from and may erase
+     * @param afterSlice Called after each slice, without the lock
+     * @return false if the traversal was abandoned because the backend is stopping; true otherwise
+     */
+    template <template <typename> typename Lock, typename Table, typename Visit, typename AfterSlice>
+    bool
+    forEachSliced(Table& table, Visit const& visit, AfterSlice const& afterSlice);
+};
+
+}  // namespace data::embedded
@@ -19,6 +19,9 @@
 
 #include <data/LedgerCache.h>
 
+#include <chrono>
+#include <stdexcept>
+
 namespace data {
 
 uint32_t
@@ -34,23 +37,52 @@ LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool is
     if (disabled_)
         return;
 
+    // compressing is the expensive part of an update, so it's done before taking the lock that blocks every reader;
+    // compressor_ and bounded_ are only ever set at startup, before the cache is populated
+    std::vector<Blob> compressed;
+    if (compressor_ and not bounded_) {
+        compressed.reserve(objs.size());
+        for (auto const& obj : objs)
+            compressed.push_back(obj.blob.empty() ? Blob{} : compressor_->compress(obj.blob));
+    }
+
     {
         std::scoped_lock const lck{mtx_};
         if (seq > latestSeq_) {
             assert(seq == latestSeq_ + 1 || latestSeq_ == 0);
             latestSeq_ = seq;
         }
-        for (auto const& obj : objs) {
+
+        if (bounded_) {
+            for (auto const& obj : objs)
+                bounded_->update(obj.key, seq, obj.blob);
+            boundedBytes_.get().set(static_cast<std::int64_t>(bounded_->bytes()));
+            return;
+        }
+
+        for (std::size_t i = 0; i < objs.size(); ++i) {
+            auto const& obj = objs[i];
             if (!obj.blob.empty()) {
                 if (isBackground && deletes_.contains(obj.key))
                     continue;
 
                 auto& e = map_[obj.key];
                 if (seq > e.seq) {
-                    e = {seq, obj.blob};
+                    uncompressedBytes_.get() -= e.size;
+                    storedBytes_.get() -= static_cast<std::int64_t>(e.blob.size());
+
+                    auto blob = compressor_ ? std::move(compressed[i]) : obj.blob;
+                    e = {seq, static_cast<uint32_t>(obj.blob.size()), std::move(blob)};
+
+                    uncompressedBytes_.get() += e.size;
+                    storedBytes_.get() += static_cast<std::int64_t>(e.blob.size());
                 }
             } else {
-                map_.erase(obj.key);
+                if (auto const it = map_.find(obj.key); it != map_.end()) {
+                    uncompressedBytes_.get() -= it->second.size;
+                    storedBytes_.get() -= static_cast<std::int64_t>(it->second.blob.size());
+                    map_.erase(it);
+                }
                 if (!full_ && !isBackground)
                     deletes_.insert(obj.key);
             }
@@ -71,7 +103,7 @@ LedgerCache::getSuccessor(ripple::uint256 const& key, uint32_t seq) const
     if (e == map_.end())
         return {};
     ++successorHitCounter_.get();
-    return {{e->first, e->second.blob}};
+    return {{e->first, decode(e->second)}};
 }
 
 std::optional<LedgerObject>
@@ -86,7 +118,7 @@ LedgerCache::getPredecessor(ripple::uint256 const& key, uint32_t seq) const
     if (e == map_.begin())
         return {};
     --e;
-    return {{e->first, e->second.blob}};
+    return {{e->first, decode(e->second)}};
 }
 
 std::optional<Blob>
@@ -95,6 +127,15 @@ LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
     std::shared_lock const lck{mtx_};
     if (seq > latestSeq_)
         return {};
+
+    if (bounded_) {
+        ++boundedReqCounter_.get();
+        auto blob = bounded_->get(key, seq);
+        if (blob)
+            ++boundedHitCounter_.get();
+        return blob;
+    }
+
     ++objectReqCounter_.get();
     auto e = map_.find(key);
     if (e == map_.end())
@@ -102,7 +143,59 @@ LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
     if (seq < e->second.seq)
         return {};
     ++objectHitCounter_.get();
-    return {e->second.blob};
+    return {decode(e->second)};
+}
+
+void
+LedgerCache::put(ripple::uint256 const& key, uint32_t seq, Blob const& blob) const
+{
+    // bounded_ is only ever set at startup, before any object is fetched
+    if (not bounded_ or blob.empty())
+        return;
+
+    // update() changes objects and moves to the next sequence under the exclusive lock, so holding the shared lock is
+    // enough for an object of the latest sequence not to be put after it has changed; the bounded cache locks the
+    // shard of the key itself
+    std::shared_lock const lck{mtx_};
+    if (seq != latestSeq_)
+        return;
+
+    bounded_->put(key, seq, blob);
+    boundedBytes_.get().set(static_cast<std::int64_t>(bounded_->bytes()));
+}
+
+void
+LedgerCache::setCompression(int level)
+{
+    std::scoped_lock const lck{mtx_};
+    if (not map_.empty())
+        throw std::logic_error("Cache compression must be set before the cache is populated");
+
+    compressor_ = std::make_unique<CacheCompressor>(level);
+}
+
+bool
+LedgerCache::isCompressed() const
+{
+    std::shared_lock const lck{mtx_};
+    return compressor_ != nullptr;
+}
+
+void
+LedgerCache::setBounded(std::size_t maxBytes)
+{
+    std::scoped_lock const lck{mtx_};
+    if (not map_.empty())
+        throw std::logic_error("Cache must be bounded before it is populated");
+
+    bounded_ = std::make_unique<BoundedObjectCache>(maxBytes);
+}
+
+bool
+LedgerCache::isBounded() const
+{
+    std::shared_lock const lck{mtx_};
+    return bounded_ != nullptr;
 }
 
 void
@@ -114,7 +207,7 @@ LedgerCache::setDisabled()
 void
 LedgerCache::setFull()
 {
-    if (disabled_)
+    if (disabled_ or isBounded())
         return;
 
     full_ = true;
@@ -132,7 +225,7 @@ size_t
 LedgerCache::size() const
 {
     std::shared_lock const lck{mtx_};
-    return map_.size();
+    return bounded_ ? bounded_->size() : map_.size();
 }
 
 float
@@ -143,6 +236,14 @@ LedgerCache::getObjectHitRate() const
     return static_cast<float>(objectHitCounter_.get().value()) / objectReqCounter_.get().value();
 }
 
+float
+LedgerCache::getBoundedHitRate() const
+{
+    if (boundedReqCounter_.get().value() == 0u)
+        return 1;
+    return static_cast<float>(boundedHitCounter_.get().value()) / boundedReqCounter_.get().value();
+}
+
 float
 LedgerCache::getSuccessorHitRate() const
 {
@@ -151,4 +252,19 @@ LedgerCache::getSuccessorHitRate() const
     return static_cast<float>(successorHitCounter_.get().value()) / successorReqCounter_.get().value();
 }
 
+Blob
+LedgerCache::decode(CacheEntry const& entry) const
+{
+    if (not compressor_)
+        return entry.blob;
+
+    auto const start = std::chrono::steady_clock::now();
+    auto blob = compressor_->decompress(entry.blob);
+    ++decompressionCounter_.get();
+    decompressionDuration_.get() +=
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    return blob;
+}
+
 }  // namespace data
@@ -21,8 +21,11 @@
 
 #include <ripple/basics/base_uint.h>
 #include <ripple/basics/hardened_hash.h>
+#include <data/BoundedObjectCache.h>
+#include <data/CacheCompressor.h>
 #include <data/Types.h>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <util/prometheus/Prometheus.h>
@@ -33,10 +36,17 @@ namespace data {
 
 /**
  * @brief Cache for an entire ledger.
+ *
+ * Objects can optionally be kept compressed, trading CPU on every read for memory. See @ref CacheCompressor.
+ *
+ * Alternatively, the cache can be bounded to a memory cap. It then only holds objects that were recently fetched from
+ * the database and ETL changes are applied to the ones already cached. See @ref BoundedObjectCache. A bounded cache is
+ * never full, so it serves point lookups only.
  */
 class LedgerCache {
     struct CacheEntry {
         uint32_t seq = 0;
+        uint32_t size = 0;  // uncompressed size of blob
         Blob blob;
     };
 
@@ -51,6 +61,16 @@ class LedgerCache {
         util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "ledger_objects"}})
     )};
 
+    // counters for fetchLedgerObject(s) hit rate when the cache is bounded
+    std::reference_wrapper<util::prometheus::CounterInt> boundedReqCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}, {"fetch", "bounded_ledger_objects"}})
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> boundedHitCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "bounded_ledger_objects"}})
+    )};
+
     // counters for fetchSuccessorKey hit rate
     std::reference_wrapper<util::prometheus::CounterInt> successorReqCounter_{PrometheusService::counterInt(
         "ledger_cache_counter_total_number",
@@ -62,7 +82,34 @@ class LedgerCache {
         util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "successor_key"}})
     )};
 
+    // memory used by the cached objects and cost of decompressing them
+    std::reference_wrapper<util::prometheus::GaugeInt> uncompressedBytes_{PrometheusService::gaugeInt(
+        "ledger_cache_bytes_current_number",
+        util::prometheus::Labels({{"type", "uncompressed"}}),
+        "Size of the objects in the ledger cache"
+    )};
+    std::reference_wrapper<util::prometheus::GaugeInt> storedBytes_{PrometheusService::gaugeInt(
+        "ledger_cache_bytes_current_number",
+        util::prometheus::Labels({{"type", "stored"}})
+    )};
+    std::reference_wrapper<util::prometheus::GaugeInt> boundedBytes_{PrometheusService::gaugeInt(
+        "ledger_cache_bytes_current_number",
+        util::prometheus::Labels({{"type", "bounded"}})
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> decompressionCounter_{PrometheusService::counterInt(
+        "ledger_cache_decompression_total_number",
+        util::prometheus::Labels(),
+        "Total number of objects decompressed when read from the ledger cache"
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> decompressionDuration_{PrometheusService::counterInt(
+        "ledger_cache_decompression_duration_us",
+        util::prometheus::Labels(),
+        "Total time spent decompressing objects read from the ledger cache"
+    )};
+
     std::map<ripple::uint256, CacheEntry> map_;
+    std::unique_ptr<CacheCompressor> compressor_;
+    std::unique_ptr<BoundedObjectCache> bounded_;
 
     mutable std::shared_mutex mtx_;
     uint32_t latestSeq_ = 0;
@@ -93,6 +140,19 @@ public:
     std::optional<Blob>
     get(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Offer an object fetched from the database to the cache.
+     *
+     * Only used when the cache is bounded and only for objects of the latest sequence; ignored otherwise. This is
+     * const for the same reason get() is: it doesn't change what the cache answers for any key, only how fast.
+     *
+     * @param key The key of the object
+     * @param seq The sequence the object was fetched for
+     * @param blob The object
+     */
+    void
+    put(ripple::uint256 const& key, uint32_t seq, Blob const& blob) const;
+
     /**
      * @brief Gets a cached successor.
      *
@@ -117,6 +177,36 @@ public:
     std::optional<LedgerObject>
     getPredecessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Keep the cached objects compressed.
+     *
+     * @param level The zstd compression level to use
+     * @throw std::logic_error if the cache is not empty
+     */
+    void
+    setCompression(int level = CacheCompressor::DEFAULT_LEVEL);
+
+    /**
+     * @return true if the cached objects are kept compressed; false otherwise
+     */
+    bool
+    isCompressed() const;
+
+    /**
+     * @brief Bound the cache to a memory cap instead of loading it in its entirety.
+     *
+     * @param maxBytes The memory cap
+     * @throw std::logic_error if the cache is not empty
+     */
+    void
+    setBounded(std::size_t maxBytes);
+
+    /**
+     * @return true if the cache is bounded; false otherwise
+     */
+    bool
+    isBounded() const;
+
     /**
      * @brief Disables the cache.
      */
@@ -128,7 +218,7 @@ public:
      *
      * This is used when cache loaded in its entirety at startup of the application. This can be either loaded from DB,
      * populated together with initial ledger download (on first run) or downloaded from a peer node (specified in
-     * config).
+     * config). Does nothing if the cache is bounded.
      */
     void
     setFull();
@@ -146,7 +236,7 @@ public:
     isFull() const;
 
     /**
-     * @return The total size of the cache.
+     * @return The total number of objects in the cache.
      */
     size_t
     size() const;
@@ -157,11 +247,22 @@ public:
     float
     getObjectHitRate() const;
 
+    /**
+     * @return A number representing the success rate of hitting an object in the bounded cache versus missing it.
+     */
+    float
+    getBoundedHitRate() const;
+
     /**
      * @return A number representing the success rate of hitting a successor in the cache versus missing it.
      */
     float
     getSuccessorHitRate() const;
+
+private:
+    // must be called with mtx_ held
+    Blob
+    decode(CacheEntry const& entry) const;
 };
 
 }  // namespace data
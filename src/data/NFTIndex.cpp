@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <data/NFTIndex.h>
+
+#include <ripple/protocol/nft.h>
+
+#include <iterator>
+#include <map>
+#include <mutex>
+
+namespace data {
+
+namespace {
+
+std::pair<std::uint32_t, ripple::uint256>
+issuerKey(ripple::uint256 const& tokenID)
+{
+    return {ripple::nft::toUInt32(ripple::nft::getTaxon(tokenID)), tokenID};
+}
+
+}  // namespace
+
+void
+NFTIndex::enable(std::size_t maxIssuerTokens, std::size_t maxTokens)
+{
+    std::scoped_lock const lck{mtx_};
+    maxIssuerTokens_ = maxIssuerTokens;
+    maxTokens_ = maxTokens;
+    enabled_ = true;
+}
+
+bool
+NFTIndex::isEnabled() const
+{
+    return enabled_;
+}
+
+std::size_t
+NFTIndex::maxIssuerTokens() const
+{
+    std::shared_lock const lck{mtx_};
+    return maxIssuerTokens_;
+}
+
+void
+NFTIndex::update(std::vector<NFTsData> const& nfts, std::uint32_t seq)
+{
+    if (not enabled_)
+        return;
+
+    // a ledger can change the same token several times, only its last change counts
+    std::map<ripple::uint256, NFTsData const*> latest;
+    for (auto const& nft : nfts) {
+        auto& current = latest[nft.tokenID];
+        if (current == nullptr or nft.transactionIndex.value_or(0) >= current->transactionIndex.value_or(0))
+            current = &nft;
+    }
+
+    std::scoped_lock const lck{mtx_};
+    if (latestSeq_ != 0 and seq != latestSeq_ + 1) {
+        tokens_.clear();
+        issuers_.clear();
+        standaloneTokens_.clear();
+    }
+    latestSeq_ = seq;
+
+    for (auto const& [tokenID, nft] : latest) {
+        auto it = tokens_.find(tokenID);
+        if (it == tokens_.end()) {
+            // only mints carry the URI and only the mints of indexed issuers are kept; other changes to tokens that
+            // are not indexed yet are left to the database
+            auto const issuer = issuers_.find(ripple::nft::getIssuer(tokenID));
+            if (not nft->uri or issuer == issuers_.end())
+                continue;
+
+            it = tokens_.emplace(tokenID, Token{}).first;
+            issuer->second.insert(issuerKey(tokenID));
+        }
+
+        auto& token = it->second;
+        token.seq = seq;
+        token.owner = nft->owner;
+        token.isBurned = nft->isBurned;
+        if (nft->uri)
+            token.uri = nft->uri;
+    }
+}
+
+std::uint32_t
+NFTIndex::latestLedgerSequence() const
+{
+    std::shared_lock const lck{mtx_};
+    return latestSeq_;
+}
+
+std::optional<NFT>
+NFTIndex::getNFT(ripple::uint256 const& tokenID, std::uint32_t seq) const
+{
+    if (not enabled_)
+        return std::nullopt;
+
+    std::shared_lock const lck{mtx_};
+    if (seq > latestSeq_)
+        return std::nullopt;
+
+    auto const it = tokens_.find(tokenID);
+    if (it == tokens_.end() or seq < it->second.seq or not it->second.uri)
+        return std::nullopt;
+
+    auto const& token = it->second;
+    return NFT{tokenID, token.seq, token.owner, *token.uri, token.isBurned};
+}
+
+std::optional<NFTsAndCursor>
+NFTIndex::getNFTsByIssuer(
+    ripple::AccountID const& issuer,
+    std::optional<std::uint32_t> const& taxon,
+    std::uint32_t seq,
+    std::uint32_t limit,
+    std::optional<ripple::uint256> const& cursor
+) const
+{
+    if (not enabled_)
+        return std::nullopt;
+
+    std::shared_lock const lck{mtx_};
+    if (seq != latestSeq_)
+        return std::nullopt;
+
+    auto const issuerIt = issuers_.find(issuer);
+    if (issuerIt == issuers_.end())
+        return std::nullopt;
+
+    auto const& tokens = issuerIt->second;
+    auto it = [&]() {
+        if (taxon) {
+            return cursor ? tokens.upper_bound({*taxon, *cursor}) : tokens.lower_bound({*taxon, ripple::uint256{}});
+        }
+        return cursor ? tokens.upper_bound(issuerKey(*cursor)) : tokens.begin();
+    }();
+
+    NFTsAndCursor page;
+    for (; it != tokens.end() and page.nfts.size() < limit; ++it) {
+        if (taxon and it->first != *taxon)
+            break;
+
+        auto const& token = tokens_.at(it->second);
+        page.nfts.emplace_back(it->second, token.seq, token.owner, token.uri.value_or(Blob{}), token.isBurned);
+    }
+
+    if (page.nfts.size() == limit and limit > 0)
+        page.cursor = page.nfts.back().tokenID;
+
+    return page;
+}
+
+void
+NFTIndex::put(NFT const& nft, std::uint32_t seq) const
+{
+    if (not enabled_)
+        return;
+
+    std::scoped_lock const lck{mtx_};
+    if (seq != latestSeq_ or tokens_.contains(nft.tokenID))
+        return;
+
+    // the issuer would have indexed the token already, so it is kept on its own
+    insert(nft);
+    standaloneTokens_.push_back(nft.tokenID);
+    evictStandaloneTokens();
+}
+
+bool
+NFTIndex::shouldLoadIssuer(ripple::AccountID const& issuer, std::uint32_t seq) const
+{
+    if (not enabled_)
+        return false;
+
+    std::shared_lock const lck{mtx_};
+    return seq == latestSeq_ and not issuers_.contains(issuer) and not oversizedIssuers_.contains(issuer);
+}
+
+void
+NFTIndex::putIssuer(ripple::AccountID const& issuer, std::vector<NFT> const& nfts, std::uint32_t seq) const
+{
+    if (not enabled_)
+        return;
+
+    std::scoped_lock const lck{mtx_};
+    if (seq != latestSeq_)
+        return;
+
+    auto& tokens = issuers_[issuer];
+    for (auto const& nft : nfts) {
+        // tokens already indexed are at least as recent as the ones just read
+        if (not tokens_.contains(nft.tokenID))
+            insert(nft);
+        tokens.insert(issuerKey(nft.tokenID));
+    }
+}
+
+void
+NFTIndex::skipIssuer(ripple::AccountID const& issuer) const
+{
+    std::scoped_lock const lck{mtx_};
+    oversizedIssuers_.insert(issuer);
+}
+
+std::size_t
+NFTIndex::size() const
+{
+    std::shared_lock const lck{mtx_};
+    return tokens_.size();
+}
+
+void
+NFTIndex::insert(NFT const& nft) const
+{
+    tokens_.emplace(nft.tokenID, Token{nft.ledgerSequence, nft.owner, nft.isBurned, nft.uri});
+}
+
+void
+NFTIndex::evictStandaloneTokens() const
+{
+    while (standaloneTokens_.size() > maxTokens_) {
+        auto const tokenID = standaloneTokens_.front();
+        standaloneTokens_.pop_front();
+
+        // the issuer may have been indexed since, in which case the token is not standalone anymore
+        if (not issuers_.contains(ripple::nft::getIssuer(tokenID)))
+            tokens_.erase(tokenID);
+    }
+}
+
+}  // namespace data
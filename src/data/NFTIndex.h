@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <data/DBHelpers.h>
+#include <data/Types.h>
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/protocol/AccountID.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief In-memory index of the NFTs of the latest ledger, kept up to date with the NFT changes of every new ledger.
+ *
+ * Issuers enter the index when all their tokens have been read from the database once, after which their new mints
+ * are indexed too, so that hot collections are served from memory. Other tokens only enter the index when they are
+ * read from the database; at most the configured number of them is kept and the oldest are evicted first, leaving
+ * them to the database again. A token is valid from the sequence of its last change on, while issuer listings are
+ * only served for the latest sequence. Issuers with more than the configured number of tokens are never indexed.
+ *
+ * The index is disabled unless @ref enable is called. If a ledger is ever skipped, the index is cleared.
+ */
+class NFTIndex {
+    struct Token {
+        std::uint32_t seq = 0;
+        ripple::AccountID owner;
+        bool isBurned = false;
+        std::optional<Blob> uri;
+    };
+
+    // ordered the same way the database orders the tokens of an issuer
+    using IssuerTokens = std::set<std::pair<std::uint32_t, ripple::uint256>>;
+
+    std::atomic_bool enabled_ = false;
+    std::size_t maxIssuerTokens_ = 0;
+    std::size_t maxTokens_ = 0;
+
+    mutable std::shared_mutex mtx_;
+    std::uint32_t latestSeq_ = 0;
+    mutable std::unordered_map<ripple::uint256, Token, ripple::hardened_hash<>> tokens_;
+    mutable std::unordered_map<ripple::AccountID, IssuerTokens, ripple::hardened_hash<>> issuers_;
+    mutable std::unordered_set<ripple::AccountID, ripple::hardened_hash<>> oversizedIssuers_;
+    // tokens indexed outside of any issuer, oldest first
+    mutable std::deque<ripple::uint256> standaloneTokens_;
+
+public:
+    /**
+     * @brief Start indexing.
+     *
+     * @param maxIssuerTokens The maximum number of tokens of an issuer for it to be indexed
+     * @param maxTokens The maximum number of tokens kept outside of indexed issuers
+     */
+    void
+    enable(std::size_t maxIssuerTokens, std::size_t maxTokens);
+
+    /**
+     * @return true if the index is enabled; false otherwise
+     */
+    bool
+    isEnabled() const;
+
+    /**
+     * @return The maximum number of tokens of an issuer for it to be indexed
+     */
+    std::size_t
+    maxIssuerTokens() const;
+
+    /**
+     * @brief Apply the NFT changes of a new ledger.
+     *
+     * @param nfts The NFT changes of the ledger, as extracted by ETL from its transactions
+     * @param seq The sequence of the ledger
+     */
+    void
+    update(std::vector<NFTsData> const& nfts, std::uint32_t seq);
+
+    /**
+     * @return The latest ledger sequence the index is up to date with
+     */
+    std::uint32_t
+    latestLedgerSequence() const;
+
+    /**
+     * @brief Fetch an NFT.
+     *
+     * @param tokenID The ID of the token
+     * @param seq The sequence to fetch for
+     * @return The NFT if it is indexed and valid for the sequence; nullopt otherwise
+     */
+    std::optional<NFT>
+    getNFT(ripple::uint256 const& tokenID, std::uint32_t seq) const;
+
+    /**
+     * @brief Fetch a page of the NFTs of an issuer, with the same ordering and cursor as the database.
+     *
+     * @param issuer The issuer
+     * @param taxon The taxon to filter by, if any
+     * @param seq The sequence to fetch for
+     * @param limit The maximum number of NFTs to return
+     * @param cursor The token ID to resume after, if any
+     * @return The page if the issuer is indexed and seq is the latest sequence; nullopt otherwise
+     */
+    std::optional<NFTsAndCursor>
+    getNFTsByIssuer(
+        ripple::AccountID const& issuer,
+        std::optional<std::uint32_t> const& taxon,
+        std::uint32_t seq,
+        std::uint32_t limit,
+        std::optional<ripple::uint256> const& cursor
+    ) const;
+
+    /**
+     * @brief Offer an NFT read from the database to the index; ignored unless it was read for the latest sequence.
+     *
+     * @param nft The NFT
+     * @param seq The sequence it was read for
+     */
+    void
+    put(NFT const& nft, std::uint32_t seq) const;
+
+    /**
+     * @brief Check whether all the tokens of an issuer should be read from the database to index them.
+     *
+     * @param issuer The issuer
+     * @param seq The sequence of the request
+     * @return true if the issuer should be loaded with @ref putIssuer; false otherwise
+     */
+    bool
+    shouldLoadIssuer(ripple::AccountID const& issuer, std::uint32_t seq) const;
+
+    /**
+     * @brief Index all the tokens of an issuer; ignored unless they were read for the latest sequence.
+     *
+     * @param issuer The issuer
+     * @param nfts All the NFTs of the issuer
+     * @param seq The sequence they were read for
+     */
+    void
+    putIssuer(ripple::AccountID const& issuer, std::vector<NFT> const& nfts, std::uint32_t seq) const;
+
+    /**
+     * @brief Never index an issuer, because it has too many tokens.
+     *
+     * @param issuer The issuer
+     */
+    void
+    skipIssuer(ripple::AccountID const& issuer) const;
+
+    /**
+     * @return The number of indexed tokens
+     */
+    std::size_t
+    size() const;
+
+private:
+    // must be called with mtx_ held
+    void
+    insert(NFT const& nft) const;
+
+    // must be called with mtx_ held
+    void
+    evictStandaloneTokens() const;
+};
+
+}  // namespace data
@@ -22,6 +22,8 @@
 #include <ripple/basics/base_uint.h>
 #include <ripple/protocol/AccountID.h>
 
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <string>
 #include <utility>
@@ -77,8 +79,8 @@ struct TransactionAndMetadata {
     }
 
     TransactionAndMetadata(std::tuple<Blob, Blob, std::uint32_t, std::uint32_t> data)
-        : transaction{std::get<0>(data)}
-        , metadata{std::get<1>(data)}
+        : transaction{std::move(std::get<0>(data))}
+        , metadata{std::move(std::get<1>(data))}
         , ledgerSequence{std::get<2>(data)}
         , date{std::get<3>(data)}
     {
@@ -175,6 +177,48 @@ struct LedgerRange {
     std::uint32_t maxSequence = 0;
 };
 
+/**
+ * @brief A slice of the ledger objects that can be scanned independently of the other slices.
+ *
+ * The bounds are inclusive and cover a signed 64-bit space. It is up to the backend to map its keys onto it; the
+ * Cassandra backend uses the partition token for example.
+ */
+struct ScanRange {
+    std::int64_t first = std::numeric_limits<std::int64_t>::min();
+    std::int64_t last = std::numeric_limits<std::int64_t>::max();
+
+    /**
+     * @brief Split the whole space into ranges of equal size.
+     *
+     * @param count The number of ranges; must be positive
+     * @return The ranges, in ascending order
+     */
+    static std::vector<ScanRange>
+    split(std::size_t count)
+    {
+        // work on the unsigned space, flipping the sign bit maps it onto the signed one in order
+        static constexpr auto SIGN_BIT = std::uint64_t{1} << 63;
+        auto const step = std::numeric_limits<std::uint64_t>::max() / count;
+
+        std::vector<ScanRange> ranges;
+        ranges.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const first = i * step;
+            auto const last = i + 1 == count ? std::numeric_limits<std::uint64_t>::max() : first + step - 1;
+            ranges.push_back({static_cast<std::int64_t>(first ^ SIGN_BIT), static_cast<std::int64_t>(last ^ SIGN_BIT)});
+        }
+        return ranges;
+    }
+};
+
+/**
+ * @brief Represents a page of a scan over the ledger objects of a @ref ScanRange.
+ */
+struct LedgerScanPage {
+    std::vector<LedgerObject> objects;
+    std::optional<std::string> cursor;
+};
+
 constexpr ripple::uint256 firstKey{"0000000000000000000000000000000000000000000000000000000000000000"};
 constexpr ripple::uint256 lastKey{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"};
 constexpr ripple::uint256 hi192{"0000000000000000000000000000000000000000000000001111111111111111"};
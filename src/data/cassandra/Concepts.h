@@ -87,6 +87,15 @@ concept SomeExecutionStrategy = requires(
     {
         a.write(std::move(statements))
     } -> std::same_as<void>;
+    {
+        a.writeToPartition(std::string{}, std::move(statement))
+    } -> std::same_as<void>;
+    {
+        a.writeToPartition(std::string{}, prepared)
+    } -> std::same_as<void>;
+    {
+        a.flush()
+    } -> std::same_as<void>;
     {
         a.read(token, prepared)
     } -> std::same_as<ResultOrError>;
@@ -539,6 +539,21 @@ public:
             ));
         }();
 
+        PreparedStatement selectLedgerScanPage = [this]() {
+            return handle_.get().prepare(fmt::format(
+                R"(
+                SELECT key, object
+                  FROM {}
+                 WHERE TOKEN(key) >= ?
+                   AND TOKEN(key) <= ?
+                   AND sequence <= ?
+         PER PARTITION LIMIT 1
+                 ALLOW FILTERING
+                )",
+                qualifiedTableName(settingsProvider_.get(), "objects")
+            ));
+        }();
+
         PreparedStatement getToken = [this]() {
             return handle_.get().prepare(fmt::format(
                 R"(
@@ -110,6 +110,11 @@ SettingsProvider::parseSettings() const
         config_.valueOr<uint32_t>("max_write_requests_outstanding", settings.maxWriteRequestsOutstanding);
     settings.maxReadRequestsOutstanding =
         config_.valueOr<uint32_t>("max_read_requests_outstanding", settings.maxReadRequestsOutstanding);
+    settings.writeBatchSize = config_.valueOr<uint32_t>("write_batch_size", settings.writeBatchSize);
+    settings.adaptiveConcurrency = config_.valueOr<bool>("adaptive_concurrency", settings.adaptiveConcurrency);
+    settings.hedgedReads = config_.valueOr<bool>("hedged_reads", settings.hedgedReads);
+    settings.hedgePercentile = config_.valueOr<uint32_t>("hedge_percentile", settings.hedgePercentile);
+    settings.hedgeBudgetPercent = config_.valueOr<uint32_t>("hedge_budget_percent", settings.hedgeBudgetPercent);
     settings.coreConnectionsPerHost =
         config_.valueOr<uint32_t>("core_connections_per_host", settings.coreConnectionsPerHost);
 
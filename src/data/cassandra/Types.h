@@ -21,6 +21,7 @@
 
 #include <util/Expected.h>
 
+#include <span>
 #include <string>
 
 namespace data::cassandra {
@@ -56,6 +57,13 @@ struct Limit {
     int32_t limit;
 };
 
+/**
+ * @brief A non-owning view of a blob column.
+ *
+ * Points into the memory of the driver's result it was extracted from and is only valid while that Result is alive.
+ */
+using BlobView = std::span<unsigned char const>;
+
 class Handle;
 class CassandraError;
 
@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <data/cassandra/impl/AdaptiveLimiter.h>
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <memory>
+
+namespace data::cassandra::detail {
+
+using util::prometheus::Label;
+using util::prometheus::Labels;
+
+AdaptiveLimiter::AdaptiveLimiter(std::string const& operation, std::uint32_t maxLimit, bool adaptive)
+    : adaptive_{adaptive}
+    , maxLimit_{static_cast<double>(maxLimit)}
+    , minLimit_{static_cast<double>(std::min(MIN_LIMIT, maxLimit))}
+    , limit_{maxLimit_}
+    , limitGauge_{PrometheusService::gaugeInt(
+          "backend_concurrency_limit_current_number",
+          Labels({Label{"operation", operation}}),
+          "Current limit of concurrent database requests"
+      )}
+    , queuedGauge_{PrometheusService::gaugeInt(
+          "backend_queued_requests_current_number",
+          Labels({Label{"operation", operation}}),
+          "Current number of database requests waiting for the concurrency limit"
+      )}
+    , queueDelayGauge_{PrometheusService::gaugeInt(
+          "backend_queue_delay_us",
+          Labels({Label{"operation", operation}}),
+          "Moving average of the time database requests wait for the concurrency limit"
+      )}
+{
+    limitGauge_.set(static_cast<std::int64_t>(limit_));
+}
+
+void
+AdaptiveLimiter::acquire(std::uint32_t count)
+{
+    auto const enqueued = std::chrono::steady_clock::now();
+    std::unique_lock lck(mtx_);
+    if (waiters_.empty() and canStart(count)) {
+        inflight_ += count;
+        onStarted(enqueued);
+        return;
+    }
+
+    // notified with mtx_ held so that cv can't go out of scope before notify_one returns
+    std::condition_variable cv;
+    bool granted = false;
+    waiters_.push_back({count, enqueued, [this, &cv, &granted]() {
+                            std::scoped_lock const lck(mtx_);
+                            granted = true;
+                            cv.notify_one();
+                        }});
+    queuedGauge_.set(static_cast<std::int64_t>(waiters_.size()));
+
+    cv.wait(lck, [&granted]() { return granted; });
+}
+
+void
+AdaptiveLimiter::acquire(boost::asio::yield_context yield, std::uint32_t count)
+{
+    auto const enqueued = std::chrono::steady_clock::now();
+    {
+        std::scoped_lock const lck(mtx_);
+        if (waiters_.empty() and canStart(count)) {
+            inflight_ += count;
+            onStarted(enqueued);
+            return;
+        }
+    }
+
+    auto init = [this, count, enqueued]<typename Self>(Self& self) {
+        auto sself = std::make_shared<Self>(std::move(self));
+        auto resume = [sself]() mutable {
+            boost::asio::post(boost::asio::get_associated_executor(*sself), [sself]() mutable { sself->complete(); });
+        };
+
+        std::unique_lock lck(mtx_);
+        // requests may have been released since the check above
+        if (waiters_.empty() and canStart(count)) {
+            inflight_ += count;
+            onStarted(enqueued);
+            lck.unlock();
+            resume();
+            return;
+        }
+
+        waiters_.push_back({count, enqueued, std::move(resume)});
+        queuedGauge_.set(static_cast<std::int64_t>(waiters_.size()));
+    };
+
+    boost::asio::async_compose<boost::asio::yield_context, void()>(
+        init, yield, boost::asio::get_associated_executor(yield)
+    );
+}
+
+void
+AdaptiveLimiter::release(std::uint32_t count, std::chrono::microseconds latency, bool success, void const* kind)
+{
+    std::vector<std::function<void()>> grants;
+    {
+        std::scoped_lock const lck(mtx_);
+        auto const inflightBefore = inflight_;
+        inflight_ -= std::min<std::uint64_t>(count, inflight_);
+
+        // batches of different sizes take different times even without any congestion
+        if (adaptive_)
+            adapt({kind, static_cast<int>(std::bit_width(count))}, latency, success, inflightBefore);
+
+        grants = admitWaiters();
+    }
+
+    for (auto& grant : grants)
+        grant();
+}
+
+bool
+AdaptiveLimiter::isOverloaded() const
+{
+    std::scoped_lock const lck(mtx_);
+    return not waiters_.empty() and std::chrono::steady_clock::now() - waiters_.front().enqueued >= OVERLOAD_DELAY;
+}
+
+std::uint32_t
+AdaptiveLimiter::limit() const
+{
+    std::scoped_lock const lck(mtx_);
+    return static_cast<std::uint32_t>(limit_);
+}
+
+std::uint64_t
+AdaptiveLimiter::inflight() const
+{
+    std::scoped_lock const lck(mtx_);
+    return inflight_;
+}
+
+bool
+AdaptiveLimiter::isSaturated() const
+{
+    std::scoped_lock const lck(mtx_);
+    return not waiters_.empty() or inflight_ >= static_cast<std::uint64_t>(limit_);
+}
+
+bool
+AdaptiveLimiter::canStart(std::uint32_t count) const
+{
+    return inflight_ == 0 or inflight_ + count <= static_cast<std::uint64_t>(limit_);
+}
+
+std::vector<std::function<void()>>
+AdaptiveLimiter::admitWaiters()
+{
+    std::vector<std::function<void()>> grants;
+    while (not waiters_.empty() and canStart(waiters_.front().count)) {
+        auto& waiter = waiters_.front();
+        inflight_ += waiter.count;
+        onStarted(waiter.enqueued);
+        grants.push_back(std::move(waiter.grant));
+        waiters_.pop_front();
+    }
+
+    queuedGauge_.set(static_cast<std::int64_t>(waiters_.size()));
+    return grants;
+}
+
+void
+AdaptiveLimiter::adapt(
+    BaselineKey const& key,
+    std::chrono::microseconds latency,
+    bool success,
+    std::uint64_t inflightBefore
+)
+{
+    auto const sample = static_cast<double>(latency.count());
+    auto const now = std::chrono::steady_clock::now();
+
+    // failed requests say nothing about how long the request takes when it succeeds
+    auto roundTripUs = sample;
+    if (success) {
+        auto [it, inserted] = baselines_.try_emplace(key, Baseline{sample, sample, now});
+        auto& baseline = it->second;
+
+        // the minimum of the previous window is carried over so that the baseline can also move up when the
+        // cluster's unloaded latency does
+        if (not inserted and now - baseline.windowStart >= MIN_RTT_WINDOW) {
+            baseline.minUs = std::min(baseline.candidateUs, sample);
+            baseline.candidateUs = sample;
+            baseline.windowStart = now;
+        } else {
+            baseline.minUs = std::min(baseline.minUs, sample);
+            baseline.candidateUs = std::min(baseline.candidateUs, sample);
+        }
+
+        latencyRatio_ = latencyRatio_ * (1 - LATENCY_ALPHA) + sample / std::max(baseline.minUs, 1.0) * LATENCY_ALPHA;
+        roundTripUs = baseline.minUs;
+    } else if (auto const it = baselines_.find(key); it != baselines_.end()) {
+        roundTripUs = it->second.minUs;
+    }
+
+    if (not success or latencyRatio_ > LATENCY_TOLERANCE) {
+        // one decrease per round trip, otherwise a burst of slow responses to the same congestion collapses the limit
+        auto const roundTrip = std::chrono::microseconds{static_cast<std::int64_t>(roundTripUs)};
+        if (not lastDecrease_ or now - *lastDecrease_ >= roundTrip) {
+            limit_ = std::max(minLimit_, limit_ * DECREASE_FACTOR);
+            lastDecrease_ = now;
+        }
+    } else if (static_cast<double>(inflightBefore) * 2 >= limit_) {
+        limit_ = std::min(maxLimit_, limit_ + 1.0 / limit_);
+    }
+
+    limitGauge_.set(static_cast<std::int64_t>(limit_));
+}
+
+void
+AdaptiveLimiter::onStarted(std::chrono::steady_clock::time_point enqueued)
+{
+    auto const delay = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - enqueued).count()
+    );
+    queueDelayUs_ = queueDelayUs_ ? *queueDelayUs_ * (1 - ALPHA) + delay * ALPHA : delay;
+    queueDelayGauge_.set(static_cast<std::int64_t>(*queueDelayUs_));
+}
+
+}  // namespace data::cassandra::detail
@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/prometheus/Prometheus.h>
+
+#include <boost/asio/spawn.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace data::cassandra::detail {
+
+/**
+ * @brief Limits the number of concurrent requests to the database, adapting the limit to the observed latency.
+ *
+ * Each request is compared to the baseline of its own kind (the statement, or the kind of batch, and the number of
+ * requests it covers): the minimum latency seen over the last MIN_RTT_WINDOW, which is what the request costs without
+ * queueing anywhere. The ratio to that baseline is smoothed over recent requests so that ordinary tail latency does
+ * not count as congestion; only a sustained rise of the smoothed ratio above LATENCY_TOLERANCE does.
+ *
+ * The limit follows AIMD: it grows by roughly one per round trip while the smoothed ratio stays below the tolerance
+ * and the limit is actually being used, and is cut by 10% at most once per round trip when the ratio is above the
+ * tolerance or a request fails. It always stays within [min(MIN_LIMIT, maxLimit), maxLimit].
+ *
+ * Requests that don't fit within the limit wait in FIFO order, either blocking the calling thread or suspending the
+ * calling coroutine. A request bigger than the whole limit is let through alone so that it can't wait forever.
+ */
+class AdaptiveLimiter {
+public:
+    static constexpr std::uint32_t MIN_LIMIT = 8;
+    static constexpr double DECREASE_FACTOR = 0.9;
+    static constexpr double LATENCY_TOLERANCE = 2.0;
+    static constexpr double ALPHA = 0.01;
+    static constexpr double LATENCY_ALPHA = 0.05;
+    static constexpr std::chrono::seconds MIN_RTT_WINDOW{30};
+    static constexpr std::chrono::milliseconds OVERLOAD_DELAY{500};
+
+private:
+    // the minimum latency of a kind of request over the current window and, for the next window, over the last one
+    struct Baseline {
+        double minUs;
+        double candidateUs;
+        std::chrono::steady_clock::time_point windowStart;
+    };
+
+    using BaselineKey = std::pair<void const*, int>;
+
+    struct Waiter {
+        std::uint32_t count;
+        std::chrono::steady_clock::time_point enqueued;
+        std::function<void()> grant;
+    };
+
+    mutable std::mutex mtx_;
+    bool adaptive_;
+    double maxLimit_;
+    double minLimit_;
+    double limit_;
+    std::uint64_t inflight_ = 0;
+    std::map<BaselineKey, Baseline> baselines_;
+    double latencyRatio_ = 1.0;
+    std::optional<double> queueDelayUs_;
+    std::optional<std::chrono::steady_clock::time_point> lastDecrease_;
+    std::deque<Waiter> waiters_;
+
+    util::prometheus::GaugeInt& limitGauge_;
+    util::prometheus::GaugeInt& queuedGauge_;
+    util::prometheus::GaugeInt& queueDelayGauge_;
+
+public:
+    /**
+     * @brief Create a new limiter.
+     *
+     * @param operation The kind of requests limited, used as the `operation` label of the metrics
+     * @param maxLimit The maximum number of concurrent requests; also the initial limit
+     * @param adaptive Whether the limit should adapt to latency; if false it stays at maxLimit
+     */
+    AdaptiveLimiter(std::string const& operation, std::uint32_t maxLimit, bool adaptive = true);
+
+    /**
+     * @brief Block the calling thread until `count` more requests may be started.
+     *
+     * @param count The number of requests to start
+     */
+    void
+    acquire(std::uint32_t count = 1);
+
+    /**
+     * @brief Suspend the calling coroutine until `count` more requests may be started.
+     *
+     * @param yield The coroutine context
+     * @param count The number of requests to start
+     */
+    void
+    acquire(boost::asio::yield_context yield, std::uint32_t count = 1);
+
+    /**
+     * @brief Mark requests as finished, feeding their latency to the limit, and let waiting requests in.
+     *
+     * @param count The number of requests that finished
+     * @param latency How long the requests took, retries included
+     * @param success Whether the requests succeeded
+     * @param kind Identifies requests with similar latency, e.g. the prepared statement used; may be nullptr
+     */
+    void
+    release(std::uint32_t count, std::chrono::microseconds latency, bool success, void const* kind = nullptr);
+
+    /**
+     * @return The current limit
+     */
+    [[nodiscard]] std::uint32_t
+    limit() const;
+
+    /**
+     * @return The number of requests currently started and not yet released
+     */
+    [[nodiscard]] std::uint64_t
+    inflight() const;
+
+    /**
+     * @return true if no more requests can be started without waiting; false otherwise
+     */
+    [[nodiscard]] bool
+    isSaturated() const;
+
+    /**
+     * @return true if requests have been waiting for the limit for at least OVERLOAD_DELAY, i.e. requests are arriving
+     * faster than the database completes them rather than in a short burst; false otherwise
+     */
+    [[nodiscard]] bool
+    isOverloaded() const;
+
+private:
+    // must be called with mtx_ held
+    [[nodiscard]] bool
+    canStart(std::uint32_t count) const;
+
+    // must be called with mtx_ held; returns the grants to call once mtx_ is released
+    std::vector<std::function<void()>>
+    admitWaiters();
+
+    // must be called with mtx_ held
+    void
+    adapt(BaselineKey const& key, std::chrono::microseconds latency, bool success, std::uint64_t inflightBefore);
+
+    // must be called with mtx_ held
+    void
+    onStarted(std::chrono::steady_clock::time_point enqueued);
+};
+
+}  // namespace data::cassandra::detail
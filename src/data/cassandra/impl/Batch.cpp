@@ -31,9 +31,9 @@ constexpr auto batchDeleter = [](CassBatch* ptr) { cass_batch_free(ptr); };
 
 namespace data::cassandra::detail {
 
-// TODO: Use an appropriate value instead of CASS_BATCH_TYPE_LOGGED for different use cases
+// All batched writes are idempotent and retried until they succeed, so the batchlog of LOGGED batches buys nothing
 Batch::Batch(std::vector<Statement> const& statements)
-    : ManagedObject{cass_batch_new(CASS_BATCH_TYPE_LOGGED), batchDeleter}
+    : ManagedObject{cass_batch_new(CASS_BATCH_TYPE_UNLOGGED), batchDeleter}
 {
     cass_batch_set_is_idempotent(*this, cass_true);
 
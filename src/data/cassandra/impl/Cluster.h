@@ -42,6 +42,9 @@ struct Settings {
     static constexpr std::size_t DEFAULT_CONNECTION_TIMEOUT = 10000;
     static constexpr uint32_t DEFAULT_MAX_WRITE_REQUESTS_OUTSTANDING = 10'000;
     static constexpr uint32_t DEFAULT_MAX_READ_REQUESTS_OUTSTANDING = 100'000;
+    static constexpr uint32_t DEFAULT_WRITE_BATCH_SIZE = 20;
+    static constexpr uint32_t DEFAULT_HEDGE_PERCENTILE = 95;
+    static constexpr uint32_t DEFAULT_HEDGE_BUDGET_PERCENT = 5;
     /**
      * @brief Represents the configuration of contact points for cassandra.
      */
@@ -78,6 +81,21 @@ struct Settings {
     /** @brief The maximum number of outstanding read requests at any given moment */
     uint32_t maxReadRequestsOutstanding = DEFAULT_MAX_READ_REQUESTS_OUTSTANDING;
 
+    /** @brief The maximum number of writes to the same partition sent together in one UNLOGGED batch */
+    uint32_t writeBatchSize = DEFAULT_WRITE_BATCH_SIZE;
+
+    /** @brief Whether the outstanding read and write limits adapt to the observed latency; otherwise they are fixed */
+    bool adaptiveConcurrency = false;
+
+    /** @brief Whether a read still outstanding after the usual latency of its statement is sent a second time */
+    bool hedgedReads = false;
+
+    /** @brief The latency percentile of a statement after which a read is hedged */
+    uint32_t hedgePercentile = DEFAULT_HEDGE_PERCENTILE;
+
+    /** @brief The maximum percentage of reads that may be hedged */
+    uint32_t hedgeBudgetPercent = DEFAULT_HEDGE_BUDGET_PERCENT;
+
     /** @brief The number of connection per host to always have active */
     uint32_t coreConnectionsPerHost = 1u;
 
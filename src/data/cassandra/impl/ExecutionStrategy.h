@@ -23,20 +23,28 @@
 #include <data/BackendInterface.h>
 #include <data/cassandra/Handle.h>
 #include <data/cassandra/Types.h>
+#include <data/cassandra/impl/AdaptiveLimiter.h>
 #include <data/cassandra/impl/AsyncExecutor.h>
+#include <data/cassandra/impl/HedgingPolicy.h>
 #include <util/Expected.h>
 #include <util/log/Logger.h>
+#include <util/trace/Trace.h>
 
 #include <boost/asio.hpp>
 #include <boost/asio/spawn.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace data::cassandra::detail {
 
@@ -54,16 +62,20 @@ class DefaultExecutionStrategy {
 
     std::uint32_t maxWriteRequestsOutstanding_;
     std::atomic_uint32_t numWriteRequestsOutstanding_ = 0;
+    AdaptiveLimiter writeLimiter_;
 
     std::uint32_t maxReadRequestsOutstanding_;
-    std::atomic_uint32_t numReadRequestsOutstanding_ = 0;
-
-    std::mutex throttleMutex_;
-    std::condition_variable throttleCv_;
+    bool adaptiveConcurrency_;
+    AdaptiveLimiter readLimiter_;
+    HedgingPolicy hedging_;
 
     std::mutex syncMutex_;
     std::condition_variable syncCv_;
 
+    std::uint32_t writeBatchSize_;
+    std::mutex partitionsMutex_;
+    std::unordered_map<std::string, std::vector<typename HandleType::StatementType>> partitions_;
+
     boost::asio::io_context ioc_;
     std::optional<boost::asio::io_service::work> work_;
 
@@ -72,9 +84,15 @@ class DefaultExecutionStrategy {
 
     typename BackendCountersType::PtrType counters_;
 
+    // identify batches to the limiters, which keep a latency baseline per kind of request
+    static constexpr char BATCH_READ_KIND = 0;
+    static constexpr char READ_EACH_KIND = 0;
+    static constexpr char BATCH_WRITE_KIND = 0;
+
 public:
     using ResultOrErrorType = typename HandleType::ResultOrErrorType;
     using StatementType = typename HandleType::StatementType;
+
     using PreparedStatementType = typename HandleType::PreparedStatementType;
     using FutureType = typename HandleType::FutureType;
     using FutureWithCallbackType = typename HandleType::FutureWithCallbackType;
@@ -91,14 +109,23 @@ public:
         typename BackendCountersType::PtrType counters = BackendCountersType::make()
     )
         : maxWriteRequestsOutstanding_{settings.maxWriteRequestsOutstanding}
+        // writes adapt to their own latency, separately from reads
+        , writeLimiter_{"write", settings.maxWriteRequestsOutstanding, settings.adaptiveConcurrency}
         , maxReadRequestsOutstanding_{settings.maxReadRequestsOutstanding}
+        , adaptiveConcurrency_{settings.adaptiveConcurrency}
+        , readLimiter_{"read", settings.maxReadRequestsOutstanding, settings.adaptiveConcurrency}
+        , hedging_{settings.hedgedReads, settings.hedgePercentile, settings.hedgeBudgetPercent}
+        , writeBatchSize_{settings.writeBatchSize}
         , work_{ioc_}
         , handle_{std::cref(handle)}
         , thread_{[this]() { ioc_.run(); }}
         , counters_{std::move(counters)}
     {
         LOG(log_.info()) << "Max write requests outstanding is " << maxWriteRequestsOutstanding_
-                         << "; Max read requests outstanding is " << maxReadRequestsOutstanding_;
+                         << "; Max read requests outstanding is " << maxReadRequestsOutstanding_
+                         << "; Write batch size is " << writeBatchSize_
+                         << "; Adaptive concurrency is " << (settings.adaptiveConcurrency ? "enabled" : "disabled")
+                         << "; Hedged reads are " << (settings.hedgedReads ? "enabled" : "disabled");
     }
 
     ~DefaultExecutionStrategy()
@@ -121,12 +148,14 @@ public:
     }
 
     /**
-     * @return true if outstanding read requests allowance is exhausted; false otherwise
+     * @return true if the fixed limit of outstanding read requests is exhausted or, with adaptive concurrency, if reads
+     * have been queueing for the adaptive limit for a while; false otherwise
      */
     bool
     isTooBusy() const
     {
-        bool const result = numReadRequestsOutstanding_ >= maxReadRequestsOutstanding_;
+        // the adaptive limit is expected to be reached routinely, only a queue that doesn't drain means overload
+        bool const result = adaptiveConcurrency_ ? readLimiter_.isOverloaded() : readLimiter_.isSaturated();
         if (result)
             counters_->registerTooBusy();
         return result;
@@ -180,6 +209,7 @@ public:
     {
         auto statement = preparedStatement.bind(std::forward<Args>(args)...);
         incrementOutstandingRequestCount();
+        auto const start = std::chrono::steady_clock::now();
 
         counters_->registerWriteStarted();
         // Note: lifetime is controlled by std::shared_from_this internally
@@ -187,8 +217,8 @@ public:
             ioc_,
             handle_,
             std::move(statement),
-            [this](auto const&) {
-                decrementOutstandingRequestCount();
+            [this, start, kind = &preparedStatement](auto const&) {
+                decrementOutstandingRequestCount(start, kind);
 
                 counters_->registerWriteFinished();
             },
@@ -211,6 +241,7 @@ public:
             return;
 
         incrementOutstandingRequestCount();
+        auto const start = std::chrono::steady_clock::now();
 
         counters_->registerWriteStarted();
         // Note: lifetime is controlled by std::shared_from_this internally
@@ -218,14 +249,76 @@ public:
             ioc_,
             handle_,
             std::move(statements),
-            [this](auto const&) {
-                decrementOutstandingRequestCount();
+            [this, start](auto const&) {
+                decrementOutstandingRequestCount(start, &BATCH_WRITE_KIND);
                 counters_->registerWriteFinished();
             },
             [this]() { counters_->registerWriteRetry(); }
         );
     }
 
+    /**
+     * @brief Queue a write to be sent in an UNLOGGED batch together with other writes to the same partition.
+     *
+     * A batch is sent as soon as `writeBatchSize` writes are queued for the partition; the rest is sent by @ref flush.
+     * Batching writes that share a partition lets the coordinator apply them with a single mutation instead of one
+     * round trip per row. A `writeBatchSize` of 0 or 1 sends every write on its own.
+     *
+     * @param partition Identifies the table and partition key the statement writes to
+     * @param statement Statement to execute
+     */
+    void
+    writeToPartition(std::string const& partition, StatementType&& statement)
+    {
+        std::vector<StatementType> batch;
+        {
+            std::scoped_lock const lck(partitionsMutex_);
+            auto& queued = partitions_[partition];
+            queued.push_back(std::move(statement));
+            if (queued.size() < writeBatchSize_)
+                return;
+
+            batch = std::move(queued);
+            partitions_.erase(partition);
+        }
+
+        write(std::move(batch));
+    }
+
+    /**
+     * @brief Queue a write to be sent in an UNLOGGED batch together with other writes to the same partition.
+     *
+     * See @ref writeToPartition(std::string const&, StatementType&&) for how this works.
+     *
+     * @param partition Identifies the table and partition key the statement writes to
+     * @param preparedStatement Statement to prepare and execute
+     * @param args Args to bind to the prepared statement
+     */
+    template <typename... Args>
+    void
+    writeToPartition(std::string const& partition, PreparedStatementType const& preparedStatement, Args&&... args)
+    {
+        writeToPartition(partition, preparedStatement.bind(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Send all writes queued by @ref writeToPartition, one batch per partition.
+     *
+     * Must be called before @ref sync to make sure the queued writes are included.
+     */
+    void
+    flush()
+    {
+        decltype(partitions_) partitions;
+        {
+            std::scoped_lock const lck(partitionsMutex_);
+            partitions = std::exchange(partitions_, {});
+        }
+
+        for (auto& [_, statements] : partitions)
+            write(std::move(statements));
+    }
+
     /**
      * @brief Coroutine-based query execution used for reading data.
      *
@@ -241,7 +334,8 @@ public:
     [[maybe_unused]] ResultOrErrorType
     read(CompletionTokenType token, PreparedStatementType const& preparedStatement, Args&&... args)
     {
-        return read(token, preparedStatement.bind(std::forward<Args>(args)...));
+        // the prepared statement identifies the kind of read for hedging
+        return doRead(token, preparedStatement.bind(std::forward<Args>(args)...), &preparedStatement);
     }
 
     /**
@@ -261,10 +355,16 @@ public:
         std::optional<FutureWithCallbackType> future;
         counters_->registerReadStarted(numStatements);
 
+        util::trace::Span span{"cassandra.read"};
+        if (span.isRecording())
+            span.setAttribute("statements", std::to_string(numStatements));
+
+        auto const count = static_cast<std::uint32_t>(numStatements);
+        readLimiter_.acquire(token, count);
+        auto const start = std::chrono::steady_clock::now();
+
         // todo: perhaps use policy instead
         while (true) {
-            numReadRequestsOutstanding_ += numStatements;
-
             auto init = [this, &statements, &future]<typename Self>(Self& self) {
                 auto sself = std::make_shared<Self>(std::move(self));
 
@@ -279,9 +379,9 @@ public:
             auto res = boost::asio::async_compose<CompletionTokenType, void(ResultOrErrorType)>(
                 init, token, boost::asio::get_associated_executor(token)
             );
-            numReadRequestsOutstanding_ -= numStatements;
 
             if (res) {
+                readLimiter_.release(count, elapsedSince(start), true, &BATCH_READ_KIND);
                 counters_->registerReadFinished(numStatements);
                 return res;
             }
@@ -290,7 +390,9 @@ public:
             try {
                 throwErrorIfNeeded(res.error());
             } catch (...) {
+                readLimiter_.release(count, elapsedSince(start), false, &BATCH_READ_KIND);
                 counters_->registerReadError(numStatements);
+                span.setError();
                 throw;
             }
             counters_->registerReadRetry(numStatements);
@@ -310,42 +412,7 @@ public:
     [[maybe_unused]] ResultOrErrorType
     read(CompletionTokenType token, StatementType const& statement)
     {
-        std::optional<FutureWithCallbackType> future;
-        counters_->registerReadStarted();
-
-        // todo: perhaps use policy instead
-        while (true) {
-            ++numReadRequestsOutstanding_;
-            auto init = [this, &statement, &future]<typename Self>(Self& self) {
-                auto sself = std::make_shared<Self>(std::move(self));
-
-                future.emplace(handle_.get().asyncExecute(statement, [sself](auto&& res) mutable {
-                    boost::asio::post(
-                        boost::asio::get_associated_executor(*sself),
-                        [sself, res = std::forward<decltype(res)>(res)]() mutable { sself->complete(std::move(res)); }
-                    );
-                }));
-            };
-
-            auto res = boost::asio::async_compose<CompletionTokenType, void(ResultOrErrorType)>(
-                init, token, boost::asio::get_associated_executor(token)
-            );
-            --numReadRequestsOutstanding_;
-
-            if (res) {
-                counters_->registerReadFinished();
-                return res;
-            }
-
-            LOG(log_.error()) << "Failed read in coroutine: " << res.error();
-            try {
-                throwErrorIfNeeded(res.error());
-            } catch (...) {
-                counters_->registerReadError();
-                throw;
-            }
-            counters_->registerReadRetry();
-        }
+        return doRead(token, statement, nullptr);
     }
 
     /**
@@ -364,7 +431,15 @@ public:
     {
         std::atomic_uint64_t errorsCount = 0u;
         std::atomic_int numOutstanding = statements.size();
-        numReadRequestsOutstanding_ += statements.size();
+
+        auto const numStatements = static_cast<std::uint32_t>(statements.size());
+
+        util::trace::Span span{"cassandra.read"};
+        if (span.isRecording())
+            span.setAttribute("statements", std::to_string(numStatements));
+
+        readLimiter_.acquire(token, numStatements);
+        auto const start = std::chrono::steady_clock::now();
 
         auto futures = std::vector<FutureWithCallbackType>{};
         futures.reserve(numOutstanding);
@@ -397,12 +472,13 @@ public:
         boost::asio::async_compose<CompletionTokenType, void()>(
             init, token, boost::asio::get_associated_executor(token)
         );
-        numReadRequestsOutstanding_ -= statements.size();
+        readLimiter_.release(numStatements, elapsedSince(start), errorsCount == 0, &READ_EACH_KIND);
 
         if (errorsCount > 0) {
             assert(errorsCount <= statements.size());
             counters_->registerReadError(errorsCount);
             counters_->registerReadFinished(statements.size() - errorsCount);
+            span.setError();
             throw DatabaseTimeout{};
         }
         counters_->registerReadFinished(statements.size());
@@ -437,22 +513,117 @@ public:
     }
 
 private:
-    void
-    incrementOutstandingRequestCount()
+    ResultOrErrorType
+    doRead(CompletionTokenType token, StatementType const& statement, void const* kind)
     {
-        {
-            std::unique_lock<std::mutex> lck(throttleMutex_);
-            if (!canAddWriteRequest()) {
-                LOG(log_.trace()) << "Max outstanding requests reached. "
-                                  << "Waiting for other requests to finish";
-                throttleCv_.wait(lck, [this]() { return canAddWriteRequest(); });
+        counters_->registerReadStarted();
+        util::trace::Span span{"cassandra.read"};
+
+        readLimiter_.acquire(token);
+        auto const start = std::chrono::steady_clock::now();
+
+        // todo: perhaps use policy instead
+        while (true) {
+            auto res = readOnce(token, statement, kind);
+
+            if (res) {
+                readLimiter_.release(1, elapsedSince(start), true, kind);
+                counters_->registerReadFinished();
+                return res;
             }
+
+            LOG(log_.error()) << "Failed read in coroutine: " << res.error();
+            try {
+                throwErrorIfNeeded(res.error());
+            } catch (...) {
+                readLimiter_.release(1, elapsedSince(start), false, kind);
+                counters_->registerReadError();
+                span.setError();
+                throw;
+            }
+            counters_->registerReadRetry();
         }
+    }
+
+    /**
+     * @brief State shared by the attempts of one read: the first one and possibly a hedged one.
+     */
+    struct ReadAttempt {
+        std::mutex mtx;
+        std::atomic_bool done = false;
+        std::optional<boost::asio::steady_timer> timer;
+        std::optional<FutureWithCallbackType> first;
+        std::optional<FutureWithCallbackType> hedge;
+    };
+
+    ResultOrErrorType
+    readOnce(CompletionTokenType token, StatementType const& statement, void const* kind)
+    {
+        auto const hedgeDelay = hedging_.onRead(kind);
+        auto attempt = std::make_shared<ReadAttempt>();
+
+        // Both attempts stay alive until the driver calls them back, the first response is returned to the caller and
+        // the other one is dropped when it arrives.
+        auto init = [this, &statement, kind, hedgeDelay, attempt]<typename Self>(Self& self) {
+            auto sself = std::make_shared<Self>(std::move(self));
+            auto complete = [sself](ResultOrErrorType res) {
+                boost::asio::post(
+                    boost::asio::get_associated_executor(*sself),
+                    [sself, res = std::move(res)]() mutable { sself->complete(std::move(res)); }
+                );
+            };
+
+            auto const start = std::chrono::steady_clock::now();
+            auto onFirst = [this, kind, start, attempt, complete](auto&& res) {
+                if (res)
+                    hedging_.record(kind, elapsedSince(start));
+
+                if (not attempt->done.exchange(true))
+                    complete(std::forward<decltype(res)>(res));
+            };
+            attempt->first.emplace(handle_.get().asyncExecute(statement, std::move(onFirst)));
+
+            if (not hedgeDelay)
+                return;
+
+            attempt->timer.emplace(ioc_, *hedgeDelay);
+            attempt->timer->async_wait([this, &statement, attempt, complete](boost::system::error_code const& ec) {
+                // the statement is alive as long as the read is not done, which can't change while the lock is held
+                std::scoped_lock const lck(attempt->mtx);
+                if (ec or attempt->done or not hedging_.tryHedge())
+                    return;
+
+                auto onHedge = [this, attempt, complete](auto&& res) {
+                    if (not attempt->done.exchange(true)) {
+                        hedging_.onHedgeWon();
+                        complete(std::forward<decltype(res)>(res));
+                    }
+                };
+                attempt->hedge.emplace(handle_.get().asyncExecute(statement, std::move(onHedge)));
+            });
+        };
+
+        auto res = boost::asio::async_compose<CompletionTokenType, void(ResultOrErrorType)>(
+            init, token, boost::asio::get_associated_executor(token)
+        );
+
+        // a hedged read may still be in the process of being sent
+        std::scoped_lock const lck(attempt->mtx);
+        return res;
+    }
+
+    void
+    incrementOutstandingRequestCount()
+    {
+        // Writes come from the ETL threads through the synchronous write API of the backend rather than from
+        // coroutines. Blocking the calling thread is the backpressure: ETL stops extracting while the database is
+        // behind on writes.
+        writeLimiter_.acquire();
         ++numWriteRequestsOutstanding_;
     }
 
     void
-    decrementOutstandingRequestCount()
+    decrementOutstandingRequestCount(std::chrono::steady_clock::time_point start, void const* kind)
     {
         // sanity check
         if (numWriteRequestsOutstanding_ == 0) {
@@ -460,12 +631,9 @@ private:
             throw std::runtime_error("decrementing num outstanding below 0");
         }
         size_t const cur = (--numWriteRequestsOutstanding_);
-        {
-            // mutex lock required to prevent race condition around spurious
-            // wakeup
-            std::lock_guard const lck(throttleMutex_);
-            throttleCv_.notify_one();
-        }
+        // the executor retries until the write succeeds, so only its latency tells about congestion
+        writeLimiter_.release(1, elapsedSince(start), true, kind);
+
         if (cur == 0) {
             // mutex lock required to prevent race condition around spurious
             // wakeup
@@ -474,10 +642,10 @@ private:
         }
     }
 
-    bool
-    canAddWriteRequest() const
+    static std::chrono::microseconds
+    elapsedSince(std::chrono::steady_clock::time_point start)
     {
-        return numWriteRequestsOutstanding_ < maxWriteRequestsOutstanding_;
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
     }
 
     bool
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <data/cassandra/impl/HedgingPolicy.h>
+
+#include <algorithm>
+
+namespace data::cassandra::detail {
+
+using util::prometheus::Label;
+using util::prometheus::Labels;
+
+HedgingPolicy::HedgingPolicy(bool enabled, std::uint32_t percentile, std::uint32_t budgetPercent)
+    : enabled_{enabled}
+    , percentile_{std::clamp(static_cast<double>(percentile), 1.0, 100.0) / 100.0}
+    , budgetPerRead_{static_cast<double>(budgetPercent) / 100.0}
+    , hedgesSent_{PrometheusService::counterInt(
+          "backend_hedged_reads_total_number",
+          Labels({Label{"status", "sent"}}),
+          "Total number of hedged reads sent to the database"
+      )}
+    , hedgesWon_{PrometheusService::counterInt(
+          "backend_hedged_reads_total_number",
+          Labels({Label{"status", "won"}}),
+          "Total number of hedged reads that completed before the first attempt"
+      )}
+{
+}
+
+std::optional<std::chrono::microseconds>
+HedgingPolicy::onRead(void const* kind)
+{
+    if (not enabled_)
+        return std::nullopt;
+
+    std::scoped_lock const lck(mtx_);
+    budget_ = std::min(MAX_BUDGET, budget_ + budgetPerRead_);
+
+    if (auto const it = windows_.find(kind); it != windows_.end())
+        return it->second.percentile;
+
+    return std::nullopt;
+}
+
+void
+HedgingPolicy::record(void const* kind, std::chrono::microseconds latency)
+{
+    if (not enabled_)
+        return;
+
+    std::scoped_lock const lck(mtx_);
+    auto& window = windows_[kind];
+
+    if (window.samples.size() < WINDOW_SIZE) {
+        window.samples.push_back(latency.count());
+    } else {
+        window.samples[window.next] = latency.count();
+        window.next = (window.next + 1) % WINDOW_SIZE;
+    }
+
+    if (window.samples.size() < MIN_SAMPLES)
+        return;
+
+    if (window.percentile and ++window.sinceRecalculated < RECALCULATE_EVERY)
+        return;
+
+    window.sinceRecalculated = 0;
+
+    auto sorted = window.samples;
+    auto const idx = static_cast<std::size_t>(percentile_ * static_cast<double>(sorted.size() - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(idx), sorted.end());
+    window.percentile = std::chrono::microseconds{sorted[idx]};
+}
+
+bool
+HedgingPolicy::tryHedge()
+{
+    {
+        std::scoped_lock const lck(mtx_);
+        if (budget_ < 1.0)
+            return false;
+
+        budget_ -= 1.0;
+    }
+
+    ++hedgesSent_;
+    return true;
+}
+
+void
+HedgingPolicy::onHedgeWon()
+{
+    ++hedgesWon_;
+}
+
+}  // namespace data::cassandra::detail
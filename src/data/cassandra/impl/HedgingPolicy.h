@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#pragma once
+
+#include <util/prometheus/Prometheus.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace data::cassandra::detail {
+
+/**
+ * @brief Decides when a read should be hedged, i.e. sent a second time because the first attempt is slow.
+ *
+ * A read is hedged once it has been outstanding for longer than the configured percentile of the recent latencies of
+ * reads of the same kind (in practice, of the same prepared statement). Hedging is bounded by a budget: every read
+ * earns a fraction of a hedge and sending one spends a whole hedge, so at most `budgetPercent` of reads are hedged over
+ * time.
+ */
+class HedgingPolicy {
+public:
+    static constexpr std::size_t WINDOW_SIZE = 1024;
+    static constexpr std::size_t MIN_SAMPLES = 100;
+    static constexpr std::size_t RECALCULATE_EVERY = 64;
+    static constexpr double MAX_BUDGET = 10.0;
+
+private:
+    struct LatencyWindow {
+        std::vector<std::int64_t> samples;
+        std::size_t next = 0;
+        std::size_t sinceRecalculated = 0;
+        std::optional<std::chrono::microseconds> percentile;
+    };
+
+    bool enabled_;
+    double percentile_;
+    double budgetPerRead_;
+
+    std::mutex mtx_;
+    std::unordered_map<void const*, LatencyWindow> windows_;
+    double budget_ = 0.0;
+
+    util::prometheus::CounterInt& hedgesSent_;
+    util::prometheus::CounterInt& hedgesWon_;
+
+public:
+    /**
+     * @brief Create a new hedging policy.
+     *
+     * @param enabled Whether reads are hedged at all
+     * @param percentile The latency percentile after which a read is hedged, within [1, 100]
+     * @param budgetPercent The maximum percentage of reads that may be hedged
+     */
+    HedgingPolicy(bool enabled, std::uint32_t percentile, std::uint32_t budgetPercent);
+
+    /**
+     * @brief Account for a new read and get the time after which it should be hedged.
+     *
+     * @param kind Identifies reads with similar latency, e.g. the prepared statement used; may be nullptr
+     * @return The delay after which to send a hedged read; std::nullopt if the read should not be hedged
+     */
+    [[nodiscard]] std::optional<std::chrono::microseconds>
+    onRead(void const* kind);
+
+    /**
+     * @brief Record the latency of a successful first attempt.
+     *
+     * Only first attempts are recorded, so hedging doesn't skew the distribution it is based on.
+     *
+     * @param kind The kind of read, as passed to onRead
+     * @param latency The latency of the attempt
+     */
+    void
+    record(void const* kind, std::chrono::microseconds latency);
+
+    /**
+     * @brief Spend a hedge from the budget.
+     *
+     * @return true if a hedged read may be sent; false if the budget is exhausted
+     */
+    [[nodiscard]] bool
+    tryHedge();
+
+    /** @brief Account for a hedged read that completed before the first attempt. */
+    void
+    onHedgeWon();
+};
+
+}  // namespace data::cassandra::detail
@@ -19,6 +19,9 @@
 
 #include <data/cassandra/impl/Result.h>
 
+#include <stdexcept>
+#include <string>
+
 namespace {
 constexpr auto resultDeleter = [](CassResult const* ptr) { cass_result_free(ptr); };
 constexpr auto resultIteratorDeleter = [](CassIterator* ptr) { cass_iterator_free(ptr); };
@@ -42,6 +45,20 @@ Result::hasRows() const
     return numRows() > 0;
 }
 
+[[nodiscard]] std::optional<std::string>
+Result::pagingState() const
+{
+    if (cass_result_has_more_pages(*this) == cass_false)
+        return std::nullopt;
+
+    char const* token = nullptr;
+    std::size_t size = 0;
+    if (auto const rc = cass_result_paging_state_token(*this, &token, &size); rc != CASS_OK)
+        throw std::logic_error(std::string{"[Extract paging state]: "} + cass_error_desc(rc));
+
+    return std::string{token, size};
+}
+
 /* implicit */ ResultIterator::ResultIterator(CassIterator* ptr)
     : ManagedObject{ptr, resultIteratorDeleter}, hasMore_{cass_iterator_next(ptr) != 0u}
 {
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <data/cassandra/Types.h>
 #include <data/cassandra/impl/ManagedObject.h>
 #include <data/cassandra/impl/Tuple.h>
 #include <util/Expected.h>
@@ -29,6 +30,8 @@
 
 #include <compare>
 #include <iterator>
+#include <optional>
+#include <string>
 #include <tuple>
 
 namespace data::cassandra::detail {
@@ -72,6 +75,13 @@ extractColumn(CassRow const* row, std::size_t idx)
         auto const rc = cass_value_get_bytes(cass_row_get_column(row, idx), &buf, &bufSize);
         throwErrorIfNeeded(rc, "Extract vector<unsigned char>");
         output = UCharVectorType{buf, buf + bufSize};
+    } else if constexpr (std::is_same_v<DecayedType, BlobView>) {
+        // no copy, the bytes stay owned by the driver's result
+        cass_byte_t const* buf = nullptr;
+        std::size_t bufSize = 0;
+        auto const rc = cass_value_get_bytes(cass_row_get_column(row, idx), &buf, &bufSize);
+        throwErrorIfNeeded(rc, "Extract blob view");
+        output = BlobView{buf, bufSize};
     } else if constexpr (std::is_same_v<DecayedType, UintTupleType>) {
         auto const* tuple = cass_row_get_column(row, idx);
         output = TupleIterator::fromTuple(tuple).extract<uint32_t, uint32_t>();
@@ -101,6 +111,11 @@ extractColumn(CassRow const* row, std::size_t idx)
     return output;
 }
 
+/**
+ * @brief The rows returned by a query.
+ *
+ * Columns extracted as BlobView point into the result and must not outlive it.
+ */
 struct Result : public ManagedObject<CassResult const> {
     /* implicit */ Result(CassResult const* ptr);
 
@@ -110,6 +125,12 @@ struct Result : public ManagedObject<CassResult const> {
     [[nodiscard]] bool
     hasRows() const;
 
+    /**
+     * @return The state to fetch the next page with if the statement was paged and more pages remain; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<std::string>
+    pagingState() const;
+
     template <typename... RowTypes>
     std::optional<std::tuple<RowTypes...>>
     get() const
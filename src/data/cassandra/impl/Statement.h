@@ -33,6 +33,8 @@
 #include <chrono>
 #include <compare>
 #include <iterator>
+#include <optional>
+#include <string>
 
 namespace data::cassandra::detail {
 
@@ -64,6 +66,26 @@ public:
         cass_statement_set_is_idempotent(*this, cass_true);
     }
 
+    /**
+     * @brief Let the driver page through the results of the statement.
+     *
+     * @param pageSize The maximum number of rows per page
+     * @param pagingState The paging state of the previous page's result; nullopt for the first page
+     */
+    void
+    setPaging(std::uint32_t pageSize, std::optional<std::string> const& pagingState = std::nullopt) const
+    {
+        if (auto const rc = cass_statement_set_paging_size(*this, static_cast<int>(pageSize)); rc != CASS_OK)
+            throw std::logic_error(fmt::format("[Set paging size]: {}", cass_error_desc(rc)));
+
+        if (not pagingState)
+            return;
+
+        auto const rc = cass_statement_set_paging_state_token(*this, pagingState->data(), pagingState->size());
+        if (rc != CASS_OK)
+            throw std::logic_error(fmt::format("[Set paging state]: {}", cass_error_desc(rc)));
+    }
+
     /**
      * @brief Binds the given arguments to the statement.
      *
@@ -0,0 +1,346 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <data/embedded/WriteAheadLog.h>
+
+#include <boost/crc.hpp>
+#include <fmt/format.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace data::embedded {
+
+namespace {
+
+constexpr std::uint32_t FRAME_MAGIC = 0x324C5743;  // "CWL2"
+constexpr std::uint32_t COMMIT_FLAG = 1u;
+
+// magic, flags, size (64 bits), crc
+constexpr std::size_t FRAME_HEADER_SIZE = 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t) + sizeof(std::uint32_t);
+constexpr std::size_t COPY_BLOCK_SIZE = 1024 * 1024;
+
+struct FrameHeader {
+    std::uint32_t magic = 0;
+    std::uint32_t flags = 0;
+    std::uint64_t size = 0;
+    std::uint32_t crc = 0;
+};
+
+std::uint32_t
+checksum(std::string_view payload)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(payload.data(), payload.size());
+    return crc.checksum();
+}
+
+template <typename T>
+void
+put(char* out, T value)
+{
+    for (std::size_t i = 0; i < sizeof(value); ++i)
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+template <typename T>
+T
+get(char const* in)
+{
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(value); ++i)
+        value |= static_cast<T>(static_cast<unsigned char>(in[i])) << (8 * i);
+    return value;
+}
+
+std::array<char, FRAME_HEADER_SIZE>
+makeHeader(std::string_view payload, bool commit)
+{
+    std::array<char, FRAME_HEADER_SIZE> header{};
+    auto* out = header.data();
+    put(out, FRAME_MAGIC);
+    put(out + 4, commit ? COMMIT_FLAG : 0u);
+    put(out + 8, static_cast<std::uint64_t>(payload.size()));
+    put(out + 16, checksum(payload));
+    return header;
+}
+
+// Reads the next frame; returns false if there is no complete and valid frame at the current position
+bool
+readFrame(std::istream& in, std::uint64_t remaining, FrameHeader& header, std::string& payload)
+{
+    std::array<char, FRAME_HEADER_SIZE> raw{};
+    if (remaining < FRAME_HEADER_SIZE or not in.read(raw.data(), raw.size()))
+        return false;
+
+    header = FrameHeader{
+        get<std::uint32_t>(raw.data()),
+        get<std::uint32_t>(raw.data() + 4),
+        get<std::uint64_t>(raw.data() + 8),
+        get<std::uint32_t>(raw.data() + 16)};
+
+    if (header.magic != FRAME_MAGIC or header.size > remaining - FRAME_HEADER_SIZE)
+        return false;
+
+    payload.resize(header.size);
+    if (not in.read(payload.data(), static_cast<std::streamsize>(payload.size())))
+        return false;
+
+    return checksum(payload) == header.crc;
+}
+
+void
+writeAll(int fd, std::string_view data, std::string const& path)
+{
+    while (not data.empty()) {
+        auto const written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(fmt::format("Could not write to {}: {}", path, std::strerror(errno)));
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+    }
+}
+
+void
+writeFrame(int fd, std::string_view payload, bool commit, std::string const& path)
+{
+    auto const header = makeHeader(payload, commit);
+    writeAll(fd, std::string_view{header.data(), header.size()}, path);
+    writeAll(fd, payload, path);
+}
+
+void
+syncFile(int fd, std::string const& path)
+{
+    if (::fsync(fd) != 0)
+        throw std::runtime_error(fmt::format("Could not sync {}: {}", path, std::strerror(errno)));
+}
+
+}  // namespace
+
+WriteAheadLog::Rewrite::Rewrite(std::string path) : path_{std::move(path)}
+{
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+        throw std::runtime_error(fmt::format("Could not create {}: {}", path_, std::strerror(errno)));
+}
+
+WriteAheadLog::Rewrite::~Rewrite()
+{
+    if (fd_ < 0)
+        return;
+
+    ::close(fd_);
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+}
+
+void
+WriteAheadLog::Rewrite::append(std::string_view chunk, bool commit)
+{
+    writeFrame(fd_, chunk, commit, path_);
+    size_ += FRAME_HEADER_SIZE + chunk.size();
+}
+
+WriteAheadLog::WriteAheadLog(std::string path, bool readOnly, bool sync)
+    : path_{std::move(path)}, readOnly_{readOnly}, sync_{sync}
+{
+    if (not readOnly_) {
+        if (auto const dir = std::filesystem::path{path_}.parent_path(); not dir.empty())
+            std::filesystem::create_directories(dir);
+    }
+
+    open();
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    close();
+}
+
+std::size_t
+WriteAheadLog::replay(std::function<void(std::string_view)> const& onChunk)
+{
+    std::ifstream in{path_, std::ios::binary};
+    if (not in)
+        return 0;
+
+    std::size_t batches = 0;
+    std::uint64_t offset = 0;
+    std::uint64_t batchStart = 0;
+    FrameHeader header;
+    std::string payload;
+
+    while (readFrame(in, size_ - offset, header, payload)) {
+        auto const frameEnd = offset + FRAME_HEADER_SIZE + header.size;
+
+        if ((header.flags & COMMIT_FLAG) != 0) {
+            // the earlier chunks of a batch are only delivered once we know the batch is complete
+            if (batchStart != offset) {
+                std::string chunk;
+                in.seekg(static_cast<std::streamoff>(batchStart));
+                for (auto pos = batchStart; pos < offset; pos += FRAME_HEADER_SIZE + chunk.size()) {
+                    FrameHeader chunkHeader;
+                    if (not readFrame(in, offset - pos, chunkHeader, chunk))
+                        throw std::runtime_error(fmt::format("Could not re-read a batch of {}", path_));
+                    onChunk(chunk);
+                }
+                in.seekg(static_cast<std::streamoff>(frameEnd));
+            }
+
+            onChunk(payload);
+            batchStart = frameEnd;
+            ++batches;
+        }
+
+        offset = frameEnd;
+    }
+
+    if (batchStart != size_) {
+        LOG(log_.warn()) << "Dropping " << size_ - batchStart << " bytes of incomplete batch at the end of " << path_;
+
+        if (not readOnly_) {
+            if (::ftruncate(fd_, static_cast<off_t>(batchStart)) != 0)
+                throw std::runtime_error(fmt::format("Could not truncate {}: {}", path_, std::strerror(errno)));
+            size_ = batchStart;
+        }
+    }
+
+    committedSize_ = batchStart;
+    LOG(log_.info()) << "Replayed " << batches << " batches (" << batchStart << " bytes) from " << path_;
+    return batches;
+}
+
+void
+WriteAheadLog::append(std::string_view chunk, bool commit)
+{
+    if (readOnly_)
+        throw std::runtime_error(fmt::format("Can't append to {}: opened read only", path_));
+
+    try {
+        writeFrame(fd_, chunk, commit, path_);
+    } catch (std::runtime_error const&) {
+        // leave no partial frame behind so that the next append starts at a frame boundary
+        if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0)
+            LOG(log_.error()) << "Could not truncate " << path_ << " after a failed append";
+        throw;
+    }
+
+    size_ += FRAME_HEADER_SIZE + chunk.size();
+    if (not commit)
+        return;
+
+    if (sync_)
+        syncFile(fd_, path_);
+    committedSize_ = size_;
+}
+
+void
+WriteAheadLog::abort()
+{
+    if (readOnly_ or size_ == committedSize_)
+        return;
+
+    if (::ftruncate(fd_, static_cast<off_t>(committedSize_)) != 0)
+        throw std::runtime_error(fmt::format("Could not truncate {}: {}", path_, std::strerror(errno)));
+    size_ = committedSize_;
+}
+
+WriteAheadLog::Rewrite
+WriteAheadLog::startRewrite() const
+{
+    if (readOnly_)
+        throw std::runtime_error(fmt::format("Can't rewrite {}: opened read only", path_));
+
+    return Rewrite{path_ + ".tmp"};
+}
+
+void
+WriteAheadLog::finishRewrite(Rewrite& rewrite, std::uint64_t tailFrom)
+{
+    if (tailFrom > committedSize_ or tailFrom > size_)
+        throw std::runtime_error(fmt::format("Invalid tail offset {} for {}", tailFrom, path_));
+
+    auto const tailStart = rewrite.size_;
+    {
+        std::ifstream in{path_, std::ios::binary};
+        in.seekg(static_cast<std::streamoff>(tailFrom));
+
+        std::string block;
+        for (auto remaining = size_ - tailFrom; remaining > 0;) {
+            block.resize(std::min<std::uint64_t>(remaining, COPY_BLOCK_SIZE));
+            if (not in.read(block.data(), static_cast<std::streamsize>(block.size())))
+                throw std::runtime_error(fmt::format("Could not read the tail of {}", path_));
+
+            writeAll(rewrite.fd_, block, rewrite.path_);
+            remaining -= block.size();
+        }
+    }
+
+    syncFile(rewrite.fd_, rewrite.path_);
+    ::close(std::exchange(rewrite.fd_, -1));
+    std::filesystem::rename(rewrite.path_, path_);
+
+    auto const committedSize = tailStart + (committedSize_ - tailFrom);
+    close();
+    open();
+    committedSize_ = committedSize;
+}
+
+void
+WriteAheadLog::open()
+{
+    auto const flags = readOnly_ ? O_RDONLY : (O_WRONLY | O_CREAT | O_APPEND);
+    fd_ = ::open(path_.c_str(), flags, 0644);
+    if (fd_ < 0) {
+        if (readOnly_ and errno == ENOENT) {
+            LOG(log_.warn()) << "Log " << path_ << " does not exist yet; starting empty";
+            size_ = 0;
+            committedSize_ = 0;
+            return;
+        }
+        throw std::runtime_error(fmt::format("Could not open {}: {}", path_, std::strerror(errno)));
+    }
+
+    auto const end = ::lseek(fd_, 0, SEEK_END);
+    size_ = end < 0 ? 0 : static_cast<std::uint64_t>(end);
+    committedSize_ = size_;
+}
+
+void
+WriteAheadLog::close()
+{
+    if (fd_ >= 0)
+        ::close(fd_);
+    fd_ = -1;
+}
+
+}  // namespace data::embedded
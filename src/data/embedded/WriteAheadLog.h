@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/log/Logger.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace data::embedded {
+
+/**
+ * @brief An append-only log of checksummed batches backing the embedded backend.
+ *
+ * A batch is written as one or more frames, each holding a chunk of it: a magic number, flags, the 64-bit chunk size,
+ * a CRC32 of the chunk and the chunk itself. The last frame of a batch carries the commit flag. A batch either replays
+ * as a whole or not at all; frames after the last commit (e.g. after a crash in the middle of a batch) are dropped on
+ * open.
+ */
+class WriteAheadLog {
+    util::Logger log_{"Backend"};
+
+    std::string path_;
+    bool readOnly_;
+    bool sync_;
+    int fd_ = -1;
+    std::uint64_t size_ = 0;
+    std::uint64_t committedSize_ = 0;
+
+public:
+    /**
+     * @brief A new content for the log, written to a temporary file next to it.
+     *
+     * Used to compact the log without blocking appends: the rewrite is filled independently and the frames appended to
+     * the log in the meantime are copied over when it is installed with @ref WriteAheadLog::finishRewrite.
+     */
+    class Rewrite {
+        friend class WriteAheadLog;
+
+        std::string path_;
+        int fd_ = -1;
+        std::uint64_t size_ = 0;
+
+        explicit Rewrite(std::string path);
+
+    public:
+        /** @brief Removes the temporary file unless the rewrite was installed. */
+        ~Rewrite();
+
+        Rewrite(Rewrite const&) = delete;
+        Rewrite&
+        operator=(Rewrite const&) = delete;
+
+        /**
+         * @brief Append a chunk of a batch to the rewrite.
+         *
+         * @param chunk The chunk to append
+         * @param commit Whether this is the last chunk of the batch
+         * @throw std::runtime_error if the chunk could not be written
+         */
+        void
+        append(std::string_view chunk, bool commit);
+    };
+
+    /**
+     * @brief Open the log file, creating it and its directory if needed.
+     *
+     * @param path The path of the log file
+     * @param readOnly Whether the log should be opened for reading only
+     * @param sync Whether commits should be flushed to disk before returning
+     */
+    WriteAheadLog(std::string path, bool readOnly, bool sync);
+
+    ~WriteAheadLog();
+
+    WriteAheadLog(WriteAheadLog const&) = delete;
+    WriteAheadLog&
+    operator=(WriteAheadLog const&) = delete;
+
+    /**
+     * @brief Read all committed batches from the beginning of the log.
+     *
+     * Anything after the last commit is truncated away unless the log is read only.
+     *
+     * @param onChunk Called with every chunk of every committed batch, in order
+     * @return The number of batches replayed
+     */
+    std::size_t
+    replay(std::function<void(std::string_view)> const& onChunk);
+
+    /**
+     * @brief Append a chunk of a batch to the end of the log.
+     *
+     * @param chunk The chunk to append
+     * @param commit Whether this is the last chunk of the batch; the log is synced after it if requested
+     * @throw std::runtime_error if the chunk could not be written
+     */
+    void
+    append(std::string_view chunk, bool commit);
+
+    /**
+     * @brief Drop the chunks appended since the last commit.
+     */
+    void
+    abort();
+
+    /**
+     * @brief Start rewriting the log.
+     *
+     * @return The rewrite to fill with the new content
+     * @throw std::runtime_error if the temporary file could not be created
+     */
+    [[nodiscard]] Rewrite
+    startRewrite() const;
+
+    /**
+     * @brief Replace the log with the rewrite.
+     *
+     * Everything appended to the log from `tailFrom` on is copied to the rewrite first, which is then atomically
+     * renamed over the log. No append may run concurrently.
+     *
+     * @param rewrite The rewrite to install
+     * @param tailFrom The size of the log when the content of the rewrite was captured
+     * @throw std::runtime_error if the log could not be replaced; the log is left untouched
+     */
+    void
+    finishRewrite(Rewrite& rewrite, std::uint64_t tailFrom);
+
+    /**
+     * @return The size of the log file in bytes
+     */
+    [[nodiscard]] std::uint64_t
+    size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @return The size of the log up to the end of the last committed batch
+     */
+    [[nodiscard]] std::uint64_t
+    committedSize() const
+    {
+        return committedSize_;
+    }
+
+private:
+    void
+    open();
+
+    void
+    close();
+};
+
+}  // namespace data::embedded
@@ -23,18 +23,25 @@
 #include <etl/ProbingSource.h>
 #include <etl/Source.h>
 #include <rpc/RPCHelpers.h>
-#include <util/Profiler.h>
-#include <util/Random.h>
 #include <util/log/Logger.h>
 
 #include <ripple/beast/net/IPEndpoint.h>
 #include <ripple/protocol/STLedgerEntry.h>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/json.hpp>
 #include <boost/json/src.hpp>
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
 #include <thread>
 
 using namespace util;
@@ -84,6 +91,11 @@ LoadBalancer::LoadBalancer(
         downloadRanges_ = 4;
     }
 
+    hedging_ = config.valueOr("forwarding.hedging", false);
+    maxHedgeDelay_ = std::chrono::milliseconds{
+        config.valueOr<std::uint32_t>("forwarding.max_hedge_delay_ms", DEFAULT_MAX_HEDGE_DELAY_MS)
+    };
+
     auto const allowNoEtl = config.valueOr("allow_no_etl", false);
 
     auto const checkOnETLFailure = [this, allowNoEtl](std::string const& log) {
@@ -117,6 +129,10 @@ LoadBalancer::LoadBalancer(
         }
 
         sources_.push_back(std::move(source));
+        auto const name =
+            fmt::format("{}:{}", entry.valueOr<std::string>("ip", {}), entry.valueOr<std::string>("ws_port", {}));
+        sourceStats_.push_back(std::make_unique<detail::SourceStats>(name, "forward"));
+        fetchStats_.push_back(std::make_unique<detail::SourceStats>(name, "fetch"));
         LOG(log_.info()) << "Added etl source - " << sources_.back()->toString();
     }
 
@@ -170,7 +186,8 @@ LoadBalancer::fetchLedger(uint32_t ledgerSequence, bool getObjects, bool getObje
                             << ", source = " << source->toString();
             return false;
         },
-        ledgerSequence
+        ledgerSequence,
+        true
     );
     if (success) {
         return response;
@@ -185,23 +202,163 @@ LoadBalancer::forwardToRippled(
     boost::asio::yield_context yield
 ) const
 {
-    std::size_t sourceIdx = 0;
-    if (!sources_.empty())
-        sourceIdx = util::Random::uniform(0ul, sources_.size() - 1);
+    auto const order = orderSources(sourceStats_);
+    auto next = 0u;
 
-    auto numAttempts = 0u;
+    if (hedging_ && order.size() > 1 && isHedgeable(request)) {
+        if (auto const p95 = sourceStats_[order[0]]->p95(); p95) {
+            auto const delay = std::min(*p95, std::chrono::duration_cast<std::chrono::microseconds>(maxHedgeDelay_));
+            auto [res, hedged] = forwardHedged(order[0], order[1], delay, request, clientIp, yield);
+            if (res)
+                return res;
 
-    while (numAttempts < sources_.size()) {
-        if (auto res = sources_[sourceIdx]->forwardToRippled(request, clientIp, yield))
-            return res;
+            next = hedged ? 2u : 1u;
+        }
+    }
 
-        sourceIdx = (sourceIdx + 1) % sources_.size();
-        ++numAttempts;
+    for (; next < order.size(); ++next) {
+        if (auto res = forwardToSource(order[next], request, clientIp, yield))
+            return res;
     }
 
     return {};
 }
 
+std::vector<std::size_t>
+LoadBalancer::orderSources(std::vector<std::unique_ptr<detail::SourceStats>> const& stats)
+{
+    std::vector<double> scores;
+    scores.reserve(stats.size());
+    for (auto const& sourceStats : stats)
+        scores.push_back(sourceStats->score());
+
+    return detail::orderSources(scores);
+}
+
+std::optional<boost::json::object>
+LoadBalancer::forwardToSource(
+    std::size_t sourceIdx,
+    boost::json::object const& request,
+    std::optional<std::string> const& clientIp,
+    boost::asio::yield_context yield
+) const
+{
+    auto const start = std::chrono::steady_clock::now();
+    auto res = sources_[sourceIdx]->forwardToRippled(request, clientIp, yield);
+    sourceStats_[sourceIdx]->record(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start),
+        res.has_value()
+    );
+
+    return res;
+}
+
+std::pair<std::optional<boost::json::object>, bool>
+LoadBalancer::forwardHedged(
+    std::size_t primaryIdx,
+    std::size_t secondaryIdx,
+    std::chrono::microseconds delay,
+    boost::json::object const& request,
+    std::optional<std::string> const& clientIp,
+    boost::asio::yield_context yield
+) const
+{
+    // the request that loses the race keeps running after this function returns, so it must own everything it uses
+    struct HedgeState {
+        boost::json::object request;
+        std::optional<std::string> clientIp;
+
+        std::mutex mtx;
+        std::optional<boost::json::object> response;
+        std::size_t numOutstanding = 1;
+        bool hedged = false;
+        bool done = false;
+        std::function<void()> complete;
+
+        // only used on the strand
+        std::optional<boost::asio::steady_timer> hedgeTimer;
+    };
+
+    auto state = std::make_shared<HedgeState>();
+    state->request = request;
+    state->clientIp = clientIp;
+
+    auto const executor = yield.get_executor();
+    auto const strand = boost::asio::make_strand(executor);
+
+    auto const send = [this, state, executor, strand](std::size_t sourceIdx) {
+        boost::asio::spawn(executor, [this, state, strand, sourceIdx](boost::asio::yield_context innerYield) {
+            auto res = forwardToSource(sourceIdx, state->request, state->clientIp, innerYield);
+
+            std::function<void()> complete;
+            {
+                std::scoped_lock const lk(state->mtx);
+                --state->numOutstanding;
+
+                // the first success wins; otherwise wait for every request that was sent
+                if (not state->done and (res or state->numOutstanding == 0)) {
+                    state->done = true;
+                    state->response = std::move(res);
+                    complete = std::move(state->complete);
+                }
+            }
+
+            if (complete) {
+                // no need to hedge any more if the hedge has not been sent yet
+                boost::asio::post(strand, [state]() { state->hedgeTimer->cancel(); });
+                complete();
+            }
+        });
+    };
+
+    auto init = [this, state, send, strand, primaryIdx, secondaryIdx, delay]<typename Self>(Self& self) {
+        auto sself = std::make_shared<Self>(std::move(self));
+        state->complete = [sself]() {
+            boost::asio::post(boost::asio::get_associated_executor(*sself), [sself]() mutable { sself->complete(); });
+        };
+
+        state->hedgeTimer.emplace(strand, delay);
+        boost::asio::spawn(strand, [this, state, send, secondaryIdx](boost::asio::yield_context innerYield) {
+            boost::system::error_code ec;
+            state->hedgeTimer->async_wait(innerYield[ec]);
+            if (ec == boost::asio::error::operation_aborted)
+                return;
+
+            {
+                std::scoped_lock const lk(state->mtx);
+                if (state->done)
+                    return;
+
+                ++state->numOutstanding;
+                state->hedged = true;
+            }
+
+            sourceStats_[secondaryIdx]->onHedged();
+            send(secondaryIdx);
+        });
+
+        send(primaryIdx);
+    };
+
+    boost::asio::async_compose<boost::asio::yield_context, void()>(init, yield, executor);
+
+    std::scoped_lock const lk(state->mtx);
+    return {std::move(state->response), state->hedged};
+}
+
+bool
+LoadBalancer::isHedgeable(boost::json::object const& request)
+{
+    static constexpr std::array<std::string_view, 2> NON_HEDGEABLE{"submit", "submit_multisigned"};
+
+    auto const commandIt = request.contains("command") ? request.find("command") : request.find("method");
+    if (commandIt == request.end() or not commandIt->value().is_string())
+        return true;
+
+    auto const command = std::string_view{commandIt->value().as_string().c_str()};
+    return std::find(NON_HEDGEABLE.begin(), NON_HEDGEABLE.end(), command) == NON_HEDGEABLE.end();
+}
+
 bool
 LoadBalancer::shouldPropagateTxnStream(Source* in) const
 {
@@ -221,55 +378,60 @@ boost::json::value
 LoadBalancer::toJson() const
 {
     boost::json::array ret;
-    for (auto& src : sources_)
-        ret.push_back(src->toJson());
+    for (std::size_t i = 0; i < sources_.size(); ++i) {
+        auto json = sources_[i]->toJson();
+        json["latency_us"] = std::to_string(sourceStats_[i]->latency().count());
+        json["error_rate"] = std::to_string(sourceStats_[i]->errorRate());
+        json["fetch_latency_us"] = std::to_string(fetchStats_[i]->latency().count());
+        ret.push_back(std::move(json));
+    }
 
     return ret;
 }
 
 template <class Func>
 bool
-LoadBalancer::execute(Func f, uint32_t ledgerSequence)
+LoadBalancer::execute(Func f, uint32_t ledgerSequence, bool recordLatency)
 {
-    std::size_t sourceIdx = 0;
-    if (!sources_.empty())
-        sourceIdx = util::Random::uniform(0ul, sources_.size() - 1);
-
-    auto numAttempts = 0;
-
     while (true) {
-        auto& source = sources_[sourceIdx];
-
-        LOG(log_.debug()) << "Attempting to execute func. ledger sequence = " << ledgerSequence
-                          << " - source = " << source->toString();
-        // Originally, it was (source->hasLedger(ledgerSequence) || true)
-        /* Sometimes rippled has ledger but doesn't actually know. However,
-        but this does NOT happen in the normal case and is safe to remove
-        This || true is only needed when loading full history standalone */
-        if (source->hasLedger(ledgerSequence)) {
-            bool const res = f(source);
-            if (res) {
-                LOG(log_.debug()) << "Successfully executed func at source = " << source->toString()
-                                  << " - ledger sequence = " << ledgerSequence;
-                break;
+        for (auto const sourceIdx : orderSources(fetchStats_)) {
+            auto& source = sources_[sourceIdx];
+
+            LOG(log_.debug()) << "Attempting to execute func. ledger sequence = " << ledgerSequence
+                              << " - source = " << source->toString();
+            // Originally, it was (source->hasLedger(ledgerSequence) || true)
+            /* Sometimes rippled has ledger but doesn't actually know. However,
+            but this does NOT happen in the normal case and is safe to remove
+            This || true is only needed when loading full history standalone */
+            if (source->hasLedger(ledgerSequence)) {
+                auto const start = std::chrono::steady_clock::now();
+                bool const res = f(source);
+                if (recordLatency) {
+                    fetchStats_[sourceIdx]->record(
+                        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start),
+                        res
+                    );
+                }
+
+                if (res) {
+                    LOG(log_.debug()) << "Successfully executed func at source = " << source->toString()
+                                      << " - ledger sequence = " << ledgerSequence;
+                    return true;
+                }
+
+                LOG(log_.warn()) << "Failed to execute func at source = " << source->toString()
+                                 << " - ledger sequence = " << ledgerSequence;
+            } else {
+                LOG(log_.warn()) << "Ledger not present at source = " << source->toString()
+                                 << " - ledger sequence = " << ledgerSequence;
             }
-
-            LOG(log_.warn()) << "Failed to execute func at source = " << source->toString()
-                             << " - ledger sequence = " << ledgerSequence;
-        } else {
-            LOG(log_.warn()) << "Ledger not present at source = " << source->toString()
-                             << " - ledger sequence = " << ledgerSequence;
-        }
-        sourceIdx = (sourceIdx + 1) % sources_.size();
-        numAttempts++;
-        if (numAttempts % sources_.size() == 0) {
-            LOG(log_.info()) << "Ledger sequence " << ledgerSequence
-                             << " is not yet available from any configured sources. "
-                             << "Sleeping and trying again";
-            std::this_thread::sleep_for(std::chrono::seconds(2));
         }
+
+        LOG(log_.info()) << "Ledger sequence " << ledgerSequence
+                         << " is not yet available from any configured sources. "
+                         << "Sleeping and trying again";
+        std::this_thread::sleep_for(std::chrono::seconds(2));
     }
-    return true;
 }
 
 std::optional<ETLState>
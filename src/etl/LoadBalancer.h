@@ -22,6 +22,7 @@
 #include <data/BackendInterface.h>
 #include <etl/ETLHelpers.h>
 #include <etl/ETLState.h>
+#include <etl/impl/SourceStats.h>
 #include <feed/SubscriptionManager.h>
 #include <util/config/Config.h>
 #include <util/log/Logger.h>
@@ -30,6 +31,8 @@
 #include <boost/asio.hpp>
 #include <grpcpp/grpcpp.h>
 
+#include <chrono>
+
 namespace etl {
 class Source;
 class ProbingSource;
@@ -47,6 +50,10 @@ namespace etl {
  * This class spawns a listener for each etl source, which listens to messages on the ledgers stream (to keep track of
  * which ledgers have been validated by the network, and the range of ledgers each etl source has). This class also
  * allows requests for ledger data to be load balanced across all possible ETL sources.
+ *
+ * The latency and error rate of every source are tracked and each request goes to the better of two randomly picked
+ * sources. If hedging is enabled, a forwarded request that takes longer than the 95th percentile latency of its source
+ * is also sent to a second source and the first successful response wins.
  */
 class LoadBalancer {
 public:
@@ -56,9 +63,14 @@ public:
 
 private:
     static constexpr std::uint32_t DEFAULT_DOWNLOAD_RANGES = 16;
+    static constexpr std::uint32_t DEFAULT_MAX_HEDGE_DELAY_MS = 1000;
 
     util::Logger log_{"ETL"};
     std::vector<std::unique_ptr<Source>> sources_;
+    std::vector<std::unique_ptr<detail::SourceStats>> sourceStats_; /*< Forwarding statistics of each source */
+    std::vector<std::unique_ptr<detail::SourceStats>> fetchStats_;  /*< Ledger fetching statistics of each source */
+    bool hedging_ = false;
+    std::chrono::milliseconds maxHedgeDelay_{DEFAULT_MAX_HEDGE_DELAY_MS};
     std::optional<ETLState> etlState_;
     std::uint32_t downloadRanges_ =
         DEFAULT_DOWNLOAD_RANGES; /*< The number of markers to use when downloading intial ledger */
@@ -165,7 +177,7 @@ public:
     toJson() const;
 
     /**
-     * @brief Forward a JSON RPC request to a randomly selected rippled node.
+     * @brief Forward a JSON RPC request to a rippled node selected by latency and error rate.
      *
      * @param request JSON-RPC request to forward
      * @param clientIp The IP address of the peer, if known
@@ -188,19 +200,75 @@ public:
 
 private:
     /**
-     * @brief Execute a function on a randomly selected source.
+     * @brief Execute a function on the sources in the order given by their ledger fetching statistics.
      *
      * @note f is a function that takes an Source as an argument and returns a bool.
-     * Attempt to execute f for one randomly chosen Source that has the specified ledger. If f returns false, another
-     * randomly chosen Source is used. The process repeats until f returns true.
+     * Attempt to execute f for the first Source that has the specified ledger. If f returns false, the next Source is
+     * used. The process repeats until f returns true.
      *
      * @param f Function to execute. This function takes the ETL source as an argument, and returns a bool
      * @param ledgerSequence f is executed for each Source that has this ledger
+     * @param recordLatency Whether the duration of f counts towards the ledger fetching statistics of the source
      * @return true if f was eventually executed successfully. false if the ledger was found in the database or the
      * server is shutting down
      */
     template <class Func>
     bool
-    execute(Func f, uint32_t ledgerSequence);
+    execute(Func f, uint32_t ledgerSequence, bool recordLatency = false);
+
+    /**
+     * @param stats The statistics to order the sources by, one per source
+     * @return Indices of the sources in the order they should be tried
+     */
+    static std::vector<std::size_t>
+    orderSources(std::vector<std::unique_ptr<detail::SourceStats>> const& stats);
+
+    /**
+     * @brief Forward a request to one source and record the outcome.
+     *
+     * @param sourceIdx Index of the source to use
+     * @param request JSON-RPC request to forward
+     * @param clientIp The IP address of the peer, if known
+     * @param yield The coroutine context
+     * @return Response received from rippled node as JSON object on success; nullopt on failure
+     */
+    std::optional<boost::json::object>
+    forwardToSource(
+        std::size_t sourceIdx,
+        boost::json::object const& request,
+        std::optional<std::string> const& clientIp,
+        boost::asio::yield_context yield
+    ) const;
+
+    /**
+     * @brief Forward a request to the primary source, and to the secondary one too if the primary is slower than
+     * the given delay.
+     *
+     * @param primaryIdx Index of the source to send the request to first
+     * @param secondaryIdx Index of the source to send the hedged request to
+     * @param delay How long to wait for the primary source before sending the hedged request
+     * @param request JSON-RPC request to forward
+     * @param clientIp The IP address of the peer, if known
+     * @param yield The coroutine context
+     * @return The first successful response if any, and whether the hedged request was sent
+     */
+    std::pair<std::optional<boost::json::object>, bool>
+    forwardHedged(
+        std::size_t primaryIdx,
+        std::size_t secondaryIdx,
+        std::chrono::microseconds delay,
+        boost::json::object const& request,
+        std::optional<std::string> const& clientIp,
+        boost::asio::yield_context yield
+    ) const;
+
+    /**
+     * @brief Check whether a request can safely be sent to more than one source.
+     *
+     * @param request JSON-RPC request to check
+     * @return true if the request has no side effects; false otherwise
+     */
+    static bool
+    isHedgeable(boost::json::object const& request);
 };
 }  // namespace etl
@@ -23,7 +23,6 @@
 #include <etl/ProbingSource.h>
 #include <etl/Source.h>
 #include <rpc/RPCHelpers.h>
-#include <util/Profiler.h>
 
 #include <ripple/beast/net/IPEndpoint.h>
 #include <ripple/protocol/STLedgerEntry.h>
@@ -253,7 +253,7 @@ public:
         , backend_(std::move(backend))
         , subscriptions_(std::move(subscriptions))
         , balancer_(balancer)
-        , forwardCache_(config, ioc, *this)
+        , forwardCache_(config, *this)
         , strand_(boost::asio::make_strand(ioc))
         , timer_(strand_)
         , resolver_(strand_)
@@ -527,12 +527,7 @@ public:
         boost::asio::yield_context yield
     ) const override
     {
-        if (auto resp = forwardCache_.get(request); resp) {
-            LOG(log_.debug()) << "request hit forwardCache";
-            return resp;
-        }
-
-        return requestFromRippled(request, clientIp, yield);
+        return forwardCache_.getOrFetch(request, clientIp, yield);
     }
 
     void
@@ -684,7 +679,6 @@ public:
             } else {
                 if (balancer_.shouldPropagateTxnStream(this)) {
                     if (response.contains("transaction")) {
-                        forwardCache_.freshen();
                         subscriptions_->forwardProposedTransaction(response);
                     } else if (response.contains("type") && response.at("type") == "validationReceived") {
                         subscriptions_->forwardValidation(response);
@@ -697,6 +691,7 @@ public:
             if (ledgerIndex != 0) {
                 LOG(log_.trace()) << "Pushing ledger sequence = " << ledgerIndex << " - " << toString();
                 networkValidatedLedgers_->push(ledgerIndex);
+                forwardCache_.invalidate(ledgerIndex);
             }
 
             return true;
@@ -21,6 +21,7 @@
 
 #include <data/BackendInterface.h>
 #include <util/log/Logger.h>
+#include <util/prometheus/Prometheus.h>
 
 #include <ripple/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 #include <boost/algorithm/string.hpp>
@@ -44,8 +45,10 @@ class CacheLoader {
     static constexpr size_t DEFAULT_NUM_CACHE_DIFFS = 32;
     static constexpr size_t DEFAULT_NUM_CACHE_MARKERS = 48;
     static constexpr size_t DEFAULT_CACHE_PAGE_FETCH_SIZE = 512;
+    static constexpr size_t DEFAULT_NUM_SCAN_RANGES = 256;
+    static constexpr size_t DEFAULT_SCAN_PAGE_SIZE = 4096;
 
-    enum class LoadStyle { ASYNC, SYNC, NOT_AT_ALL };
+    enum class LoadStyle { ASYNC, SYNC, NOT_AT_ALL, BOUNDED };
 
     util::Logger log_{"ETL"};
 
@@ -63,6 +66,26 @@ class CacheLoader {
     // number of ledger objects to fetch concurrently per marker during cache download
     size_t cachePageFetchSize_ = DEFAULT_CACHE_PAGE_FETCH_SIZE;
 
+    // read the objects in bulk by ranges of the key space instead of walking the successor chain from the cursors
+    bool bulkScan_ = false;
+
+    // number of ranges to split the key space into for the bulk scan; at most numCacheMarkers_ are read at a time
+    size_t numScanRanges_ = DEFAULT_NUM_SCAN_RANGES;
+
+    // number of ledger objects to read per page of the bulk scan
+    size_t scanPageSize_ = DEFAULT_SCAN_PAGE_SIZE;
+
+    std::reference_wrapper<util::prometheus::CounterInt> loadedObjects_{PrometheusService::counterInt(
+        "cache_load_objects_total_number",
+        util::prometheus::Labels(),
+        "Total number of ledger objects read by the bulk scan of the cache loader"
+    )};
+    std::reference_wrapper<util::prometheus::GaugeInt> remainingRanges_{PrometheusService::gaugeInt(
+        "cache_load_remaining_ranges_current_number",
+        util::prometheus::Labels(),
+        "Number of ranges the bulk scan of the cache loader has yet to finish"
+    )};
+
     struct ClioPeer {
         std::string ip;
         int port{};
@@ -96,6 +119,20 @@ public:
             numCacheDiffs_ = cache.valueOr<size_t>("num_diffs", numCacheDiffs_);
             numCacheMarkers_ = cache.valueOr<size_t>("num_markers", numCacheMarkers_);
             cachePageFetchSize_ = cache.valueOr<size_t>("page_fetch_size", cachePageFetchSize_);
+            bulkScan_ = cache.valueOr("bulk_scan", bulkScan_);
+            numScanRanges_ = std::max<size_t>(1, cache.valueOr<size_t>("num_scan_ranges", numScanRanges_));
+            scanPageSize_ = cache.valueOr<size_t>("scan_page_size", scanPageSize_);
+
+            if (auto const maxMemory = cache.maybeValue<size_t>("max_memory_mb"); maxMemory) {
+                cache_.get().setBounded(*maxMemory * 1024 * 1024);
+                cacheLoadStyle_ = LoadStyle::BOUNDED;
+            }
+
+            if (cache.valueOr("compression", false)) {
+                cache_.get().setCompression(
+                    cache.valueOr<int>("compression_level", data::CacheCompressor::DEFAULT_LEVEL)
+                );
+            }
 
             if (auto peers = cache.maybeArray("peers"); peers) {
                 for (auto const& peer : *peers) {
@@ -123,7 +160,8 @@ public:
      * @brief Populates the cache by walking through the given ledger.
      *
      * Should only be called once. The default behavior is to return immediately and populate the cache in the
-     * background. This can be overridden via config parameter, to populate synchronously, or not at all.
+     * background. This can be overridden via config parameter, to populate synchronously, or not at all. A bounded
+     * cache is never loaded; it is populated as objects are fetched from the database.
      */
     void
     load(uint32_t seq)
@@ -134,6 +172,11 @@ public:
             return;
         }
 
+        if (cacheLoadStyle_ == LoadStyle::BOUNDED) {
+            LOG(log_.info()) << "Cache is bounded. Populating on demand";
+            return;
+        }
+
         if (cache_.get().isFull()) {
             assert(false);
             return;
@@ -148,12 +191,20 @@ public:
                 }
 
                 // if we couldn't successfully load from any peers, load from db
-                loadCacheFromDb(seq);
+                if (bulkScan_) {
+                    loadCacheByScan(seq);
+                } else {
+                    loadCacheFromDb(seq);
+                }
             });
             return;
         }
 
-        loadCacheFromDb(seq);
+        if (bulkScan_) {
+            loadCacheByScan(seq);
+        } else {
+            loadCacheFromDb(seq);
+        }
 
         // If loading synchronously, poll cache until full
         static constexpr size_t SLEEP_TIME_SECONDS = 10;
@@ -317,6 +368,64 @@ private:
         }
     }
 
+    void
+    loadCacheByScan(uint32_t seq)
+    {
+        auto ranges = data::ScanRange::split(numScanRanges_);
+        remainingRanges_.get().set(static_cast<std::int64_t>(ranges.size()));
+
+        LOG(log_.info()) << "Loading cache by scan. num ranges = " << ranges.size();
+
+        thread_ = std::thread{[this, seq, ranges = std::move(ranges)]() {
+            auto const startTime = std::chrono::steady_clock::now();
+            auto markers = std::make_shared<std::atomic_int>(0);
+            auto numRemaining = std::make_shared<std::atomic_int>(ranges.size());
+            auto numObjects = std::make_shared<std::atomic_uint64_t>(0);
+
+            for (auto const& range : ranges) {
+                markers->wait(numCacheMarkers_);
+                ++(*markers);
+
+                boost::asio::spawn(
+                    ioContext_.get(),
+                    [this, seq, range, numRemaining, numObjects, startTime, markers](boost::asio::yield_context yield) {
+                        std::optional<std::string> cursor;
+                        do {
+                            auto page = data::retryOnTimeout([this, seq, &range, &cursor, yield]() {
+                                return backend_->fetchLedgerScanPage(range, cursor, seq, scanPageSize_, yield);
+                            });
+
+                            cache_.get().update(page.objects, seq, true);
+                            *numObjects += page.objects.size();
+                            loadedObjects_.get() += page.objects.size();
+                            cursor = std::move(page.cursor);
+                        } while (cursor and not stopping_);
+
+                        --(*markers);
+                        markers->notify_one();
+                        --remainingRanges_.get();
+
+                        if (--(*numRemaining) == 0) {
+                            auto const duration = std::chrono::duration_cast<std::chrono::seconds>(
+                                std::chrono::steady_clock::now() - startTime
+                            );
+
+                            LOG(log_.info()) << "Finished loading cache by scan. cache size = " << cache_.get().size()
+                                             << ". Read " << *numObjects << " objects in " << duration.count()
+                                             << " seconds (" << *numObjects / std::max<int64_t>(duration.count(), 1)
+                                             << " objects per second)";
+                            if (not stopping_)
+                                cache_.get().setFull();
+                        } else {
+                            LOG(log_.debug()) << "Finished a scan range. num remaining = " << *numRemaining
+                                              << " objects read = " << *numObjects;
+                        }
+                    }
+                );
+            }
+        }};
+    }
+
     void
     loadCacheFromDb(uint32_t seq)
     {
@@ -20,8 +20,8 @@
 #pragma once
 
 #include <etl/SystemState.h>
-#include <util/Profiler.h>
 #include <util/log/Logger.h>
+#include <util/profiling/Profiling.h>
 
 #include <ripple/beast/core/CurrentThreadName.h>
 
@@ -91,9 +91,11 @@ private:
 
         while (!shouldFinish(currentSequence) && networkValidatedLedgers_->waitUntilValidatedByNetwork(currentSequence)
         ) {
-            auto [fetchResponse, time] = ::util::timed<std::chrono::duration<double>>([this, currentSequence]() {
-                return ledgerFetcher_.get().fetchDataAndDiff(currentSequence);
-            });
+            static ::util::profiling::Zone const extractZone{"etl.extract"};
+            auto [fetchResponse, time] =
+                ::util::profiling::timed<std::chrono::duration<double>>(extractZone, [this, currentSequence]() {
+                    return ledgerFetcher_.get().fetchDataAndDiff(currentSequence);
+                });
             totalTime += time;
 
             // if the fetch is unsuccessful, stop. fetchLedger only returns false if the server is shutting down, or
@@ -22,46 +22,128 @@
 #include <rpc/RPCHelpers.h>
 
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/json.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+
 namespace etl::detail {
 
-void
-ForwardCache::freshen()
+namespace {
+
+boost::json::value
+canonical(boost::json::value const& value)
 {
-    LOG(log_.trace()) << "Freshening ForwardCache";
+    if (value.is_array()) {
+        boost::json::array result;
+        for (auto const& item : value.as_array())
+            result.push_back(canonical(item));
+        return result;
+    }
 
-    auto numOutstanding = std::make_shared<std::atomic_uint>(latestForwarded_.size());
+    if (!value.is_object())
+        return value;
 
-    for (auto const& cacheEntry : latestForwarded_) {
-        boost::asio::spawn(
-            strand_,
-            [this, numOutstanding, command = cacheEntry.first](boost::asio::yield_context yield) {
-                boost::json::object const request = {{"command", command}};
-                auto resp = source_.requestFromRippled(request, std::nullopt, yield);
+    std::vector<std::pair<std::string_view, boost::json::value const*>> sorted;
+    for (auto const& [key, item] : value.as_object())
+        sorted.emplace_back(key, &item);
+    std::sort(sorted.begin(), sorted.end(), [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
 
-                if (!resp || resp->contains("error"))
-                    resp = {};
+    boost::json::object result;
+    for (auto const& [key, item] : sorted)
+        result[key] = canonical(*item);
+    return result;
+}
 
-                {
-                    std::scoped_lock const lk(mtx_);
-                    latestForwarded_[command] = resp;
-                }
-            }
-        );
+// the response to share with other requests, without the id rippled echoed back for this one
+std::optional<boost::json::object>
+withoutId(std::optional<boost::json::object> response)
+{
+    if (response)
+        response->erase("id");
+    return response;
+}
+
+// the shared response as the answer to a request, with the id of that request
+std::optional<boost::json::object>
+withIdOf(boost::json::object const& request, std::optional<boost::json::object> response)
+{
+    if (response && request.contains("id"))
+        response->insert_or_assign("id", request.at("id"));
+    return response;
+}
+
+util::prometheus::Labels
+makeLabels(util::Config const& config, std::string const& result)
+{
+    auto const source = config.valueOr<std::string>("ip", {}) + ":" + config.valueOr<std::string>("ws_port", {});
+    return util::prometheus::Labels({{"source", source}, {"result", result}});
+}
+
+}  // namespace
+
+ForwardCache::ForwardCache(util::Config const& config, Source const& source)
+    : source_(source)
+    , hitCounter_(PrometheusService::counterInt(
+          "forward_cache_total_number",
+          makeLabels(config, "hit"),
+          "Total number of forwarded requests checked against the forward cache"
+      ))
+    , missCounter_(PrometheusService::counterInt(
+          "forward_cache_total_number",
+          makeLabels(config, "miss"),
+          "Total number of forwarded requests checked against the forward cache"
+      ))
+    , coalescedCounter_(PrometheusService::counterInt(
+          "forward_cache_total_number",
+          makeLabels(config, "coalesced"),
+          "Total number of forwarded requests checked against the forward cache"
+      ))
+    , waitTimeoutCounter_(PrometheusService::counterInt(
+          "forward_cache_total_number",
+          makeLabels(config, "wait_timeout"),
+          "Total number of forwarded requests checked against the forward cache"
+      ))
+{
+    if (config.contains("cache")) {
+        auto commands = config.arrayOrThrow("cache", "Source cache must be array");
+
+        if (config.contains("cache_duration")) {
+            duration_ = std::chrono::seconds{
+                config.valueOrThrow<uint32_t>("cache_duration", "Source cache_duration must be a number")
+            };
+        }
+
+        if (config.contains("cache_wait_timeout_ms")) {
+            waitTimeout_ = std::chrono::milliseconds{config.valueOrThrow<uint32_t>(
+                "cache_wait_timeout_ms", "Source cache_wait_timeout_ms must be a number"
+            )};
+        }
+
+        for (auto const& command : commands)
+            commands_.insert(command.valueOrThrow<std::string>("Source forward command must be array of strings"));
     }
 }
 
 void
-ForwardCache::clear()
+ForwardCache::invalidate(std::uint32_t ledgerSequence)
 {
-    std::scoped_lock const lk(mtx_);
-    for (auto& cacheEntry : latestForwarded_)
-        latestForwarded_[cacheEntry.first] = {};
+    auto latest = latestLedger_.load();
+    while (ledgerSequence > latest) {
+        if (latestLedger_.compare_exchange_weak(latest, ledgerSequence)) {
+            LOG(log_.trace()) << "Invalidating ForwardCache for ledger " << ledgerSequence;
+
+            std::scoped_lock const lk(mtx_);
+            latestForwarded_.clear();
+            return;
+        }
+    }
 }
 
-std::optional<boost::json::object>
-ForwardCache::get(boost::json::object const& request) const
+std::optional<std::string>
+ForwardCache::makeKey(boost::json::object const& request) const
 {
     std::optional<std::string> command = {};
     if (request.contains("command") && !request.contains("method") && request.at("command").is_string()) {
@@ -70,16 +152,151 @@ ForwardCache::get(boost::json::object const& request) const
         command = request.at("method").as_string().c_str();
     }
 
-    if (!command)
+    if (!command || !commands_.contains(*command))
         return {};
     if (rpc::specifiesCurrentOrClosedLedger(request))
         return {};
 
+    // the id is echoed back by rippled but does not change the result
+    auto keyed = request;
+    keyed.erase("id");
+    return boost::json::serialize(canonical(keyed));
+}
+
+std::optional<boost::json::object>
+ForwardCache::lookup(std::string const& key) const
+{
     std::shared_lock const lk(mtx_);
-    if (!latestForwarded_.contains(*command))
+    if (auto const it = latestForwarded_.find(key);
+        it != latestForwarded_.end() && it->second.expiry > std::chrono::steady_clock::now())
+        return it->second.response;
+
+    return {};
+}
+
+void
+ForwardCache::store(std::string const& key, boost::json::object const& response, std::uint32_t ledgerSequence) const
+{
+    std::scoped_lock const lk(mtx_);
+
+    // a newer ledger was validated while the request was in flight; the response may already be outdated
+    if (latestLedger_ != ledgerSequence)
+        return;
+
+    latestForwarded_[key] = {response, std::chrono::steady_clock::now() + duration_};
+}
+
+std::optional<boost::json::object>
+ForwardCache::get(boost::json::object const& request) const
+{
+    auto const key = makeKey(request);
+    if (!key)
         return {};
 
-    return {latestForwarded_.at(*command)};
+    return withIdOf(request, lookup(*key));
+}
+
+ForwardCache::ResponseType
+ForwardCache::waitFor(std::shared_ptr<Inflight> const& inflight, boost::asio::yield_context yield) const
+{
+    return boost::asio::async_compose<boost::asio::yield_context, void(ResponseType)>(
+        [this, inflight]<typename Self>(Self& self) {
+            auto sself = std::make_shared<Self>(std::move(self));
+            auto const executor = boost::asio::get_associated_executor(*sself);
+            auto timer = std::make_shared<boost::asio::steady_timer>(executor, waitTimeout_);
+            auto completed = std::make_shared<std::atomic_bool>(false);
+
+            // called once by whichever comes first, the response or the timeout
+            auto complete = [sself, executor, timer, completed](ResponseType response) {
+                if (completed->exchange(true))
+                    return;
+
+                boost::asio::post(executor, [sself, timer, response = std::move(response)]() mutable {
+                    timer->cancel();
+                    sself->complete(std::move(response));
+                });
+            };
+
+            timer->async_wait([this, complete](boost::system::error_code const& ec) {
+                if (ec == boost::asio::error::operation_aborted)
+                    return;
+
+                LOG(log_.warn()) << "Coalesced request timed out waiting for the response of an identical one";
+                ++waitTimeoutCounter_.get();
+                complete(std::nullopt);
+            });
+
+            std::unique_lock lk(inflightMtx_);
+            if (!inflight->done) {
+                inflight->waiters.push_back(std::move(complete));
+                return;
+            }
+
+            auto response = inflight->response;
+            lk.unlock();
+            complete(std::move(response));
+        },
+        yield,
+        yield.get_executor()
+    );
+}
+
+std::optional<boost::json::object>
+ForwardCache::getOrFetch(
+    boost::json::object const& request,
+    std::optional<std::string> const& clientIp,
+    boost::asio::yield_context yield
+) const
+{
+    auto const key = makeKey(request);
+    if (!key)
+        return source_.requestFromRippled(request, clientIp, yield);
+
+    if (auto resp = lookup(*key); resp) {
+        LOG(log_.debug()) << "request hit forwardCache";
+        ++hitCounter_.get();
+        return withIdOf(request, std::move(resp));
+    }
+
+    std::shared_ptr<Inflight> inflight;
+    bool isLeader = false;
+    {
+        std::scoped_lock const lk(inflightMtx_);
+        auto [it, inserted] = inflight_.try_emplace(*key);
+        if (inserted)
+            it->second = std::make_shared<Inflight>();
+
+        inflight = it->second;
+        isLeader = inserted;
+    }
+
+    if (!isLeader) {
+        LOG(log_.debug()) << "request coalesced with an identical one in flight";
+        ++coalescedCounter_.get();
+        return withIdOf(request, waitFor(inflight, yield));
+    }
+
+    ++missCounter_.get();
+
+    auto const ledgerSequence = latestLedger_.load();
+    auto const resp = withoutId(source_.requestFromRippled(request, clientIp, yield));
+
+    if (resp && !resp->contains("error"))
+        store(*key, *resp, ledgerSequence);
+
+    std::vector<std::function<void(ResponseType)>> waiters;
+    {
+        std::scoped_lock const lk(inflightMtx_);
+        inflight->done = true;
+        inflight->response = resp;
+        waiters = std::move(inflight->waiters);
+        inflight_.erase(*key);
+    }
+
+    for (auto& waiter : waiters)
+        waiter(resp);
+
+    return withIdOf(request, resp);
 }
 
 }  // namespace etl::detail
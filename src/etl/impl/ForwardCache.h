@@ -16,20 +16,28 @@
     OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 //==============================================================================
-
 #pragma once
 
 #include <data/BackendInterface.h>
 #include <etl/ETLHelpers.h>
 #include <util/config/Config.h>
 #include <util/log/Logger.h>
+#include <util/prometheus/Prometheus.h>
 
 #include <boost/asio.hpp>
+#include <boost/asio/spawn.hpp>
 #include <boost/json.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace etl {
 class Source;
@@ -39,44 +47,108 @@ namespace etl::detail {
 
 /**
  * @brief Cache for rippled responses
+ *
+ * Only the commands listed in the `cache` section of the source config are cached. Responses are keyed on the
+ * canonical form of the whole request, so the same command with different params gets its own entry. All entries are
+ * dropped when a new validated ledger is observed, and in any case after `cache_duration` seconds.
+ *
+ * Concurrent identical requests that miss the cache are coalesced into a single request to rippled. They wait for its
+ * response for at most `cache_wait_timeout_ms` milliseconds and fail to forward after that.
+ *
+ * The `id` of requests is not part of the key and is never cached or shared; every response carries the `id` of its own
+ * request.
  */
 class ForwardCache {
     using ResponseType = std::optional<boost::json::object>;
     static constexpr std::uint32_t DEFAULT_DURATION = 10;
+    static constexpr std::uint32_t DEFAULT_WAIT_TIMEOUT_MS = 5000;
+
+    struct Entry {
+        boost::json::object response;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    struct Inflight {
+        bool done = false;
+        ResponseType response;
+        std::vector<std::function<void(ResponseType)>> waiters;
+    };
 
     util::Logger log_{"ETL"};
 
     mutable std::shared_mutex mtx_;
-    std::unordered_map<std::string, ResponseType> latestForwarded_;
-    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    mutable std::unordered_map<std::string, Entry> latestForwarded_;
+    std::atomic_uint32_t latestLedger_ = 0;
+
+    mutable std::mutex inflightMtx_;
+    mutable std::unordered_map<std::string, std::shared_ptr<Inflight>> inflight_;
+
+    std::unordered_set<std::string> commands_;
     etl::Source const& source_;
-    std::uint32_t duration_ = DEFAULT_DURATION;
+    std::chrono::seconds duration_{DEFAULT_DURATION};
+    std::chrono::milliseconds waitTimeout_{DEFAULT_WAIT_TIMEOUT_MS};
 
-    void
-    clear();
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> missCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> coalescedCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> waitTimeoutCounter_;
 
 public:
-    ForwardCache(util::Config const& config, boost::asio::io_context& ioc, Source const& source)
-        : strand_(boost::asio::make_strand(ioc)), source_(source)
-    {
-        if (config.contains("cache")) {
-            auto commands = config.arrayOrThrow("cache", "Source cache must be array");
-
-            if (config.contains("cache_duration"))
-                duration_ = config.valueOrThrow<uint32_t>("cache_duration", "Source cache_duration must be a number");
-
-            for (auto const& command : commands) {
-                auto key = command.valueOrThrow<std::string>("Source forward command must be array of strings");
-                latestForwarded_[key] = {};
-            }
-        }
-    }
-
+    /**
+     * @brief Create a forward cache for a source.
+     *
+     * @param config The config of the source
+     * @param source The source to forward requests to on a miss
+     */
+    ForwardCache(util::Config const& config, Source const& source);
+
+    /**
+     * @brief Drop all cached responses if the ledger is newer than the latest one seen.
+     *
+     * @param ledgerSequence Sequence of a newly validated ledger
+     */
     void
-    freshen();
-
+    invalidate(std::uint32_t ledgerSequence);
+
+    /**
+     * @brief Get the cached response for a request.
+     *
+     * @param request The request
+     * @return The cached response if any; nullopt otherwise
+     */
     std::optional<boost::json::object>
     get(boost::json::object const& request) const;
+
+    /**
+     * @brief Get the cached response for a request, or forward it to rippled and cache the response.
+     *
+     * Requests that can't be cached are always forwarded. If an identical request is already being forwarded, this
+     * waits for its response instead of sending another one.
+     *
+     * @param request The request
+     * @param clientIp IP of the client forwarding this request if known
+     * @param yield The coroutine context
+     * @return Response wrapped in an optional on success; nullopt otherwise
+     */
+    std::optional<boost::json::object>
+    getOrFetch(
+        boost::json::object const& request,
+        std::optional<std::string> const& clientIp,
+        boost::asio::yield_context yield
+    ) const;
+
+private:
+    std::optional<std::string>
+    makeKey(boost::json::object const& request) const;
+
+    std::optional<boost::json::object>
+    lookup(std::string const& key) const;
+
+    ResponseType
+    waitFor(std::shared_ptr<Inflight> const& inflight, boost::asio::yield_context yield) const;
+
+    void
+    store(std::string const& key, boost::json::object const& response, std::uint32_t ledgerSequence) const;
 };
 
 }  // namespace etl::detail
@@ -24,8 +24,8 @@
 #include <etl/SystemState.h>
 #include <etl/impl/LedgerFetcher.h>
 #include <util/LedgerUtils.h>
-#include <util/Profiler.h>
 #include <util/log/Logger.h>
+#include <util/profiling/Profiling.h>
 
 #include <ripple/beast/core/CurrentThreadName.h>
 
@@ -167,7 +167,10 @@ public:
 
         LOG(log_.debug()) << "Deserialized ledger header. " << ::util::toString(lgrInfo);
 
-        auto timeDiff = ::util::timed<std::chrono::duration<double>>([this, sequence, &lgrInfo, &ledgerData]() {
+        static ::util::profiling::Zone const initialLedgerZone{"etl.load_initial_ledger"};
+        static ::util::profiling::Zone const successorsZone{"etl.load_initial_ledger.successors"};
+
+        auto timeDiff = ::util::profiling::timed<std::chrono::duration<double>>(initialLedgerZone, [&]() {
             backend_->startWrites();
 
             LOG(log_.debug()) << "Started writes";
@@ -189,8 +192,9 @@ public:
                 size_t numWrites = 0;
                 backend_->cache().setFull();
 
-                auto seconds =
-                    ::util::timed<std::chrono::seconds>([this, edgeKeys = &edgeKeys, sequence, &numWrites]() {
+                auto seconds = ::util::profiling::timed<std::chrono::seconds>(
+                    successorsZone,
+                    [this, edgeKeys = &edgeKeys, sequence, &numWrites]() {
                         for (auto& key : *edgeKeys) {
                             LOG(log_.debug()) << "Writing edge key = " << ripple::strHex(key);
                             auto succ =
@@ -232,7 +236,8 @@ public:
 
                         backend_->writeSuccessor(uint256ToString(prev), sequence, uint256ToString(data::lastKey));
                         ++numWrites;
-                    });
+                    }
+                );
 
                 LOG(log_.info()) << "Looping through cache and submitting all writes took " << seconds
                                  << " seconds. numWrites = " << std::to_string(numWrites);
@@ -20,12 +20,15 @@
 #pragma once
 
 #include <data/BackendInterface.h>
+#include <etl/NFTHelpers.h>
 #include <etl/SystemState.h>
 #include <feed/SubscriptionManager.h>
 #include <util/LedgerUtils.h>
 #include <util/log/Logger.h>
 
 #include <ripple/protocol/LedgerHeader.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/TxMeta.h>
 
 #include <chrono>
 #include <utility>
@@ -147,6 +150,23 @@ public:
                 backend_->updateRange(lgrInfo.seq);
             }
 
+            std::optional<std::vector<data::TransactionAndMetadata>> maybeTransactions;
+            auto const fetchTransactions = [&]() -> std::vector<data::TransactionAndMetadata>& {
+                if (not maybeTransactions) {
+                    maybeTransactions = data::synchronousAndRetryOnTimeout([&](auto yield) {
+                        return backend_->fetchAllTransactionsInLedger(lgrInfo.seq, yield);
+                    });
+                }
+                return *maybeTransactions;
+            };
+
+            // the indexes must see every ledger to stay consistent, published or not
+            if (backend_->nftIndex().isEnabled())
+                updateNFTIndex(lgrInfo.seq, fetchTransactions());
+
+            if (backend_->balancesIndex().isEnabled())
+                backend_->balancesIndex().update(fetchTransactions(), lgrInfo.seq);
+
             setLastClose(lgrInfo.closeTime);
             auto age = lastCloseAgeSeconds();
 
@@ -159,10 +179,7 @@ public:
                 });
                 assert(fees);
 
-                std::vector<data::TransactionAndMetadata> transactions =
-                    data::synchronousAndRetryOnTimeout([&](auto yield) {
-                        return backend_->fetchAllTransactionsInLedger(lgrInfo.seq, yield);
-                    });
+                auto& transactions = fetchTransactions();
 
                 auto const ledgerRange = backend_->fetchLedgerRange();
                 assert(ledgerRange);
@@ -264,6 +281,22 @@ private:
         std::scoped_lock const lck(lastPublishedSeqMtx_);
         lastPublishedSequence_ = lastPublishedSequence;
     }
+
+    void
+    updateNFTIndex(std::uint32_t seq, std::vector<data::TransactionAndMetadata> const& transactions)
+    {
+        std::vector<NFTsData> nfts;
+        for (auto const& txAndMeta : transactions) {
+            ripple::SerialIter it{txAndMeta.transaction.data(), txAndMeta.transaction.size()};
+            ripple::STTx const sttx{it};
+            ripple::TxMeta const txMeta{sttx.getTransactionID(), seq, txAndMeta.metadata};
+
+            if (auto const maybeNFT = getNFTDataFromTx(txMeta, sttx).second; maybeNFT)
+                nfts.push_back(*maybeNFT);
+        }
+
+        backend_->nftIndex().update(nfts, seq);
+    }
 };
 
 }  // namespace etl::detail
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <etl/impl/SourceStats.h>
+#include <util/Random.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace etl::detail {
+
+using util::prometheus::Label;
+using util::prometheus::Labels;
+
+SourceStats::SourceStats(std::string const& name, std::string const& kind)
+    : succeededCounter_(PrometheusService::counterInt(
+          "etl_source_requests_total_number",
+          Labels({Label{"source", name}, Label{"kind", kind}, Label{"status", "succeeded"}}),
+          "Total number of requests sent to the ETL source"
+      ))
+    , failedCounter_(PrometheusService::counterInt(
+          "etl_source_requests_total_number",
+          Labels({Label{"source", name}, Label{"kind", kind}, Label{"status", "failed"}}),
+          "Total number of requests sent to the ETL source"
+      ))
+    , hedgedCounter_(PrometheusService::counterInt(
+          "etl_source_requests_total_number",
+          Labels({Label{"source", name}, Label{"kind", kind}, Label{"status", "hedged"}}),
+          "Total number of requests sent to the ETL source"
+      ))
+    , durationCounter_(PrometheusService::counterInt(
+          "etl_source_request_duration_us",
+          Labels({Label{"source", name}, Label{"kind", kind}}),
+          "Total duration of requests sent to the ETL source"
+      ))
+    , latencyGauge_(PrometheusService::gaugeInt(
+          "etl_source_latency_ewma_us",
+          Labels({Label{"source", name}, Label{"kind", kind}}),
+          "Moving average of the latency of successful requests sent to the ETL source"
+      ))
+{
+}
+
+void
+SourceStats::record(std::chrono::microseconds latency, bool success, std::chrono::steady_clock::time_point now)
+{
+    durationCounter_ += latency.count();
+    if (success) {
+        ++succeededCounter_;
+    } else {
+        ++failedCounter_;
+    }
+
+    std::scoped_lock const lk(mtx_);
+
+    auto const error = success ? 0.0 : 1.0;
+    errorRateEwma_ = numSamples_ == 0 ? error : ALPHA * error + (1 - ALPHA) * errorRateEwma_;
+    ++numSamples_;
+    lastSample_ = now;
+
+    // a failure is usually a timeout or a dropped connection: only let it raise the latency
+    auto const us = static_cast<double>(latency.count());
+    auto const sample = success or !latencyEwmaUs_ ? us : std::max(us, *latencyEwmaUs_);
+    latencyEwmaUs_ = latencyEwmaUs_ ? ALPHA * sample + (1 - ALPHA) * *latencyEwmaUs_ : sample;
+    latencyGauge_.set(static_cast<std::int64_t>(*latencyEwmaUs_));
+
+    if (!success)
+        return;
+
+    window_[windowPos_] = latency.count();
+    windowPos_ = (windowPos_ + 1) % WINDOW_SIZE;
+    windowSize_ = std::min(windowSize_ + 1, WINDOW_SIZE);
+}
+
+void
+SourceStats::onHedged()
+{
+    ++hedgedCounter_;
+}
+
+double
+SourceStats::score(std::chrono::steady_clock::time_point now) const
+{
+    std::scoped_lock const lk(mtx_);
+    if (!lastSample_ || now - *lastSample_ > STALE_AFTER)
+        return 0;
+
+    return latencyEwmaUs_.value_or(0) + static_cast<double>(ERROR_PENALTY.count()) * errorRateEwma_;
+}
+
+std::chrono::microseconds
+SourceStats::latency() const
+{
+    std::scoped_lock const lk(mtx_);
+    return std::chrono::microseconds{static_cast<std::int64_t>(latencyEwmaUs_.value_or(0))};
+}
+
+double
+SourceStats::errorRate() const
+{
+    std::scoped_lock const lk(mtx_);
+    return errorRateEwma_;
+}
+
+std::optional<std::chrono::microseconds>
+SourceStats::p95() const
+{
+    static constexpr std::size_t PERCENTILE = 95;
+
+    std::vector<std::int64_t> samples;
+    {
+        std::scoped_lock const lk(mtx_);
+        if (windowSize_ < MIN_SAMPLES_FOR_PERCENTILE)
+            return std::nullopt;
+
+        samples.assign(window_.begin(), window_.begin() + windowSize_);
+    }
+
+    auto const nth = samples.begin() + (samples.size() * PERCENTILE - 1) / 100;
+    std::nth_element(samples.begin(), nth, samples.end());
+    return std::chrono::microseconds{*nth};
+}
+
+std::vector<std::size_t>
+orderSources(std::vector<double> const& scores)
+{
+    std::vector<std::size_t> order(scores.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&scores](auto lhs, auto rhs) { return scores[lhs] < scores[rhs]; });
+
+    if (scores.size() < 2)
+        return order;
+
+    auto const first = util::Random::uniform(0ul, scores.size() - 1);
+    auto second = util::Random::uniform(0ul, scores.size() - 2);
+    if (second >= first)
+        ++second;
+
+    // move the better of the two random picks to the front, the others stay sorted by score
+    auto const chosen = scores[second] < scores[first] ? second : first;
+    auto const it = std::find(order.begin(), order.end(), chosen);
+    std::rotate(order.begin(), it, std::next(it));
+    return order;
+}
+
+}  // namespace etl::detail
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/prometheus/Prometheus.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace etl::detail {
+
+/**
+ * @brief Latency and error statistics of one kind of requests sent to one ETL source.
+ *
+ * Each source has separate statistics for the requests forwarded from clients and for the ledgers fetched by the ETL,
+ * as the latter take much longer and would otherwise skew the hedging delay of forwarded requests.
+ *
+ * Latency and error rate are tracked as exponentially weighted moving averages so that recent samples dominate. Failed
+ * requests count towards the latency too when they took longer than usual, e.g. timeouts, but fast failures never make
+ * a source look faster. The last `WINDOW_SIZE` latencies of successful requests are also kept to estimate the 95th
+ * percentile, which is used as the delay before a hedged request is sent.
+ */
+class SourceStats {
+public:
+    static constexpr double ALPHA = 0.2;
+    static constexpr std::chrono::microseconds ERROR_PENALTY = std::chrono::seconds{1};
+    static constexpr std::size_t WINDOW_SIZE = 128;
+    static constexpr std::size_t MIN_SAMPLES_FOR_PERCENTILE = 20;
+    static constexpr std::chrono::seconds STALE_AFTER{10};
+
+private:
+    mutable std::mutex mtx_;
+    std::size_t numSamples_ = 0;
+    std::optional<double> latencyEwmaUs_;
+    double errorRateEwma_ = 0;
+    std::optional<std::chrono::steady_clock::time_point> lastSample_;
+    std::array<std::int64_t, WINDOW_SIZE> window_{};
+    std::size_t windowSize_ = 0;
+    std::size_t windowPos_ = 0;
+
+    util::prometheus::CounterInt& succeededCounter_;
+    util::prometheus::CounterInt& failedCounter_;
+    util::prometheus::CounterInt& hedgedCounter_;
+    util::prometheus::CounterInt& durationCounter_;
+    util::prometheus::GaugeInt& latencyGauge_;
+
+public:
+    /**
+     * @brief Create statistics for a source.
+     *
+     * @param name The name of the source used as label of the exported metrics
+     * @param kind The kind of requests, `forward` or `fetch`, used as label of the exported metrics
+     */
+    SourceStats(std::string const& name, std::string const& kind);
+
+    /**
+     * @brief Record the outcome of a request sent to the source.
+     *
+     * @param latency How long the request took
+     * @param success Whether the request succeeded
+     * @param now The time the request completed
+     */
+    void
+    record(
+        std::chrono::microseconds latency,
+        bool success,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()
+    );
+
+    /** @brief Account for a hedged request sent to the source. */
+    void
+    onHedged();
+
+    /**
+     * @brief Score of the source; lower is better.
+     *
+     * The score is the average latency plus `ERROR_PENALTY` scaled by the error rate, so a source that fails every
+     * request scores worse than any source that answers within a second. A source without recent samples scores 0 so
+     * that it gets probed again.
+     *
+     * @param now The current time
+     * @return The score
+     */
+    [[nodiscard]] double
+    score(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const;
+
+    /** @return The moving average of the latency of requests */
+    [[nodiscard]] std::chrono::microseconds
+    latency() const;
+
+    /** @return The moving average of the error rate within [0, 1] */
+    [[nodiscard]] double
+    errorRate() const;
+
+    /** @return The 95th percentile of the recent latencies; nullopt if there are not enough samples */
+    [[nodiscard]] std::optional<std::chrono::microseconds>
+    p95() const;
+};
+
+/**
+ * @brief Order sources for sending a request using the power of two choices.
+ *
+ * Two distinct sources are picked at random and the one with the lower score goes first. All other sources follow
+ * from the best score to the worst, to be used as fallbacks.
+ *
+ * @param scores The score of each source
+ * @return Indices of the sources in the order they should be tried
+ */
+std::vector<std::size_t>
+orderSources(std::vector<double> const& scores);
+
+}  // namespace etl::detail
@@ -24,8 +24,8 @@
 #include <etl/impl/AmendmentBlock.h>
 #include <etl/impl/LedgerLoader.h>
 #include <util/LedgerUtils.h>
-#include <util/Profiler.h>
 #include <util/log/Logger.h>
+#include <util/profiling/Profiling.h>
 
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
@@ -136,14 +136,15 @@ private:
             if (isStopping())
                 continue;
 
-            auto const start = std::chrono::system_clock::now();
-            auto [lgrInfo, success] = buildNextLedger(*fetchResponse);
+            static ::util::profiling::Zone const buildZone{"etl.build_ledger"};
+            auto const [result, duration] = ::util::profiling::timed<std::chrono::duration<double>>(buildZone, [&]() {
+                return buildNextLedger(*fetchResponse);
+            });
+            auto const& [lgrInfo, success] = result;
 
             if (success) {
                 auto const numTxns = fetchResponse->transactions_list().transactions_size();
                 auto const numObjects = fetchResponse->ledger_objects().objects_size();
-                auto const end = std::chrono::system_clock::now();
-                auto const duration = ((end - start).count()) / 1000000000.0;
 
                 LOG(log_.info()) << "Load phase of etl : "
                                  << "Successfully wrote ledger! Ledger info: " << util::toString(lgrInfo)
@@ -201,8 +202,10 @@ private:
         backend_->writeNFTs(std::move(insertTxResultOp->nfTokensData));
         backend_->writeNFTTransactions(std::move(insertTxResultOp->nfTokenTxData));
 
-        auto [success, duration] =
-            ::util::timed<std::chrono::duration<double>>([&]() { return backend_->finishWrites(lgrInfo.seq); });
+        static ::util::profiling::Zone const finishWritesZone{"etl.finish_writes"};
+        auto [success, duration] = ::util::profiling::timed<std::chrono::duration<double>>(finishWritesZone, [&]() {
+            return backend_->finishWrites(lgrInfo.seq);
+        });
 
         LOG(log_.debug()) << "Finished writes. Total time: " << std::to_string(duration);
         LOG(log_.debug()) << "Finished ledger update: " << ::util::toString(lgrInfo);
@@ -208,12 +208,13 @@ SubscriptionManager::pubTransaction(data::TransactionAndMetadata const& blobs, r
     auto pubMsg = std::make_shared<std::string>(boost::json::serialize(pubObj));
     txSubscribers_.publish(pubMsg);
 
-    auto accounts = meta->getAffectedAccounts();
-
-    for (auto const& account : accounts)
-        accountSubscribers_.publish(pubMsg, account);
+    auto const affectedAccounts = meta->getAffectedAccounts();
+    accountSubscribers_.publish(
+        pubMsg, std::vector<ripple::AccountID>{std::cbegin(affectedAccounts), std::cend(affectedAccounts)}
+    );
 
     std::unordered_set<ripple::Book> alreadySent;
+    std::vector<ripple::Book> books;
 
     for (auto const& node : meta->getNodes()) {
         if (node.getFieldU16(ripple::sfLedgerEntryType) == ripple::ltOFFER) {
@@ -239,13 +240,16 @@ SubscriptionManager::pubTransaction(data::TransactionAndMetadata const& blobs, r
                         data->getFieldAmount(ripple::sfTakerGets).issue(),
                         data->getFieldAmount(ripple::sfTakerPays).issue()};
                     if (alreadySent.find(book) == alreadySent.end()) {
-                        bookSubscribers_.publish(pubMsg, book);
+                        books.push_back(book);
                         alreadySent.insert(book);
                     }
                 }
             }
         }
     }
+
+    if (!books.empty())
+        bookSubscribers_.publish(pubMsg, books);
 }
 
 void
@@ -254,7 +258,8 @@ SubscriptionManager::pubBookChanges(
     std::vector<data::TransactionAndMetadata> const& transactions
 )
 {
-    auto const json = rpc::computeBookChanges(lgrInfo, transactions);
+    auto const changes = bookChangesCache_->put(lgrInfo.seq, rpc::BookChanges::compute(transactions));
+    auto const json = rpc::computeBookChanges(lgrInfo, *changes);
     auto const bookChangesMsg = std::make_shared<std::string>(boost::json::serialize(json));
     bookChangesSubscribers_.publish(bookChangesMsg);
 }
@@ -267,9 +272,7 @@ SubscriptionManager::forwardProposedTransaction(boost::json::object const& respo
 
     auto transaction = response.at("transaction").as_object();
     auto accounts = rpc::getAccountsFromTransaction(transaction);
-
-    for (ripple::AccountID const& account : accounts)
-        accountProposedSubscribers_.publish(pubMsg, account);
+    accountProposedSubscribers_.publish(pubMsg, accounts);
 }
 
 void
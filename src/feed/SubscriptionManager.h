@@ -20,6 +20,7 @@
 #pragma once
 
 #include <data/BackendInterface.h>
+#include <rpc/BookChangesCache.h>
 #include <util/config/Config.h>
 #include <util/log/Logger.h>
 #include <util/prometheus/Prometheus.h>
@@ -27,7 +28,9 @@
 
 #include <ripple/protocol/LedgerHeader.h>
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 /**
  * @brief This namespace deals with subscriptions.
@@ -177,13 +180,24 @@ public:
 
 /**
  * @brief Represents a collection of subscriptions where each stream is mapped to a key.
+ *
+ * Keys are partitioned into a number of shards by their hash. Each shard owns its own strand and subscribers, so
+ * publishing to keys that live on different shards can run in parallel on the subscription workers.
  */
 template <class Key>
 class SubscriptionMap {
-    using SubscribersType = std::set<SessionPtrType>;
+    using SubscribersType = std::vector<SessionPtrType>;
 
-    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
-    std::unordered_map<Key, SubscribersType> subscribers_ = {};
+    struct Shard {
+        boost::asio::strand<boost::asio::io_context::executor_type> strand;
+        std::unordered_map<Key, SubscribersType> subscribers = {};
+
+        explicit Shard(boost::asio::io_context& ioc) : strand(boost::asio::make_strand(ioc))
+        {
+        }
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
     util::prometheus::GaugeInt& subCount_;
 
 public:
@@ -195,15 +209,20 @@ public:
      * @brief Create a new subscription map.
      *
      * @param ioc The io_context to run on
+     * @param name The name of the collection; used for metrics
+     * @param numShards The number of shards (strands) to partition the keys into
      */
-    explicit SubscriptionMap(boost::asio::io_context& ioc, std::string const& name)
-        : strand_(boost::asio::make_strand(ioc))
-        , subCount_(PrometheusService::gaugeInt(
+    explicit SubscriptionMap(boost::asio::io_context& ioc, std::string const& name, std::size_t numShards = 1)
+        : subCount_(PrometheusService::gaugeInt(
               "subscriptions_current_number",
               util::prometheus::Labels({util::prometheus::Label{"collection", name}}),
               fmt::format("Current subscribers number on the {} collection", name)
           ))
     {
+        numShards = std::max<std::size_t>(numShards, 1);
+        shards_.reserve(numShards);
+        for (std::size_t i = 0; i < numShards; ++i)
+            shards_.push_back(std::make_unique<Shard>(ioc));
     }
 
     ~SubscriptionMap() = default;
@@ -217,7 +236,15 @@ public:
     void
     subscribe(SessionPtrType const& session, Key const& key)
     {
-        boost::asio::post(strand_, [this, session, key]() { addSession(session, subscribers_[key], subCount_); });
+        auto& shard = shardFor(key);
+        boost::asio::post(shard.strand, [this, &shard, session, key]() {
+            auto& subscribers = shard.subscribers[key];
+            if (std::find(std::cbegin(subscribers), std::cend(subscribers), session) != std::cend(subscribers))
+                return;
+
+            subscribers.push_back(session);
+            ++subCount_;
+        });
     }
 
     /**
@@ -229,19 +256,23 @@ public:
     void
     unsubscribe(SessionPtrType const& session, Key const& key)
     {
-        boost::asio::post(strand_, [this, key, session]() {
-            if (!subscribers_.contains(key))
+        auto& shard = shardFor(key);
+        boost::asio::post(shard.strand, [this, &shard, key, session]() {
+            auto it = shard.subscribers.find(key);
+            if (it == std::end(shard.subscribers))
                 return;
 
-            if (!subscribers_[key].contains(session))
+            auto& subscribers = it->second;
+            auto sessionIt = std::find(std::begin(subscribers), std::end(subscribers), session);
+            if (sessionIt == std::end(subscribers))
                 return;
 
             --subCount_;
-            subscribers_[key].erase(session);
+            *sessionIt = std::move(subscribers.back());
+            subscribers.pop_back();
 
-            if (subscribers_[key].size() == 0) {
-                subscribers_.erase(key);
-            }
+            if (subscribers.empty())
+                shard.subscribers.erase(it);
         });
     }
 
@@ -255,10 +286,12 @@ public:
     bool
     hasSession(SessionPtrType const& session, Key const& key)
     {
-        if (!subscribers_.contains(key))
+        auto const& subscribers = shardFor(key).subscribers;
+        auto const it = subscribers.find(key);
+        if (it == std::cend(subscribers))
             return false;
 
-        return subscribers_[key].contains(session);
+        return std::find(std::cbegin(it->second), std::cend(it->second), session) != std::cend(it->second);
     }
 
     /**
@@ -270,12 +303,44 @@ public:
     void
     publish(std::shared_ptr<std::string> const& message, Key const& key)
     {
-        boost::asio::post(strand_, [this, key, message]() {
-            if (!subscribers_.contains(key))
-                return;
+        auto& shard = shardFor(key);
+        boost::asio::post(shard.strand, [this, &shard, key, message]() { publishToKey(shard, message, key); });
+    }
 
-            sendToSubscribers(message, subscribers_[key], subCount_);
-        });
+    /**
+     * @brief Sends the given message to the subscribers of all the given keys.
+     *
+     * Keys are grouped by their shard so that at most one task is posted per shard regardless of the number of keys.
+     *
+     * @param message The message to send
+     * @param keys The keys for the subscriptions to send the message to
+     */
+    void
+    publish(std::shared_ptr<std::string> const& message, std::vector<Key> const& keys)
+    {
+        if (shards_.size() == 1) {
+            auto& shard = *shards_.front();
+            boost::asio::post(shard.strand, [this, &shard, keys, message]() {
+                for (auto const& key : keys)
+                    publishToKey(shard, message, key);
+            });
+            return;
+        }
+
+        std::vector<std::vector<Key>> keysPerShard(shards_.size());
+        for (auto const& key : keys)
+            keysPerShard[shardIndex(key)].push_back(key);
+
+        for (std::size_t i = 0; i < shards_.size(); ++i) {
+            if (keysPerShard[i].empty())
+                continue;
+
+            auto& shard = *shards_[i];
+            boost::asio::post(shard.strand, [this, &shard, keys = std::move(keysPerShard[i]), message]() {
+                for (auto const& key : keys)
+                    publishToKey(shard, message, key);
+            });
+        }
     }
 
     /**
@@ -286,6 +351,52 @@ public:
     {
         return subCount_.value();
     }
+
+    /**
+     * @return The number of shards the keys are partitioned into.
+     */
+    std::size_t
+    numShards() const
+    {
+        return shards_.size();
+    }
+
+private:
+    std::size_t
+    shardIndex(Key const& key) const
+    {
+        return std::hash<Key>{}(key) % shards_.size();
+    }
+
+    Shard&
+    shardFor(Key const& key)
+    {
+        return *shards_[shardIndex(key)];
+    }
+
+    // must be called on the strand of the given shard
+    void
+    publishToKey(Shard& shard, std::shared_ptr<std::string> const& message, Key const& key)
+    {
+        auto it = shard.subscribers.find(key);
+        if (it == std::end(shard.subscribers))
+            return;
+
+        auto& subscribers = it->second;
+        for (std::size_t i = 0; i < subscribers.size();) {
+            if (subscribers[i]->dead()) {
+                subscribers[i] = std::move(subscribers.back());
+                subscribers.pop_back();
+                --subCount_;
+            } else {
+                subscribers[i]->send(message);
+                ++i;
+            }
+        }
+
+        if (subscribers.empty())
+            shard.subscribers.erase(it);
+    }
 };
 
 /**
@@ -310,8 +421,11 @@ class SubscriptionManager {
     SubscriptionMap<ripple::Book> bookSubscribers_;
 
     std::shared_ptr<data::BackendInterface const> backend_;
+    std::shared_ptr<rpc::BookChangesCache> bookChangesCache_;
 
 public:
+    static constexpr std::size_t DEFAULT_BOOK_CHANGES_CACHE_SIZE = 256;
+
     /**
      * @brief A factory function that creates a new subscription manager configured from the config provided.
      *
@@ -322,7 +436,9 @@ public:
     make_SubscriptionManager(util::Config const& config, std::shared_ptr<data::BackendInterface const> const& backend)
     {
         auto numThreads = config.valueOr<uint64_t>("subscription_workers", 1);
-        return std::make_shared<SubscriptionManager>(numThreads, backend);
+        auto bookChangesCacheSize =
+            config.valueOr<std::size_t>("book_changes_cache_size", DEFAULT_BOOK_CHANGES_CACHE_SIZE);
+        return std::make_shared<SubscriptionManager>(numThreads, backend, bookChangesCacheSize);
     }
 
     /**
@@ -330,24 +446,29 @@ public:
      *
      * @param numThreads The number of worker threads to manage subscriptions
      * @param backend The backend to use
+     * @param bookChangesCacheSize The number of recent ledgers to keep the book changes of
      */
-    SubscriptionManager(std::uint64_t numThreads, std::shared_ptr<data::BackendInterface const> const& backend)
+    SubscriptionManager(
+        std::uint64_t numThreads,
+        std::shared_ptr<data::BackendInterface const> const& backend,
+        std::size_t bookChangesCacheSize = DEFAULT_BOOK_CHANGES_CACHE_SIZE
+    )
         : ledgerSubscribers_(ioc_, "ledger")
         , txSubscribers_(ioc_, "tx")
         , txProposedSubscribers_(ioc_, "tx_proposed")
         , manifestSubscribers_(ioc_, "manifest")
         , validationsSubscribers_(ioc_, "validations")
         , bookChangesSubscribers_(ioc_, "book_changes")
-        , accountSubscribers_(ioc_, "account")
-        , accountProposedSubscribers_(ioc_, "account_proposed")
-        , bookSubscribers_(ioc_, "book")
+        , accountSubscribers_(ioc_, "account", numThreads)
+        , accountProposedSubscribers_(ioc_, "account_proposed", numThreads)
+        , bookSubscribers_(ioc_, "book", numThreads)
         , backend_(backend)
+        , bookChangesCache_(std::make_shared<rpc::BookChangesCache>(bookChangesCacheSize))
     {
         work_.emplace(ioc_);
 
-        // We will eventually want to clamp this to be the number of strands,
-        // since adding more threads than we have strands won't see any
-        // performance benefits
+        // The keyed collections are sharded into one strand per worker, so account and book fan-out can use all of
+        // the workers. The single streams still have one strand each.
         LOG(log_.info()) << "Starting subscription manager with " << numThreads << " workers";
 
         workers_.reserve(numThreads);
@@ -392,7 +513,8 @@ public:
     );
 
     /**
-     * @brief Publish to the book changes stream.
+     * @brief Compute the book changes of a ledger, keep them for the book_changes handler and publish them to the book
+     * changes stream.
      *
      * @param lgrInfo The ledger header to serialize
      * @param transactions The transactions to serialize
@@ -400,6 +522,15 @@ public:
     void
     pubBookChanges(ripple::LedgerHeader const& lgrInfo, std::vector<data::TransactionAndMetadata> const& transactions);
 
+    /**
+     * @return The book changes of the recently published ledgers
+     */
+    std::shared_ptr<rpc::BookChangesCache const>
+    bookChangesCache() const
+    {
+        return bookChangesCache_;
+    }
+
     /**
      * @brief Unsubscribe from the ledger stream.
      *
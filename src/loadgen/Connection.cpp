@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/Connection.h>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/json.hpp>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <stdexcept>
+
+namespace loadgen {
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace websocket = beast::websocket;
+using tcp = boost::asio::ip::tcp;
+
+namespace {
+
+constexpr auto TIMEOUT = std::chrono::seconds(30);
+
+std::optional<std::string>
+errorOf(boost::json::object const& object)
+{
+    auto const status = object.if_contains("status");
+    auto const error = object.if_contains("error");
+    bool const failed = (status != nullptr && status->is_string() && status->as_string() == "error") ||
+        (error != nullptr && status == nullptr);
+
+    if (!failed)
+        return std::nullopt;
+
+    if (error != nullptr && error->is_string())
+        return std::string{error->as_string().c_str()};
+
+    return "unknown_error";
+}
+
+}  // namespace
+
+std::optional<std::string>
+Connection::responseError(std::string const& response)
+{
+    boost::json::value parsed;
+    try {
+        parsed = boost::json::parse(response);
+    } catch (std::exception const&) {
+        return "malformed_response";
+    }
+
+    if (!parsed.is_object())
+        return "malformed_response";
+
+    auto const& object = parsed.as_object();
+    if (auto const result = object.if_contains("result"); result != nullptr && result->is_object()) {
+        if (auto error = errorOf(result->as_object()); error)
+            return error;
+    }
+
+    return errorOf(object);
+}
+
+HttpConnection::HttpConnection(std::string host, std::string port) : host_(std::move(host)), port_(std::move(port))
+{
+}
+
+std::string
+HttpConnection::request(std::string const& body, boost::asio::yield_context yield)
+{
+    try {
+        if (!stream_) {
+            auto const executor = boost::asio::get_associated_executor(yield);
+            tcp::resolver resolver{executor};
+            auto const results = resolver.async_resolve(host_, port_, yield);
+            stream_.emplace(executor);
+            stream_->expires_after(TIMEOUT);
+            stream_->async_connect(results, yield);
+        }
+
+        http::request<http::string_body> req{http::verb::post, "/", 11};
+        req.set(http::field::host, host_);
+        req.set(http::field::content_type, "application/json");
+        req.keep_alive(true);
+        req.body() = body;
+        req.prepare_payload();
+
+        stream_->expires_after(TIMEOUT);
+        http::async_write(*stream_, req, yield);
+
+        beast::flat_buffer buffer;
+        http::response<http::string_body> res;
+        http::async_read(*stream_, buffer, res, yield);
+
+        if (!res.keep_alive())
+            stream_.reset();
+
+        return std::move(res.body());
+    } catch (...) {
+        stream_.reset();
+        throw;
+    }
+}
+
+bool
+HttpConnection::isConnected() const
+{
+    return stream_.has_value();
+}
+
+WsConnection::WsConnection(std::string host, std::string port) : host_(std::move(host)), port_(std::move(port))
+{
+}
+
+std::string
+WsConnection::request(std::string const& body, boost::asio::yield_context yield)
+{
+    try {
+        if (!stream_) {
+            auto const executor = boost::asio::get_associated_executor(yield);
+            tcp::resolver resolver{executor};
+            auto const results = resolver.async_resolve(host_, port_, yield);
+            stream_.emplace(executor);
+            stream_->next_layer().expires_after(TIMEOUT);
+            stream_->next_layer().async_connect(results, yield);
+            stream_->next_layer().expires_never();
+            stream_->set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
+            stream_->async_handshake(host_, "/", yield);
+        }
+
+        stream_->async_write(boost::asio::buffer(body), yield);
+
+        beast::flat_buffer buffer;
+        stream_->async_read(buffer, yield);
+
+        return beast::buffers_to_string(buffer.data());
+    } catch (...) {
+        stream_.reset();
+        throw;
+    }
+}
+
+bool
+WsConnection::isConnected() const
+{
+    return stream_.has_value();
+}
+
+std::unique_ptr<Connection>
+make_Connection(std::string const& protocol, std::string const& host, std::string const& port)
+{
+    if (protocol == "http")
+        return std::make_unique<HttpConnection>(host, port);
+
+    if (protocol == "ws")
+        return std::make_unique<WsConnection>(host, port);
+
+    throw std::runtime_error(fmt::format("Unknown protocol '{}', expected http or ws", protocol));
+}
+
+}  // namespace loadgen
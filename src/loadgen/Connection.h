@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/spawn.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace loadgen {
+
+/**
+ * @brief A connection to the server under test that sends one request at a time.
+ *
+ * The connection is established lazily and re-established after any transport error, so a worker keeps going if the
+ * server drops it.
+ */
+class Connection {
+public:
+    virtual ~Connection() = default;
+
+    /**
+     * @brief Send a request and wait for its response.
+     *
+     * @param body The serialized request
+     * @param yield The coroutine context
+     * @return The body of the response
+     * @throws boost::system::system_error on transport errors
+     */
+    virtual std::string
+    request(std::string const& body, boost::asio::yield_context yield) = 0;
+
+    /**
+     * @return true if the connection is established; false if the next request has to connect first
+     */
+    virtual bool
+    isConnected() const = 0;
+
+    /**
+     * @brief Extract the error code of a response.
+     *
+     * Handles both the HTTP form (`result.status` and `result.error`) and the websocket form (`status` and `error`).
+     *
+     * @param response The body of the response
+     * @return The error code; nullopt if the response is successful
+     */
+    static std::optional<std::string>
+    responseError(std::string const& response);
+};
+
+/**
+ * @brief Sends requests as HTTP POSTs over a keep-alive connection.
+ */
+class HttpConnection : public Connection {
+    std::string host_;
+    std::string port_;
+    std::optional<boost::beast::tcp_stream> stream_;
+
+public:
+    HttpConnection(std::string host, std::string port);
+
+    std::string
+    request(std::string const& body, boost::asio::yield_context yield) override;
+
+    bool
+    isConnected() const override;
+};
+
+/**
+ * @brief Sends requests as messages over a websocket session.
+ */
+class WsConnection : public Connection {
+    std::string host_;
+    std::string port_;
+    std::optional<boost::beast::websocket::stream<boost::beast::tcp_stream>> stream_;
+
+public:
+    WsConnection(std::string host, std::string port);
+
+    std::string
+    request(std::string const& body, boost::asio::yield_context yield) override;
+
+    bool
+    isConnected() const override;
+};
+
+/**
+ * @brief A factory function that creates a connection for the given protocol.
+ *
+ * @param protocol Either "http" or "ws"
+ * @param host The host of the server
+ * @param port The port of the server
+ * @return The connection
+ * @throws std::runtime_error if the protocol is unknown
+ */
+std::unique_ptr<Connection>
+make_Connection(std::string const& protocol, std::string const& host, std::string const& port);
+
+}  // namespace loadgen
@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/LoadGenerator.h>
+
+#include <loadgen/Connection.h>
+#include <loadgen/Stats.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace loadgen {
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr auto MIN_BACKOFF = std::chrono::milliseconds(10);
+constexpr auto MAX_BACKOFF = std::chrono::milliseconds(1000);
+
+}  // namespace
+
+LoadGenerator::LoadGenerator(LoadSettings settings, RequestSet const& requests)
+    : settings_(std::move(settings)), requests_(std::cref(requests))
+{
+}
+
+std::optional<MetricsSnapshot>
+LoadGenerator::scrapeMetrics() const
+{
+    if (!settings_.scrapeMetrics)
+        return std::nullopt;
+
+    boost::asio::io_context ioc;
+    std::optional<MetricsSnapshot> snapshot;
+    boost::asio::spawn(ioc, [&](boost::asio::yield_context yield) {
+        snapshot = MetricsSnapshot::scrape(settings_.host, settings_.port, settings_.adminPassword, yield);
+    });
+    ioc.run();
+
+    return snapshot;
+}
+
+boost::json::object
+LoadGenerator::run()
+{
+    auto const before = scrapeMetrics();
+
+    boost::asio::io_context ioc;
+    std::atomic_uint64_t next = 0;
+    std::vector<Stats> stats(settings_.concurrency);
+
+    auto const start = Clock::now();
+    auto const deadline = settings_.duration.count() == 0 ? Clock::time_point::max() : start + settings_.duration;
+
+    // created up front so that bad settings are reported before any load is sent
+    std::vector<std::unique_ptr<Connection>> connections;
+    for (std::size_t worker = 0; worker < settings_.concurrency; ++worker)
+        connections.push_back(make_Connection(settings_.protocol, settings_.host, settings_.port));
+
+    for (std::size_t worker = 0; worker < settings_.concurrency; ++worker) {
+        boost::asio::spawn(ioc, [&, worker](boost::asio::yield_context yield) {
+            auto& connection = *connections[worker];
+            boost::asio::steady_timer timer{boost::asio::get_associated_executor(yield)};
+            auto backoff = MIN_BACKOFF;
+
+            while (true) {
+                auto const k = next.fetch_add(1);
+                if (settings_.maxRequests != 0 && k >= settings_.maxRequests)
+                    break;
+
+                auto intended = Clock::now();
+                if (settings_.rate > 0) {
+                    auto const offset = std::chrono::duration<double>(static_cast<double>(k) / settings_.rate);
+                    intended = start + std::chrono::duration_cast<Clock::duration>(offset);
+                    if (intended >= deadline)
+                        break;
+
+                    boost::system::error_code ec;
+                    timer.expires_at(intended);
+                    timer.async_wait(yield[ec]);
+                } else if (intended >= deadline) {
+                    break;
+                }
+
+                auto const& request = requests_.get().next(k);
+                auto const wasConnected = connection.isConnected();
+                std::optional<std::string> error;
+                try {
+                    auto const& body = settings_.protocol == "http" ? request.httpBody : request.wsBody;
+                    error = Connection::responseError(connection.request(body, yield));
+                    backoff = MIN_BACKOFF;
+                } catch (std::exception const& e) {
+                    error = wasConnected ? "transport_error" : "connect_error";
+                    if (backoff == MIN_BACKOFF) {
+                        std::cerr << fmt::format(
+                            "Worker {} failed to send to {}:{}: {}\n", worker, settings_.host, settings_.port, e.what()
+                        );
+                    }
+                }
+
+                auto const latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - intended);
+                stats[worker].record(request.method, latency, error);
+
+                // the connection is gone; wait before reconnecting instead of spinning against a server that is down
+                if (!connection.isConnected() && error) {
+                    boost::system::error_code ec;
+                    timer.expires_at(std::min(Clock::now() + backoff, deadline));
+                    timer.async_wait(yield[ec]);
+                    backoff = std::min(backoff * 2, MAX_BACKOFF);
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < settings_.threads; ++i)
+        threads.emplace_back([&ioc] { ioc.run(); });
+    ioc.run();
+    for (auto& thread : threads)
+        thread.join();
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+
+    Stats total;
+    for (auto const& workerStats : stats)
+        total.merge(workerStats);
+
+    auto report = total.report(elapsed);
+    report["settings"] = {
+        {"host", settings_.host},
+        {"port", settings_.port},
+        {"protocol", settings_.protocol},
+        {"concurrency", settings_.concurrency},
+        {"rate", settings_.rate},
+        {"requests_in_set", requests_.get().size()},
+    };
+
+    if (auto const after = scrapeMetrics(); before && after) {
+        boost::json::object metrics;
+        for (auto const& [series, delta] : after->deltaSince(*before))
+            metrics[series] = delta;
+        report["metrics_delta"] = std::move(metrics);
+    }
+
+    return report;
+}
+
+}  // namespace loadgen
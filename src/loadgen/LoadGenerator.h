@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <loadgen/MetricsSnapshot.h>
+#include <loadgen/RequestSet.h>
+
+#include <boost/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace loadgen {
+
+/**
+ * @brief Settings of one load generation run.
+ */
+struct LoadSettings {
+    std::string host = "127.0.0.1";
+    std::string port = "51233";
+    std::string protocol = "ws";
+    std::size_t concurrency = 8;
+    std::size_t threads = 2;
+    double rate = 0.0;  // requests per second; 0 sends the next request as soon as a worker is free
+    std::chrono::seconds duration{30};  // 0 runs until maxRequests are sent
+    std::uint64_t maxRequests = 0;  // 0 sends requests until the duration elapses
+    bool scrapeMetrics = true;
+    std::optional<std::string> adminPassword;
+};
+
+/**
+ * @brief Replays a request set against a running server and reports what happened.
+ *
+ * Every worker is a coroutine with its own connection that sends one request at a time; all the workers share a
+ * counter that picks the next request from the set, so the sequence sent is the same regardless of the concurrency.
+ *
+ * With a rate the run is open-loop: the k-th request is due at `start + k / rate` and its latency is measured from that
+ * moment rather than from when a worker got around to sending it. A server that falls behind then shows up as growing
+ * latencies instead of silently lowering the offered load.
+ *
+ * A worker whose connection fails records the request as a `connect_error` or `transport_error` and waits before
+ * reconnecting, doubling the wait while the server stays unreachable.
+ */
+class LoadGenerator {
+    LoadSettings settings_;
+    std::reference_wrapper<RequestSet const> requests_;
+
+public:
+    /**
+     * @brief Create a new load generator.
+     *
+     * @param settings The settings of the run
+     * @param requests The requests to replay
+     */
+    LoadGenerator(LoadSettings settings, RequestSet const& requests);
+
+    /**
+     * @brief Run the load and block until it is over.
+     *
+     * @return JSON report with the settings, per-method latency percentiles, throughput and error codes, and the
+     * changes of the server metrics during the run if they could be scraped
+     */
+    boost::json::object
+    run();
+
+private:
+    std::optional<MetricsSnapshot>
+    scrapeMetrics() const;
+};
+
+}  // namespace loadgen
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/LoadGenerator.h>
+#include <loadgen/RequestSet.h>
+
+#include <boost/json.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace po = boost::program_options;
+
+int
+main(int argc, char* argv[])
+try {
+    loadgen::LoadSettings settings;
+    std::uint64_t durationSeconds = settings.duration.count();
+
+    // clang-format off
+    po::options_description description("Options");
+    description.add_options()
+        ("help,h", "print help message and exit")
+        ("requests,r", po::value<std::string>(), "jsonl file with one request per line")
+        ("host", po::value<std::string>(&settings.host)->default_value(settings.host), "host of the server")
+        ("port", po::value<std::string>(&settings.port)->default_value(settings.port), "port of the server")
+        ("protocol", po::value<std::string>(&settings.protocol)->default_value(settings.protocol), "http or ws")
+        ("concurrency,c", po::value<std::size_t>(&settings.concurrency)->default_value(settings.concurrency),
+            "number of connections sending requests")
+        ("threads", po::value<std::size_t>(&settings.threads)->default_value(settings.threads),
+            "number of threads running the connections")
+        ("rate", po::value<double>(&settings.rate)->default_value(settings.rate),
+            "requests per second; 0 sends requests as fast as the server answers them")
+        ("duration,d", po::value<std::uint64_t>(&durationSeconds)->default_value(durationSeconds),
+            "duration of the run in seconds; 0 runs until max-requests are sent")
+        ("max-requests,n", po::value<std::uint64_t>(&settings.maxRequests)->default_value(settings.maxRequests),
+            "number of requests to send; 0 sends requests until the duration elapses")
+        ("mix", po::value<std::string>()->default_value(""),
+            "weighted methods to replay, e.g. account_info=3,tx=1; empty replays the file in order")
+        ("admin-password", po::value<std::string>(), "admin password of the server, needed to scrape metrics")
+        ("no-metrics", "do not scrape the metrics of the server before and after the run")
+        ("output,o", po::value<std::string>(), "file to write the report to; the report is printed if not set")
+    ;
+    // clang-format on
+
+    po::variables_map parsed;
+    po::store(po::parse_command_line(argc, argv, description), parsed);
+    po::notify(parsed);
+
+    if (parsed.count("help") != 0u || parsed.count("requests") == 0u) {
+        std::cout << "Clio load generator\n\n" << description;
+        return parsed.count("help") != 0u ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    settings.duration = std::chrono::seconds(durationSeconds);
+    settings.scrapeMetrics = parsed.count("no-metrics") == 0u;
+    if (parsed.count("admin-password") != 0u)
+        settings.adminPassword = parsed["admin-password"].as<std::string>();
+
+    if (settings.concurrency == 0 || settings.threads == 0 || settings.rate < 0) {
+        std::cerr << "concurrency and threads must be positive and rate must not be negative\n";
+        return EXIT_FAILURE;
+    }
+
+    if (settings.duration.count() == 0 && settings.maxRequests == 0) {
+        std::cerr << "Either duration or max-requests must be set\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input{parsed["requests"].as<std::string>()};
+    if (!input) {
+        std::cerr << "Can't open " << parsed["requests"].as<std::string>() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    auto const requests = loadgen::RequestSet::parse(input, parsed["mix"].as<std::string>());
+    auto const report = boost::json::serialize(loadgen::LoadGenerator{settings, requests}.run());
+
+    if (parsed.count("output") != 0u) {
+        std::ofstream output{parsed["output"].as<std::string>()};
+        output << report << '\n';
+    } else {
+        std::cout << report << '\n';
+    }
+
+    return EXIT_SUCCESS;
+} catch (std::exception const& e) {
+    std::cerr << "Exit on exception: " << e.what() << '\n';
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/MetricsSnapshot.h>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/digest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace loadgen {
+
+namespace {
+
+/**
+ * @brief Find the end of the series name and labels, skipping over quoted label values.
+ */
+std::size_t
+seriesEnd(std::string_view line)
+{
+    bool inLabels = false;
+    bool inQuotes = false;
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        auto const c = line[i];
+        if (inQuotes) {
+            if (c == '\\')
+                ++i;
+            else if (c == '"')
+                inQuotes = false;
+        } else if (c == '"' && inLabels) {
+            inQuotes = true;
+        } else if (c == '{') {
+            inLabels = true;
+        } else if (c == '}') {
+            inLabels = false;
+        } else if ((c == ' ' || c == '\t') && !inLabels) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+std::string
+passwordHeader(std::string const& password)
+{
+    ripple::sha256_hasher hasher;
+    hasher(password.data(), password.size());
+    auto const d = static_cast<ripple::sha256_hasher::result_type>(hasher);
+    ripple::uint256 sha256;
+    std::memcpy(sha256.data(), d.data(), d.size());
+    return "Password " + ripple::to_string(sha256);
+}
+
+}  // namespace
+
+MetricsSnapshot
+MetricsSnapshot::parse(std::string_view text)
+{
+    MetricsSnapshot snapshot;
+
+    while (!text.empty()) {
+        auto const eol = text.find('\n');
+        auto line = text.substr(0, eol);
+        text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        auto const end = seriesEnd(line);
+        if (end == std::string_view::npos)
+            continue;
+
+        auto value = line.substr(end);
+        value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+        value = value.substr(0, value.find_first_of(" \t\r"));
+
+        try {
+            snapshot.values_[std::string{line.substr(0, end)}] = std::stod(std::string{value});
+        } catch (std::exception const&) {
+            continue;
+        }
+    }
+
+    return snapshot;
+}
+
+std::optional<MetricsSnapshot>
+MetricsSnapshot::scrape(
+    std::string const& host,
+    std::string const& port,
+    std::optional<std::string> const& adminPassword,
+    boost::asio::yield_context yield
+)
+{
+    namespace beast = boost::beast;
+    namespace http = beast::http;
+
+    auto const executor = boost::asio::get_associated_executor(yield);
+    beast::error_code ec;
+    boost::asio::ip::tcp::resolver resolver{executor};
+    beast::tcp_stream stream{executor};
+
+    auto const results = resolver.async_resolve(host, port, yield[ec]);
+    if (ec)
+        return std::nullopt;
+
+    stream.expires_after(std::chrono::seconds(10));
+    stream.async_connect(results, yield[ec]);
+    if (ec)
+        return std::nullopt;
+
+    http::request<http::string_body> req{http::verb::get, "/metrics", 11};
+    req.set(http::field::host, host);
+    if (adminPassword)
+        req.set(http::field::authorization, passwordHeader(*adminPassword));
+
+    http::async_write(stream, req, yield[ec]);
+    if (ec)
+        return std::nullopt;
+
+    beast::flat_buffer buffer;
+    http::response<http::string_body> res;
+    http::async_read(stream, buffer, res, yield[ec]);
+    if (ec || res.result() != http::status::ok)
+        return std::nullopt;
+
+    return parse(res.body());
+}
+
+std::map<std::string, double>
+MetricsSnapshot::deltaSince(MetricsSnapshot const& before) const
+{
+    std::map<std::string, double> delta;
+    for (auto const& [series, value] : values_) {
+        auto const it = before.values_.find(series);
+        auto const diff = value - (it == before.values_.end() ? 0.0 : it->second);
+        if (diff != 0.0)
+            delta[series] = diff;
+    }
+    return delta;
+}
+
+}  // namespace loadgen
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/spawn.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace loadgen {
+
+/**
+ * @brief The values of all the series exposed by the server on `/metrics` at one point in time.
+ *
+ * Taking one snapshot before and one after a run shows what the server did during the run: requests per method as it
+ * counted them, cache hits, database reads, errors and so on.
+ */
+class MetricsSnapshot {
+    std::map<std::string, double> values_;
+
+public:
+    /**
+     * @brief Parse the Prometheus text exposition format.
+     *
+     * Comments and malformed lines are ignored. Series are keyed by their name followed by their labels exactly as
+     * written by the server, e.g. `rpc_method_total_number{method="tx",status="finished"}`.
+     *
+     * @param text The body of a `/metrics` response
+     * @return The snapshot
+     */
+    static MetricsSnapshot
+    parse(std::string_view text);
+
+    /**
+     * @brief Fetch the metrics of a running server.
+     *
+     * @param host The host of the server
+     * @param port The port of the server
+     * @param adminPassword The admin password of the server; nullopt if admin rights are granted by IP
+     * @param yield The coroutine context
+     * @return The snapshot; nullopt if the server could not be reached or did not return metrics
+     */
+    static std::optional<MetricsSnapshot>
+    scrape(
+        std::string const& host,
+        std::string const& port,
+        std::optional<std::string> const& adminPassword,
+        boost::asio::yield_context yield
+    );
+
+    /**
+     * @brief Compute how much each series changed since an earlier snapshot.
+     *
+     * @param before The earlier snapshot
+     * @return The non-zero differences; series missing from the earlier snapshot are compared against zero
+     */
+    [[nodiscard]] std::map<std::string, double>
+    deltaSince(MetricsSnapshot const& before) const;
+
+    /**
+     * @return All the values of the snapshot
+     */
+    [[nodiscard]] std::map<std::string, double> const&
+    values() const
+    {
+        return values_;
+    }
+};
+
+}  // namespace loadgen
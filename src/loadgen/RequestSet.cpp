@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/RequestSet.h>
+
+#include <boost/json.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace loadgen {
+
+namespace {
+
+bool
+isSubscription(std::string const& method)
+{
+    return method == "subscribe" || method == "unsubscribe";
+}
+
+std::map<std::string, std::size_t>
+parseMix(std::string const& mix)
+{
+    std::map<std::string, std::size_t> weights;
+    std::size_t pos = 0;
+    while (pos < mix.size()) {
+        auto const end = std::min(mix.find(',', pos), mix.size());
+        auto const item = mix.substr(pos, end - pos);
+        pos = end + 1;
+
+        auto const eq = item.find('=');
+        if (eq == std::string::npos || eq == 0 || eq + 1 == item.size())
+            throw std::runtime_error(fmt::format("Malformed mix entry '{}', expected method=weight", item));
+
+        try {
+            weights[item.substr(0, eq)] = std::stoul(item.substr(eq + 1));
+        } catch (std::exception const&) {
+            throw std::runtime_error(fmt::format("Malformed weight in mix entry '{}'", item));
+        }
+    }
+    return weights;
+}
+
+}  // namespace
+
+Request
+RequestSet::parseRequest(std::string const& line)
+{
+    boost::json::value parsed;
+    try {
+        parsed = boost::json::parse(line);
+    } catch (std::exception const& e) {
+        throw std::runtime_error(fmt::format("Invalid json: {}", e.what()));
+    }
+
+    if (!parsed.is_object())
+        throw std::runtime_error("Request is not an object");
+
+    auto const& object = parsed.as_object();
+    std::string method;
+    boost::json::object params;
+
+    if (object.contains("method") && object.at("method").is_string()) {
+        method = object.at("method").as_string().c_str();
+        if (object.contains("params")) {
+            auto const& array = object.at("params");
+            if (!array.is_array() || array.as_array().size() > 1 ||
+                (!array.as_array().empty() && !array.as_array().at(0).is_object()))
+                throw std::runtime_error("params must be an array holding a single object");
+
+            if (!array.as_array().empty())
+                params = array.as_array().at(0).as_object();
+        }
+    } else if (object.contains("command") && object.at("command").is_string()) {
+        method = object.at("command").as_string().c_str();
+        params = object;
+        params.erase("command");
+        params.erase("id");
+    } else {
+        throw std::runtime_error("Request has neither a method nor a command");
+    }
+
+    auto http = boost::json::object{{"method", method}, {"params", boost::json::array{params}}};
+    auto ws = params;
+    ws["command"] = method;
+
+    return {method, boost::json::serialize(http), boost::json::serialize(ws)};
+}
+
+RequestSet
+RequestSet::parse(std::istream& input, std::string const& mix)
+{
+    RequestSet set;
+    std::string line;
+    std::size_t lineNumber = 0;
+
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
+        try {
+            auto request = parseRequest(line);
+            if (!isSubscription(request.method))
+                set.requests_.push_back(std::move(request));
+        } catch (std::runtime_error const& e) {
+            throw std::runtime_error(fmt::format("Line {}: {}", lineNumber, e.what()));
+        }
+    }
+
+    if (mix.empty()) {
+        auto& all = set.methods_.emplace_back(MethodRequests{1, {}});
+        for (std::size_t i = 0; i < set.requests_.size(); ++i)
+            all.requests.push_back(i);
+    } else {
+        for (auto const& [method, weight] : parseMix(mix)) {
+            if (weight == 0)
+                continue;
+
+            MethodRequests methodRequests{weight, {}};
+            for (std::size_t i = 0; i < set.requests_.size(); ++i) {
+                if (set.requests_[i].method == method)
+                    methodRequests.requests.push_back(i);
+            }
+
+            if (methodRequests.requests.empty())
+                throw std::runtime_error(fmt::format("Mix refers to method '{}' which has no requests", method));
+
+            set.methods_.push_back(std::move(methodRequests));
+        }
+    }
+
+    if (set.methods_.empty() || set.methods_.front().requests.empty())
+        throw std::runtime_error("No requests to replay");
+
+    // smooth weighted round-robin over one period of the weights
+    std::size_t totalWeight = 0;
+    for (auto const& method : set.methods_)
+        totalWeight += method.weight;
+
+    std::vector<std::int64_t> current(set.methods_.size(), 0);
+    std::vector<std::size_t> occurrences(set.methods_.size(), 0);
+    for (std::size_t slot = 0; slot < totalWeight; ++slot) {
+        std::size_t best = 0;
+        for (std::size_t i = 0; i < set.methods_.size(); ++i) {
+            current[i] += static_cast<std::int64_t>(set.methods_[i].weight);
+            if (current[i] > current[best])
+                best = i;
+        }
+        current[best] -= static_cast<std::int64_t>(totalWeight);
+        set.schedule_.push_back({best, occurrences[best]++});
+    }
+
+    return set;
+}
+
+Request const&
+RequestSet::next(std::uint64_t k) const
+{
+    auto const period = k / schedule_.size();
+    auto const& slot = schedule_[k % schedule_.size()];
+    auto const& method = methods_[slot.method];
+    auto const index = (period * method.weight + slot.occurrence) % method.requests.size();
+
+    return requests_[method.requests[index]];
+}
+
+std::size_t
+RequestSet::size() const
+{
+    std::size_t size = 0;
+    for (auto const& method : methods_)
+        size += method.requests.size();
+    return size;
+}
+
+}  // namespace loadgen
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace loadgen {
+
+/**
+ * @brief A single request to replay, serialized once for both transports.
+ */
+struct Request {
+    std::string method;
+    std::string httpBody;
+    std::string wsBody;
+};
+
+/**
+ * @brief The requests replayed by the load generator and the order they are sent in.
+ *
+ * Each line of the input is a JSON object in either the HTTP form (`{"method": ..., "params": [{...}]}`) or the
+ * websocket form (`{"command": ..., ...}`). Empty lines are ignored. Subscriptions are skipped as they open streams
+ * instead of producing a single response.
+ *
+ * Without a mix the requests are replayed in file order. A mix such as `account_info=3,tx=1` restricts the replay to
+ * the given methods and interleaves them by weight using smooth weighted round-robin, cycling through the requests of
+ * each method in file order. The schedule is fully deterministic so two runs against different builds send exactly
+ * the same sequence of requests.
+ */
+class RequestSet {
+    struct Slot {
+        std::size_t method;
+        std::size_t occurrence;
+    };
+
+    struct MethodRequests {
+        std::size_t weight;
+        std::vector<std::size_t> requests;
+    };
+
+    std::vector<Request> requests_;
+    std::vector<MethodRequests> methods_;
+    std::vector<Slot> schedule_;
+
+public:
+    /**
+     * @brief Parse the requests and build the schedule.
+     *
+     * @param input The stream to read jsonl requests from
+     * @param mix The method mix; empty to replay in file order
+     * @return The parsed request set
+     * @throws std::runtime_error if a line is not a valid request, the mix is malformed or no request is left
+     */
+    static RequestSet
+    parse(std::istream& input, std::string const& mix = "");
+
+    /**
+     * @brief Get the request to send as the k-th request of the run.
+     *
+     * @param k The zero-based index of the request in the run
+     * @return The request to send
+     */
+    [[nodiscard]] Request const&
+    next(std::uint64_t k) const;
+
+    /**
+     * @return The number of requests taking part in the replay
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * @brief Parse a single line of the input.
+     *
+     * @param line The line to parse
+     * @return The request
+     * @throws std::runtime_error if the line is not a valid request
+     */
+    static Request
+    parseRequest(std::string const& line);
+};
+
+}  // namespace loadgen
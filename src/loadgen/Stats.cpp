@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/Stats.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace loadgen {
+
+namespace {
+
+boost::json::object
+summarize(std::vector<std::uint64_t> latencies, std::uint64_t errors, std::chrono::microseconds elapsed)
+{
+    std::sort(latencies.begin(), latencies.end());
+
+    auto const seconds = std::chrono::duration<double>(elapsed).count();
+    auto const throughput = seconds > 0 ? static_cast<double>(latencies.size()) / seconds : 0.0;
+
+    return {
+        {"requests", latencies.size()},
+        {"errors", errors},
+        {"throughput_rps", throughput},
+        {"latency_us",
+         boost::json::object{
+             {"p50", Stats::percentile(latencies, 50)},
+             {"p90", Stats::percentile(latencies, 90)},
+             {"p99", Stats::percentile(latencies, 99)},
+             {"max", latencies.empty() ? std::uint64_t{0} : latencies.back()},
+         }},
+    };
+}
+
+}  // namespace
+
+void
+Stats::record(std::string const& method, std::chrono::microseconds latency, std::optional<std::string> const& error)
+{
+    auto& stats = methods_[method];
+    stats.latenciesUs.push_back(static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0)));
+    if (error)
+        ++stats.errors[*error];
+}
+
+void
+Stats::merge(Stats const& other)
+{
+    for (auto const& [method, stats] : other.methods_) {
+        auto& mine = methods_[method];
+        mine.latenciesUs.insert(mine.latenciesUs.end(), stats.latenciesUs.begin(), stats.latenciesUs.end());
+        for (auto const& [code, count] : stats.errors)
+            mine.errors[code] += count;
+    }
+}
+
+std::uint64_t
+Stats::count() const
+{
+    std::uint64_t count = 0;
+    for (auto const& [_, stats] : methods_)
+        count += stats.latenciesUs.size();
+    return count;
+}
+
+boost::json::object
+Stats::report(std::chrono::microseconds elapsed) const
+{
+    std::vector<std::uint64_t> allLatencies;
+    std::map<std::string, std::uint64_t> allErrors;
+    std::uint64_t totalErrors = 0;
+    boost::json::object methods;
+
+    for (auto const& [method, stats] : methods_) {
+        std::uint64_t errors = 0;
+        boost::json::object codes;
+        for (auto const& [code, count] : stats.errors) {
+            errors += count;
+            allErrors[code] += count;
+            codes[code] = count;
+        }
+        totalErrors += errors;
+        allLatencies.insert(allLatencies.end(), stats.latenciesUs.begin(), stats.latenciesUs.end());
+
+        auto summary = summarize(stats.latenciesUs, errors, elapsed);
+        summary["error_codes"] = std::move(codes);
+        methods[method] = std::move(summary);
+    }
+
+    auto total = summarize(std::move(allLatencies), totalErrors, elapsed);
+    boost::json::object codes;
+    for (auto const& [code, count] : allErrors)
+        codes[code] = count;
+    total["error_codes"] = std::move(codes);
+
+    return {
+        {"duration_us", elapsed.count()},
+        {"total", std::move(total)},
+        {"methods", std::move(methods)},
+    };
+}
+
+std::uint64_t
+Stats::percentile(std::vector<std::uint64_t> const& sorted, double percentile)
+{
+    if (sorted.empty())
+        return 0;
+
+    auto const rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+}  // namespace loadgen
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loadgen {
+
+/**
+ * @brief Latencies and error codes of the requests sent by the load generator, grouped by method.
+ *
+ * Not thread safe: every worker records into its own instance and the instances are merged once the run is over, so
+ * the measurement itself does not add contention between workers.
+ */
+class Stats {
+    struct MethodStats {
+        std::vector<std::uint64_t> latenciesUs;
+        std::map<std::string, std::uint64_t> errors;
+    };
+
+    std::map<std::string, MethodStats> methods_;
+
+public:
+    /**
+     * @brief Record a completed request.
+     *
+     * @param method The method of the request
+     * @param latency The time from the intended start of the request to the end of its response
+     * @param error The error code of the response; nullopt if the request succeeded
+     */
+    void
+    record(std::string const& method, std::chrono::microseconds latency, std::optional<std::string> const& error);
+
+    /**
+     * @brief Add all the requests recorded by another instance.
+     *
+     * @param other The instance to merge in
+     */
+    void
+    merge(Stats const& other);
+
+    /**
+     * @return The total number of recorded requests
+     */
+    [[nodiscard]] std::uint64_t
+    count() const;
+
+    /**
+     * @brief Build the report of the run.
+     *
+     * @param elapsed The duration of the run, used to compute throughput
+     * @return JSON object with totals and per-method request counts, throughput, latency percentiles and error codes
+     */
+    [[nodiscard]] boost::json::object
+    report(std::chrono::microseconds elapsed) const;
+
+    /**
+     * @brief Get a percentile using the nearest-rank method.
+     *
+     * @param sorted The values, sorted in ascending order
+     * @param percentile The percentile within [0, 100]
+     * @return The value at the given percentile; 0 if there are no values
+     */
+    static std::uint64_t
+    percentile(std::vector<std::uint64_t> const& sorted, double percentile);
+};
+
+}  // namespace loadgen
@@ -25,7 +25,9 @@
 #include <rpc/RPCEngine.h>
 #include <rpc/common/impl/HandlerProvider.h>
 #include <util/config/Config.h>
+#include <util/profiling/ProfilingService.h>
 #include <util/prometheus/Prometheus.h>
+#include <util/trace/TraceService.h>
 #include <web/RPCServerHandler.h>
 #include <web/Server.h>
 
@@ -158,6 +160,8 @@ try {
     LOG(LogService::info()) << "Clio version: " << Build::getClioFullVersionString();
 
     PrometheusService::init(config);
+    TraceService::init(config);
+    ProfilingService::init(config);
 
     auto const threads = config.valueOr("io_threads", 2);
     if (threads <= 0) {
@@ -208,13 +212,18 @@ try {
     );
     auto ctx = parseCerts(config);
     auto const ctxRef = ctx ? std::optional<std::reference_wrapper<ssl::context>>{ctx.value()} : std::nullopt;
-    auto const httpServer = web::make_HttpServer(config, ioc, ctxRef, dosGuard, handler);
+
+    // Optional per-core io_contexts owning the connections of the web server; stopped before everything they use
+    auto const serverShards = web::make_ServerShards(config);
+    auto const httpServer = web::make_HttpServer(config, ioc, ctxRef, dosGuard, handler, serverShards);
 
     // Blocks until stopped.
     // When stopped, shared_ptrs fall out of scope
     // Calls destructors on all resources, and destructs in order
     start(ioc, threads);
 
+    ProfilingService::shutdown();
+    TraceService::shutdown();
     return EXIT_SUCCESS;
 } catch (std::exception const& e) {
     LOG(LogService::fatal()) << "Exit on exception: " << e.what();
@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <rpc/BookChangesCache.h>
+
+#include <mutex>
+
+namespace rpc {
+
+BookChangesCache::BookChangesCache(std::size_t capacity) : ring_(capacity)
+{
+}
+
+BookChangesCache::ChangesPtr
+BookChangesCache::put(std::uint32_t seq, std::vector<BookChange> changes)
+{
+    auto ptr = std::make_shared<std::vector<BookChange> const>(std::move(changes));
+    if (ring_.empty())
+        return ptr;
+
+    std::scoped_lock const lck{mtx_};
+    ring_[seq % ring_.size()] = {seq, ptr};
+    return ptr;
+}
+
+BookChangesCache::ChangesPtr
+BookChangesCache::get(std::uint32_t seq) const
+{
+    if (ring_.empty())
+        return nullptr;
+
+    std::shared_lock const lck{mtx_};
+    auto const& [storedSeq, changes] = ring_[seq % ring_.size()];
+    if (storedSeq != seq)
+        return nullptr;
+
+    return changes;
+}
+
+std::size_t
+BookChangesCache::capacity() const
+{
+    return ring_.size();
+}
+
+}  // namespace rpc
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <rpc/BookChangesHelper.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+
+/**
+ * @brief Keeps the book changes of the most recently published ledgers.
+ *
+ * The changes of a ledger are computed once when it is published and then shared by the book_changes stream and the
+ * book_changes handler. Ledger `seq` lives in slot `seq % capacity`, so a ledger is evicted when the ledger `capacity`
+ * sequences after it is published.
+ */
+class BookChangesCache {
+public:
+    using ChangesPtr = std::shared_ptr<std::vector<BookChange> const>;
+
+private:
+    mutable std::shared_mutex mtx_;
+    std::vector<std::pair<std::uint32_t, ChangesPtr>> ring_;
+
+public:
+    /**
+     * @brief Create a new cache.
+     *
+     * @param capacity The number of ledgers to keep; 0 disables the cache
+     */
+    explicit BookChangesCache(std::size_t capacity);
+
+    /**
+     * @brief Store the book changes of a ledger.
+     *
+     * @param seq The sequence of the ledger
+     * @param changes The book changes of the ledger
+     * @return The stored changes
+     */
+    ChangesPtr
+    put(std::uint32_t seq, std::vector<BookChange> changes);
+
+    /**
+     * @brief Fetch the book changes of a ledger.
+     *
+     * @param seq The sequence of the ledger
+     * @return The book changes if the ledger is cached; nullptr otherwise
+     */
+    [[nodiscard]] ChangesPtr
+    get(std::uint32_t seq) const;
+
+    /**
+     * @return The number of ledgers the cache can hold
+     */
+    [[nodiscard]] std::size_t
+    capacity() const;
+};
+
+}  // namespace rpc
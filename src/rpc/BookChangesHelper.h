@@ -22,6 +22,8 @@
 
 #include <rpc/RPCHelpers.h>
 
+#include <map>
+#include <memory>
 #include <set>
 
 namespace rpc {
@@ -57,6 +59,46 @@ public:
         return HandlerImpl{}(transactions);
     }
 
+    /**
+     * @brief Merges the book changes of consecutive ledgers into the book changes of the whole span.
+     *
+     * @param ledgers The book changes of each ledger, in ledger order
+     * @return std::vector<BookChange> Book changes of the span
+     */
+    [[nodiscard]] static std::vector<BookChange>
+    aggregate(std::vector<std::shared_ptr<std::vector<BookChange> const>> const& ledgers)
+    {
+        // same key and therefore the same order as the tally of a single ledger
+        std::map<std::string, BookChange> tally;
+        for (auto const& changes : ledgers) {
+            for (auto const& change : *changes) {
+                auto const key = to_string(change.sideAVolume.issue()) + '|' + to_string(change.sideBVolume.issue());
+                auto const [it, inserted] = tally.try_emplace(key, change);
+                if (inserted)
+                    continue;
+
+                auto& entry = it->second;
+                entry.sideAVolume += change.sideAVolume;
+                entry.sideBVolume += change.sideBVolume;
+
+                if (entry.highRate < change.highRate)
+                    entry.highRate = change.highRate;
+
+                if (entry.lowRate > change.lowRate)
+                    entry.lowRate = change.lowRate;
+
+                entry.closeRate = change.closeRate;
+            }
+        }
+
+        std::vector<BookChange> changes;
+        changes.reserve(tally.size());
+        for (auto& [_, change] : tally)
+            changes.push_back(std::move(change));
+
+        return changes;
+    }
+
 private:
     class HandlerImpl final {
         std::map<std::string, BookChange> tally_ = {};
@@ -231,12 +273,12 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, BookChange const
 }
 
 /**
- * @brief Computes all book changes for the given ledger header and transactions.
+ * @brief Builds the book_changes stream message of a ledger.
  *
  * @param lgrInfo The ledger header
- * @param transactions The vector of transactions with heir metadata
+ * @param bookChanges The book changes of the ledger, as computed by @ref BookChanges::compute
  */
 [[nodiscard]] boost::json::object
-computeBookChanges(ripple::LedgerHeader const& lgrInfo, std::vector<data::TransactionAndMetadata> const& transactions);
+computeBookChanges(ripple::LedgerHeader const& lgrInfo, std::vector<BookChange> const& bookChanges);
 
 }  // namespace rpc
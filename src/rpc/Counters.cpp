@@ -101,6 +101,21 @@ Counters::Counters(WorkQueue const& wq)
           Labels({Label{"error_type", "internal_error"}}),
           "Total number of internal errors"
       ))
+    , batchCounter_(PrometheusService::counterInt(
+          "rpc_batch_total_number",
+          Labels(),
+          "Total number of received batch requests"
+      ))
+    , batchRequestsCounter_(PrometheusService::counterInt(
+          "rpc_batch_requests_total_number",
+          Labels(),
+          "Total number of requests received in batches"
+      ))
+    , batchDurationCounter_(PrometheusService::counterInt(
+          "rpc_batch_duration_us",
+          Labels(),
+          "Total duration of batch requests"
+      ))
     , workQueue_(std::cref(wq))
     , startupTime_{std::chrono::system_clock::now()}
 {
@@ -180,6 +195,14 @@ Counters::onInternalError()
     ++internalErrorCounter_.get();
 }
 
+void
+Counters::onBatch(std::size_t batchSize, std::chrono::microseconds const& batchDuration)
+{
+    ++batchCounter_.get();
+    batchRequestsCounter_.get() += batchSize;
+    batchDurationCounter_.get() += batchDuration.count();
+}
+
 std::chrono::seconds
 Counters::uptime() const
 {
@@ -214,6 +237,10 @@ Counters::report() const
     obj["unknown_command_errors"] = std::to_string(unknownCommandCounter_.get().value());
     obj["internal_errors"] = std::to_string(internalErrorCounter_.get().value());
 
+    obj["batches"] = std::to_string(batchCounter_.get().value());
+    obj["batch_requests"] = std::to_string(batchRequestsCounter_.get().value());
+    obj["batch_duration_us"] = std::to_string(batchDurationCounter_.get().value());
+
     obj["work_queue"] = workQueue_.get().report();
 
     return obj;
@@ -64,6 +64,10 @@ class Counters {
     CounterType unknownCommandCounter_;
     CounterType internalErrorCounter_;
 
+    CounterType batchCounter_;
+    CounterType batchRequestsCounter_;
+    CounterType batchDurationCounter_;
+
     std::reference_wrapper<WorkQueue const> workQueue_;
     std::chrono::time_point<std::chrono::system_clock> startupTime_;
 
@@ -147,6 +151,15 @@ public:
     void
     onInternalError();
 
+    /**
+     * @brief Increments the batch counters.
+     *
+     * @param batchSize The number of requests in the batch
+     * @param batchDuration The time it took to execute the whole batch
+     */
+    void
+    onBatch(std::size_t batchSize, std::chrono::microseconds const& batchDuration);
+
     /** @return Uptime of this instance in seconds. */
     std::chrono::seconds
     uptime() const;
@@ -30,6 +30,7 @@
 #include <util/Taggable.h>
 #include <util/config/Config.h>
 #include <util/log/Logger.h>
+#include <util/trace/Trace.h>
 #include <web/Context.h>
 #include <web/DOSGuard.h>
 
@@ -66,7 +67,7 @@ class RPCEngine {
     std::shared_ptr<BackendInterface> backend_;
     std::shared_ptr<feed::SubscriptionManager> subscriptions_;
     std::shared_ptr<etl::LoadBalancer> balancer_;
-    std::reference_wrapper<web::DOSGuard const> dosGuard_;
+    std::reference_wrapper<web::DOSGuard> dosGuard_;
     std::reference_wrapper<WorkQueue> workQueue_;
     std::reference_wrapper<Counters> counters_;
 
@@ -79,7 +80,7 @@ public:
         std::shared_ptr<BackendInterface> const& backend,
         std::shared_ptr<feed::SubscriptionManager> const& subscriptions,
         std::shared_ptr<etl::LoadBalancer> const& balancer,
-        web::DOSGuard const& dosGuard,
+        web::DOSGuard& dosGuard,
         WorkQueue& workQueue,
         Counters& counters,
         std::shared_ptr<HandlerProvider const> const& handlerProvider
@@ -87,7 +88,7 @@ public:
         : backend_{backend}
         , subscriptions_{subscriptions}
         , balancer_{balancer}
-        , dosGuard_{std::cref(dosGuard)}
+        , dosGuard_{std::ref(dosGuard)}
         , workQueue_{std::ref(workQueue)}
         , counters_{std::ref(counters)}
         , handlerProvider_{handlerProvider}
@@ -100,7 +101,7 @@ public:
         std::shared_ptr<BackendInterface> const& backend,
         std::shared_ptr<feed::SubscriptionManager> const& subscriptions,
         std::shared_ptr<etl::LoadBalancer> const& balancer,
-        web::DOSGuard const& dosGuard,
+        web::DOSGuard& dosGuard,
         WorkQueue& workQueue,
         Counters& counters,
         std::shared_ptr<HandlerProvider const> const& handlerProvider
@@ -114,51 +115,21 @@ public:
     /**
      * @brief Main request processor routine.
      *
-     * @param ctx The @ref Context of the request
+     * @param ctx The @ref Context of the request; its params are moved into the handler that executes the request
      * @return A result which can be an error status or a valid JSON response
      */
     Result
-    buildResponse(web::Context const& ctx)
+    buildResponse(web::Context& ctx)
     {
-        if (forwardingProxy_.shouldForward(ctx))
-            return forwardingProxy_.forward(ctx);
-
-        if (backend_->isTooBusy()) {
-            LOG(log_.error()) << "Database is too busy. Rejecting request";
-            notifyTooBusy();  // TODO: should we add ctx.method if we have it?
-            return Status{RippledError::rpcTOO_BUSY};
-        }
-
-        auto const method = handlerProvider_->getHandler(ctx.method);
-        if (!method) {
-            notifyUnknownCommand();
-            return Status{RippledError::rpcUNKNOWN_COMMAND};
-        }
+        util::trace::Span span{"rpc.handle"};
+        if (span.isRecording())
+            span.setAttribute("rpc.method", ctx.method);
 
-        try {
-            LOG(perfLog_.debug()) << ctx.tag() << " start executing rpc `" << ctx.method << '`';
-
-            auto const context = Context{ctx.yield, ctx.session, ctx.isAdmin, ctx.clientIp, ctx.apiVersion};
-            auto const v = (*method).process(ctx.params, context);
+        auto result = doBuildResponse(ctx);
+        if (std::holds_alternative<Status>(result))
+            span.setError();
 
-            LOG(perfLog_.debug()) << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
-
-            if (v)
-                return v->as_object();
-
-            notifyErrored(ctx.method);
-            return Status{v.error()};
-        } catch (data::DatabaseTimeout const& t) {
-            LOG(log_.error()) << "Database timeout";
-            notifyTooBusy();
-
-            return Status{RippledError::rpcTOO_BUSY};
-        } catch (std::exception const& ex) {
-            LOG(log_.error()) << ctx.tag() << "Caught exception: " << ex.what();
-            notifyInternalError();
-
-            return Status{RippledError::rpcINTERNAL};
-        }
+        return result;
     }
 
     /**
@@ -175,6 +146,37 @@ public:
         return workQueue_.get().postCoro(std::forward<FnType>(func), dosGuard_.get().isWhiteListed(ip));
     }
 
+    /**
+     * @brief Account the requests of a batch against the DOS guard.
+     *
+     * The message carrying the batch is already counted as one request by the session that received it, so only the
+     * remaining requests of the batch are added here.
+     *
+     * @param ip The ip address of the client that sent the batch
+     * @param batchSize The number of requests in the batch
+     * @return true if the client is still within its limits; false if the batch should be rejected
+     */
+    bool
+    requestBatch(std::string const& ip, std::size_t batchSize)
+    {
+        if (batchSize <= 1)
+            return dosGuard_.get().isOk(ip);
+
+        return dosGuard_.get().request(ip, static_cast<std::uint32_t>(batchSize - 1));
+    }
+
+    /**
+     * @brief Notify the system that a batch of requests was executed.
+     *
+     * @param batchSize The number of requests in the batch
+     * @param duration The time it took to execute the whole batch
+     */
+    void
+    notifyBatch(std::size_t batchSize, std::chrono::microseconds const& duration)
+    {
+        counters_.get().onBatch(batchSize, duration);
+    }
+
     /**
      * @brief Notify the system that specified method was executed.
      *
@@ -265,6 +267,63 @@ public:
     }
 
 private:
+    Result
+    doBuildResponse(web::Context& ctx)
+    {
+        if (forwardingProxy_.shouldForward(ctx)) {
+            util::trace::Span const span{"rpc.forward"};
+            return forwardingProxy_.forward(ctx);
+        }
+
+        if (backend_->isTooBusy()) {
+            LOG(log_.error()) << "Database is too busy. Rejecting request";
+            notifyTooBusy();  // TODO: should we add ctx.method if we have it?
+            return Status{RippledError::rpcTOO_BUSY};
+        }
+
+        auto const* method = handlerProvider_->getHandler(ctx.method);
+        if (method == nullptr) {
+            notifyUnknownCommand();
+            return Status{RippledError::rpcUNKNOWN_COMMAND};
+        }
+
+        try {
+            LOG(perfLog_.debug()) << ctx.tag() << " start executing rpc `" << ctx.method << '`';
+
+            auto const context = Context{
+                ctx.yield,
+                ctx.session,
+                ctx.isAdmin,
+                ctx.clientIp,
+                ctx.apiVersion,
+                [this, ip = ctx.clientIp](std::uint32_t numRequests) {
+                    return dosGuard_.get().request(ip, numRequests);
+                },
+                ctx.params.storage()
+            };
+            // the handler takes the params over, together with the arena of the request they live on
+            auto v = method->process(boost::json::value(std::move(ctx.params)), context);
+
+            LOG(perfLog_.debug()) << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
+
+            if (v)
+                return std::move(v->as_object());
+
+            notifyErrored(ctx.method);
+            return Status{v.error()};
+        } catch (data::DatabaseTimeout const& t) {
+            LOG(log_.error()) << "Database timeout";
+            notifyTooBusy();
+
+            return Status{RippledError::rpcTOO_BUSY};
+        } catch (std::exception const& ex) {
+            LOG(log_.error()) << ctx.tag() << "Caught exception: " << ex.what();
+            notifyInternalError();
+
+            return Status{RippledError::rpcINTERNAL};
+        }
+    }
+
     bool
     validHandler(std::string const& method) const
     {
@@ -21,8 +21,8 @@
 #include <data/DBHelpers.h>
 #include <rpc/Errors.h>
 #include <rpc/RPCHelpers.h>
-#include <util/Profiler.h>
 #include <util/log/Logger.h>
+#include <util/profiling/Profiling.h>
 
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/protocol/NFTSyntheticSerializer.h>
@@ -559,7 +559,9 @@ traverseOwnedNodes(
     static std::uint32_t constexpr MIN_NODES = 2048;
     keys.reserve(std::min(MIN_NODES, limit));
 
-    auto start = std::chrono::system_clock::now();
+    static util::profiling::Zone const directoriesZone{"rpc.owned_objects.directories"};
+    static util::profiling::Zone const objectsZone{"rpc.owned_objects.objects"};
+    auto const start = util::profiling::now();
 
     // If startAfter is not zero try jumping to that page using the hint
     if (hexMarker.isNonZero()) {
@@ -644,15 +646,18 @@ traverseOwnedNodes(
             currentPage = uNodeNext;
         }
     }
-    auto end = std::chrono::system_clock::now();
+    auto const directoriesTime = util::profiling::toDuration(util::profiling::now() - start);
+    util::profiling::record(directoriesZone, directoriesTime);
 
     LOG(gLog.debug()) << fmt::format(
         "Time loading owned directories: {} milliseconds, entries size: {}",
-        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(directoriesTime).count(),
         keys.size()
     );
 
-    auto [objects, timeDiff] = util::timed([&]() { return backend.fetchLedgerObjects(keys, sequence, yield); });
+    auto [objects, timeDiff] = util::profiling::timed(objectsZone, [&]() {
+        return backend.fetchLedgerObjects(keys, sequence, yield);
+    });
 
     LOG(gLog.debug()) << "Time loading owned entries: " << timeDiff << " milliseconds";
 
@@ -1002,10 +1007,11 @@ postProcessOrderBook(
     ripple::AccountID const& takerID,
     data::BackendInterface const& backend,
     std::uint32_t const ledgerSequence,
-    boost::asio::yield_context yield
+    boost::asio::yield_context yield,
+    boost::json::storage_ptr storage
 )
 {
-    boost::json::array jsonOffers;
+    boost::json::array jsonOffers(std::move(storage));
 
     std::map<ripple::AccountID, ripple::STAmount> umBalance;
 
@@ -1092,7 +1098,7 @@ postProcessOrderBook(
 
             offerJson["quality"] = dirRate.getText();
 
-            jsonOffers.push_back(offerJson);
+            jsonOffers.push_back(std::move(offerJson));
         } catch (std::exception const& e) {
             LOG(gLog.error()) << "caught exception: " << e.what();
         }
@@ -225,7 +225,8 @@ postProcessOrderBook(
     ripple::AccountID const& takerID,
     data::BackendInterface const& backend,
     std::uint32_t ledgerSequence,
-    boost::asio::yield_context yield
+    boost::asio::yield_context yield,
+    boost::json::storage_ptr storage = {}
 );
 
 std::variant<Status, ripple::Book>
@@ -293,7 +294,7 @@ decodeCTID(T const ctid) noexcept
 
 template <class T>
 void
-logDuration(web::Context const& ctx, T const& dur)
+logDuration(web::Context const& ctx, boost::json::object const& request, T const& dur)
 {
     using boost::json::serialize;
 
@@ -303,7 +304,7 @@ logDuration(web::Context const& ctx, T const& dur)
     auto const millis = std::chrono::duration_cast<std::chrono::milliseconds>(dur).count();
     auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(dur).count();
     auto const msg = fmt::format(
-        "Request processing duration = {} milliseconds. request = {}", millis, serialize(util::removeSecret(ctx.params))
+        "Request processing duration = {} milliseconds. request = {}", millis, serialize(util::removeSecret(request))
     );
 
     if (seconds > DURATION_ERROR_THRESHOLD_SECONDS) {
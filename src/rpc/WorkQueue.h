@@ -22,6 +22,8 @@
 #include <util/config/Config.h>
 #include <util/log/Logger.h>
 #include <util/prometheus/Prometheus.h>
+#include <util/trace/ContextExecutor.h>
+#include <util/trace/Trace.h>
 
 #include <boost/asio.hpp>
 #include <boost/asio/spawn.hpp>
@@ -101,9 +103,11 @@ public:
         // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job at the front
         // of the job queue.
         boost::asio::spawn(
-            ioc_,
-            [this, func = std::forward<FnType>(func), start = std::chrono::system_clock::now()](auto yield) mutable {
-                auto const run = std::chrono::system_clock::now();
+            util::trace::make_ContextExecutor(ioc_.get_executor(), util::trace::current()),
+            [this, func = std::forward<FnType>(func), start = std::chrono::steady_clock::now()](auto yield) mutable {
+                util::trace::Span{"queue.wait", start}.finish();
+
+                auto const run = std::chrono::steady_clock::now();
                 auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - start).count();
 
                 ++queued_.get();
@@ -67,14 +67,16 @@ public:
     /**
      * @brief Process incoming JSON by the stored handler
      *
+     * The value is taken by value so that the spec can modify it in place; move it in if it's not needed afterwards.
+     *
      * @param value The JSON to process
      * @param ctx Request context
      * @return JSON result or @ref Status on error
      */
     [[nodiscard]] ReturnType
-    process(boost::json::value const& value, Context const& ctx) const
+    process(boost::json::value value, Context const& ctx) const
     {
-        return pimpl_->process(value, ctx);
+        return pimpl_->process(std::move(value), ctx);
     }
 
 private:
@@ -82,7 +84,7 @@ private:
         virtual ~Concept() = default;
 
         [[nodiscard]] virtual ReturnType
-        process(boost::json::value const& value, Context const& ctx) const = 0;
+        process(boost::json::value&& value, Context const& ctx) const = 0;
 
         [[nodiscard]] virtual std::unique_ptr<Concept>
         clone() const = 0;
@@ -98,9 +100,9 @@ private:
         }
 
         [[nodiscard]] ReturnType
-        process(boost::json::value const& value, Context const& ctx) const override
+        process(boost::json::value&& value, Context const& ctx) const override
         {
-            return processor(handler, value, ctx);
+            return processor(handler, std::move(value), ctx);
         }
 
         [[nodiscard]] std::unique_ptr<Concept>
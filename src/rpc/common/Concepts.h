@@ -25,6 +25,8 @@
 #include <boost/json/value_to.hpp>
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace rpc {
 
@@ -50,6 +52,38 @@ concept SomeModifier = requires(T a, boost::json::value lval) {
     } -> std::same_as<MaybeError>;
 };
 
+/**
+ * @brief Specifies a requirement that can also verify the value of its field directly.
+ *
+ * Used by @ref rpc::StaticRpcSpec, which looks every field up only once.
+ */
+template <typename T>
+concept SomeFieldRequirement = SomeRequirement<T> and requires(T a, boost::json::value lval) {
+    {
+        a.verifyField(lval, std::string_view{})
+    } -> std::same_as<MaybeError>;
+};
+
+/**
+ * @brief Specifies a modifier that can also modify the value of its field directly.
+ *
+ * Used by @ref rpc::StaticRpcSpec, which looks every field up only once.
+ */
+template <typename T>
+concept SomeFieldModifier = SomeModifier<T> and requires(T a, boost::json::value lval) {
+    {
+        a.modifyField(lval, std::string_view{})
+    } -> std::same_as<MaybeError>;
+};
+
+/**
+ * @brief Specifies a processor that has to run even if its field is missing, e.g. to report that it is missing.
+ *
+ * All other processors of a @ref rpc::FieldSpec are skipped when the field is not in the request.
+ */
+template <typename T>
+concept SomePresenceChecker = requires { requires std::remove_cvref_t<T>::checksPresence; };
+
 /**
  * @brief The requirements of a processor to be used with @ref rpc::FieldSpec.
  */
@@ -76,6 +110,17 @@ concept SomeContextProcessWithoutInput = requires(T a, typename T::Output out, C
     } -> std::same_as<HandlerReturnType<decltype(out)>>;
 };
 
+/**
+ * @brief A handler that validates the request and produces its Input in one go, usually with a @ref
+ * rpc::StaticRpcSpec, instead of converting the validated request with `value_to`.
+ */
+template <typename T>
+concept SomeInputParser = requires(T a, boost::json::value lval, uint32_t version) {
+    {
+        a.parseInput(lval, version)
+    } -> std::same_as<util::Expected<typename T::Input, Status>>;
+};
+
 /**
  * @brief Specifies what a Handler with Input must provide.
  */
@@ -84,7 +129,7 @@ concept SomeHandlerWithInput = requires(T a, uint32_t version) {
     {
         a.spec(version)
     } -> std::same_as<RpcSpecConstRef>;
-} and SomeContextProcessWithInput<T> and boost::json::has_value_to<typename T::Input>::value;
+} and SomeContextProcessWithInput<T> and (boost::json::has_value_to<typename T::Input>::value or SomeInputParser<T>);
 
 /**
  * @brief Specifies what a Handler without Input must provide.
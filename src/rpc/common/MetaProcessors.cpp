@@ -32,14 +32,18 @@ Section::verify(boost::json::value& value, std::string_view key) const
     if (not value.is_object() or not value.as_object().contains(key.data()))
         return {};  // ignore. field does not exist, let 'required' fail instead
 
-    auto& res = value.as_object().at(key.data());
+    return verifyField(value.as_object().at(key.data()), key);
+}
 
+[[nodiscard]] MaybeError
+Section::verifyField(boost::json::value& field, std::string_view /* key */) const
+{
     // if it is not a json object, let other validators fail
-    if (!res.is_object())
+    if (!field.is_object())
         return {};
 
     for (auto const& spec : specs) {
-        if (auto const ret = spec.process(res); not ret)
+        if (auto const ret = spec.process(field); not ret)
             return Error{ret.error()};
     }
 
@@ -52,10 +56,16 @@ ValidateArrayAt::verify(boost::json::value& value, std::string_view key) const
     if (not value.is_object() or not value.as_object().contains(key.data()))
         return {};  // ignore. field does not exist, let 'required' fail instead
 
-    if (not value.as_object().at(key.data()).is_array())
+    return verifyField(value.as_object().at(key.data()), key);
+}
+
+[[nodiscard]] MaybeError
+ValidateArrayAt::verifyField(boost::json::value& field, std::string_view /* key */) const
+{
+    if (not field.is_array())
         return Error{Status{RippledError::rpcINVALID_PARAMS}};
 
-    auto& arr = value.as_object().at(key.data()).as_array();
+    auto& arr = field.as_array();
     if (idx_ >= arr.size())
         return Error{Status{RippledError::rpcINVALID_PARAMS}};
 
@@ -55,6 +55,16 @@ public:
      */
     [[nodiscard]] MaybeError
     verify(boost::json::value& value, std::string_view key) const;
+
+    /**
+     * @brief Verify that the JSON value of the section is valid according to the given specs.
+     *
+     * @param field The JSON value of the section
+     * @param key The key of the section
+     * @return Possibly an error
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value& field, std::string_view key) const;
 };
 
 /**
@@ -84,6 +94,16 @@ public:
      */
     [[nodiscard]] MaybeError
     verify(boost::json::value& value, std::string_view key) const;
+
+    /**
+     * @brief Verify that the element at the stored index of the JSON array is valid according the stored specs.
+     *
+     * @param field The JSON value of the array
+     * @param key The key of the array
+     * @return Possibly an error
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value& field, std::string_view key) const;
 };
 
 /**
@@ -97,20 +117,20 @@ public:
      * @brief Constructs a validator that validates the specs if the type matches.
      * @param requirements The requirements to validate against
      */
-    template <SomeRequirement... Requirements>
+    template <SomeFieldRequirement... Requirements>
     IfType(Requirements&&... requirements)
         : processor_(
               [... r = std::forward<Requirements>(requirements
-               )](boost::json::value& j, std::string_view key) -> MaybeError {
+               )](boost::json::value& field, std::string_view key) -> MaybeError {
                   std::optional<Status> firstFailure = std::nullopt;
 
                   // the check logic is the same as fieldspec
                   (
-                      [&j, &key, &firstFailure, req = &r]() {
+                      [&field, &key, &firstFailure, req = &r]() {
                           if (firstFailure)
                               return;
 
-                          if (auto const res = req->verify(j, key); not res)
+                          if (auto const res = req->verifyField(field, key); not res)
                               firstFailure = res.error();
                       }(),
                       ...
@@ -138,10 +158,23 @@ public:
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
-        if (not rpc::validation::checkType<Type>(value.as_object().at(key.data())))
+        return verifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Verify that the value of the field is valid according to the stored requirements when type matches.
+     *
+     * @param field The JSON value of the field
+     * @param key The key of the field
+     * @return Possibly an error
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value& field, std::string_view key) const
+    {
+        if (not rpc::validation::checkType<Type>(field))
             return {};  // ignore if type does not match
 
-        return processor_(value, key);
+        return processor_(field, key);
     }
 
 private:
@@ -157,6 +190,8 @@ class WithCustomError final {
     Status error;
 
 public:
+    static constexpr bool checksPresence = rpc::SomePresenceChecker<SomeRequirement>;
+
     /**
      * @brief Constructs a validator that calls the given validator `req` and returns a custom error `err` in case `req`
      * fails.
@@ -180,6 +215,23 @@ public:
 
         return {};
     }
+
+    /**
+     * @brief Runs the stored validator on the value of the field and produces a custom error if it fails.
+     *
+     * @param field The JSON value of the field
+     * @param key The key of the field
+     * @return Possibly an error
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view key) const
+        requires SomeFieldRequirement<SomeRequirement>
+    {
+        if (auto const res = requirement.verifyField(field, key); not res)
+            return Error{error};
+
+        return {};
+    }
 };
 
 }  // namespace rpc::meta
@@ -57,14 +57,26 @@ public:
     [[nodiscard]] MaybeError
     modify(boost::json::value& value, std::string_view key) const
     {
-        using boost::json::value_to;
-
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
+        return modifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Clamp the value of the field to stored min and max values.
+     *
+     * @param field The JSON value of the field
+     * @return Possibly an error
+     */
+    [[nodiscard]] MaybeError
+    modifyField(boost::json::value& field, std::string_view /* key */) const
+    {
+        using boost::json::value_to;
+
         // clamp to min_ and max_
-        auto const oldValue = value_to<Type>(value.as_object().at(key.data()));
-        value.as_object()[key.data()] = std::clamp<Type>(oldValue, min_, max_);
+        auto const oldValue = value_to<Type>(field);
+        field = std::clamp<Type>(oldValue, min_, max_);
 
         return {};
     }
@@ -89,10 +101,22 @@ struct ToLower final {
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
-        if (not value.as_object().at(key.data()).is_string())
+        return modifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Update the string value of the field to lower case.
+     *
+     * @param field The JSON value of the field
+     * @return Possibly an error
+     */
+    [[nodiscard]] static MaybeError
+    modifyField(boost::json::value& field, std::string_view /* key */)
+    {
+        if (not field.is_string())
             return {};  // ignore for non-string types
 
-        value.as_object()[key.data()] = util::toLower(value.as_object().at(key.data()).as_string().c_str());
+        field = util::toLower(field.as_string().c_str());
         return {};
     }
 };
@@ -26,6 +26,9 @@ namespace rpc {
 [[nodiscard]] MaybeError
 FieldSpec::process(boost::json::value& value) const
 {
+    if (not checksPresence_ and value.is_object() and not value.as_object().contains(key_))
+        return {};
+
     return processor_(value);
 }
 
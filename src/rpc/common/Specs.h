@@ -42,12 +42,17 @@ struct FieldSpec final {
     template <SomeProcessor... Processors>
     FieldSpec(std::string const& key, Processors&&... processors)
         : processor_{detail::makeFieldProcessor<Processors...>(key, std::forward<Processors>(processors)...)}
+        , key_{key}
+        , checksPresence_{(SomePresenceChecker<Processors> or ...)}
     {
     }
 
     /**
      * @brief Processos the passed JSON value using the stored processors.
      *
+     * If the field is missing from the object, the processors are only run if one of them checks for presence of the
+     * field (see @ref rpc::SomePresenceChecker); all other processors would ignore it anyway.
+     *
      * @param value The JSON value to validate and/or modify
      * @return Nothing on success; @ref Status on error
      */
@@ -56,13 +61,16 @@ struct FieldSpec final {
 
 private:
     std::function<MaybeError(boost::json::value&)> processor_;
+    std::string key_;
+    bool checksPresence_ = false;
 };
 
 /**
  * @brief Represents a Specification of an entire RPC command.
  *
- * Note: this should really be all constexpr and handlers would expose
- * static constexpr RpcSpec spec instead. Maybe some day in the future.
+ * Fields are processed one after the other, each through its type-erased @ref FieldSpec. Fields missing from the
+ * request skip their processors unless one of them checks for presence. Handlers that declare their fields in a @ref
+ * StaticRpcSpec derive this spec from it.
  */
 struct RpcSpec final {
     /**
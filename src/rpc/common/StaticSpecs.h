@@ -0,0 +1,275 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <rpc/common/Concepts.h>
+#include <rpc/common/Specs.h>
+#include <rpc/common/Types.h>
+
+#include <boost/json/value.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace rpc {
+
+namespace detail {
+
+template <typename>
+static constexpr bool unsupported_processor_v = false;
+
+}  // namespace detail
+
+/**
+ * @brief Represents a Specification for one field of an RPC command whose processors are a compile-time type.
+ *
+ * Next to the processors it knows how to store the value of the field into the typed input of the handler.
+ *
+ * @tparam Assign Stores the processed value of the field into the input; called as `assign(input, value)`
+ * @tparam Processors The processors of the field, see @ref rpc::SomeProcessor
+ */
+template <typename Assign, SomeProcessor... Processors>
+class StaticFieldSpec final {
+    std::string_view key_;
+    Assign assign_;
+    std::tuple<Processors...> processors_;
+
+public:
+    /**
+     * @brief Construct a field specification.
+     *
+     * @param key The key in a JSON object that the field validates; must outlive the spec
+     * @param assign Stores the processed value of the field into the input
+     * @param processors The processors, each of them have to fulfil the @ref rpc::SomeProcessor concept
+     */
+    StaticFieldSpec(std::string_view key, Assign assign, Processors... processors)
+        : key_{key}, assign_{std::move(assign)}, processors_{std::move(processors)...}
+    {
+    }
+
+    /**
+     * @return The key of the field
+     */
+    [[nodiscard]] std::string_view
+    key() const
+    {
+        return key_;
+    }
+
+    /**
+     * @brief Run the processors on the field, stopping at the first failure.
+     *
+     * Processors that can work on the value of the field directly are given it without looking the field up again.
+     * If the field is missing, only the processors that check for its presence are run.
+     *
+     * @param request The JSON object of the whole request
+     * @param field The value of the field in the request; nullptr if the field is missing
+     * @return Nothing on success; @ref Status on error
+     */
+    [[nodiscard]] MaybeError
+    process(boost::json::value& request, boost::json::value* field) const
+    {
+        MaybeError result;
+        std::apply(
+            [&](auto const&... processors) {
+                // stops at the first failure
+                return (... and static_cast<bool>(result = processOne(processors, request, field)));
+            },
+            processors_
+        );
+
+        return result;
+    }
+
+    /**
+     * @brief Store the processed value of the field into the input.
+     *
+     * @param input The input to fill
+     * @param field The value of the field in the request
+     */
+    template <typename InputType>
+    void
+    assign(InputType& input, boost::json::value const& field) const
+    {
+        assign_(input, field);
+    }
+
+    /**
+     * @return The same field as a type-erased @ref FieldSpec
+     */
+    [[nodiscard]] FieldSpec
+    fieldSpec() const
+    {
+        return std::apply(
+            [this](auto const&... processors) { return FieldSpec{std::string{key_}, processors...}; }, processors_
+        );
+    }
+
+private:
+    template <typename Processor>
+    [[nodiscard]] MaybeError
+    processOne(Processor const& processor, boost::json::value& request, boost::json::value* field) const
+    {
+        if (field == nullptr) {
+            if constexpr (SomePresenceChecker<Processor>) {
+                return processor.verify(request, std::string{key_});
+            } else {
+                return {};
+            }
+        } else if constexpr (SomeFieldRequirement<Processor>) {
+            return processor.verifyField(*field, key_);
+        } else if constexpr (SomeFieldModifier<Processor>) {
+            return processor.modifyField(*field, key_);
+        } else if constexpr (SomeRequirement<Processor>) {
+            // a requirement without access to the field alone looks it up in the request itself
+            return processor.verify(request, std::string{key_});
+        } else {
+            // modifiers of the whole request could invalidate the values found in it
+            static_assert(detail::unsupported_processor_v<Processor>);
+        }
+    }
+};
+
+/**
+ * @brief Deduction guide to avoid having to specify the template arguments.
+ */
+template <typename Assign, typename... Processors>
+StaticFieldSpec(std::string_view, Assign, Processors...) -> StaticFieldSpec<Assign, Processors...>;
+
+/**
+ * @brief Represents a Specification of an entire RPC command whose fields are a compile-time type.
+ *
+ * @ref parse walks the members of the request once to find the value of every field, then runs the processors of
+ * the fields in the order of the spec and stores each value into the typed input right away. Nested sections are
+ * still processed by their type-erased @ref FieldSpec.
+ *
+ * The same fields give the @ref RpcSpec of the handler through @ref rpcSpec, so there is a single declaration of what
+ * a request may contain.
+ *
+ * @tparam Fields The fields of the spec, each a @ref StaticFieldSpec
+ */
+template <typename... Fields>
+class StaticRpcSpec final {
+    template <typename...>
+    friend class StaticRpcSpec;
+
+    std::tuple<Fields...> fields_;
+
+public:
+    /**
+     * @brief Construct a full RPC request specification.
+     *
+     * @param fields The fields of the RPC specification
+     */
+    explicit StaticRpcSpec(Fields... fields) : fields_{std::move(fields)...}
+    {
+    }
+
+    /**
+     * @brief Construct a full RPC request specification from another spec and additional fields.
+     *
+     * @param other The other spec to copy fields from
+     * @param additionalFields The additional fields to add to the spec
+     */
+    template <typename... OtherFields, typename... AdditionalFields>
+    StaticRpcSpec(StaticRpcSpec<OtherFields...> const& other, AdditionalFields... additionalFields)
+        : fields_{std::tuple_cat(other.fields_, std::tuple<AdditionalFields...>{std::move(additionalFields)...})}
+    {
+    }
+
+    /**
+     * @brief Validate the request and convert it into the typed input of the handler.
+     *
+     * @tparam InputType The typed input of the handler; must be default constructible
+     * @param request The JSON value of the request; processors may modify it in place
+     * @return The input on success; @ref Status of the first failing processor on error
+     */
+    template <typename InputType>
+    [[nodiscard]] util::Expected<InputType, Status>
+    parse(boost::json::value& request) const
+    {
+        std::array<boost::json::value*, sizeof...(Fields)> values{};
+        if (request.is_object()) {
+            for (auto& member : request.as_object()) {
+                if (auto const index = indexOf(member.key()); index < values.size())
+                    values[index] = &member.value();
+            }
+        }
+
+        auto input = InputType{};
+        MaybeError result;
+        [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+            // stops at the first failure
+            return (
+                ... and
+                static_cast<bool>(result = processAndAssign(std::get<Index>(fields_), request, values[Index], input))
+            );
+        }(std::index_sequence_for<Fields...>{});
+
+        if (not result)
+            return Error{result.error()};
+
+        return input;
+    }
+
+    /**
+     * @return The same fields as a type-erased @ref RpcSpec
+     */
+    [[nodiscard]] RpcSpec
+    rpcSpec() const
+    {
+        return std::apply([](auto const&... fields) { return RpcSpec{fields.fieldSpec()...}; }, fields_);
+    }
+
+private:
+    [[nodiscard]] std::size_t
+    indexOf(std::string_view key) const
+    {
+        auto index = std::size_t{0};
+        std::apply([&](auto const&... fields) { (... or (fields.key() == key or (++index, false))); }, fields_);
+        return index;
+    }
+
+    template <typename Field, typename InputType>
+    [[nodiscard]] static MaybeError
+    processAndAssign(Field const& field, boost::json::value& request, boost::json::value* value, InputType& input)
+    {
+        if (auto ret = field.process(request, value); not ret)
+            return ret;
+
+        if (value != nullptr)
+            field.assign(input, *value);
+
+        return {};
+    }
+};
+
+/**
+ * @brief Deduction guide for a spec extending another spec.
+ */
+template <typename... OtherFields, typename... AdditionalFields>
+StaticRpcSpec(StaticRpcSpec<OtherFields...> const&, AdditionalFields...)
+    -> StaticRpcSpec<OtherFields..., AdditionalFields...>;
+
+}  // namespace rpc
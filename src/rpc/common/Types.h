@@ -25,9 +25,13 @@
 #include <ripple/basics/base_uint.h>
 
 #include <boost/asio/spawn.hpp>
+#include <boost/json/storage_ptr.hpp>
 #include <boost/json/value.hpp>
 #include <boost/json/value_from.hpp>
 
+#include <cstdint>
+#include <functional>
+
 namespace etl {
 class LoadBalancer;
 }  // namespace etl
@@ -86,6 +90,10 @@ struct Context {
     bool isAdmin = false;
     std::string clientIp = {};
     uint32_t apiVersion = 0u;  // invalid by default
+    // charges extra requests to the client for calls that do the work of several; false if it is over its limits
+    std::function<bool(std::uint32_t)> chargeRequests = [](std::uint32_t) { return true; };
+    // where the JSON of the handler output is built; the arena of the request when called by the engine
+    boost::json::storage_ptr storage = {};
 };
 
 /**
@@ -123,7 +131,7 @@ public:
     virtual bool
     contains(std::string const& method) const = 0;
 
-    virtual std::optional<AnyHandler>
+    virtual AnyHandler const*
     getHandler(std::string const& command) const = 0;
 
     virtual bool
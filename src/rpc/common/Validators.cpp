@@ -183,13 +183,9 @@ CustomValidator SubscribeAccountsValidator =
         if (value.as_array().empty())
             return Error{Status{RippledError::rpcACT_MALFORMED, std::string(key) + " malformed."}};
 
+        auto const keyItem = std::string(key) + "'sItem";
         for (auto const& v : value.as_array()) {
-            auto obj = boost::json::object();
-            auto const keyItem = std::string(key) + "'sItem";
-
-            obj[keyItem] = v;
-
-            if (auto err = AccountValidator.verify(obj, keyItem); !err)
+            if (auto err = AccountValidator.verifyField(v, keyItem); !err)
                 return err;
         }
 
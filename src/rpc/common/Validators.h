@@ -72,8 +72,21 @@ template <typename Expected>
  * @brief A validator that simply requires a field to be present.
  */
 struct Required final {
+    static constexpr bool checksPresence = true;
+
     [[nodiscard]] static MaybeError
     verify(boost::json::value const& value, std::string_view key);
+
+    /**
+     * @brief A field that has a value is present.
+     *
+     * @return No error
+     */
+    [[nodiscard]] static MaybeError
+    verifyField(boost::json::value const& /* field */, std::string_view /* key */)
+    {
+        return {};
+    }
 };
 
 /**
@@ -112,14 +125,28 @@ public:
     [[nodiscard]] MaybeError
     verify(boost::json::value const& value, std::string_view key) const
     {
-        if (value.is_object() and value.as_object().contains(key.data())) {
-            using boost::json::value_to;
-            auto const res = value_to<T>(value.as_object().at(key.data()));
-            if (value_ == res) {
-                return Error{Status{
-                    RippledError::rpcNOT_SUPPORTED,
-                    fmt::format("Not supported field '{}'s value '{}'", std::string{key}, res)}};
-            }
+        if (value.is_object() and value.as_object().contains(key.data()))
+            return verifyField(value.as_object().at(key.data()), key);
+
+        return {};
+    }
+
+    /**
+     * @brief Verify whether the value of the field is supported or not.
+     *
+     * @param field The JSON value of the field
+     * @param key The key of the field
+     * @return `RippledError::rpcNOT_SUPPORTED` if the value matched; otherwise no error is returned
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view key) const
+    {
+        using boost::json::value_to;
+        auto const res = value_to<T>(field);
+        if (value_ == res) {
+            return Error{Status{
+                RippledError::rpcNOT_SUPPORTED,
+                fmt::format("Not supported field '{}'s value '{}'", std::string{key}, res)}};
         }
         return {};
     }
@@ -142,10 +169,22 @@ public:
     verify(boost::json::value const& value, std::string_view key)
     {
         if (value.is_object() and value.as_object().contains(key.data()))
-            return Error{Status{RippledError::rpcNOT_SUPPORTED, "Not supported field '" + std::string{key}}};
+            return verifyField(value.as_object().at(key.data()), key);
 
         return {};
     }
+
+    /**
+     * @brief A field that has a value is present and therefore not supported.
+     *
+     * @param key The key of the field
+     * @return `RippledError::rpcNOT_SUPPORTED`
+     */
+    [[nodiscard]] static MaybeError
+    verifyField(boost::json::value const& /* field */, std::string_view key)
+    {
+        return Error{Status{RippledError::rpcNOT_SUPPORTED, "Not supported field '" + std::string{key}}};
+    }
 };
 
 /**
@@ -172,8 +211,19 @@ struct Type final {
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
-        auto const& res = value.as_object().at(key.data());
-        auto const convertible = (checkType<Types>(res) || ...);
+        return verifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Verify that the JSON value of the field is (one) of specified type(s).
+     *
+     * @param field The JSON value of the field
+     * @return `RippledError::rpcINVALID_PARAMS` if validation failed; otherwise no error is returned
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view /* key */) const
+    {
+        auto const convertible = (checkType<Types>(field) || ...);
 
         if (not convertible)
             return Error{Status{RippledError::rpcINVALID_PARAMS}};
@@ -211,12 +261,24 @@ public:
     [[nodiscard]] MaybeError
     verify(boost::json::value const& value, std::string_view key) const
     {
-        using boost::json::value_to;
-
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
-        auto const res = value_to<Type>(value.as_object().at(key.data()));
+        return verifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Verify that the JSON value of the field is within a certain range.
+     *
+     * @param field The JSON value of the field
+     * @return `RippledError::rpcINVALID_PARAMS` if validation failed; otherwise no error is returned
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view /* key */) const
+    {
+        using boost::json::value_to;
+
+        auto const res = value_to<Type>(field);
 
         // TODO: may want a way to make this code more generic (e.g. use a free
         // function that can be overridden for this comparison)
@@ -254,14 +316,24 @@ public:
     [[nodiscard]] MaybeError
     verify(boost::json::value const& value, std::string_view key) const
     {
-        using boost::json::value_to;
-
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
-        auto const res = value_to<Type>(value.as_object().at(key.data()));
+        return verifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Verify that the JSON value of the field is not smaller than min.
+     *
+     * @param field The JSON value of the field
+     * @return `RippledError::rpcINVALID_PARAMS` if validation failed; otherwise no error is returned
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view /* key */) const
+    {
+        using boost::json::value_to;
 
-        if (res < min_)
+        if (value_to<Type>(field) < min_)
             return Error{Status{RippledError::rpcINVALID_PARAMS}};
 
         return {};
@@ -295,14 +367,24 @@ public:
     [[nodiscard]] MaybeError
     verify(boost::json::value const& value, std::string_view key) const
     {
-        using boost::json::value_to;
-
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
-        auto const res = value_to<Type>(value.as_object().at(key.data()));
+        return verifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Verify that the JSON value of the field is not greater than max.
+     *
+     * @param field The JSON value of the field
+     * @return `RippledError::rpcINVALID_PARAMS` if validation failed; otherwise no error is returned
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view /* key */) const
+    {
+        using boost::json::value_to;
 
-        if (res > max_)
+        if (value_to<Type>(field) > max_)
             return Error{Status{RippledError::rpcINVALID_PARAMS}};
 
         return {};
@@ -336,13 +418,24 @@ public:
     [[nodiscard]] MaybeError
     verify(boost::json::value const& value, std::string_view key) const
     {
-        using boost::json::value_to;
-
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
-        auto const res = value_to<Type>(value.as_object().at(key.data()));
-        if (res != original_)
+        return verifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Verify that the JSON value of the field is equal to the stored original.
+     *
+     * @param field The JSON value of the field
+     * @return `RippledError::rpcINVALID_PARAMS` if validation failed; otherwise no error is returned
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view /* key */) const
+    {
+        using boost::json::value_to;
+
+        if (value_to<Type>(field) != original_)
             return Error{Status{RippledError::rpcINVALID_PARAMS}};
 
         return {};
@@ -391,12 +484,25 @@ public:
     [[nodiscard]] MaybeError
     verify(boost::json::value const& value, std::string_view key) const
     {
-        using boost::json::value_to;
-
         if (not value.is_object() or not value.as_object().contains(key.data()))
             return {};  // ignore. field does not exist, let 'required' fail instead
 
-        auto const res = value_to<Type>(value.as_object().at(key.data()));
+        return verifyField(value.as_object().at(key.data()), key);
+    }
+
+    /**
+     * @brief Verify that the JSON value of the field is one of the stored options.
+     *
+     * @param field The JSON value of the field
+     * @param key The key of the field
+     * @return `RippledError::rpcINVALID_PARAMS` if validation failed; otherwise no error is returned
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view key) const
+    {
+        using boost::json::value_to;
+
+        auto const res = value_to<Type>(field);
         if (std::find(std::begin(options_), std::end(options_), res) == std::end(options_))
             return Error{Status{RippledError::rpcINVALID_PARAMS, fmt::format("Invalid field '{}'.", key)}};
 
@@ -436,6 +542,19 @@ public:
      */
     [[nodiscard]] MaybeError
     verify(boost::json::value const& value, std::string_view key) const;
+
+    /**
+     * @brief Verify that the JSON value of the field is valid according to the custom validation function stored.
+     *
+     * @param field The JSON value of the field
+     * @param key The key of the field
+     * @return Any compatible user-provided error if validation failed; otherwise no error is returned
+     */
+    [[nodiscard]] MaybeError
+    verifyField(boost::json::value const& field, std::string_view key) const
+    {
+        return validator_(field, key);
+    }
 };
 
 /**
@@ -73,7 +73,7 @@ ProductionHandlerProvider::ProductionHandlerProvider(
           {"account_objects", {AccountObjectsHandler{backend}}},
           {"account_offers", {AccountOffersHandler{backend}}},
           {"account_tx", {AccountTxHandler{backend}}},
-          {"book_changes", {BookChangesHandler{backend}}},
+          {"book_changes", {BookChangesHandler{backend, subscriptionManager->bookChangesCache()}}},
           {"book_offers", {BookOffersHandler{backend}}},
           {"deposit_authorized", {DepositAuthorizedHandler{backend}}},
           {"gateway_balances", {GatewayBalancesHandler{backend}}},
@@ -105,13 +105,13 @@ ProductionHandlerProvider::contains(std::string const& method) const
     return handlerMap_.contains(method);
 }
 
-std::optional<AnyHandler>
+AnyHandler const*
 ProductionHandlerProvider::getHandler(std::string const& command) const
 {
-    if (!handlerMap_.contains(command))
-        return {};
+    if (auto const it = handlerMap_.find(command); it != handlerMap_.end())
+        return &it->second.handler;
 
-    return handlerMap_.at(command).handler;
+    return nullptr;
 }
 
 bool
@@ -62,7 +62,7 @@ public:
     bool
     contains(std::string const& method) const override;
 
-    std::optional<AnyHandler>
+    AnyHandler const*
     getHandler(std::string const& command) const override;
 
     bool
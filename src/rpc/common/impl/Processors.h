@@ -22,6 +22,7 @@
 #include <rpc/common/APIVersion.h>
 #include <rpc/common/Concepts.h>
 #include <rpc/common/Types.h>
+#include <util/trace/Trace.h>
 
 namespace rpc::detail {
 
@@ -31,33 +32,53 @@ static constexpr bool unsupported_handler_v = false;
 template <SomeHandler HandlerType>
 struct DefaultProcessor final {
     [[nodiscard]] ReturnType
-    operator()(HandlerType const& handler, boost::json::value const& value, Context const& ctx) const
+    operator()(HandlerType const& handler, boost::json::value value, Context const& ctx) const
     {
         using boost::json::value_from;
         using boost::json::value_to;
         if constexpr (SomeHandlerWithInput<HandlerType>) {
-            // first we run validation against specified API version
-            auto const spec = handler.spec(ctx.apiVersion);
-            auto input = value;  // copy here, spec require mutable data
+            util::trace::Span validateSpan{"rpc.validate"};
+            auto inData = [&]() -> util::Expected<typename HandlerType::Input, Status> {
+                if constexpr (SomeInputParser<HandlerType>) {
+                    // validation and conversion to the typed input in a single walk of the request
+                    return handler.parseInput(value, ctx.apiVersion);
+                } else {
+                    // first we run validation against specified API version; the spec may modify the value in place
+                    auto const& spec = handler.spec(ctx.apiVersion);
+                    if (auto const ret = spec.process(value); not ret)
+                        return Error{ret.error()};  // forward Status
 
-            if (auto const ret = spec.process(input); not ret)
-                return Error{ret.error()};  // forward Status
+                    return value_to<typename HandlerType::Input>(value);
+                }
+            }();
+            if (not inData)
+                return Error{inData.error()};  // forward Status
+
+            validateSpan.finish();
 
-            auto const inData = value_to<typename HandlerType::Input>(input);
-            auto const ret = handler.process(inData, ctx);
+            util::trace::Span handlerSpan{"rpc.handler"};
+            auto ret = handler.process(std::move(*inData), ctx);
+            handlerSpan.finish();
 
             // real handler is given expected Input, not json
             if (!ret) {
                 return Error{ret.error()};  // forward Status
             }
-            return value_from(ret.value());
+
+            util::trace::Span const serializeSpan{"rpc.serialize"};
+            return value_from(std::move(ret.value()), ctx.storage);
         } else if constexpr (SomeHandlerWithoutInput<HandlerType>) {
             // no input to pass, ignore the value
-            auto const ret = handler.process(ctx);
+            util::trace::Span handlerSpan{"rpc.handler"};
+            auto ret = handler.process(ctx);
+            handlerSpan.finish();
+
             if (not ret) {
                 return Error{ret.error()};  // forward Status
             }
-            return value_from(ret.value());
+
+            util::trace::Span const serializeSpan{"rpc.serialize"};
+            return value_from(std::move(ret.value()), ctx.storage);
         } else {
             // when concept SomeHandlerWithInput and SomeHandlerWithoutInput not cover all Handler case
             static_assert(unsupported_handler_v<HandlerType>);
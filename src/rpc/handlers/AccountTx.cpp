@@ -19,7 +19,7 @@
 
 #include <rpc/handlers/AccountTx.h>
 #include <util/JsonUtils.h>
-#include <util/Profiler.h>
+#include <util/profiling/Profiling.h>
 
 namespace rpc {
 
@@ -139,14 +139,16 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
 
     auto const limit = input.limit.value_or(LIMIT_DEFAULT);
     auto const accountID = accountFromStringStrict(input.account);
-    auto const [txnsAndCursor, timeDiff] = util::timed([&]() {
+    static util::profiling::Zone const fetchZone{"rpc.account_tx.fetch"};
+    auto const [txnsAndCursor, timeDiff] = util::profiling::timed(fetchZone, [&]() {
         return sharedPtrBackend_->fetchAccountTransactions(*accountID, limit, input.forward, cursor, ctx.yield);
     });
 
     LOG(log_.info()) << "db fetch took " << timeDiff << " milliseconds - num blobs = " << txnsAndCursor.txns.size();
 
     auto const [blobs, retCursor] = txnsAndCursor;
-    Output response;
+    // the transactions go on the storage of the context, so that the response can take them without a copy
+    Output response{.transactions = boost::json::array(ctx.storage)};
 
     if (retCursor)
         response.marker = {retCursor->ledgerSequence, retCursor->transactionIndex};
@@ -163,7 +165,7 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
             continue;
         }
 
-        boost::json::object obj;
+        boost::json::object obj(ctx.storage);
         if (!input.binary) {
             auto [txn, meta] = toExpandedJson(txnPlusMeta, NFTokenjson::ENABLE);
             obj[JS(meta)] = std::move(meta);
@@ -192,7 +194,7 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
 
         obj[JS(validated)] = true;
 
-        response.transactions.push_back(obj);
+        response.transactions.push_back(std::move(obj));
     }
 
     response.limit = input.limit;
@@ -204,21 +206,21 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
 }
 
 void
-tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountTxHandler::Output const& output)
+tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountTxHandler::Output output)
 {
-    jv = {
-        {JS(account), output.account},
-        {JS(ledger_index_min), output.ledgerIndexMin},
-        {JS(ledger_index_max), output.ledgerIndexMax},
-        {JS(transactions), output.transactions},
-        {JS(validated), output.validated},
-    };
+    // built on the storage of jv; the transactions are moved in without a copy when they were built on the same one
+    auto& obj = jv.emplace_object();
+    obj[JS(account)] = output.account;
+    obj[JS(ledger_index_min)] = output.ledgerIndexMin;
+    obj[JS(ledger_index_max)] = output.ledgerIndexMax;
+    obj[JS(transactions)] = std::move(output.transactions);
+    obj[JS(validated)] = output.validated;
 
     if (output.marker)
-        jv.as_object()[JS(marker)] = boost::json::value_from(*(output.marker));
+        obj[JS(marker)] = boost::json::value_from(*(output.marker), obj.storage());
 
     if (output.limit)
-        jv.as_object()[JS(limit)] = *(output.limit);
+        obj[JS(limit)] = *(output.limit);
 }
 
 void
@@ -230,55 +232,4 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountTxHandler
     };
 }
 
-AccountTxHandler::Input
-tag_invoke(boost::json::value_to_tag<AccountTxHandler::Input>, boost::json::value const& jv)
-{
-    auto input = AccountTxHandler::Input{};
-    auto const& jsonObject = jv.as_object();
-
-    input.account = jsonObject.at(JS(account)).as_string().c_str();
-
-    if (jsonObject.contains(JS(ledger_index_min)) && jsonObject.at(JS(ledger_index_min)).as_int64() != -1)
-        input.ledgerIndexMin = jsonObject.at(JS(ledger_index_min)).as_int64();
-
-    if (jsonObject.contains(JS(ledger_index_max)) && jsonObject.at(JS(ledger_index_max)).as_int64() != -1)
-        input.ledgerIndexMax = jsonObject.at(JS(ledger_index_max)).as_int64();
-
-    if (jsonObject.contains(JS(ledger_hash)))
-        input.ledgerHash = jsonObject.at(JS(ledger_hash)).as_string().c_str();
-
-    if (jsonObject.contains(JS(ledger_index))) {
-        if (!jsonObject.at(JS(ledger_index)).is_string()) {
-            input.ledgerIndex = jsonObject.at(JS(ledger_index)).as_int64();
-        } else if (jsonObject.at(JS(ledger_index)).as_string() != "validated") {
-            input.ledgerIndex = std::stoi(jsonObject.at(JS(ledger_index)).as_string().c_str());
-        } else {
-            // could not get the latest validated ledger seq here, using this flag to indicate that
-            input.usingValidatedLedger = true;
-        }
-    }
-
-    if (jsonObject.contains(JS(binary)))
-        input.binary = boost::json::value_to<JsonBool>(jsonObject.at(JS(binary)));
-
-    if (jsonObject.contains(JS(forward)))
-        input.forward = boost::json::value_to<JsonBool>(jsonObject.at(JS(forward)));
-
-    if (jsonObject.contains(JS(limit)))
-        input.limit = jsonObject.at(JS(limit)).as_int64();
-
-    if (jsonObject.contains(JS(marker))) {
-        input.marker = AccountTxHandler::Marker{
-            jsonObject.at(JS(marker)).as_object().at(JS(ledger)).as_int64(),
-            jsonObject.at(JS(marker)).as_object().at(JS(seq)).as_int64()};
-    }
-
-    if (jsonObject.contains("tx_type")) {
-        auto objTransactionType = jsonObject.at("tx_type");
-        input.transactionType = AccountTxHandler::TYPESMAP.at(objTransactionType.as_string().c_str());
-    }
-
-    return input;
-}
-
 }  // namespace rpc
@@ -24,6 +24,7 @@
 #include <rpc/common/JsonBool.h>
 #include <rpc/common/MetaProcessors.h>
 #include <rpc/common/Modifiers.h>
+#include <rpc/common/StaticSpecs.h>
 #include <rpc/common/Types.h>
 #include <rpc/common/Validators.h>
 #include <util/log/Logger.h>
@@ -86,55 +87,143 @@ public:
     {
     }
 
-    static RpcSpecConstRef
-    spec([[maybe_unused]] uint32_t apiVersion)
+private:
+    // fields of both API versions
+    static auto const&
+    commonStaticSpec()
     {
-        static auto const rpcSpecForV1 = RpcSpec{
-            {JS(account), validation::Required{}, validation::AccountValidator},
-            {JS(ledger_hash), validation::Uint256HexStringValidator},
-            {JS(ledger_index), validation::LedgerIndexValidator},
-            {JS(ledger_index_min), validation::Type<int32_t>{}},
-            {JS(ledger_index_max), validation::Type<int32_t>{}},
-            {JS(limit),
-             validation::Type<uint32_t>{},
-             validation::Min(1u),
-             modifiers::Clamp<int32_t>{LIMIT_MIN, std::numeric_limits<int32_t>::max()}},
-            {JS(marker),
-             meta::WithCustomError{
-                 validation::Type<boost::json::object>{},
-                 Status{RippledError::rpcINVALID_PARAMS, "invalidMarker"},
-             },
-             meta::Section{
-                 {JS(ledger), validation::Required{}, validation::Type<uint32_t>{}},
-                 {JS(seq), validation::Required{}, validation::Type<uint32_t>{}},
-             }},
-            {
+        static auto const commonSpec = StaticRpcSpec{
+            StaticFieldSpec{
+                JS(account),
+                [](Input& input, boost::json::value const& value) { input.account = value.as_string().c_str(); },
+                validation::Required{},
+                validation::AccountValidator},
+            StaticFieldSpec{
+                JS(ledger_hash),
+                [](Input& input, boost::json::value const& value) { input.ledgerHash = value.as_string().c_str(); },
+                validation::Uint256HexStringValidator},
+            StaticFieldSpec{
+                JS(ledger_index),
+                [](Input& input, boost::json::value const& value) {
+                    if (!value.is_string()) {
+                        input.ledgerIndex = value.as_int64();
+                    } else if (value.as_string() != "validated") {
+                        input.ledgerIndex = std::stoi(value.as_string().c_str());
+                    } else {
+                        // could not get the latest validated ledger seq here, using this flag to indicate that
+                        input.usingValidatedLedger = true;
+                    }
+                },
+                validation::LedgerIndexValidator},
+            StaticFieldSpec{
+                JS(ledger_index_min),
+                [](Input& input, boost::json::value const& value) {
+                    if (value.as_int64() != -1)
+                        input.ledgerIndexMin = value.as_int64();
+                },
+                validation::Type<int32_t>{}},
+            StaticFieldSpec{
+                JS(ledger_index_max),
+                [](Input& input, boost::json::value const& value) {
+                    if (value.as_int64() != -1)
+                        input.ledgerIndexMax = value.as_int64();
+                },
+                validation::Type<int32_t>{}},
+            StaticFieldSpec{
+                JS(limit),
+                [](Input& input, boost::json::value const& value) { input.limit = value.as_int64(); },
+                validation::Type<uint32_t>{},
+                validation::Min(1u),
+                modifiers::Clamp<int32_t>{LIMIT_MIN, std::numeric_limits<int32_t>::max()}},
+            StaticFieldSpec{
+                JS(marker),
+                [](Input& input, boost::json::value const& value) {
+                    input.marker = Marker{
+                        static_cast<uint32_t>(value.as_object().at(JS(ledger)).as_int64()),
+                        static_cast<uint32_t>(value.as_object().at(JS(seq)).as_int64())};
+                },
+                meta::WithCustomError{
+                    validation::Type<boost::json::object>{},
+                    Status{RippledError::rpcINVALID_PARAMS, "invalidMarker"},
+                },
+                meta::Section{
+                    {JS(ledger), validation::Required{}, validation::Type<uint32_t>{}},
+                    {JS(seq), validation::Required{}, validation::Type<uint32_t>{}},
+                }},
+            StaticFieldSpec{
                 "tx_type",
+                [](Input& input, boost::json::value const& value) {
+                    input.transactionType = TYPESMAP.at(value.as_string().c_str());
+                },
                 validation::Type<std::string>{},
                 modifiers::ToLower{},
                 validation::OneOf<std::string>(TYPES_KEYS.cbegin(), TYPES_KEYS.cend()),
             },
         };
 
-        static auto const rpcSpec = RpcSpec{
-            rpcSpecForV1,
-            {
-                {JS(binary), validation::Type<bool>{}},
-                {JS(forward), validation::Type<bool>{}},
-            }};
+        return commonSpec;
+    }
+
+    static void
+    assignBinary(Input& input, boost::json::value const& value)
+    {
+        input.binary = boost::json::value_to<JsonBool>(value);
+    }
+
+    static void
+    assignForward(Input& input, boost::json::value const& value)
+    {
+        input.forward = boost::json::value_to<JsonBool>(value);
+    }
+
+    // API version 1 accepts any value that converts to a bool for binary and forward
+    static auto const&
+    staticSpecForV1()
+    {
+        static auto const specForV1 = StaticRpcSpec{
+            commonStaticSpec(), StaticFieldSpec{JS(binary), &assignBinary}, StaticFieldSpec{JS(forward), &assignForward}
+        };
+
+        return specForV1;
+    }
+
+    static auto const&
+    staticSpec()
+    {
+        static auto const specForV2 = StaticRpcSpec{
+            commonStaticSpec(),
+            StaticFieldSpec{JS(binary), &assignBinary, validation::Type<bool>{}},
+            StaticFieldSpec{JS(forward), &assignForward, validation::Type<bool>{}},
+        };
+
+        return specForV2;
+    }
+
+public:
+    static RpcSpecConstRef
+    spec([[maybe_unused]] uint32_t apiVersion)
+    {
+        static auto const rpcSpecForV1 = staticSpecForV1().rpcSpec();
+        static auto const rpcSpec = staticSpec().rpcSpec();
 
         return apiVersion == 1 ? rpcSpecForV1 : rpcSpec;
     }
 
+    static util::Expected<Input, Status>
+    parseInput(boost::json::value& request, uint32_t apiVersion)
+    {
+        if (apiVersion == 1)
+            return staticSpecForV1().parse<Input>(request);
+
+        return staticSpec().parse<Input>(request);
+    }
+
     Result
     process(Input input, Context const& ctx) const;
 
 private:
     friend void
-    tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output);
-
-    friend Input
-    tag_invoke(boost::json::value_to_tag<Input>, boost::json::value const& jv);
+    tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output output);
 
     friend void
     tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Marker const& marker);
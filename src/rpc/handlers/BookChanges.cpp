@@ -24,6 +24,9 @@ namespace rpc {
 BookChangesHandler::Result
 BookChangesHandler::process(BookChangesHandler::Input input, Context const& ctx) const
 {
+    if (input.ledgerIndexMin || input.ledgerIndexMax)
+        return processRange(input, ctx);
+
     auto const range = sharedPtrBackend_->fetchLedgerRange();
     auto const lgrInfoOrStatus = getLedgerInfoFromHashOrSeq(
         *sharedPtrBackend_, ctx.yield, input.ledgerHash, input.ledgerIndex, range->maxSequence
@@ -33,10 +36,9 @@ BookChangesHandler::process(BookChangesHandler::Input input, Context const& ctx)
         return Error{*status};
 
     auto const lgrInfo = std::get<ripple::LedgerHeader>(lgrInfoOrStatus);
-    auto const transactions = sharedPtrBackend_->fetchAllTransactionsInLedger(lgrInfo.seq, ctx.yield);
 
     Output response;
-    response.bookChanges = BookChanges::compute(transactions);
+    response.bookChanges = *fetchBookChanges(lgrInfo.seq, ctx.yield);
     response.ledgerHash = ripple::strHex(lgrInfo.hash);
     response.ledgerIndex = lgrInfo.seq;
     response.ledgerTime = lgrInfo.closeTime.time_since_epoch().count();
@@ -44,6 +46,77 @@ BookChangesHandler::process(BookChangesHandler::Input input, Context const& ctx)
     return response;
 }
 
+BookChangesHandler::Result
+BookChangesHandler::processRange(BookChangesHandler::Input const& input, Context const& ctx) const
+{
+    if (input.ledgerHash || input.ledgerIndex)
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "containsLedgerSpecifierAndRange"}};
+
+    if (!input.ledgerIndexMin || !input.ledgerIndexMax)
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "incompleteLedgerRange"}};
+
+    auto const minIndex = *input.ledgerIndexMin;
+    auto const maxIndex = *input.ledgerIndexMax;
+    if (minIndex > maxIndex)
+        return Error{Status{RippledError::rpcINVALID_LGR_RANGE}};
+
+    if (maxIndex - minIndex >= MAX_RANGE_LEDGERS)
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "ledgerRangeTooLarge"}};
+
+    auto const range = sharedPtrBackend_->fetchLedgerRange();
+    if (minIndex < range->minSequence)
+        return Error{Status{RippledError::rpcLGR_IDX_MALFORMED, "ledgerSeqMinOutOfRange"}};
+
+    if (maxIndex > range->maxSequence)
+        return Error{Status{RippledError::rpcLGR_IDX_MALFORMED, "ledgerSeqMaxOutOfRange"}};
+
+    // the request itself was already counted, every other ledger of the range is charged as one more request
+    if (!ctx.chargeRequests(maxIndex - minIndex))
+        return Error{Status{RippledError::rpcSLOW_DOWN}};
+
+    std::vector<BookChangesCache::ChangesPtr> ledgers;
+    ledgers.reserve(maxIndex - minIndex + 1);
+    std::size_t uncached = 0;
+    for (auto seq = minIndex; seq <= maxIndex; ++seq) {
+        ledgers.push_back(bookChangesCache_->get(seq));
+        if (!ledgers.back())
+            ++uncached;
+    }
+
+    // a range only aggregates what was computed on publish; reading all of it from the database is too expensive
+    if (uncached > MAX_UNCACHED_RANGE_LEDGERS)
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "ledgerRangeNotCached"}};
+
+    auto const lgrInfo = sharedPtrBackend_->fetchLedgerBySequence(maxIndex, ctx.yield);
+    if (!lgrInfo)
+        return Error{Status{RippledError::rpcLGR_NOT_FOUND, "ledgerNotFound"}};
+
+    for (auto seq = minIndex; seq <= maxIndex; ++seq) {
+        if (auto& changes = ledgers[seq - minIndex]; !changes)
+            changes = fetchBookChanges(seq, ctx.yield);
+    }
+
+    Output response;
+    response.bookChanges = BookChanges::aggregate(ledgers);
+    response.ledgerHash = ripple::strHex(lgrInfo->hash);
+    response.ledgerIndex = lgrInfo->seq;
+    response.ledgerTime = lgrInfo->closeTime.time_since_epoch().count();
+    response.ledgerIndexMin = minIndex;
+    response.ledgerIndexMax = maxIndex;
+
+    return response;
+}
+
+BookChangesCache::ChangesPtr
+BookChangesHandler::fetchBookChanges(std::uint32_t seq, boost::asio::yield_context yield) const
+{
+    if (auto changes = bookChangesCache_->get(seq); changes)
+        return changes;
+
+    auto const transactions = sharedPtrBackend_->fetchAllTransactionsInLedger(seq, yield);
+    return std::make_shared<std::vector<BookChange> const>(BookChanges::compute(transactions));
+}
+
 void
 tag_invoke(boost::json::value_from_tag, boost::json::value& jv, BookChangesHandler::Output const& output)
 {
@@ -57,6 +130,11 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, BookChangesHandl
         {JS(validated), output.validated},
         {JS(changes), value_from(output.bookChanges)},
     };
+
+    if (output.ledgerIndexMin && output.ledgerIndexMax) {
+        jv.as_object()[JS(ledger_index_min)] = *output.ledgerIndexMin;
+        jv.as_object()[JS(ledger_index_max)] = *output.ledgerIndexMax;
+    }
 }
 
 BookChangesHandler::Input
@@ -76,11 +154,17 @@ tag_invoke(boost::json::value_to_tag<BookChangesHandler::Input>, boost::json::va
         }
     }
 
+    if (jsonObject.contains(JS(ledger_index_min)))
+        input.ledgerIndexMin = jv.at(JS(ledger_index_min)).as_int64();
+
+    if (jsonObject.contains(JS(ledger_index_max)))
+        input.ledgerIndexMax = jv.at(JS(ledger_index_max)).as_int64();
+
     return input;
 }
 
 [[nodiscard]] boost::json::object
-computeBookChanges(ripple::LedgerHeader const& lgrInfo, std::vector<data::TransactionAndMetadata> const& transactions)
+computeBookChanges(ripple::LedgerHeader const& lgrInfo, std::vector<BookChange> const& bookChanges)
 {
     using boost::json::value_from;
 
@@ -89,7 +173,7 @@ computeBookChanges(ripple::LedgerHeader const& lgrInfo, std::vector<data::Transa
         {JS(ledger_index), lgrInfo.seq},
         {JS(ledger_hash), to_string(lgrInfo.hash)},
         {JS(ledger_time), lgrInfo.closeTime.time_since_epoch().count()},
-        {JS(changes), value_from(BookChanges::compute(transactions))},
+        {JS(changes), value_from(bookChanges)},
     };
 }
 
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <data/BackendInterface.h>
+#include <rpc/BookChangesCache.h>
 #include <rpc/BookChangesHelper.h>
 #include <rpc/RPCHelpers.h>
 #include <rpc/common/Types.h>
@@ -31,15 +32,26 @@ namespace rpc {
  * @brief BookChangesHandler returns the order book changes for a given ledger.
  *
  * This API is not documented in the rippled API documentation.
+ *
+ * Clio extends it with `ledger_index_min` and `ledger_index_max`, which aggregate the changes of every ledger in the
+ * range: volumes are summed, open and close come from the first and last ledger that traded the pair. A range is
+ * charged to the client as one request per ledger and is served from the ledgers cached when they were published; at
+ * most a few ledgers of a range are read from the database.
  */
 class BookChangesHandler {
     std::shared_ptr<BackendInterface> sharedPtrBackend_;
+    std::shared_ptr<BookChangesCache const> bookChangesCache_;
 
 public:
+    static constexpr auto MAX_RANGE_LEDGERS = 256u;
+    static constexpr auto MAX_UNCACHED_RANGE_LEDGERS = 4u;
+
     struct Output {
         std::string ledgerHash;
         uint32_t ledgerIndex{};
         uint32_t ledgerTime{};
+        std::optional<uint32_t> ledgerIndexMin;
+        std::optional<uint32_t> ledgerIndexMax;
         std::vector<BookChange> bookChanges;
         bool validated = true;
     };
@@ -48,11 +60,17 @@ public:
     struct Input {
         std::optional<std::string> ledgerHash;
         std::optional<uint32_t> ledgerIndex;
+        std::optional<uint32_t> ledgerIndexMin;
+        std::optional<uint32_t> ledgerIndexMax;
     };
 
     using Result = HandlerReturnType<Output>;
 
-    BookChangesHandler(std::shared_ptr<BackendInterface> const& sharedPtrBackend) : sharedPtrBackend_(sharedPtrBackend)
+    BookChangesHandler(
+        std::shared_ptr<BackendInterface> const& sharedPtrBackend,
+        std::shared_ptr<BookChangesCache const> const& bookChangesCache
+    )
+        : sharedPtrBackend_(sharedPtrBackend), bookChangesCache_(bookChangesCache)
     {
     }
 
@@ -62,6 +80,8 @@ public:
         static auto const rpcSpec = RpcSpec{
             {JS(ledger_hash), validation::Uint256HexStringValidator},
             {JS(ledger_index), validation::LedgerIndexValidator},
+            {JS(ledger_index_min), validation::Type<uint32_t>{}},
+            {JS(ledger_index_max), validation::Type<uint32_t>{}},
         };
 
         return rpcSpec;
@@ -71,6 +91,12 @@ public:
     process(Input input, Context const& ctx) const;
 
 private:
+    BookChangesCache::ChangesPtr
+    fetchBookChanges(std::uint32_t seq, boost::asio::yield_context yield) const;
+
+    Result
+    processRange(Input const& input, Context const& ctx) const;
+
     friend void
     tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output);
 
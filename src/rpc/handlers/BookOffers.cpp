@@ -45,24 +45,29 @@ BookOffersHandler::process(Input input, Context const& ctx) const
     // TODO: Add perfomance metrics if needed in future
     auto [offers, _] = sharedPtrBackend_->fetchBookOffers(bookKey, lgrInfo.seq, input.limit, ctx.yield);
 
-    auto output = BookOffersHandler::Output{};
-    output.ledgerHash = ripple::strHex(lgrInfo.hash);
-    output.ledgerIndex = lgrInfo.seq;
-    output.offers = postProcessOrderBook(
-        offers, book, input.taker ? *(input.taker) : beast::zero, *sharedPtrBackend_, lgrInfo.seq, ctx.yield
-    );
-
-    return output;
+    // the offers are built on the storage of the context and moved into the output as is
+    return BookOffersHandler::Output{
+        .ledgerHash = ripple::strHex(lgrInfo.hash),
+        .ledgerIndex = lgrInfo.seq,
+        .offers = postProcessOrderBook(
+            offers,
+            book,
+            input.taker ? *(input.taker) : beast::zero,
+            *sharedPtrBackend_,
+            lgrInfo.seq,
+            ctx.yield,
+            ctx.storage
+        ),
+    };
 }
 
 void
-tag_invoke(boost::json::value_from_tag, boost::json::value& jv, BookOffersHandler::Output const& output)
+tag_invoke(boost::json::value_from_tag, boost::json::value& jv, BookOffersHandler::Output output)
 {
-    jv = boost::json::object{
-        {JS(ledger_hash), output.ledgerHash},
-        {JS(ledger_index), output.ledgerIndex},
-        {JS(offers), output.offers},
-    };
+    auto& obj = jv.emplace_object();
+    obj[JS(ledger_hash)] = output.ledgerHash;
+    obj[JS(ledger_index)] = output.ledgerIndex;
+    obj[JS(offers)] = std::move(output.offers);
 }
 
 BookOffersHandler::Input
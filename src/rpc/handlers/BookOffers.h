@@ -109,7 +109,7 @@ public:
 
 private:
     friend void
-    tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output);
+    tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output output);
 
     friend Input
     tag_invoke(boost::json::value_to_tag<Input>, boost::json::value const& jv);
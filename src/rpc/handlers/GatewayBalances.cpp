@@ -44,70 +44,73 @@ GatewayBalancesHandler::process(GatewayBalancesHandler::Input input, Context con
 
     auto output = GatewayBalancesHandler::Output{};
 
-    auto const addToResponse = [&](ripple::SLE&& sle) {
-        if (sle.getType() == ripple::ltRIPPLE_STATE) {
-            ripple::STAmount balance = sle.getFieldAmount(ripple::sfBalance);
-            auto const lowLimit = sle.getFieldAmount(ripple::sfLowLimit);
-            auto const highLimit = sle.getFieldAmount(ripple::sfHighLimit);
-            auto const lowID = lowLimit.getIssuer();
-            auto const highID = highLimit.getIssuer();
-            auto const viewLowest = (lowLimit.getIssuer() == accountID);
-            auto const flags = sle.getFieldU32(ripple::sfFlags);
-            auto const freeze = flags & (viewLowest ? ripple::lsfLowFreeze : ripple::lsfHighFreeze);
-
-            if (!viewLowest)
-                balance.negate();
-
-            auto const balSign = balance.signum();
-            if (balSign == 0)
-                return true;
-
-            auto const& peer = !viewLowest ? lowID : highID;
-
-            // Here, a negative balance means the cold wallet owes (normal)
-            // A positive balance means the cold wallet has an asset (unusual)
-
-            if (input.hotWallets.contains(peer)) {
-                // This is a specified hot wallet
-                output.hotBalances[peer].push_back(-balance);
-            } else if (balSign > 0) {
-                // This is a gateway asset
-                output.assets[peer].push_back(balance);
-            } else if (freeze != 0u) {
-                // An obligation the gateway has frozen
-                output.frozenBalances[peer].push_back(-balance);
-            } else {
-                // normal negative balance, obligation to customer
-                auto& bal = output.sums[balance.getCurrency()];
-                if (bal == beast::zero) {
-                    // This is needed to set the currency code correctly
-                    bal = -balance;
+    // without hot wallets, the balances of the latest ledger may be maintained by the balances index
+    auto const& balancesIndex = sharedPtrBackend_->balancesIndex();
+    auto balances = input.hotWallets.empty() ? balancesIndex.get(*accountID, lgrInfo.seq) : std::nullopt;
+
+    if (!balances) {
+        balances.emplace();
+
+        // the index is given the trust lines in the order they are walked, which its totals depend on
+        auto const indexed = input.hotWallets.empty() and balancesIndex.isEnabled();
+        std::vector<data::TrustLineState> lines;
+
+        auto const addToResponse = [&](ripple::SLE&& sle) {
+            if (sle.getType() == ripple::ltRIPPLE_STATE) {
+                auto const line = data::TrustLineState::fromSLE(sle);
+                auto const viewLowest = (line.lowLimit.getIssuer() == accountID);
+                auto const& peer = !viewLowest ? line.lowLimit.getIssuer() : line.highLimit.getIssuer();
+
+                if (input.hotWallets.contains(peer)) {
+                    // This is a specified hot wallet
+                    auto balance = line.balance;
+                    if (!viewLowest)
+                        balance.negate();
+
+                    if (balance.signum() != 0)
+                        output.hotBalances[peer].push_back(-balance);
                 } else {
-                    try {
-                        bal -= balance;
-                    } catch (std::runtime_error const& e) {
-                        bal = ripple::STAmount(bal.issue(), ripple::STAmount::cMaxValue, ripple::STAmount::cMaxOffset);
-                    }
+                    // Here, a negative balance means the cold wallet owes (normal)
+                    // A positive balance means the cold wallet has an asset (unusual)
+                    balances->add(*accountID, line);
+                    if (indexed)
+                        lines.push_back(line);
                 }
             }
-        }
 
-        return true;
-    };
+            return true;
+        };
+
+        // traverse all owned nodes, limit->max, marker->empty
+        auto const ret = traverseOwnedNodes(
+            *sharedPtrBackend_,
+            *accountID,
+            lgrInfo.seq,
+            std::numeric_limits<std::uint32_t>::max(),
+            {},
+            ctx.yield,
+            addToResponse
+        );
+
+        if (auto status = std::get_if<Status>(&ret))
+            return Error{*status};
+
+        if (indexed)
+            balancesIndex.put(*accountID, lines, lgrInfo.seq);
+    }
 
-    // traverse all owned nodes, limit->max, marker->empty
-    auto const ret = traverseOwnedNodes(
-        *sharedPtrBackend_,
-        *accountID,
-        lgrInfo.seq,
-        std::numeric_limits<std::uint32_t>::max(),
-        {},
-        ctx.yield,
-        addToResponse
-    );
+    for (auto const& [currency, total] : balances->obligations)
+        output.sums[currency] = total;
 
-    if (auto status = std::get_if<Status>(&ret))
-        return Error{*status};
+    auto const toOutput = [](data::IssuerBalances::PeerBalances const& peerBalances, auto& outputBalances) {
+        for (auto const& [peer, byCurrency] : peerBalances) {
+            for (auto const& [_, balance] : byCurrency)
+                outputBalances[peer].push_back(balance);
+        }
+    };
+
+    toOutput(balances->assets, output.assets);
+    toOutput(balances->frozenBalances, output.frozenBalances);
 
     auto inHotbalances = [&](auto const& hw) { return output.hotBalances.contains(hw); };
     if (not std::all_of(input.hotWallets.begin(), input.hotWallets.end(), inHotbalances))
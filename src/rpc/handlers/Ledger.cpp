@@ -32,7 +32,8 @@ LedgerHandler::process(LedgerHandler::Input input, Context const& ctx) const
         return Error{*status};
 
     auto const lgrInfo = std::get<ripple::LedgerHeader>(lgrInfoOrStatus);
-    Output output;
+    // constructed in place: a json container keeps its storage when assigned to
+    Output output{.header = boost::json::object(ctx.storage)};
 
     if (input.binary) {
         output.header[JS(ledger_data)] = ripple::strHex(ledgerInfoToBlob(lgrInfo));
@@ -65,7 +66,7 @@ LedgerHandler::process(LedgerHandler::Input input, Context const& ctx) const
                 std::move_iterator(txns.end()),
                 std::back_inserter(jsonTxs),
                 [&](auto obj) {
-                    boost::json::object entry;
+                    boost::json::object entry(ctx.storage);
                     if (!input.binary) {
                         auto [txn, meta] = toExpandedJson(obj);
                         entry = std::move(txn);
@@ -120,7 +121,7 @@ LedgerHandler::process(LedgerHandler::Input input, Context const& ctx) const
         auto diff = sharedPtrBackend_->fetchLedgerDiff(lgrInfo.seq, ctx.yield);
 
         for (auto const& obj : diff) {
-            boost::json::object entry;
+            boost::json::object entry(ctx.storage);
             entry["object_id"] = ripple::strHex(obj.key);
 
             if (input.binary) {
@@ -143,14 +144,14 @@ LedgerHandler::process(LedgerHandler::Input input, Context const& ctx) const
 }
 
 void
-tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerHandler::Output const& output)
+tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerHandler::Output output)
 {
-    jv = boost::json::object{
-        {JS(ledger_hash), output.ledgerHash},
-        {JS(ledger_index), output.ledgerIndex},
-        {JS(validated), output.validated},
-        {JS(ledger), output.header},
-    };
+    // the header moves in as is when the handler built it on the storage of jv
+    auto& obj = jv.emplace_object();
+    obj[JS(ledger_hash)] = output.ledgerHash;
+    obj[JS(ledger_index)] = output.ledgerIndex;
+    obj[JS(validated)] = output.validated;
+    obj[JS(ledger)] = std::move(output.header);
 }
 
 LedgerHandler::Input
@@ -19,8 +19,6 @@
 
 #include <rpc/handlers/LedgerEntry.h>
 
-#include <unordered_map>
-
 namespace rpc {
 
 LedgerEntryHandler::Result
@@ -165,73 +163,4 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerEntryHandl
     jv = std::move(object);
 }
 
-LedgerEntryHandler::Input
-tag_invoke(boost::json::value_to_tag<LedgerEntryHandler::Input>, boost::json::value const& jv)
-{
-    auto input = LedgerEntryHandler::Input{};
-    auto const& jsonObject = jv.as_object();
-
-    if (jsonObject.contains(JS(ledger_hash)))
-        input.ledgerHash = jv.at(JS(ledger_hash)).as_string().c_str();
-
-    if (jsonObject.contains(JS(ledger_index))) {
-        if (!jsonObject.at(JS(ledger_index)).is_string()) {
-            input.ledgerIndex = jv.at(JS(ledger_index)).as_int64();
-        } else if (jsonObject.at(JS(ledger_index)).as_string() != "validated") {
-            input.ledgerIndex = std::stoi(jv.at(JS(ledger_index)).as_string().c_str());
-        }
-    }
-
-    if (jsonObject.contains(JS(binary)))
-        input.binary = jv.at(JS(binary)).as_bool();
-
-    // check all the protential index
-    static auto const indexFieldTypeMap = std::unordered_map<std::string, ripple::LedgerEntryType>{
-        {JS(index), ripple::ltANY},
-        {JS(directory), ripple::ltDIR_NODE},
-        {JS(offer), ripple::ltOFFER},
-        {JS(check), ripple::ltCHECK},
-        {JS(escrow), ripple::ltESCROW},
-        {JS(payment_channel), ripple::ltPAYCHAN},
-        {JS(deposit_preauth), ripple::ltDEPOSIT_PREAUTH},
-        {JS(ticket), ripple::ltTICKET},
-        {JS(nft_page), ripple::ltNFTOKEN_PAGE},
-        {JS(amm), ripple::ltAMM}};
-
-    auto const indexFieldType =
-        std::find_if(indexFieldTypeMap.begin(), indexFieldTypeMap.end(), [&jsonObject](auto const& pair) {
-            auto const& [field, _] = pair;
-            return jsonObject.contains(field) && jsonObject.at(field).is_string();
-        });
-
-    if (indexFieldType != indexFieldTypeMap.end()) {
-        input.index = jv.at(indexFieldType->first).as_string().c_str();
-        input.expectedType = indexFieldType->second;
-    }
-    // check if request for account root
-    else if (jsonObject.contains(JS(account_root))) {
-        input.accountRoot = jv.at(JS(account_root)).as_string().c_str();
-    } else if (jsonObject.contains(JS(did))) {
-        input.did = jv.at(JS(did)).as_string().c_str();
-    }
-    // no need to check if_object again, validator only allows string or object
-    else if (jsonObject.contains(JS(directory))) {
-        input.directory = jv.at(JS(directory)).as_object();
-    } else if (jsonObject.contains(JS(offer))) {
-        input.offer = jv.at(JS(offer)).as_object();
-    } else if (jsonObject.contains(JS(ripple_state))) {
-        input.rippleStateAccount = jv.at(JS(ripple_state)).as_object();
-    } else if (jsonObject.contains(JS(escrow))) {
-        input.escrow = jv.at(JS(escrow)).as_object();
-    } else if (jsonObject.contains(JS(deposit_preauth))) {
-        input.depositPreauth = jv.at(JS(deposit_preauth)).as_object();
-    } else if (jsonObject.contains(JS(ticket))) {
-        input.ticket = jv.at(JS(ticket)).as_object();
-    } else if (jsonObject.contains(JS(amm))) {
-        input.amm = jv.at(JS(amm)).as_object();
-    }
-
-    return input;
-}
-
 }  // namespace rpc
@@ -22,6 +22,7 @@
 #include <data/BackendInterface.h>
 #include <rpc/RPCHelpers.h>
 #include <rpc/common/MetaProcessors.h>
+#include <rpc/common/StaticSpecs.h>
 #include <rpc/common/Types.h>
 #include <rpc/common/Validators.h>
 
@@ -74,8 +75,36 @@ public:
     {
     }
 
-    static RpcSpecConstRef
-    spec([[maybe_unused]] uint32_t apiVersion)
+private:
+    // stores the id of the entry to look up; the first id in the order of the spec wins
+    static auto
+    assignIndex(ripple::LedgerEntryType type)
+    {
+        return [type](Input& input, boost::json::value const& value) {
+            if (input.index)
+                return;
+
+            input.index = value.as_string().c_str();
+            input.expectedType = type;
+        };
+    }
+
+    // stores a field that takes either the id of the entry or the fields to compose the id from
+    static auto
+    assignIndexOrObject(ripple::LedgerEntryType type, std::optional<boost::json::object> Input::*object)
+    {
+        return [type, object](Input& input, boost::json::value const& value) {
+            // the validators only allow a string or an object
+            if (value.is_string()) {
+                assignIndex(type)(input, value);
+            } else {
+                input.*object = value.as_object();
+            }
+        };
+    }
+
+    static auto const&
+    staticSpec()
     {
         // Validator only works in this handler
         // The accounts array must have two different elements
@@ -124,90 +153,146 @@ public:
                 return MaybeError{};
             }};
 
-        static auto const rpcSpec = RpcSpec{
-            {JS(binary), validation::Type<bool>{}},
-            {JS(ledger_hash), validation::Uint256HexStringValidator},
-            {JS(ledger_index), validation::LedgerIndexValidator},
-            {JS(index), malformedRequestHexStringValidator},
-            {JS(account_root), validation::AccountBase58Validator},
-            {JS(did), validation::AccountBase58Validator},
-            {JS(check), malformedRequestHexStringValidator},
-            {JS(deposit_preauth),
-             validation::Type<std::string, boost::json::object>{},
-             meta::IfType<std::string>{malformedRequestHexStringValidator},
-             meta::IfType<boost::json::object>{
-                 meta::Section{
-                     {JS(owner),
-                      validation::Required{},
-                      meta::WithCustomError{validation::AccountBase58Validator, Status(ClioError::rpcMALFORMED_OWNER)}},
-                     {JS(authorized), validation::Required{}, validation::AccountBase58Validator},
-                 },
-             }},
-            {JS(directory),
-             validation::Type<std::string, boost::json::object>{},
-             meta::IfType<std::string>{malformedRequestHexStringValidator},
-             meta::IfType<boost::json::object>{meta::Section{
-                 {JS(owner), validation::AccountBase58Validator},
-                 {JS(dir_root), validation::Uint256HexStringValidator},
-                 {JS(sub_index), malformedRequestIntValidator}}}},
-            {JS(escrow),
-             validation::Type<std::string, boost::json::object>{},
-             meta::IfType<std::string>{malformedRequestHexStringValidator},
-             meta::IfType<boost::json::object>{
-                 meta::Section{
-                     {JS(owner),
-                      validation::Required{},
-                      meta::WithCustomError{validation::AccountBase58Validator, Status(ClioError::rpcMALFORMED_OWNER)}},
-                     {JS(seq), validation::Required{}, malformedRequestIntValidator},
-                 },
-             }},
-            {JS(offer),
-             validation::Type<std::string, boost::json::object>{},
-             meta::IfType<std::string>{malformedRequestHexStringValidator},
-             meta::IfType<boost::json::object>{
-                 meta::Section{
-                     {JS(account), validation::Required{}, validation::AccountBase58Validator},
-                     {JS(seq), validation::Required{}, malformedRequestIntValidator},
-                 },
-             }},
-            {JS(payment_channel), malformedRequestHexStringValidator},
-            {JS(ripple_state),
-             validation::Type<boost::json::object>{},
-             meta::Section{
-                 {JS(accounts), validation::Required{}, rippleStateAccountsCheck},
-                 {JS(currency), validation::Required{}, validation::CurrencyValidator},
-             }},
-            {JS(ticket),
-             validation::Type<std::string, boost::json::object>{},
-             meta::IfType<std::string>{malformedRequestHexStringValidator},
-             meta::IfType<boost::json::object>{
-                 meta::Section{
-                     {JS(account), validation::Required{}, validation::AccountBase58Validator},
-                     {JS(ticket_seq), validation::Required{}, malformedRequestIntValidator},
-                 },
-             }},
-            {JS(nft_page), malformedRequestHexStringValidator},
-            {JS(amm),
-             validation::Type<std::string, boost::json::object>{},
-             meta::IfType<std::string>{malformedRequestHexStringValidator},
-             meta::IfType<boost::json::object>{
-                 meta::Section{
-                     {JS(asset),
-                      meta::WithCustomError{validation::Required{}, Status(ClioError::rpcMALFORMED_REQUEST)},
-                      meta::WithCustomError{
-                          validation::Type<boost::json::object>{}, Status(ClioError::rpcMALFORMED_REQUEST)},
-                      ammAssetValidator},
-                     {JS(asset2),
-                      meta::WithCustomError{validation::Required{}, Status(ClioError::rpcMALFORMED_REQUEST)},
-                      meta::WithCustomError{
-                          validation::Type<boost::json::object>{}, Status(ClioError::rpcMALFORMED_REQUEST)},
-                      ammAssetValidator},
-                 },
-             }}};
+        static auto const ledgerEntrySpec = StaticRpcSpec{
+            StaticFieldSpec{
+                JS(binary),
+                [](Input& input, boost::json::value const& value) { input.binary = value.as_bool(); },
+                validation::Type<bool>{}},
+            StaticFieldSpec{
+                JS(ledger_hash),
+                [](Input& input, boost::json::value const& value) { input.ledgerHash = value.as_string().c_str(); },
+                validation::Uint256HexStringValidator},
+            StaticFieldSpec{
+                JS(ledger_index),
+                [](Input& input, boost::json::value const& value) {
+                    if (!value.is_string()) {
+                        input.ledgerIndex = value.as_int64();
+                    } else if (value.as_string() != "validated") {
+                        input.ledgerIndex = std::stoi(value.as_string().c_str());
+                    }
+                },
+                validation::LedgerIndexValidator},
+            StaticFieldSpec{JS(index), assignIndex(ripple::ltANY), malformedRequestHexStringValidator},
+            StaticFieldSpec{
+                JS(account_root),
+                [](Input& input, boost::json::value const& value) { input.accountRoot = value.as_string().c_str(); },
+                validation::AccountBase58Validator},
+            StaticFieldSpec{
+                JS(did),
+                [](Input& input, boost::json::value const& value) { input.did = value.as_string().c_str(); },
+                validation::AccountBase58Validator},
+            StaticFieldSpec{JS(check), assignIndex(ripple::ltCHECK), malformedRequestHexStringValidator},
+            StaticFieldSpec{
+                JS(deposit_preauth),
+                assignIndexOrObject(ripple::ltDEPOSIT_PREAUTH, &Input::depositPreauth),
+                validation::Type<std::string, boost::json::object>{},
+                meta::IfType<std::string>{malformedRequestHexStringValidator},
+                meta::IfType<boost::json::object>{
+                    meta::Section{
+                        {JS(owner),
+                         validation::Required{},
+                         meta::WithCustomError{
+                             validation::AccountBase58Validator, Status(ClioError::rpcMALFORMED_OWNER)
+                         }},
+                        {JS(authorized), validation::Required{}, validation::AccountBase58Validator},
+                    },
+                }},
+            StaticFieldSpec{
+                JS(directory),
+                assignIndexOrObject(ripple::ltDIR_NODE, &Input::directory),
+                validation::Type<std::string, boost::json::object>{},
+                meta::IfType<std::string>{malformedRequestHexStringValidator},
+                meta::IfType<boost::json::object>{meta::Section{
+                    {JS(owner), validation::AccountBase58Validator},
+                    {JS(dir_root), validation::Uint256HexStringValidator},
+                    {JS(sub_index), malformedRequestIntValidator}}}},
+            StaticFieldSpec{
+                JS(escrow),
+                assignIndexOrObject(ripple::ltESCROW, &Input::escrow),
+                validation::Type<std::string, boost::json::object>{},
+                meta::IfType<std::string>{malformedRequestHexStringValidator},
+                meta::IfType<boost::json::object>{
+                    meta::Section{
+                        {JS(owner),
+                         validation::Required{},
+                         meta::WithCustomError{
+                             validation::AccountBase58Validator, Status(ClioError::rpcMALFORMED_OWNER)
+                         }},
+                        {JS(seq), validation::Required{}, malformedRequestIntValidator},
+                    },
+                }},
+            StaticFieldSpec{
+                JS(offer),
+                assignIndexOrObject(ripple::ltOFFER, &Input::offer),
+                validation::Type<std::string, boost::json::object>{},
+                meta::IfType<std::string>{malformedRequestHexStringValidator},
+                meta::IfType<boost::json::object>{
+                    meta::Section{
+                        {JS(account), validation::Required{}, validation::AccountBase58Validator},
+                        {JS(seq), validation::Required{}, malformedRequestIntValidator},
+                    },
+                }},
+            StaticFieldSpec{JS(payment_channel), assignIndex(ripple::ltPAYCHAN), malformedRequestHexStringValidator},
+            StaticFieldSpec{
+                JS(ripple_state),
+                [](Input& input, boost::json::value const& value) { input.rippleStateAccount = value.as_object(); },
+                validation::Type<boost::json::object>{},
+                meta::Section{
+                    {JS(accounts), validation::Required{}, rippleStateAccountsCheck},
+                    {JS(currency), validation::Required{}, validation::CurrencyValidator},
+                }},
+            StaticFieldSpec{
+                JS(ticket),
+                assignIndexOrObject(ripple::ltTICKET, &Input::ticket),
+                validation::Type<std::string, boost::json::object>{},
+                meta::IfType<std::string>{malformedRequestHexStringValidator},
+                meta::IfType<boost::json::object>{
+                    meta::Section{
+                        {JS(account), validation::Required{}, validation::AccountBase58Validator},
+                        {JS(ticket_seq), validation::Required{}, malformedRequestIntValidator},
+                    },
+                }},
+            StaticFieldSpec{JS(nft_page), assignIndex(ripple::ltNFTOKEN_PAGE), malformedRequestHexStringValidator},
+            StaticFieldSpec{
+                JS(amm),
+                assignIndexOrObject(ripple::ltAMM, &Input::amm),
+                validation::Type<std::string, boost::json::object>{},
+                meta::IfType<std::string>{malformedRequestHexStringValidator},
+                meta::IfType<boost::json::object>{
+                    meta::Section{
+                        {JS(asset),
+                         meta::WithCustomError{validation::Required{}, Status(ClioError::rpcMALFORMED_REQUEST)},
+                         meta::WithCustomError{
+                             validation::Type<boost::json::object>{}, Status(ClioError::rpcMALFORMED_REQUEST)
+                         },
+                         ammAssetValidator},
+                        {JS(asset2),
+                         meta::WithCustomError{validation::Required{}, Status(ClioError::rpcMALFORMED_REQUEST)},
+                         meta::WithCustomError{
+                             validation::Type<boost::json::object>{}, Status(ClioError::rpcMALFORMED_REQUEST)
+                         },
+                         ammAssetValidator},
+                    },
+                }},
+        };
 
+        return ledgerEntrySpec;
+    }
+
+public:
+    static RpcSpecConstRef
+    spec([[maybe_unused]] uint32_t apiVersion)
+    {
+        static auto const rpcSpec = staticSpec().rpcSpec();
         return rpcSpec;
     }
 
+    static util::Expected<Input, Status>
+    parseInput(boost::json::value& request, [[maybe_unused]] uint32_t apiVersion)
+    {
+        return staticSpec().parse<Input>(request);
+    }
+
     Result
     process(Input input, Context const& ctx) const;
 
@@ -219,9 +304,6 @@ private:
 
     friend void
     tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output);
-
-    friend Input
-    tag_invoke(boost::json::value_to_tag<Input>, boost::json::value const& jv);
 };
 
 }  // namespace rpc
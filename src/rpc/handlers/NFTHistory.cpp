@@ -18,7 +18,7 @@
 //==============================================================================
 
 #include <rpc/handlers/NFTHistory.h>
-#include <util/Profiler.h>
+#include <util/profiling/Profiling.h>
 
 #include <limits>
 
@@ -80,7 +80,8 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
     auto const limit = input.limit.value_or(LIMIT_DEFAULT);
     auto const tokenID = ripple::uint256{input.nftID.c_str()};
 
-    auto const [txnsAndCursor, timeDiff] = util::timed([&]() {
+    static util::profiling::Zone const fetchZone{"rpc.nft_history.fetch"};
+    auto const [txnsAndCursor, timeDiff] = util::profiling::timed(fetchZone, [&]() {
         return sharedPtrBackend_->fetchNFTTransactions(tokenID, limit, input.forward, cursor, ctx.yield);
     });
     LOG(log_.info()) << "db fetch took " << timeDiff << " milliseconds - num blobs = " << txnsAndCursor.txns.size();
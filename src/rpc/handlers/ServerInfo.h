@@ -26,6 +26,7 @@
 #include <rpc/RPCHelpers.h>
 #include <rpc/common/Types.h>
 #include <rpc/common/Validators.h>
+#include <util/profiling/ProfilingService.h>
 
 #include <ripple/basics/chrono.h>
 #include <ripple/protocol/BuildInfo.h>
@@ -49,6 +50,7 @@ namespace rpc {
 template <typename SubscriptionManagerType, typename LoadBalancerType, typename ETLServiceType, typename CountersType>
 class BaseServerInfoHandler {
     static constexpr auto BACKEND_COUNTERS_KEY = "backend_counters";
+    static constexpr auto PROFILING_KEY = "profiling";
 
     std::shared_ptr<BackendInterface> backend_;
     std::shared_ptr<SubscriptionManagerType> subscriptions_;
@@ -59,11 +61,13 @@ class BaseServerInfoHandler {
 public:
     struct Input {
         bool backendCounters = false;
+        bool profiling = false;
     };
 
     struct AdminSection {
         boost::json::object counters = {};
         std::optional<boost::json::object> backendCounters = {};
+        std::optional<boost::json::object> profiling = {};
         boost::json::object subscriptions = {};
         boost::json::object etl = {};
     };
@@ -81,6 +85,7 @@ public:
         ripple::LedgerIndex latestLedgerSeq = {};
         float objectHitRate = 1.0;
         float successorHitRate = 1.0;
+        std::optional<float> boundedHitRate = std::nullopt;
     };
 
     struct InfoSection {
@@ -155,6 +160,7 @@ public:
             output.info.adminSection = {
                 .counters = counters_.get().report(),
                 .backendCounters = input.backendCounters ? std::make_optional(backend_->stats()) : std::nullopt,
+                .profiling = input.profiling ? std::make_optional(util::profiling::report()) : std::nullopt,
                 .subscriptions = subscriptions_->report(),
                 .etl = etl_->getInfo()};
         }
@@ -178,6 +184,8 @@ public:
         output.info.cache.latestLedgerSeq = backend_->cache().latestLedgerSequence();
         output.info.cache.objectHitRate = backend_->cache().getObjectHitRate();
         output.info.cache.successorHitRate = backend_->cache().getSuccessorHitRate();
+        if (backend_->cache().isBounded())
+            output.info.cache.boundedHitRate = backend_->cache().getBoundedHitRate();
         output.info.uptime = counters_.get().uptime();
         output.info.isAmendmentBlocked = etl_->isAmendmentBlocked();
 
@@ -236,6 +244,8 @@ private:
             if (info.adminSection->backendCounters.has_value()) {
                 jv.as_object()[BACKEND_COUNTERS_KEY] = *info.adminSection->backendCounters;
             }
+            if (info.adminSection->profiling.has_value())
+                jv.as_object()[PROFILING_KEY] = *info.adminSection->profiling;
         }
     }
 
@@ -262,6 +272,9 @@ private:
             {"object_hit_rate", cache.objectHitRate},
             {"successor_hit_rate", cache.successorHitRate},
         };
+
+        if (cache.boundedHitRate)
+            jv.as_object()["bounded_hit_rate"] = *cache.boundedHitRate;
     }
 
     friend Input
@@ -271,6 +284,8 @@ private:
         auto const jsonObject = jv.as_object();
         if (jsonObject.contains(BACKEND_COUNTERS_KEY) && jsonObject.at(BACKEND_COUNTERS_KEY).is_bool())
             input.backendCounters = jv.at(BACKEND_COUNTERS_KEY).as_bool();
+        if (jsonObject.contains(PROFILING_KEY) && jsonObject.at(PROFILING_KEY).is_bool())
+            input.profiling = jv.at(PROFILING_KEY).as_bool();
         return input;
     }
 };
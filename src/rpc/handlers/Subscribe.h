@@ -22,6 +22,7 @@
 #include <data/BackendInterface.h>
 #include <rpc/RPCHelpers.h>
 #include <rpc/common/MetaProcessors.h>
+#include <rpc/common/StaticSpecs.h>
 #include <rpc/common/Types.h>
 #include <rpc/common/Validators.h>
 
@@ -73,8 +74,20 @@ public:
     {
     }
 
-    RpcSpecConstRef
-    spec([[maybe_unused]] uint32_t apiVersion) const
+private:
+    static std::vector<std::string>
+    toStrings(boost::json::value const& value)
+    {
+        auto strings = std::vector<std::string>();
+        strings.reserve(value.as_array().size());
+        for (auto const& item : value.as_array())
+            strings.push_back(item.as_string().c_str());
+
+        return strings;
+    }
+
+    static auto const&
+    staticSpec()
     {
         static auto const booksValidator =
             validation::CustomValidator{[](boost::json::value const& value, std::string_view key) -> MaybeError {
@@ -109,16 +122,61 @@ public:
                 return MaybeError{};
             }};
 
-        static auto const rpcSpec = RpcSpec{
-            {JS(streams), validation::SubscribeStreamValidator},
-            {JS(accounts), validation::SubscribeAccountsValidator},
-            {JS(accounts_proposed), validation::SubscribeAccountsValidator},
-            {JS(books), booksValidator},
+        static auto const subscribeSpec = StaticRpcSpec{
+            StaticFieldSpec{
+                JS(streams),
+                [](Input& input, boost::json::value const& value) { input.streams = toStrings(value); },
+                validation::SubscribeStreamValidator},
+            StaticFieldSpec{
+                JS(accounts),
+                [](Input& input, boost::json::value const& value) { input.accounts = toStrings(value); },
+                validation::SubscribeAccountsValidator},
+            StaticFieldSpec{
+                JS(accounts_proposed),
+                [](Input& input, boost::json::value const& value) { input.accountsProposed = toStrings(value); },
+                validation::SubscribeAccountsValidator},
+            StaticFieldSpec{
+                JS(books),
+                [](Input& input, boost::json::value const& value) {
+                    input.books = std::vector<OrderBook>();
+                    for (auto const& book : value.as_array()) {
+                        auto internalBook = OrderBook{};
+                        auto const& bookObject = book.as_object();
+
+                        if (auto const& taker = bookObject.find(JS(taker)); taker != bookObject.end())
+                            internalBook.taker = taker->value().as_string().c_str();
+
+                        if (auto const& both = bookObject.find(JS(both)); both != bookObject.end())
+                            internalBook.both = both->value().as_bool();
+
+                        if (auto const& snapshot = bookObject.find(JS(snapshot)); snapshot != bookObject.end())
+                            internalBook.snapshot = snapshot->value().as_bool();
+
+                        auto const parsedBookMaybe = parseBook(book.as_object());
+                        internalBook.book = std::get<ripple::Book>(parsedBookMaybe);
+                        input.books->push_back(internalBook);
+                    }
+                },
+                booksValidator},
         };
 
+        return subscribeSpec;
+    }
+
+public:
+    RpcSpecConstRef
+    spec([[maybe_unused]] uint32_t apiVersion) const
+    {
+        static auto const rpcSpec = staticSpec().rpcSpec();
         return rpcSpec;
     }
 
+    static util::Expected<Input, Status>
+    parseInput(boost::json::value& request, [[maybe_unused]] uint32_t apiVersion)
+    {
+        return staticSpec().template parse<Input>(request);
+    }
+
     Result
     process(Input input, Context const& ctx) const
     {
@@ -259,55 +317,6 @@ private:
         if (output.bids)
             jv.as_object().emplace(JS(bids), *(output.bids));
     }
-
-    friend Input
-    tag_invoke(boost::json::value_to_tag<Input>, boost::json::value const& jv)
-    {
-        auto input = Input{};
-        auto const& jsonObject = jv.as_object();
-
-        if (auto const& streams = jsonObject.find(JS(streams)); streams != jsonObject.end()) {
-            input.streams = std::vector<std::string>();
-            for (auto const& stream : streams->value().as_array())
-                input.streams->push_back(stream.as_string().c_str());
-        }
-
-        if (auto const& accounts = jsonObject.find(JS(accounts)); accounts != jsonObject.end()) {
-            input.accounts = std::vector<std::string>();
-            for (auto const& account : accounts->value().as_array())
-                input.accounts->push_back(account.as_string().c_str());
-        }
-
-        if (auto const& accountsProposed = jsonObject.find(JS(accounts_proposed));
-            accountsProposed != jsonObject.end()) {
-            input.accountsProposed = std::vector<std::string>();
-            for (auto const& account : accountsProposed->value().as_array())
-                input.accountsProposed->push_back(account.as_string().c_str());
-        }
-
-        if (auto const& books = jsonObject.find(JS(books)); books != jsonObject.end()) {
-            input.books = std::vector<OrderBook>();
-            for (auto const& book : books->value().as_array()) {
-                auto internalBook = OrderBook{};
-                auto const& bookObject = book.as_object();
-
-                if (auto const& taker = bookObject.find(JS(taker)); taker != bookObject.end())
-                    internalBook.taker = taker->value().as_string().c_str();
-
-                if (auto const& both = bookObject.find(JS(both)); both != bookObject.end())
-                    internalBook.both = both->value().as_bool();
-
-                if (auto const& snapshot = bookObject.find(JS(snapshot)); snapshot != bookObject.end())
-                    internalBook.snapshot = snapshot->value().as_bool();
-
-                auto const parsedBookMaybe = parseBook(book.as_object());
-                internalBook.book = std::get<ripple::Book>(parsedBookMaybe);
-                input.books->push_back(internalBook);
-            }
-        }
-
-        return input;
-    }
 };
 
 /**
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/profiling/Clock.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+namespace util::profiling {
+
+bool
+tscAvailable()
+{
+#if defined(__x86_64__)
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+
+    // CPUID.80000007H:EDX[8] is the invariant TSC flag
+    static constexpr unsigned int ADVANCED_POWER_MANAGEMENT_LEAF = 0x80000007;
+    static constexpr unsigned int INVARIANT_TSC_BIT = 1u << 8;
+    if (__get_cpuid(ADVANCED_POWER_MANAGEMENT_LEAF, &eax, &ebx, &ecx, &edx) == 0)
+        return false;
+
+    return (edx & INVARIANT_TSC_BIT) != 0;
+#else
+    return false;
+#endif
+}
+
+void
+setClock(ClockType type)
+{
+    if (type == ClockType::Steady) {
+        detail::clockState = detail::ClockState{};
+        return;
+    }
+
+    if (not tscAvailable())
+        throw std::logic_error("The time stamp counter is not available or not invariant on this CPU");
+
+#if defined(__x86_64__)
+    static constexpr auto CALIBRATION_TIME = std::chrono::milliseconds{20};
+
+    auto const steadyStart = std::chrono::steady_clock::now();
+    auto const tscStart = __rdtsc();
+    std::this_thread::sleep_for(CALIBRATION_TIME);
+    auto const tscEnd = __rdtsc();
+    auto const steadyEnd = std::chrono::steady_clock::now();
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(steadyEnd - steadyStart).count();
+    detail::clockState = detail::ClockState{
+        .type = ClockType::Tsc,
+        .nanosecondsPerTick = static_cast<double>(elapsed) / static_cast<double>(tscEnd - tscStart),
+    };
+#endif
+}
+
+}  // namespace util::profiling
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace util::profiling {
+
+/**
+ * @brief A timestamp of the profiling clock; only differences of two ticks are meaningful.
+ */
+using Ticks = std::uint64_t;
+
+/**
+ * @brief The clocks the profiler can read.
+ *
+ * `Steady` is `std::chrono::steady_clock`. `Tsc` reads the time stamp counter of x86-64 CPUs directly, which is several
+ * times cheaper than a clock_gettime call; it is only available when the CPU has an invariant TSC, i.e. one that ticks
+ * at a constant rate on every core.
+ */
+enum class ClockType { Steady, Tsc };
+
+namespace detail {
+
+struct ClockState {
+    ClockType type = ClockType::Steady;
+    double nanosecondsPerTick = 1.0;
+};
+
+// Written only by setClock, before any zone is measured
+inline ClockState clockState;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace detail
+
+/**
+ * @return The current time of the profiling clock
+ */
+[[nodiscard]] inline Ticks
+now() noexcept
+{
+#if defined(__x86_64__)
+    if (detail::clockState.type == ClockType::Tsc)
+        return __rdtsc();
+#endif
+    auto const sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<Ticks>(std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count());
+}
+
+/**
+ * @brief Convert a difference of ticks to a duration.
+ *
+ * @param ticks The difference of two values returned by @ref now
+ * @return The duration
+ */
+[[nodiscard]] inline std::chrono::nanoseconds
+toDuration(Ticks ticks) noexcept
+{
+    if (detail::clockState.type == ClockType::Steady)
+        return std::chrono::nanoseconds{ticks};
+
+    auto const nanoseconds = static_cast<double>(ticks) * detail::clockState.nanosecondsPerTick;
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(nanoseconds)};
+}
+
+/**
+ * @return true if the CPU has an invariant time stamp counter; false otherwise
+ */
+bool
+tscAvailable();
+
+/**
+ * @brief Select the clock used by the profiler.
+ *
+ * Selecting `Tsc` measures the frequency of the counter against the steady clock, which takes a few milliseconds. This
+ * must be called before any zone is measured, i.e. at startup.
+ *
+ * @param type The clock to use
+ * @throw std::logic_error if `Tsc` is requested but not available
+ */
+void
+setClock(ClockType type);
+
+/**
+ * @return The clock used by the profiler
+ */
+[[nodiscard]] inline ClockType
+clockType() noexcept
+{
+    return detail::clockState.type;
+}
+
+}  // namespace util::profiling
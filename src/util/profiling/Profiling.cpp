@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/profiling/Profiling.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace util::profiling {
+
+namespace {
+
+// The measurements of one thread, indexed by zone id. The mutex is only ever contended while a snapshot is taken.
+struct ThreadStats {
+    std::mutex mutex;
+    std::vector<ZoneStats> zones;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    // threads are never removed, so the measurements of finished threads are kept
+    std::vector<std::shared_ptr<ThreadStats>> threads;
+
+    static Registry&
+    instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+};
+
+std::atomic_bool enabled = true;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+ThreadStats&
+threadStats()
+{
+    thread_local std::shared_ptr<ThreadStats> const stats = [] {
+        auto stats = std::make_shared<ThreadStats>();
+        auto& registry = Registry::instance();
+        std::scoped_lock const lock(registry.mutex);
+        registry.threads.push_back(stats);
+        return stats;
+    }();
+    return *stats;
+}
+
+}  // namespace
+
+void
+Histogram::merge(Histogram const& other)
+{
+    for (std::size_t i = 0; i < NUM_BUCKETS; ++i)
+        buckets_[i] += other.buckets_[i];
+}
+
+std::uint64_t
+Histogram::count() const
+{
+    return std::accumulate(buckets_.cbegin(), buckets_.cend(), std::uint64_t{0});
+}
+
+std::uint64_t
+Histogram::percentile(double quantile) const
+{
+    auto const total = count();
+    if (total == 0)
+        return 0;
+
+    // nearest-rank
+    auto const rank =
+        std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(total))));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < NUM_BUCKETS; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank)
+            return bucketUpperBound(i);
+    }
+    return bucketUpperBound(NUM_BUCKETS - 1);
+}
+
+std::size_t
+Histogram::bucketIndex(std::uint64_t value)
+{
+    if (value < SUB_BUCKETS)
+        return value;
+
+    auto const exponent = static_cast<std::size_t>(std::bit_width(value)) - 1;
+    if (exponent > MAX_EXPONENT)
+        return NUM_BUCKETS - 1;
+
+    auto const subBucket = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return SUB_BUCKETS + (exponent - SUB_BUCKET_BITS) * SUB_BUCKETS + subBucket;
+}
+
+std::uint64_t
+Histogram::bucketUpperBound(std::size_t index)
+{
+    if (index < SUB_BUCKETS)
+        return index;
+
+    auto const exponent = (index - SUB_BUCKETS) / SUB_BUCKETS + SUB_BUCKET_BITS;
+    auto const subBucket = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    auto const width = std::uint64_t{1} << (exponent - SUB_BUCKET_BITS);
+    return (SUB_BUCKETS + subBucket) * width + width - 1;
+}
+
+void
+ZoneStats::add(std::uint64_t ns)
+{
+    ++count;
+    sumNs += ns;
+    maxNs = std::max(maxNs, ns);
+    histogram.add(ns);
+}
+
+void
+ZoneStats::merge(ZoneStats const& other)
+{
+    count += other.count;
+    sumNs += other.sumNs;
+    maxNs = std::max(maxNs, other.maxNs);
+    histogram.merge(other.histogram);
+}
+
+std::uint64_t
+ZoneStats::percentileNs(double quantile) const
+{
+    return std::min(histogram.percentile(quantile), maxNs);
+}
+
+Zone::Zone(std::string_view name)
+{
+#ifndef CLIO_PROFILING_DISABLED
+    auto& registry = Registry::instance();
+    std::scoped_lock const lock(registry.mutex);
+
+    auto const it = std::find(registry.names.cbegin(), registry.names.cend(), name);
+    id_ = static_cast<std::size_t>(std::distance(registry.names.cbegin(), it));
+    if (it == registry.names.cend())
+        registry.names.emplace_back(name);
+#else
+    static_cast<void>(name);
+#endif
+}
+
+void
+record(Zone const& zone, std::chrono::nanoseconds elapsed)
+{
+#ifdef CLIO_PROFILING_DISABLED
+    return;
+#endif
+    if (not enabled.load(std::memory_order_relaxed))
+        return;
+
+    auto& stats = threadStats();
+    std::scoped_lock const lock(stats.mutex);
+
+    if (stats.zones.size() <= zone.id())
+        stats.zones.resize(zone.id() + 1);
+
+    auto const ns = std::max(elapsed.count(), decltype(elapsed.count()){0});
+    stats.zones[zone.id()].add(static_cast<std::uint64_t>(ns));
+}
+
+void
+setEnabled(bool value)
+{
+    enabled = value;
+}
+
+std::vector<std::pair<std::string, ZoneStats>>
+snapshot()
+{
+    std::vector<std::string> names;
+    std::vector<std::shared_ptr<ThreadStats>> threads;
+    {
+        auto& registry = Registry::instance();
+        std::scoped_lock const lock(registry.mutex);
+        names = registry.names;
+        threads = registry.threads;
+    }
+
+    std::vector<ZoneStats> merged(names.size());
+    for (auto const& thread : threads) {
+        std::scoped_lock const lock(thread->mutex);
+        for (std::size_t i = 0; i < thread->zones.size() && i < merged.size(); ++i)
+            merged[i].merge(thread->zones[i]);
+    }
+
+    std::vector<std::pair<std::string, ZoneStats>> result;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (merged[i].count > 0)
+            result.emplace_back(std::move(names[i]), std::move(merged[i]));
+    }
+
+    std::sort(result.begin(), result.end(), [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+    return result;
+}
+
+}  // namespace util::profiling
@@ -0,0 +1,265 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/profiling/Clock.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace util::profiling {
+
+/**
+ * @brief A log-linear histogram of durations in nanoseconds.
+ *
+ * Every power of two is split into 4 linear sub-buckets, so a value is known within 25% at any magnitude with a fixed
+ * number of buckets: values up to 2^41 ns (about 36 minutes) fit in 160 buckets, larger ones go into the last bucket.
+ */
+class Histogram {
+public:
+    static constexpr std::size_t SUB_BUCKET_BITS = 2;
+    static constexpr std::size_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr std::size_t MAX_EXPONENT = 40;
+    static constexpr std::size_t NUM_BUCKETS = SUB_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+private:
+    std::array<std::uint64_t, NUM_BUCKETS> buckets_{};
+
+public:
+    /**
+     * @brief Add a value to the histogram.
+     *
+     * @param value The value
+     */
+    void
+    add(std::uint64_t value)
+    {
+        ++buckets_[bucketIndex(value)];
+    }
+
+    /**
+     * @brief Add all the values of another histogram.
+     *
+     * @param other The other histogram
+     */
+    void
+    merge(Histogram const& other);
+
+    /**
+     * @brief Find the value below which the given fraction of the values fall.
+     *
+     * @param quantile The fraction, within [0, 1]
+     * @return The upper bound of the bucket holding the value; 0 if the histogram is empty
+     */
+    [[nodiscard]] std::uint64_t
+    percentile(double quantile) const;
+
+    /** @return The number of values in the histogram */
+    [[nodiscard]] std::uint64_t
+    count() const;
+
+    /**
+     * @param value A value
+     * @return The index of the bucket the value falls into
+     */
+    static std::size_t
+    bucketIndex(std::uint64_t value);
+
+    /**
+     * @param index The index of a bucket
+     * @return The largest value that falls into the bucket
+     */
+    static std::uint64_t
+    bucketUpperBound(std::size_t index);
+};
+
+/**
+ * @brief Aggregated measurements of one zone.
+ */
+struct ZoneStats {
+    std::uint64_t count = 0;
+    std::uint64_t sumNs = 0;
+    std::uint64_t maxNs = 0;
+    Histogram histogram;
+
+    /**
+     * @brief Account for one execution of the zone.
+     *
+     * @param ns The duration of the execution in nanoseconds
+     */
+    void
+    add(std::uint64_t ns);
+
+    /**
+     * @brief Add the measurements of another thread.
+     *
+     * @param other The other measurements
+     */
+    void
+    merge(ZoneStats const& other);
+
+    /**
+     * @param quantile The fraction, within [0, 1]
+     * @return The duration below which the given fraction of the executions fall, never more than the maximum
+     */
+    [[nodiscard]] std::uint64_t
+    percentileNs(double quantile) const;
+};
+
+/**
+ * @brief A named piece of code whose executions are measured.
+ *
+ * Zones are meant to be static: registering one takes a lock. Zones with the same name share their measurements.
+ */
+class Zone {
+    std::size_t id_ = 0;
+
+public:
+    /**
+     * @brief Register a zone.
+     *
+     * @param name The name of the zone, e.g. `etl.finish_writes`
+     */
+    explicit Zone(std::string_view name);
+
+    [[nodiscard]] std::size_t
+    id() const
+    {
+        return id_;
+    }
+};
+
+/**
+ * @brief Account for one execution of a zone.
+ *
+ * Measurements are aggregated in the calling thread's own storage, so recording never contends with other threads; the
+ * per-thread measurements are only merged when a @ref snapshot is taken.
+ *
+ * @param zone The zone
+ * @param elapsed The duration of the execution
+ */
+void
+record(Zone const& zone, std::chrono::nanoseconds elapsed);
+
+/**
+ * @brief Enable or disable recording at runtime; recording is enabled by default.
+ *
+ * @param enabled Whether to record
+ */
+void
+setEnabled(bool enabled);
+
+/**
+ * @return The measurements of every zone executed at least once, merged across threads and sorted by name
+ */
+std::vector<std::pair<std::string, ZoneStats>>
+snapshot();
+
+/**
+ * @brief Measures a zone from construction to destruction.
+ */
+class ScopedZone {
+    Zone const& zone_;
+    Ticks const start_ = now();
+
+public:
+    /**
+     * @brief Start measuring.
+     *
+     * @param zone The zone to measure
+     */
+    explicit ScopedZone(Zone const& zone) : zone_(zone)
+    {
+    }
+
+    ~ScopedZone()
+    {
+#ifndef CLIO_PROFILING_DISABLED
+        record(zone_, elapsed());
+#endif
+    }
+
+    ScopedZone(ScopedZone const&) = delete;
+    ScopedZone&
+    operator=(ScopedZone const&) = delete;
+
+    /** @return The time elapsed since the zone was entered */
+    [[nodiscard]] std::chrono::nanoseconds
+    elapsed() const
+    {
+        return toDuration(now() - start_);
+    }
+};
+
+/**
+ * @brief Run a function as a zone and return how long it took.
+ *
+ * The duration is returned even if profiling is compiled out, so call sites can still log it.
+ *
+ * @tparam U The duration measurement to return; defaults to milliseconds
+ * @tparam FnType The type of the function object
+ * @param zone The zone to account the execution to
+ * @param func Any function object
+ * @return The result of the function and the elapsed time as a pair, or only the elapsed time if the function returns
+ * void
+ */
+template <typename U = std::chrono::milliseconds, typename FnType>
+[[nodiscard]] auto
+timed(Zone const& zone, FnType&& func)
+{
+    ScopedZone const scope{zone};
+
+    if constexpr (std::is_same_v<decltype(func()), void>) {
+        func();
+        return std::chrono::duration_cast<U>(scope.elapsed()).count();
+    } else {
+        auto ret = func();
+        auto elapsed = std::chrono::duration_cast<U>(scope.elapsed()).count();
+        return std::make_pair(std::move(ret), std::move(elapsed));
+    }
+}
+
+}  // namespace util::profiling
+
+#define CLIO_PROFILING_CONCAT_IMPL(a, b) a##b
+#define CLIO_PROFILING_CONCAT(a, b) CLIO_PROFILING_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Measure the rest of the enclosing scope as the zone with the given name.
+ *
+ * Compiles to nothing when `CLIO_PROFILING_DISABLED` is defined.
+ */
+#ifdef CLIO_PROFILING_DISABLED
+#define CLIO_PROFILE_ZONE(name) static_cast<void>(0)
+#else
+#define CLIO_PROFILE_ZONE(name)                                                                    \
+    static ::util::profiling::Zone const CLIO_PROFILING_CONCAT(clioProfilingZone, __LINE__){name}; \
+    ::util::profiling::ScopedZone const CLIO_PROFILING_CONCAT(clioProfilingScope, __LINE__)        \
+    {                                                                                              \
+        CLIO_PROFILING_CONCAT(clioProfilingZone, __LINE__)                                         \
+    }
+#endif
@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/profiling/ProfilingService.h>
+
+#include <util/config/Config.h>
+#include <util/profiling/Clock.h>
+#include <util/profiling/Profiling.h>
+#include <util/prometheus/Prometheus.h>
+
+#include <boost/json.hpp>
+#include <fmt/format.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace util::profiling {
+
+namespace {
+
+struct Percentile {
+    char const* label;
+    double quantile;
+};
+
+constexpr std::array<Percentile, 3> PERCENTILES = {{{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}}};
+
+}  // namespace
+
+PrometheusDumper::PrometheusDumper(std::chrono::milliseconds interval) : interval_(interval)
+{
+    thread_ = std::thread([this] {
+        std::unique_lock lock(mutex_);
+        while (!cv_.wait_for(lock, interval_, [this] { return stopping_; })) {
+            lock.unlock();
+            dump();
+            lock.lock();
+        }
+    });
+}
+
+PrometheusDumper::~PrometheusDumper()
+{
+    {
+        std::scoped_lock const lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void
+PrometheusDumper::dump()
+{
+    using util::prometheus::Label;
+    using util::prometheus::Labels;
+
+    for (auto const& [zone, stats] : snapshot()) {
+        // the counters only grow, so only what was measured since the last dump is added
+        auto& [count, sum] = published_[zone];
+
+        PrometheusService::counterInt(
+            "profiling_zone_calls_total_number",
+            Labels({Label{"zone", zone}}),
+            "Total number of executions of the profiling zone"
+        ) += stats.count - count;
+        PrometheusService::counterInt(
+            "profiling_zone_duration_ns_total_number",
+            Labels({Label{"zone", zone}}),
+            "Total time spent in the profiling zone"
+        ) += stats.sumNs - sum;
+
+        count = stats.count;
+        sum = stats.sumNs;
+
+        PrometheusService::gaugeInt(
+            "profiling_zone_duration_ns",
+            Labels({Label{"zone", zone}, Label{"stat", "max"}}),
+            "Duration statistics of the profiling zone since startup"
+        )
+            .set(static_cast<std::int64_t>(stats.maxNs));
+
+        for (auto const& percentile : PERCENTILES) {
+            PrometheusService::gaugeInt(
+                "profiling_zone_duration_ns",
+                Labels({Label{"zone", zone}, Label{"stat", percentile.label}}),
+                "Duration statistics of the profiling zone since startup"
+            )
+                .set(static_cast<std::int64_t>(stats.percentileNs(percentile.quantile)));
+        }
+    }
+}
+
+ProfilingSettings
+makeProfilingSettings(util::Config const& config)
+{
+    ProfilingSettings settings;
+    if (!config.contains("profiling"))
+        return settings;
+
+    auto const section = config.section("profiling");
+    settings.enabled = section.valueOr("enabled", settings.enabled);
+    settings.dumpInterval =
+        std::chrono::milliseconds{section.valueOr<std::size_t>("dump_interval_ms", settings.dumpInterval.count())};
+
+    auto const clock = section.valueOr<std::string>("clock", "steady");
+    if (clock == "steady") {
+        settings.clock = ClockType::Steady;
+    } else if (clock == "tsc") {
+        settings.clock = ClockType::Tsc;
+    } else {
+        throw std::logic_error(fmt::format("profiling.clock must be 'steady' or 'tsc', got '{}'", clock));
+    }
+
+    return settings;
+}
+
+boost::json::object
+report()
+{
+    boost::json::object zones;
+    for (auto const& [zone, stats] : snapshot()) {
+        boost::json::object entry{
+            {"count", stats.count},
+            {"total_ns", stats.sumNs},
+            {"max_ns", stats.maxNs},
+        };
+        for (auto const& percentile : PERCENTILES)
+            entry[fmt::format("{}_ns", percentile.label)] = stats.percentileNs(percentile.quantile);
+
+        zones[zone] = std::move(entry);
+    }
+
+    return boost::json::object{
+        {"clock", clockType() == ClockType::Tsc ? "tsc" : "steady"},
+        {"zones", std::move(zones)},
+    };
+}
+
+}  // namespace util::profiling
+
+void
+ProfilingService::init(util::Config const& config)
+{
+    shutdown();
+
+    auto const settings = util::profiling::makeProfilingSettings(config);
+    util::profiling::setEnabled(settings.enabled);
+    util::profiling::setClock(settings.clock);
+
+    if (settings.enabled && settings.dumpInterval.count() > 0)
+        dumper_ = std::make_unique<util::profiling::PrometheusDumper>(settings.dumpInterval);
+}
+
+void
+ProfilingService::shutdown()
+{
+    dumper_.reset();
+}
+
+std::unique_ptr<util::profiling::PrometheusDumper> ProfilingService::dumper_;
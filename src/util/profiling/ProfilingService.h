@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/config/Config.h>
+#include <util/profiling/Clock.h>
+#include <util/profiling/Profiling.h>
+
+#include <boost/json.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace util::profiling {
+
+/**
+ * @brief Settings of the `profiling` section of the config.
+ */
+struct ProfilingSettings {
+    bool enabled = true;
+    ClockType clock = ClockType::Steady;
+    std::chrono::milliseconds dumpInterval{10000};
+};
+
+/**
+ * @brief Periodically publishes the zone measurements as Prometheus metrics.
+ *
+ * Every zone gets `profiling_zone_calls_total_number` and `profiling_zone_duration_ns_total_number` counters and a
+ * `profiling_zone_duration_ns` gauge with the maximum and the 50th, 90th and 99th percentiles since startup.
+ */
+class PrometheusDumper {
+    std::chrono::milliseconds interval_;
+    std::map<std::string, std::pair<std::uint64_t, std::uint64_t>> published_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::thread thread_;
+
+public:
+    /**
+     * @brief Start publishing.
+     *
+     * @param interval How often to publish
+     */
+    explicit PrometheusDumper(std::chrono::milliseconds interval);
+
+    ~PrometheusDumper();
+
+    PrometheusDumper(PrometheusDumper const&) = delete;
+    PrometheusDumper&
+    operator=(PrometheusDumper const&) = delete;
+
+    /** @brief Publish the current measurements. */
+    void
+    dump();
+};
+
+/**
+ * @brief Parse the `profiling` section of the config.
+ *
+ * @param config The whole config
+ * @return The settings
+ */
+ProfilingSettings
+makeProfilingSettings(util::Config const& config);
+
+/**
+ * @brief Report the current measurements as JSON.
+ *
+ * @return An object with the count, total, maximum and percentiles in nanoseconds of every zone
+ */
+boost::json::object
+report();
+
+}  // namespace util::profiling
+
+/**
+ * @brief Singleton class to set up the profiler
+ */
+class ProfilingService {
+public:
+    /**
+     * @brief Select the clock, enable or disable recording and start publishing to Prometheus
+     *
+     * @param config The configuration to use
+     */
+    static void
+    init(util::Config const& config = util::Config{});
+
+    /** @brief Stop publishing to Prometheus. */
+    static void
+    shutdown();
+
+private:
+    static std::unique_ptr<util::profiling::PrometheusDumper> dumper_;
+};
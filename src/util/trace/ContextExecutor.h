@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/trace/Trace.h>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/execution.hpp>
+#include <boost/asio/prefer.hpp>
+#include <boost/asio/query.hpp>
+#include <boost/asio/require.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace util::trace {
+
+/**
+ * @brief An executor that runs every function with the trace context of one coroutine.
+ *
+ * A coroutine spawned on this executor resumes through it after every suspension, so its context is installed on
+ * whatever thread it resumes on and removed again when it suspends. Spans started by the coroutine update its own
+ * context, and nothing is left behind on the thread for the next coroutine it runs.
+ *
+ * All the copies of the executor share the context; every coroutine should get its own, see @ref make_ContextExecutor.
+ */
+class ContextExecutor {
+    boost::asio::any_io_executor inner_;
+    std::shared_ptr<detail::ContextState> state_;
+
+public:
+    /**
+     * @brief Create an executor that runs functions on another executor with the given context.
+     *
+     * @param inner The executor to run the functions on
+     * @param state The context to run them with
+     */
+    ContextExecutor(boost::asio::any_io_executor inner, std::shared_ptr<detail::ContextState> state)
+        : inner_(std::move(inner)), state_(std::move(state))
+    {
+    }
+
+    /** @return The executor the functions run on */
+    [[nodiscard]] boost::asio::any_io_executor const&
+    inner() const
+    {
+        return inner_;
+    }
+
+    template <typename Property>
+    auto
+    query(Property const& property) const
+        -> decltype(boost::asio::query(std::declval<boost::asio::any_io_executor const&>(), property))
+    {
+        return boost::asio::query(inner_, property);
+    }
+
+    template <typename Property>
+    auto
+    require(Property const& property) const
+        -> std::enable_if_t<
+            std::is_convertible_v<
+                decltype(boost::asio::require(std::declval<boost::asio::any_io_executor const&>(), property)),
+                boost::asio::any_io_executor>,
+            ContextExecutor>
+    {
+        return ContextExecutor{boost::asio::require(inner_, property), state_};
+    }
+
+    template <typename Property>
+    auto
+    prefer(Property const& property) const
+        -> std::enable_if_t<
+            std::is_convertible_v<
+                decltype(boost::asio::prefer(std::declval<boost::asio::any_io_executor const&>(), property)),
+                boost::asio::any_io_executor>,
+            ContextExecutor>
+    {
+        return ContextExecutor{boost::asio::prefer(inner_, property), state_};
+    }
+
+    template <typename Function>
+    void
+    execute(Function&& function) const
+    {
+        inner_.execute([state = state_, function = std::forward<Function>(function)]() mutable {
+            detail::ActiveStateScope const scope{*state};
+            std::move(function)();
+        });
+    }
+
+    friend bool
+    operator==(ContextExecutor const& lhs, ContextExecutor const& rhs) noexcept
+    {
+        return lhs.inner_ == rhs.inner_ && lhs.state_ == rhs.state_;
+    }
+
+    friend bool
+    operator!=(ContextExecutor const& lhs, ContextExecutor const& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief Create the executor to spawn a coroutine on, so that it runs with the given trace context.
+ *
+ * @param executor The executor to run the coroutine on; if it already carries a context, that context is replaced
+ * @param context The context; usually util::trace::current() of the code spawning the coroutine
+ * @return The executor
+ */
+inline boost::asio::any_io_executor
+make_ContextExecutor(boost::asio::any_io_executor executor, TraceContext const& context)
+{
+    if (auto const* withContext = executor.target<ContextExecutor>(); withContext != nullptr)
+        executor = withContext->inner();
+
+    // nothing to carry; the coroutine runs without a context of its own
+    if (!context.trace)
+        return executor;
+
+    return ContextExecutor{
+        std::move(executor), std::make_shared<detail::ContextState>(detail::ContextState{context.trace, context.spanId})
+    };
+}
+
+}  // namespace util::trace
@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/trace/OtlpJson.h>
+
+#include <util/trace/Trace.h>
+
+#include <boost/json.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace util::trace {
+
+namespace {
+
+// See opentelemetry/proto/trace/v1/trace.proto
+constexpr int kSpanKindInternal = 1;
+constexpr int kSpanKindServer = 2;
+constexpr int kStatusCodeError = 2;
+
+std::string
+spanIdToHex(std::uint64_t id)
+{
+    std::array<std::uint8_t, sizeof(id)> bytes{};
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::uint8_t>(id >> (8 * (bytes.size() - 1 - i)));
+    return toHex(bytes.data(), bytes.size());
+}
+
+std::string
+toNanoseconds(std::chrono::system_clock::time_point time)
+{
+    return std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+}
+
+boost::json::array
+toAttributes(std::vector<std::pair<std::string_view, std::string>> const& attributes)
+{
+    boost::json::array result;
+    for (auto const& [key, value] : attributes) {
+        result.push_back(boost::json::object{
+            {"key", key},
+            {"value", boost::json::object{{"stringValue", value}}},
+        });
+    }
+    return result;
+}
+
+boost::json::object
+makeSpan(
+    std::string const& traceId,
+    std::string_view name,
+    std::uint64_t id,
+    std::uint64_t parentId,
+    std::chrono::system_clock::time_point start,
+    std::chrono::system_clock::time_point end,
+    std::vector<std::pair<std::string_view, std::string>> const& attributes,
+    bool error
+)
+{
+    boost::json::object span{
+        {"traceId", traceId},
+        {"spanId", spanIdToHex(id)},
+        {"name", name},
+        {"kind", parentId == 0 ? kSpanKindServer : kSpanKindInternal},
+        {"startTimeUnixNano", toNanoseconds(start)},
+        {"endTimeUnixNano", toNanoseconds(end)},
+        {"attributes", toAttributes(attributes)},
+    };
+
+    if (parentId != 0)
+        span["parentSpanId"] = spanIdToHex(parentId);
+
+    if (error)
+        span["status"] = boost::json::object{{"code", kStatusCodeError}};
+
+    return span;
+}
+
+}  // namespace
+
+std::string
+toHex(std::uint8_t const* data, std::size_t size)
+{
+    static constexpr char kDigits[] = "0123456789abcdef";
+
+    std::string result;
+    result.reserve(size * 2);
+    for (std::size_t i = 0; i < size; ++i) {
+        result.push_back(kDigits[data[i] >> 4]);
+        result.push_back(kDigits[data[i] & 0xf]);
+    }
+    return result;
+}
+
+boost::json::object
+toOtlpJson(std::vector<std::unique_ptr<Trace>> const& traces)
+{
+    boost::json::array spans;
+    for (auto const& trace : traces) {
+        auto const traceId = toHex(trace->id().data(), trace->id().size());
+
+        spans.push_back(makeSpan(
+            traceId,
+            trace->name(),
+            trace->rootSpanId(),
+            0,
+            trace->toSystemTime(trace->start()),
+            trace->toSystemTime(trace->end()),
+            trace->attributes(),
+            trace->hasError()
+        ));
+
+        for (auto const& span : trace->spans()) {
+            spans.push_back(makeSpan(
+                traceId,
+                span.name,
+                span.id,
+                span.parentId,
+                trace->toSystemTime(span.start),
+                trace->toSystemTime(span.end),
+                span.attributes,
+                span.error
+            ));
+        }
+    }
+
+    boost::json::object scopeSpans{
+        {"scope", boost::json::object{{"name", "clio"}}},
+        {"spans", std::move(spans)},
+    };
+
+    boost::json::object resourceSpans{
+        {"resource",
+         boost::json::object{
+             {"attributes", toAttributes({{"service.name", "clio"}})},
+         }},
+        {"scopeSpans", boost::json::array{std::move(scopeSpans)}},
+    };
+
+    return boost::json::object{{"resourceSpans", boost::json::array{std::move(resourceSpans)}}};
+}
+
+}  // namespace util::trace
@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/trace/Trace.h>
+
+#include <boost/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace util::trace {
+
+/**
+ * @brief Convert traces to an OTLP/JSON `ExportTraceServiceRequest`.
+ *
+ * The output follows the JSON encoding of the OpenTelemetry protocol: ids are hex strings, timestamps are nanoseconds
+ * since the epoch encoded as strings and enums are integers. A file of such requests, one per line, can be loaded by
+ * the OpenTelemetry collector's `otlpjsonfile` receiver and forwarded to any tracing backend.
+ *
+ * @param traces The traces to convert
+ * @return The request
+ */
+boost::json::object
+toOtlpJson(std::vector<std::unique_ptr<Trace>> const& traces);
+
+/**
+ * @brief Encode bytes as lowercase hex.
+ *
+ * @param data The bytes
+ * @param size The number of bytes
+ * @return The hex string
+ */
+std::string
+toHex(std::uint8_t const* data, std::size_t size);
+
+}  // namespace util::trace
@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/trace/Trace.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace util::trace {
+
+namespace {
+
+using detail::ContextState;
+
+// the context of the thread, used unless the thread runs the code of a coroutine with a context of its own
+thread_local ContextState threadState;               // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local ContextState* activeState = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+ContextState&
+currentState()
+{
+    return activeState != nullptr ? *activeState : threadState;
+}
+
+bool
+isSameTrace(std::weak_ptr<Trace> const& lhs, std::shared_ptr<Trace> const& rhs)
+{
+    return !lhs.owner_before(rhs) && !rhs.owner_before(lhs);
+}
+
+std::mt19937_64&
+randomEngine()
+{
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+    return engine;
+}
+
+}  // namespace
+
+Trace::Trace(std::string_view name, bool sampled) : name_(name), sampled_(sampled)
+{
+    auto& engine = randomEngine();
+    auto const high = engine();
+    auto const low = engine();
+    std::memcpy(id_.data(), &high, sizeof(high));
+    std::memcpy(id_.data() + sizeof(high), &low, sizeof(low));
+
+    // Span ids only have to be unique within the trace; starting from a random base keeps them from looking alike
+    // across traces in a viewer.
+    nextSpan_ = (engine() | 1u) & 0x7fff'ffff'ffff'ffffULL;
+    rootSpanId_ = newSpanId();
+}
+
+std::uint64_t
+Trace::newSpanId()
+{
+    return nextSpan_.fetch_add(1);
+}
+
+void
+Trace::record(SpanData&& span)
+{
+    std::scoped_lock const lock(mutex_);
+    spans_.push_back(std::move(span));
+}
+
+void
+Trace::setAttribute(std::string_view key, std::string value)
+{
+    std::scoped_lock const lock(mutex_);
+    attributes_.emplace_back(key, std::move(value));
+}
+
+void
+Trace::setError()
+{
+    error_ = true;
+}
+
+void
+Trace::finish()
+{
+    end_ = Clock::now();
+}
+
+std::vector<SpanData>
+Trace::spans() const
+{
+    std::scoped_lock const lock(mutex_);
+    return spans_;
+}
+
+std::vector<std::pair<std::string_view, std::string>>
+Trace::attributes() const
+{
+    std::scoped_lock const lock(mutex_);
+    return attributes_;
+}
+
+TraceContext
+current()
+{
+    auto const& state = currentState();
+    return TraceContext{state.trace.lock(), state.spanId};
+}
+
+namespace detail {
+
+ActiveStateScope::ActiveStateScope(ContextState& state) : previous_(activeState)
+{
+    activeState = &state;
+}
+
+ActiveStateScope::~ActiveStateScope()
+{
+    activeState = previous_;
+}
+
+}  // namespace detail
+
+TraceScope::TraceScope(TraceContext context)
+    : context_(std::move(context)), previousTrace_(currentState().trace), previousSpanId_(currentState().spanId)
+{
+    currentState() = ContextState{context_.trace, context_.spanId};
+}
+
+TraceScope::TraceScope(std::shared_ptr<Trace> const& trace)
+    : TraceScope(TraceContext{trace, trace ? trace->rootSpanId() : 0})
+{
+}
+
+TraceScope::~TraceScope()
+{
+    currentState() = ContextState{std::move(previousTrace_), previousSpanId_};
+}
+
+Span::Span(std::string_view name) : trace_(currentState().trace.lock())
+{
+    if (!trace_)
+        return;
+
+    auto& state = currentState();
+    data_.name = name;
+    data_.id = trace_->newSpanId();
+    data_.parentId = state.spanId;
+    data_.start = Clock::now();
+    state.spanId = data_.id;
+}
+
+Span::Span(std::string_view name, Clock::time_point start) : Span(name)
+{
+    if (trace_)
+        data_.start = start;
+}
+
+Span::Span(std::string_view name, DetachedTag) : trace_(currentState().trace.lock()), nested_(false)
+{
+    if (!trace_)
+        return;
+
+    data_.name = name;
+    data_.id = trace_->newSpanId();
+    data_.parentId = currentState().spanId;
+    data_.start = Clock::now();
+}
+
+Span
+Span::detached(std::string_view name)
+{
+    return Span{name, DetachedTag{}};
+}
+
+Span::~Span()
+{
+    finish();
+}
+
+Span::Span(Span&& other) noexcept
+    : trace_(std::move(other.trace_)), data_(std::move(other.data_)), nested_(other.nested_)
+{
+}
+
+Span&
+Span::operator=(Span&& other) noexcept
+{
+    if (this != &other) {
+        finish();
+        trace_ = std::move(other.trace_);
+        data_ = std::move(other.data_);
+        nested_ = other.nested_;
+    }
+    return *this;
+}
+
+void
+Span::setAttribute(std::string_view key, std::string value)
+{
+    if (trace_)
+        data_.attributes.emplace_back(key, std::move(value));
+}
+
+void
+Span::setError()
+{
+    if (!trace_)
+        return;
+
+    data_.error = true;
+    trace_->setError();
+}
+
+void
+Span::finish()
+{
+    if (!trace_)
+        return;
+
+    data_.end = Clock::now();
+    auto trace = std::move(trace_);
+
+    if (auto& state = currentState(); nested_ && isSameTrace(state.trace, trace))
+        state.spanId = data_.parentId;
+
+    trace->record(std::move(data_));
+}
+
+}  // namespace util::trace
@@ -0,0 +1,343 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace util::trace {
+
+// durations are measured on a steady clock; see Trace::toSystemTime for the wall clock time used in exports
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief A finished span.
+ *
+ * Span names and attribute keys are string literals; only attribute values are owned.
+ */
+struct SpanData {
+    std::string_view name;
+    std::uint64_t id = 0;
+    std::uint64_t parentId = 0;
+    Clock::time_point start;
+    Clock::time_point end;
+    std::vector<std::pair<std::string_view, std::string>> attributes;
+    bool error = false;
+};
+
+/**
+ * @brief All the spans recorded while handling one request.
+ *
+ * The trace itself is the root span: it starts when the request is received and ends when the last reference to it is
+ * released, which is after the response was written. See @ref TraceService::startTrace.
+ */
+class Trace {
+public:
+    using TraceId = std::array<std::uint8_t, 16>;
+
+private:
+    TraceId id_{};
+    std::string_view name_;
+    std::uint64_t rootSpanId_ = 0;
+    std::atomic_uint64_t nextSpan_ = 1;
+    bool sampled_ = false;
+    std::atomic_bool error_ = false;
+    Clock::time_point start_ = Clock::now();
+    Clock::time_point end_ = start_;
+    std::chrono::system_clock::time_point systemStart_ = std::chrono::system_clock::now();
+
+    mutable std::mutex mutex_;
+    std::vector<SpanData> spans_;
+    std::vector<std::pair<std::string_view, std::string>> attributes_;
+
+public:
+    /**
+     * @brief Create a new trace with a random id.
+     *
+     * @param name The name of the root span
+     * @param sampled Whether the trace is kept regardless of its duration
+     */
+    Trace(std::string_view name, bool sampled);
+
+    /** @return A span id that is unique within the trace */
+    std::uint64_t
+    newSpanId();
+
+    /**
+     * @brief Add a finished span to the trace.
+     *
+     * @param span The span
+     */
+    void
+    record(SpanData&& span);
+
+    /**
+     * @brief Set an attribute of the root span.
+     *
+     * @param key The attribute key; must be a string literal
+     * @param value The attribute value
+     */
+    void
+    setAttribute(std::string_view key, std::string value);
+
+    /** @brief Mark the request as failed. */
+    void
+    setError();
+
+    /** @brief End the root span; called when the trace is released. */
+    void
+    finish();
+
+    [[nodiscard]] TraceId const&
+    id() const
+    {
+        return id_;
+    }
+
+    [[nodiscard]] std::string_view
+    name() const
+    {
+        return name_;
+    }
+
+    [[nodiscard]] std::uint64_t
+    rootSpanId() const
+    {
+        return rootSpanId_;
+    }
+
+    [[nodiscard]] bool
+    sampled() const
+    {
+        return sampled_;
+    }
+
+    [[nodiscard]] bool
+    hasError() const
+    {
+        return error_;
+    }
+
+    [[nodiscard]] Clock::time_point
+    start() const
+    {
+        return start_;
+    }
+
+    [[nodiscard]] Clock::time_point
+    end() const
+    {
+        return end_;
+    }
+
+    [[nodiscard]] Clock::duration
+    duration() const
+    {
+        return end_ - start_;
+    }
+
+    /**
+     * @brief Convert a time of this trace to wall clock time, based on the wall clock time the trace started at.
+     *
+     * @param time A time of the trace or of one of its spans
+     * @return The wall clock time
+     */
+    [[nodiscard]] std::chrono::system_clock::time_point
+    toSystemTime(Clock::time_point time) const
+    {
+        return systemStart_ + std::chrono::duration_cast<std::chrono::system_clock::duration>(time - start_);
+    }
+
+    /** @return A copy of the spans recorded so far */
+    [[nodiscard]] std::vector<SpanData>
+    spans() const;
+
+    /** @return A copy of the attributes of the root span */
+    [[nodiscard]] std::vector<std::pair<std::string_view, std::string>>
+    attributes() const;
+};
+
+/**
+ * @brief The trace and the span that new spans created on this thread become children of.
+ */
+struct TraceContext {
+    std::shared_ptr<Trace> trace;
+    std::uint64_t spanId = 0;
+};
+
+/**
+ * @return The trace context of the calling thread; empty if the thread is not handling a traced request
+ */
+TraceContext
+current();
+
+namespace detail {
+
+// The context only refers to the trace weakly: it must not keep the trace of a finished request alive.
+struct ContextState {
+    std::weak_ptr<Trace> trace;
+    std::uint64_t spanId = 0;
+};
+
+/**
+ * @brief Makes the given state the context of the calling thread for the lifetime of the scope.
+ *
+ * Used to run the code of a coroutine with the context of its request: spans started and finished in the scope update
+ * the state rather than the thread, and the thread gets its own context back when the coroutine suspends.
+ */
+class ActiveStateScope {
+    ContextState* previous_;
+
+public:
+    explicit ActiveStateScope(ContextState& state);
+    ~ActiveStateScope();
+
+    ActiveStateScope(ActiveStateScope const&) = delete;
+    ActiveStateScope&
+    operator=(ActiveStateScope const&) = delete;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Makes a trace context current on the calling thread for the lifetime of the scope.
+ *
+ * This is only right for code that doesn't suspend in the scope. Coroutines may suspend and resume on a different
+ * thread, so the coroutines of a request are spawned on a @ref ContextExecutor that carries the context instead.
+ *
+ * The scope keeps the trace alive; the thread itself only refers to it weakly.
+ */
+class TraceScope {
+    TraceContext context_;
+    std::weak_ptr<Trace> previousTrace_;
+    std::uint64_t previousSpanId_ = 0;
+
+public:
+    /**
+     * @brief Install the given context.
+     *
+     * @param context The context; may be empty to make sure nothing is traced in the scope
+     */
+    explicit TraceScope(TraceContext context);
+
+    /**
+     * @brief Install the root span of the given trace.
+     *
+     * @param trace The trace; may be nullptr
+     */
+    explicit TraceScope(std::shared_ptr<Trace> const& trace);
+
+    ~TraceScope();
+
+    TraceScope(TraceScope const&) = delete;
+    TraceScope&
+    operator=(TraceScope const&) = delete;
+};
+
+/**
+ * @brief A span of the current trace, ended when destroyed or when @ref finish is called.
+ *
+ * If the calling thread is not handling a traced request the span does nothing, so spans can be placed on hot paths:
+ * all it costs when tracing is off is a thread-local lookup. A span keeps its trace alive until it finishes.
+ *
+ * A nested span that finishes makes its parent the current span again, but only if the context it finishes in still
+ * belongs to its trace; it never installs its trace on a thread.
+ */
+class Span {
+    std::shared_ptr<Trace> trace_;
+    SpanData data_;
+    bool nested_ = true;
+
+    struct DetachedTag {};
+    Span(std::string_view name, DetachedTag);
+
+public:
+    /**
+     * @brief Start a span that is the parent of the spans started on this thread until it finishes.
+     *
+     * @param name The name of the span; must be a string literal
+     */
+    explicit Span(std::string_view name);
+
+    /**
+     * @brief Start a span at the given time, e.g. when a job was queued.
+     *
+     * @param name The name of the span; must be a string literal
+     * @param start The start of the span
+     */
+    Span(std::string_view name, Clock::time_point start);
+
+    /**
+     * @brief Start a span for an operation that completes asynchronously, such as a socket write.
+     *
+     * The span is not the parent of the spans started after it and it does not change the context of the thread when
+     * it finishes, so it can end anywhere.
+     *
+     * @param name The name of the span; must be a string literal
+     * @return The span
+     */
+    static Span
+    detached(std::string_view name);
+
+    Span() = default;
+    ~Span();
+
+    Span(Span&& other) noexcept;
+    Span&
+    operator=(Span&& other) noexcept;
+
+    Span(Span const&) = delete;
+    Span&
+    operator=(Span const&) = delete;
+
+    /**
+     * @brief Set an attribute of the span.
+     *
+     * @param key The attribute key; must be a string literal
+     * @param value The attribute value
+     */
+    void
+    setAttribute(std::string_view key, std::string value);
+
+    /** @brief Mark the span and its trace as failed. */
+    void
+    setError();
+
+    /** @brief End the span; does nothing if it already ended. */
+    void
+    finish();
+
+    /** @return true if the span belongs to a trace; false if it does nothing */
+    [[nodiscard]] bool
+    isRecording() const
+    {
+        return trace_ != nullptr;
+    }
+};
+
+}  // namespace util::trace
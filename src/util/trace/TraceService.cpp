@@ -0,0 +1,309 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/trace/TraceService.h>
+
+#include <util/config/Config.h>
+#include <util/log/Logger.h>
+#include <util/prometheus/Prometheus.h>
+#include <util/trace/OtlpJson.h>
+#include <util/trace/Trace.h>
+
+#include <boost/json.hpp>
+#include <fmt/format.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace util::trace {
+
+namespace {
+
+std::atomic_uint64_t nextGeneration = 1;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+util::prometheus::CounterInt&
+decisionCounter(char const* decision)
+{
+    return PrometheusService::counterInt(
+        "trace_total_number",
+        util::prometheus::Labels({util::prometheus::Label{"decision", decision}}),
+        "Total number of finished request traces by sampling decision"
+    );
+}
+
+bool
+headSample(double rate)
+{
+    if (rate <= 0.0)
+        return false;
+    if (rate >= 1.0)
+        return true;
+
+    thread_local std::mt19937 engine{std::random_device{}()};
+    return std::uniform_real_distribution<double>{0.0, 1.0}(engine) < rate;
+}
+
+}  // namespace
+
+Tracer::Tracer(TraceSettings settings)
+    : settings_(std::move(settings))
+    , generation_(nextGeneration.fetch_add(1))
+    , sampledCounter_(decisionCounter("sampled"))
+    , slowCounter_(decisionCounter("slow"))
+    , errorCounter_(decisionCounter("error"))
+    , droppedCounter_(decisionCounter("dropped"))
+    , overflowCounter_(decisionCounter("overflow"))
+{
+}
+
+Tracer::~Tracer()
+{
+    stop();
+}
+
+void
+Tracer::run()
+{
+    exporter_ = std::thread([this] {
+        std::unique_lock lock(stopMutex_);
+        while (!stopping_) {
+            stopCv_.wait_for(lock, settings_.flushInterval, [this] { return stopping_; });
+
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    });
+}
+
+void
+Tracer::stop()
+{
+    {
+        std::scoped_lock const lock(stopMutex_);
+        stopping_ = true;
+    }
+    stopCv_.notify_all();
+
+    if (exporter_.joinable())
+        exporter_.join();
+
+    flush();
+}
+
+std::shared_ptr<Trace>
+Tracer::startTrace(std::string_view name)
+{
+    // The deleter only refers to the tracer weakly: requests still in flight when the tracer is replaced or shut down
+    // are simply not exported.
+    return std::shared_ptr<Trace>(
+        new Trace(name, headSample(settings_.sampleRate)),
+        [weak = weak_from_this()](Trace* trace) {
+            auto owned = std::unique_ptr<Trace>(trace);
+            owned->finish();
+            if (auto tracer = weak.lock(); tracer)
+                tracer->submit(std::move(owned));
+        }
+    );
+}
+
+Decision
+Tracer::decide(Trace const& trace, TraceSettings const& settings)
+{
+    if (trace.hasError() && settings.keepErrors)
+        return Decision::Error;
+    if (trace.duration() >= settings.slowThreshold)
+        return Decision::Slow;
+    if (trace.sampled())
+        return Decision::Sampled;
+    return Decision::Dropped;
+}
+
+void
+Tracer::submit(std::unique_ptr<Trace> trace)
+{
+    switch (decide(*trace, settings_)) {
+        case Decision::Error:
+            ++errorCounter_.get();
+            break;
+        case Decision::Slow:
+            ++slowCounter_.get();
+            break;
+        case Decision::Sampled:
+            ++sampledCounter_.get();
+            break;
+        case Decision::Dropped:
+            ++droppedCounter_.get();
+            return;
+    }
+
+    if (buffered_.fetch_add(1) >= settings_.maxBufferedTraces) {
+        --buffered_;
+        ++overflowCounter_.get();
+        return;
+    }
+
+    auto& buffer = threadBuffer();
+    std::scoped_lock const lock(buffer.mutex);
+    buffer.traces.push_back(std::move(trace));
+}
+
+Tracer::Buffer&
+Tracer::threadBuffer()
+{
+    struct ThreadBuffer {
+        std::uint64_t generation = 0;
+        std::shared_ptr<Buffer> buffer;
+    };
+    thread_local ThreadBuffer threadBuffer;
+
+    if (threadBuffer.generation != generation_) {
+        threadBuffer.generation = generation_;
+        threadBuffer.buffer = std::make_shared<Buffer>();
+
+        std::scoped_lock const lock(buffersMutex_);
+        buffers_.push_back(threadBuffer.buffer);
+    }
+
+    return *threadBuffer.buffer;
+}
+
+std::vector<std::unique_ptr<Trace>>
+Tracer::drain()
+{
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    {
+        std::scoped_lock const lock(buffersMutex_);
+        buffers = buffers_;
+    }
+
+    std::vector<std::unique_ptr<Trace>> traces;
+    for (auto const& buffer : buffers) {
+        std::vector<std::unique_ptr<Trace>> taken;
+        {
+            std::scoped_lock const lock(buffer->mutex);
+            taken.swap(buffer->traces);
+        }
+        std::move(taken.begin(), taken.end(), std::back_inserter(traces));
+    }
+
+    buffered_ -= traces.size();
+    return traces;
+}
+
+void
+Tracer::flush()
+{
+    std::scoped_lock const lock(exportMutex_);
+
+    auto const traces = drain();
+    if (traces.empty())
+        return;
+
+    std::ofstream out(settings_.file, std::ios::app);
+    out << boost::json::serialize(toOtlpJson(traces)) << '\n';
+
+    if (!out)
+        LOG(log_.error()) << "Failed to write " << traces.size() << " traces to " << settings_.file;
+}
+
+TraceSettings
+makeTraceSettings(util::Config const& config)
+{
+    TraceSettings settings;
+    if (!config.contains("tracing"))
+        return settings;
+
+    auto const section = config.section("tracing");
+    settings.enabled = section.valueOr("enabled", settings.enabled);
+    settings.sampleRate = section.valueOr("sample_rate", settings.sampleRate);
+    settings.slowThreshold =
+        std::chrono::milliseconds{section.valueOr<std::size_t>("slow_threshold_ms", settings.slowThreshold.count())};
+    settings.keepErrors = section.valueOr("keep_errors", settings.keepErrors);
+    settings.file = section.valueOr("file", settings.file);
+    settings.flushInterval =
+        std::chrono::milliseconds{section.valueOr<std::size_t>("flush_interval_ms", settings.flushInterval.count())};
+    settings.maxBufferedTraces = section.valueOr("max_buffered_traces", settings.maxBufferedTraces);
+
+    if (settings.sampleRate < 0.0 || settings.sampleRate > 1.0)
+        throw std::logic_error(fmt::format("tracing.sample_rate must be within [0, 1], got {}", settings.sampleRate));
+
+    if (settings.flushInterval.count() == 0)
+        throw std::logic_error("tracing.flush_interval_ms must be positive");
+
+    return settings;
+}
+
+}  // namespace util::trace
+
+void
+TraceService::init(util::Config const& config)
+{
+    shutdown();
+
+    auto settings = util::trace::makeTraceSettings(config);
+    if (!settings.enabled)
+        return;
+
+    instance_ = std::make_shared<util::trace::Tracer>(std::move(settings));
+    instance_->run();
+}
+
+std::shared_ptr<util::trace::Trace>
+TraceService::startTrace(std::string_view name)
+{
+    if (!instance_)
+        return nullptr;
+
+    return instance_->startTrace(name);
+}
+
+bool
+TraceService::isEnabled()
+{
+    return instance_ != nullptr;
+}
+
+void
+TraceService::shutdown()
+{
+    if (instance_)
+        instance_->stop();
+
+    instance_.reset();
+}
+
+void
+TraceService::replaceInstance(std::shared_ptr<util::trace::Tracer> instance)
+{
+    instance_ = std::move(instance);
+}
+
+std::shared_ptr<util::trace::Tracer> TraceService::instance_;
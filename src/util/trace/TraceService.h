@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/config/Config.h>
+#include <util/log/Logger.h>
+#include <util/prometheus/Prometheus.h>
+#include <util/trace/Trace.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace util::trace {
+
+/**
+ * @brief Settings of the `tracing` section of the config.
+ */
+struct TraceSettings {
+    bool enabled = false;
+    double sampleRate = 0.01;
+    std::chrono::milliseconds slowThreshold{500};
+    bool keepErrors = true;
+    std::string file = "clio_traces.jsonl";
+    std::chrono::milliseconds flushInterval{1000};
+    std::size_t maxBufferedTraces = 10000;
+};
+
+/**
+ * @brief What happens to a finished trace.
+ */
+enum class Decision { Sampled, Slow, Error, Dropped };
+
+/**
+ * @brief Collects finished traces and periodically appends the kept ones to a file.
+ *
+ * Spans of every request are recorded and the decision to keep a trace is taken when the request is done (tail-based
+ * sampling): a trace is kept if it was picked by the head sampling rate, if it took longer than the slow threshold or
+ * if it failed. Kept traces are pushed into a buffer owned by the thread that finished them, so request threads never
+ * contend with each other; the exporter thread swaps the buffers out every flush interval and writes one OTLP/JSON
+ * `ExportTraceServiceRequest` per line.
+ */
+class Tracer : public std::enable_shared_from_this<Tracer> {
+    struct Buffer {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Trace>> traces;
+    };
+
+    util::Logger log_{"General"};
+
+    TraceSettings settings_;
+    std::uint64_t generation_;
+    std::atomic_size_t buffered_ = 0;
+
+    std::mutex buffersMutex_;
+    std::vector<std::shared_ptr<Buffer>> buffers_;
+
+    std::mutex exportMutex_;
+    std::mutex stopMutex_;
+    std::condition_variable stopCv_;
+    bool stopping_ = false;
+    std::thread exporter_;
+
+    util::prometheus::CounterInt& sampledCounter_;
+    util::prometheus::CounterInt& slowCounter_;
+    util::prometheus::CounterInt& errorCounter_;
+    util::prometheus::CounterInt& droppedCounter_;
+    util::prometheus::CounterInt& overflowCounter_;
+
+public:
+    /**
+     * @brief Create a tracer; call @ref run to start exporting.
+     *
+     * @param settings The settings to use
+     */
+    explicit Tracer(TraceSettings settings);
+
+    ~Tracer();
+
+    Tracer(Tracer const&) = delete;
+    Tracer&
+    operator=(Tracer const&) = delete;
+
+    /** @brief Start the exporter thread. */
+    void
+    run();
+
+    /** @brief Stop the exporter thread and write out the buffered traces. */
+    void
+    stop();
+
+    /**
+     * @brief Start a trace; see @ref TraceService::startTrace.
+     *
+     * @param name The name of the root span; must be a string literal
+     * @return The trace
+     */
+    std::shared_ptr<Trace>
+    startTrace(std::string_view name);
+
+    /**
+     * @brief Take the sampling decision for a finished trace and buffer it if it is kept.
+     *
+     * @param trace The finished trace
+     */
+    void
+    submit(std::unique_ptr<Trace> trace);
+
+    /** @brief Write the buffered traces to the file. */
+    void
+    flush();
+
+    /** @return The buffered traces, removing them from the buffers */
+    std::vector<std::unique_ptr<Trace>>
+    drain();
+
+    [[nodiscard]] TraceSettings const&
+    settings() const
+    {
+        return settings_;
+    }
+
+    /**
+     * @brief Decide whether a finished trace is kept.
+     *
+     * @param trace The finished trace
+     * @param settings The settings to decide with
+     * @return The decision
+     */
+    static Decision
+    decide(Trace const& trace, TraceSettings const& settings);
+
+private:
+    Buffer&
+    threadBuffer();
+};
+
+/**
+ * @brief Parse the `tracing` section of the config.
+ *
+ * @param config The whole config
+ * @return The settings; tracing is disabled if the section is missing
+ */
+TraceSettings
+makeTraceSettings(util::Config const& config);
+
+}  // namespace util::trace
+
+/**
+ * @brief Singleton class to access the tracer
+ */
+class TraceService {
+public:
+    /**
+     * @brief Initialize the singleton with the given configuration and start exporting if tracing is enabled
+     *
+     * @param config The configuration to use
+     */
+    static void
+    init(util::Config const& config = util::Config{});
+
+    /**
+     * @brief Start the trace of a request.
+     *
+     * The trace ends when the last reference to it is released; the caller keeps it alive for as long as the request is
+     * being handled and every span of the trace holds a reference until it finishes.
+     *
+     * @param name The name of the root span; must be a string literal
+     * @return The trace or nullptr if tracing is disabled
+     */
+    static std::shared_ptr<util::trace::Trace>
+    startTrace(std::string_view name);
+
+    /** @return true if tracing is enabled; false otherwise */
+    static bool
+    isEnabled();
+
+    /** @brief Stop exporting and write out the buffered traces. */
+    static void
+    shutdown();
+
+    /**
+     * @brief Replace the tracer stored in the singleton
+     *
+     * @param instance The new tracer; may be nullptr to disable tracing
+     */
+    static void
+    replaceInstance(std::shared_ptr<util::trace::Tracer> instance);
+
+private:
+    static std::shared_ptr<util::trace::Tracer> instance_;
+};
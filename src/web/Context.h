@@ -40,7 +40,7 @@ struct Context : util::Taggable {
     boost::asio::yield_context yield;
     std::string method;
     std::uint32_t apiVersion;
-    boost::json::object params;
+    boost::json::object params;  ///< Moved into the handler by the engine, so it is empty once the request is executed
     std::shared_ptr<web::ConnectionBase> session;
     data::LedgerRange range;
     std::string clientIp;
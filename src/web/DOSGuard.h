@@ -22,6 +22,7 @@
 #include <util/config/Config.h>
 #include <util/log/Logger.h>
 #include <web/IntervalSweepHandler.h>
+#include <web/IpKey.h>
 #include <web/WhitelistHandler.h>
 
 #include <boost/asio.hpp>
@@ -66,8 +67,8 @@ class BasicDOSGuard : public BaseDOSGuard {
 
     mutable std::mutex mtx_;
     // accumulated states map
-    std::unordered_map<std::string, ClientState> ipState_;
-    std::unordered_map<std::string, std::uint32_t> ipConnCount_;
+    std::unordered_map<IpKey, ClientState> ipState_;
+    std::unordered_map<IpKey, std::uint32_t> ipConnCount_;
     std::reference_wrapper<WhitelistHandlerType const> whitelistHandler_;
 
     std::uint32_t const maxFetches_;
@@ -108,6 +109,19 @@ public:
      */
     [[nodiscard]] bool
     isWhiteListed(std::string_view const ip) const noexcept
+    {
+        return isWhiteListed(makeIpKey(ip));
+    }
+
+    /**
+     * @brief Check whether an ip address is in the whitelist or not.
+     *
+     * @param ip The binary key of the ip address to check
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] bool
+    isWhiteListed(IpKey const& ip) const noexcept
     {
         return whitelistHandler_.get().isWhiteListed(ip);
     }
@@ -122,29 +136,24 @@ public:
     [[nodiscard]] bool
     isOk(std::string const& ip) const noexcept
     {
-        if (whitelistHandler_.get().isWhiteListed(ip))
+        return isOk(makeIpKey(ip));
+    }
+
+    /**
+     * @brief Check whether an ip address is currently rate limited or not.
+     *
+     * @param ip The binary key of the ip address to check
+     * @return true If not rate limited
+     * @return false If rate limited and the request should not be processed
+     */
+    [[nodiscard]] bool
+    isOk(IpKey const& ip) const noexcept
+    {
+        if (isWhiteListed(ip))
             return true;
 
-        {
-            std::scoped_lock const lck(mtx_);
-            if (ipState_.find(ip) != ipState_.end()) {
-                auto [transferedByte, requests] = ipState_.at(ip);
-                if (transferedByte > maxFetches_ || requests > maxRequestCount_) {
-                    LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                     << " Transfered Byte: " << transferedByte << "; Requests: " << requests;
-                    return false;
-                }
-            }
-            auto it = ipConnCount_.find(ip);
-            if (it != ipConnCount_.end()) {
-                if (it->second > maxConnCount_) {
-                    LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                     << " Concurrent connection: " << it->second;
-                    return false;
-                }
-            }
-        }
-        return true;
+        std::scoped_lock const lck(mtx_);
+        return isWithinLimits(ip);
     }
 
     /**
@@ -155,7 +164,18 @@ public:
     void
     increment(std::string const& ip) noexcept
     {
-        if (whitelistHandler_.get().isWhiteListed(ip))
+        increment(makeIpKey(ip));
+    }
+
+    /**
+     * @brief Increment connection count for the given ip address.
+     *
+     * @param ip The binary key of the ip address
+     */
+    void
+    increment(IpKey const& ip) noexcept
+    {
+        if (isWhiteListed(ip))
             return;
         std::scoped_lock const lck{mtx_};
         ipConnCount_[ip]++;
@@ -169,7 +189,18 @@ public:
     void
     decrement(std::string const& ip) noexcept
     {
-        if (whitelistHandler_.get().isWhiteListed(ip))
+        decrement(makeIpKey(ip));
+    }
+
+    /**
+     * @brief Decrement connection count for the given ip address.
+     *
+     * @param ip The binary key of the ip address
+     */
+    void
+    decrement(IpKey const& ip) noexcept
+    {
+        if (isWhiteListed(ip))
             return;
         std::scoped_lock const lck{mtx_};
         assert(ipConnCount_[ip] > 0);
@@ -193,40 +224,63 @@ public:
     [[maybe_unused]] bool
     add(std::string const& ip, uint32_t numObjects) noexcept
     {
-        if (whitelistHandler_.get().isWhiteListed(ip))
-            return true;
+        return add(makeIpKey(ip), numObjects);
+    }
 
-        {
-            std::scoped_lock const lck(mtx_);
-            ipState_[ip].transferedByte += numObjects;
-        }
+    /**
+     * @brief Adds numObjects of usage for the given ip address.
+     *
+     * @param ip The binary key of the ip address
+     * @param numObjects
+     * @return true If the client is still within its limits
+     * @return false If the client surpassed the limits
+     */
+    [[maybe_unused]] bool
+    add(IpKey const& ip, uint32_t numObjects) noexcept
+    {
+        if (isWhiteListed(ip))
+            return true;
 
-        return isOk(ip);
+        std::scoped_lock const lck(mtx_);
+        ipState_[ip].transferedByte += numObjects;
+        return isWithinLimits(ip);
     }
 
     /**
-     * @brief Adds one request for the given ip address.
+     * @brief Adds numRequests requests for the given ip address.
      *
      * If the total sums up to a value equal or larger than maxRequestCount_
      * the operation is no longer allowed and false is returned; true is
      * returned otherwise.
      *
      * @param ip
+     * @param numRequests The number of requests to add; defaults to one
      * @return true
      * @return false
      */
     [[maybe_unused]] bool
-    request(std::string const& ip) noexcept
+    request(std::string const& ip, std::uint32_t numRequests = 1) noexcept
     {
-        if (whitelistHandler_.get().isWhiteListed(ip))
-            return true;
+        return request(makeIpKey(ip), numRequests);
+    }
 
-        {
-            std::scoped_lock const lck(mtx_);
-            ipState_[ip].requestsCount++;
-        }
+    /**
+     * @brief Adds numRequests requests for the given ip address.
+     *
+     * @param ip The binary key of the ip address
+     * @param numRequests The number of requests to add; defaults to one
+     * @return true If the client is still within its limits
+     * @return false If the client surpassed the limits
+     */
+    [[maybe_unused]] bool
+    request(IpKey const& ip, std::uint32_t numRequests = 1) noexcept
+    {
+        if (isWhiteListed(ip))
+            return true;
 
-        return isOk(ip);
+        std::scoped_lock const lck(mtx_);
+        ipState_[ip].requestsCount += numRequests;
+        return isWithinLimits(ip);
     }
 
     /**
@@ -240,6 +294,28 @@ public:
     }
 
 private:
+    // must be called with mtx_ locked
+    [[nodiscard]] bool
+    isWithinLimits(IpKey const& ip) const
+    {
+        if (auto const it = ipState_.find(ip); it != ipState_.end()) {
+            auto const [transferedByte, requests] = it->second;
+            if (transferedByte > maxFetches_ || requests > maxRequestCount_) {
+                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip.toString()
+                                 << " Transfered Byte: " << transferedByte << "; Requests: " << requests;
+                return false;
+            }
+        }
+        if (auto const it = ipConnCount_.find(ip); it != ipConnCount_.end()) {
+            if (it->second > maxConnCount_) {
+                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip.toString()
+                                 << " Concurrent connection: " << it->second;
+                return false;
+            }
+        }
+        return true;
+    }
+
     [[nodiscard]] std::unordered_set<std::string>
     getWhitelist(util::Config const& config) const
     {
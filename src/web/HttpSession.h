@@ -39,6 +39,8 @@ class HttpSession : public detail::HttpBase<HttpSession, HandlerType>,
                     public std::enable_shared_from_this<HttpSession<HandlerType>> {
     boost::beast::tcp_stream stream_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
+    std::shared_ptr<detail::WsCompression> compression_;
+    ConnectionGuard connectionGuard_;
 
 public:
     /**
@@ -50,6 +52,8 @@ public:
      * @param tagFactory A factory that is used to generate tags to track requests and sessions
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
+     * @param compression The websocket compression to use after an upgrade
+     * @param connectionGuard Keeps the connection counted as open while the session owns it
      * @param buffer Buffer with initial data received from the peer
      */
     explicit HttpSession(
@@ -59,6 +63,8 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<web::DOSGuard> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
+        std::shared_ptr<detail::WsCompression> compression,
+        ConnectionGuard connectionGuard,
         boost::beast::flat_buffer buffer
     )
         : detail::HttpBase<HttpSession, HandlerType>(
@@ -71,6 +77,8 @@ public:
           )
         , stream_(std::move(socket))
         , tagFactory_(tagFactory)
+        , compression_(std::move(compression))
+        , connectionGuard_(std::move(connectionGuard))
     {
     }
 
@@ -113,6 +121,8 @@ public:
             tagFactory_,
             this->dosGuard_,
             this->handler_,
+            compression_,
+            connectionGuard_,
             std::move(this->buffer_),
             std::move(this->req_),
             ConnectionBase::isAdmin()
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <web/IpKey.h>
+
+#include <boost/asio/ip/address_v6.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace web {
+
+namespace {
+
+constexpr std::uint64_t V4_MAPPED_MARKER = 0x0000'ffff'0000'0000ULL;
+
+std::uint64_t
+maskWord(std::uint64_t word, std::size_t length)
+{
+    if (length == 0)
+        return 0;
+    if (length >= 64)
+        return word;
+    return word & (~std::uint64_t{0} << (64 - length));
+}
+
+}  // namespace
+
+IpKey
+IpKey::masked(std::size_t length) const
+{
+    if (length <= 64)
+        return IpKey{maskWord(high, length), 0};
+    return IpKey{high, maskWord(low, length - 64)};
+}
+
+std::size_t
+IpKey::commonPrefixLength(IpKey const& other, std::size_t limit) const
+{
+    std::size_t length = 0;
+    if (auto const diff = high ^ other.high; diff != 0) {
+        length = std::countl_zero(diff);
+    } else {
+        length = 64 + std::countl_zero(low ^ other.low);
+    }
+    return std::min(length, limit);
+}
+
+bool
+IpKey::isV4() const
+{
+    return high == 0 && (low & 0xffff'ffff'0000'0000ULL) == V4_MAPPED_MARKER;
+}
+
+std::string
+IpKey::toString() const
+{
+    if (isV4())
+        return boost::asio::ip::address_v4{static_cast<std::uint32_t>(low)}.to_string();
+
+    boost::asio::ip::address_v6::bytes_type bytes;
+    for (std::size_t i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<unsigned char>(high >> (56 - (8 * i)));
+        bytes[8 + i] = static_cast<unsigned char>(low >> (56 - (8 * i)));
+    }
+    return boost::asio::ip::address_v6{bytes}.to_string();
+}
+
+IpKey
+makeIpKey(boost::asio::ip::address const& address)
+{
+    if (address.is_v4())
+        return IpKey{0, V4_MAPPED_MARKER | address.to_v4().to_uint()};
+
+    auto const bytes = address.to_v6().to_bytes();
+    IpKey key;
+    for (std::size_t i = 0; i < 8; ++i) {
+        key.high = (key.high << 8) | bytes[i];
+        key.low = (key.low << 8) | bytes[8 + i];
+    }
+    return key;
+}
+
+IpKey
+makeIpKey(std::string_view ip) noexcept
+{
+    boost::system::error_code ec;
+    auto const address = boost::asio::ip::make_address(ip, ec);
+    if (ec)
+        return IpKey{};
+    return makeIpKey(address);
+}
+
+}  // namespace web
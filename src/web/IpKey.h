@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/ip/address.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace web {
+
+/**
+ * @brief A compact binary representation of an IP address.
+ *
+ * Both families share the IPv6 address space: IPv4 addresses are stored as IPv4-mapped IPv6 addresses
+ * (`::ffff:a.b.c.d`). The 128 bits are kept as two big-endian words, so prefixes can be compared with a couple of
+ * integer operations.
+ */
+struct IpKey {
+    static constexpr std::size_t BITS = 128;
+    static constexpr std::size_t V4_MAPPED_PREFIX = 96;
+
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+
+    /**
+     * @param index The index of the bit, starting from the most significant one
+     * @return The value of the bit
+     */
+    [[nodiscard]] bool
+    bit(std::size_t index) const
+    {
+        if (index < 64)
+            return ((high >> (63 - index)) & 1u) != 0;
+        return ((low >> (127 - index)) & 1u) != 0;
+    }
+
+    /**
+     * @param length The number of leading bits to keep
+     * @return A copy of this key with all bits past the first `length` set to zero
+     */
+    [[nodiscard]] IpKey
+    masked(std::size_t length) const;
+
+    /**
+     * @param other The key to compare with
+     * @param limit The maximum number of bits to compare
+     * @return The number of leading bits both keys have in common, at most `limit`
+     */
+    [[nodiscard]] std::size_t
+    commonPrefixLength(IpKey const& other, std::size_t limit = BITS) const;
+
+    /**
+     * @return true if the key holds an IPv4-mapped address; false otherwise
+     */
+    [[nodiscard]] bool
+    isV4() const;
+
+    /**
+     * @return The textual form of the address; IPv4 addresses are printed in dotted decimal notation
+     */
+    [[nodiscard]] std::string
+    toString() const;
+
+    bool
+    operator==(IpKey const&) const = default;
+};
+
+/**
+ * @brief Build the key of an address.
+ *
+ * @param address The address
+ * @return The binary key of the address
+ */
+[[nodiscard]] IpKey
+makeIpKey(boost::asio::ip::address const& address);
+
+/**
+ * @brief Parse an address into its key.
+ *
+ * Addresses that can't be parsed (e.g. the empty string used when the remote endpoint is unknown) are mapped to the
+ * unspecified address `::`.
+ *
+ * @param ip The textual form of the address
+ * @return The binary key of the address
+ */
+[[nodiscard]] IpKey
+makeIpKey(std::string_view ip) noexcept;
+
+}  // namespace web
+
+template <>
+struct std::hash<web::IpKey> {
+    std::size_t
+    operator()(web::IpKey const& key) const noexcept
+    {
+        auto const seed = std::hash<std::uint64_t>{}(key.high);
+        return seed ^ (std::hash<std::uint64_t>{}(key.low) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    }
+};
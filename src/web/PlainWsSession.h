@@ -32,8 +32,9 @@ namespace web {
  */
 template <SomeServerHandler HandlerType>
 class PlainWsSession : public detail::WsBase<PlainWsSession, HandlerType> {
-    using StreamType = boost::beast::websocket::stream<boost::beast::tcp_stream>;
+    using StreamType = boost::beast::websocket::stream<detail::MeteredStream<boost::beast::tcp_stream>>;
     StreamType ws_;
+    ConnectionGuard connectionGuard_;
 
 public:
     /**
@@ -44,6 +45,8 @@ public:
      * @param tagFactory A factory that is used to generate tags to track requests and sessions
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
+     * @param compression The websocket compression to use
+     * @param connectionGuard Keeps the connection counted as open while the session owns it
      * @param buffer Buffer with initial data received from the peer
      * @param isAdmin Whether the connection has admin privileges
      */
@@ -53,11 +56,21 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<web::DOSGuard> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
+        std::shared_ptr<detail::WsCompression> compression,
+        ConnectionGuard connectionGuard,
         boost::beast::flat_buffer&& buffer,
         bool isAdmin
     )
-        : detail::WsBase<PlainWsSession, HandlerType>(ip, tagFactory, dosGuard, handler, std::move(buffer))
+        : detail::WsBase<PlainWsSession, HandlerType>(
+              ip,
+              tagFactory,
+              dosGuard,
+              handler,
+              std::move(compression),
+              std::move(buffer)
+          )
         , ws_(std::move(socket))
+        , connectionGuard_(std::move(connectionGuard))
     {
         ConnectionBase::isAdmin_ = isAdmin;  // NOLINT(cppcoreguidelines-prefer-member-initializer)
     }
@@ -89,6 +102,8 @@ class WsUpgrader : public std::enable_shared_from_this<WsUpgrader<HandlerType>>
     http::request<http::string_body> req_;
     std::string ip_;
     std::shared_ptr<HandlerType> const handler_;
+    std::shared_ptr<detail::WsCompression> compression_;
+    ConnectionGuard connectionGuard_;
     bool isAdmin_;
 
 public:
@@ -100,6 +115,8 @@ public:
      * @param tagFactory A factory that is used to generate tags to track requests and sessions
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
+     * @param compression The websocket compression to use
+     * @param connectionGuard Keeps the connection counted as open while the session owns it
      * @param buffer Buffer with initial data received from the peer. Ownership is transferred
      * @param request The request. Ownership is transferred
      * @param isAdmin Whether the connection has admin privileges
@@ -110,6 +127,8 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<web::DOSGuard> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
+        std::shared_ptr<detail::WsCompression> compression,
+        ConnectionGuard connectionGuard,
         boost::beast::flat_buffer&& buffer,
         http::request<http::string_body> request,
         bool isAdmin
@@ -121,6 +140,8 @@ public:
         , req_(std::move(request))
         , ip_(std::move(ip))
         , handler_(handler)
+        , compression_(std::move(compression))
+        , connectionGuard_(std::move(connectionGuard))
         , isAdmin_(isAdmin)
     {
     }
@@ -158,7 +179,15 @@ private:
         boost::beast::get_lowest_layer(http_).expires_never();
 
         std::make_shared<PlainWsSession<HandlerType>>(
-            http_.release_socket(), ip_, tagFactory_, dosGuard_, handler_, std::move(buffer_), isAdmin_
+            http_.release_socket(),
+            ip_,
+            tagFactory_,
+            dosGuard_,
+            handler_,
+            std::move(compression_),
+            std::move(connectionGuard_),
+            std::move(buffer_),
+            isAdmin_
         )
             ->run(std::move(req_));
     }
@@ -24,11 +24,22 @@
 #include <rpc/RPCHelpers.h>
 #include <rpc/common/impl/APIVersionParser.h>
 #include <util/JsonUtils.h>
-#include <util/Profiler.h>
+#include <util/profiling/Profiling.h>
+#include <util/trace/ContextExecutor.h>
+#include <util/trace/Trace.h>
+#include <util/trace/TraceService.h>
 #include <web/impl/ErrorHandling.h>
 
+#include <boost/asio/spawn.hpp>
+#include <boost/json/monotonic_resource.hpp>
 #include <boost/json/parse.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
 namespace web {
 
 /**
@@ -45,11 +56,14 @@ class RPCServerHandler {
     std::weak_ptr<feed::SubscriptionManager> const subscriptions_;
     util::TagDecoratorFactory const tagFactory_;
     rpc::detail::ProductionAPIVersionParser apiVersionParser_;  // can be injected if needed
+    std::uint32_t const maxBatchSize_;
 
     util::Logger log_{"RPC"};
     util::Logger perfLog_{"Performance"};
 
 public:
+    static constexpr std::uint32_t DEFAULT_MAX_BATCH_SIZE = 100u;
+
     /**
      * @brief Create a new server handler.
      *
@@ -72,6 +86,7 @@ public:
         , subscriptions_(subscriptions)
         , tagFactory_(config)
         , apiVersionParser_(config.sectionOr("api_version", {}))
+        , maxBatchSize_(config.valueOr("server.max_batch_size", DEFAULT_MAX_BATCH_SIZE))
     {
     }
 
@@ -84,8 +99,18 @@ public:
     void
     operator()(std::string const& request, std::shared_ptr<web::ConnectionBase> const& connection)
     {
+        // the trace lives until the work queue job and the write of the response are done
+        util::trace::TraceScope const traceScope{startTrace(connection)};
+
         try {
-            auto req = boost::json::parse(request).as_object();
+            auto parsed = [&] {
+                util::trace::Span const span{"json.parse"};
+                return boost::json::parse(request, makeRequestStorage());
+            }();
+            if (parsed.is_array() and maxBatchSize_ > 0)
+                return postBatch(std::move(parsed.as_array()), connection);
+
+            auto req = std::move(parsed.as_object());
             LOG(perfLog_.debug()) << connection->tag() << "Adding to work queue";
 
             if (not connection->upgraded and shouldReplaceParams(req))
@@ -131,6 +156,231 @@ public:
     }
 
 private:
+    static std::shared_ptr<util::trace::Trace>
+    startTrace(std::shared_ptr<web::ConnectionBase> const& connection)
+    {
+        auto trace = TraceService::startTrace(connection->upgraded ? "ws.request" : "http.request");
+        if (!trace)
+            return trace;
+
+        // links the trace to the log lines of the request
+        std::ostringstream tag;
+        tag << connection->tag();
+        trace->setAttribute("clio.tag", tag.str());
+        trace->setAttribute("client.address", connection->clientIp);
+        return trace;
+    }
+
+    void
+    postBatch(boost::json::array&& batch, std::shared_ptr<web::ConnectionBase> const& connection)
+    {
+        if (batch.empty() or batch.size() > maxBatchSize_) {
+            rpcEngine_->notifyBadSyntax();
+            return web::detail::ErrorHelper(connection).sendJsonParsingError(
+                fmt::format("batch must contain between 1 and {} requests", maxBatchSize_)
+            );
+        }
+
+        // the message carrying the batch was already counted by the session; account for the rest of the batch
+        if (!rpcEngine_->requestBatch(connection->clientIp, batch.size()))
+            return web::detail::ErrorHelper(connection).sendSlowDownError();
+
+        LOG(perfLog_.debug()) << connection->tag() << "Adding batch of " << batch.size() << " to work queue";
+
+        // the whole batch takes a single slot in the work queue
+        if (!rpcEngine_->post(
+                [this, batch = std::move(batch), connection](boost::asio::yield_context yield) mutable {
+                    handleBatch(yield, std::move(batch), connection);
+                },
+                connection->clientIp
+            )) {
+            rpcEngine_->notifyTooBusy();
+            web::detail::ErrorHelper(connection).sendTooBusyError();
+        }
+    }
+
+    void
+    handleBatch(
+        boost::asio::yield_context yield,
+        boost::json::array&& batch,
+        std::shared_ptr<web::ConnectionBase> const& connection
+    )
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto responses = boost::json::array(batch.size());
+        std::atomic_size_t numOutstanding = batch.size();
+
+        // every request of the batch runs in its own coroutine; this coroutine resumes when the last one completes
+        auto init = [this, &yield, &batch, &responses, &numOutstanding, &connection]<typename Self>(Self& self) {
+            auto sself = std::make_shared<Self>(std::move(self));
+
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                auto process = [this, i, sself, &batch, &responses, &numOutstanding, &connection](auto innerYield) {
+                    responses[i] = processBatchElement(innerYield, batch[i], connection);
+
+                    if (--numOutstanding == 0) {
+                        boost::asio::post(boost::asio::get_associated_executor(*sself), [sself]() mutable {
+                            sself->complete();
+                        });
+                    }
+                };
+
+                // each request of the batch gets its own context, so their spans don't nest in each other
+                boost::asio::spawn(
+                    util::trace::make_ContextExecutor(yield.get_executor(), util::trace::current()), std::move(process)
+                );
+            }
+        };
+
+        boost::asio::async_compose<boost::asio::yield_context, void()>(init, yield, yield.get_executor());
+
+        rpcEngine_->notifyBatch(
+            batch.size(),
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+        );
+        connection->send(serialize(responses));
+    }
+
+    boost::json::object
+    processBatchElement(
+        boost::asio::yield_context yield,
+        boost::json::value const& element,
+        std::shared_ptr<web::ConnectionBase> const& connection
+    )
+    {
+        if (!element.is_object()) {
+            rpcEngine_->notifyBadSyntax();
+            return web::detail::ErrorHelper(connection).composeError(rpc::RippledError::rpcBAD_SYNTAX);
+        }
+
+        // batch elements run concurrently and the arena is not thread-safe, so every element gets its own
+        auto request = boost::json::object(element.as_object(), makeRequestStorage());
+        if (not connection->upgraded and shouldReplaceParams(request))
+            request[JS(params)] = boost::json::array({boost::json::object{}});
+
+        try {
+            auto const range = backend_->fetchLedgerRange();
+            if (!range) {
+                rpcEngine_->notifyNotReady();
+                return web::detail::ErrorHelper(connection, request).composeError(rpc::RippledError::rpcNOT_READY);
+            }
+
+            auto context = makeContext(yield, request, connection, *range);
+            if (!context) {
+                rpcEngine_->notifyBadSyntax();
+                return web::detail::ErrorHelper(connection, request).composeError(context.error());
+            }
+
+            static util::profiling::Zone const zone{"rpc.build_response"};
+            auto [result, timeDiff] =
+                util::profiling::timed(zone, [&]() { return rpcEngine_->buildResponse(*context); });
+
+            auto us = std::chrono::duration<int, std::milli>(timeDiff);
+            rpc::logDuration(*context, request, us);
+
+            boost::json::object response;
+            if (auto const status = std::get_if<rpc::Status>(&result)) {
+                // note: error statuses are counted/notified in buildResponse itself
+                response = web::detail::ErrorHelper(connection, request).composeError(*status);
+            } else {
+                rpcEngine_->notifyComplete(context->method, us);
+                response = composeResponse(std::get<boost::json::object>(result), request, connection);
+            }
+
+            response["warnings"] = makeWarnings();
+            return response;
+        } catch (std::exception const& ex) {
+            LOG(perfLog_.error()) << connection->tag() << "Caught exception in batch: " << ex.what();
+            LOG(log_.error()) << connection->tag() << "Caught exception in batch: " << ex.what();
+
+            rpcEngine_->notifyInternalError();
+            return web::detail::ErrorHelper(connection, request).composeError(rpc::RippledError::rpcINTERNAL);
+        }
+    }
+
+    util::Expected<web::Context, rpc::Status>
+    makeContext(
+        boost::asio::yield_context yield,
+        boost::json::object const& request,
+        std::shared_ptr<web::ConnectionBase> const& connection,
+        data::LedgerRange const& range
+    ) const
+    {
+        if (connection->upgraded) {
+            return rpc::make_WsContext(
+                yield,
+                request,
+                connection,
+                tagFactory_.with(connection->tag()),
+                range,
+                connection->clientIp,
+                std::cref(apiVersionParser_)
+            );
+        }
+        return rpc::make_HttpContext(
+            yield,
+            request,
+            tagFactory_.with(connection->tag()),
+            range,
+            connection->clientIp,
+            std::cref(apiVersionParser_),
+            connection->isAdmin()
+        );
+    }
+
+    boost::json::object
+    composeResponse(
+        boost::json::object const& json,
+        boost::json::object const& request,
+        std::shared_ptr<web::ConnectionBase> const& connection
+    ) const
+    {
+        boost::json::object response(request.storage());
+        auto const isForwarded =
+            json.contains("forwarded") && json.at("forwarded").is_bool() && json.at("forwarded").as_bool();
+
+        // if the result is forwarded - just use it as is
+        // if forwarded request has error, for http, error should be in "result"; for ws, error should
+        // be at top
+        if (isForwarded && (json.contains("result") || connection->upgraded)) {
+            for (auto const& [k, v] : json)
+                response.insert_or_assign(k, v);
+        } else {
+            response["result"] = json;
+        }
+
+        // for ws there is an additional field "status" in the response,
+        // otherwise the "status" is in the "result" field
+        if (connection->upgraded) {
+            auto const id = request.contains("id") ? request.at("id") : nullptr;
+
+            if (not id.is_null())
+                response["id"] = id;
+
+            if (!response.contains("error"))
+                response["status"] = "success";
+
+            response["type"] = "response";
+        } else {
+            if (response.contains("result") && !response["result"].as_object().contains("error"))
+                response["result"].as_object()["status"] = "success";
+        }
+
+        return response;
+    }
+
+    boost::json::array
+    makeWarnings() const
+    {
+        boost::json::array warnings;
+        warnings.emplace_back(rpc::makeWarning(rpc::warnRPC_CLIO));
+
+        if (etl_->lastCloseAgeSeconds() >= 60)
+            warnings.emplace_back(rpc::makeWarning(rpc::warnRPC_OUTDATED));
+
+        return warnings;
+    }
+
     void
     handleRequest(
         boost::asio::yield_context yield,
@@ -150,28 +400,7 @@ private:
                 return web::detail::ErrorHelper(connection, request).sendNotReadyError();
             }
 
-            auto const context = [&] {
-                if (connection->upgraded) {
-                    return rpc::make_WsContext(
-                        yield,
-                        request,
-                        connection,
-                        tagFactory_.with(connection->tag()),
-                        *range,
-                        connection->clientIp,
-                        std::cref(apiVersionParser_)
-                    );
-                }
-                return rpc::make_HttpContext(
-                    yield,
-                    request,
-                    tagFactory_.with(connection->tag()),
-                    *range,
-                    connection->clientIp,
-                    std::cref(apiVersionParser_),
-                    connection->isAdmin()
-                );
-            }();
+            auto context = makeContext(yield, request, connection, *range);
 
             if (!context) {
                 auto const err = context.error();
@@ -184,12 +413,14 @@ private:
                 return web::detail::ErrorHelper(connection, request).sendError(err);
             }
 
-            auto [result, timeDiff] = util::timed([&]() { return rpcEngine_->buildResponse(*context); });
+            static util::profiling::Zone const zone{"rpc.build_response"};
+            auto [result, timeDiff] =
+                util::profiling::timed(zone, [&]() { return rpcEngine_->buildResponse(*context); });
 
             auto us = std::chrono::duration<int, std::milli>(timeDiff);
-            rpc::logDuration(*context, us);
+            rpc::logDuration(*context, request, us);
 
-            boost::json::object response;
+            boost::json::object response(request.storage());
             if (auto const status = std::get_if<rpc::Status>(&result)) {
                 // note: error statuses are counted/notified in buildResponse itself
                 response = web::detail::ErrorHelper(connection, request).composeError(*status);
@@ -200,47 +431,11 @@ private:
             } else {
                 // This can still technically be an error. Clio counts forwarded requests as successful.
                 rpcEngine_->notifyComplete(context->method, us);
-
-                auto& json = std::get<boost::json::object>(result);
-                auto const isForwarded =
-                    json.contains("forwarded") && json.at("forwarded").is_bool() && json.at("forwarded").as_bool();
-
-                // if the result is forwarded - just use it as is
-                // if forwarded request has error, for http, error should be in "result"; for ws, error should
-                // be at top
-                if (isForwarded && (json.contains("result") || connection->upgraded)) {
-                    for (auto const& [k, v] : json)
-                        response.insert_or_assign(k, v);
-                } else {
-                    response["result"] = json;
-                }
-
-                // for ws there is an additional field "status" in the response,
-                // otherwise the "status" is in the "result" field
-                if (connection->upgraded) {
-                    auto const id = request.contains("id") ? request.at("id") : nullptr;
-
-                    if (not id.is_null())
-                        response["id"] = id;
-
-                    if (!response.contains("error"))
-                        response["status"] = "success";
-
-                    response["type"] = "response";
-                } else {
-                    if (response.contains("result") && !response["result"].as_object().contains("error"))
-                        response["result"].as_object()["status"] = "success";
-                }
+                response = composeResponse(std::get<boost::json::object>(result), request, connection);
             }
 
-            boost::json::array warnings;
-            warnings.emplace_back(rpc::makeWarning(rpc::warnRPC_CLIO));
-
-            if (etl_->lastCloseAgeSeconds() >= 60)
-                warnings.emplace_back(rpc::makeWarning(rpc::warnRPC_OUTDATED));
-
-            response["warnings"] = warnings;
-            connection->send(boost::json::serialize(response));
+            response["warnings"] = makeWarnings();
+            connection->send(serialize(response));
         } catch (std::exception const& ex) {
             // note: while we are catching this in buildResponse too, this is here to make sure
             // that any other code that may throw is outside of buildResponse is also worked around.
@@ -252,6 +447,28 @@ private:
         }
     }
 
+    static std::string
+    serialize(boost::json::value const& response)
+    {
+        util::trace::Span const span{"json.serialize"};
+        return boost::json::serialize(response);
+    }
+
+    /**
+     * @brief Make the arena that the JSON of a single request is allocated from.
+     *
+     * The request, its copies in the contexts, the output of the handler (see rpc::Context::storage) and the response
+     * envelope all share the arena, which is released in one go once the last JSON value using it is destroyed. The
+     * arena is not thread-safe: values using it must only be modified from the coroutine handling the request.
+     *
+     * @return The storage of the arena
+     */
+    static boost::json::storage_ptr
+    makeRequestStorage()
+    {
+        return boost::json::make_shared_resource<boost::json::monotonic_resource>();
+    }
+
     bool
     shouldReplaceParams(boost::json::object const& req) const
     {
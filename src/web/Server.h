@@ -20,12 +20,19 @@
 #pragma once
 
 #include <util/log/Logger.h>
+#include <util/prometheus/Prometheus.h>
 #include <web/HttpSession.h>
+#include <web/ServerShards.h>
 #include <web/SslHttpSession.h>
 #include <web/interface/Concepts.h>
 
 #include <fmt/core.h>
 
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
 /**
  * @brief This namespace implements the web server and related components.
  *
@@ -58,6 +65,8 @@ class Detector : public std::enable_shared_from_this<Detector<PlainSessionType,
     std::shared_ptr<HandlerType> const handler_;
     boost::beast::flat_buffer buffer_;
     std::shared_ptr<detail::AdminVerificationStrategy> const adminVerification_;
+    std::shared_ptr<detail::WsCompression> const compression_;
+    ConnectionGuard const connectionGuard_;
 
 public:
     /**
@@ -68,7 +77,9 @@ public:
      * @param tagFactory A factory that is used to generate tags to track requests and sessions
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
-     * @param adminPassword The optional password to verify admin role in requests
+     * @param adminVerification The strategy to verify admin role in requests
+     * @param compression The websocket compression to use
+     * @param connectionGuard Keeps the connection counted as open while the detector owns it
      */
     Detector(
         tcp::socket&& socket,
@@ -76,7 +87,9 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<web::DOSGuard> dosGuard,
         std::shared_ptr<HandlerType> handler,
-        std::shared_ptr<detail::AdminVerificationStrategy> adminVerification
+        std::shared_ptr<detail::AdminVerificationStrategy> adminVerification,
+        std::shared_ptr<detail::WsCompression> compression,
+        ConnectionGuard connectionGuard
     )
         : stream_(std::move(socket))
         , ctx_(ctx)
@@ -84,6 +97,8 @@ public:
         , dosGuard_(dosGuard)
         , handler_(std::move(handler))
         , adminVerification_(std::move(adminVerification))
+        , compression_(std::move(compression))
+        , connectionGuard_(std::move(connectionGuard))
     {
     }
 
@@ -141,6 +156,8 @@ public:
                 tagFactory_,
                 dosGuard_,
                 handler_,
+                compression_,
+                connectionGuard_,
                 std::move(buffer_)
             )
                 ->run();
@@ -148,7 +165,15 @@ public:
         }
 
         std::make_shared<PlainSessionType<HandlerType>>(
-            stream_.release_socket(), ip, adminVerification_, tagFactory_, dosGuard_, handler_, std::move(buffer_)
+            stream_.release_socket(),
+            ip,
+            adminVerification_,
+            tagFactory_,
+            dosGuard_,
+            handler_,
+            compression_,
+            connectionGuard_,
+            std::move(buffer_)
         )
             ->run();
     }
@@ -159,6 +184,9 @@ public:
  *
  * Once there is client connection, it will accept it and pass the socket to Detector to detect ssl or plain.
  *
+ * If @ref ServerShards are given, one acceptor is opened with `SO_REUSEPORT` on each shard instead of a single one on
+ * the shared io_context, and every accepted connection lives on the io_context of the shard that accepted it.
+ *
  * @tparam PlainSessionType The plain session to handle non-ssl connection.
  * @tparam SslSessionType The SSL session to handle SSL connection.
  * @tparam HandlerType The handler to process the request and return response.
@@ -167,26 +195,35 @@ template <template <class> class PlainSessionType, template <class> class SslSes
 class Server : public std::enable_shared_from_this<Server<PlainSessionType, SslSessionType, HandlerType>> {
     using std::enable_shared_from_this<Server<PlainSessionType, SslSessionType, HandlerType>>::shared_from_this;
 
+    struct Listener {
+        std::reference_wrapper<boost::asio::io_context> ioc;
+        tcp::acceptor acceptor;
+        std::optional<std::size_t> shard;
+    };
+
     util::Logger log_{"WebServer"};
-    std::reference_wrapper<boost::asio::io_context> ioc_;
     std::optional<std::reference_wrapper<boost::asio::ssl::context>> ctx_;
     util::TagDecoratorFactory tagFactory_;
     std::reference_wrapper<web::DOSGuard> dosGuard_;
     std::shared_ptr<HandlerType> handler_;
-    tcp::acceptor acceptor_;
+    std::vector<Listener> listeners_;
     std::shared_ptr<detail::AdminVerificationStrategy> adminVerification_;
+    std::shared_ptr<detail::WsCompression> compression_;
+    std::optional<std::reference_wrapper<ServerShards>> shards_;
 
 public:
     /**
      * @brief Create a new instance of the web server.
      *
-     * @param ioc The io_context to run the server on
+     * @param ioc The io_context to run the server on when it is not sharded
      * @param ctx The SSL context if any
      * @param endpoint The endpoint to listen on
      * @param tagFactory A factory that is used to generate tags to track requests and sessions
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
      * @param adminPassword The optional password to verify admin role in requests
+     * @param compression The websocket compression to use
+     * @param shards The shards to accept connections on, kept alive by the caller; nullptr to accept them on ioc
      */
     Server(
         boost::asio::io_context& ioc,
@@ -195,27 +232,68 @@ public:
         util::TagDecoratorFactory tagFactory,
         web::DOSGuard& dosGuard,
         std::shared_ptr<HandlerType> handler,
-        std::optional<std::string> adminPassword
+        std::optional<std::string> adminPassword,
+        std::shared_ptr<detail::WsCompression> compression,
+        std::shared_ptr<ServerShards> const& shards = nullptr
     )
-        : ioc_(std::ref(ioc))
-        , ctx_(ctx)
+        : ctx_(ctx)
         , tagFactory_(tagFactory)
         , dosGuard_(std::ref(dosGuard))
         , handler_(std::move(handler))
-        , acceptor_(boost::asio::make_strand(ioc))
         , adminVerification_(detail::make_AdminVerificationStrategy(std::move(adminPassword)))
+        , compression_(std::move(compression))
+    {
+        if (not shards) {
+            listeners_.push_back(Listener{std::ref(ioc), tcp::acceptor{boost::asio::make_strand(ioc)}, std::nullopt});
+            listen(listeners_.back().acceptor, endpoint, false);
+            return;
+        }
+
+        shards_ = std::ref(*shards);
+        listeners_.reserve(shards->size());
+        for (std::size_t i = 0; i < shards->size(); ++i) {
+            auto& shardIoc = shards->ioContext(i);
+            listeners_.push_back(Listener{std::ref(shardIoc), tcp::acceptor{shardIoc}, i});
+            listen(listeners_.back().acceptor, endpoint, true);
+        }
+    }
+
+    /** @brief Start accepting incoming connections. */
+    void
+    run()
+    {
+        for (std::size_t i = 0; i < listeners_.size(); ++i)
+            doAccept(i);
+    }
+
+private:
+    void
+    listen(tcp::acceptor& acceptor, tcp::endpoint const& endpoint, bool reusePort)
     {
         boost::beast::error_code ec;
 
-        acceptor_.open(endpoint.protocol(), ec);
+        acceptor.open(endpoint.protocol(), ec);
         if (ec)
             return;
 
-        acceptor_.set_option(boost::asio::socket_base::reuse_address(true), ec);
+        acceptor.set_option(boost::asio::socket_base::reuse_address(true), ec);
         if (ec)
             return;
 
-        acceptor_.bind(endpoint, ec);
+        if (reusePort) {
+#ifdef SO_REUSEPORT
+            acceptor.set_option(ReusePort(true), ec);
+#endif
+            if (ec) {
+                LOG(log_.error()) << "Failed to set SO_REUSEPORT on endpoint: " << endpoint
+                                  << ". message: " << ec.message();
+                throw std::runtime_error(fmt::format(
+                    "Failed to set SO_REUSEPORT on endpoint: {}:{}", endpoint.address().to_string(), endpoint.port()
+                ));
+            }
+        }
+
+        acceptor.bind(endpoint, ec);
         if (ec) {
             LOG(log_.error()) << "Failed to bind to endpoint: " << endpoint << ". message: " << ec.message();
             throw std::runtime_error(
@@ -223,7 +301,7 @@ public:
             );
         }
 
-        acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec);
+        acceptor.listen(boost::asio::socket_base::max_listen_connections, ec);
         if (ec) {
             LOG(log_.error()) << "Failed to listen at endpoint: " << endpoint << ". message: " << ec.message();
             throw std::runtime_error(
@@ -232,37 +310,41 @@ public:
         }
     }
 
-    /** @brief Start accepting incoming connections. */
-    void
-    run()
-    {
-        doAccept();
-    }
-
-private:
     void
-    doAccept()
+    doAccept(std::size_t index)
     {
-        acceptor_.async_accept(
-            boost::asio::make_strand(ioc_.get()),
-            boost::beast::bind_front_handler(&Server::onAccept, shared_from_this())
+        auto& listener = listeners_[index];
+        listener.acceptor.async_accept(
+            boost::asio::make_strand(listener.ioc.get()),
+            boost::beast::bind_front_handler(&Server::onAccept, shared_from_this(), index)
         );
     }
 
     void
-    onAccept(boost::beast::error_code ec, tcp::socket socket)
+    onAccept(std::size_t index, boost::beast::error_code ec, tcp::socket socket)
     {
         if (!ec) {
+            ConnectionGuard connectionGuard;
+            if (auto const& shard = listeners_[index].shard; shard)
+                connectionGuard = shards_->get().openConnection(*shard);
+
             auto ctxRef =
                 ctx_ ? std::optional<std::reference_wrapper<boost::asio::ssl::context>>{ctx_.value()} : std::nullopt;
 
             std::make_shared<Detector<PlainSessionType, SslSessionType, HandlerType>>(
-                std::move(socket), ctxRef, std::cref(tagFactory_), dosGuard_, handler_, adminVerification_
+                std::move(socket),
+                ctxRef,
+                std::cref(tagFactory_),
+                dosGuard_,
+                handler_,
+                adminVerification_,
+                compression_,
+                std::move(connectionGuard)
             )
                 ->run();
         }
 
-        doAccept();
+        doAccept(index);
     }
 };
 
@@ -279,6 +361,7 @@ using HttpServer = Server<HttpSession, SslHttpSession, HandlerType>;
  * @param ctx The SSL context if any
  * @param dosGuard The dos guard to protect the server
  * @param handler The handler to process the request
+ * @param shards The shards to accept connections on if the server is sharded; the caller keeps them alive
  */
 template <class HandlerType>
 static std::shared_ptr<HttpServer<HandlerType>>
@@ -287,7 +370,8 @@ make_HttpServer(
     boost::asio::io_context& ioc,
     std::optional<std::reference_wrapper<boost::asio::ssl::context>> const& ctx,
     web::DOSGuard& dosGuard,
-    std::shared_ptr<HandlerType> const& handler
+    std::shared_ptr<HandlerType> const& handler,
+    std::shared_ptr<ServerShards> const& shards = nullptr
 )
 {
     static util::Logger const log{"WebServer"};
@@ -320,7 +404,9 @@ make_HttpServer(
         util::TagDecoratorFactory(config),
         dosGuard,
         handler,
-        std::move(adminPassword)
+        std::move(adminPassword),
+        detail::make_WsCompression(serverConfig),
+        shards
     );
 
     server->run();
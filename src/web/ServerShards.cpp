@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <web/ServerShards.h>
+
+#include <boost/system/error_code.hpp>
+#include <fmt/format.h>
+
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace web {
+
+ServerShards::Shard::Shard(
+    util::prometheus::GaugeInt& loopLag,
+    util::prometheus::CounterInt& accepted,
+    util::prometheus::GaugeInt& connections
+)
+    : loopLag(loopLag), accepted(accepted), connections(connections)
+{
+}
+
+ServerShards::ServerShards(ServerShardsSettings settings) : settings_(settings)
+{
+    shards_.reserve(settings_.count);
+    for (std::size_t i = 0; i < settings_.count; ++i) {
+        auto const labels = util::prometheus::Labels({util::prometheus::Label{"shard", std::to_string(i)}});
+        shards_.push_back(std::make_unique<Shard>(
+            PrometheusService::gaugeInt(
+                "server_shard_event_loop_lag_probe_us",
+                labels,
+                "How late the event loop of the server shard ran its last lag probe timer"
+            ),
+            PrometheusService::counterInt(
+                "server_shard_accepted_total_number", labels, "Total number of connections accepted by the server shard"
+            ),
+            PrometheusService::gaugeInt(
+                "server_shard_connections_current_number",
+                labels,
+                "Current number of open connections of the server shard"
+            )
+        ));
+    }
+
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        auto& shard = *shards_[i];
+        scheduleLagProbe(shard);
+        shard.thread = std::thread([&shard] { shard.ioc.run(); });
+
+        if (settings_.pinThreads)
+            pinThread(shard.thread, settings_.firstCpu + i);
+    }
+
+    LOG(log_.info()) << "Started " << shards_.size() << " server shards"
+                     << (settings_.pinThreads ? fmt::format(" pinned from CPU {}", settings_.firstCpu) : "");
+}
+
+ServerShards::~ServerShards()
+{
+    stop();
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable())
+            shard->thread.join();
+    }
+}
+
+void
+ServerShards::stop()
+{
+    for (auto& shard : shards_) {
+        shard->work.reset();
+        shard->ioc.stop();
+    }
+}
+
+ConnectionGuard
+ServerShards::openConnection(std::size_t index)
+{
+    auto& shard = *shards_.at(index);
+    ++shard.accepted.get();
+    ++shard.connections.get();
+
+    // the gauge is owned by the prometheus registry, so it outlives the shards and every connection
+    return ConnectionGuard{nullptr, [&connections = shard.connections.get()](void*) { --connections; }};
+}
+
+void
+ServerShards::scheduleLagProbe(Shard& shard)
+{
+    shard.lagProbe.expires_after(LAG_PROBE_INTERVAL);
+    shard.lagProbe.async_wait([this, &shard](boost::system::error_code const& ec) {
+        if (ec)
+            return;
+
+        auto const lag = std::chrono::steady_clock::now() - shard.lagProbe.expiry();
+        shard.loopLag.get().set(std::chrono::duration_cast<std::chrono::microseconds>(lag).count());
+        scheduleLagProbe(shard);
+    });
+}
+
+void
+ServerShards::pinThread(std::thread& thread, std::size_t cpu)
+{
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (auto const rc = pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet); rc != 0)
+        LOG(log_.warn()) << "Failed to pin server shard thread to CPU " << cpu << ": error " << rc;
+#else
+    LOG(log_.warn()) << "Pinning server shard threads is not supported on this platform; CPU " << cpu << " ignored";
+#endif
+}
+
+std::shared_ptr<ServerShards>
+make_ServerShards(util::Config const& config)
+{
+    if (!config.contains("server") || !config.section("server").contains("shards"))
+        return nullptr;
+
+    auto const section = config.section("server").section("shards");
+    ServerShardsSettings settings;
+    settings.count = section.valueOr("count", settings.count);
+    settings.pinThreads = section.valueOr("pin_threads", settings.pinThreads);
+    settings.firstCpu = section.valueOr("first_cpu", settings.firstCpu);
+
+    if (settings.count == 0)
+        return nullptr;
+
+#ifndef SO_REUSEPORT
+    throw std::logic_error("server.shards requires SO_REUSEPORT which is not available on this platform");
+#endif
+
+    auto const cpus = std::thread::hardware_concurrency();
+    if (settings.pinThreads && cpus != 0 && settings.firstCpu + settings.count > cpus) {
+        throw std::logic_error(fmt::format(
+            "server.shards pins {} threads from CPU {} but only {} CPUs are available",
+            settings.count,
+            settings.firstCpu,
+            cpus
+        ));
+    }
+
+    return std::make_shared<ServerShards>(settings);
+}
+
+}  // namespace web
@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/config/Config.h>
+#include <util/log/Logger.h>
+#include <util/prometheus/Prometheus.h>
+#include <web/interface/ConnectionBase.h>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace web {
+
+#ifdef SO_REUSEPORT
+/** @brief The socket option that lets several acceptors listen on the same port. */
+using ReusePort = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+/**
+ * @brief Settings of the sharded acceptor mode of one server.
+ */
+struct ServerShardsSettings {
+    std::size_t count = 0;
+    bool pinThreads = false;
+    std::size_t firstCpu = 0;
+};
+
+/**
+ * @brief A set of single-threaded io_contexts that own the connections of a server.
+ *
+ * Every shard runs its own acceptor on the server port with `SO_REUSEPORT` so the kernel spreads incoming connections
+ * between the shards. A connection is accepted on the io_context of its shard and all its handlers stay there until it
+ * is closed, so sessions never contend with each other on a shared scheduler. Work that is not tied to a connection
+ * (ETL, the RPC work queue, backend callbacks) keeps running on its own threads.
+ *
+ * Each shard thread can be pinned to its own CPU, starting from `firstCpu`. Every shard exports the connections it has
+ * accepted (`server_shard_accepted_total_number`), the ones that are still open
+ * (`server_shard_connections_current_number`) and how late its event loop ran the last of the timers it schedules every
+ * second as a lag probe (`server_shard_event_loop_lag_probe_us`).
+ */
+class ServerShards {
+    struct Shard {
+        boost::asio::io_context ioc{1};
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work =
+            boost::asio::make_work_guard(ioc);
+        boost::asio::steady_timer lagProbe{ioc};
+        std::reference_wrapper<util::prometheus::GaugeInt> loopLag;
+        std::reference_wrapper<util::prometheus::CounterInt> accepted;
+        std::reference_wrapper<util::prometheus::GaugeInt> connections;
+        std::thread thread;
+
+        Shard(
+            util::prometheus::GaugeInt& loopLag,
+            util::prometheus::CounterInt& accepted,
+            util::prometheus::GaugeInt& connections
+        );
+    };
+
+    static constexpr auto LAG_PROBE_INTERVAL = std::chrono::seconds{1};
+
+    util::Logger log_{"WebServer"};
+    ServerShardsSettings settings_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+public:
+    /**
+     * @brief Create the shards and start their threads.
+     *
+     * @param settings The settings to use
+     */
+    explicit ServerShards(ServerShardsSettings settings);
+
+    /** @brief Stops all shards and joins their threads. */
+    ~ServerShards();
+
+    ServerShards(ServerShards const&) = delete;
+    ServerShards&
+    operator=(ServerShards const&) = delete;
+
+    /**
+     * @return The number of shards
+     */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return shards_.size();
+    }
+
+    /**
+     * @param index The index of the shard
+     * @return The io_context of the shard
+     */
+    [[nodiscard]] boost::asio::io_context&
+    ioContext(std::size_t index)
+    {
+        return shards_.at(index)->ioc;
+    }
+
+    /**
+     * @param index The index of the shard
+     * @return The counter of connections accepted by the shard
+     */
+    [[nodiscard]] util::prometheus::CounterInt&
+    acceptedCounter(std::size_t index)
+    {
+        return shards_.at(index)->accepted;
+    }
+
+    /**
+     * @param index The index of the shard
+     * @return The gauge of connections of the shard that are still open
+     */
+    [[nodiscard]] util::prometheus::GaugeInt&
+    connectionsGauge(std::size_t index)
+    {
+        return shards_.at(index)->connections;
+    }
+
+    /**
+     * @brief Count a connection accepted by a shard.
+     *
+     * @param index The index of the shard
+     * @return The guard that keeps the connection counted as open until its last copy is gone
+     */
+    [[nodiscard]] ConnectionGuard
+    openConnection(std::size_t index);
+
+    /** @brief Stop all shards; pending handlers are dropped when the shards are destroyed. */
+    void
+    stop();
+
+private:
+    void
+    scheduleLagProbe(Shard& shard);
+
+    void
+    pinThread(std::thread& thread, std::size_t cpu);
+};
+
+/**
+ * @brief A factory function that creates the shards of the web server.
+ *
+ * @param config The Clio config to use
+ * @return The shards if `server.shards.count` is configured and greater than zero; nullptr otherwise
+ * @throws std::logic_error if sharding is requested on a platform without `SO_REUSEPORT`
+ */
+std::shared_ptr<ServerShards>
+make_ServerShards(util::Config const& config);
+
+}  // namespace web
@@ -39,6 +39,8 @@ class SslHttpSession : public detail::HttpBase<SslHttpSession, HandlerType>,
                        public std::enable_shared_from_this<SslHttpSession<HandlerType>> {
     boost::beast::ssl_stream<boost::beast::tcp_stream> stream_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
+    std::shared_ptr<detail::WsCompression> compression_;
+    ConnectionGuard connectionGuard_;
 
 public:
     /**
@@ -51,6 +53,8 @@ public:
      * @param tagFactory A factory that is used to generate tags to track requests and sessions
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
+     * @param compression The websocket compression to use after an upgrade
+     * @param connectionGuard Keeps the connection counted as open while the session owns it
      * @param buffer Buffer with initial data received from the peer
      */
     explicit SslHttpSession(
@@ -61,6 +65,8 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<web::DOSGuard> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
+        std::shared_ptr<detail::WsCompression> compression,
+        ConnectionGuard connectionGuard,
         boost::beast::flat_buffer buffer
     )
         : detail::HttpBase<SslHttpSession, HandlerType>(
@@ -73,6 +79,8 @@ public:
           )
         , stream_(std::move(socket), ctx)
         , tagFactory_(tagFactory)
+        , compression_(std::move(compression))
+        , connectionGuard_(std::move(connectionGuard))
     {
     }
 
@@ -151,6 +159,8 @@ public:
             tagFactory_,
             this->dosGuard_,
             this->handler_,
+            compression_,
+            connectionGuard_,
             std::move(this->buffer_),
             std::move(this->req_),
             ConnectionBase::isAdmin()
@@ -34,8 +34,10 @@ namespace web {
  */
 template <SomeServerHandler HandlerType>
 class SslWsSession : public detail::WsBase<SslWsSession, HandlerType> {
-    using StreamType = boost::beast::websocket::stream<boost::beast::ssl_stream<boost::beast::tcp_stream>>;
+    using StreamType =
+        boost::beast::websocket::stream<detail::MeteredStream<boost::beast::ssl_stream<boost::beast::tcp_stream>>>;
     StreamType ws_;
+    ConnectionGuard connectionGuard_;
 
 public:
     /**
@@ -46,6 +48,8 @@ public:
      * @param tagFactory A factory that is used to generate tags to track requests and sessions
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
+     * @param compression The websocket compression to use
+     * @param connectionGuard Keeps the connection counted as open while the session owns it
      * @param buffer Buffer with initial data received from the peer
      * @param isAdmin Whether the connection has admin privileges
      */
@@ -55,11 +59,21 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<web::DOSGuard> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
+        std::shared_ptr<detail::WsCompression> compression,
+        ConnectionGuard connectionGuard,
         boost::beast::flat_buffer&& buffer,
         bool isAdmin
     )
-        : detail::WsBase<SslWsSession, HandlerType>(ip, tagFactory, dosGuard, handler, std::move(buffer))
+        : detail::WsBase<SslWsSession, HandlerType>(
+              ip,
+              tagFactory,
+              dosGuard,
+              handler,
+              std::move(compression),
+              std::move(buffer)
+          )
         , ws_(std::move(stream))
+        , connectionGuard_(std::move(connectionGuard))
     {
         ConnectionBase::isAdmin_ = isAdmin;  // NOLINT(cppcoreguidelines-prefer-member-initializer)
     }
@@ -88,6 +102,8 @@ class SslWsUpgrader : public std::enable_shared_from_this<SslWsUpgrader<HandlerT
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
     std::reference_wrapper<web::DOSGuard> dosGuard_;
     std::shared_ptr<HandlerType> const handler_;
+    std::shared_ptr<detail::WsCompression> compression_;
+    ConnectionGuard connectionGuard_;
     http::request<http::string_body> req_;
     bool isAdmin_;
 
@@ -100,6 +116,8 @@ public:
      * @param tagFactory A factory that is used to generate tags to track requests and sessions
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
+     * @param compression The websocket compression to use
+     * @param connectionGuard Keeps the connection counted as open while the session owns it
      * @param buffer Buffer with initial data received from the peer. Ownership is transferred
      * @param request The request. Ownership is transferred
      * @param isAdmin Whether the connection has admin privileges
@@ -110,6 +128,8 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<web::DOSGuard> dosGuard,
         std::shared_ptr<HandlerType> handler,
+        std::shared_ptr<detail::WsCompression> compression,
+        ConnectionGuard connectionGuard,
         boost::beast::flat_buffer&& buffer,
         http::request<http::string_body> request,
         bool isAdmin
@@ -120,6 +140,8 @@ public:
         , tagFactory_(tagFactory)
         , dosGuard_(dosGuard)
         , handler_(std::move(handler))
+        , compression_(std::move(compression))
+        , connectionGuard_(std::move(connectionGuard))
         , req_(std::move(request))
         , isAdmin_(isAdmin)
     {
@@ -163,7 +185,15 @@ private:
         boost::beast::get_lowest_layer(https_).expires_never();
 
         std::make_shared<SslWsSession<HandlerType>>(
-            std::move(https_), ip_, tagFactory_, dosGuard_, handler_, std::move(buffer_), isAdmin_
+            std::move(https_),
+            ip_,
+            tagFactory_,
+            dosGuard_,
+            handler_,
+            std::move(compression_),
+            std::move(connectionGuard_),
+            std::move(buffer_),
+            isAdmin_
         )
             ->run(std::move(req_));
     }
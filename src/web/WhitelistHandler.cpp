@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <web/WhitelistHandler.h>
+
+#include <boost/asio/ip/address.hpp>
+#include <boost/system/error_code.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+namespace web {
+
+void
+Whitelist::add(std::string_view net)
+{
+    auto const slash = net.find('/');
+    auto const addressPart = net.substr(0, slash);
+
+    boost::system::error_code ec;
+    auto const address = boost::asio::ip::make_address(addressPart, ec);
+    if (ec)
+        throw std::runtime_error(fmt::format("malformed network: {}", net));
+
+    auto const key = makeIpKey(address);
+    auto const offset = address.is_v4() ? IpKey::V4_MAPPED_PREFIX : std::size_t{0};
+
+    if (slash == std::string_view::npos) {
+        insert(key, IpKey::BITS);
+        return;
+    }
+
+    auto const prefixPart = net.substr(slash + 1);
+    std::size_t prefixLength = 0;
+    auto const [ptr, err] = std::from_chars(prefixPart.data(), prefixPart.data() + prefixPart.size(), prefixLength);
+    if (prefixPart.empty() or err != std::errc{} or ptr != prefixPart.data() + prefixPart.size() or
+        prefixLength > IpKey::BITS - offset) {
+        throw std::runtime_error(fmt::format("malformed network: {}", net));
+    }
+
+    insert(key, offset + prefixLength);
+}
+
+bool
+Whitelist::isWhiteListed(IpKey const& ip) const
+{
+    auto const* node = &nodes_.front();
+    while (not node->whitelisted) {
+        if (node->length == IpKey::BITS)
+            return false;
+
+        auto const child = node->children[ip.bit(node->length)];
+        if (child == NO_CHILD)
+            return false;
+
+        node = &nodes_[child];
+        if (ip.commonPrefixLength(node->prefix, node->length) < node->length)
+            return false;
+    }
+
+    return true;
+}
+
+void
+Whitelist::insert(IpKey const& prefix, std::size_t length)
+{
+    auto const key = prefix.masked(length);
+
+    // Invariant: the first nodes_[current].length bits of key match the node's prefix
+    std::uint32_t current = 0;
+    while (true) {
+        if (nodes_[current].length == length) {
+            nodes_[current].whitelisted = true;
+            return;
+        }
+
+        auto const branch = key.bit(nodes_[current].length);
+        auto const child = nodes_[current].children[branch];
+        if (child == NO_CHILD) {
+            auto const leaf = makeNode(key, length, true);
+            nodes_[current].children[branch] = leaf;
+            return;
+        }
+
+        auto const childLength = nodes_[child].length;
+        auto const common = key.commonPrefixLength(nodes_[child].prefix, std::min(length, childLength));
+        if (common == childLength) {
+            current = child;
+            continue;
+        }
+
+        // The new prefix diverges from the child's (or ends) in the middle of its edge; split the edge
+        auto const split = makeNode(key.masked(common), common, common == length);
+        nodes_[split].children[nodes_[child].prefix.bit(common)] = child;
+        nodes_[current].children[branch] = split;
+
+        if (common != length) {
+            auto const leaf = makeNode(key, length, true);
+            nodes_[split].children[key.bit(common)] = leaf;
+        }
+        return;
+    }
+}
+
+std::uint32_t
+Whitelist::makeNode(IpKey const& prefix, std::size_t length, bool whitelisted)
+{
+    nodes_.push_back(Node{.prefix = prefix, .length = length, .whitelisted = whitelisted});
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
+
+}  // namespace web
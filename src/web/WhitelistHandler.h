@@ -19,115 +19,79 @@
 
 #pragma once
 
-#include <boost/asio.hpp>
+#include <util/config/Config.h>
+#include <web/IpKey.h>
+
 #include <boost/iterator/transform_iterator.hpp>
-#include <fmt/core.h>
 
-#include <regex>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 namespace web {
 
 /**
  * @brief A whitelist to remove rate limits of certain IP addresses.
+ *
+ * Addresses and networks of both families are compiled into a single path-compressed binary trie over @ref IpKey, so
+ * a lookup walks at most one node per stored prefix on the way down instead of scanning every entry. IPv4 entries
+ * also match clients connected through IPv4-mapped IPv6 addresses.
  */
 class Whitelist {
-    std::vector<boost::asio::ip::network_v4> subnetsV4_;
-    std::vector<boost::asio::ip::network_v6> subnetsV6_;
-    std::vector<boost::asio::ip::address> ips_;
+    static constexpr std::uint32_t NO_CHILD = std::numeric_limits<std::uint32_t>::max();
+
+    struct Node {
+        IpKey prefix;
+        std::size_t length = 0;
+        bool whitelisted = false;
+        std::array<std::uint32_t, 2> children = {NO_CHILD, NO_CHILD};
+    };
+
+    // nodes_[0] is the root and represents the empty prefix
+    std::vector<Node> nodes_ = {Node{}};
 
 public:
     /**
-     * @brief Add network address to whitelist.
+     * @brief Add an address or a network in CIDR notation to the whitelist.
      *
-     * @param net Network part of the ip address
-     * @throws std::runtime::error when the network address is not valid
+     * @param net The address or network to add
+     * @throws std::runtime_error when the address or network is not valid
      */
     void
-    add(std::string_view net)
-    {
-        using namespace boost::asio;
-
-        if (not isMask(net)) {
-            ips_.push_back(ip::make_address(net));
-            return;
-        }
-
-        if (isV4(net)) {
-            subnetsV4_.push_back(ip::make_network_v4(net));
-        } else if (isV6(net)) {
-            subnetsV6_.push_back(ip::make_network_v6(net));
-        } else {
-            throw std::runtime_error(fmt::format("malformed network: {}", net.data()));
-        }
-    }
+    add(std::string_view net);
 
     /**
      * @brief Checks to see if ip address is whitelisted.
      *
-     * @param ip IP address
-     * @throws std::runtime::error when the network address is not valid
+     * @param ip IP address; addresses that can't be parsed are never whitelisted unless `::` is
+     * @return true if the address belongs to any of the whitelisted networks; false otherwise
      */
-    bool
+    [[nodiscard]] bool
     isWhiteListed(std::string_view ip) const
     {
-        using namespace boost::asio;
-
-        auto const addr = ip::make_address(ip);
-        if (std::find(std::begin(ips_), std::end(ips_), addr) != std::end(ips_))
-            return true;
-
-        if (addr.is_v4()) {
-            return std::find_if(
-                       std::begin(subnetsV4_), std::end(subnetsV4_), std::bind_front(&isInV4Subnet, std::cref(addr))
-                   ) != std::end(subnetsV4_);
-        }
-
-        if (addr.is_v6()) {
-            return std::find_if(
-                       std::begin(subnetsV6_), std::end(subnetsV6_), std::bind_front(&isInV6Subnet, std::cref(addr))
-                   ) != std::end(subnetsV6_);
-        }
-
-        return false;
+        return isWhiteListed(makeIpKey(ip));
     }
 
-private:
-    static bool
-    isInV4Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v4 const& subnet)
-    {
-        auto const range = subnet.hosts();
-        return range.find(addr.to_v4()) != range.end();
-    }
-
-    static bool
-    isInV6Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v6 const& subnet)
-    {
-        auto const range = subnet.hosts();
-        return range.find(addr.to_v6()) != range.end();
-    }
-
-    static bool
-    isV4(std::string_view net)
-    {
-        static const std::regex ipv4CidrRegex(R"(^\d{1,3}\.\d{1,3}\.\d{1,3}\.\d{1,3}/\d{1,2}$)");
-        return std::regex_match(std::string(net), ipv4CidrRegex);
-    }
+    /**
+     * @brief Checks to see if ip address is whitelisted.
+     *
+     * @param ip The binary key of the address
+     * @return true if the address belongs to any of the whitelisted networks; false otherwise
+     */
+    [[nodiscard]] bool
+    isWhiteListed(IpKey const& ip) const;
 
-    static bool
-    isV6(std::string_view net)
-    {
-        static const std::regex ipv6CidrRegex(R"(^([0-9A-Fa-f]{1,4}:){7}[0-9A-Fa-f]{1,4}/\d{1,3}$)");
-        return std::regex_match(std::string(net), ipv6CidrRegex);
-    }
+private:
+    void
+    insert(IpKey const& prefix, std::size_t length);
 
-    static bool
-    isMask(std::string_view net)
-    {
-        return net.find('/') != std::string_view::npos;
-    }
+    std::uint32_t
+    makeNode(IpKey const& prefix, std::size_t length, bool whitelisted);
 };
 
 /**
@@ -158,6 +122,15 @@ public:
         return whitelist_.isWhiteListed(ip);
     }
 
+    /**
+     * @return true if the given IP is whitelisted; false otherwise
+     */
+    bool
+    isWhiteListed(IpKey const& ip) const
+    {
+        return whitelist_.isWhiteListed(ip);
+    }
+
 private:
     [[nodiscard]] static std::unordered_set<std::string>
     getWhitelist(util::Config const& config)
@@ -31,6 +31,38 @@
 
 namespace web::detail {
 
+/**
+ * @brief Adds the rate limit warning to a serialized response.
+ *
+ * @param msg The serialized response; either a single response object or an array of responses to a batch
+ * @return The serialized response with the warning included
+ */
+inline std::string
+addLoadWarning(std::string const& msg)
+{
+    auto const addWarning = [](boost::json::object& response) {
+        response["warning"] = "load";
+
+        if (response.contains("warnings") && response["warnings"].is_array()) {
+            response["warnings"].as_array().push_back(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
+        } else {
+            response["warnings"] = boost::json::array{rpc::makeWarning(rpc::warnRPC_RATE_LIMIT)};
+        }
+    };
+
+    auto response = boost::json::parse(msg);
+    if (response.is_array()) {
+        for (auto& element : response.as_array()) {
+            if (element.is_object())
+                addWarning(element.as_object());
+        }
+    } else {
+        addWarning(response.as_object());
+    }
+
+    return boost::json::serialize(response);
+}
+
 /**
  * @brief A helper that attempts to match rippled reporting mode HTTP errors as close as possible.
  */
@@ -123,6 +155,21 @@ public:
         }
     }
 
+    void
+    sendSlowDownError() const
+    {
+        if (connection_->upgraded) {
+            connection_->send(
+                boost::json::serialize(rpc::makeError(rpc::RippledError::rpcSLOW_DOWN)), boost::beast::http::status::ok
+            );
+        } else {
+            connection_->send(
+                boost::json::serialize(rpc::makeError(rpc::RippledError::rpcSLOW_DOWN)),
+                boost::beast::http::status::service_unavailable
+            );
+        }
+    }
+
     void
     sendJsonParsingError(std::string_view reason) const
     {
@@ -23,8 +23,10 @@
 #include <rpc/Errors.h>
 #include <util/log/Logger.h>
 #include <util/prometheus/Http.h>
+#include <util/trace/Trace.h>
 #include <web/DOSGuard.h>
 #include <web/impl/AdminVerificationStrategy.h>
+#include <web/impl/ErrorHandling.h>
 #include <web/interface/Concepts.h>
 #include <web/interface/ConnectionBase.h>
 
@@ -75,6 +77,7 @@ class HttpBase : public ConnectionBase {
 
             // Store a type-erased version of the shared pointer in the class to keep it alive.
             self_.res_ = sp;
+            self_.writeSpan_ = util::trace::Span::detached("http.write");
 
             // Write the response
             http::async_write(
@@ -86,6 +89,7 @@ class HttpBase : public ConnectionBase {
     };
 
     std::shared_ptr<void> res_;
+    util::trace::Span writeSpan_;
     SendLambda sender_;
     std::shared_ptr<AdminVerificationStrategy> adminVerification_;
 
@@ -144,14 +148,14 @@ public:
         , handler_(std::move(handler))
     {
         LOG(perfLog_.debug()) << tag() << "http session created";
-        dosGuard_.get().increment(ip);
+        dosGuard_.get().increment(clientKey);
     }
 
     ~HttpBase() override
     {
         LOG(perfLog_.debug()) << tag() << "http session closed";
         if (not upgraded)
-            dosGuard_.get().decrement(this->clientIp);
+            dosGuard_.get().decrement(this->clientKey);
     }
 
     void
@@ -187,7 +191,7 @@ public:
         ConnectionBase::isAdmin_ = adminVerification_->isAdmin(req_, this->clientIp);
 
         if (boost::beast::websocket::is_upgrade(req_)) {
-            if (dosGuard_.get().isOk(this->clientIp)) {
+            if (dosGuard_.get().isOk(this->clientKey)) {
                 // Disable the timeout. The websocket::stream uses its own timeout settings.
                 boost::beast::get_lowest_layer(derived().stream()).expires_never();
 
@@ -208,7 +212,7 @@ public:
         // to avoid overwhelm work queue, the request limit check should be
         // before posting to queue the web socket creation will be guarded via
         // connection limit
-        if (!dosGuard_.get().request(clientIp)) {
+        if (!dosGuard_.get().request(clientKey)) {
             // TODO: this looks like it could be useful to count too in the future
             return sender_(httpResponse(
                 http::status::service_unavailable,
@@ -238,18 +242,10 @@ public:
     void
     send(std::string&& msg, http::status status = http::status::ok) override
     {
-        if (!dosGuard_.get().add(clientIp, msg.size())) {
-            auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
-            } else {
-                jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::warnRPC_RATE_LIMIT)};
-            }
+        // Reserialize when we need to include the load warning
+        if (!dosGuard_.get().add(clientKey, msg.size()))
+            msg = addLoadWarning(msg);
 
-            // Reserialize when we need to include this warning
-            msg = boost::json::serialize(jsonResponse);
-        }
         sender_(httpResponse(status, "application/json", std::move(msg)));
     }
 
@@ -258,6 +254,10 @@ public:
     {
         boost::ignore_unused(bytes_transferred);
 
+        if (ec)
+            writeSpan_.setError();
+        writeSpan_.finish();
+
         if (ec)
             return httpFail(ec, "write");
 
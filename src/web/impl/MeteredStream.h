@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/associator.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/beast/core/role.hpp>
+#include <boost/beast/websocket/teardown.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace web::detail {
+
+/**
+ * @brief What a message written through a MeteredStream cost.
+ */
+struct MessageCost {
+    std::size_t bytesWritten = 0;                    ///< Bytes written to the next layer, frame headers included
+    std::chrono::steady_clock::duration busyTime{};  ///< Time the layer above spent between its writes
+};
+
+template <typename Stream, typename Handler>
+struct MeteredWriteHandler;
+
+/**
+ * @brief A stream that forwards everything to the next layer and meters the messages the layer above writes.
+ *
+ * It sits between a websocket stream and the tcp or ssl stream below it. While a message is metered, it counts the
+ * bytes the websocket writes to the next layer and the time the websocket spends outside of the next layer's writes,
+ * which is mostly the time it takes to deflate the frames of a compressed message.
+ *
+ * @tparam NextLayer The stream to write to
+ */
+template <typename NextLayer>
+class MeteredStream {
+    template <typename Stream, typename Handler>
+    friend struct MeteredWriteHandler;
+
+    NextLayer next_;
+
+    bool metering_ = false;
+    MessageCost cost_;
+    std::optional<std::chrono::steady_clock::time_point> busySince_;
+
+public:
+    using executor_type = typename NextLayer::executor_type;
+
+    /**
+     * @brief Create a new metered stream.
+     *
+     * @param args The arguments to construct the next layer with
+     */
+    template <typename... Args>
+    explicit MeteredStream(Args&&... args) : next_(std::forward<Args>(args)...)
+    {
+    }
+
+    executor_type
+    get_executor() noexcept
+    {
+        return next_.get_executor();
+    }
+
+    NextLayer&
+    next_layer() noexcept
+    {
+        return next_;
+    }
+
+    NextLayer const&
+    next_layer() const noexcept
+    {
+        return next_;
+    }
+
+    /** @brief Start metering a message; the time until its first write is counted as busy. */
+    void
+    beginMessage()
+    {
+        metering_ = true;
+        cost_ = {};
+        busySince_ = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Stop metering the current message.
+     *
+     * @return What the message cost since beginMessage was called
+     */
+    MessageCost
+    endMessage()
+    {
+        metering_ = false;
+        busySince_.reset();
+        return std::exchange(cost_, {});
+    }
+
+    template <typename MutableBufferSequence, typename ReadHandler>
+    auto
+    async_read_some(MutableBufferSequence const& buffers, ReadHandler&& handler)
+    {
+        return next_.async_read_some(buffers, std::forward<ReadHandler>(handler));
+    }
+
+    template <typename ConstBufferSequence, typename WriteHandler>
+    auto
+    async_write_some(ConstBufferSequence const& buffers, WriteHandler&& handler)
+    {
+        if (busySince_) {
+            cost_.busyTime += std::chrono::steady_clock::now() - *busySince_;
+            busySince_.reset();
+        }
+
+        return boost::asio::async_initiate<WriteHandler, void(boost::system::error_code, std::size_t)>(
+            [this](auto&& completionHandler, ConstBufferSequence const& bufs) {
+                using HandlerType = std::decay_t<decltype(completionHandler)>;
+                next_.async_write_some(
+                    bufs,
+                    MeteredWriteHandler<MeteredStream, HandlerType>{
+                        this, std::forward<decltype(completionHandler)>(completionHandler)
+                    }
+                );
+            },
+            handler,
+            buffers
+        );
+    }
+
+    friend void
+    teardown(boost::beast::role_type role, MeteredStream& stream, boost::system::error_code& ec)
+    {
+        using boost::beast::websocket::teardown;
+        teardown(role, stream.next_, ec);
+    }
+
+    template <typename TeardownHandler>
+    friend void
+    async_teardown(boost::beast::role_type role, MeteredStream& stream, TeardownHandler&& handler)
+    {
+        using boost::beast::websocket::async_teardown;
+        async_teardown(role, stream.next_, std::forward<TeardownHandler>(handler));
+    }
+};
+
+/**
+ * @brief Completes a write of a MeteredStream: counts the bytes written and restarts the busy clock.
+ */
+template <typename Stream, typename Handler>
+struct MeteredWriteHandler {
+    Stream* stream;
+    Handler handler;
+
+    void
+    operator()(boost::system::error_code ec, std::size_t bytesWritten)
+    {
+        if (stream->metering_) {
+            stream->cost_.bytesWritten += bytesWritten;
+            stream->busySince_ = std::chrono::steady_clock::now();
+        }
+
+        std::move(handler)(ec, bytesWritten);
+    }
+};
+
+}  // namespace web::detail
+
+/** @brief Keeps the executor, allocator and cancellation slot of the wrapped handler. */
+template <template <typename, typename> class Associator, typename Stream, typename Handler, typename DefaultCandidate>
+struct boost::asio::associator<Associator, web::detail::MeteredWriteHandler<Stream, Handler>, DefaultCandidate>
+    : Associator<Handler, DefaultCandidate> {
+    static typename Associator<Handler, DefaultCandidate>::type
+    get(web::detail::MeteredWriteHandler<Stream, Handler> const& h) noexcept
+    {
+        return Associator<Handler, DefaultCandidate>::get(h.handler);
+    }
+
+    static auto
+    get(web::detail::MeteredWriteHandler<Stream, Handler> const& h, DefaultCandidate const& c) noexcept
+        -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler, c))
+    {
+        return Associator<Handler, DefaultCandidate>::get(h.handler, c);
+    }
+};
@@ -21,7 +21,10 @@
 
 #include <rpc/common/Types.h>
 #include <util/log/Logger.h>
+#include <util/trace/Trace.h>
 #include <web/DOSGuard.h>
+#include <web/impl/ErrorHandling.h>
+#include <web/impl/WsCompression.h>
 #include <web/interface/Concepts.h>
 #include <web/interface/ConnectionBase.h>
 
@@ -49,8 +52,16 @@ class WsBase : public ConnectionBase, public std::enable_shared_from_this<WsBase
     boost::beast::flat_buffer buffer_;
     std::reference_wrapper<web::DOSGuard> dosGuard_;
     bool sending_ = false;
-    std::queue<std::shared_ptr<std::string>> messages_;
+
+    // the span covers the time the message spends in the queue and on the wire
+    struct Message {
+        std::shared_ptr<std::string> payload;
+        util::trace::Span span;
+    };
+    std::queue<Message> messages_;
     std::shared_ptr<HandlerType> const handler_;
+    std::shared_ptr<WsCompression> const compression_;
+    bool compressed_ = false;
 
 protected:
     util::Logger log_{"WebServer"};
@@ -73,9 +84,14 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<web::DOSGuard> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
+        std::shared_ptr<WsCompression> compression,
         boost::beast::flat_buffer&& buffer
     )
-        : ConnectionBase(tagFactory, ip), buffer_(std::move(buffer)), dosGuard_(dosGuard), handler_(handler)
+        : ConnectionBase(tagFactory, ip)
+        , buffer_(std::move(buffer))
+        , dosGuard_(dosGuard)
+        , handler_(handler)
+        , compression_(std::move(compression))
     {
         upgraded = true;  // NOLINT (cppcoreguidelines-pro-type-member-init)
         LOG(perfLog_.debug()) << tag() << "session created";
@@ -84,7 +100,10 @@ public:
     ~WsBase() override
     {
         LOG(perfLog_.debug()) << tag() << "session closed";
-        dosGuard_.get().decrement(clientIp);
+        dosGuard_.get().decrement(clientKey);
+
+        if (compressed_)
+            compression_->onSessionClosed();
     }
 
     Derived<HandlerType>&
@@ -97,8 +116,11 @@ public:
     doWrite()
     {
         sending_ = true;
+        if (compressed_)
+            derived().ws().next_layer().beginMessage();
+
         derived().ws().async_write(
-            boost::asio::buffer(messages_.front()->data(), messages_.front()->size()),
+            boost::asio::buffer(messages_.front().payload->data(), messages_.front().payload->size()),
             boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this())
         );
     }
@@ -106,6 +128,15 @@ public:
     void
     onWrite(boost::system::error_code ec, std::size_t)
     {
+        if (compressed_) {
+            auto const cost = derived().ws().next_layer().endMessage();
+            if (!ec)
+                compression_->onMessageSent(messages_.front().payload->size(), cost);
+        }
+
+        if (ec)
+            messages_.front().span.setError();
+
         messages_.pop();
         sending_ = false;
         if (ec) {
@@ -139,8 +170,11 @@ public:
     {
         boost::asio::dispatch(
             derived().ws().get_executor(),
-            [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
-                messages_.push(msg);
+            [this,
+             self = derived().shared_from_this(),
+             msg = std::move(msg),
+             span = util::trace::Span::detached("ws.write")]() mutable {
+                messages_.push(Message{std::move(msg), std::move(span)});
                 maybeSendNext();
             }
         );
@@ -155,19 +189,10 @@ public:
     void
     send(std::string&& msg, http::status = http::status::ok) override
     {
-        if (!dosGuard_.get().add(clientIp, msg.size())) {
-            auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
-            } else {
-                jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::warnRPC_RATE_LIMIT)};
-            }
+        // Reserialize when we need to include the load warning
+        if (!dosGuard_.get().add(clientKey, msg.size()))
+            msg = addLoadWarning(msg);
 
-            // Reserialize when we need to include this warning
-            msg = boost::json::serialize(jsonResponse);
-        }
         auto sharedMsg = std::make_shared<std::string>(std::move(msg));
         send(std::move(sharedMsg));
     }
@@ -183,10 +208,19 @@ public:
         derived().ws().set_option(websocket::stream_base::timeout::suggested(role_type::server));
 
         // Set a decorator to change the Server of the handshake
-        derived().ws().set_option(websocket::stream_base::decorator([](websocket::response_type& res) {
+        // The response it gets already tells whether beast agreed on compression with the client
+        derived().ws().set_option(websocket::stream_base::decorator([this](websocket::response_type& res) {
             res.set(http::field::server, std::string(BOOST_BEAST_VERSION_STRING) + " websocket-server-async");
+
+            if (!compressed_ && WsCompression::isNegotiated(res)) {
+                compressed_ = true;
+                compression_->onSessionOpened();
+            }
         }));
 
+        if (compression_->enabled())
+            derived().ws().set_option(compression_->options());
+
         derived().ws().async_accept(req, bind_front_handler(&WsBase::onAccept, this->shared_from_this()));
     }
 
@@ -241,7 +275,7 @@ public:
         std::string requestStr{static_cast<char const*>(buffer_.data().data()), buffer_.size()};
 
         // dosGuard served request++ and check ip address
-        if (!dosGuard_.get().request(clientIp)) {
+        if (!dosGuard_.get().request(clientKey)) {
             // TODO: could be useful to count in counters in the future too
             sendError(rpc::RippledError::rpcSLOW_DOWN, std::move(requestStr));
         } else {
@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <web/impl/WsCompression.h>
+
+#include <boost/beast/http/rfc7230.hpp>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+
+namespace web::detail {
+
+WsCompression::WsCompression(WsCompressionSettings settings)
+    : settings_(settings)
+    , sessions_(PrometheusService::gaugeInt(
+          "ws_compression_sessions_current_number",
+          util::prometheus::Labels(),
+          "Current number of websocket sessions using permessage-deflate"
+      ))
+    , payloadBytes_(PrometheusService::counterInt(
+          "ws_compression_payload_bytes_total_number",
+          util::prometheus::Labels(),
+          "Total uncompressed bytes sent to websocket sessions using permessage-deflate"
+      ))
+    , compressedBytes_(PrometheusService::counterInt(
+          "ws_compression_compressed_bytes_total_number",
+          util::prometheus::Labels(),
+          "Total bytes written to the socket for the messages counted in ws_compression_payload_bytes_total_number"
+      ))
+    , deflateDuration_(PrometheusService::counterInt(
+          "ws_compression_deflate_duration_us",
+          util::prometheus::Labels(),
+          "Total time spent deflating the messages counted in ws_compression_payload_bytes_total_number"
+      ))
+{
+}
+
+boost::beast::websocket::permessage_deflate
+WsCompression::options() const
+{
+    boost::beast::websocket::permessage_deflate opts;
+    opts.server_enable = settings_.enabled;
+    opts.server_max_window_bits = settings_.windowBits;
+    opts.server_no_context_takeover = true;
+    opts.client_no_context_takeover = true;
+    opts.compLevel = settings_.level;
+    opts.memLevel = settings_.memLevel;
+    opts.msg_size_threshold = settings_.minMessageSize;
+    return opts;
+}
+
+bool
+WsCompression::isNegotiated(boost::beast::websocket::response_type const& response)
+{
+    if (response.result() != boost::beast::http::status::switching_protocols)
+        return false;
+
+    auto const it = response.find(boost::beast::http::field::sec_websocket_extensions);
+    if (it == response.end())
+        return false;
+
+    return boost::beast::http::ext_list{it->value()}.exists("permessage-deflate");
+}
+
+void
+WsCompression::onSessionOpened()
+{
+    ++sessions_;
+}
+
+void
+WsCompression::onSessionClosed()
+{
+    --sessions_;
+}
+
+void
+WsCompression::onMessageSent(std::size_t payloadSize, MessageCost const& cost)
+{
+    // Smaller messages are sent uncompressed, they would only dilute the ratio
+    if (payloadSize < settings_.minMessageSize)
+        return;
+
+    payloadBytes_ += payloadSize;
+    compressedBytes_ += cost.bytesWritten;
+    deflateDuration_ += std::chrono::duration_cast<std::chrono::microseconds>(cost.busyTime).count();
+}
+
+std::shared_ptr<WsCompression>
+make_WsCompression(util::Config const& serverConfig)
+{
+    WsCompressionSettings settings;
+    if (!serverConfig.contains("ws_compression"))
+        return std::make_shared<WsCompression>(settings);
+
+    auto const section = serverConfig.section("ws_compression");
+    settings.enabled = section.valueOr("enabled", settings.enabled);
+    settings.level = section.valueOr("level", settings.level);
+    settings.memLevel = section.valueOr("mem_level", settings.memLevel);
+    settings.windowBits = section.valueOr("window_bits", settings.windowBits);
+    settings.minMessageSize = section.valueOr("min_message_size", settings.minMessageSize);
+
+    if (settings.level < 0 || settings.level > 9)
+        throw std::logic_error(fmt::format("ws_compression.level must be within [0, 9], got {}", settings.level));
+
+    if (settings.memLevel < 1 || settings.memLevel > 9)
+        throw std::logic_error(fmt::format("ws_compression.mem_level must be within [1, 9], got {}", settings.memLevel)
+        );
+
+    if (settings.windowBits < 9 || settings.windowBits > 15) {
+        throw std::logic_error(
+            fmt::format("ws_compression.window_bits must be within [9, 15], got {}", settings.windowBits)
+        );
+    }
+
+    return std::make_shared<WsCompression>(settings);
+}
+
+}  // namespace web::detail
@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/config/Config.h>
+#include <web/impl/MeteredStream.h>
+#include <util/prometheus/Prometheus.h>
+
+#include <boost/beast/http.hpp>
+#include <boost/beast/websocket.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace web::detail {
+
+/**
+ * @brief Settings of the permessage-deflate websocket extension for one server.
+ */
+struct WsCompressionSettings {
+    bool enabled = false;
+    int level = 1;
+    int memLevel = 4;
+    int windowBits = 15;
+    std::size_t minMessageSize = 1024;
+};
+
+/**
+ * @brief Negotiates permessage-deflate for websocket sessions and meters the sessions using it.
+ *
+ * For the messages large enough to be compressed, it counts the payload bytes, the bytes actually written below the
+ * websocket layer and the time spent deflating them. The bytes saved and the CPU cost per byte can be derived from
+ * these counters.
+ *
+ * Context takeover is always disabled on both sides, so no sliding window has to be kept per connection.
+ *
+ * Each session compresses the messages it sends with its own deflate stream. Beast has no way to write a frame that was
+ * compressed beforehand, and it writes control frames such as pongs on its own, so a broadcast message can't be
+ * compressed once and shared by all the sessions it is sent to.
+ */
+class WsCompression {
+    WsCompressionSettings settings_;
+
+    util::prometheus::GaugeInt& sessions_;
+    util::prometheus::CounterInt& payloadBytes_;
+    util::prometheus::CounterInt& compressedBytes_;
+    util::prometheus::CounterInt& deflateDuration_;
+
+public:
+    /**
+     * @brief Create a new compression instance.
+     *
+     * @param settings The settings to use
+     */
+    explicit WsCompression(WsCompressionSettings settings);
+
+    /**
+     * @return true if compression is enabled on this server; false otherwise
+     */
+    [[nodiscard]] bool
+    enabled() const
+    {
+        return settings_.enabled;
+    }
+
+    /**
+     * @return The settings in use
+     */
+    [[nodiscard]] WsCompressionSettings const&
+    settings() const
+    {
+        return settings_;
+    }
+
+    /**
+     * @return The permessage-deflate option to set on a websocket stream before accepting the handshake
+     */
+    [[nodiscard]] boost::beast::websocket::permessage_deflate
+    options() const;
+
+    /**
+     * @brief Checks whether compression is used by a session, from the handshake response the server sends.
+     *
+     * @param response The websocket handshake response, as built by beast from the options and the client offer
+     * @return true if the handshake succeeds and the response accepts permessage-deflate; false otherwise
+     */
+    [[nodiscard]] static bool
+    isNegotiated(boost::beast::websocket::response_type const& response);
+
+    /** @brief Account for a new session that uses compression. */
+    void
+    onSessionOpened();
+
+    /** @brief Account for a closed session that used compression. */
+    void
+    onSessionClosed();
+
+    /**
+     * @brief Account for a message sent to a session that uses compression.
+     *
+     * @param payloadSize The size of the uncompressed payload that was sent
+     * @param cost The bytes written and the time spent deflating, as metered by the session's stream
+     */
+    void
+    onMessageSent(std::size_t payloadSize, MessageCost const& cost);
+};
+
+/**
+ * @brief A factory function that creates the websocket compression of a server.
+ *
+ * @param serverConfig The `server` section of the config
+ * @return The websocket compression instance; compression is disabled if `ws_compression` is not configured
+ */
+std::shared_ptr<WsCompression>
+make_WsCompression(util::Config const& serverConfig);
+
+}  // namespace web::detail
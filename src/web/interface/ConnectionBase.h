@@ -20,14 +20,25 @@
 #pragma once
 
 #include <util/Taggable.h>
+#include <web/IpKey.h>
 
 #include <boost/beast/http.hpp>
+
+#include <memory>
 #include <utility>
 
 namespace web {
 
 namespace http = boost::beast::http;
 
+/**
+ * @brief Keeps a connection counted as open while any copy of it is alive.
+ *
+ * Every object that owns the socket of a connection holds a copy, so the count only drops once the connection is
+ * closed, including after an upgrade to websocket. Empty if nothing counts the connections.
+ */
+using ConnectionGuard = std::shared_ptr<void>;
+
 /**
  * @brief Base class for all connections.
  *
@@ -39,6 +50,7 @@ protected:
 
 public:
     std::string const clientIp;
+    IpKey const clientKey;
     bool upgraded = false;
     bool isAdmin_ = false;
 
@@ -49,7 +61,7 @@ public:
      * @param ip The IP address of the connected peer
      */
     ConnectionBase(util::TagDecoratorFactory const& tagFactory, std::string ip)
-        : Taggable(tagFactory), clientIp(std::move(ip))
+        : Taggable(tagFactory), clientIp(std::move(ip)), clientKey(makeIpKey(clientIp))
     {
     }
 
@@ -50,7 +50,7 @@ constexpr auto JSONData = R"JSON(
 constexpr auto IP = "127.0.0.2";
 
 struct MockWhitelistHandler {
-    MOCK_METHOD(bool, isWhiteListed, (std::string_view ip), (const));
+    MOCK_METHOD(bool, isWhiteListed, (IpKey const& ip), (const));
 };
 
 using MockWhitelistHandlerType = NiceMock<MockWhitelistHandler>;
@@ -85,12 +85,31 @@ protected:
 
 TEST_F(DOSGuardTest, Whitelisting)
 {
-    EXPECT_CALL(whitelistHandler, isWhiteListed("127.0.0.1")).Times(1).WillOnce(Return(false));
+    EXPECT_CALL(whitelistHandler, isWhiteListed(makeIpKey("127.0.0.1"))).Times(1).WillOnce(Return(false));
     EXPECT_FALSE(guard.isWhiteListed("127.0.0.1"));
-    EXPECT_CALL(whitelistHandler, isWhiteListed("127.0.0.1")).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(whitelistHandler, isWhiteListed(makeIpKey("127.0.0.1"))).Times(1).WillOnce(Return(true));
     EXPECT_TRUE(guard.isWhiteListed("127.0.0.1"));
 }
 
+TEST_F(DOSGuardTest, WhitelistedClientIsNeverLimited)
+{
+    auto const key = makeIpKey(IP);
+    EXPECT_CALL(whitelistHandler, isWhiteListed(key)).WillRepeatedly(Return(true));
+
+    EXPECT_TRUE(guard.request(key, 10));
+    EXPECT_TRUE(guard.add(key, 1000));
+    EXPECT_TRUE(guard.isOk(key));
+}
+
+TEST_F(DOSGuardTest, StringAndKeyOverloadsShareState)
+{
+    auto const key = makeIpKey(IP);
+    EXPECT_TRUE(guard.request(IP, 3));
+    EXPECT_TRUE(guard.isOk(key));
+    EXPECT_FALSE(guard.request(key));
+    EXPECT_FALSE(guard.isOk(IP));
+}
+
 TEST_F(DOSGuardTest, ConnectionCount)
 {
     EXPECT_TRUE(guard.isOk(IP));
@@ -139,6 +158,16 @@ TEST_F(DOSGuardTest, RequestLimit)
     EXPECT_TRUE(guard.isOk(IP));  // can request again
 }
 
+TEST_F(DOSGuardTest, RequestLimitWithMultipleRequests)
+{
+    EXPECT_TRUE(guard.request(IP, 3));
+    EXPECT_TRUE(guard.isOk(IP));
+    EXPECT_FALSE(guard.request(IP, 1));
+    EXPECT_FALSE(guard.isOk(IP));
+    guard.clear();
+    EXPECT_FALSE(guard.request(IP, 4));
+}
+
 TEST_F(DOSGuardTest, RequestLimitOnTimer)
 {
     EXPECT_TRUE(guard.request(IP));
@@ -370,6 +370,11 @@ TEST_F(SubscriptionManagerSimpleBackendTest, SubscriptionManagerBookChange)
         ]
     })";
     CheckSubscriberMessage(BookChangePublish, session, 20);
+
+    // the changes are kept for the book_changes handler
+    auto const cached = subManagerPtr->bookChangesCache()->get(32);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->size(), 1);
 }
 
 /*
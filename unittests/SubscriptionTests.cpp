@@ -259,6 +259,85 @@ TEST_F(SubscriptionMapTest, SubscriptionMapDeadRemoveSubscriber)
     EXPECT_EQ(subMap.count(), 1);
 }
 
+struct ShardedSubscriptionMapTest : SubscriptionTest {
+    SubscriptionMap<std::string> subMap{ctx, "test", 4};
+};
+
+TEST_F(ShardedSubscriptionMapTest, SubscriptionMapCount)
+{
+    EXPECT_EQ(subMap.numShards(), 4);
+
+    std::vector<std::shared_ptr<web::ConnectionBase>> sessions;
+    for (auto i = 0; i < 8; ++i) {
+        sessions.push_back(std::make_shared<MockSession>(tagDecoratorFactory));
+        subMap.subscribe(sessions.back(), fmt::format("topic{}", i));
+    }
+    ctx.run();
+    EXPECT_EQ(subMap.count(), 8);
+
+    for (auto i = 0; i < 8; ++i)
+        EXPECT_TRUE(subMap.hasSession(sessions[i], fmt::format("topic{}", i)));
+
+    for (auto i = 0; i < 8; ++i)
+        subMap.unsubscribe(sessions[i], fmt::format("topic{}", i));
+    ctx.restart();
+    ctx.run();
+    EXPECT_EQ(subMap.count(), 0);
+
+    for (auto i = 0; i < 8; ++i)
+        EXPECT_FALSE(subMap.hasSession(sessions[i], fmt::format("topic{}", i)));
+}
+
+TEST_F(ShardedSubscriptionMapTest, PublishToMultipleKeys)
+{
+    std::vector<std::shared_ptr<web::ConnectionBase>> sessions;
+    std::vector<std::string> topics;
+    for (auto i = 0; i < 8; ++i) {
+        sessions.push_back(std::make_shared<MockSession>(tagDecoratorFactory));
+        topics.push_back(fmt::format("topic{}", i));
+        subMap.subscribe(sessions.back(), topics.back());
+    }
+    std::shared_ptr<web::ConnectionBase> const notSubscribed = std::make_shared<MockSession>(tagDecoratorFactory);
+    subMap.subscribe(notSubscribed, "other");
+    ctx.run();
+
+    subMap.publish(std::make_shared<std::string>("message"), topics);
+    ctx.restart();
+    ctx.run();
+
+    for (auto const& session : sessions) {
+        auto const* mockSession = dynamic_cast<MockSession*>(session.get());
+        ASSERT_NE(mockSession, nullptr);
+        EXPECT_EQ(mockSession->message, "message");
+    }
+
+    auto const* other = dynamic_cast<MockSession*>(notSubscribed.get());
+    ASSERT_NE(other, nullptr);
+    EXPECT_TRUE(other->message.empty());
+}
+
+TEST_F(ShardedSubscriptionMapTest, PublishToMultipleKeysRemovesDeadSubscribers)
+{
+    std::shared_ptr<web::ConnectionBase> const deadSession(new MockDeadSession(tagDecoratorFactory));
+    std::shared_ptr<web::ConnectionBase> const session = std::make_shared<MockSession>(tagDecoratorFactory);
+    subMap.subscribe(deadSession, "topic1");
+    subMap.subscribe(session, "topic2");
+    ctx.run();
+    EXPECT_EQ(subMap.count(), 2);
+
+    std::vector<std::string> const topics = {"topic1", "topic2"};
+    subMap.publish(std::make_shared<std::string>("message"), topics);
+    subMap.publish(std::make_shared<std::string>("message"), topics);  // dead session is detected after failed send
+    ctx.restart();
+    ctx.run();
+    EXPECT_EQ(subMap.count(), 1);
+    EXPECT_FALSE(subMap.hasSession(deadSession, "topic1"));
+
+    auto const* mockSession = dynamic_cast<MockSession*>(session.get());
+    ASSERT_NE(mockSession, nullptr);
+    EXPECT_EQ(mockSession->message, "messagemessage");
+}
+
 struct SubscriptionMapMockPrometheusTest : SubscriptionMockPrometheusTest {
     SubscriptionMap<std::string> subMap{ctx, "test"};
     std::shared_ptr<web::ConnectionBase> const session = std::make_shared<MockSession>(tagDecoratorFactory);
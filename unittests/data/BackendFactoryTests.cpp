@@ -24,6 +24,8 @@
 #include <fmt/core.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+
 namespace {
 constexpr auto contactPoints = "127.0.0.1";
 constexpr auto keyspace = "factory_test";
@@ -76,6 +78,26 @@ TEST_F(BackendCassandraFactoryTest, NoSuchBackend)
     EXPECT_THROW(make_Backend(cfg), std::runtime_error);
 }
 
+TEST_F(BackendCassandraFactoryTest, EmbeddedWriterRequiresOnlineDelete)
+{
+    // the path is valid, so the only reason to refuse the config is the missing online_delete
+    auto const path = (std::filesystem::temp_directory_path() / "clio_factory_test").string();
+    util::Config const cfg{boost::json::parse(fmt::format(
+        R"({{
+            "database":
+            {{
+                "type": "embedded",
+                "embedded": {{
+                    "path": "{}"
+                }}
+            }}
+        }})",
+        path
+    ))};
+    EXPECT_THROW(make_Backend(cfg), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
 TEST_F(BackendCassandraFactoryTest, CreateCassandraBackendDBDisconnect)
 {
     util::Config const cfg{boost::json::parse(fmt::format(
@@ -0,0 +1,347 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <util/TestObject.h>
+
+#include <data/BalancesIndex.h>
+
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/TER.h>
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr static auto CURRENCY = "USD";
+constexpr static auto ISSUER = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr static auto HOLDER1 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr static auto HOLDER2 = "raHGBERMka3KZsfpTQUAtumxmvpqhFLyrk";
+constexpr static auto HOLDER3 = "rK9DrarGKnVEo2nYp5MfVRXRYf5yRX3mwD";
+constexpr static auto HOLDER4 = "rB9BMzh27F3Q6a5FtGPDayQoCCEdiRdqcK";
+constexpr static auto MAX_ACCOUNTS = 10;
+
+// the issuer is always the low side of the line, so a negative balance is owed by the issuer to the holder
+TrustLineState
+makeLine(ripple::AccountID const& holder, ripple::STAmount const& balance, std::uint32_t flags = 0)
+{
+    return TrustLineState{
+        balance,
+        ripple::STAmount{GetIssue(CURRENCY, ISSUER), 0},
+        ripple::STAmount{ripple::Issue{ripple::to_currency(CURRENCY), holder}, 1000},
+        flags
+    };
+}
+
+TrustLineState
+makeLine(char const* holder, int balance, std::uint32_t flags = 0)
+{
+    return makeLine(GetAccountIDWithString(holder), ripple::STAmount{GetIssue(CURRENCY, ISSUER), balance}, flags);
+}
+
+// an amount owed by the issuer
+ripple::STAmount
+makeOwed(std::uint64_t mantissa, int exponent)
+{
+    return ripple::STAmount{GetIssue(CURRENCY, ISSUER), mantissa, exponent, true};
+}
+
+ripple::STObject
+makeFields(ripple::SField const& name, TrustLineState const& line)
+{
+    ripple::STObject fields(name);
+    fields.setFieldAmount(ripple::sfBalance, line.balance);
+    fields.setFieldAmount(ripple::sfLowLimit, line.lowLimit);
+    fields.setFieldAmount(ripple::sfHighLimit, line.highLimit);
+    fields.setFieldU32(ripple::sfFlags, line.flags);
+    return fields;
+}
+
+ripple::STObject
+makeNode(ripple::SField const& nodeType, std::optional<TrustLineState> const& before, TrustLineState const& after)
+{
+    ripple::STObject node(nodeType);
+    node.setFieldU16(ripple::sfLedgerEntryType, ripple::ltRIPPLE_STATE);
+    auto const& fieldsName = nodeType == ripple::sfCreatedNode ? ripple::sfNewFields : ripple::sfFinalFields;
+    node.emplace_back(makeFields(fieldsName, after));
+
+    if (before) {
+        ripple::STObject previousFields(ripple::sfPreviousFields);
+        previousFields.setFieldAmount(ripple::sfBalance, before->balance);
+        previousFields.setFieldU32(ripple::sfFlags, before->flags);
+        node.emplace_back(std::move(previousFields));
+    }
+
+    return node;
+}
+
+TransactionAndMetadata
+makeTransaction(std::uint32_t transactionIndex, ripple::STObject const& node)
+{
+    ripple::STObject metaObj(ripple::sfTransactionMetaData);
+    ripple::STArray metaArray{1};
+    metaArray.push_back(node);
+    metaObj.setFieldArray(ripple::sfAffectedNodes, metaArray);
+    metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    metaObj.setFieldU32(ripple::sfTransactionIndex, transactionIndex);
+
+    TransactionAndMetadata tx;
+    tx.metadata = metaObj.getSerializer().peekData();
+    return tx;
+}
+
+IssuerBalances
+recompute(std::vector<TrustLineState> const& lines)
+{
+    IssuerBalances balances;
+    for (auto const& line : lines)
+        balances.add(GetAccountIDWithString(ISSUER), line);
+    return balances;
+}
+
+}  // namespace
+
+struct BalancesIndexTest : NoLoggerFixture {
+    BalancesIndex index;
+    ripple::AccountID const issuer = GetAccountIDWithString(ISSUER);
+
+    void
+    SetUp() override
+    {
+        NoLoggerFixture::SetUp();
+        index.enable(MAX_ACCOUNTS);
+    }
+};
+
+TEST_F(BalancesIndexTest, ClassifiesLikeGatewayBalances)
+{
+    auto const balances = recompute({
+        makeLine(HOLDER1, -10),
+        makeLine(HOLDER2, -20),
+        makeLine(HOLDER3, 5),
+        makeLine(HOLDER4, -7, ripple::lsfLowFreeze),
+    });
+
+    ASSERT_EQ(balances.obligations.size(), 1);
+    EXPECT_EQ(balances.obligations.begin()->second.getText(), "30");
+
+    ASSERT_EQ(balances.assets.size(), 1);
+    EXPECT_EQ(balances.assets.at(GetAccountIDWithString(HOLDER3)).begin()->second.getText(), "5");
+
+    ASSERT_EQ(balances.frozenBalances.size(), 1);
+    EXPECT_EQ(balances.frozenBalances.at(GetAccountIDWithString(HOLDER4)).begin()->second.getText(), "7");
+}
+
+TEST_F(BalancesIndexTest, ObligationsDependOnTheOrderOfTheLines)
+{
+    // the small amounts are lost when they are added to the large one, but not when they are added together first
+    auto const large = makeLine(GetAccountIDWithString(HOLDER1), makeOwed(1'000'000'000'000'000, 1));
+    auto const small1 = makeLine(GetAccountIDWithString(HOLDER2), makeOwed(5, 0));
+    auto const small2 = makeLine(GetAccountIDWithString(HOLDER3), makeOwed(5, 0));
+
+    EXPECT_NE(recompute({large, small1, small2}), recompute({small1, small2, large}));
+}
+
+TEST_F(BalancesIndexTest, ObligationOverflowIsCapped)
+{
+    auto const balances = recompute({
+        makeLine(GetAccountIDWithString(HOLDER1), makeOwed(9'999'999'999'999'999, 80)),
+        makeLine(GetAccountIDWithString(HOLDER2), makeOwed(9'999'999'999'999'999, 80)),
+        makeLine(GetAccountIDWithString(HOLDER3), makeOwed(1, 0)),
+    });
+
+    EXPECT_EQ(balances.obligations.begin()->second.getText(), "9999999999999999e80");
+}
+
+TEST_F(BalancesIndexTest, ChangesKeepTheOrderOfTheDirectory)
+{
+    auto const large = makeLine(GetAccountIDWithString(HOLDER1), makeOwed(1'000'000'000'000'000, 1));
+    auto const small = makeLine(GetAccountIDWithString(HOLDER2), makeOwed(5, 0));
+    auto const other = makeLine(GetAccountIDWithString(HOLDER3), makeOwed(5, 0));
+
+    IndexedBalances indexed{issuer, {small, large}};
+    EXPECT_EQ(indexed.balances(), recompute({small, large}));
+
+    // appended after the large amount, where a full walk would find it
+    indexed.apply(std::nullopt, other);
+    indexed.refresh();
+    EXPECT_EQ(indexed.balances(), recompute({small, large, other}));
+
+    // changed in the middle; the small amounts are now both after the large one
+    auto const larger = makeLine(GetAccountIDWithString(HOLDER1), makeOwed(2'000'000'000'000'000, 1));
+    indexed.apply(small, std::nullopt);
+    indexed.apply(large, larger);
+    indexed.refresh();
+    EXPECT_EQ(indexed.balances(), recompute({larger, other}));
+
+    // added again, at the end
+    indexed.apply(std::nullopt, small);
+    indexed.refresh();
+    EXPECT_EQ(indexed.balances(), recompute({larger, other, small}));
+}
+
+TEST_F(BalancesIndexTest, ChurnMatchesFullRecomputeExactly)
+{
+    static constexpr auto LEDGERS = 500;
+    static constexpr auto CHANGES_PER_LEDGER = 10;
+
+    std::mt19937 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<std::uint64_t> mantissas{1, 9'999'999'999'999'999};
+    std::uniform_int_distribution<int> exponents{-30, 10};
+    std::uniform_int_distribution<int> actions{0, 2};
+    std::bernoulli_distribution assets{0.1};
+
+    auto holders = std::uint64_t{0};
+    auto const makeBalance = [&]() {
+        auto balance = makeOwed(mantissas(gen), exponents(gen));
+        if (assets(gen))
+            balance.negate();
+        return balance;
+    };
+
+    // the lines in the order of the owner directory; removed lines leave a hole
+    std::vector<std::optional<TrustLineState>> directory;
+    IndexedBalances indexed{issuer, {}};
+
+    for (auto ledger = 0; ledger < LEDGERS; ++ledger) {
+        for (auto change = 0; change < CHANGES_PER_LEDGER; ++change) {
+            std::vector<std::size_t> present;
+            for (std::size_t i = 0; i < directory.size(); ++i) {
+                if (directory[i])
+                    present.push_back(i);
+            }
+
+            auto const action = present.empty() ? 0 : actions(gen);
+            if (action == 0) {
+                auto const line = makeLine(ripple::AccountID{++holders}, makeBalance());
+                indexed.apply(std::nullopt, line);
+                directory.push_back(line);
+                continue;
+            }
+
+            auto& line = directory[present[std::uniform_int_distribution<std::size_t>{0, present.size() - 1}(gen)]];
+            if (action == 1) {
+                indexed.apply(line, std::nullopt);
+                line.reset();
+            } else {
+                auto modified = *line;
+                modified.balance = makeBalance();
+                indexed.apply(line, modified);
+                line = modified;
+            }
+        }
+
+        indexed.refresh();
+
+        std::vector<TrustLineState> lines;
+        for (auto const& line : directory) {
+            if (line)
+                lines.push_back(*line);
+        }
+
+        ASSERT_EQ(indexed.balances(), recompute(lines)) << "ledger " << ledger;
+    }
+}
+
+TEST_F(BalancesIndexTest, IncrementalUpdatesMatchFullRecompute)
+{
+    index.update({}, 10);
+    index.put(issuer, {makeLine(HOLDER1, -10), makeLine(HOLDER2, -20), makeLine(HOLDER3, 5)}, 10);
+
+    // given out of order, as the database returns them
+    index.update(
+        {
+            // HOLDER1 gets frozen after its balance changed
+            makeTransaction(
+                3,
+                makeNode(ripple::sfModifiedNode, makeLine(HOLDER1, -15), makeLine(HOLDER1, -15, ripple::lsfLowFreeze))
+            ),
+            makeTransaction(1, makeNode(ripple::sfModifiedNode, makeLine(HOLDER1, -10), makeLine(HOLDER1, -15))),
+            makeTransaction(0, makeNode(ripple::sfCreatedNode, std::nullopt, makeLine(HOLDER4, -3))),
+            makeTransaction(2, makeNode(ripple::sfDeletedNode, makeLine(HOLDER2, -20), makeLine(HOLDER2, 0))),
+            makeTransaction(4, makeNode(ripple::sfModifiedNode, makeLine(HOLDER3, 5), makeLine(HOLDER3, -1))),
+        },
+        11
+    );
+
+    auto const balances = index.get(issuer, 11);
+    ASSERT_TRUE(balances);
+    EXPECT_EQ(
+        *balances,
+        recompute({makeLine(HOLDER1, -15, ripple::lsfLowFreeze), makeLine(HOLDER3, -1), makeLine(HOLDER4, -3)})
+    );
+    EXPECT_EQ(balances->obligations.begin()->second.getText(), "4");
+}
+
+TEST_F(BalancesIndexTest, OnlyLatestSequenceIsServed)
+{
+    index.update({}, 10);
+
+    index.put(issuer, std::vector{makeLine(HOLDER1, -10)}, 9);
+    EXPECT_FALSE(index.get(issuer, 10));
+
+    index.put(issuer, std::vector{makeLine(HOLDER1, -10)}, 10);
+    EXPECT_TRUE(index.get(issuer, 10));
+    EXPECT_FALSE(index.get(issuer, 9));
+
+    index.update({}, 11);
+    EXPECT_FALSE(index.get(issuer, 10));
+    EXPECT_TRUE(index.get(issuer, 11));
+}
+
+TEST_F(BalancesIndexTest, SequenceGapClearsIndex)
+{
+    index.update({}, 10);
+    index.put(issuer, std::vector{makeLine(HOLDER1, -10)}, 10);
+    EXPECT_EQ(index.size(), 1);
+
+    index.update({}, 12);
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.latestLedgerSequence(), 12);
+}
+
+TEST_F(BalancesIndexTest, AccountsAreLimited)
+{
+    BalancesIndex small;
+    small.enable(1);
+    small.update({}, 10);
+
+    small.put(issuer, std::vector{makeLine(HOLDER1, -10)}, 10);
+    small.put(GetAccountIDWithString(HOLDER1), {}, 10);
+    EXPECT_EQ(small.size(), 1);
+    EXPECT_FALSE(small.get(GetAccountIDWithString(HOLDER1), 10));
+}
+
+TEST_F(BalancesIndexTest, DisabledIndexIgnoresEverything)
+{
+    BalancesIndex disabled;
+    disabled.update({}, 10);
+    disabled.put(issuer, std::vector{makeLine(HOLDER1, -10)}, 10);
+
+    EXPECT_FALSE(disabled.isEnabled());
+    EXPECT_EQ(disabled.size(), 0);
+    EXPECT_FALSE(disabled.get(issuer, 10));
+}
@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+
+#include <data/BoundedObjectCache.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto OBJECT_SIZE = 100;
+constexpr auto OBJECT_COST = OBJECT_SIZE + BoundedObjectCache::ENTRY_OVERHEAD;
+
+ripple::uint256
+makeKey(std::uint64_t idx)
+{
+    std::mt19937_64 rng{idx};
+    ripple::uint256 key;
+    for (auto i = 0u; i < 4; ++i) {
+        auto const word = rng();
+        std::memcpy(key.data() + i * sizeof(word), &word, sizeof(word));
+    }
+    return key;
+}
+
+}  // namespace
+
+struct BoundedObjectCacheTest : NoLoggerFixture {
+    Blob const blob = Blob(OBJECT_SIZE, 'a');
+};
+
+TEST_F(BoundedObjectCacheTest, GetReturnsObjectFromItsSequenceOn)
+{
+    BoundedObjectCache cache{10 * OBJECT_COST};
+    auto const key = makeKey(1);
+
+    EXPECT_FALSE(cache.get(key, 2));
+    cache.put(key, 2, blob);
+
+    EXPECT_EQ(cache.get(key, 2), blob);
+    EXPECT_EQ(cache.get(key, 5), blob);
+    EXPECT_FALSE(cache.get(key, 1));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.bytes(), OBJECT_COST);
+}
+
+TEST_F(BoundedObjectCacheTest, UpdateOnlyAppliesToCachedObjects)
+{
+    BoundedObjectCache cache{10 * OBJECT_COST};
+    auto const cached = makeKey(1);
+    auto const notCached = makeKey(2);
+    cache.put(cached, 1, blob);
+
+    cache.update(cached, 2, Blob{'b'});
+    cache.update(notCached, 2, Blob{'b'});
+
+    EXPECT_FALSE(cache.get(cached, 1));
+    EXPECT_EQ(cache.get(cached, 2), Blob{'b'});
+    EXPECT_FALSE(cache.get(notCached, 2));
+    EXPECT_EQ(cache.size(), 1);
+
+    cache.update(cached, 3, Blob{});
+    EXPECT_FALSE(cache.get(cached, 3));
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.bytes(), 0);
+}
+
+TEST_F(BoundedObjectCacheTest, StaysWithinMemoryCap)
+{
+    static constexpr auto MAX_BYTES = 10 * OBJECT_COST;
+    BoundedObjectCache cache{MAX_BYTES};
+
+    for (auto i = 0u; i < 1000; ++i) {
+        cache.put(makeKey(i), 1, blob);
+        EXPECT_LE(cache.bytes(), MAX_BYTES);
+    }
+    EXPECT_LE(cache.size(), 10);
+
+    cache.put(makeKey(1000), 1, Blob(MAX_BYTES, 'a'));
+    EXPECT_FALSE(cache.get(makeKey(1000), 1));
+    EXPECT_LE(cache.bytes(), MAX_BYTES);
+}
+
+TEST_F(BoundedObjectCacheTest, FrequentObjectsSurviveScans)
+{
+    static constexpr auto NUM_HOT = 100u;
+    static constexpr auto SCAN_SIZE = 1000u;
+    BoundedObjectCache cache{2 * NUM_HOT * OBJECT_COST};
+
+    auto fetch = [&](ripple::uint256 const& key) {
+        if (cache.get(key, 1))
+            return true;
+        cache.put(key, 1, blob);
+        return false;
+    };
+
+    // every round requests each hot object a few times, then scans through many more objects than fit in the cache
+    auto coldIdx = NUM_HOT;
+    for (auto round = 0u; round < 20; ++round) {
+        for (auto i = 0u; i < 3 * NUM_HOT; ++i)
+            fetch(makeKey(i % NUM_HOT));
+        for (auto i = 0u; i < SCAN_SIZE; ++i)
+            fetch(makeKey(coldIdx++));
+    }
+
+    auto hits = 0u;
+    for (auto i = 0u; i < NUM_HOT; ++i)
+        hits += fetch(makeKey(i)) ? 1 : 0;
+    EXPECT_GE(hits, NUM_HOT * 9 / 10);
+}
+
+TEST_F(BoundedObjectCacheTest, ShardsScaleWithMemoryCap)
+{
+    EXPECT_EQ(BoundedObjectCache{10 * OBJECT_COST}.shardCount(), 1);
+    EXPECT_EQ(BoundedObjectCache{3 * BoundedObjectCache::MIN_SHARD_BYTES}.shardCount(), 3);
+    EXPECT_EQ(
+        BoundedObjectCache{100 * BoundedObjectCache::MIN_SHARD_BYTES}.shardCount(), BoundedObjectCache::DEFAULT_SHARDS
+    );
+    EXPECT_EQ(BoundedObjectCache(100 * BoundedObjectCache::MIN_SHARD_BYTES, 4).shardCount(), 4);
+}
+
+TEST_F(BoundedObjectCacheTest, ShardedCacheUnderConcurrentReadersAndWriters)
+{
+    static constexpr auto NUM_THREADS = 8u;
+    static constexpr auto NUM_KEYS = 20'000u;
+    static constexpr auto MAX_BYTES = 4 * BoundedObjectCache::MIN_SHARD_BYTES;
+    BoundedObjectCache cache{MAX_BYTES};
+    ASSERT_EQ(cache.shardCount(), 4);
+
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (auto i = 0u; i < NUM_KEYS; ++i) {
+                auto const key = makeKey((i * NUM_THREADS + t) % NUM_KEYS);
+                if (auto const cached = cache.get(key, 2); cached) {
+                    EXPECT_EQ(*cached, blob);
+                } else {
+                    cache.put(key, 2, blob);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_GT(cache.size(), 0);
+    EXPECT_LE(cache.bytes(), MAX_BYTES);
+    EXPECT_EQ(cache.bytes(), cache.size() * OBJECT_COST);
+}
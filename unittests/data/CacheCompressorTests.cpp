@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <util/Fixtures.h>
+
+#include <data/CacheCompressor.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+// looks enough like a serialized ledger object: the type field, some shared layout and some random bytes
+Blob
+makeObject(std::uint16_t type, std::size_t idx, std::mt19937& rng)
+{
+    Blob blob{0x11, static_cast<unsigned char>(type >> 8), static_cast<unsigned char>(type), 0x22, 0, 0, 0, 0};
+    for (auto i = 0u; i < 32; ++i)
+        blob.push_back(static_cast<unsigned char>(i * 7));
+    for (auto i = 0u; i < 32; ++i)
+        blob.push_back(static_cast<unsigned char>(rng()));
+    for (auto i = 0u; i < 20; ++i)
+        blob.push_back(static_cast<unsigned char>(idx + i));
+    return blob;
+}
+
+}  // namespace
+
+struct CacheCompressorTest : NoLoggerFixture {
+    std::mt19937 rng{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+};
+
+TEST_F(CacheCompressorTest, EntryType)
+{
+    EXPECT_EQ(CacheCompressor::entryType(Blob{0x11, 0x00, 0x61, 0x22}), 0x61);
+    EXPECT_EQ(CacheCompressor::entryType(Blob{0x22, 0x00, 0x61}), 0);
+    EXPECT_EQ(CacheCompressor::entryType(Blob{0x11}), 0);
+}
+
+TEST_F(CacheCompressorTest, RoundTripWithoutDictionary)
+{
+    CacheCompressor compressor;
+    auto const blob = makeObject(0x61, 0, rng);
+
+    auto const compressed = compressor.compress(blob);
+    EXPECT_EQ(compressor.decompress(compressed), blob);
+    EXPECT_EQ(compressor.numDictionaries(), 0);
+}
+
+TEST_F(CacheCompressorTest, TrainsOneDictionaryPerType)
+{
+    CacheCompressor compressor;
+    std::vector<std::pair<Blob, Blob>> objects;
+
+    for (auto i = 0u; i < CacheCompressor::SAMPLES_PER_DICTIONARY * 2; ++i) {
+        auto blob = makeObject(i % 2 == 0 ? 0x61 : 0x6f, i, rng);
+        auto compressed = compressor.compress(blob);
+        objects.emplace_back(std::move(blob), std::move(compressed));
+    }
+    compressor.waitForTraining();
+    EXPECT_EQ(compressor.numDictionaries(), 2);
+
+    // objects compressed before and after training can all be read back
+    for (auto const& [blob, compressed] : objects)
+        EXPECT_EQ(compressor.decompress(compressed), blob);
+
+    auto const blob = makeObject(0x61, 0, rng);
+    auto const withDictionary = compressor.compress(blob);
+    EXPECT_LT(withDictionary.size(), objects.front().second.size());
+    EXPECT_EQ(compressor.decompress(withDictionary), blob);
+}
+
+TEST_F(CacheCompressorTest, DecompressIntoBuffer)
+{
+    CacheCompressor compressor;
+    auto const small = makeObject(0x61, 0, rng);
+    auto large = makeObject(0x61, 1, rng);
+    large.insert(large.end(), small.begin(), small.end());
+
+    Blob buffer;
+    compressor.decompress(compressor.compress(large), buffer);
+    EXPECT_EQ(buffer, large);
+
+    compressor.decompress(compressor.compress(small), buffer);
+    EXPECT_EQ(buffer, small);
+}
+
+TEST_F(CacheCompressorTest, ConcurrentUseWhileTraining)
+{
+    static constexpr auto NUM_THREADS = 4u;
+
+    CacheCompressor compressor;
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&compressor, t]() {
+            std::mt19937 rng{t};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+            for (auto i = 0u; i < CacheCompressor::SAMPLES_PER_DICTIONARY; ++i) {
+                auto const blob = makeObject(i % 2 == 0 ? 0x61 : 0x6f, i, rng);
+                EXPECT_EQ(compressor.decompress(compressor.compress(blob)), blob);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    compressor.waitForTraining();
+    EXPECT_EQ(compressor.numDictionaries(), 2);
+}
+
+TEST_F(CacheCompressorTest, DecompressInvalidDataThrows)
+{
+    CacheCompressor const compressor;
+    EXPECT_THROW(std::ignore = compressor.decompress(Blob{1, 2, 3, 4}), std::runtime_error);
+}
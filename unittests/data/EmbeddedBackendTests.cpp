@@ -0,0 +1,471 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <data/EmbeddedBackend.h>
+#include <util/Fixtures.h>
+#include <util/StringUtils.h>
+#include <util/TestObject.h>
+
+#include <ripple/protocol/nft.h>
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace data;
+using namespace data::embedded;
+
+namespace {
+constexpr auto KEY = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto TOKENID = "000827103B94ECBB7BF0A0A6ED62B3607801A27B65F4679F4AD1D4850000C0EA";
+constexpr auto SEQ = 30;
+
+std::string
+hashOf(std::uint32_t seq)
+{
+    return fmt::format("{:064X}", seq);
+}
+}  // namespace
+
+class EmbeddedBackendTest : public SyncAsioContextTest {
+protected:
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "clio_embedded_backend_test";
+    Settings settings{dir.string(), false, 0};
+    std::unique_ptr<EmbeddedBackend> backend;
+
+    void
+    SetUp() override
+    {
+        SyncAsioContextTest::SetUp();
+        std::filesystem::remove_all(dir);
+        backend = std::make_unique<EmbeddedBackend>(settings, false);
+    }
+
+    void
+    TearDown() override
+    {
+        backend.reset();
+        std::filesystem::remove_all(dir);
+        SyncAsioContextTest::TearDown();
+    }
+
+    void
+    reopen()
+    {
+        backend.reset();
+        backend = std::make_unique<EmbeddedBackend>(settings, false);
+    }
+
+    void
+    writeLedger(std::uint32_t seq)
+    {
+        auto const header = CreateLedgerInfo(hashOf(seq), seq);
+        backend->writeLedger(header, ledgerInfoToBinaryString(header));
+    }
+
+    void
+    writeObject(std::uint32_t seq, std::string const& blob)
+    {
+        backend->writeLedgerObject(uint256ToString(ripple::uint256{KEY}), seq, std::string{blob});
+    }
+
+    static std::string
+    toString(Blob const& blob)
+    {
+        return {blob.begin(), blob.end()};
+    }
+};
+
+TEST_F(EmbeddedBackendTest, LedgerAndRange)
+{
+    runSpawn([this](auto yield) {
+        EXPECT_FALSE(backend->hardFetchLedgerRange(yield));
+        EXPECT_FALSE(backend->fetchLatestLedgerSequence(yield));
+
+        writeLedger(SEQ);
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+        writeLedger(SEQ + 1);
+        ASSERT_TRUE(backend->finishWrites(SEQ + 1));
+
+        auto const rng = backend->hardFetchLedgerRange(yield);
+        ASSERT_TRUE(rng);
+        EXPECT_EQ(rng->minSequence, SEQ);
+        EXPECT_EQ(rng->maxSequence, SEQ + 1);
+        EXPECT_EQ(*backend->fetchLatestLedgerSequence(yield), SEQ + 1);
+
+        auto const bySeq = backend->fetchLedgerBySequence(SEQ, yield);
+        ASSERT_TRUE(bySeq);
+        EXPECT_EQ(bySeq->hash, ripple::uint256{hashOf(SEQ).c_str()});
+
+        auto const byHash = backend->fetchLedgerByHash(ripple::uint256{hashOf(SEQ + 1).c_str()}, yield);
+        ASSERT_TRUE(byHash);
+        EXPECT_EQ(byHash->seq, SEQ + 1);
+
+        EXPECT_FALSE(backend->fetchLedgerBySequence(SEQ + 2, yield));
+    });
+}
+
+TEST_F(EmbeddedBackendTest, ObjectVersionsDiffAndSuccessor)
+{
+    runSpawn([this](auto yield) {
+        auto const key = ripple::uint256{KEY};
+
+        writeLedger(SEQ);
+        writeObject(SEQ, "first");
+        backend->writeSuccessor(uint256ToString(firstKey), SEQ, uint256ToString(key));
+        backend->writeSuccessor(uint256ToString(key), SEQ, uint256ToString(lastKey));
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+
+        writeLedger(SEQ + 1);
+        writeObject(SEQ + 1, "second");
+        ASSERT_TRUE(backend->finishWrites(SEQ + 1));
+
+        writeLedger(SEQ + 2);
+        writeObject(SEQ + 2, "");
+        backend->writeSuccessor(uint256ToString(firstKey), SEQ + 2, uint256ToString(lastKey));
+        ASSERT_TRUE(backend->finishWrites(SEQ + 2));
+
+        EXPECT_FALSE(backend->doFetchLedgerObject(key, SEQ - 1, yield));
+        EXPECT_EQ(toString(*backend->doFetchLedgerObject(key, SEQ, yield)), "first");
+        EXPECT_EQ(toString(*backend->doFetchLedgerObject(key, SEQ + 1, yield)), "second");
+        EXPECT_FALSE(backend->doFetchLedgerObject(key, SEQ + 2, yield));
+
+        auto const objs = backend->doFetchLedgerObjects({key, ripple::uint256{}}, SEQ + 1, yield);
+        ASSERT_EQ(objs.size(), 2);
+        EXPECT_EQ(toString(objs[0]), "second");
+        EXPECT_TRUE(objs[1].empty());
+
+        auto const diff = backend->fetchLedgerDiff(SEQ + 1, yield);
+        ASSERT_EQ(diff.size(), 1);
+        EXPECT_EQ(diff[0].key, key);
+        EXPECT_EQ(toString(diff[0].blob), "second");
+
+        auto const successor = backend->doFetchSuccessorKey(firstKey, SEQ + 1, yield);
+        ASSERT_TRUE(successor);
+        EXPECT_EQ(*successor, key);
+        EXPECT_FALSE(backend->doFetchSuccessorKey(key, SEQ + 1, yield));
+        EXPECT_FALSE(backend->doFetchSuccessorKey(firstKey, SEQ + 2, yield));
+    });
+}
+
+TEST_F(EmbeddedBackendTest, LedgerScanPages)
+{
+    runSpawn([this](auto yield) {
+        auto const low = ripple::uint256{"00000000000000000000000000000000000000000000000000000000000000AA"};
+        auto const middle = ripple::uint256{KEY};
+        auto const high = ripple::uint256{"FF000000000000000000000000000000000000000000000000000000000000BB"};
+
+        writeLedger(SEQ);
+        backend->writeLedgerObject(uint256ToString(low), SEQ, "low");
+        backend->writeLedgerObject(uint256ToString(middle), SEQ, "middle");
+        backend->writeLedgerObject(uint256ToString(high), SEQ, "high");
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+
+        writeLedger(SEQ + 1);
+        backend->writeLedgerObject(uint256ToString(low), SEQ + 1, "low2");
+        backend->writeLedgerObject(uint256ToString(middle), SEQ + 1, "");
+        ASSERT_TRUE(backend->finishWrites(SEQ + 1));
+
+        auto const ranges = ScanRange::split(2);
+        ASSERT_EQ(ranges.size(), 2);
+        EXPECT_EQ(ranges[0].last + 1, ranges[1].first);
+
+        auto page = backend->fetchLedgerScanPage(ranges[0], std::nullopt, SEQ, 1, yield);
+        ASSERT_EQ(page.objects.size(), 1);
+        EXPECT_EQ(page.objects[0].key, low);
+        ASSERT_TRUE(page.cursor);
+
+        page = backend->fetchLedgerScanPage(ranges[0], page.cursor, SEQ, 1, yield);
+        ASSERT_EQ(page.objects.size(), 1);
+        EXPECT_EQ(toString(page.objects[0].blob), "middle");
+        EXPECT_FALSE(page.cursor);
+
+        page = backend->fetchLedgerScanPage(ranges[1], std::nullopt, SEQ, 10, yield);
+        ASSERT_EQ(page.objects.size(), 1);
+        EXPECT_EQ(page.objects[0].key, high);
+        EXPECT_FALSE(page.cursor);
+
+        // only the latest version is returned and deleted objects are skipped
+        page = backend->fetchLedgerScanPage(ranges[0], std::nullopt, SEQ + 1, 10, yield);
+        ASSERT_EQ(page.objects.size(), 1);
+        EXPECT_EQ(toString(page.objects[0].blob), "low2");
+    });
+}
+
+TEST_F(EmbeddedBackendTest, WritesInvisibleUntilFinished)
+{
+    runSpawn([this](auto yield) {
+        writeLedger(SEQ);
+        writeObject(SEQ, "first");
+
+        EXPECT_FALSE(backend->doFetchLedgerObject(ripple::uint256{KEY}, SEQ, yield));
+        EXPECT_FALSE(backend->fetchLedgerBySequence(SEQ, yield));
+
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+        EXPECT_TRUE(backend->doFetchLedgerObject(ripple::uint256{KEY}, SEQ, yield));
+    });
+}
+
+TEST_F(EmbeddedBackendTest, AccountTransactionsPaging)
+{
+    runSpawn([this](auto yield) {
+        auto const account = GetAccountIDWithString(ACCOUNT);
+
+        writeLedger(SEQ);
+        std::vector<AccountTransactionsData> accountTxs;
+        for (std::uint32_t idx = 0; idx < 3; ++idx) {
+            auto const hash = ripple::uint256{hashOf(100 + idx).c_str()};
+            backend->writeTransaction(uint256ToString(hash), SEQ, idx, fmt::format("tx{}", idx), "meta");
+
+            AccountTransactionsData data;
+            data.accounts.insert(account);
+            data.ledgerSequence = SEQ;
+            data.transactionIndex = idx;
+            data.txHash = hash;
+            accountTxs.push_back(std::move(data));
+        }
+        backend->writeAccountTransactions(std::move(accountTxs));
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+
+        EXPECT_EQ(backend->fetchAllTransactionHashesInLedger(SEQ, yield).size(), 3);
+
+        auto const [first, cursor] = backend->fetchAccountTransactions(account, 2, false, {}, yield);
+        ASSERT_EQ(first.size(), 2);
+        EXPECT_EQ(toString(first[0].transaction), "tx2");
+        EXPECT_EQ(toString(first[1].transaction), "tx1");
+        ASSERT_TRUE(cursor);
+        EXPECT_EQ(cursor->ledgerSequence, SEQ);
+        EXPECT_EQ(cursor->transactionIndex, 1);
+
+        auto const [rest, noCursor] = backend->fetchAccountTransactions(account, 2, false, cursor, yield);
+        ASSERT_EQ(rest.size(), 1);
+        EXPECT_EQ(toString(rest[0].transaction), "tx0");
+        EXPECT_EQ(rest[0].date, 0);
+        EXPECT_FALSE(noCursor);
+
+        auto const [forward, _] =
+            backend->fetchAccountTransactions(account, 10, true, TransactionsCursor{SEQ - 1, 0}, yield);
+        ASSERT_EQ(forward.size(), 3);
+        EXPECT_EQ(toString(forward[0].transaction), "tx0");
+    });
+}
+
+TEST_F(EmbeddedBackendTest, NFTs)
+{
+    runSpawn([this](auto yield) {
+        auto const tokenID = ripple::uint256{TOKENID};
+        auto const owner = GetAccountIDWithString(ACCOUNT);
+
+        writeLedger(SEQ);
+        backend->writeNFTs({NFTsData{tokenID, SEQ, owner, ripple::Blob{'u', 'r', 'i'}}});
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+
+        EXPECT_FALSE(backend->fetchNFT(tokenID, SEQ - 1, yield));
+
+        auto const nft = backend->fetchNFT(tokenID, SEQ, yield);
+        ASSERT_TRUE(nft);
+        EXPECT_EQ(nft->owner, owner);
+        EXPECT_EQ(toString(nft->uri), "uri");
+        EXPECT_FALSE(nft->isBurned);
+
+        auto const byIssuer =
+            backend->fetchNFTsByIssuer(ripple::nft::getIssuer(tokenID), std::nullopt, SEQ, 10, std::nullopt, yield);
+        ASSERT_EQ(byIssuer.nfts.size(), 1);
+        EXPECT_EQ(byIssuer.nfts[0].tokenID, tokenID);
+        EXPECT_FALSE(byIssuer.cursor);
+    });
+}
+
+TEST_F(EmbeddedBackendTest, NFTIndexIsFilledByReads)
+{
+    runSpawn([this](auto yield) {
+        auto const tokenID = ripple::uint256{TOKENID};
+        auto const issuer = ripple::nft::getIssuer(tokenID);
+        backend->nftIndex().enable(10, 10);
+
+        writeLedger(SEQ);
+        backend->writeNFTs({NFTsData{tokenID, SEQ, GetAccountIDWithString(ACCOUNT), ripple::Blob{'u', 'r', 'i'}}});
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+        backend->nftIndex().update({}, SEQ);
+
+        EXPECT_TRUE(backend->nftIndex().shouldLoadIssuer(issuer, SEQ));
+        auto const byIssuer = backend->fetchNFTsByIssuer(issuer, std::nullopt, SEQ, 10, std::nullopt, yield);
+        ASSERT_EQ(byIssuer.nfts.size(), 1);
+        EXPECT_FALSE(backend->nftIndex().shouldLoadIssuer(issuer, SEQ));
+        EXPECT_EQ(backend->nftIndex().size(), 1);
+
+        auto const nft = backend->nftIndex().getNFT(tokenID, SEQ);
+        ASSERT_TRUE(nft);
+        EXPECT_EQ(toString(nft->uri), "uri");
+    });
+}
+
+TEST_F(EmbeddedBackendTest, ReplaysLogOnOpen)
+{
+    runSpawn([this](auto yield) {
+        writeLedger(SEQ);
+        writeObject(SEQ, "first");
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+
+        reopen();
+
+        auto const rng = backend->hardFetchLedgerRange(yield);
+        ASSERT_TRUE(rng);
+        EXPECT_EQ(rng->maxSequence, SEQ);
+        EXPECT_EQ(toString(*backend->doFetchLedgerObject(ripple::uint256{KEY}, SEQ, yield)), "first");
+    });
+}
+
+TEST_F(EmbeddedBackendTest, TornBatchDroppedOnOpen)
+{
+    runSpawn([this](auto yield) {
+        writeLedger(SEQ);
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+        backend.reset();
+
+        // simulate a crash in the middle of appending the next ledger
+        std::ofstream{dir / "clio.wal", std::ios::binary | std::ios::app} << "CWL2\x01\x00";
+        backend = std::make_unique<EmbeddedBackend>(settings, false);
+        EXPECT_EQ(backend->hardFetchLedgerRange(yield)->maxSequence, SEQ);
+
+        writeLedger(SEQ + 1);
+        ASSERT_TRUE(backend->finishWrites(SEQ + 1));
+
+        reopen();
+        EXPECT_EQ(backend->hardFetchLedgerRange(yield)->maxSequence, SEQ + 1);
+    });
+}
+
+TEST_F(EmbeddedBackendTest, LedgerCommittedAcrossChunks)
+{
+    settings.chunkSize = 64;
+    reopen();
+
+    runSpawn([this](auto yield) {
+        auto const key = ripple::uint256{KEY};
+
+        writeLedger(SEQ);
+        writeObject(SEQ, "first");
+        for (auto i = 0u; i < 10; ++i)
+            backend->writeSuccessor(uint256ToString(key), SEQ, uint256ToString(ripple::uint256{hashOf(i).c_str()}));
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+
+        reopen();
+
+        auto const rng = backend->hardFetchLedgerRange(yield);
+        ASSERT_TRUE(rng);
+        EXPECT_EQ(rng->maxSequence, SEQ);
+        EXPECT_TRUE(backend->fetchLedgerBySequence(SEQ, yield));
+        EXPECT_EQ(toString(*backend->doFetchLedgerObject(key, SEQ, yield)), "first");
+        EXPECT_EQ(*backend->doFetchSuccessorKey(key, SEQ, yield), ripple::uint256{hashOf(9).c_str()});
+    });
+}
+
+TEST_F(EmbeddedBackendTest, UncommittedChunksDroppedOnOpen)
+{
+    settings.chunkSize = 64;
+    reopen();
+
+    runSpawn([this](auto yield) {
+        auto const key = ripple::uint256{KEY};
+
+        writeLedger(SEQ);
+        writeObject(SEQ, "first");
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+
+        // chunks of the next ledger reach the log but the ledger is never committed
+        writeLedger(SEQ + 1);
+        for (auto i = 0u; i < 10; ++i)
+            writeObject(SEQ + 1, "second");
+
+        reopen();
+
+        EXPECT_EQ(backend->hardFetchLedgerRange(yield)->maxSequence, SEQ);
+        EXPECT_FALSE(backend->fetchLedgerBySequence(SEQ + 1, yield));
+        EXPECT_EQ(toString(*backend->doFetchLedgerObject(key, SEQ + 1, yield)), "first");
+    });
+}
+
+TEST_F(EmbeddedBackendTest, DeleteLedgersBefore)
+{
+    runSpawn([this](auto yield) {
+        auto const key = ripple::uint256{KEY};
+
+        writeLedger(SEQ);
+        writeObject(SEQ, "first");
+        backend->writeTransaction(uint256ToString(ripple::uint256{hashOf(100).c_str()}), SEQ, 0, "tx", "meta");
+        ASSERT_TRUE(backend->finishWrites(SEQ));
+        for (auto seq = SEQ + 1; seq <= SEQ + 3; ++seq) {
+            writeLedger(seq);
+            ASSERT_TRUE(backend->finishWrites(seq));
+        }
+
+        EXPECT_TRUE(backend->deleteLedgersBefore(SEQ + 2));
+
+        auto const check = [&]() {
+            auto const rng = backend->hardFetchLedgerRange(yield);
+            ASSERT_TRUE(rng);
+            EXPECT_EQ(rng->minSequence, SEQ + 2);
+            EXPECT_EQ(rng->maxSequence, SEQ + 3);
+
+            EXPECT_FALSE(backend->fetchLedgerBySequence(SEQ + 1, yield));
+            EXPECT_TRUE(backend->fetchLedgerBySequence(SEQ + 2, yield));
+            EXPECT_FALSE(backend->fetchTransaction(ripple::uint256{hashOf(100).c_str()}, yield));
+
+            // still visible in the first remaining ledger
+            EXPECT_EQ(toString(*backend->doFetchLedgerObject(key, SEQ + 2, yield)), "first");
+        };
+
+        check();
+        EXPECT_EQ(backend->fetchLedgerRange()->minSequence, SEQ + 2);
+
+        reopen();
+        check();
+    });
+}
+
+TEST_F(EmbeddedBackendTest, OnlineDelete)
+{
+    settings.onlineDelete = 2;
+    reopen();
+
+    runSpawn([this](auto yield) {
+        for (auto seq = SEQ; seq < SEQ + 4; ++seq) {
+            writeLedger(seq);
+            ASSERT_TRUE(backend->finishWrites(seq));
+        }
+
+        auto const rng = backend->hardFetchLedgerRange(yield);
+        ASSERT_TRUE(rng);
+        EXPECT_EQ(rng->minSequence, SEQ + 2);
+        EXPECT_EQ(rng->maxSequence, SEQ + 3);
+    });
+}
+
+TEST_F(EmbeddedBackendTest, ReadOnlyRefusesWrites)
+{
+    backend.reset();
+    backend = std::make_unique<EmbeddedBackend>(settings, true);
+
+    writeLedger(SEQ);
+    EXPECT_FALSE(backend->finishWrites(SEQ));
+    EXPECT_FALSE(backend->deleteLedgersBefore(SEQ));
+}
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <util/Fixtures.h>
+#include <util/MockPrometheus.h>
+
+#include <data/LedgerCache.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace data;
+using namespace util::prometheus;
+
+namespace {
+
+LedgerObject
+makeObject(unsigned char keyByte, std::size_t size)
+{
+    ripple::uint256 key;
+    *key.begin() = keyByte;
+
+    Blob blob{0x11, 0x00, 0x61};
+    blob.resize(size, keyByte);
+    return {key, blob};
+}
+
+}  // namespace
+
+struct LedgerCacheTest : WithPrometheus, NoLoggerFixture {
+    LedgerCache cache;
+};
+
+TEST_F(LedgerCacheTest, GetReturnsLatestObject)
+{
+    auto const obj = makeObject(1, 100);
+    cache.update({obj}, 1);
+    cache.update({{obj.key, Blob{0x11, 0x00, 0x61, 0x42}}}, 2);
+
+    EXPECT_EQ(cache.get(obj.key, 2), (Blob{0x11, 0x00, 0x61, 0x42}));
+    EXPECT_FALSE(cache.get(obj.key, 3));
+    EXPECT_FALSE(cache.isCompressed());
+}
+
+TEST_F(LedgerCacheTest, CompressedObjectsAreReadBack)
+{
+    cache.setCompression();
+    EXPECT_TRUE(cache.isCompressed());
+
+    auto const first = makeObject(1, 200);
+    auto const second = makeObject(2, 300);
+    cache.update({first, second}, 1);
+    cache.setFull();
+
+    EXPECT_EQ(cache.get(first.key, 1), first.blob);
+    EXPECT_EQ(cache.get(second.key, 1), second.blob);
+
+    auto const successor = cache.getSuccessor(first.key, 1);
+    ASSERT_TRUE(successor);
+    EXPECT_EQ(successor->blob, second.blob);
+
+    auto const predecessor = cache.getPredecessor(second.key, 1);
+    ASSERT_TRUE(predecessor);
+    EXPECT_EQ(predecessor->blob, first.blob);
+}
+
+TEST_F(LedgerCacheTest, CompressionCantBeSetOnPopulatedCache)
+{
+    cache.update({makeObject(1, 10)}, 1);
+    EXPECT_THROW(cache.setCompression(), std::logic_error);
+}
+
+TEST_F(LedgerCacheTest, BoundedCacheIsPopulatedOnDemand)
+{
+    cache.setBounded(1024 * 1024);
+    EXPECT_TRUE(cache.isBounded());
+
+    auto const obj = makeObject(1, 100);
+    cache.update({obj}, 1);
+    cache.setFull();
+    EXPECT_FALSE(cache.isFull());
+    EXPECT_FALSE(cache.get(obj.key, 1));
+
+    cache.put(obj.key, 1, obj.blob);
+    EXPECT_EQ(cache.get(obj.key, 1), obj.blob);
+    EXPECT_EQ(cache.size(), 1);
+
+    cache.update({{obj.key, Blob{0x11, 0x00, 0x61, 0x42}}}, 2);
+    EXPECT_FALSE(cache.get(obj.key, 1));
+    EXPECT_EQ(cache.get(obj.key, 2), (Blob{0x11, 0x00, 0x61, 0x42}));
+
+    // objects fetched for an older ledger may have changed since
+    auto const other = makeObject(2, 100);
+    cache.put(other.key, 1, other.blob);
+    EXPECT_FALSE(cache.get(other.key, 2));
+
+    EXPECT_FLOAT_EQ(cache.getBoundedHitRate(), 2.f / 5);
+    EXPECT_FLOAT_EQ(cache.getObjectHitRate(), 1);
+}
+
+TEST_F(LedgerCacheTest, CantBeBoundedWhenPopulated)
+{
+    cache.update({makeObject(1, 10)}, 1);
+    EXPECT_THROW(cache.setBounded(1024), std::logic_error);
+}
+
+struct LedgerCacheMockPrometheusTest : WithMockPrometheus, NoLoggerFixture {};
+
+TEST_F(LedgerCacheMockPrometheusTest, ReportsMemoryAndDecompression)
+{
+    auto& uncompressed = makeMock<GaugeInt>("ledger_cache_bytes_current_number", "{type=\"uncompressed\"}");
+    auto& stored = makeMock<GaugeInt>("ledger_cache_bytes_current_number", "{type=\"stored\"}");
+    auto& decompressions = makeMock<CounterInt>("ledger_cache_decompression_total_number", "");
+    auto& duration = makeMock<CounterInt>("ledger_cache_decompression_duration_us", "");
+    auto& requests =
+        makeMock<CounterInt>("ledger_cache_counter_total_number", "{fetch=\"ledger_objects\",type=\"request\"}");
+    auto& hits =
+        makeMock<CounterInt>("ledger_cache_counter_total_number", "{fetch=\"ledger_objects\",type=\"cache_hit\"}");
+
+    LedgerCache cache;
+    cache.setCompression();
+    auto const obj = makeObject(1, 1000);
+
+    EXPECT_CALL(uncompressed, add(0));
+    EXPECT_CALL(stored, add(0));
+    EXPECT_CALL(uncompressed, add(1000));
+    EXPECT_CALL(stored, add(testing::Lt(1000)));
+    cache.update({obj}, 1);
+
+    EXPECT_CALL(requests, add(1));
+    EXPECT_CALL(hits, add(1));
+    EXPECT_CALL(decompressions, add(1));
+    EXPECT_CALL(duration, add(testing::_));
+    EXPECT_EQ(cache.get(obj.key, 1), obj.blob);
+}
@@ -0,0 +1,258 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <util/TestObject.h>
+
+#include <data/NFTIndex.h>
+
+#include <ripple/protocol/nft.h>
+
+#include <gtest/gtest.h>
+
+using namespace data;
+
+namespace {
+
+constexpr static auto ACCOUNT = "r4X6JLsBfhNK4UnquNkCxhVHKPkvbQff67";
+constexpr static auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr static auto NFTID1 = "00080000EC28C2910FD1C454A51598AAB91C8876286B2E7F0000099B00000000";  // taxon 0
+constexpr static auto NFTID2 = "00080000EC28C2910FD1C454A51598AAB91C8876286B2E7F16E5DA9C00000001";  // taxon 0
+constexpr static auto NFTID3 = "00080000EC28C2910FD1C454A51598AAB91C8876286B2E7F5B974D9E00000004";  // taxon 1
+// another issuer
+constexpr static auto NFTID4 = "00080000A0B1C2D3E4F5A6B7C8D9E0F1A2B3C4D5E6F7A8B90000099B00000000";
+constexpr static auto MAX_ISSUER_TOKENS = 10;
+constexpr static auto MAX_TOKENS = 2;
+
+NFTsData
+makeMint(char const* tokenID, char const* owner, std::uint32_t seq, std::uint32_t txIndex)
+{
+    NFTsData mint{ripple::uint256{tokenID}, seq, GetAccountIDWithString(owner), Blob{'u', 'r', 'i'}};
+    mint.transactionIndex = txIndex;
+    return mint;
+}
+
+NFTsData
+makeTransfer(char const* tokenID, char const* owner, std::uint32_t seq, std::uint32_t txIndex, bool isBurned = false)
+{
+    auto transfer = makeMint(tokenID, owner, seq, txIndex);
+    transfer.uri.reset();
+    transfer.isBurned = isBurned;
+    return transfer;
+}
+
+NFT
+makeNFT(char const* tokenID, char const* owner, std::uint32_t seq)
+{
+    return NFT{ripple::uint256{tokenID}, seq, GetAccountIDWithString(owner), Blob{'u', 'r', 'i'}, false};
+}
+
+}  // namespace
+
+struct NFTIndexTest : NoLoggerFixture {
+    NFTIndex index;
+
+    void
+    SetUp() override
+    {
+        NoLoggerFixture::SetUp();
+        index.enable(MAX_ISSUER_TOKENS, MAX_TOKENS);
+    }
+
+    void
+    loadIssuerOf(char const* tokenID, std::uint32_t seq)
+    {
+        index.update({}, seq);
+        index.putIssuer(ripple::nft::getIssuer(ripple::uint256{tokenID}), {}, seq);
+    }
+};
+
+TEST_F(NFTIndexTest, DisabledIndexIgnoresEverything)
+{
+    NFTIndex disabled;
+    disabled.update({makeMint(NFTID1, ACCOUNT, 10, 0)}, 10);
+    disabled.put(makeNFT(NFTID2, ACCOUNT, 5), 10);
+
+    EXPECT_FALSE(disabled.isEnabled());
+    EXPECT_EQ(disabled.size(), 0);
+    EXPECT_FALSE(disabled.getNFT(ripple::uint256{NFTID1}, 10));
+    EXPECT_FALSE(disabled.shouldLoadIssuer(GetAccountIDWithString(ACCOUNT), 10));
+}
+
+TEST_F(NFTIndexTest, MintIsServedFromItsSequenceOn)
+{
+    loadIssuerOf(NFTID1, 9);
+    index.update({makeMint(NFTID1, ACCOUNT, 10, 0)}, 10);
+
+    EXPECT_EQ(index.latestLedgerSequence(), 10);
+    EXPECT_FALSE(index.getNFT(ripple::uint256{NFTID1}, 9));
+    EXPECT_FALSE(index.getNFT(ripple::uint256{NFTID1}, 11));
+
+    auto const nft = index.getNFT(ripple::uint256{NFTID1}, 10);
+    ASSERT_TRUE(nft);
+    EXPECT_EQ(nft->ledgerSequence, 10);
+    EXPECT_EQ(nft->owner, GetAccountIDWithString(ACCOUNT));
+    EXPECT_EQ(nft->uri, (Blob{'u', 'r', 'i'}));
+    EXPECT_FALSE(nft->isBurned);
+}
+
+TEST_F(NFTIndexTest, LastChangeOfLedgerWins)
+{
+    loadIssuerOf(NFTID1, 9);
+    index.update({makeMint(NFTID1, ACCOUNT, 10, 0)}, 10);
+    index.update({makeTransfer(NFTID1, ACCOUNT2, 11, 3, true), makeTransfer(NFTID1, ACCOUNT, 11, 1)}, 11);
+
+    auto const nft = index.getNFT(ripple::uint256{NFTID1}, 11);
+    ASSERT_TRUE(nft);
+    EXPECT_EQ(nft->ledgerSequence, 11);
+    EXPECT_EQ(nft->owner, GetAccountIDWithString(ACCOUNT2));
+    EXPECT_EQ(nft->uri, (Blob{'u', 'r', 'i'}));
+    EXPECT_TRUE(nft->isBurned);
+
+    // the older state is not kept
+    EXPECT_FALSE(index.getNFT(ripple::uint256{NFTID1}, 10));
+}
+
+TEST_F(NFTIndexTest, ChangeOfUnknownTokenIsLeftToTheDatabase)
+{
+    index.update({makeTransfer(NFTID1, ACCOUNT2, 10, 0)}, 10);
+
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_FALSE(index.getNFT(ripple::uint256{NFTID1}, 10));
+}
+
+TEST_F(NFTIndexTest, MintOfIssuerNotIndexedIsLeftToTheDatabase)
+{
+    index.update({makeMint(NFTID1, ACCOUNT, 10, 0)}, 10);
+
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_FALSE(index.getNFT(ripple::uint256{NFTID1}, 10));
+}
+
+TEST_F(NFTIndexTest, SequenceGapClearsIndex)
+{
+    loadIssuerOf(NFTID1, 10);
+    index.update({makeMint(NFTID1, ACCOUNT, 11, 0)}, 11);
+    EXPECT_EQ(index.size(), 1);
+
+    index.update({}, 13);
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.latestLedgerSequence(), 13);
+}
+
+TEST_F(NFTIndexTest, PutOnlyAcceptsLatestSequence)
+{
+    index.update({}, 10);
+
+    index.put(makeNFT(NFTID1, ACCOUNT, 5), 9);
+    EXPECT_FALSE(index.getNFT(ripple::uint256{NFTID1}, 9));
+
+    index.put(makeNFT(NFTID1, ACCOUNT, 5), 10);
+    EXPECT_FALSE(index.getNFT(ripple::uint256{NFTID1}, 4));
+    EXPECT_TRUE(index.getNFT(ripple::uint256{NFTID1}, 5));
+    EXPECT_TRUE(index.getNFT(ripple::uint256{NFTID1}, 10));
+}
+
+TEST_F(NFTIndexTest, OldestTokensReadOnTheirOwnAreEvicted)
+{
+    index.update({}, 10);
+    index.put(makeNFT(NFTID1, ACCOUNT, 5), 10);
+    index.put(makeNFT(NFTID2, ACCOUNT, 6), 10);
+    index.put(makeNFT(NFTID3, ACCOUNT, 7), 10);
+
+    EXPECT_EQ(index.size(), MAX_TOKENS);
+    EXPECT_FALSE(index.getNFT(ripple::uint256{NFTID1}, 10));
+    EXPECT_TRUE(index.getNFT(ripple::uint256{NFTID2}, 10));
+    EXPECT_TRUE(index.getNFT(ripple::uint256{NFTID3}, 10));
+}
+
+TEST_F(NFTIndexTest, TokensOfIndexedIssuerAreNeverEvicted)
+{
+    auto const issuer = ripple::nft::getIssuer(ripple::uint256{NFTID1});
+    index.update({}, 10);
+    index.put(makeNFT(NFTID1, ACCOUNT, 5), 10);
+    index.put(makeNFT(NFTID2, ACCOUNT, 6), 10);
+    index.putIssuer(
+        issuer, {makeNFT(NFTID1, ACCOUNT, 5), makeNFT(NFTID2, ACCOUNT, 6), makeNFT(NFTID3, ACCOUNT, 7)}, 10
+    );
+    index.put(makeNFT(NFTID4, ACCOUNT2, 8), 10);
+
+    EXPECT_EQ(index.size(), 4);
+    EXPECT_TRUE(index.getNFT(ripple::uint256{NFTID1}, 10));
+    EXPECT_TRUE(index.getNFTsByIssuer(issuer, std::nullopt, 10, 10, std::nullopt));
+}
+
+TEST_F(NFTIndexTest, IssuerIsPagedLikeTheDatabase)
+{
+    auto const issuer = ripple::nft::getIssuer(ripple::uint256{NFTID1});
+    index.update({}, 10);
+
+    EXPECT_TRUE(index.shouldLoadIssuer(issuer, 10));
+    EXPECT_FALSE(index.shouldLoadIssuer(issuer, 9));
+    EXPECT_FALSE(index.getNFTsByIssuer(issuer, std::nullopt, 10, 10, std::nullopt));
+
+    index.putIssuer(
+        issuer, {makeNFT(NFTID3, ACCOUNT, 5), makeNFT(NFTID2, ACCOUNT, 6), makeNFT(NFTID1, ACCOUNT, 7)}, 10
+    );
+    EXPECT_FALSE(index.shouldLoadIssuer(issuer, 10));
+    EXPECT_FALSE(index.getNFTsByIssuer(issuer, std::nullopt, 9, 10, std::nullopt));
+
+    auto const first = index.getNFTsByIssuer(issuer, std::nullopt, 10, 2, std::nullopt);
+    ASSERT_TRUE(first);
+    ASSERT_EQ(first->nfts.size(), 2);
+    EXPECT_EQ(first->nfts[0].tokenID, ripple::uint256{NFTID1});
+    EXPECT_EQ(first->nfts[1].tokenID, ripple::uint256{NFTID2});
+    EXPECT_EQ(first->cursor, ripple::uint256{NFTID2});
+
+    auto const second = index.getNFTsByIssuer(issuer, std::nullopt, 10, 2, first->cursor);
+    ASSERT_TRUE(second);
+    ASSERT_EQ(second->nfts.size(), 1);
+    EXPECT_EQ(second->nfts[0].tokenID, ripple::uint256{NFTID3});
+    EXPECT_FALSE(second->cursor);
+
+    auto const taxon1 = index.getNFTsByIssuer(issuer, 1, 10, 10, std::nullopt);
+    ASSERT_TRUE(taxon1);
+    ASSERT_EQ(taxon1->nfts.size(), 1);
+    EXPECT_EQ(taxon1->nfts[0].tokenID, ripple::uint256{NFTID3});
+}
+
+TEST_F(NFTIndexTest, MintIsAddedToLoadedIssuer)
+{
+    auto const issuer = ripple::nft::getIssuer(ripple::uint256{NFTID1});
+    index.update({}, 10);
+    index.putIssuer(issuer, {makeNFT(NFTID1, ACCOUNT, 7)}, 10);
+    index.update({makeMint(NFTID2, ACCOUNT, 11, 0)}, 11);
+
+    auto const page = index.getNFTsByIssuer(issuer, std::nullopt, 11, 10, std::nullopt);
+    ASSERT_TRUE(page);
+    ASSERT_EQ(page->nfts.size(), 2);
+    EXPECT_EQ(page->nfts[1].tokenID, ripple::uint256{NFTID2});
+    EXPECT_EQ(page->nfts[1].ledgerSequence, 11);
+}
+
+TEST_F(NFTIndexTest, SkippedIssuerIsNeverLoaded)
+{
+    auto const issuer = ripple::nft::getIssuer(ripple::uint256{NFTID1});
+    index.update({}, 10);
+    index.skipIssuer(issuer);
+
+    EXPECT_FALSE(index.shouldLoadIssuer(issuer, 10));
+    index.update({}, 12);
+    EXPECT_FALSE(index.shouldLoadIssuer(issuer, 12));
+}
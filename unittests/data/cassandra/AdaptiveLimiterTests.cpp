@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <util/Fixtures.h>
+#include <util/MockPrometheus.h>
+
+#include <data/cassandra/impl/AdaptiveLimiter.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace data::cassandra::detail;
+using namespace util::prometheus;
+using namespace std::chrono_literals;
+
+struct BackendCassandraAdaptiveLimiterTest : WithPrometheus, SyncAsioContextTest {};
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, NonAdaptiveKeepsMaxLimit)
+{
+    AdaptiveLimiter limiter{"test", 100, false};
+    limiter.acquire();
+    limiter.release(1, 10s, false);
+
+    EXPECT_EQ(limiter.limit(), 100);
+    EXPECT_EQ(limiter.inflight(), 0);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, DecreasesOnFailure)
+{
+    AdaptiveLimiter limiter{"test", 100};
+    limiter.acquire();
+    limiter.release(1, 1ms, false);
+
+    EXPECT_EQ(limiter.limit(), 90);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, DecreasesOnSlowRequest)
+{
+    AdaptiveLimiter limiter{"test", 100};
+    limiter.acquire();
+    limiter.release(1, 100us, true);
+    EXPECT_EQ(limiter.limit(), 100);
+
+    limiter.acquire();
+    limiter.release(1, 10ms, true);
+    EXPECT_EQ(limiter.limit(), 90);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, DecreasesAtMostOncePerRoundTrip)
+{
+    AdaptiveLimiter limiter{"test", 100};
+    limiter.acquire();
+    limiter.release(1, 10s, true);
+
+    limiter.acquire(2);
+    limiter.release(1, 1ms, false);
+    limiter.release(1, 1ms, false);
+
+    EXPECT_EQ(limiter.limit(), 90);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, NeverDropsBelowMinimum)
+{
+    AdaptiveLimiter limiter{"test", 100};
+    for (auto i = 0; i < 100; ++i) {
+        limiter.acquire();
+        limiter.release(1, 0us, false);
+    }
+
+    EXPECT_EQ(limiter.limit(), AdaptiveLimiter::MIN_LIMIT);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, IncreasesOnlyWhenLimitIsUsed)
+{
+    AdaptiveLimiter limiter{"test", 100};
+    limiter.acquire();
+    limiter.release(1, 0us, false);
+    ASSERT_EQ(limiter.limit(), 90);
+
+    for (auto i = 0; i < 100; ++i) {
+        limiter.acquire();
+        limiter.release(1, 100us, true);
+    }
+    EXPECT_EQ(limiter.limit(), 90);
+
+    for (auto i = 0; i < 100; ++i) {
+        limiter.acquire(50);
+        limiter.release(50, 100us, true);
+    }
+    EXPECT_EQ(limiter.limit(), 91);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, OccasionalSlowRequestsKeepLimit)
+{
+    AdaptiveLimiter limiter{"test", 100};
+    for (auto i = 0; i < 1000; ++i) {
+        limiter.acquire(60);
+        limiter.release(60, i % 20 == 0 ? 10ms : 1ms, true);
+    }
+
+    EXPECT_EQ(limiter.limit(), 100);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, BaselineIsPerKind)
+{
+    AdaptiveLimiter limiter{"test", 100};
+    int const fast = 0;
+    int const slow = 0;
+    for (auto i = 0; i < 1000; ++i) {
+        limiter.acquire(60);
+        if (i % 2 == 0) {
+            limiter.release(60, 100us, true, &fast);
+        } else {
+            limiter.release(60, 10ms, true, &slow);
+        }
+    }
+
+    EXPECT_EQ(limiter.limit(), 100);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, DecreasesOnSustainedSlowdown)
+{
+    AdaptiveLimiter limiter{"test", 100};
+    for (auto i = 0; i < 200; ++i) {
+        limiter.acquire(60);
+        limiter.release(60, i < 20 ? 1ms : 5ms, true);
+    }
+
+    EXPECT_LT(limiter.limit(), 100);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, OverloadedOnlyWhenQueueDoesNotDrain)
+{
+    AdaptiveLimiter limiter{"test", 1, false};
+    limiter.acquire();
+
+    std::thread waiter{[&limiter]() {
+        limiter.acquire();
+        limiter.release(1, 1ms, true);
+    }};
+
+    std::this_thread::sleep_for(10ms);
+    EXPECT_FALSE(limiter.isOverloaded());
+
+    std::this_thread::sleep_for(AdaptiveLimiter::OVERLOAD_DELAY);
+    EXPECT_TRUE(limiter.isOverloaded());
+
+    limiter.release(1, 1ms, true);
+    waiter.join();
+    EXPECT_FALSE(limiter.isOverloaded());
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, OversizedRequestPassesAlone)
+{
+    AdaptiveLimiter limiter{"test", 10};
+    limiter.acquire(20);
+
+    EXPECT_EQ(limiter.inflight(), 20);
+    EXPECT_TRUE(limiter.isSaturated());
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, BlockedThreadIsLetInOnRelease)
+{
+    AdaptiveLimiter limiter{"test", 10, false};
+    limiter.acquire(10);
+    EXPECT_TRUE(limiter.isSaturated());
+
+    std::atomic_bool acquired = false;
+    auto thread = std::thread([&]() {
+        limiter.acquire();
+        acquired = true;
+    });
+
+    std::this_thread::sleep_for(10ms);
+    EXPECT_FALSE(acquired);
+
+    limiter.release(10, 1ms, true);
+    thread.join();
+
+    EXPECT_TRUE(acquired);
+    EXPECT_EQ(limiter.inflight(), 1);
+}
+
+TEST_F(BackendCassandraAdaptiveLimiterTest, SuspendedCoroutinesAreLetInInOrder)
+{
+    AdaptiveLimiter limiter{"test", 1, false};
+    limiter.acquire();
+
+    std::vector<std::string> order;
+    for (auto const* name : {"first", "second"}) {
+        boost::asio::spawn(ctx, [&, name](boost::asio::yield_context yield) {
+            limiter.acquire(yield);
+            order.emplace_back(name);
+            limiter.release(1, 1ms, true);
+        });
+    }
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        boost::asio::post(yield);
+        EXPECT_TRUE(order.empty());
+        EXPECT_TRUE(limiter.isSaturated());
+
+        limiter.release(1, 1ms, true);
+    });
+
+    EXPECT_EQ(order, (std::vector<std::string>{"first", "second"}));
+    EXPECT_EQ(limiter.inflight(), 0);
+}
@@ -723,6 +723,21 @@ TEST_F(BackendCassandraTest, Basic)
                 if (found != (obj.second.size() != 0))
                     ASSERT_EQ(found, obj.second.size() != 0);
             }
+
+            std::vector<data::LedgerObject> scannedObjs;
+            for (auto const& range : data::ScanRange::split(4)) {
+                data::LedgerScanPage scanPage;
+                do {
+                    uint32_t const limit = 7;
+                    scanPage = backend->fetchLedgerScanPage(range, scanPage.cursor, seq, limit, yield);
+                    scannedObjs.insert(scannedObjs.end(), scanPage.objects.begin(), scanPage.objects.end());
+                } while (scanPage.cursor);
+            }
+
+            auto const byKey = [](auto const& a, auto const& b) { return a.key < b.key; };
+            std::sort(retObjs.begin(), retObjs.end(), byKey);
+            std::sort(scannedObjs.begin(), scannedObjs.end(), byKey);
+            EXPECT_EQ(scannedObjs, retObjs);
         };
 
         std::map<uint32_t, std::vector<std::pair<std::string, std::string>>> state;
@@ -24,6 +24,7 @@
 #include <fmt/core.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <semaphore>
 
 using namespace std;
@@ -289,6 +290,41 @@ TEST_F(BackendCassandraBaseTest, CreateTableWithStrings)
     }
 }
 
+TEST_F(BackendCassandraBaseTest, ExtractBlobViewWithoutCopy)
+{
+    auto const blob = std::vector<unsigned char>{0xDE, 0xAD, 0xBE, 0xEF};
+
+    auto handle = createHandle("127.0.0.1", "test");
+    {
+        auto const res = handle.execute("CREATE TABLE IF NOT EXISTS blobs (id bigint PRIMARY KEY, data blob)");
+        ASSERT_TRUE(res) << res.error();
+    }
+
+    auto insert = handle.prepare("INSERT INTO blobs (id, data) VALUES (?, ?)");
+    {
+        auto const rc = handle.asyncExecute(insert, int64_t{1}, blob).await();
+        ASSERT_TRUE(rc) << rc.error();
+    }
+
+    {
+        auto const res = handle.execute("SELECT id, data FROM blobs");
+        ASSERT_TRUE(res) << res.error();
+
+        auto const maybeRow = res->get<int64_t, BlobView>();
+        ASSERT_TRUE(maybeRow);
+
+        auto const [id, view] = *maybeRow;
+        EXPECT_EQ(id, 1);
+        EXPECT_TRUE(std::equal(view.begin(), view.end(), blob.begin(), blob.end()));
+    }
+
+    {
+        auto const res = handle.execute("DROP TABLE blobs");
+        ASSERT_TRUE(res) << res.error();
+        dropKeyspace(handle, "test");
+    }
+}
+
 TEST_F(BackendCassandraBaseTest, BatchInsert)
 {
     auto const entries = std::vector<std::string>{
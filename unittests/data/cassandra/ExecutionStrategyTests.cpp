@@ -24,6 +24,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 using namespace data::cassandra;
 using namespace data::cassandra::detail;
 using namespace testing;
@@ -98,6 +103,13 @@ TEST_F(BackendCassandraExecutionStrategyTest, IsTooBusy)
     EXPECT_FALSE(strat.isTooBusy());
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, AdaptiveIsNotTooBusyWithoutQueueing)
+{
+    auto strat = makeStrategy(Settings{.maxReadRequestsOutstanding = 0, .adaptiveConcurrency = true});
+    EXPECT_CALL(*counters, registerTooBusy()).Times(0);
+    EXPECT_FALSE(strat.isTooBusy());
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, ReadOneInCoroutineSuccessful)
 {
     auto strat = makeStrategy();
@@ -160,6 +172,38 @@ TEST_F(BackendCassandraExecutionStrategyTest, ReadOneInCoroutineThrowsOnInvalidQ
     });
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, ReadOneInCoroutineHedgesSlowRead)
+{
+    auto strat = makeStrategy(Settings{.hedgedReads = true, .hedgeBudgetPercent = 100});
+    auto const numReads = HedgingPolicy::MIN_SAMPLES + 1;
+    auto numCalls = 0u;
+    std::function<void(FakeResultOrError)> slowCallback;
+
+    // the first attempt of the last read doesn't respond until the hedged attempt did
+    ON_CALL(handle, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&](auto const& /* statement */, auto&& cb) {
+            if (++numCalls == numReads) {
+                slowCallback = std::move(cb);
+            } else {
+                cb({});
+            }
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .Times(numReads + 1);
+    EXPECT_CALL(*counters, registerReadStartedImpl(1)).Times(numReads);
+    EXPECT_CALL(*counters, registerReadFinishedImpl(1)).Times(numReads);
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        auto statement = FakeStatement{};
+        for (auto i = 0u; i < numReads; ++i)
+            EXPECT_TRUE(strat.read(yield, statement));
+    });
+
+    ASSERT_TRUE(slowCallback);
+    slowCallback({});  // the late response is dropped
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, ReadBatchInCoroutineSuccessful)
 {
     auto strat = makeStrategy();
@@ -389,6 +433,93 @@ TEST_F(BackendCassandraExecutionStrategyTest, WriteMultipleAndCallSyncSucceeds)
     thread.join();
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, AdaptiveWriteMultipleAndCallSyncSucceeds)
+{
+    auto strat = makeStrategy(Settings{.maxWriteRequestsOutstanding = 16, .adaptiveConcurrency = true});
+    auto const totalRequests = 256u;
+    auto callCount = std::atomic_uint{0u};
+
+    auto work = std::optional<boost::asio::io_context::work>{ctx};
+    auto thread = std::thread{[this]() { ctx.run(); }};
+
+    ON_CALL(handle, asyncExecute(A<std::vector<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([this, &callCount](auto const&, auto&& cb) {
+            boost::asio::post(ctx, [&callCount, cb = std::forward<decltype(cb)>(cb)] {
+                ++callCount;
+                cb({});
+            });
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(
+        handle,
+        asyncExecute(
+            A<std::vector<FakeStatement> const&>(),
+            A<std::function<void(FakeResultOrError)>&&>()
+        )
+    )
+        .Times(totalRequests);
+    EXPECT_CALL(*counters, registerWriteStarted()).Times(totalRequests);
+    EXPECT_CALL(*counters, registerWriteFinished()).Times(totalRequests);
+
+    // the writing thread waits for the adaptive limit instead of failing
+    for (auto i = 0u; i < totalRequests; ++i)
+        strat.write(std::vector<FakeStatement>(4));
+
+    strat.sync();
+    EXPECT_EQ(callCount, totalRequests);
+
+    work.reset();
+    thread.join();
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, WriteToPartitionBatchesPerPartition)
+{
+    auto strat = makeStrategy(Settings{.writeBatchSize = 2});
+    auto batchSizes = std::vector<std::size_t>{};
+    std::mutex mtx;
+
+    auto work = std::optional<boost::asio::io_context::work>{ctx};
+    auto thread = std::thread{[this]() { ctx.run(); }};
+
+    ON_CALL(handle, asyncExecute(A<std::vector<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([this, &batchSizes, &mtx](auto const& statements, auto&& cb) {
+            {
+                std::scoped_lock const lk(mtx);
+                batchSizes.push_back(statements.size());
+            }
+            boost::asio::post(ctx, [cb = std::forward<decltype(cb)>(cb)] { cb({}); });
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(
+        handle,
+        asyncExecute(
+            A<std::vector<FakeStatement> const&>(),
+            A<std::function<void(FakeResultOrError)>&&>()
+        )
+    )
+        .Times(3);
+    EXPECT_CALL(*counters, registerWriteStarted()).Times(3);
+    EXPECT_CALL(*counters, registerWriteFinished()).Times(3);
+
+    for (auto i = 0u; i < 3; ++i)
+        strat.writeToPartition("a", FakeStatement{});
+    strat.writeToPartition("b", FakeStatement{});
+
+    {
+        std::scoped_lock const lk(mtx);
+        EXPECT_EQ(batchSizes, std::vector<std::size_t>{2});  // only the full batch is sent right away
+    }
+
+    strat.flush();
+    strat.sync();
+
+    std::sort(batchSizes.begin(), batchSizes.end());
+    EXPECT_EQ(batchSizes, (std::vector<std::size_t>{1, 1, 2}));
+
+    work.reset();
+    thread.join();
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, StatsCallsCountersReport)
 {
     auto strat = makeStrategy();
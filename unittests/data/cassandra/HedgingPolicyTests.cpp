@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <util/Fixtures.h>
+#include <util/MockPrometheus.h>
+
+#include <data/cassandra/impl/HedgingPolicy.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <tuple>
+
+using namespace data::cassandra::detail;
+using namespace util::prometheus;
+using namespace std::chrono_literals;
+
+namespace {
+
+void
+recordSamples(HedgingPolicy& policy, void const* kind, std::size_t count)
+{
+    for (std::size_t i = 1; i <= count; ++i)
+        policy.record(kind, std::chrono::microseconds{i});
+}
+
+}  // namespace
+
+struct BackendCassandraHedgingPolicyTest : WithPrometheus, NoLoggerFixture {
+    int const kind = 0;
+    int const otherKind = 0;
+};
+
+TEST_F(BackendCassandraHedgingPolicyTest, DisabledNeverHedges)
+{
+    HedgingPolicy policy{false, 95, 100};
+    recordSamples(policy, &kind, HedgingPolicy::MIN_SAMPLES);
+
+    EXPECT_FALSE(policy.onRead(&kind));
+}
+
+TEST_F(BackendCassandraHedgingPolicyTest, NoDelayUntilEnoughSamples)
+{
+    HedgingPolicy policy{true, 95, 5};
+    recordSamples(policy, &kind, HedgingPolicy::MIN_SAMPLES - 1);
+    EXPECT_FALSE(policy.onRead(&kind));
+
+    policy.record(&kind, 1us);
+    EXPECT_TRUE(policy.onRead(&kind));
+}
+
+TEST_F(BackendCassandraHedgingPolicyTest, DelayIsLatencyPercentile)
+{
+    HedgingPolicy policy{true, 95, 5};
+    recordSamples(policy, &kind, HedgingPolicy::MIN_SAMPLES);
+
+    EXPECT_EQ(policy.onRead(&kind), std::chrono::microseconds{95});
+}
+
+TEST_F(BackendCassandraHedgingPolicyTest, KindsAreTrackedSeparately)
+{
+    HedgingPolicy policy{true, 95, 5};
+    recordSamples(policy, &kind, HedgingPolicy::MIN_SAMPLES);
+
+    EXPECT_TRUE(policy.onRead(&kind));
+    EXPECT_FALSE(policy.onRead(&otherKind));
+}
+
+TEST_F(BackendCassandraHedgingPolicyTest, BudgetLimitsHedges)
+{
+    HedgingPolicy policy{true, 95, 50};
+    EXPECT_FALSE(policy.tryHedge());
+
+    std::ignore = policy.onRead(&kind);
+    EXPECT_FALSE(policy.tryHedge());
+
+    std::ignore = policy.onRead(&kind);
+    EXPECT_TRUE(policy.tryHedge());
+    EXPECT_FALSE(policy.tryHedge());
+}
+
+struct BackendCassandraHedgingPolicyMockPrometheusTest : WithMockPrometheus, NoLoggerFixture {};
+
+TEST_F(BackendCassandraHedgingPolicyMockPrometheusTest, CountsHedgesSentAndWon)
+{
+    auto& sent = makeMock<CounterInt>("backend_hedged_reads_total_number", "{status=\"sent\"}");
+    auto& won = makeMock<CounterInt>("backend_hedged_reads_total_number", "{status=\"won\"}");
+    HedgingPolicy policy{true, 95, 100};
+    std::ignore = policy.onRead(nullptr);
+
+    EXPECT_CALL(sent, add(1));
+    EXPECT_TRUE(policy.tryHedge());
+
+    EXPECT_CALL(won, add(1));
+    policy.onHedgeWon();
+}
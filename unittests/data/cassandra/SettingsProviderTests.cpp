@@ -52,6 +52,10 @@ TEST_F(SettingsProviderTest, Defaults)
     EXPECT_EQ(settings.maxWriteRequestsOutstanding, 10'000);
     EXPECT_EQ(settings.maxReadRequestsOutstanding, 100'000);
     EXPECT_EQ(settings.coreConnectionsPerHost, 1);
+    EXPECT_EQ(settings.writeBatchSize, 20);
+    EXPECT_FALSE(settings.hedgedReads);
+    EXPECT_EQ(settings.hedgePercentile, 95);
+    EXPECT_EQ(settings.hedgeBudgetPercent, 5);
     EXPECT_EQ(settings.certificate, std::nullopt);
     EXPECT_EQ(settings.username, std::nullopt);
     EXPECT_EQ(settings.password, std::nullopt);
@@ -104,6 +108,33 @@ TEST_F(SettingsProviderTest, DriverOptionalOptionsSpecified)
     EXPECT_EQ(settings.queueSizeIO, 2);
 }
 
+TEST_F(SettingsProviderTest, WriteBatchSize)
+{
+    Config const cfg{json::parse(R"({
+        "contact_points": "123.123.123.123",
+        "write_batch_size": 5
+    })")};
+    SettingsProvider const provider{cfg};
+
+    EXPECT_EQ(provider.getSettings().writeBatchSize, 5);
+}
+
+TEST_F(SettingsProviderTest, HedgedReads)
+{
+    Config const cfg{json::parse(R"({
+        "contact_points": "123.123.123.123",
+        "hedged_reads": true,
+        "hedge_percentile": 99,
+        "hedge_budget_percent": 2
+    })")};
+    SettingsProvider const provider{cfg};
+
+    auto const settings = provider.getSettings();
+    EXPECT_TRUE(settings.hedgedReads);
+    EXPECT_EQ(settings.hedgePercentile, 99);
+    EXPECT_EQ(settings.hedgeBudgetPercent, 2);
+}
+
 TEST_F(SettingsProviderTest, SecureBundleConfig)
 {
     Config const cfg{json::parse(R"({"secure_connect_bundle": "bundleData"})")};
@@ -145,3 +145,53 @@ TEST_F(CacheLoaderTest, FromCache)
         cv.wait_for(lk, std::chrono::milliseconds(300), [&] { return cacheReady; });
     }
 }
+
+TEST_F(CacheLoaderTest, BoundedCacheIsNotLoaded)
+{
+    auto const boundedCfg = Config{json::parse(R"({"cache": {"max_memory_mb": 16}})")};
+    EXPECT_CALL(cache, setBounded(16 * 1024 * 1024));
+    CacheLoader loader{boundedCfg, ctx, mockBackendPtr, cache};
+
+    EXPECT_CALL(cache, setDisabled).Times(0);
+    EXPECT_CALL(cache, isFull).Times(0);
+    loader.load(SEQ);
+}
+
+TEST_F(CacheLoaderTest, BulkScan)
+{
+    auto const scanCfg =
+        Config{json::parse(R"({"cache": {"bulk_scan": true, "num_scan_ranges": 4, "scan_page_size": 10}})")};
+    MockBackend* rawBackendPtr = dynamic_cast<MockBackend*>(mockBackendPtr.get());
+    CacheLoader loader{scanCfg, ctx, mockBackendPtr, cache};
+
+    // every range is read in two pages
+    ON_CALL(*rawBackendPtr, fetchLedgerScanPage(_, _, SEQ, 10, _))
+        .WillByDefault(Invoke([](auto const&, std::optional<std::string> const& cursor, auto, auto, auto) {
+            return LedgerScanPage{getLatestDiff(), cursor ? std::nullopt : std::make_optional<std::string>("cursor")};
+        }));
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerScanPage).Times(8);
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerDiff).Times(0);
+    EXPECT_CALL(*rawBackendPtr, doFetchSuccessorKey).Times(0);
+
+    EXPECT_CALL(cache, updateImp(SizeIs(getLatestDiff().size()), SEQ, true)).Times(8);
+    EXPECT_CALL(cache, isFull).Times(1);
+
+    std::mutex m;
+    std::condition_variable cv;
+    bool cacheReady = false;
+    ON_CALL(cache, setFull).WillByDefault(Invoke([&]() {
+        {
+            std::lock_guard const lk(m);
+            cacheReady = true;
+        }
+        cv.notify_one();
+    }));
+    EXPECT_CALL(cache, setFull).Times(1);
+
+    loader.load(SEQ);
+
+    {
+        std::unique_lock lk(m);
+        cv.wait_for(lk, std::chrono::milliseconds(300), [&] { return cacheReady; });
+    }
+}
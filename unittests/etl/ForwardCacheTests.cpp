@@ -0,0 +1,227 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <util/MockPrometheus.h>
+#include <util/MockSource.h>
+
+#include <etl/impl/ForwardCache.h>
+
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/json/parse.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace etl::detail;
+using namespace testing;
+
+namespace {
+
+constexpr static auto CONFIG = R"({
+    "ip": "127.0.0.1",
+    "ws_port": "6006",
+    "cache": ["fee", "account_info"]
+})";
+
+}  // namespace
+
+struct ForwardCacheTest : WithPrometheus, SyncAsioContextTest {
+    StrictMock<MockSource> source;
+    ForwardCache cache{util::Config{boost::json::parse(CONFIG)}, source};
+
+    boost::json::object const response = {{"result", {{"status", "success"}}}};
+};
+
+TEST_F(ForwardCacheTest, CommandNotInConfigIsAlwaysForwarded)
+{
+    boost::json::object const request = {{"command", "server_info"}};
+    EXPECT_CALL(source, requestFromRippled(request, _, _)).Times(2).WillRepeatedly(Return(response));
+
+    runSpawn([&](auto yield) {
+        EXPECT_EQ(cache.getOrFetch(request, std::nullopt, yield), response);
+        EXPECT_EQ(cache.getOrFetch(request, std::nullopt, yield), response);
+    });
+}
+
+TEST_F(ForwardCacheTest, CachedByParams)
+{
+    auto const request1 = boost::json::parse(R"({"command": "account_info", "account": "A", "id": 1})").as_object();
+    auto const request2 = boost::json::parse(R"({"id": 2, "account": "A", "command": "account_info"})").as_object();
+    auto const request3 = boost::json::parse(R"({"command": "account_info", "account": "B"})").as_object();
+
+    EXPECT_CALL(source, requestFromRippled(request1, _, _)).WillOnce(Return(response));
+    EXPECT_CALL(source, requestFromRippled(request3, _, _)).WillOnce(Return(response));
+
+    runSpawn([&](auto yield) {
+        EXPECT_EQ(cache.getOrFetch(request1, std::nullopt, yield), response);
+        EXPECT_EQ(cache.getOrFetch(request2, std::nullopt, yield), response);  // same params in a different order
+        EXPECT_EQ(cache.getOrFetch(request3, std::nullopt, yield), response);
+    });
+
+    EXPECT_EQ(cache.get(request2), response);
+}
+
+TEST_F(ForwardCacheTest, CurrentLedgerIsNotCached)
+{
+    auto const request =
+        boost::json::parse(R"({"command": "account_info", "account": "A", "ledger_index": "current"})").as_object();
+    EXPECT_CALL(source, requestFromRippled(request, _, _)).Times(2).WillRepeatedly(Return(response));
+
+    runSpawn([&](auto yield) {
+        cache.getOrFetch(request, std::nullopt, yield);
+        cache.getOrFetch(request, std::nullopt, yield);
+    });
+}
+
+TEST_F(ForwardCacheTest, InvalidatedByNewLedger)
+{
+    boost::json::object const request = {{"command", "fee"}};
+    EXPECT_CALL(source, requestFromRippled(request, _, _)).Times(2).WillRepeatedly(Return(response));
+
+    runSpawn([&](auto yield) {
+        cache.invalidate(10);
+        cache.getOrFetch(request, std::nullopt, yield);
+
+        cache.invalidate(9);  // older ledger is ignored
+        EXPECT_EQ(cache.get(request), response);
+
+        cache.invalidate(11);
+        EXPECT_FALSE(cache.get(request));
+        cache.getOrFetch(request, std::nullopt, yield);
+    });
+}
+
+TEST_F(ForwardCacheTest, ErrorIsNotCached)
+{
+    boost::json::object const request = {{"command", "fee"}};
+    boost::json::object const error = {{"error", "noNetwork"}};
+    EXPECT_CALL(source, requestFromRippled(request, _, _)).Times(2).WillRepeatedly(Return(error));
+
+    runSpawn([&](auto yield) {
+        EXPECT_EQ(cache.getOrFetch(request, std::nullopt, yield), error);
+        EXPECT_EQ(cache.getOrFetch(request, std::nullopt, yield), error);
+    });
+}
+
+TEST_F(ForwardCacheTest, ConcurrentRequestsAreCoalesced)
+{
+    boost::json::object const request = {{"command", "fee"}};
+    EXPECT_CALL(source, requestFromRippled(request, _, _))
+        .WillOnce([this](auto&&, auto&&, boost::asio::yield_context yield) {
+            boost::asio::steady_timer timer{yield.get_executor(), std::chrono::milliseconds{10}};
+            timer.async_wait(yield);
+            return std::optional<boost::json::object>{response};
+        });
+
+    auto numResponses = 0;
+    for (auto i = 0; i < 3; ++i) {
+        boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+            EXPECT_EQ(cache.getOrFetch(request, std::nullopt, yield), response);
+            ++numResponses;
+        });
+    }
+
+    ctx.run();
+    EXPECT_EQ(numResponses, 3);
+}
+
+TEST_F(ForwardCacheTest, IdIsNotShared)
+{
+    auto const request1 = boost::json::parse(R"({"command": "fee", "id": 1})").as_object();
+    auto const request2 = boost::json::parse(R"({"command": "fee", "id": "two"})").as_object();
+    boost::json::object const request3 = {{"command", "fee"}};
+
+    auto withId = [this](boost::json::value id) {
+        auto result = response;
+        result["id"] = std::move(id);
+        return result;
+    };
+
+    EXPECT_CALL(source, requestFromRippled(request1, _, _)).WillOnce(Return(withId(1)));
+
+    runSpawn([&](auto yield) {
+        EXPECT_EQ(cache.getOrFetch(request1, std::nullopt, yield), withId(1));
+        EXPECT_EQ(cache.getOrFetch(request2, std::nullopt, yield), withId("two"));
+        EXPECT_EQ(cache.getOrFetch(request3, std::nullopt, yield), response);
+    });
+
+    EXPECT_EQ(cache.get(request3), response);
+}
+
+TEST_F(ForwardCacheTest, CoalescedRequestsGetTheirOwnId)
+{
+    auto const request1 = boost::json::parse(R"({"command": "fee", "id": 1})").as_object();
+    auto const request2 = boost::json::parse(R"({"command": "fee", "id": 2})").as_object();
+
+    EXPECT_CALL(source, requestFromRippled(request1, _, _))
+        .WillOnce([this](auto&&, auto&&, boost::asio::yield_context yield) {
+            boost::asio::steady_timer timer{yield.get_executor(), std::chrono::milliseconds{10}};
+            timer.async_wait(yield);
+
+            auto result = response;
+            result["id"] = 1;
+            return std::optional<boost::json::object>{result};
+        });
+
+    auto const expectId = [this](boost::json::object const& request) {
+        boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+            auto const result = cache.getOrFetch(request, std::nullopt, yield);
+            ASSERT_TRUE(result);
+            EXPECT_EQ(result->at("id"), request.at("id"));
+        });
+    };
+
+    expectId(request1);
+    expectId(request2);
+    ctx.run();
+}
+
+TEST_F(ForwardCacheTest, CoalescedWaitIsBounded)
+{
+    auto config = boost::json::parse(CONFIG).as_object();
+    config["cache_wait_timeout_ms"] = 10;
+    ForwardCache const boundedCache{util::Config{config}, source};
+
+    boost::json::object const request = {{"command", "fee"}};
+    EXPECT_CALL(source, requestFromRippled(request, _, _))
+        .WillOnce([this](auto&&, auto&&, boost::asio::yield_context yield) {
+            boost::asio::steady_timer timer{yield.get_executor(), std::chrono::milliseconds{200}};
+            timer.async_wait(yield);
+            return std::optional<boost::json::object>{response};
+        });
+
+    auto leaderResponded = false;
+    auto waiterTimedOut = false;
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        EXPECT_EQ(boundedCache.getOrFetch(request, std::nullopt, yield), response);
+        leaderResponded = true;
+    });
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        EXPECT_FALSE(boundedCache.getOrFetch(request, std::nullopt, yield));
+        EXPECT_FALSE(leaderResponded);
+        waiterTimedOut = true;
+    });
+
+    ctx.run();
+    EXPECT_TRUE(leaderResponded);
+    EXPECT_TRUE(waiterTimedOut);
+}
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <util/MockPrometheus.h>
+
+#include <etl/impl/SourceStats.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace etl::detail;
+using namespace std::chrono;
+using util::prometheus::CounterInt;
+
+struct SourceStatsTest : WithPrometheus, NoLoggerFixture {
+    SourceStats stats{"127.0.0.1:6006", "forward"};
+};
+
+TEST_F(SourceStatsTest, NoSamples)
+{
+    EXPECT_EQ(stats.score(), 0);
+    EXPECT_EQ(stats.latency(), microseconds{0});
+    EXPECT_EQ(stats.errorRate(), 0);
+    EXPECT_FALSE(stats.p95());
+}
+
+TEST_F(SourceStatsTest, MovingAverages)
+{
+    auto const now = steady_clock::now();
+    stats.record(microseconds{1000}, true, now);
+    EXPECT_EQ(stats.latency(), microseconds{1000});
+    EXPECT_EQ(stats.errorRate(), 0);
+    EXPECT_DOUBLE_EQ(stats.score(now), 1000);
+
+    stats.record(microseconds{2000}, true, now);
+    EXPECT_EQ(stats.latency(), microseconds{1200});
+
+    // fast failures don't make the source look faster
+    stats.record(microseconds{5}, false, now);
+    EXPECT_EQ(stats.latency(), microseconds{1200});
+    EXPECT_DOUBLE_EQ(stats.errorRate(), SourceStats::ALPHA);
+    EXPECT_NEAR(stats.score(now), 1200 + SourceStats::ERROR_PENALTY.count() * SourceStats::ALPHA, 1e-6);
+
+    // slow failures do
+    stats.record(microseconds{11200}, false, now);
+    EXPECT_EQ(stats.latency(), microseconds{3200});
+}
+
+TEST_F(SourceStatsTest, FailingSourceScoresWorse)
+{
+    auto const now = steady_clock::now();
+    SourceStats healthy{"healthy", "forward"};
+    healthy.record(microseconds{500'000}, true, now);
+
+    for (auto const latency : {microseconds{5}, microseconds{2'000'000}}) {
+        SourceStats failing{"failing", "forward"};
+        failing.record(latency, false, now);
+        EXPECT_GT(failing.score(now), healthy.score(now));
+    }
+}
+
+TEST_F(SourceStatsTest, StaleSourceIsProbedAgain)
+{
+    auto const now = steady_clock::now();
+    stats.record(microseconds{1000}, true, now);
+    EXPECT_GT(stats.score(now), 0);
+    EXPECT_EQ(stats.score(now + SourceStats::STALE_AFTER + seconds{1}), 0);
+}
+
+TEST_F(SourceStatsTest, Percentile)
+{
+    for (auto i = 1u; i < SourceStats::MIN_SAMPLES_FOR_PERCENTILE; ++i)
+        stats.record(microseconds{i}, true);
+    EXPECT_FALSE(stats.p95());
+
+    for (auto i = SourceStats::MIN_SAMPLES_FOR_PERCENTILE; i <= 100u; ++i)
+        stats.record(microseconds{i}, true);
+    EXPECT_EQ(stats.p95(), microseconds{95});
+}
+
+TEST_F(SourceStatsTest, PercentileUsesRecentSamplesOnly)
+{
+    for (auto i = 0u; i < SourceStats::WINDOW_SIZE; ++i)
+        stats.record(microseconds{1'000'000}, true);
+    for (auto i = 0u; i < SourceStats::WINDOW_SIZE; ++i)
+        stats.record(microseconds{10}, true);
+
+    EXPECT_EQ(stats.p95(), microseconds{10});
+}
+
+struct SourceStatsMockPrometheusTest : WithMockPrometheus, NoLoggerFixture {};
+
+TEST_F(SourceStatsMockPrometheusTest, KindsOfRequestsAreExportedSeparately)
+{
+    auto& forwardDuration =
+        makeMock<CounterInt>("etl_source_request_duration_us", "{kind=\"forward\",source=\"127.0.0.1:6006\"}");
+    auto& fetchDuration =
+        makeMock<CounterInt>("etl_source_request_duration_us", "{kind=\"fetch\",source=\"127.0.0.1:6006\"}");
+    SourceStats forward{"127.0.0.1:6006", "forward"};
+    SourceStats fetch{"127.0.0.1:6006", "fetch"};
+
+    EXPECT_CALL(forwardDuration, add(10));
+    EXPECT_CALL(fetchDuration, add(5'000'000));
+    forward.record(microseconds{10}, true);
+    fetch.record(microseconds{5'000'000}, true);
+
+    EXPECT_EQ(forward.latency(), microseconds{10});
+}
+
+TEST(OrderSourcesTest, Empty)
+{
+    EXPECT_TRUE(orderSources({}).empty());
+}
+
+TEST(OrderSourcesTest, SingleSource)
+{
+    EXPECT_EQ(orderSources({42.}), std::vector<std::size_t>{0});
+}
+
+TEST(OrderSourcesTest, TwoSourcesBestFirst)
+{
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_EQ(orderSources({300., 100.}), (std::vector<std::size_t>{1, 0}));
+}
+
+TEST(OrderSourcesTest, WorstSourceIsNeverFirst)
+{
+    for (auto i = 0; i < 100; ++i) {
+        auto const order = orderSources({300., 100., 200., 1000.});
+        ASSERT_EQ(order.size(), 4u);
+        EXPECT_NE(order.front(), 3u);
+
+        // everything after the first choice is sorted by score
+        auto rest = std::vector<std::size_t>(order.begin() + 1, order.end());
+        auto const scores = std::vector<double>{300., 100., 200., 1000.};
+        EXPECT_TRUE(std::is_sorted(rest.begin(), rest.end(), [&scores](auto lhs, auto rhs) {
+            return scores[lhs] < scores[rhs];
+        }));
+    }
+}
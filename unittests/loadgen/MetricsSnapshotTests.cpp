@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/Connection.h>
+#include <loadgen/MetricsSnapshot.h>
+
+#include <gtest/gtest.h>
+
+using namespace loadgen;
+
+TEST(LoadgenMetricsSnapshotTests, ParseTextFormat)
+{
+    auto const snapshot = MetricsSnapshot::parse(
+        "# HELP rpc_method_total_number Total number of finished calls\n"
+        "# TYPE rpc_method_total_number counter\n"
+        "rpc_method_total_number{method=\"tx\",status=\"finished\"} 12\n"
+        "rpc_method_total_number{method=\"a b}\",status=\"finished\"} 3 1700000000000\n"
+        "ledger_cache_size 1.5e3\n"
+        "broken_line\n"
+        "bad_value{a=\"b\"} abc\n"
+    );
+
+    auto const& values = snapshot.values();
+    ASSERT_EQ(values.size(), 3u);
+    EXPECT_DOUBLE_EQ(values.at("rpc_method_total_number{method=\"tx\",status=\"finished\"}"), 12);
+    EXPECT_DOUBLE_EQ(values.at("rpc_method_total_number{method=\"a b}\",status=\"finished\"}"), 3);
+    EXPECT_DOUBLE_EQ(values.at("ledger_cache_size"), 1500);
+}
+
+TEST(LoadgenMetricsSnapshotTests, DeltaSince)
+{
+    auto const before = MetricsSnapshot::parse("a 1\nb 5\n");
+    auto const after = MetricsSnapshot::parse("a 4\nb 5\nc 2\n");
+
+    auto const delta = after.deltaSince(before);
+    ASSERT_EQ(delta.size(), 2u);
+    EXPECT_DOUBLE_EQ(delta.at("a"), 3);
+    EXPECT_DOUBLE_EQ(delta.at("c"), 2);
+}
+
+TEST(LoadgenConnectionTests, ResponseError)
+{
+    EXPECT_EQ(Connection::responseError(R"({"result": {"status": "success"}})"), std::nullopt);
+    EXPECT_EQ(Connection::responseError(R"({"status": "success", "result": {}})"), std::nullopt);
+    EXPECT_EQ(Connection::responseError(R"({"result": {"status": "error", "error": "actNotFound"}})"), "actNotFound");
+    EXPECT_EQ(Connection::responseError(R"({"status": "error", "error": "lgrNotFound"})"), "lgrNotFound");
+    EXPECT_EQ(Connection::responseError(R"({"error": "slowDown"})"), "slowDown");
+    EXPECT_EQ(Connection::responseError(R"({"status": "error"})"), "unknown_error");
+    EXPECT_EQ(Connection::responseError("Too many requests"), "malformed_response");
+}
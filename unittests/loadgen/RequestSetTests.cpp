@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/RequestSet.h>
+
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <sstream>
+
+using namespace loadgen;
+
+TEST(LoadgenRequestSetTests, ParsesHttpAndWebsocketForms)
+{
+    auto const http = RequestSet::parseRequest(R"({"method": "tx", "params": [{"transaction": "ABC"}]})");
+    EXPECT_EQ(http.method, "tx");
+    EXPECT_EQ(
+        boost::json::parse(http.httpBody), boost::json::parse(R"({"method":"tx","params":[{"transaction":"ABC"}]})")
+    );
+    EXPECT_EQ(boost::json::parse(http.wsBody), boost::json::parse(R"({"command":"tx","transaction":"ABC"})"));
+
+    auto const ws = RequestSet::parseRequest(R"({"command": "ledger", "id": 1, "ledger_index": "validated"})");
+    EXPECT_EQ(ws.method, "ledger");
+    EXPECT_EQ(
+        boost::json::parse(ws.httpBody),
+        boost::json::parse(R"({"method":"ledger","params":[{"ledger_index":"validated"}]})")
+    );
+    EXPECT_EQ(boost::json::parse(ws.wsBody), boost::json::parse(R"({"command":"ledger","ledger_index":"validated"})"));
+
+    auto const noParams = RequestSet::parseRequest(R"({"method": "server_info"})");
+    EXPECT_EQ(boost::json::parse(noParams.httpBody), boost::json::parse(R"({"method":"server_info","params":[{}]})"));
+}
+
+TEST(LoadgenRequestSetTests, InvalidLinesAreReportedWithTheirNumber)
+{
+    std::stringstream input{"{\"method\": \"tx\"}\n\nnot json\n"};
+    try {
+        RequestSet::parse(input);
+        FAIL() << "expected an exception";
+    } catch (std::runtime_error const& e) {
+        EXPECT_EQ(std::string{e.what()}.rfind("Line 3:", 0), 0u);
+    }
+
+    EXPECT_THROW(RequestSet::parseRequest(R"({"params": [{}]})"), std::runtime_error);
+    EXPECT_THROW(RequestSet::parseRequest(R"({"method": "tx", "params": [1]})"), std::runtime_error);
+}
+
+TEST(LoadgenRequestSetTests, FileOrderIsReplayedWithoutSubscriptions)
+{
+    std::stringstream input{
+        "{\"command\": \"tx\"}\n"
+        "{\"command\": \"subscribe\", \"streams\": [\"ledger\"]}\n"
+        "{\"command\": \"ledger\"}\n"
+    };
+    auto const set = RequestSet::parse(input);
+
+    ASSERT_EQ(set.size(), 2u);
+    EXPECT_EQ(set.next(0).method, "tx");
+    EXPECT_EQ(set.next(1).method, "ledger");
+    EXPECT_EQ(set.next(2).method, "tx");
+}
+
+TEST(LoadgenRequestSetTests, MixFollowsTheWeights)
+{
+    std::stringstream input{
+        "{\"command\": \"account_info\", \"account\": \"a\"}\n"
+        "{\"command\": \"account_info\", \"account\": \"b\"}\n"
+        "{\"command\": \"tx\"}\n"
+        "{\"command\": \"ledger\"}\n"
+    };
+    auto const set = RequestSet::parse(input, "account_info=3,tx=1");
+    EXPECT_EQ(set.size(), 3u);
+
+    std::map<std::string, int> counts;
+    std::map<std::string, int> accounts;
+    for (std::uint64_t k = 0; k < 400; ++k) {
+        auto const& request = set.next(k);
+        ++counts[request.method];
+        if (request.method == "account_info")
+            ++accounts[boost::json::parse(request.wsBody).at("account").as_string().c_str()];
+    }
+
+    EXPECT_EQ(counts["account_info"], 300);
+    EXPECT_EQ(counts["tx"], 100);
+    EXPECT_EQ(counts.count("ledger"), 0u);
+    EXPECT_EQ(accounts["a"], 150);
+    EXPECT_EQ(accounts["b"], 150);
+
+    // smooth round-robin spreads the heavier method instead of sending it in a burst
+    EXPECT_EQ(set.next(0).method, "account_info");
+    EXPECT_EQ(set.next(1).method, "account_info");
+    EXPECT_EQ(set.next(2).method, "tx");
+    EXPECT_EQ(set.next(3).method, "account_info");
+}
+
+TEST(LoadgenRequestSetTests, InvalidMix)
+{
+    auto const parse = [](std::string const& mix) {
+        std::stringstream input{"{\"command\": \"tx\"}\n"};
+        return RequestSet::parse(input, mix);
+    };
+
+    EXPECT_THROW(parse("ledger=1"), std::runtime_error);
+    EXPECT_THROW(parse("tx"), std::runtime_error);
+    EXPECT_THROW(parse("tx=abc"), std::runtime_error);
+    EXPECT_THROW(parse("tx=0"), std::runtime_error);
+    EXPECT_NO_THROW(parse("tx=2"));
+}
@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <loadgen/Stats.h>
+
+#include <gtest/gtest.h>
+
+using namespace loadgen;
+using namespace std::chrono_literals;
+
+TEST(LoadgenStatsTests, Percentile)
+{
+    EXPECT_EQ(Stats::percentile({}, 50), 0u);
+    EXPECT_EQ(Stats::percentile({7}, 99), 7u);
+
+    std::vector<std::uint64_t> values;
+    for (std::uint64_t i = 1; i <= 100; ++i)
+        values.push_back(i);
+
+    EXPECT_EQ(Stats::percentile(values, 0), 1u);
+    EXPECT_EQ(Stats::percentile(values, 50), 50u);
+    EXPECT_EQ(Stats::percentile(values, 90), 90u);
+    EXPECT_EQ(Stats::percentile(values, 99), 99u);
+    EXPECT_EQ(Stats::percentile(values, 100), 100u);
+}
+
+TEST(LoadgenStatsTests, ReportMergesWorkers)
+{
+    Stats first;
+    first.record("tx", 100us, std::nullopt);
+    first.record("tx", 300us, "txnNotFound");
+
+    Stats second;
+    second.record("tx", 200us, std::nullopt);
+    second.record("ledger", 1000us, "transport_error");
+
+    first.merge(second);
+    EXPECT_EQ(first.count(), 4u);
+
+    auto const report = first.report(2s);
+    EXPECT_EQ(report.at("duration_us").as_int64(), 2'000'000);
+
+    auto const& total = report.at("total").as_object();
+    EXPECT_EQ(total.at("requests").as_uint64(), 4u);
+    EXPECT_EQ(total.at("errors").as_uint64(), 2u);
+    EXPECT_DOUBLE_EQ(total.at("throughput_rps").as_double(), 2.0);
+    EXPECT_EQ(total.at("latency_us").at("max").as_uint64(), 1000u);
+    EXPECT_EQ(total.at("error_codes").at("transport_error").as_uint64(), 1u);
+
+    auto const& tx = report.at("methods").at("tx").as_object();
+    EXPECT_EQ(tx.at("requests").as_uint64(), 3u);
+    EXPECT_EQ(tx.at("latency_us").at("p50").as_uint64(), 200u);
+    EXPECT_EQ(tx.at("error_codes").at("txnNotFound").as_uint64(), 1u);
+    EXPECT_FALSE(tx.at("error_codes").as_object().contains("transport_error"));
+}
@@ -24,6 +24,7 @@
 #include <rpc/common/MetaProcessors.h>
 #include <rpc/common/Modifiers.h>
 #include <rpc/common/Specs.h>
+#include <rpc/common/StaticSpecs.h>
 #include <rpc/common/Validators.h>
 
 #include <boost/json/parse.hpp>
@@ -126,6 +127,35 @@ TEST_F(RPCBaseTest, TypeValidator)
     }
 }
 
+TEST_F(RPCBaseTest, ProcessorsSkippedForMissingField)
+{
+    struct CountingValidator {
+        int& calls;
+
+        [[nodiscard]] MaybeError
+        verify(json::value const&, std::string_view) const
+        {
+            ++calls;
+            return {};
+        }
+    };
+
+    auto calls = 0;
+    auto const spec = RpcSpec{
+        {"missing", CountingValidator{calls}},
+        {"present", CountingValidator{calls}},
+        {"required", Required{}, CountingValidator{calls}},
+    };
+
+    auto failingInput = json::parse(R"({ "present": 1 })");
+    ASSERT_FALSE(spec.process(failingInput));  // Required still runs for the missing field
+    EXPECT_EQ(calls, 1);
+
+    auto passingInput = json::parse(R"({ "present": 1, "required": 2 })");
+    ASSERT_TRUE(spec.process(passingInput));
+    EXPECT_EQ(calls, 3);
+}
+
 TEST_F(RPCBaseTest, TypeValidatorMultipleTypes)
 {
     auto spec = RpcSpec{
@@ -596,3 +626,109 @@ TEST_F(RPCBaseTest, ToLowerModifier)
     ASSERT_TRUE(spec.process(passingInput4));  // empty str no problem
     ASSERT_EQ(passingInput4.at("str").as_string(), "");
 }
+
+namespace {
+
+struct StaticSpecInput {
+    std::string account;
+    std::optional<uint32_t> limit;
+    std::optional<std::string> type;
+    std::optional<uint32_t> seq;
+};
+
+auto const&
+staticSpecForTest()
+{
+    static auto const spec = StaticRpcSpec{
+        StaticFieldSpec{
+            "account",
+            [](StaticSpecInput& input, json::value const& value) { input.account = value.as_string().c_str(); },
+            Required{},
+            Type<std::string>{}},
+        StaticFieldSpec{
+            "limit",
+            [](StaticSpecInput& input, json::value const& value) { input.limit = value.as_int64(); },
+            Type<uint32_t>{},
+            Min(1u),
+            Clamp<uint32_t>{1, 100}},
+        StaticFieldSpec{
+            "type",
+            [](StaticSpecInput& input, json::value const& value) { input.type = value.as_string().c_str(); },
+            Type<std::string>{},
+            ToLower{},
+            OneOf{"offer", "check"}},
+        StaticFieldSpec{
+            "marker",
+            [](StaticSpecInput& input, json::value const& value) { input.seq = value.at("seq").as_int64(); },
+            WithCustomError{Type<json::object>{}, rpc::Status{ripple::rpcINVALID_PARAMS, "invalidMarker"}},
+            Section{{"seq", Required{}, Type<uint32_t>{}}}},
+    };
+
+    return spec;
+}
+
+}  // namespace
+
+TEST_F(RPCBaseTest, StaticSpecParsesInput)
+{
+    auto request = json::parse(R"({ "type": "OFFER", "marker": {"seq": 5}, "limit": 1000, "account": "acc" })");
+    auto const input = staticSpecForTest().parse<StaticSpecInput>(request);
+
+    ASSERT_TRUE(input);
+    EXPECT_EQ(input->account, "acc");
+    EXPECT_EQ(input->limit, 100u);  // clamped before it is stored
+    EXPECT_EQ(input->type, "offer");
+    EXPECT_EQ(input->seq, 5u);
+
+    auto minimal = json::parse(R"({ "account": "acc" })");
+    auto const minimalInput = staticSpecForTest().parse<StaticSpecInput>(minimal);
+
+    ASSERT_TRUE(minimalInput);
+    EXPECT_FALSE(minimalInput->limit);
+    EXPECT_FALSE(minimalInput->type);
+    EXPECT_FALSE(minimalInput->seq);
+}
+
+TEST_F(RPCBaseTest, StaticSpecFailsLikeRpcSpec)
+{
+    auto const rpcSpec = staticSpecForTest().rpcSpec();
+
+    for (auto const* request : {
+             R"({ "limit": 10 })",
+             R"({ "account": 1 })",
+             R"({ "account": "acc", "limit": 0 })",
+             R"({ "account": "acc", "type": "payment" })",
+             R"({ "account": "acc", "marker": 1 })",
+             R"({ "account": "acc", "marker": {} })",
+             R"({ "marker": 1, "limit": "10" })",
+         }) {
+        auto forStaticSpec = json::parse(request);
+        auto forRpcSpec = json::parse(request);
+
+        auto const input = staticSpecForTest().parse<StaticSpecInput>(forStaticSpec);
+        auto const ret = rpcSpec.process(forRpcSpec);
+
+        ASSERT_FALSE(input) << request;
+        ASSERT_FALSE(ret) << request;
+        EXPECT_TRUE(input.error().code == ret.error().code) << request;
+        EXPECT_EQ(input.error().message, ret.error().message) << request;
+    }
+}
+
+TEST_F(RPCBaseTest, StaticSpecExtendedWithFields)
+{
+    auto const spec = StaticRpcSpec{
+        staticSpecForTest(),
+        StaticFieldSpec{
+            "binary", [](StaticSpecInput& input, json::value const&) { input.account += "+binary"; }, Type<bool>{}},
+    };
+
+    auto request = json::parse(R"({ "account": "acc", "binary": true })");
+    auto const input = spec.parse<StaticSpecInput>(request);
+    ASSERT_TRUE(input);
+    EXPECT_EQ(input->account, "acc+binary");
+
+    auto failing = json::parse(R"({ "account": "acc", "binary": 1 })");
+    EXPECT_TRUE(staticSpecForTest().parse<StaticSpecInput>(failing));
+    EXPECT_FALSE(spec.parse<StaticSpecInput>(failing));
+}
@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <rpc/BookChangesCache.h>
+#include <util/Fixtures.h>
+
+#include <gtest/gtest.h>
+
+using namespace rpc;
+
+namespace {
+
+constexpr auto CAPACITY = 4;
+
+std::vector<BookChange>
+makeChanges(std::size_t count)
+{
+    return std::vector<BookChange>(count);
+}
+
+}  // namespace
+
+class BookChangesCacheTest : public NoLoggerFixture {
+protected:
+    BookChangesCache cache{CAPACITY};
+};
+
+TEST_F(BookChangesCacheTest, GetReturnsStoredLedger)
+{
+    EXPECT_EQ(cache.get(10), nullptr);
+
+    auto const stored = cache.put(10, makeChanges(2));
+    auto const fetched = cache.get(10);
+    ASSERT_NE(fetched, nullptr);
+    EXPECT_EQ(fetched, stored);
+    EXPECT_EQ(fetched->size(), 2);
+}
+
+TEST_F(BookChangesCacheTest, OldLedgersAreEvicted)
+{
+    for (auto seq = 10u; seq < 10u + CAPACITY; ++seq)
+        cache.put(seq, makeChanges(1));
+
+    EXPECT_NE(cache.get(10), nullptr);
+
+    cache.put(10 + CAPACITY, makeChanges(1));
+    EXPECT_EQ(cache.get(10), nullptr);
+    EXPECT_NE(cache.get(11), nullptr);
+    EXPECT_NE(cache.get(10 + CAPACITY), nullptr);
+}
+
+TEST_F(BookChangesCacheTest, ZeroCapacityDisablesCache)
+{
+    BookChangesCache disabled{0};
+    EXPECT_NE(disabled.put(10, makeChanges(1)), nullptr);
+    EXPECT_EQ(disabled.get(10), nullptr);
+    EXPECT_EQ(disabled.capacity(), 0);
+}
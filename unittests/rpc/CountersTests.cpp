@@ -50,6 +50,7 @@ TEST_F(RPCCountersTest, CheckThatCountersAddUp)
         counters.onBadSyntax();
         counters.onUnknownCommand();
         counters.onInternalError();
+        counters.onBatch(2, std::chrono::microseconds{10u});
     }
 
     auto const report = counters.report();
@@ -96,6 +97,9 @@ TEST_F(RPCCountersTest, CheckThatCountersAddUp)
     EXPECT_STREQ(report.at("bad_syntax_errors").as_string().c_str(), "512");
     EXPECT_STREQ(report.at("unknown_command_errors").as_string().c_str(), "512");
     EXPECT_STREQ(report.at("internal_errors").as_string().c_str(), "512");
+    EXPECT_STREQ(report.at("batches").as_string().c_str(), "512");
+    EXPECT_STREQ(report.at("batch_requests").as_string().c_str(), "1024");
+    EXPECT_STREQ(report.at("batch_duration_us").as_string().c_str(), "5120");
 
     EXPECT_EQ(report.at("work_queue"), queue.report());  // Counters report includes queue report
 }
@@ -183,3 +187,14 @@ TEST_F(RPCCountersMockPrometheusTests, onInternalError)
     EXPECT_CALL(internalErrorMock, add(1));
     counters.onInternalError();
 }
+
+TEST_F(RPCCountersMockPrometheusTests, onBatch)
+{
+    auto& batchMock = makeMock<CounterInt>("rpc_batch_total_number", "");
+    auto& batchRequestsMock = makeMock<CounterInt>("rpc_batch_requests_total_number", "");
+    auto& batchDurationMock = makeMock<CounterInt>("rpc_batch_duration_us", "");
+    EXPECT_CALL(batchMock, add(1));
+    EXPECT_CALL(batchRequestsMock, add(5));
+    EXPECT_CALL(batchDurationMock, add(123));
+    counters.onBatch(5, std::chrono::microseconds(123));
+}
@@ -36,7 +36,22 @@ constexpr static auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A
 constexpr static auto MAXSEQ = 30;
 constexpr static auto MINSEQ = 10;
 
-class RPCBookChangesHandlerTest : public HandlerBaseTest {};
+class RPCBookChangesHandlerTest : public HandlerBaseTest {
+protected:
+    std::shared_ptr<BookChangesCache> bookChangesCache = std::make_shared<BookChangesCache>(MAXSEQ);
+
+    static std::vector<TransactionAndMetadata>
+    createBookChangeTransactions()
+    {
+        auto trans1 = TransactionAndMetadata();
+        ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+        trans1.transaction = obj.getSerializer().peekData();
+        trans1.ledgerSequence = 32;
+        ripple::STObject const metaObj = CreateMetaDataForBookChange(CURRENCY, ISSUER, 22, 1, 3, 3, 1);
+        trans1.metadata = metaObj.getSerializer().peekData();
+        return {trans1};
+    }
+};
 
 struct BookChangesParamTestCaseBundle {
     std::string testName;
@@ -69,6 +84,25 @@ generateTestValuesForParametersTest()
             "LedgerHashNotString", R"({"ledger_hash":1})", "invalidParams", "ledger_hashNotString"},
         BookChangesParamTestCaseBundle{
             "LedgerIndexInvalid", R"({"ledger_index":"a"})", "invalidParams", "ledgerIndexMalformed"},
+        BookChangesParamTestCaseBundle{
+            "LedgerIndexMinNotInt", R"({"ledger_index_min":"a"})", "invalidParams", "Invalid parameters."},
+        BookChangesParamTestCaseBundle{
+            "RangeWithoutMax", R"({"ledger_index_min":10})", "invalidParams", "incompleteLedgerRange"},
+        BookChangesParamTestCaseBundle{
+            "RangeWithLedgerIndex",
+            R"({"ledger_index_min":10, "ledger_index_max":20, "ledger_index":15})",
+            "invalidParams",
+            "containsLedgerSpecifierAndRange"},
+        BookChangesParamTestCaseBundle{
+            "RangeMinAboveMax",
+            R"({"ledger_index_min":20, "ledger_index_max":10})",
+            "invalidLgrRange",
+            "Ledger range is invalid."},
+        BookChangesParamTestCaseBundle{
+            "RangeTooLarge",
+            R"({"ledger_index_min":1, "ledger_index_max":1000})",
+            "invalidParams",
+            "ledgerRangeTooLarge"},
     };
 }
 
@@ -83,7 +117,7 @@ TEST_P(BookChangesParameterTest, InvalidParams)
 {
     auto const testBundle = GetParam();
     runSpawn([&, this](auto yield) {
-        auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr}};
+        auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
         auto const req = json::parse(testBundle.testJson);
         auto const output = handler.process(req, Context{yield});
         ASSERT_FALSE(output);
@@ -105,7 +139,7 @@ TEST_F(RPCBookChangesHandlerTest, LedgerNonExistViaIntSequence)
         .WillByDefault(Return(std::optional<ripple::LedgerInfo>{}));
 
     auto const static input = json::parse(R"({"ledger_index":30})");
-    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr}};
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
     runSpawn([&](auto yield) {
         auto const output = handler.process(input, Context{yield});
         ASSERT_FALSE(output);
@@ -126,7 +160,7 @@ TEST_F(RPCBookChangesHandlerTest, LedgerNonExistViaStringSequence)
     ON_CALL(*rawBackendPtr, fetchLedgerBySequence(MAXSEQ, _)).WillByDefault(Return(std::nullopt));
 
     auto const static input = json::parse(R"({"ledger_index":"30"})");
-    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr}};
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
     runSpawn([&](auto yield) {
         auto const output = handler.process(input, Context{yield});
         ASSERT_FALSE(output);
@@ -153,7 +187,7 @@ TEST_F(RPCBookChangesHandlerTest, LedgerNonExistViaHash)
         }})",
         LEDGERHASH
     ));
-    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr}};
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
     runSpawn([&](auto yield) {
         auto const output = handler.process(input, Context{yield});
         ASSERT_FALSE(output);
@@ -205,10 +239,142 @@ TEST_F(RPCBookChangesHandlerTest, NormalPath)
     EXPECT_CALL(*rawBackendPtr, fetchAllTransactionsInLedger).Times(1);
     ON_CALL(*rawBackendPtr, fetchAllTransactionsInLedger(MAXSEQ, _)).WillByDefault(Return(transactions));
 
-    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr}};
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
     runSpawn([&](auto yield) {
         auto const output = handler.process(json::parse("{}"), Context{yield});
         ASSERT_TRUE(output);
         EXPECT_EQ(*output, json::parse(expectedOut));
     });
 }
+
+TEST_F(RPCBookChangesHandlerTest, CachedLedgerIsNotReadFromDatabase)
+{
+    auto const rawBackendPtr = dynamic_cast<MockBackend*>(mockBackendPtr.get());
+    ASSERT_NE(rawBackendPtr, nullptr);
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerBySequence).Times(1);
+    ON_CALL(*rawBackendPtr, fetchLedgerBySequence(MAXSEQ, _))
+        .WillByDefault(Return(CreateLedgerInfo(LEDGERHASH, MAXSEQ)));
+    EXPECT_CALL(*rawBackendPtr, fetchAllTransactionsInLedger).Times(0);
+
+    bookChangesCache->put(MAXSEQ, BookChanges::compute(createBookChangeTransactions()));
+
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
+    runSpawn([&](auto yield) {
+        auto const output = handler.process(json::parse("{}"), Context{yield});
+        ASSERT_TRUE(output);
+        auto const& changes = output->at("changes").as_array();
+        ASSERT_EQ(changes.size(), 1);
+        EXPECT_EQ(changes[0].at("volume_a").as_string(), "2");
+    });
+}
+
+TEST_F(RPCBookChangesHandlerTest, RangeAggregatesLedgers)
+{
+    static auto constexpr expectedOut =
+        R"({
+            "type":"bookChanges",
+            "ledger_hash":"4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652",
+            "ledger_index":30,
+            "ledger_index_min":29,
+            "ledger_index_max":30,
+            "ledger_time":0,
+            "validated":true,
+            "changes":[
+                {
+                    "currency_a":"XRP_drops",
+                    "currency_b":"rK9DrarGKnVEo2nYp5MfVRXRYf5yRX3mwD/0158415500000000C1F76FF6ECB0BAC600000000",
+                    "volume_a":"4",
+                    "volume_b":"4",
+                    "high":"-1",
+                    "low":"-1",
+                    "open":"-1",
+                    "close":"-1"
+                }
+            ]
+        })";
+    auto const rawBackendPtr = dynamic_cast<MockBackend*>(mockBackendPtr.get());
+    ASSERT_NE(rawBackendPtr, nullptr);
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerBySequence).Times(1);
+    ON_CALL(*rawBackendPtr, fetchLedgerBySequence(MAXSEQ, _))
+        .WillByDefault(Return(CreateLedgerInfo(LEDGERHASH, MAXSEQ)));
+
+    // the older ledger is cached, the latest one is read from the database
+    bookChangesCache->put(MAXSEQ - 1, BookChanges::compute(createBookChangeTransactions()));
+    EXPECT_CALL(*rawBackendPtr, fetchAllTransactionsInLedger).Times(1);
+    ON_CALL(*rawBackendPtr, fetchAllTransactionsInLedger(MAXSEQ, _))
+        .WillByDefault(Return(createBookChangeTransactions()));
+
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
+    runSpawn([&](auto yield) {
+        auto const req = json::parse(R"({"ledger_index_min":29, "ledger_index_max":30})");
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_TRUE(output);
+        EXPECT_EQ(*output, json::parse(expectedOut));
+    });
+}
+
+TEST_F(RPCBookChangesHandlerTest, RangeOutOfAvailableLedgers)
+{
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
+    runSpawn([&](auto yield) {
+        auto const req = json::parse(R"({"ledger_index_min":25, "ledger_index_max":31})");
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_FALSE(output);
+        auto const err = rpc::makeError(output.error());
+        EXPECT_EQ(err.at("error").as_string(), "lgrIdxMalformed");
+        EXPECT_EQ(err.at("error_message").as_string(), "ledgerSeqMaxOutOfRange");
+    });
+}
+
+TEST_F(RPCBookChangesHandlerTest, RangeIsMostlyServedFromCache)
+{
+    auto const rawBackendPtr = dynamic_cast<MockBackend*>(mockBackendPtr.get());
+    ASSERT_NE(rawBackendPtr, nullptr);
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerBySequence).Times(0);
+    EXPECT_CALL(*rawBackendPtr, fetchAllTransactionsInLedger).Times(0);
+
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
+    runSpawn([&](auto yield) {
+        auto const req = json::parse(R"({"ledger_index_min":20, "ledger_index_max":30})");
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_FALSE(output);
+        auto const err = rpc::makeError(output.error());
+        EXPECT_EQ(err.at("error").as_string(), "invalidParams");
+        EXPECT_EQ(err.at("error_message").as_string(), "ledgerRangeNotCached");
+    });
+}
+
+TEST_F(RPCBookChangesHandlerTest, RangeIsChargedPerLedger)
+{
+    auto const rawBackendPtr = dynamic_cast<MockBackend*>(mockBackendPtr.get());
+    ASSERT_NE(rawBackendPtr, nullptr);
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerBySequence).Times(0);
+    EXPECT_CALL(*rawBackendPtr, fetchAllTransactionsInLedger).Times(0);
+
+    auto const handler = AnyHandler{BookChangesHandler{mockBackendPtr, bookChangesCache}};
+    runSpawn([&](auto yield) {
+        std::optional<std::uint32_t> charged;
+        auto ctx = Context{yield};
+        ctx.chargeRequests = [&](std::uint32_t numRequests) {
+            charged = numRequests;
+            return false;
+        };
+
+        auto const req = json::parse(R"({"ledger_index_min":20, "ledger_index_max":30})");
+        auto const output = handler.process(req, ctx);
+        ASSERT_FALSE(output);
+        EXPECT_EQ(rpc::makeError(output.error()).at("error").as_string(), "slowDown");
+        EXPECT_EQ(charged, 10);
+    });
+}
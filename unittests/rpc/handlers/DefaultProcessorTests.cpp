@@ -20,6 +20,7 @@
 #include <rpc/handlers/impl/FakesAndMocks.h>
 #include <util/Fixtures.h>
 
+#include <rpc/common/Modifiers.h>
 #include <rpc/common/impl/Processors.h>
 
 #include <boost/json/parse.hpp>
@@ -52,6 +53,22 @@ TEST_F(RPCDefaultProcessorTest, ValidInput)
     });
 }
 
+TEST_F(RPCDefaultProcessorTest, ModifiersAppliedToInput)
+{
+    runSpawn([](auto yield) {
+        HandlerMock const handler;
+        rpc::detail::DefaultProcessor<HandlerMock> const processor;
+
+        auto const spec = RpcSpec{{"something", Required{}, modifiers::ToLower{}}};
+        auto const data = InOutFake{"works"};
+        EXPECT_CALL(handler, spec(_)).WillOnce(ReturnRef(spec));
+        EXPECT_CALL(handler, process(Eq(data), _)).WillOnce(Return(data));
+
+        auto const ret = processor(handler, json::parse(R"({ "something": "WoRkS" })"), Context{yield});
+        ASSERT_TRUE(ret);  // no error
+    });
+}
+
 TEST_F(RPCDefaultProcessorTest, NoInputVaildCall)
 {
     runSpawn([](auto yield) {
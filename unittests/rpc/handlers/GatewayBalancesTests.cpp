@@ -380,6 +380,41 @@ struct NormalPathTest : public RPCGatewayBalancesHandlerTest, public WithParamIn
     };
 };
 
+TEST_F(RPCGatewayBalancesHandlerTest, IndexedBalancesAreServedWithoutReadingTrustLines)
+{
+    auto const seq = 300;
+    auto const rawBackendPtr = dynamic_cast<MockBackend*>(mockBackendPtr.get());
+    ASSERT_NE(rawBackendPtr, nullptr);
+    mockBackendPtr->updateRange(10);   // min
+    mockBackendPtr->updateRange(seq);  // max
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerBySequence).Times(1);
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, seq);
+    ON_CALL(*rawBackendPtr, fetchLedgerBySequence(seq, _)).WillByDefault(Return(ledgerinfo));
+
+    // only the account itself is read
+    auto const accountKk = ripple::keylet::account(GetAccountIDWithString(ACCOUNT)).key;
+    ON_CALL(*rawBackendPtr, doFetchLedgerObject(accountKk, seq, _)).WillByDefault(Return(Blob{'f', 'a', 'k', 'e'}));
+    EXPECT_CALL(*rawBackendPtr, doFetchLedgerObject).Times(1);
+    EXPECT_CALL(*rawBackendPtr, doFetchLedgerObjects).Times(0);
+
+    auto const line = CreateRippleStateLedgerObject("USD", ISSUER, -10, ACCOUNT, 10, ACCOUNT2, 20, TXNID, 123);
+    auto const sle = ripple::SLE{line, ripple::uint256{INDEX2}};
+
+    mockBackendPtr->balancesIndex().enable(1);
+    mockBackendPtr->balancesIndex().update({}, seq);
+    mockBackendPtr->balancesIndex().put(
+        GetAccountIDWithString(ACCOUNT), std::vector{data::TrustLineState::fromSLE(sle)}, seq
+    );
+
+    auto const handler = AnyHandler{GatewayBalancesHandler{mockBackendPtr}};
+    runSpawn([&](auto yield) {
+        auto const req = json::parse(fmt::format(R"({{"account": "{}"}})", ACCOUNT));
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_TRUE(output);
+        EXPECT_EQ(output->at("obligations"), json::parse(R"({"USD":"10"})"));
+    });
+}
+
 TEST_P(NormalPathTest, CheckOutput)
 {
     auto const& bundle = GetParam();
@@ -278,8 +278,8 @@ TEST_F(RPCNFTInfoHandlerTest, NonExistNFT)
     ON_CALL(*rawBackendPtr, fetchLedgerByHash(ripple::uint256{LEDGERHASH}, _)).WillByDefault(Return(ledgerinfo));
     EXPECT_CALL(*rawBackendPtr, fetchLedgerByHash).Times(1);
     // fetch nft return emtpy
-    ON_CALL(*rawBackendPtr, fetchNFT).WillByDefault(Return(std::optional<NFT>{}));
-    EXPECT_CALL(*rawBackendPtr, fetchNFT(ripple::uint256{NFTID}, 30, _)).Times(1);
+    ON_CALL(*rawBackendPtr, doFetchNFT).WillByDefault(Return(std::optional<NFT>{}));
+    EXPECT_CALL(*rawBackendPtr, doFetchNFT(ripple::uint256{NFTID}, 30, _)).Times(1);
     auto const input = json::parse(fmt::format(
         R"({{
             "nft_id": "{}",
@@ -324,8 +324,8 @@ TEST_F(RPCNFTInfoHandlerTest, DefaultParameters)
 
     // fetch nft return something
     auto const nft = std::make_optional<NFT>(CreateNFT(NFTID, ACCOUNT, ledgerInfo.seq));
-    ON_CALL(*rawBackendPtr, fetchNFT).WillByDefault(Return(nft));
-    EXPECT_CALL(*rawBackendPtr, fetchNFT(ripple::uint256{NFTID}, 30, _)).Times(1);
+    ON_CALL(*rawBackendPtr, doFetchNFT).WillByDefault(Return(nft));
+    EXPECT_CALL(*rawBackendPtr, doFetchNFT(ripple::uint256{NFTID}, 30, _)).Times(1);
 
     auto const input = json::parse(fmt::format(
         R"({{
@@ -368,8 +368,8 @@ TEST_F(RPCNFTInfoHandlerTest, BurnedNFT)
     // fetch nft return something
     auto const nft =
         std::make_optional<NFT>(CreateNFT(NFTID, ACCOUNT, ledgerInfo.seq, ripple::Blob{'u', 'r', 'i'}, true));
-    ON_CALL(*rawBackendPtr, fetchNFT).WillByDefault(Return(nft));
-    EXPECT_CALL(*rawBackendPtr, fetchNFT(ripple::uint256{NFTID}, 30, _)).Times(1);
+    ON_CALL(*rawBackendPtr, doFetchNFT).WillByDefault(Return(nft));
+    EXPECT_CALL(*rawBackendPtr, doFetchNFT(ripple::uint256{NFTID}, 30, _)).Times(1);
 
     auto const input = json::parse(fmt::format(
         R"({{
@@ -411,8 +411,8 @@ TEST_F(RPCNFTInfoHandlerTest, NotBurnedNFTWithoutURI)
 
     // fetch nft return something
     auto const nft = std::make_optional<NFT>(CreateNFT(NFTID, ACCOUNT, ledgerInfo.seq, ripple::Blob{}));
-    ON_CALL(*rawBackendPtr, fetchNFT).WillByDefault(Return(nft));
-    EXPECT_CALL(*rawBackendPtr, fetchNFT(ripple::uint256{NFTID}, 30, _)).Times(1);
+    ON_CALL(*rawBackendPtr, doFetchNFT).WillByDefault(Return(nft));
+    EXPECT_CALL(*rawBackendPtr, doFetchNFT(ripple::uint256{NFTID}, 30, _)).Times(1);
 
     auto const input = json::parse(fmt::format(
         R"({{
@@ -454,8 +454,8 @@ TEST_F(RPCNFTInfoHandlerTest, NFTWithExtraFieldsSet)
 
     // fetch nft return something
     auto const nft = std::make_optional<NFT>(CreateNFT(NFTID2, ACCOUNT, ledgerInfo.seq));
-    ON_CALL(*rawBackendPtr, fetchNFT).WillByDefault(Return(nft));
-    EXPECT_CALL(*rawBackendPtr, fetchNFT(ripple::uint256{NFTID2}, 30, _)).Times(1);
+    ON_CALL(*rawBackendPtr, doFetchNFT).WillByDefault(Return(nft));
+    EXPECT_CALL(*rawBackendPtr, doFetchNFT(ripple::uint256{NFTID2}, 30, _)).Times(1);
 
     auto const input = json::parse(fmt::format(
         R"({{
@@ -384,10 +384,10 @@ TEST_F(RPCNFTsByIssuerHandlerTest, DefaultParameters)
 
     std::vector<NFT> const nfts = {CreateNFT(NFTID1, ACCOUNT, 29)};
     auto const account = GetAccountIDWithString(ACCOUNT);
-    ON_CALL(*rawBackendPtr, fetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
+    ON_CALL(*rawBackendPtr, doFetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
     EXPECT_CALL(
         *rawBackendPtr,
-        fetchNFTsByIssuer(
+        doFetchNFTsByIssuer(
             account, testing::Eq(std::nullopt), Const(30), testing::_, testing::Eq(std::nullopt), testing::_
         )
     )
@@ -445,10 +445,10 @@ TEST_F(RPCNFTsByIssuerHandlerTest, SpecificLedgerIndex)
 
     std::vector<NFT> const nfts = {CreateNFT(NFTID1, ACCOUNT, specificLedger)};
     auto const account = GetAccountIDWithString(ACCOUNT);
-    ON_CALL(*rawBackendPtr, fetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
+    ON_CALL(*rawBackendPtr, doFetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
     EXPECT_CALL(
         *rawBackendPtr,
-        fetchNFTsByIssuer(
+        doFetchNFTsByIssuer(
             account, testing::Eq(std::nullopt), Const(specificLedger), testing::_, testing::Eq(std::nullopt), testing::_
         )
     )
@@ -495,10 +495,10 @@ TEST_F(RPCNFTsByIssuerHandlerTest, TaxonParameter)
 
     std::vector<NFT> const nfts = {CreateNFT(NFTID1, ACCOUNT, 29)};
     auto const account = GetAccountIDWithString(ACCOUNT);
-    ON_CALL(*rawBackendPtr, fetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
+    ON_CALL(*rawBackendPtr, doFetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
     EXPECT_CALL(
         *rawBackendPtr,
-        fetchNFTsByIssuer(account, testing::Optional(0), Const(30), testing::_, testing::Eq(std::nullopt), testing::_)
+        doFetchNFTsByIssuer(account, testing::Optional(0), Const(30), testing::_, testing::Eq(std::nullopt), testing::_)
     )
         .Times(1);
 
@@ -542,10 +542,12 @@ TEST_F(RPCNFTsByIssuerHandlerTest, MarkerParameter)
 
     std::vector<NFT> const nfts = {CreateNFT(NFTID3, ACCOUNT, 29)};
     auto const account = GetAccountIDWithString(ACCOUNT);
-    ON_CALL(*rawBackendPtr, fetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, ripple::uint256{NFTID3}}));
+    ON_CALL(*rawBackendPtr, doFetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, ripple::uint256{NFTID3}}));
     EXPECT_CALL(
         *rawBackendPtr,
-        fetchNFTsByIssuer(account, testing::_, Const(30), testing::_, testing::Eq(ripple::uint256{NFTID1}), testing::_)
+        doFetchNFTsByIssuer(
+            account, testing::_, Const(30), testing::_, testing::Eq(ripple::uint256{NFTID1}), testing::_
+        )
     )
         .Times(1);
 
@@ -592,10 +594,10 @@ TEST_F(RPCNFTsByIssuerHandlerTest, MultipleNFTs)
     std::vector<NFT> const nfts = {
         CreateNFT(NFTID1, ACCOUNT, 29), CreateNFT(NFTID2, ACCOUNT, 29), CreateNFT(NFTID3, ACCOUNT, 29)};
     auto const account = GetAccountIDWithString(ACCOUNT);
-    ON_CALL(*rawBackendPtr, fetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
+    ON_CALL(*rawBackendPtr, doFetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
     EXPECT_CALL(
         *rawBackendPtr,
-        fetchNFTsByIssuer(
+        doFetchNFTsByIssuer(
             account, testing::Eq(std::nullopt), Const(30), testing::_, testing::Eq(std::nullopt), testing::_
         )
     )
@@ -639,10 +641,10 @@ TEST_F(RPCNFTsByIssuerHandlerTest, LimitMoreThanMAx)
 
     std::vector<NFT> const nfts = {CreateNFT(NFTID1, ACCOUNT, 29)};
     auto const account = GetAccountIDWithString(ACCOUNT);
-    ON_CALL(*rawBackendPtr, fetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
+    ON_CALL(*rawBackendPtr, doFetchNFTsByIssuer).WillByDefault(Return(NFTsAndCursor{nfts, {}}));
     EXPECT_CALL(
         *rawBackendPtr,
-        fetchNFTsByIssuer(
+        doFetchNFTsByIssuer(
             account,
             testing::Eq(std::nullopt),
             Const(30),
@@ -336,6 +336,54 @@ TEST_F(RPCServerInfoHandlerTest, BackendCountersPresentWhenRequestWithParam)
     });
 }
 
+TEST_F(RPCServerInfoHandlerTest, ProfilingPresentWhenRequestWithParam)
+{
+    MockLoadBalancer* rawBalancerPtr = mockLoadBalancerPtr.get();
+    MockCounters* rawCountersPtr = mockCountersPtr.get();
+    MockSubscriptionManager* rawSubscriptionManagerPtr = mockSubscriptionManagerPtr.get();
+    MockETLService* rawETLServicePtr = mockETLServicePtr.get();
+
+    auto const empty = json::object{};
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 30, 3);  // 3 seconds old
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerBySequence).WillOnce(Return(ledgerinfo));
+
+    auto const feeBlob = CreateFeeSettingBlob(1, 2, 3, 4, 0);
+    EXPECT_CALL(*rawBackendPtr, doFetchLedgerObject).WillOnce(Return(feeBlob));
+
+    EXPECT_CALL(*rawBalancerPtr, forwardToRippled).WillOnce(Return(empty));
+
+    EXPECT_CALL(*rawCountersPtr, uptime).WillOnce(Return(std::chrono::seconds{1234}));
+
+    EXPECT_CALL(*rawETLServicePtr, isAmendmentBlocked).WillOnce(Return(false));
+
+    // admin calls
+    EXPECT_CALL(*rawCountersPtr, report).WillOnce(Return(empty));
+
+    EXPECT_CALL(*rawSubscriptionManagerPtr, report).WillOnce(Return(empty));
+
+    EXPECT_CALL(*rawETLServicePtr, getInfo).WillOnce(Return(empty));
+
+    auto const handler = AnyHandler{TestServerInfoHandler{
+        mockBackendPtr, mockSubscriptionManagerPtr, mockLoadBalancerPtr, mockETLServicePtr, *mockCountersPtr}};
+
+    runSpawn([&](auto yield) {
+        auto const req = json::parse(R"(
+        {
+            "profiling": true
+        }
+        )");
+        auto const output = handler.process(req, Context{yield, {}, true});
+
+        validateNormalOutput(output);
+        validateAdminOutput(output);
+
+        auto const& info = output.value().as_object().at("info").as_object();
+        ASSERT_TRUE(info.contains("profiling")) << boost::json::serialize(info);
+        EXPECT_TRUE(info.at("profiling").as_object().at("zones").is_object());
+        EXPECT_FALSE(info.contains("backend_counters"));
+    });
+}
+
 TEST_F(RPCServerInfoHandlerTest, RippledForwardedValuesPresent)
 {
     MockLoadBalancer* rawBalancerPtr = mockLoadBalancerPtr.get();
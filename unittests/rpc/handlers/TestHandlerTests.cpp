@@ -22,6 +22,7 @@
 #include <util/Fixtures.h>
 #include <util/MockWsBase.h>
 
+#include <boost/json/monotonic_resource.hpp>
 #include <boost/json/parse.hpp>
 
 using namespace std;
@@ -63,6 +64,20 @@ TEST_F(RPCTestHandlerTest, NoInputHandlerSuccess)
     });
 }
 
+TEST_F(RPCTestHandlerTest, OutputBuiltOnContextStorage)
+{
+    runSpawn([](auto yield) {
+        auto const handler = AnyHandler{HandlerFake{}};
+        auto const storage = json::make_shared_resource<json::monotonic_resource>();
+        auto const input = json::parse(R"({"hello": "world"})");
+
+        auto const output = handler.process(input, Context{.yield = yield, .storage = storage});
+        ASSERT_TRUE(output);
+        EXPECT_EQ(output.value().storage().get(), storage.get());
+        EXPECT_EQ(output.value().as_object().at("computed").as_string().storage().get(), storage.get());
+    });
+}
+
 TEST_F(RPCTestHandlerTest, HandlerErrorHandling)
 {
     runSpawn([](auto yield) {
@@ -91,7 +91,7 @@ struct MockBackend : public BackendInterface {
 
     MOCK_METHOD(
         std::optional<NFT>,
-        fetchNFT,
+        doFetchNFT,
         (ripple::uint256 const&, std::uint32_t const, boost::asio::yield_context),
         (const, override)
     );
@@ -109,7 +109,7 @@ struct MockBackend : public BackendInterface {
 
     MOCK_METHOD(
         NFTsAndCursor,
-        fetchNFTsByIssuer,
+        doFetchNFTsByIssuer,
         (ripple::AccountID const& issuer,
          std::optional<std::uint32_t> const& taxon,
          std::uint32_t const ledgerSequence,
@@ -140,6 +140,13 @@ struct MockBackend : public BackendInterface {
         (const, override)
     );
 
+    MOCK_METHOD(
+        LedgerScanPage,
+        fetchLedgerScanPage,
+        (ScanRange const&, std::optional<std::string> const&, std::uint32_t, std::uint32_t, boost::asio::yield_context),
+        (const, override)
+    );
+
     MOCK_METHOD(
         std::optional<ripple::uint256>,
         doFetchSuccessorKey,
@@ -42,6 +42,10 @@ struct MockCache {
 
     MOCK_METHOD(void, setDisabled, (), ());
 
+    MOCK_METHOD(void, setCompression, (int), ());
+
+    MOCK_METHOD(void, setBounded, (std::size_t), ());
+
     MOCK_METHOD(void, setFull, (), ());
 
     MOCK_METHOD(bool, isFull, (), (const));
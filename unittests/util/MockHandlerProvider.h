@@ -27,6 +27,6 @@
 struct MockHandlerProvider : public rpc::HandlerProvider {
 public:
     MOCK_METHOD(bool, contains, (std::string const&), (const, override));
-    MOCK_METHOD(std::optional<rpc::AnyHandler>, getHandler, (std::string const&), (const, override));
+    MOCK_METHOD(rpc::AnyHandler const*, getHandler, (std::string const&), (const, override));
     MOCK_METHOD(bool, isClioOnly, (std::string const&), (const, override));
 };
@@ -53,7 +53,9 @@ struct MockAsyncRPCEngine {
     MOCK_METHOD(void, notifyTooBusy, (), ());
     MOCK_METHOD(void, notifyUnknownCommand, (), ());
     MOCK_METHOD(void, notifyInternalError, (), ());
-    MOCK_METHOD(rpc::Result, buildResponse, (web::Context const&), ());
+    MOCK_METHOD(bool, requestBatch, (std::string const&, std::size_t), ());
+    MOCK_METHOD(void, notifyBatch, (std::size_t, std::chrono::microseconds const&), ());
+    MOCK_METHOD(rpc::Result, buildResponse, (web::Context&), ());
 };
 
 struct MockRPCEngine {
@@ -67,5 +69,7 @@ struct MockRPCEngine {
     MOCK_METHOD(void, notifyTooBusy, (), ());
     MOCK_METHOD(void, notifyUnknownCommand, (), ());
     MOCK_METHOD(void, notifyInternalError, (), ());
-    MOCK_METHOD(rpc::Result, buildResponse, (web::Context const&), ());
+    MOCK_METHOD(bool, requestBatch, (std::string const&, std::size_t), ());
+    MOCK_METHOD(void, notifyBatch, (std::size_t, std::chrono::microseconds const&), ());
+    MOCK_METHOD(rpc::Result, buildResponse, (web::Context&), ());
 };
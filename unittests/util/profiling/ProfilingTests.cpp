@@ -0,0 +1,308 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2022, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <util/MockPrometheus.h>
+#include <util/config/Config.h>
+#include <util/profiling/Clock.h>
+#include <util/profiling/Profiling.h>
+#include <util/profiling/ProfilingService.h>
+
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace util::profiling;
+
+namespace {
+
+ZoneStats
+statsOf(std::string_view name)
+{
+    for (auto const& [zone, stats] : snapshot()) {
+        if (zone == name)
+            return stats;
+    }
+    return {};
+}
+
+}  // namespace
+
+TEST(TimedTest, HasReturnValue)
+{
+    static Zone const zone{"test.timed.return_value"};
+    auto [ret, time] = timed(zone, []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return 8;
+    });
+
+    ASSERT_EQ(ret, 8);
+    ASSERT_NE(time, 0);
+}
+
+TEST(TimedTest, ReturnVoid)
+{
+    static Zone const zone{"test.timed.void"};
+    auto time = timed(zone, []() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+
+    ASSERT_NE(time, 0);
+}
+
+struct FunctorTest {
+    void
+    operator()() const
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+};
+
+TEST(TimedTest, Functor)
+{
+    static Zone const zone{"test.timed.functor"};
+    auto time = timed(zone, FunctorTest());
+
+    ASSERT_NE(time, 0);
+}
+
+TEST(TimedTest, MovedLambda)
+{
+    static Zone const zone{"test.timed.moved"};
+    auto f = []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return 8;
+    };
+    auto [ret, time] = timed(zone, std::move(f));
+
+    ASSERT_EQ(ret, 8);
+    ASSERT_NE(time, 0);
+}
+
+TEST(TimedTest, ChangeToNs)
+{
+    static Zone const zone{"test.timed.ns"};
+    auto f = []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return 8;
+    };
+    auto [ret, time] = timed<std::chrono::nanoseconds>(zone, std::move(f));
+    ASSERT_EQ(ret, 8);
+    ASSERT_GE(time, 5 * 1000000);
+}
+
+TEST(TimedTest, NestedLambda)
+{
+    static Zone const outer{"test.timed.outer"};
+    static Zone const inner{"test.timed.inner"};
+    double timeNested = std::numeric_limits<double>::quiet_NaN();
+    auto f = [&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        timeNested = timed(inner, []() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+        return 8;
+    };
+    auto [ret, time] = timed<std::chrono::nanoseconds>(outer, std::move(f));
+    ASSERT_EQ(ret, 8);
+    ASSERT_GE(timeNested, 5);
+    ASSERT_GE(time, 10 * 1000000);
+}
+
+TEST(TimedTest, FloatSec)
+{
+    static Zone const zone{"test.timed.float"};
+    auto f = []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return 8;
+    };
+    auto [ret, time] = timed<std::chrono::duration<double>>(zone, std::move(f));
+    ASSERT_EQ(ret, 8);
+    ASSERT_GE(time, 0);
+}
+
+TEST(HistogramTest, BucketBoundaries)
+{
+    for (std::uint64_t value : {0ull, 1ull, 3ull, 4ull, 5ull, 7ull, 8ull, 9ull, 1000ull, 123456789ull}) {
+        auto const index = Histogram::bucketIndex(value);
+        EXPECT_LE(value, Histogram::bucketUpperBound(index)) << value;
+        if (index > 0)
+            EXPECT_GT(value, Histogram::bucketUpperBound(index - 1)) << value;
+    }
+
+    EXPECT_EQ(Histogram::bucketIndex(std::numeric_limits<std::uint64_t>::max()), Histogram::NUM_BUCKETS - 1);
+}
+
+TEST(HistogramTest, RelativeErrorIsBounded)
+{
+    for (std::uint64_t value = 4; value < (std::uint64_t{1} << 40); value = value * 3 + 1) {
+        auto const upper = Histogram::bucketUpperBound(Histogram::bucketIndex(value));
+        EXPECT_LE(static_cast<double>(upper - value) / static_cast<double>(value), 0.25) << value;
+    }
+}
+
+TEST(HistogramTest, Percentiles)
+{
+    Histogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+
+    for (std::uint64_t i = 1; i <= 100; ++i)
+        histogram.add(i * 1000);
+
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_GE(histogram.percentile(0.5), 50000u);
+    EXPECT_LE(histogram.percentile(0.5), 50000u * 5 / 4);
+    EXPECT_GE(histogram.percentile(0.99), 99000u);
+    EXPECT_LE(histogram.percentile(0.99), 99000u * 5 / 4);
+
+    Histogram other;
+    other.add(1);
+    histogram.merge(other);
+    EXPECT_EQ(histogram.count(), 101u);
+    EXPECT_EQ(histogram.percentile(0.0), 1u);
+}
+
+TEST(ZoneTest, MeasurementsAreMergedAcrossThreads)
+{
+    static Zone const zone{"test.zone.threads"};
+    static Zone const sameName{"test.zone.threads"};
+    EXPECT_EQ(zone.id(), sameName.id());
+
+    auto const before = statsOf("test.zone.threads");
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([] {
+            for (auto j = 1; j <= 10; ++j)
+                record(zone, std::chrono::microseconds{j});
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    auto const after = statsOf("test.zone.threads");
+    EXPECT_EQ(after.count - before.count, 40u);
+    EXPECT_EQ(after.sumNs - before.sumNs, 4u * 55000u);
+    EXPECT_EQ(after.maxNs, 10000u);
+    EXPECT_LE(after.percentileNs(1.0), after.maxNs);
+}
+
+TEST(ZoneTest, ScopedZoneAndMacro)
+{
+    static Zone const zone{"test.zone.scoped"};
+    {
+        ScopedZone const scope{zone};
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_GE(scope.elapsed(), std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(statsOf("test.zone.scoped").count, 1u);
+
+    {
+        CLIO_PROFILE_ZONE("test.zone.macro");
+    }
+    EXPECT_EQ(statsOf("test.zone.macro").count, 1u);
+}
+
+TEST(ZoneTest, DisabledRecording)
+{
+    static Zone const zone{"test.zone.disabled"};
+    setEnabled(false);
+    record(zone, std::chrono::nanoseconds{1});
+    setEnabled(true);
+
+    EXPECT_EQ(statsOf("test.zone.disabled").count, 0u);
+}
+
+TEST(ClockTest, SteadyIsTheDefault)
+{
+    EXPECT_EQ(clockType(), ClockType::Steady);
+    auto const start = now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_GE(toDuration(now() - start), std::chrono::milliseconds(1));
+}
+
+TEST(ClockTest, Tsc)
+{
+    if (not tscAvailable()) {
+        EXPECT_THROW(setClock(ClockType::Tsc), std::logic_error);
+        return;
+    }
+
+    setClock(ClockType::Tsc);
+    auto const start = now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    auto const elapsed = toDuration(now() - start);
+    setClock(ClockType::Steady);
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(4));
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+}
+
+struct ProfilingServiceTest : util::prometheus::WithPrometheus, NoLoggerFixture {};
+
+TEST_F(ProfilingServiceTest, SettingsFromConfig)
+{
+    auto const settings = makeProfilingSettings(util::Config{boost::json::parse(R"({
+        "profiling": {
+            "enabled": false,
+            "clock": "steady",
+            "dump_interval_ms": 0
+        }
+    })")});
+
+    EXPECT_FALSE(settings.enabled);
+    EXPECT_EQ(settings.clock, ClockType::Steady);
+    EXPECT_EQ(settings.dumpInterval.count(), 0);
+
+    EXPECT_THROW(
+        makeProfilingSettings(util::Config{boost::json::parse(R"({"profiling": {"clock": "sundial"}})")}),
+        std::logic_error
+    );
+}
+
+TEST_F(ProfilingServiceTest, Report)
+{
+    static Zone const zone{"test.report"};
+    record(zone, std::chrono::microseconds{3});
+
+    auto const json = report();
+    EXPECT_EQ(json.at("clock"), "steady");
+
+    auto const& entry = json.at("zones").at("test.report").as_object();
+    EXPECT_GE(entry.at("count").as_uint64(), 1u);
+    EXPECT_GE(entry.at("max_ns").as_uint64(), 3000u);
+    EXPECT_TRUE(entry.contains("p50_ns"));
+    EXPECT_TRUE(entry.contains("p99_ns"));
+}
+
+TEST_F(ProfilingServiceTest, DumpToPrometheus)
+{
+    static Zone const zone{"test.dump"};
+    record(zone, std::chrono::microseconds{2});
+
+    PrometheusDumper dumper{std::chrono::hours{1}};
+    dumper.dump();
+
+    auto const metrics = PrometheusService::collectMetrics();
+    EXPECT_NE(metrics.find(R"(profiling_zone_calls_total_number{zone="test.dump"} 1)"), std::string::npos);
+    EXPECT_NE(metrics.find(R"(profiling_zone_duration_ns{stat="max",zone="test.dump"} 2000)"), std::string::npos);
+}
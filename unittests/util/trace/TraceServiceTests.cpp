@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <util/MockPrometheus.h>
+#include <util/TmpFile.h>
+#include <util/config/Config.h>
+#include <util/trace/OtlpJson.h>
+#include <util/trace/Trace.h>
+#include <util/trace/TraceService.h>
+
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace util::trace;
+
+namespace {
+
+std::unique_ptr<Trace>
+makeFinishedTrace(bool sampled, bool error, std::chrono::milliseconds duration = std::chrono::milliseconds{0})
+{
+    auto trace = std::make_unique<Trace>("request", sampled);
+    if (error)
+        trace->setError();
+    if (duration.count() > 0)
+        std::this_thread::sleep_for(duration);
+    trace->finish();
+    return trace;
+}
+
+}  // namespace
+
+struct TraceServiceTest : util::prometheus::WithPrometheus, NoLoggerFixture {
+    ~TraceServiceTest() override
+    {
+        TraceService::shutdown();
+    }
+};
+
+TEST_F(TraceServiceTest, DisabledByDefault)
+{
+    TraceService::init(util::Config{boost::json::parse(R"({})")});
+    EXPECT_FALSE(TraceService::isEnabled());
+    EXPECT_EQ(TraceService::startTrace("request"), nullptr);
+}
+
+TEST_F(TraceServiceTest, SettingsFromConfig)
+{
+    auto const settings = makeTraceSettings(util::Config{boost::json::parse(R"({
+        "tracing": {
+            "enabled": true,
+            "sample_rate": 0.5,
+            "slow_threshold_ms": 20,
+            "keep_errors": false,
+            "file": "traces.jsonl",
+            "flush_interval_ms": 100,
+            "max_buffered_traces": 7
+        }
+    })")});
+
+    EXPECT_TRUE(settings.enabled);
+    EXPECT_DOUBLE_EQ(settings.sampleRate, 0.5);
+    EXPECT_EQ(settings.slowThreshold, std::chrono::milliseconds{20});
+    EXPECT_FALSE(settings.keepErrors);
+    EXPECT_EQ(settings.file, "traces.jsonl");
+    EXPECT_EQ(settings.flushInterval, std::chrono::milliseconds{100});
+    EXPECT_EQ(settings.maxBufferedTraces, 7u);
+}
+
+TEST_F(TraceServiceTest, InvalidSampleRate)
+{
+    EXPECT_THROW(
+        makeTraceSettings(util::Config{boost::json::parse(R"({"tracing": {"sample_rate": 1.5}})")}), std::logic_error
+    );
+}
+
+TEST_F(TraceServiceTest, TailDecision)
+{
+    TraceSettings settings;
+    settings.slowThreshold = std::chrono::milliseconds{5};
+
+    EXPECT_EQ(Tracer::decide(*makeFinishedTrace(false, false), settings), Decision::Dropped);
+    EXPECT_EQ(Tracer::decide(*makeFinishedTrace(true, false), settings), Decision::Sampled);
+    EXPECT_EQ(Tracer::decide(*makeFinishedTrace(false, true), settings), Decision::Error);
+    EXPECT_EQ(
+        Tracer::decide(*makeFinishedTrace(false, false, std::chrono::milliseconds{10}), settings), Decision::Slow
+    );
+
+    settings.keepErrors = false;
+    EXPECT_EQ(Tracer::decide(*makeFinishedTrace(false, true), settings), Decision::Dropped);
+}
+
+TEST_F(TraceServiceTest, ReleasedTraceIsSubmitted)
+{
+    TraceSettings settings;
+    settings.sampleRate = 1.0;
+    auto const tracer = std::make_shared<Tracer>(settings);
+
+    auto trace = tracer->startTrace("request");
+    ASSERT_NE(trace, nullptr);
+    EXPECT_TRUE(trace->sampled());
+    {
+        TraceScope const scope{trace};
+        Span const span{"handler"};
+    }
+    EXPECT_TRUE(tracer->drain().empty());
+
+    trace.reset();
+    auto const traces = tracer->drain();
+    ASSERT_EQ(traces.size(), 1u);
+    EXPECT_EQ(traces[0]->spans().size(), 1u);
+    EXPECT_TRUE(tracer->drain().empty());
+}
+
+TEST_F(TraceServiceTest, DroppedAndOverflowingTracesAreNotBuffered)
+{
+    TraceSettings settings;
+    settings.maxBufferedTraces = 2;
+    auto const tracer = std::make_shared<Tracer>(settings);
+
+    tracer->submit(makeFinishedTrace(false, false));
+    for (auto i = 0; i < 3; ++i)
+        tracer->submit(makeFinishedTrace(true, false));
+
+    EXPECT_EQ(tracer->drain().size(), 2u);
+}
+
+TEST_F(TraceServiceTest, TracesFromSeveralThreads)
+{
+    TraceSettings settings;
+    settings.sampleRate = 1.0;
+    auto const tracer = std::make_shared<Tracer>(settings);
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([&tracer] {
+            for (auto j = 0; j < 10; ++j)
+                tracer->startTrace("request");
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(tracer->drain().size(), 40u);
+}
+
+TEST_F(TraceServiceTest, FlushWritesOtlpJson)
+{
+    TmpFile const file{""};
+    TraceSettings settings;
+    settings.sampleRate = 1.0;
+    settings.file = file.path;
+    auto const tracer = std::make_shared<Tracer>(settings);
+
+    {
+        auto const trace = tracer->startTrace("http.request");
+        trace->setAttribute("clio.tag", "[uint 1]");
+        TraceScope const scope{trace};
+        Span span{"rpc.handle"};
+        span.setError();
+    }
+    tracer->flush();
+    tracer->flush();
+
+    std::ifstream in(file.path);
+    std::string line;
+    std::string nextLine;
+    ASSERT_TRUE(std::getline(in, line));
+    EXPECT_FALSE(std::getline(in, nextLine));
+
+    auto const json = boost::json::parse(line);
+    auto const& spans = json.at("resourceSpans").at(0).at("scopeSpans").at(0).at("spans").as_array();
+    ASSERT_EQ(spans.size(), 2u);
+
+    auto const& root = spans.at(0).as_object();
+    EXPECT_EQ(root.at("name"), "http.request");
+    EXPECT_EQ(root.at("kind"), 2);
+    EXPECT_EQ(root.at("traceId").as_string().size(), 32u);
+    EXPECT_EQ(root.at("spanId").as_string().size(), 16u);
+    EXPECT_FALSE(root.contains("parentSpanId"));
+    EXPECT_EQ(root.at("status").at("code"), 2);
+    EXPECT_EQ(root.at("attributes").at(0).at("key"), "clio.tag");
+    EXPECT_EQ(root.at("attributes").at(0).at("value").at("stringValue"), "[uint 1]");
+
+    auto const& child = spans.at(1).as_object();
+    EXPECT_EQ(child.at("name"), "rpc.handle");
+    EXPECT_EQ(child.at("kind"), 1);
+    EXPECT_EQ(child.at("traceId"), root.at("traceId"));
+    EXPECT_EQ(child.at("parentSpanId"), root.at("spanId"));
+    EXPECT_TRUE(child.at("startTimeUnixNano").is_string());
+}
+
+TEST(OtlpJsonTests, Hex)
+{
+    std::array<std::uint8_t, 4> const bytes = {0x00, 0x0f, 0xa5, 0xff};
+    EXPECT_EQ(toHex(bytes.data(), bytes.size()), "000fa5ff");
+}
@@ -0,0 +1,258 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/trace/ContextExecutor.h>
+#include <util/trace/Trace.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+using namespace util::trace;
+
+namespace {
+
+SpanData
+findSpan(Trace const& trace, std::string_view name)
+{
+    auto const spans = trace.spans();
+    auto const it = std::find_if(spans.cbegin(), spans.cend(), [name](auto const& span) { return span.name == name; });
+    EXPECT_NE(it, spans.cend()) << "no span named " << name;
+    return it == spans.cend() ? SpanData{} : *it;
+}
+
+}  // namespace
+
+TEST(TraceTests, SpanWithoutTraceDoesNothing)
+{
+    Span span{"test"};
+    EXPECT_FALSE(span.isRecording());
+    span.setAttribute("key", "value");
+    span.setError();
+    span.finish();
+
+    EXPECT_FALSE(current().trace);
+}
+
+TEST(TraceTests, SpansAreNestedOnTheSameThread)
+{
+    auto const trace = std::make_shared<Trace>("request", false);
+    {
+        TraceScope const scope{trace};
+        Span outer{"outer"};
+        {
+            Span const inner{"inner"};
+            EXPECT_TRUE(inner.isRecording());
+        }
+        Span const sibling{"sibling"};
+    }
+
+    ASSERT_EQ(trace->spans().size(), 3u);
+    auto const outer = findSpan(*trace, "outer");
+    auto const inner = findSpan(*trace, "inner");
+    auto const sibling = findSpan(*trace, "sibling");
+
+    EXPECT_EQ(outer.parentId, trace->rootSpanId());
+    EXPECT_EQ(inner.parentId, outer.id);
+    EXPECT_EQ(sibling.parentId, outer.id);
+    EXPECT_NE(inner.id, sibling.id);
+    EXPECT_LE(outer.start, inner.start);
+    EXPECT_LE(inner.end, outer.end);
+}
+
+TEST(TraceTests, ScopeRestoresPreviousContext)
+{
+    auto const first = std::make_shared<Trace>("first", false);
+    auto const second = std::make_shared<Trace>("second", false);
+
+    TraceScope const outer{first};
+    {
+        TraceScope const inner{second};
+        EXPECT_EQ(current().trace, second);
+    }
+
+    EXPECT_EQ(current().trace, first);
+    EXPECT_EQ(current().spanId, first->rootSpanId());
+}
+
+TEST(TraceTests, FinishDoesNotInstallTraceOnAnotherThread)
+{
+    auto const trace = std::make_shared<Trace>("request", false);
+    std::unique_ptr<Span> span;
+    {
+        TraceScope const scope{trace};
+        span = std::make_unique<Span>("read");
+    }
+
+    // like a coroutine that resumed on another thread after a suspension, without a context executor
+    std::thread([&] {
+        span.reset();
+        EXPECT_FALSE(current().trace);
+    }).join();
+
+    EXPECT_EQ(findSpan(*trace, "read").parentId, trace->rootSpanId());
+}
+
+TEST(TraceTests, ContextExecutorKeepsContextAcrossSuspension)
+{
+    boost::asio::io_context ioc;
+    auto const trace = std::make_shared<Trace>("request", false);
+
+    auto traced = false;
+    auto untraced = false;
+    boost::asio::spawn(
+        make_ContextExecutor(ioc.get_executor(), TraceContext{trace, trace->rootSpanId()}),
+        [&](boost::asio::yield_context yield) {
+            Span outer{"outer"};
+            boost::asio::steady_timer timer{ioc, std::chrono::milliseconds{10}};
+            timer.async_wait(yield);
+
+            EXPECT_EQ(current().trace, trace);
+            Span{"inner"}.finish();
+            traced = true;
+        }
+    );
+
+    // runs while the traced coroutine is suspended in its span
+    boost::asio::spawn(ioc, [&](boost::asio::yield_context yield) {
+        EXPECT_FALSE(current().trace);
+        Span const span{"untraced"};
+        EXPECT_FALSE(span.isRecording());
+
+        boost::asio::steady_timer timer{ioc, std::chrono::milliseconds{1}};
+        timer.async_wait(yield);
+        EXPECT_FALSE(current().trace);
+        untraced = true;
+    });
+
+    ioc.run();
+    EXPECT_TRUE(traced);
+    EXPECT_TRUE(untraced);
+    EXPECT_FALSE(current().trace);
+
+    ASSERT_EQ(trace->spans().size(), 2u);
+    EXPECT_EQ(findSpan(*trace, "inner").parentId, findSpan(*trace, "outer").id);
+    EXPECT_EQ(findSpan(*trace, "outer").parentId, trace->rootSpanId());
+}
+
+TEST(TraceTests, ContextExecutorIsReplacedForNestedCoroutines)
+{
+    boost::asio::io_context ioc;
+    auto const trace = std::make_shared<Trace>("request", false);
+    auto const executor = make_ContextExecutor(ioc.get_executor(), TraceContext{trace, trace->rootSpanId()});
+
+    auto const nested = make_ContextExecutor(executor, TraceContext{trace, 42});
+    ASSERT_NE(nested.target<ContextExecutor>(), nullptr);
+    EXPECT_EQ(nested.target<ContextExecutor>()->inner(), boost::asio::any_io_executor{ioc.get_executor()});
+
+    // without a trace there is nothing to carry
+    EXPECT_EQ(make_ContextExecutor(executor, TraceContext{}), boost::asio::any_io_executor{ioc.get_executor()});
+
+    boost::asio::post(nested, [&] { EXPECT_EQ(current().spanId, 42u); });
+    ioc.run();
+}
+
+TEST(TraceTests, DetachedSpanDoesNotBecomeParent)
+{
+    auto const trace = std::make_shared<Trace>("request", false);
+    TraceScope const scope{trace};
+
+    auto write = Span::detached("write");
+    EXPECT_EQ(current().spanId, trace->rootSpanId());
+
+    Span{"next"}.finish();
+    write.finish();
+
+    EXPECT_EQ(findSpan(*trace, "write").parentId, trace->rootSpanId());
+    EXPECT_EQ(findSpan(*trace, "next").parentId, trace->rootSpanId());
+}
+
+TEST(TraceTests, SpanKeepsTraceAliveAndContextDoesNot)
+{
+    auto trace = std::make_shared<Trace>("request", false);
+    std::weak_ptr<Trace> const weak = trace;
+
+    Span span;
+    {
+        TraceScope const scope{trace};
+        span = Span::detached("write");
+    }
+
+    trace.reset();
+    EXPECT_FALSE(weak.expired());
+
+    span.finish();
+    EXPECT_TRUE(weak.expired());
+    EXPECT_FALSE(current().trace);
+}
+
+TEST(TraceTests, ErrorsAndAttributes)
+{
+    auto const trace = std::make_shared<Trace>("request", false);
+    trace->setAttribute("clio.tag", "[uint 1]");
+    {
+        TraceScope const scope{trace};
+        Span span{"handler"};
+        span.setAttribute("rpc.method", "account_info");
+        span.setError();
+    }
+
+    EXPECT_TRUE(trace->hasError());
+    auto const handler = findSpan(*trace, "handler");
+    EXPECT_TRUE(handler.error);
+    ASSERT_EQ(handler.attributes.size(), 1u);
+    EXPECT_EQ(handler.attributes[0].first, "rpc.method");
+    EXPECT_EQ(handler.attributes[0].second, "account_info");
+    ASSERT_EQ(trace->attributes().size(), 1u);
+}
+
+TEST(TraceTests, ExplicitStartTime)
+{
+    auto const trace = std::make_shared<Trace>("request", false);
+    TraceScope const scope{trace};
+
+    auto const start = Clock::now() - std::chrono::milliseconds{10};
+    Span{"queue.wait", start}.finish();
+
+    auto const wait = findSpan(*trace, "queue.wait");
+    EXPECT_EQ(wait.start, start);
+    EXPECT_GE(wait.end - wait.start, std::chrono::milliseconds{10});
+}
+
+TEST(TraceTests, SystemTimeIsOnlyForExport)
+{
+    auto const before = std::chrono::system_clock::now();
+    auto const trace = std::make_shared<Trace>("request", false);
+    auto const after = std::chrono::system_clock::now();
+
+    EXPECT_GE(trace->toSystemTime(trace->start()), before);
+    EXPECT_LE(trace->toSystemTime(trace->start()), after);
+    EXPECT_EQ(
+        trace->toSystemTime(trace->start() + std::chrono::milliseconds{5}) - trace->toSystemTime(trace->start()),
+        std::chrono::milliseconds{5}
+    );
+}
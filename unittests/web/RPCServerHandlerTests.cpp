@@ -152,6 +152,28 @@ TEST_F(WebRPCServerHandlerTest, WsNormalPath)
     EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
 }
 
+TEST_F(WebRPCServerHandlerTest, WsRequestAllocatedFromArena)
+{
+    session->upgraded = true;
+    static auto constexpr request = R"({
+                                        "command": "server_info",
+                                        "id": 99
+                                    })";
+
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_)).WillOnce([](web::Context const& ctx) {
+        EXPECT_NE(ctx.params.storage().get(), boost::json::storage_ptr{}.get());
+        return boost::json::object{};
+    });
+    EXPECT_CALL(*rpcEngine, notifyComplete("server_info", testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(request, session);
+    EXPECT_EQ(boost::json::parse(session->message).at("status"), "success");
+}
+
 TEST_F(WebRPCServerHandlerTest, HTTPForwardedPath)
 {
     static auto constexpr request = R"({
@@ -797,3 +819,175 @@ TEST_F(WebRPCServerHandlerTest, WsRequestNotJson)
     (*handler)(request, session);
     EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
 }
+
+TEST_F(WebRPCServerHandlerTest, HTTPBatch)
+{
+    static auto constexpr request = R"([
+                                        {"method": "server_info", "params": [{}]},
+                                        {"method": "ledger", "params": [{"ledger_index": "xx"}]},
+                                        42
+                                    ])";
+
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+
+    static auto constexpr response = R"([
+                                        {
+                                            "result": {
+                                                "status": "success"
+                                            },
+                                            "warnings": [
+                                                {
+                                                    "id": 2001,
+                                                    "message": "This is a clio server. clio only serves validated data. If you want to talk to rippled, include 'ledger_index':'current' in your request"
+                                                }
+                                            ]
+                                        },
+                                        {
+                                            "result": {
+                                                "error": "invalidParams",
+                                                "error_code": 31,
+                                                "error_message": "ledgerIndexMalformed",
+                                                "status": "error",
+                                                "type": "response",
+                                                "request": {
+                                                    "method": "ledger",
+                                                    "params": [{"ledger_index": "xx"}]
+                                                }
+                                            },
+                                            "warnings": [
+                                                {
+                                                    "id": 2001,
+                                                    "message": "This is a clio server. clio only serves validated data. If you want to talk to rippled, include 'ledger_index':'current' in your request"
+                                                }
+                                            ]
+                                        },
+                                        {
+                                            "result": {
+                                                "error": "badSyntax",
+                                                "error_code": 1,
+                                                "error_message": "Syntax error.",
+                                                "status": "error",
+                                                "type": "response"
+                                            }
+                                        }
+                                    ])";
+
+    EXPECT_CALL(*rpcEngine, requestBatch(testing::_, 3)).WillOnce(testing::Return(true));
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_))
+        .WillRepeatedly(testing::Invoke([](web::Context const& ctx) -> rpc::Result {
+            if (ctx.method == "ledger")
+                return rpc::Status{rpc::RippledError::rpcINVALID_PARAMS, "ledgerIndexMalformed"};
+            return boost::json::object{};
+        }));
+    EXPECT_CALL(*rpcEngine, notifyComplete("server_info", testing::_)).Times(1);
+    EXPECT_CALL(*rpcEngine, notifyBadSyntax).Times(1);
+    EXPECT_CALL(*rpcEngine, notifyBatch(3, testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillRepeatedly(testing::Return(45));
+
+    (*handler)(request, session);
+    EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
+}
+
+TEST_F(WebRPCServerHandlerTest, WsBatch)
+{
+    session->upgraded = true;
+    static auto constexpr request = R"([
+                                        {"command": "server_info", "id": 1},
+                                        {"command": "ledger", "id": 2}
+                                    ])";
+
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+
+    EXPECT_CALL(*rpcEngine, requestBatch(testing::_, 2)).WillOnce(testing::Return(true));
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_))
+        .WillRepeatedly(testing::Invoke([](web::Context const& ctx) -> rpc::Result {
+            return boost::json::object{{"method", ctx.method}};
+        }));
+    EXPECT_CALL(*rpcEngine, notifyComplete(testing::_, testing::_)).Times(2);
+    EXPECT_CALL(*rpcEngine, notifyBatch(2, testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillRepeatedly(testing::Return(45));
+
+    (*handler)(request, session);
+
+    auto const response = boost::json::parse(session->message);
+    ASSERT_TRUE(response.is_array());
+    ASSERT_EQ(response.as_array().size(), 2);
+
+    // responses are in the order of the requests
+    EXPECT_EQ(response.as_array().at(0).at("id"), 1);
+    EXPECT_EQ(response.as_array().at(0).at("result").at("method"), "server_info");
+    EXPECT_EQ(response.as_array().at(0).at("status"), "success");
+    EXPECT_EQ(response.as_array().at(1).at("id"), 2);
+    EXPECT_EQ(response.as_array().at(1).at("result").at("method"), "ledger");
+    EXPECT_EQ(response.as_array().at(1).at("status"), "success");
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPBatchEmpty)
+{
+    static auto constexpr request = "[]";
+    static auto constexpr responsePrefix = "Unable to parse request: batch must contain between 1 and 100 requests";
+
+    EXPECT_CALL(*rpcEngine, notifyBadSyntax).Times(1);
+
+    (*handler)(request, session);
+    EXPECT_THAT(session->message, testing::StartsWith(responsePrefix));
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::bad_request);
+}
+
+TEST_F(WebRPCServerHandlerTest, WsBatchTooLarge)
+{
+    session->upgraded = true;
+
+    boost::json::array batch;
+    for (auto i = 0u; i <= RPCServerHandler<MockAsyncRPCEngine, MockETLService>::DEFAULT_MAX_BATCH_SIZE; ++i)
+        batch.push_back(boost::json::object{{"command", "server_info"}});
+
+    static auto constexpr response =
+        R"({
+            "error": "badSyntax",
+            "error_code": 1,
+            "error_message": "Syntax error.",
+            "status": "error",
+            "type": "response"
+        })";
+
+    EXPECT_CALL(*rpcEngine, notifyBadSyntax).Times(1);
+
+    (*handler)(boost::json::serialize(batch), session);
+    EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPBatchSlowDown)
+{
+    static auto constexpr request = R"([{"method": "server_info"}, {"method": "server_info"}])";
+
+    EXPECT_CALL(*rpcEngine, requestBatch(testing::_, 2)).WillOnce(testing::Return(false));
+
+    (*handler)(request, session);
+    EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(R"({
+        "error": "slowDown",
+        "error_code": 10,
+        "error_message": "You are placing too much load on the server.",
+        "status": "error",
+        "type": "response"
+    })"));
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::service_unavailable);
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPBatchTooBusy)
+{
+    auto localRpcEngine = std::make_shared<MockRPCEngine>();
+    auto localHandler = std::make_shared<RPCServerHandler<MockRPCEngine, MockETLService>>(
+        cfg, mockBackendPtr, localRpcEngine, etl, subManager
+    );
+    static auto constexpr request = R"([{"method": "server_info"}, {"method": "server_info"}])";
+
+    EXPECT_CALL(*localRpcEngine, requestBatch(testing::_, 2)).WillOnce(testing::Return(true));
+    EXPECT_CALL(*localRpcEngine, notifyTooBusy).Times(1);
+    EXPECT_CALL(*localRpcEngine, post).Times(1).WillOnce(testing::Return(false));
+
+    (*localHandler)(request, session);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::service_unavailable);
+}
@@ -27,7 +27,10 @@
 #include <fmt/core.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdint>
 #include <optional>
+#include <thread>
 
 using namespace util;
 using namespace web::detail;
@@ -628,3 +631,73 @@ TEST_F(WebServerPrometheusTest, validResponse)
     );
     EXPECT_EQ(res, "# TYPE test_counter counter\ntest_counter 1\n\n");
 }
+
+TEST_F(WebServerTest, NoShardsByDefault)
+{
+    EXPECT_EQ(web::make_ServerShards(cfg), nullptr);
+
+    static auto constexpr JSONServerConfigWithNoShards = R"JSON(
+        {
+            "server":{
+                "ip": "0.0.0.0",
+                "port": 8888,
+                "shards": {
+                    "count": 0
+                }
+            }
+        }
+    )JSON";
+
+    Config const disabled{boost::json::parse(JSONServerConfigWithNoShards)};
+    EXPECT_EQ(web::make_ServerShards(disabled), nullptr);
+}
+
+TEST_F(WebServerPrometheusTest, ShardedServer)
+{
+    static auto constexpr JSONServerConfigWithShards = R"JSON(
+        {
+            "server":{
+                "ip": "0.0.0.0",
+                "port": 8888,
+                "shards": {
+                    "count": 2
+                }
+            }
+        }
+    )JSON";
+
+    Config const serverConfig{boost::json::parse(JSONServerConfigWithShards)};
+    auto const shards = web::make_ServerShards(serverConfig);
+    ASSERT_NE(shards, nullptr);
+    ASSERT_EQ(shards->size(), 2u);
+
+    auto e = std::make_shared<EchoExecutor>();
+    auto const server = web::make_HttpServer(serverConfig, ctx, std::nullopt, dosGuard, e, shards);
+
+    static constexpr auto NUM_CONNECTIONS = 4;
+    for (auto i = 0; i < NUM_CONNECTIONS; ++i) {
+        auto const res = HttpSyncClient::syncPost("localhost", "8888", fmt::format(R"({{"Hello":{}}})", i));
+        EXPECT_EQ(res, fmt::format(R"({{"Hello":{}}})", i));
+    }
+
+    // sessions are closed asynchronously after their client is gone
+    auto const waitForOpenConnections = [&](std::int64_t expected) {
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (shards->connectionsGauge(0).value() + shards->connectionsGauge(1).value() != expected and
+               std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+        return shards->connectionsGauge(0).value() + shards->connectionsGauge(1).value();
+    };
+    EXPECT_EQ(waitForOpenConnections(0), 0);
+
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", "8888");
+    EXPECT_EQ(wsClient.syncPost(R"({"Hello":1})"), R"({"Hello":1})");
+    // the upgraded session keeps counting as the same connection
+    EXPECT_EQ(waitForOpenConnections(1), 1);
+    wsClient.disconnect();
+
+    EXPECT_EQ(shards->acceptedCounter(0).value() + shards->acceptedCounter(1).value(), NUM_CONNECTIONS + 1);
+    EXPECT_EQ(waitForOpenConnections(0), 0);
+}
@@ -19,10 +19,14 @@
 #include <util/Fixtures.h>
 #include <util/config/Config.h>
 #include <web/DOSGuard.h>
+#include <web/IpKey.h>
+#include <web/WhitelistHandler.h>
 
 #include <boost/json/parse.hpp>
 #include <gmock/gmock.h>
 
+#include <stdexcept>
+
 using namespace util;
 using namespace web;
 
@@ -72,3 +76,112 @@ TEST_F(WhitelistHandlerTest, TestWhiteListIPV6)
     EXPECT_TRUE(whitelistHandler.isWhiteListed("2001:0db8:85a3:0000:0000:8a2e:0000:0000"));
     EXPECT_TRUE(whitelistHandler.isWhiteListed("2001:0db8:85a3:0000:1111:8a2e:0370:7334"));
 }
+
+TEST_F(WhitelistHandlerTest, TestWhiteListCompressedIPV6)
+{
+    Whitelist whitelist;
+    whitelist.add("2001:db8::/32");
+    whitelist.add("::1");
+
+    EXPECT_TRUE(whitelist.isWhiteListed("2001:db8::1"));
+    EXPECT_TRUE(whitelist.isWhiteListed("2001:db8:ffff:ffff:ffff:ffff:ffff:ffff"));
+    EXPECT_FALSE(whitelist.isWhiteListed("2001:db9::"));
+    EXPECT_TRUE(whitelist.isWhiteListed("::1"));
+    EXPECT_FALSE(whitelist.isWhiteListed("::2"));
+}
+
+TEST_F(WhitelistHandlerTest, NetworkAndBroadcastAddressesAreWhitelisted)
+{
+    Whitelist whitelist;
+    whitelist.add("192.168.0.1/22");
+
+    EXPECT_TRUE(whitelist.isWhiteListed("192.168.0.0"));
+    EXPECT_TRUE(whitelist.isWhiteListed("192.168.3.255"));
+    EXPECT_FALSE(whitelist.isWhiteListed("192.168.4.0"));
+    EXPECT_FALSE(whitelist.isWhiteListed("192.167.255.255"));
+}
+
+TEST_F(WhitelistHandlerTest, IPV4EntriesMatchMappedClients)
+{
+    Whitelist whitelist;
+    whitelist.add("10.0.0.0/8");
+
+    EXPECT_TRUE(whitelist.isWhiteListed("::ffff:10.1.2.3"));
+    EXPECT_FALSE(whitelist.isWhiteListed("::ffff:11.1.2.3"));
+    EXPECT_FALSE(whitelist.isWhiteListed("::a01:203"));
+}
+
+TEST_F(WhitelistHandlerTest, NestedAndSiblingPrefixes)
+{
+    Whitelist whitelist;
+    whitelist.add("10.1.2.3");
+    whitelist.add("10.1.0.0/16");
+    whitelist.add("10.2.0.0/16");
+    whitelist.add("10.0.0.0/12");
+    whitelist.add("172.16.0.0/12");
+
+    EXPECT_TRUE(whitelist.isWhiteListed("10.1.2.3"));
+    EXPECT_TRUE(whitelist.isWhiteListed("10.1.200.1"));
+    EXPECT_TRUE(whitelist.isWhiteListed("10.2.0.1"));
+    EXPECT_TRUE(whitelist.isWhiteListed("10.15.255.255"));
+    EXPECT_FALSE(whitelist.isWhiteListed("10.16.0.0"));
+    EXPECT_TRUE(whitelist.isWhiteListed("172.31.0.1"));
+    EXPECT_FALSE(whitelist.isWhiteListed("172.32.0.1"));
+    EXPECT_FALSE(whitelist.isWhiteListed("2001:db8::1"));
+}
+
+TEST_F(WhitelistHandlerTest, EverythingWhitelisted)
+{
+    Whitelist whitelist;
+    whitelist.add("0.0.0.0/0");
+
+    EXPECT_TRUE(whitelist.isWhiteListed("1.2.3.4"));
+    EXPECT_TRUE(whitelist.isWhiteListed("255.255.255.255"));
+    EXPECT_FALSE(whitelist.isWhiteListed("2001:db8::1"));
+
+    whitelist.add("::/0");
+    EXPECT_TRUE(whitelist.isWhiteListed("2001:db8::1"));
+}
+
+TEST_F(WhitelistHandlerTest, UnparsableAddressIsNotWhitelisted)
+{
+    Whitelist whitelist;
+    whitelist.add("127.0.0.1");
+
+    EXPECT_FALSE(whitelist.isWhiteListed(""));
+    EXPECT_FALSE(whitelist.isWhiteListed("not an ip"));
+}
+
+TEST_F(WhitelistHandlerTest, MalformedNetworkThrows)
+{
+    Whitelist whitelist;
+    EXPECT_THROW(whitelist.add("not an ip"), std::runtime_error);
+    EXPECT_THROW(whitelist.add("10.0.0.0/33"), std::runtime_error);
+    EXPECT_THROW(whitelist.add("2001:db8::/129"), std::runtime_error);
+    EXPECT_THROW(whitelist.add("10.0.0.0/"), std::runtime_error);
+    EXPECT_THROW(whitelist.add("10.0.0.0/8x"), std::runtime_error);
+}
+
+TEST(IpKeyTest, RoundTrip)
+{
+    EXPECT_EQ(makeIpKey("192.168.1.10").toString(), "192.168.1.10");
+    EXPECT_EQ(makeIpKey("2001:db8::1").toString(), "2001:db8::1");
+    EXPECT_EQ(makeIpKey("::ffff:10.0.0.1"), makeIpKey("10.0.0.1"));
+    EXPECT_TRUE(makeIpKey("10.0.0.1").isV4());
+    EXPECT_FALSE(makeIpKey("2001:db8::1").isV4());
+    EXPECT_EQ(makeIpKey("garbage"), IpKey{});
+}
+
+TEST(IpKeyTest, Prefixes)
+{
+    auto const key = makeIpKey("2001:db8:85a3::8a2e:370:7334");
+
+    EXPECT_EQ(key.masked(32), makeIpKey("2001:db8::"));
+    EXPECT_EQ(key.masked(0), IpKey{});
+    EXPECT_EQ(key.masked(IpKey::BITS), key);
+    EXPECT_EQ(key.commonPrefixLength(makeIpKey("2001:db8::")), 32u);
+    EXPECT_EQ(key.commonPrefixLength(key), IpKey::BITS);
+    EXPECT_EQ(key.commonPrefixLength(key, 10), 10u);
+    EXPECT_TRUE(key.bit(2));
+    EXPECT_FALSE(key.bit(0));
+}
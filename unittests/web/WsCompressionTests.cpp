@@ -0,0 +1,233 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <util/MockPrometheus.h>
+
+#include <web/impl/MeteredStream.h>
+#include <web/impl/WsCompression.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+using namespace web::detail;
+using namespace util::prometheus;
+namespace http = boost::beast::http;
+
+namespace {
+
+boost::beast::websocket::response_type
+makeHandshakeResponse(std::optional<std::string> extensions, http::status status = http::status::switching_protocols)
+{
+    boost::beast::websocket::response_type response = {};
+    response.result(status);
+    if (extensions)
+        response.set(http::field::sec_websocket_extensions, *extensions);
+    return response;
+}
+
+}  // namespace
+
+struct WsCompressionTest : WithPrometheus, NoLoggerFixture {};
+
+TEST_F(WsCompressionTest, DisabledByDefault)
+{
+    auto const compression = make_WsCompression(util::Config{boost::json::parse(R"({"ip": "0.0.0.0"})")});
+    EXPECT_FALSE(compression->enabled());
+    EXPECT_FALSE(compression->options().server_enable);
+}
+
+TEST_F(WsCompressionTest, SettingsFromConfig)
+{
+    auto const compression = make_WsCompression(util::Config{boost::json::parse(R"({
+        "ws_compression": {
+            "enabled": true,
+            "level": 6,
+            "mem_level": 8,
+            "window_bits": 12,
+            "min_message_size": 256
+        }
+    })")});
+
+    EXPECT_TRUE(compression->enabled());
+    auto const& settings = compression->settings();
+    EXPECT_EQ(settings.level, 6);
+    EXPECT_EQ(settings.memLevel, 8);
+    EXPECT_EQ(settings.windowBits, 12);
+    EXPECT_EQ(settings.minMessageSize, 256);
+
+    auto const options = compression->options();
+    EXPECT_TRUE(options.server_enable);
+    EXPECT_FALSE(options.client_enable);
+    EXPECT_TRUE(options.server_no_context_takeover);
+    EXPECT_TRUE(options.client_no_context_takeover);
+    EXPECT_EQ(options.server_max_window_bits, 12);
+    EXPECT_EQ(options.compLevel, 6);
+    EXPECT_EQ(options.memLevel, 8);
+    EXPECT_EQ(options.msg_size_threshold, 256);
+}
+
+TEST_F(WsCompressionTest, InvalidSettingsThrow)
+{
+    EXPECT_THROW(
+        make_WsCompression(util::Config{boost::json::parse(R"({"ws_compression": {"level": 10}})")}), std::logic_error
+    );
+    EXPECT_THROW(
+        make_WsCompression(util::Config{boost::json::parse(R"({"ws_compression": {"mem_level": 0}})")}),
+        std::logic_error
+    );
+    EXPECT_THROW(
+        make_WsCompression(util::Config{boost::json::parse(R"({"ws_compression": {"window_bits": 16}})")}),
+        std::logic_error
+    );
+}
+
+TEST_F(WsCompressionTest, NegotiatedOnlyWhenAcceptedInResponse)
+{
+    EXPECT_TRUE(WsCompression::isNegotiated(makeHandshakeResponse("permessage-deflate; server_no_context_takeover")));
+    EXPECT_TRUE(WsCompression::isNegotiated(makeHandshakeResponse("x-custom, Permessage-Deflate")));
+    EXPECT_FALSE(WsCompression::isNegotiated(makeHandshakeResponse("x-permessage-deflate-frame")));
+    EXPECT_FALSE(WsCompression::isNegotiated(makeHandshakeResponse("x-webkit-deflate-frame")));
+    EXPECT_FALSE(WsCompression::isNegotiated(makeHandshakeResponse(std::nullopt)));
+    EXPECT_FALSE(WsCompression::isNegotiated(makeHandshakeResponse("permessage-deflate", http::status::bad_request)));
+}
+
+TEST_F(WsCompressionTest, NegotiatedByBeastHandshake)
+{
+    namespace websocket = boost::beast::websocket;
+
+    auto const accepts = [](WsCompressionSettings settings, std::string const& offer) {
+        boost::asio::io_context ioc;
+        websocket::stream<boost::beast::tcp_stream> ws{ioc};
+        ws.set_option(WsCompression{settings}.options());
+
+        auto negotiated = false;
+        ws.set_option(websocket::stream_base::decorator([&negotiated](websocket::response_type& res) {
+            negotiated = WsCompression::isNegotiated(res);
+        }));
+
+        // the socket isn't connected, so writing the response fails after it was built
+        websocket::request_type request{http::verb::get, "/", 11};
+        request.set(http::field::host, "localhost");
+        request.set(http::field::connection, "upgrade");
+        request.set(http::field::upgrade, "websocket");
+        request.set(http::field::sec_websocket_key, "dGhlIHNhbXBsZSBub25jZQ==");
+        request.set(http::field::sec_websocket_version, "13");
+        request.set(http::field::sec_websocket_extensions, offer);
+
+        boost::beast::error_code ec;
+        ws.accept(request, ec);
+        return negotiated;
+    };
+
+    EXPECT_TRUE(accepts(WsCompressionSettings{.enabled = true}, "permessage-deflate; client_max_window_bits"));
+    EXPECT_FALSE(accepts(WsCompressionSettings{.enabled = true}, "x-permessage-deflate-frame"));
+    EXPECT_FALSE(accepts(WsCompressionSettings{.enabled = false}, "permessage-deflate"));
+}
+
+struct WsCompressionMockPrometheusTest : WithMockPrometheus, NoLoggerFixture {};
+
+TEST_F(WsCompressionMockPrometheusTest, SessionsGauge)
+{
+    auto& sessions = makeMock<GaugeInt>("ws_compression_sessions_current_number", "");
+    WsCompression compression{WsCompressionSettings{.enabled = true}};
+
+    EXPECT_CALL(sessions, add(1));
+    compression.onSessionOpened();
+
+    EXPECT_CALL(sessions, add(-1));
+    compression.onSessionClosed();
+}
+
+TEST_F(WsCompressionMockPrometheusTest, BytesAndDeflateDurationAboveThreshold)
+{
+    auto& payloadBytes = makeMock<CounterInt>("ws_compression_payload_bytes_total_number", "");
+    auto& compressedBytes = makeMock<CounterInt>("ws_compression_compressed_bytes_total_number", "");
+    auto& deflateDuration = makeMock<CounterInt>("ws_compression_deflate_duration_us", "");
+    WsCompression compression{WsCompressionSettings{.enabled = true, .minMessageSize = 4}};
+
+    EXPECT_CALL(payloadBytes, add(64)).Times(2);
+    EXPECT_CALL(compressedBytes, add(12)).Times(2);
+    EXPECT_CALL(deflateDuration, add(3)).Times(2);
+    auto const cost = MessageCost{.bytesWritten = 12, .busyTime = std::chrono::microseconds{3}};
+    compression.onMessageSent(64, cost);
+    compression.onMessageSent(64, cost);
+    compression.onMessageSent(3, cost);  // below the threshold, sent uncompressed
+}
+
+TEST_F(WsCompressionTest, MeteredStreamCountsCompressedBytes)
+{
+    namespace websocket = boost::beast::websocket;
+    using boost::asio::ip::tcp;
+
+    boost::asio::io_context ioc;
+    tcp::acceptor acceptor{ioc, tcp::endpoint{boost::asio::ip::make_address("127.0.0.1"), 0}};
+    websocket::stream<MeteredStream<boost::beast::tcp_stream>> server{ioc};
+    websocket::stream<boost::beast::tcp_stream> client{ioc};
+
+    websocket::permessage_deflate deflate;
+    deflate.server_enable = true;
+    deflate.client_enable = true;
+    server.set_option(deflate);
+    client.set_option(deflate);
+
+    std::string const payload(10000, 'a');
+    std::optional<MessageCost> cost;
+    std::size_t received = 0;
+    boost::beast::flat_buffer buffer;
+
+    acceptor.async_accept([&](boost::system::error_code ec, tcp::socket socket) {
+        ASSERT_FALSE(ec);
+        boost::beast::get_lowest_layer(server).socket() = std::move(socket);
+        server.async_accept([&](boost::system::error_code ec) {
+            ASSERT_FALSE(ec);
+            server.next_layer().beginMessage();
+            server.async_write(boost::asio::buffer(payload), [&](boost::system::error_code ec, std::size_t) {
+                EXPECT_FALSE(ec);
+                cost = server.next_layer().endMessage();
+            });
+        });
+    });
+    boost::beast::get_lowest_layer(client).async_connect(acceptor.local_endpoint(), [&](boost::system::error_code ec) {
+        ASSERT_FALSE(ec);
+        client.async_handshake("localhost", "/", [&](boost::system::error_code ec) {
+            ASSERT_FALSE(ec);
+            client.async_read(buffer, [&](boost::system::error_code ec, std::size_t size) {
+                EXPECT_FALSE(ec);
+                received = size;
+            });
+        });
+    });
+    ioc.run();
+
+    ASSERT_TRUE(cost.has_value());
+    EXPECT_EQ(received, payload.size());
+    EXPECT_GT(cost->bytesWritten, 0u);
+    EXPECT_LT(cost->bytesWritten, payload.size() / 10);
+    EXPECT_GT(cost->busyTime.count(), 0);
+}